@@ -0,0 +1,679 @@
+//
+//    MINOTAUR -- It's only 1/2 bull
+//
+//    (C)opyright 2009 - 2014 The MINOTAUR Team.
+//
+
+/**
+ * \file BnbDriver.cpp
+ * \brief Define the BnbDriver class that solves instances in ampl format
+ * (.nl) by NLP-based branch-and-bound, one after the other, in the same
+ * process.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sys/stat.h>
+
+#include "MinotaurConfig.h"
+#include "BndProcessor.h"
+#include "BnbDriver.h"
+#include "BranchAndBound.h"
+#include "EngineFactory.h"
+#include "Environment.h"
+#include "IntVarHandler.h"
+#include "LexicoBrancher.h"
+#include "LinearHandler.h"
+#include "LinFeasPump.h"
+#include "Logger.h"
+#include "LPEngine.h"
+#include "MaxFreqBrancher.h"
+#include "MaxVioBrancher.h"
+#include "MINLPDiving.h"
+#include "MipStart.h"
+#include "NLPEngine.h"
+#include "NlPresHandler.h"
+#include "NodeIncRelaxer.h"
+#include "Objective.h"
+#include "Option.h"
+#include "PCBProcessor.h"
+#include "Presolver.h"
+#include "ProblemSize.h"
+#include "QPEngine.h"
+#include "Problem.h"
+#include "ProblemSnapshot.h"
+#include "RandomBrancher.h"
+#include "Relaxation.h"
+#include "ReliabilityBrancher.h"
+#include "Solution.h"
+#include "SOS1Handler.h"
+#include "SOS2Handler.h"
+#include "Timer.h"
+#include "TreeManager.h"
+
+#include "AMPLHessian.h"
+#include "AMPLInterface.h"
+#include "AMPLJacobian.h"
+
+using namespace Minotaur;
+
+const std::string BnbDriver::me_ = "bnb main: ";
+
+
+BnbDriver::BnbDriver(EnvPtr env)
+  : env_(env),
+    iface_(0),
+    numSolves_(0),
+    time_(0.0)
+{
+  env_->getOptions()->findBool("presolve")->setValue(true);
+  env_->getOptions()->findBool("use_native_cgraph")->setValue(true);
+  env_->getOptions()->findBool("nl_presolve")->setValue(true);
+
+  // Important to setup AMPL Interface first as it adds several options.
+  iface_ = new MINOTAUR_AMPL::AMPLInterface(env_, "bnb");
+  timer_ = env_->getNewTimer();
+}
+
+
+BnbDriver::~BnbDriver()
+{
+  if (iface_) {
+    delete iface_;
+  }
+  delete timer_;
+  lpe_.reset();
+  qpe_.reset();
+  nlpe_.reset();
+  env_.reset();
+}
+
+
+BranchAndBound* BnbDriver::createBab_(ProblemPtr p, EnginePtr e,
+                                      HandlerVector &handlers)
+{
+  BranchAndBound *bab = new BranchAndBound(env_, p);
+  NodeProcessorPtr nproc = NodeProcessorPtr(); // NULL
+  IntVarHandlerPtr v_hand = (IntVarHandlerPtr) new IntVarHandler(env_, p);
+  LinHandlerPtr l_hand = (LinHandlerPtr) new LinearHandler(env_, p);
+  NlPresHandlerPtr nlhand;
+  NodeIncRelaxerPtr nr;
+  RelaxationPtr rel;
+  BrancherPtr br;
+  MipStartPtr ms_heur;
+  OptionDBPtr options = env_->getOptions();
+  SOS2HandlerPtr s2_hand;
+
+  SOS1HandlerPtr s_hand = (SOS1HandlerPtr) new SOS1Handler(env_, p);
+  if (s_hand->isNeeded()) {
+    s_hand->setModFlags(false, true);
+    handlers.push_back(s_hand);
+  }
+
+  // add SOS2 handler here.
+  s2_hand = (SOS2HandlerPtr) new SOS2Handler(env_, p);
+  if (s2_hand->isNeeded()) {
+    s2_hand->setModFlags(false, true);
+    handlers.push_back(s2_hand);
+  }
+
+
+  handlers.push_back(v_hand);
+  if (true==options->findBool("presolve")->getValue()) {
+    l_hand->setModFlags(false, true);
+    handlers.push_back(l_hand);
+  }
+  if (!p->isLinear() &&
+       true==options->findBool("presolve")->getValue() &&
+       true==options->findBool("use_native_cgraph")->getValue() &&
+       true==options->findBool("nl_presolve")->getValue()) {
+    nlhand = (NlPresHandlerPtr) new NlPresHandler(env_, p);
+    nlhand->setModFlags(false, true);
+    handlers.push_back(nlhand);
+  }
+  if (handlers.size()>1) {
+    nproc = (PCBProcessorPtr) new PCBProcessor(env_, e, handlers);
+  } else {
+    nproc = (BndProcessorPtr) new BndProcessor(env_, e, handlers);
+  }
+  br = createBrancher_(p, handlers, e);
+  nproc->setBrancher(br);
+  bab->setNodeProcessor(nproc);
+
+  nr = (NodeIncRelaxerPtr) new NodeIncRelaxer(env_, handlers);
+  nr->setModFlag(false);
+  rel = (RelaxationPtr) new Relaxation(p);
+  rel->calculateSize();
+  if (options->findBool("use_native_cgraph")->getValue() ||
+      rel->isQP() || rel->isQuadratic()) {
+    rel->setNativeDer();
+  } else {
+    rel->setJacobian(p->getJacobian());
+    rel->setHessian(p->getHessian());
+  }
+  rel->setInitialPoint(p->getInitialPoint());
+  nr->setRelaxation(rel);
+  nr->setEngine(e);
+  bab->setNodeRelaxer(nr);
+  bab->shouldCreateRoot(false);
+
+  ms_heur = MipStart::create(env_, p, rel, e);
+  if (ms_heur) {
+    bab->addPreRootHeur(ms_heur);
+  }
+  if (0 <= options->findInt("divheur")->getValue()) {
+    MINLPDivingPtr div_heur;
+    EnginePtr e2 = e->emptyCopy();
+    if (true==options->findBool("use_native_cgraph")->getValue() ||
+        rel->isQP() || rel->isQuadratic()) {
+      p->setNativeDer();
+    }
+    div_heur = (MINLPDivingPtr) new MINLPDiving(env_, p, e2);
+    bab->addPreRootHeur(div_heur);
+  }
+  if (true == options->findBool("FPump")->getValue()) {
+    EngineFactory efac(env_);
+    EnginePtr lpe = efac.getLPEngine();
+    EnginePtr nlpe = e->emptyCopy();
+    LinFeasPumpPtr lin_feas_pump = (LinFeasPumpPtr)
+      new LinFeasPump(env_, p, nlpe, lpe);
+    bab->addPreRootHeur(lin_feas_pump);
+  }
+  return bab;
+}
+
+
+BrancherPtr BnbDriver::createBrancher_(ProblemPtr p, HandlerVector handlers,
+                                       EnginePtr e)
+{
+  BrancherPtr br;
+  UInt t;
+  OptionDBPtr options = env_->getOptions();
+  LoggerPtr logger = env_->getLogger();
+
+  if (options->findString("brancher")->getValue() == "rel") {
+    ReliabilityBrancherPtr rel_br;
+    rel_br = (ReliabilityBrancherPtr) new ReliabilityBrancher(env_, handlers);
+    rel_br->setEngine(e);
+    t = (p->getSize()->ints + p->getSize()->bins)/10;
+    t = std::max(t, (UInt) 2);
+    t = std::min(t, (UInt) 4);
+    rel_br->setThresh(t);
+    logger->msgStream(LogExtraInfo) << me_ <<
+      "setting reliability threshhold to " << t << std::endl;
+    t = (UInt) p->getSize()->ints + p->getSize()->bins/20+2;
+    t = std::min(t, (UInt) 10);
+    rel_br->setMaxDepth(t);
+    logger->msgStream(LogExtraInfo) << me_ <<
+      "setting reliability maxdepth to " << t << std::endl;
+    if (e->getName()=="Filter-SQP") {
+      rel_br->setIterLim(5);
+    }
+    logger->msgStream(LogExtraInfo) << me_ <<
+      "reliability branching iteration limit = " <<
+      rel_br->getIterLim() << std::endl;
+    br = rel_br;
+  } else if (options->findString("brancher")->getValue() == "maxvio") {
+    br = (MaxVioBrancherPtr) new MaxVioBrancher(env_, handlers);
+  } else if (options->findString("brancher")->getValue() == "lex") {
+    br = (LexicoBrancherPtr) new LexicoBrancher(env_, handlers);
+  } else if (options->findString("brancher")->getValue() == "rand") {
+    br = (RandomBrancherPtr) new RandomBrancher(env_, handlers);
+  } else if (options->findString("brancher")->getValue() == "maxfreq") {
+    br = (MaxFreqBrancherPtr) new MaxFreqBrancher(env_, handlers);
+  }
+  logger->msgStream(LogExtraInfo) << me_ <<
+    "brancher used = " << br->getName() << std::endl;
+  return br;
+}
+
+
+EnginePtr BnbDriver::getEngine_(ProblemPtr p)
+{
+  EngineFactory efac(env_);
+  EnginePtr e = EnginePtr(); // NULL
+
+  p->calculateSize();
+  if (p->isLinear()) {
+    if (!lpe_) {
+      lpe_ = efac.getLPEngine();
+    }
+    e = lpe_;
+  }
+
+  if (!e && (p->isLinear() || p->isQP())) {
+    if (!qpe_) {
+      qpe_ = efac.getQPEngine();
+    }
+    e = qpe_;
+  }
+
+  if (!e) {
+    if (!nlpe_) {
+      nlpe_ = efac.getNLPEngine();
+    }
+    e = nlpe_;
+  }
+
+  if (!e) {
+    env_->getLogger()->errStream() <<  "No engine available for this problem."
+                                   << std::endl << "exiting without solving"
+                                   << std::endl;
+  } else {
+    // the engine may still have the problem of the last solve.
+    e->clear();
+    env_->getLogger()->msgStream(LogExtraInfo) << me_ <<
+      "engine used = " << e->getName() << std::endl;
+  }
+  return e;
+}
+
+
+UInt BnbDriver::getNumSolves() const
+{
+  return numSolves_;
+}
+
+
+ProblemPtr BnbDriver::loadProblem_(const std::string &fname,
+                                   double *obj_sense, size_t *ndefs)
+{
+  Timer *timer = env_->getNewTimer();
+  OptionDBPtr options = env_->getOptions();
+  std::string snap = options->findString("snapshot_file")->getValue();
+  ProblemSnapshot snapshot(env_);
+  ProblemPtr oinst;
+  bool from_snap = false;
+  JacobianPtr jac;
+  HessianOfLagPtr hess;
+  std::ifstream in(fname.c_str());
+  std::ifstream in2((fname+".nl").c_str());
+
+  // ASL exits if the file can not be read.
+  if (!in.good() && !in2.good()) {
+    env_->getLogger()->errStream() << me_ << "can not read file " << fname
+                                   << std::endl;
+    delete timer;
+    return ProblemPtr(); // NULL
+  }
+  in.close();
+  in2.close();
+
+  timer->start();
+  *ndefs = 0;
+  if (useSnapshot_(fname, snap)) {
+    oinst = snapshot.read(snap);
+  }
+  if (oinst) {
+    env_->getLogger()->msgStream(LogInfo) << me_
+      << "loaded problem from snapshot " << snap << std::endl;
+  } else {
+    oinst = iface_->readInstance(fname);
+    *ndefs = iface_->getNumDefs();
+    // a snapshot does not keep defined variables apart.
+    if (!snap.empty() && 0==*ndefs &&
+        true==options->findBool("use_native_cgraph")->getValue() &&
+        snapshot.write(oinst, snap)) {
+      env_->getLogger()->msgStream(LogInfo) << me_
+        << "saved problem in snapshot " << snap << std::endl;
+    }
+  }
+  env_->getLogger()->msgStream(LogInfo) << me_
+    << "time used in reading instance = " << std::fixed
+    << std::setprecision(2) << timer->query() << std::endl;
+
+  // display the problem
+  oinst->calculateSize();
+  if (options->findBool("display_problem")->getValue()==true) {
+    oinst->write(env_->getLogger()->msgStream(LogNone), 12);
+  }
+  if (options->findBool("display_size")->getValue()==true) {
+    oinst->writeSize(env_->getLogger()->msgStream(LogNone));
+  }
+  // create the jacobian
+  if (false==options->findBool("use_native_cgraph")->getValue()) {
+    jac = (MINOTAUR_AMPL::AMPLJacobianPtr)
+      new MINOTAUR_AMPL::AMPLJacobian(iface_);
+    oinst->setJacobian(jac);
+
+    // create the hessian
+    hess = (MINOTAUR_AMPL::AMPLHessianPtr)
+      new MINOTAUR_AMPL::AMPLHessian(iface_);
+    oinst->setHessian(hess);
+  }
+
+  // set initial point. A snapshot does not save one.
+  if (!from_snap) {
+    oinst->setInitialPoint(iface_->getInitialPoint(),
+        oinst->getNumVars()-iface_->getNumDefs());
+  }
+
+  if (oinst->getObjective() &&
+      oinst->getObjective()->getObjectiveType()==Maximize) {
+    *obj_sense = -1.0;
+    env_->getLogger()->msgStream(LogInfo) << me_
+      << "objective sense: maximize (will be converted to Minimize)"
+      << std::endl;
+  } else {
+    *obj_sense = 1.0;
+    env_->getLogger()->msgStream(LogInfo) << me_
+      << "objective sense: minimize" << std::endl;
+  }
+
+  delete timer;
+  return oinst;
+}
+
+
+PresolverPtr BnbDriver::presolve_(ProblemPtr p, size_t ndefs,
+                                  HandlerVector &handlers)
+{
+  PresolverPtr pres = PresolverPtr(); // NULL
+  OptionDBPtr options = env_->getOptions();
+
+  p->calculateSize();
+  if (options->findBool("presolve")->getValue() == true) {
+    LinHandlerPtr lhandler = (LinHandlerPtr) new LinearHandler(env_, p);
+    handlers.push_back(lhandler);
+    if (p->isQP() || p->isQuadratic() || p->isLinear() ||
+        true==options->findBool("use_native_cgraph")->getValue()) {
+      lhandler->setPreOptPurgeVars(true);
+      lhandler->setPreOptPurgeCons(true);
+      lhandler->setPreOptCoeffImp(true);
+    } else {
+      lhandler->setPreOptPurgeVars(false);
+      lhandler->setPreOptPurgeCons(false);
+      lhandler->setPreOptCoeffImp(false);
+    }
+    if (ndefs>0) {
+      lhandler->setPreOptDualFix(false);
+    } else {
+      lhandler->setPreOptDualFix(true);
+    }
+
+    if (!p->isLinear() &&
+         true==options->findBool("use_native_cgraph")->getValue() &&
+         true==options->findBool("nl_presolve")->getValue()
+         ) {
+      NlPresHandlerPtr nlhand = (NlPresHandlerPtr) new NlPresHandler(env_, p);
+      handlers.push_back(nlhand);
+    }
+
+    // write the names.
+    env_->getLogger()->msgStream(LogExtraInfo) << me_
+      << "handlers used in presolve:" << std::endl;
+    for (HandlerIterator h = handlers.begin(); h != handlers.end();
+        ++h) {
+      env_->getLogger()->msgStream(LogExtraInfo) << me_
+        << (*h)->getName() << std::endl;
+    }
+  }
+
+  pres = (PresolverPtr) new Presolver(p, env_, handlers);
+  pres->standardize();
+  if (options->findBool("presolve")->getValue() == true) {
+    pres->solve();
+    for (HandlerVector::iterator h=handlers.begin(); h!=handlers.end(); ++h) {
+      (*h)->writeStats(env_->getLogger()->msgStream(LogExtraInfo));
+    }
+  }
+  return pres;
+}
+
+
+void BnbDriver::restoreOptions_()
+{
+  for (UInt i=0; i<boolOpts_.size(); ++i) {
+    boolOpts_[i].first->setValue(boolOpts_[i].second);
+  }
+  for (UInt i=0; i<intOpts_.size(); ++i) {
+    intOpts_[i].first->setValue(intOpts_[i].second);
+  }
+  for (UInt i=0; i<dblOpts_.size(); ++i) {
+    dblOpts_[i].first->setValue(dblOpts_[i].second);
+  }
+  for (UInt i=0; i<strOpts_.size(); ++i) {
+    strOpts_[i].first->setValue(strOpts_[i].second);
+  }
+}
+
+
+void BnbDriver::saveOptions()
+{
+  OptionDBPtr options = env_->getOptions();
+
+  boolOpts_.clear();
+  intOpts_.clear();
+  dblOpts_.clear();
+  strOpts_.clear();
+  for (BoolOptionSetIter it=options->boolBegin(); it!=options->boolEnd();
+       ++it) {
+    boolOpts_.push_back(std::make_pair(*it, (*it)->getValue()));
+  }
+  for (FlagOptionSetIter it=options->flagBegin(); it!=options->flagEnd();
+       ++it) {
+    boolOpts_.push_back(std::make_pair(*it, (*it)->getValue()));
+  }
+  for (IntOptionSetIter it=options->intBegin(); it!=options->intEnd(); ++it) {
+    intOpts_.push_back(std::make_pair(*it, (*it)->getValue()));
+  }
+  for (DoubleOptionSetIter it=options->dblBegin(); it!=options->dblEnd();
+       ++it) {
+    dblOpts_.push_back(std::make_pair(*it, (*it)->getValue()));
+  }
+  for (StringOptionSetIter it=options->strBegin(); it!=options->strEnd();
+       ++it) {
+    strOpts_.push_back(std::make_pair(*it, (*it)->getValue()));
+  }
+}
+
+
+int BnbDriver::solve(const std::string &fname, const std::string &opts,
+                     BnbResult *res)
+{
+  OptionDBPtr options = env_->getOptions();
+  ProblemPtr oinst;    // instance that needs to be solved.
+  EnginePtr engine;    // engine for solving relaxations.
+  BranchAndBound *bab = 0;
+  PresolverPtr pres;
+  VarVector *orig_v = 0;
+  HandlerVector handlers;
+  BnbResult res2;
+  double obj_sense = 1.0;
+  size_t ndefs = 0;
+  int err = 0;
+
+  if (!res) {
+    res = &res2;
+  }
+  res->status = NotStarted;
+  res->objValue = INFINITY;
+  res->lb = -INFINITY;
+  res->gap = INFINITY;
+  res->time = 0.0;
+  res->nodes = 0;
+  res->x.clear();
+
+  timer_->start();
+  ++numSolves_;
+  if (boolOpts_.empty()) {
+    saveOptions();
+  }
+  restoreOptions_();
+  if (opts.empty()) {
+    env_->setLogLevel((LogLevel) options->findInt("log_level")->getValue());
+  } else {
+    env_->readOptions(opts);
+  }
+  options->findString("problem_file")->setValue(fname);
+  options->findString("interface_type")->setValue("AMPL");
+
+  oinst = loadProblem_(fname, &obj_sense, &ndefs);
+  if (!oinst) {
+    err = 1;
+    goto CLEANUP;
+  }
+  orig_v = new VarVector(oinst->varsBegin(), oinst->varsEnd());
+  pres = presolve_(oinst, ndefs, handlers);
+  handlers.clear();
+  if (Finished != pres->getStatus() && NotStarted != pres->getStatus()) {
+    env_->getLogger()->msgStream(LogInfo) << me_
+      << "status of presolve: "
+      << getSolveStatusString(pres->getStatus()) << std::endl;
+    res->status = pres->getStatus();
+    writeSol_(orig_v, pres, SolutionPtr(), pres->getStatus(), res);
+    goto CLEANUP;
+  }
+
+  if (false==options->findBool("solve")->getValue()) {
+    goto CLEANUP;
+  }
+
+  engine = getEngine_(oinst);
+  if (!engine) {
+    err = 1;
+    goto CLEANUP;
+  }
+
+  bab = createBab_(oinst, engine, handlers);
+  bab->solve();
+  bab->writeStats(env_->getLogger()->msgStream(LogExtraInfo));
+  engine->writeStats(env_->getLogger()->msgStream(LogExtraInfo));
+  for (HandlerVector::iterator it=handlers.begin(); it!=handlers.end(); ++it) {
+    (*it)->writeStats(env_->getLogger()->msgStream(LogExtraInfo));
+  }
+
+  res->status = bab->getStatus();
+  res->objValue = obj_sense*bab->getUb();
+  res->lb = obj_sense*bab->getLb();
+  res->gap = bab->getPerGap();
+  res->nodes = bab->numProcNodes();
+  writeSol_(orig_v, pres, bab->getSolution(), bab->getStatus(), res);
+
+CLEANUP:
+  res->time = timer_->query();
+  time_ += res->time;
+  timer_->stop();
+  if (oinst) {
+    writeStatus_(*res);
+  }
+  if (bab) {
+    delete bab;
+  }
+  if (engine) {
+    // do not keep the problem in memory till the next solve.
+    engine->clear();
+  }
+  if (orig_v) {
+    delete orig_v;
+  }
+  return err;
+}
+
+
+bool BnbDriver::useSnapshot_(const std::string &fname,
+                             const std::string &snap)
+{
+  OptionDBPtr options = env_->getOptions();
+  struct stat nl_st, snap_st;
+
+  if (snap.empty() ||
+      false==options->findBool("use_native_cgraph")->getValue()) {
+    return false;
+  }
+  // the solution file is written by the AMPL interface, which needs the
+  // instance.
+  if (options->findFlag("AMPL")->getValue() ||
+      true==options->findBool("write_sol_file")->getValue()) {
+    env_->getLogger()->msgStream(LogInfo) << me_
+      << "not loading snapshot because a solution file is written"
+      << std::endl;
+    return false;
+  }
+  if (0!=stat(snap.c_str(), &snap_st)) {
+    return false;
+  }
+  if (0!=stat(fname.c_str(), &nl_st) &&
+      0!=stat((fname+".nl").c_str(), &nl_st)) {
+    return false;
+  }
+  if (snap_st.st_mtime<nl_st.st_mtime) {
+    env_->getLogger()->msgStream(LogInfo) << me_ << "snapshot " << snap
+      << " is older than the instance, reading the instance" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+
+void BnbDriver::writeSol_(VarVector *orig_v, PresolverPtr pres,
+                          SolutionPtr sol, SolveStatus status,
+                          BnbResult *res)
+{
+  if (sol) {
+    sol = pres->getPostSol(sol);
+  }
+
+  if (env_->getOptions()->findFlag("AMPL")->getValue() ||
+      true == env_->getOptions()->findBool("write_sol_file")->getValue()) {
+    iface_->writeSolution(sol, status);
+  } else if (sol && env_->getLogger()->getMaxLevel()>=LogExtraInfo) {
+    sol->writePrimal(env_->getLogger()->msgStream(LogExtraInfo), orig_v);
+  }
+  if (sol && res) {
+    res->x.assign(sol->getPrimal(), sol->getPrimal()+orig_v->size());
+  }
+}
+
+
+void BnbDriver::writeStats(std::ostream &out) const
+{
+  out << me_ << "instances solved = " << numSolves_ << std::endl
+      << me_ << "total time (s)   = " << std::fixed << std::setprecision(2)
+      << time_ << std::endl;
+  if (lpe_) {
+    lpe_->writeStats(out);
+  }
+  if (qpe_) {
+    qpe_->writeStats(out);
+  }
+  if (nlpe_) {
+    nlpe_->writeStats(out);
+  }
+}
+
+
+void BnbDriver::writeStatus_(const BnbResult &res)
+{
+  double gap = INFINITY;
+
+  if (fabs(res.objValue)<INFINITY && fabs(res.lb)<INFINITY) {
+    gap = fabs(res.objValue-res.lb);
+  }
+  env_->getLogger()->msgStream(LogInfo)
+    << me_ << std::fixed << std::setprecision(4)
+    << "best solution value = " << res.objValue << std::endl
+    << me_ << std::fixed << std::setprecision(4)
+    << "best bound estimate from remaining nodes = " << res.lb << std::endl
+    << me_ << "gap = " << gap << std::endl
+    << me_ << "gap percentage = " << res.gap << std::endl
+    << me_ << "time used (s) = " << std::fixed << std::setprecision(2)
+    << res.time << std::endl
+    << me_ << "status of branch-and-bound: "
+    << getSolveStatusString(res.status) << std::endl;
+}
+
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
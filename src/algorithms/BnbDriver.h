@@ -0,0 +1,189 @@
+//
+//    MINOTAUR -- It's only 1/2 bull
+//
+//    (C)opyright 2009 - 2014 The MINOTAUR Team.
+//
+
+/**
+ * \file BnbDriver.h
+ * \brief Declare the BnbDriver class that solves instances in ampl format
+ * (.nl) by NLP-based branch-and-bound, one after the other, in the same
+ * process.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#ifndef MINOTAURBNBDRIVER_H
+#define MINOTAURBNBDRIVER_H
+
+#include <string>
+
+#include "Types.h"
+
+namespace MINOTAUR_AMPL {
+  class AMPLInterface;
+}
+
+namespace Minotaur {
+
+  class BranchAndBound;
+  class Brancher;
+  class Engine;
+  class Presolver;
+  class Solution;
+  class Timer;
+  typedef boost::shared_ptr<Brancher> BrancherPtr;
+  typedef boost::shared_ptr<Engine> EnginePtr;
+  typedef boost::shared_ptr<Presolver> PresolverPtr;
+  typedef boost::shared_ptr<Problem> ProblemPtr;
+  typedef boost::shared_ptr<Solution> SolutionPtr;
+
+  /// Result of one solve by the BnbDriver.
+  struct BnbResult {
+    SolveStatus status; ///< Status of branch-and-bound or of presolve.
+    double objValue;    ///< Value of the best solution, INFINITY if none.
+    double lb;          ///< Best bound from the remaining nodes.
+    double gap;         ///< Percentage gap.
+    double time;        ///< Time taken in seconds.
+    UInt nodes;         ///< Number of nodes processed.
+    DoubleVector x;     ///< Best solution in the original variables.
+  };
+
+
+  /**
+   * \brief Solve .nl instances with the branch-and-bound of the bnb solver,
+   * one after the other, without starting a new process for each.
+   *
+   * The ampl interface and the engines are created once and reused for all
+   * instances. Options of the environment are saved once (usually after
+   * reading the command line) and restored before each solve, so options
+   * given for one solve do not leak into the next. Options that select or
+   * configure engines take effect only when the engine is first created.
+   */
+  class BnbDriver {
+    public:
+      /**
+       * \brief Constructor. It sets the default options of bnb and adds the
+       * options of the ampl interface. Options should be read after it.
+       */
+      BnbDriver(EnvPtr env);
+
+      /// Destroy.
+      ~BnbDriver();
+
+      /// Return the number of instances solved so far.
+      UInt getNumSolves() const;
+
+      /// Save the current options. They are restored before each solve.
+      void saveOptions();
+
+      /**
+       * \brief Read and solve an instance.
+       *
+       * \param[in] fname The .nl file.
+       * \param[in] opts Options for this solve only, as on the command line,
+       * e.g. "--bnb_time_limit 10". May be empty.
+       * \param[out] res The result. May be NULL.
+       * \return 0 if the instance was read and solved, else 1.
+       */
+      int solve(const std::string &fname, const std::string &opts,
+                BnbResult *res);
+
+      /// Write statistics of all solves to out.
+      void writeStats(std::ostream &out) const;
+
+    private:
+      /// Saved values of bool options and flags.
+      std::vector<std::pair<BoolOptionPtr, bool> > boolOpts_;
+
+      /// Saved values of double options.
+      std::vector<std::pair<DoubleOptionPtr, double> > dblOpts_;
+
+      /// Environment shared by all solves.
+      EnvPtr env_;
+
+      /// Interface that reads the instances.
+      MINOTAUR_AMPL::AMPLInterface *iface_;
+
+      /// Saved values of int options.
+      std::vector<std::pair<IntOptionPtr, int> > intOpts_;
+
+      /// Engine for linear problems. Created when first needed.
+      EnginePtr lpe_;
+
+      /// For logging.
+      static const std::string me_;
+
+      /// Engine for nonlinear problems. Created when first needed.
+      EnginePtr nlpe_;
+
+      /// Number of solves.
+      UInt numSolves_;
+
+      /// Engine for quadratic problems. Created when first needed.
+      EnginePtr qpe_;
+
+      /// Saved values of string options.
+      std::vector<std::pair<StringOptionPtr, std::string> > strOpts_;
+
+      /// Total time of all solves.
+      double time_;
+
+      /// Timer for each solve.
+      Timer *timer_;
+
+      /// Set up branch-and-bound for p with the engine e.
+      BranchAndBound* createBab_(ProblemPtr p, EnginePtr e,
+                                 HandlerVector &handlers);
+
+      /// Create the brancher chosen in the options.
+      BrancherPtr createBrancher_(ProblemPtr p, HandlerVector handlers,
+                                  EnginePtr e);
+
+      /**
+       * Return an engine for p, creating it if it is the first of its kind.
+       * The engine is cleared before it is returned. NULL if none.
+       */
+      EnginePtr getEngine_(ProblemPtr p);
+
+      /**
+       * Read the instance in fname, or load it from the snapshot file if
+       * one can be used. ndefs is set to the number of defined variables.
+       * Return NULL if it can not be read.
+       */
+      ProblemPtr loadProblem_(const std::string &fname, double *obj_sense,
+                              size_t *ndefs);
+
+      /// Presolve p and return the presolver.
+      PresolverPtr presolve_(ProblemPtr p, size_t ndefs,
+                             HandlerVector &handlers);
+
+      /// Set the values saved by saveOptions().
+      void restoreOptions_();
+
+      /**
+       * Return true if the snapshot file snap may be loaded instead of
+       * the instance fname: it must be newer than the instance, and the
+       * problem must not need the AMPL interface after it is read.
+       */
+      bool useSnapshot_(const std::string &fname, const std::string &snap);
+
+      /// Write the solution, and copy it to res if it is not NULL.
+      void writeSol_(VarVector *orig_v, PresolverPtr pres, SolutionPtr sol,
+                     SolveStatus status, BnbResult *res);
+
+      /// Write the status and bounds at the end of a solve.
+      void writeStatus_(const BnbResult &res);
+  };
+}
+#endif
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
@@ -0,0 +1,331 @@
+//
+//    MINOTAUR -- It's only 1/2 bull
+//
+//    (C)opyright 2009 - 2014 The MINOTAUR Team.
+//
+
+/**
+ * \file BnbServer.cpp
+ * \brief The main function of a server that keeps running and solves
+ * instances in ampl format (.nl) by branch-and-bound, one request at a time.
+ * \author Ashutosh Mahajan, IIT Bombay
+ *
+ * Requests are read one line at a time, either from stdin or from clients
+ * connecting to a Unix socket (option server_socket). The requests are:
+ *
+ *   solve <nl-file> [--option value ...]
+ *   stats
+ *   quit
+ *
+ * Each reply ends with a line "end". The reply to solve has the lines
+ * "status", "objective", "bound", "gap", "time", "nodes" and "solution <n>
+ * x_1 ... x_n". Errors are reported as "error <message>". Log messages of
+ * the solver are written to stderr.
+ */
+
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "MinotaurConfig.h"
+#include "BnbDriver.h"
+#include "Environment.h"
+#include "Logger.h"
+#include "Option.h"
+
+using namespace Minotaur;
+
+const std::string me("bnbserver: ");
+
+
+void showHelp()
+{
+  std::cout << "Server that solves convex MINLPs by NLP-based "
+            << "branch-and-bound" << std::endl
+            << "Usage:" << std::endl
+            << "To show version: bnbserver -v (or --show_version yes) "
+            << std::endl
+            << "To show all options: bnbserver -= (or --show_options yes)"
+            << std::endl
+            << "To read requests from stdin: bnbserver --option1 [value] "
+            << "--option2 [value] ... " << std::endl
+            << "To listen on a Unix socket: bnbserver --server_socket path "
+            << "--option1 [value] ... " << std::endl
+            << "Requests: solve <nl-file> [--option value ...], stats, quit"
+            << std::endl;
+}
+
+
+int showInfo(EnvPtr env)
+{
+  OptionDBPtr options = env->getOptions();
+
+  if (options->findBool("show_options")->getValue() ||
+      options->findFlag("=")->getValue()) {
+    options->write(std::cout);
+    return 1;
+  }
+
+  if (options->findBool("show_help")->getValue() ||
+      options->findFlag("?")->getValue()) {
+    showHelp();
+    return 1;
+  }
+
+  if (options->findBool("show_version")->getValue() ||
+      options->findFlag("v")->getValue()) {
+    env->getLogger()->msgStream(LogNone) << me << "Minotaur version "
+      << env->getVersion() << std::endl;
+    return 1;
+  }
+
+  env->getLogger()->errStream() << me << "Minotaur version "
+    << env->getVersion() << std::endl;
+  return 0;
+}
+
+
+// Serve one request and write the reply to out. Return 1 if the server
+// should stop, else 0.
+int serve(BnbDriver *driver, const std::string &line, std::ostream &out)
+{
+  std::istringstream iss(line);
+  std::string cmd, fname, opts;
+  BnbResult res;
+
+  iss >> cmd;
+  if (cmd.empty() || '#'==cmd[0]) {
+    return 0;
+  } else if ("quit"==cmd) {
+    out << "end" << std::endl;
+    return 1;
+  } else if ("stats"==cmd) {
+    driver->writeStats(out);
+  } else if ("solve"==cmd) {
+    iss >> fname;
+    std::getline(iss, opts);
+    if (fname.empty()) {
+      out << "error no file given" << std::endl;
+    } else if (0!=driver->solve(fname, opts, &res)) {
+      out << "error could not solve " << fname << std::endl;
+    } else {
+      out << std::setprecision(17)
+          << "status " << getSolveStatusString(res.status) << std::endl
+          << "objective " << res.objValue << std::endl
+          << "bound " << res.lb << std::endl
+          << "gap " << res.gap << std::endl
+          << "time " << res.time << std::endl
+          << "nodes " << res.nodes << std::endl
+          << "solution " << res.x.size();
+      for (UInt i=0; i<res.x.size(); ++i) {
+        out << " " << res.x[i];
+      }
+      out << std::endl;
+    }
+  } else {
+    out << "error unknown request " << cmd << std::endl;
+  }
+  out << "end" << std::endl;
+  return 0;
+}
+
+
+// Read requests from a connected client until it closes the connection or
+// asks to quit. Return 1 if the server should stop.
+int serveClient(BnbDriver *driver, int fd)
+{
+  std::string buf;
+  char chunk[4096];
+  size_t pos;
+  ssize_t n;
+  int stop = 0;
+
+  while (0==stop) {
+    pos = buf.find('\n');
+    if (std::string::npos==pos) {
+      n = read(fd, chunk, sizeof(chunk));
+      if (n<0 && EINTR==errno) {
+        continue;
+      } else if (n<=0) {
+        break;
+      }
+      buf.append(chunk, n);
+      continue;
+    }
+
+    std::ostringstream out;
+    std::string reply;
+    const char *p;
+    size_t left;
+
+    stop = serve(driver, buf.substr(0, pos), out);
+    buf.erase(0, pos+1);
+    reply = out.str();
+    p = reply.c_str();
+    left = reply.size();
+    while (left>0) {
+      n = write(fd, p, left);
+      if (n<0 && EINTR==errno) {
+        continue;
+      } else if (n<=0) {
+        return stop;
+      }
+      p += n;
+      left -= n;
+    }
+  }
+  return stop;
+}
+
+
+// Remove a stale socket at path. Return 1 if path exists and is not a
+// socket, else 0.
+int removeSocket(const std::string &path)
+{
+  struct stat st;
+
+  if (0!=lstat(path.c_str(), &st)) {
+    return 0;
+  } else if (!S_ISSOCK(st.st_mode)) {
+    return 1;
+  }
+  unlink(path.c_str());
+  return 0;
+}
+
+
+// Listen on a Unix socket and serve clients one after the other.
+int serveSocket(EnvPtr env, BnbDriver *driver, const std::string &path)
+{
+  struct sockaddr_un addr;
+  int sfd, cfd;
+  int stop = 0;
+
+  if (path.size() >= sizeof(addr.sun_path)) {
+    env->getLogger()->errStream() << me << "socket path is too long: "
+      << path << std::endl;
+    return 1;
+  }
+  sfd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (sfd<0) {
+    env->getLogger()->errStream() << me << "could not create socket: "
+      << strerror(errno) << std::endl;
+    return 1;
+  }
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path)-1);
+  if (0!=removeSocket(path)) {
+    env->getLogger()->errStream() << me << path << " exists and is not a "
+      << "socket" << std::endl;
+    close(sfd);
+    return 1;
+  }
+  if (bind(sfd, (struct sockaddr *) &addr, sizeof(addr))<0 ||
+      listen(sfd, 8)<0) {
+    env->getLogger()->errStream() << me << "could not listen on " << path
+      << ": " << strerror(errno) << std::endl;
+    close(sfd);
+    return 1;
+  }
+
+  // a client that goes away should not kill the server.
+  signal(SIGPIPE, SIG_IGN);
+  env->getLogger()->errStream() << me << "listening on " << path
+    << std::endl;
+  while (0==stop) {
+    cfd = accept(sfd, 0, 0);
+    if (cfd<0) {
+      if (EINTR==errno) {
+        continue;
+      }
+      env->getLogger()->errStream() << me << "accept failed: "
+        << strerror(errno) << std::endl;
+      break;
+    }
+    stop = serveClient(driver, cfd);
+    close(cfd);
+  }
+  close(sfd);
+  removeSocket(path);
+  return 0;
+}
+
+
+// Read requests from stdin and write the replies to stdout.
+int serveStdin(BnbDriver *driver, std::ostream &out)
+{
+  std::string line;
+
+  while (std::getline(std::cin, line)) {
+    if (0!=serve(driver, line, out)) {
+      break;
+    }
+    out.flush();
+  }
+  return 0;
+}
+
+
+int main(int argc, char** argv)
+{
+  EnvPtr env      = (EnvPtr) new Environment();
+  BnbDriver *driver = 0;
+  std::streambuf *stdout_buf = std::cout.rdbuf();
+  std::string path;
+  int err = 0;
+
+  env->startTimer(err);
+  if (err) {
+    goto CLEANUP;
+  }
+
+  // Important to setup the driver first as it sets default options and
+  // adds the options of the AMPL Interface.
+  driver = new BnbDriver(env);
+
+  // Parse command line for options set by the user. These are the defaults
+  // of all requests.
+  env->readOptions(argc, argv);
+  if (0!=showInfo(env)) {
+    goto CLEANUP;
+  }
+  driver->saveOptions();
+
+  path = env->getOptions()->findString("server_socket")->getValue();
+  if (path.empty()) {
+    // stdout carries the replies. Send the log messages to stderr.
+    std::ostream out(stdout_buf);
+    std::cout.rdbuf(std::cerr.rdbuf());
+    serveStdin(driver, out);
+    std::cout.rdbuf(stdout_buf);
+  } else {
+    err = serveSocket(env, driver, path);
+  }
+
+CLEANUP:
+  if (driver) {
+    delete driver;
+  }
+
+  return err;
+}
+
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
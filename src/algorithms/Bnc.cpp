@@ -16,6 +16,8 @@
 
 #include "MinotaurConfig.h"
 #include "BranchAndBound.h"
+#include "CliqueHandler.h"
+#include "ConflictAnalyzer.h"
 #include "EngineFactory.h"
 #include "Environment.h"
 #include "IntVarHandler.h"
@@ -26,6 +28,7 @@
 #include "LPEngine.h"
 #include "MaxVioBrancher.h"
 #include "MINLPDiving.h"
+#include "MipStart.h"
 #include "NLPEngine.h"
 #include "NlPresHandler.h"
 #include "NodeIncRelaxer.h"
@@ -39,6 +42,7 @@
 #include "Relaxation.h"
 #include "ReliabilityBrancher.h"
 #include "Solution.h"
+#include "SymmetryHandler.h"
 #include "Timer.h"
 #include "TreeManager.h"
 
@@ -99,6 +103,7 @@ BranchAndBound* createBab (EnvPtr env, ProblemPtr p, EnginePtr e,
   NodeIncRelaxerPtr nr;
   RelaxationPtr rel;
   BrancherPtr br;
+  MipStartPtr ms_heur;
   SimpleCutMan* cutman = new SimpleCutMan(env, p);
   KnapCovHandlerPtr khand = (KnapCovHandlerPtr) new KnapCovHandler(env, p);
   OptionDBPtr options = env->getOptions();
@@ -106,7 +111,15 @@ BranchAndBound* createBab (EnvPtr env, ProblemPtr p, EnginePtr e,
 
   handlers.push_back(v_hand);
   handlers.push_back(l_hand);
+  if (true==options->findBool("clique_table")->getValue()) {
+    CliqueHandlerPtr c_hand = (CliqueHandlerPtr) new CliqueHandler(env, p);
+    khand->setCliqueTable(c_hand->getCliqueTable());
+    handlers.push_back(c_hand);
+  }
   handlers.push_back(khand);
+  if (options->findInt("symmetry")->getValue() > 0) {
+    handlers.push_back((SymmetryHandlerPtr) new SymmetryHandler(env, p));
+  }
   if (!p->isLinear() &&
       true==options->findBool("use_native_cgraph")->getValue() &&
       true==options->findBool("nl_presolve")->getValue()) {
@@ -120,6 +133,18 @@ BranchAndBound* createBab (EnvPtr env, ProblemPtr p, EnginePtr e,
   bab->setNodeProcessor(nproc);
 
   nproc->setCutManager(cutman);
+  if (2==options->findInt("symmetry")->getValue() &&
+      true==options->findBool("conflict_analysis")->getValue()) {
+    // learned conflicts replay only the branching decisions, not the
+    // variables fixed by orbital fixing, and could cut off solutions.
+    env->getLogger()->msgStream(LogInfo) << me << "conflict analysis is "
+      << "disabled with orbital fixing (symmetry 2)" << std::endl;
+    options->findBool("conflict_analysis")->setValue(false);
+  }
+  if (true==options->findBool("conflict_analysis")->getValue()) {
+    nproc->setConflictAnalyzer((ConflictAnalyzerPtr)
+                               new ConflictAnalyzer(env));
+  }
 
   nr = (NodeIncRelaxerPtr) new NodeIncRelaxer(env, handlers);
   rel = (RelaxationPtr) new Relaxation(p);
@@ -138,6 +163,10 @@ BranchAndBound* createBab (EnvPtr env, ProblemPtr p, EnginePtr e,
   bab->shouldCreateRoot(false);
 
   // heuristic
+  ms_heur = MipStart::create(env, p, rel, e);
+  if (ms_heur) {
+    bab->addPreRootHeur(ms_heur);
+  }
   if (0 <= options->findInt("divheur")->getValue()) {
     MINLPDivingPtr div_heur;
     EnginePtr e2 = e->emptyCopy();
@@ -28,6 +28,7 @@
 #include "NLPEngine.h"
 #include "NLPMultiStart.h"
 #include "NlPresHandler.h"
+#include "ObbtHandler.h"
 #include "Objective.h"
 #include "Option.h"
 #include "PCBProcessor.h"
@@ -198,6 +199,13 @@ BranchAndBound * createBab (EnvPtr env, ProblemPtr p, EnginePtr e,
   }
   env->getLogger()->msgStream(LogExtraInfo) << me 
     << "brancher used = " << br->getName() << std::endl;
+
+  // bounds found by OBBT must be seen by the other handlers in the same
+  // node.
+  if (env->getOptions()->findBool("obbt")->getValue() == true) {
+    handlers.insert(handlers.begin(),
+                    (ObbtHandlerPtr) new ObbtHandler(env, p, e));
+  }
   nproc = (PCBProcessorPtr) new PCBProcessor(env, e, handlers);
   nproc->setBrancher(br);
   bab->setNodeProcessor(nproc);
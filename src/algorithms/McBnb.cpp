@@ -32,6 +32,7 @@
 #include "MaxFreqBrancher.h"
 #include "MaxVioBrancher.h"
 #include "MINLPDiving.h"
+#include "MipStart.h"
 #include "NLPEngine.h"
 #include "NlPresHandler.h"
 #include "NodeIncRelaxer.h"
@@ -68,6 +69,7 @@ ParBranchAndBound* createParBab(EnvPtr env, ProblemPtr p, EnginePtr e,
 {
   ParBranchAndBound *bab = new ParBranchAndBound(env, p);
   const std::string me("mcbnb main: ");
+  MipStartPtr ms_heur;
   OptionDBPtr options = env->getOptions();
   bab->shouldCreateRoot(false);
 #if USE_OPENMP
@@ -130,6 +132,10 @@ ParBranchAndBound* createParBab(EnvPtr env, ProblemPtr p, EnginePtr e,
     parNodeRlxr[i]->setEngine(eCopy);
   }
 
+  ms_heur = MipStart::create(env, p, relCopy[0], e);
+  if (ms_heur) {
+    bab->addPreRootHeur(ms_heur);
+  }
   if (0 <= options->findInt("divheur")->getValue()) {
     MINLPDivingPtr div_heur;
     EnginePtr e2 = e->emptyCopy();
@@ -37,6 +37,7 @@
 #include "MaxFreqBrancher.h"
 #include "MaxVioBrancher.h"
 #include "MINLPDiving.h"
+#include "MipStart.h"
 #include "NLPEngine.h"
 #include "NlPresHandler.h"
 #include "NodeIncRelaxer.h"
@@ -75,6 +76,7 @@ BranchAndBound* createBab(EnvPtr env, ProblemPtr p, EnginePtr e,
   NodeIncRelaxerPtr nr;
   RelaxationPtr rel;
   BrancherPtr br;
+  MipStartPtr ms_heur;
   const std::string me("midfo main: ");
   OptionDBPtr options = env->getOptions();
   SOS2HandlerPtr s2_hand;
@@ -132,6 +134,10 @@ BranchAndBound* createBab(EnvPtr env, ProblemPtr p, EnginePtr e,
   bab->setNodeRelaxer(nr);
   bab->shouldCreateRoot(false);
 
+  ms_heur = MipStart::create(env, p, rel, e);
+  if (ms_heur) {
+    bab->addPreRootHeur(ms_heur);
+  }
   if (0 <= options->findInt("divheur")->getValue()) {
     MINLPDivingPtr div_heur;
     EnginePtr e2 = e->emptyCopy();
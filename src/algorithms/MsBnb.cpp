@@ -29,6 +29,7 @@
 #include "MaxFreqBrancher.h"
 #include "MaxVioBrancher.h"
 #include "MINLPDiving.h"
+#include "MipStart.h"
 #include "MsProcessor.h"
 #include "NLPEngine.h"
 #include "NlPresHandler.h"
@@ -68,6 +69,7 @@ BranchAndBound* createBab(EnvPtr env, ProblemPtr p, EnginePtr e,
   NodeIncRelaxerPtr nr;
   RelaxationPtr rel;
   BrancherPtr br;
+  MipStartPtr ms_heur;
   const std::string me("msbnb main: ");
   OptionDBPtr options = env->getOptions();
   SOS2HandlerPtr s2_hand;
@@ -129,6 +131,10 @@ BranchAndBound* createBab(EnvPtr env, ProblemPtr p, EnginePtr e,
   bab->setNodeRelaxer(nr);
   bab->shouldCreateRoot(false);
 
+  ms_heur = MipStart::create(env, p, rel, e);
+  if (ms_heur) {
+    bab->addPreRootHeur(ms_heur);
+  }
   if (0 <= options->findInt("divheur")->getValue()) {
     MINLPDivingPtr div_heur;
     EnginePtr e2 = e->emptyCopy();
@@ -16,6 +16,7 @@
 #include <MinotaurConfig.h>
 #include <AMPLHessian.h>
 #include <AMPLJacobian.h>
+#include <CutMan2.h>
 #include <Environment.h>
 #include <Handler.h>
 #include <Option.h>
@@ -271,6 +272,7 @@ int main(int argc, char* argv[])
 
   BrancherPtr br = BrancherPtr(); // NULL
   PCBProcessorPtr nproc;
+  CutMan2 *cutman = 0;
 
   NodeIncRelaxerPtr nr;
 
@@ -380,6 +382,12 @@ int main(int argc, char* argv[])
 
     nr->setEngine(lin_e);
     nproc = (PCBProcessorPtr) new PCBProcessor(env, lin_e, handlers);
+    if (true==options->findBool("qg_cut_aging")->getValue()) {
+      // cuts that stay inactive are moved out of the LP relaxation.
+      cutman = new CutMan2(env, inst);
+      nproc->setCutManager(cutman);
+      qg_hand->setCutManager(cutman);
+    }
 
     if (env->getOptions()->findString("brancher")->getValue() == "rel") {
       ReliabilityBrancherPtr rel_br = 
@@ -436,6 +444,9 @@ CLEANUP:
   if (bab) {
     delete bab;
   }
+  if (cutman) {
+    delete cutman;
+  }
 
   return 0;
 }
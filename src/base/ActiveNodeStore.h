@@ -44,6 +44,12 @@ namespace Minotaur {
        /// Find the maximum depth of all active nodes.
        virtual UInt getDeepestLevel() const = 0;
 
+       /**
+        * \brief Append all active nodes, in no particular order, to nodes.
+        * The store is not modified.
+        */
+       virtual void getNodes(NodePtrVector *nodes) const = 0;
+
        /// Get the number of active nodes.
        virtual UInt getSize() const = 0;
 
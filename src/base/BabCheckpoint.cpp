@@ -0,0 +1,596 @@
+//
+//     MINOTAUR -- It's only 1/2 bull
+//
+//     (C)opyright 2008 - 2014 The MINOTAUR Team.
+//
+
+/**
+ * \file BabCheckpoint.cpp
+ * \brief Define the BabCheckpoint class that saves the state of
+ * branch-and-bound in a file so that the search can be resumed later.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+
+#include "MinotaurConfig.h"
+#include "BabCheckpoint.h"
+#include "Branch.h"
+#include "Brancher.h"
+#include "Constraint.h"
+#include "Environment.h"
+#include "Function.h"
+#include "LinearFunction.h"
+#include "Logger.h"
+#include "Modification.h"
+#include "Node.h"
+#include "Option.h"
+#include "Relaxation.h"
+#include "Solution.h"
+#include "Timer.h"
+#include "VarBoundMod.h"
+#include "Variable.h"
+
+using namespace Minotaur;
+
+const std::string BabCheckpoint::me_ = "BabCheckpoint: ";
+const UInt BabCheckpoint::version_ = 1;
+
+// First bytes of a checkpoint file.
+static const char ckptMagic[8] = {'M', 'N', 'T', 'R', 'C', 'K', 'P', 'T'};
+
+// Written as a number to check the byte order.
+static const UInt ckptOrder = 0x01020304;
+
+typedef std::map<UInt, double> CkptBounds;
+
+
+template <class T> static void ckptPut(std::vector<char> *buf, T v)
+{
+  const char *c = (const char *) &v;
+  buf->insert(buf->end(), c, c+sizeof(T));
+}
+
+
+template <class T> static bool ckptGet(const char **pos, const char *end,
+                                       T *v)
+{
+  if ((size_t) (end-*pos)<sizeof(T)) {
+    return false;
+  }
+  memcpy(v, *pos, sizeof(T));
+  *pos += sizeof(T);
+  return true;
+}
+
+
+template <class T> static void ckptPutVec(std::vector<char> *buf,
+                                          const std::vector<T> &v)
+{
+  const char *c = v.empty() ? 0 : (const char *) &(v[0]);
+  ckptPut<UInt>(buf, v.size());
+  buf->insert(buf->end(), c, c+v.size()*sizeof(T));
+}
+
+
+// Append the vector at pos to v.
+template <class T> static bool ckptGetVec(const char **pos, const char *end,
+                                          std::vector<T> *v)
+{
+  UInt n = 0;
+  size_t k = v->size();
+
+  if (!ckptGet<UInt>(pos, end, &n) || (size_t) (end-*pos)<n*sizeof(T)) {
+    return false;
+  }
+  v->resize(k+n);
+  if (n>0) {
+    memcpy(&((*v)[k]), *pos, n*sizeof(T));
+  }
+  *pos += n*sizeof(T);
+  return true;
+}
+
+
+// Record the change of bounds in mod, if it changes bounds of a variable.
+static void ckptAddMod(CkptBounds *bnds, ModificationPtr mod)
+{
+  VarBoundModPtr bmod = boost::dynamic_pointer_cast<VarBoundMod>(mod);
+  VarBoundMod2Ptr bmod2;
+  UInt k;
+
+  if (bmod) {
+    k = 2*bmod->getVar()->getIndex() + (Upper==bmod->getLU() ? 1 : 0);
+    (*bnds)[k] = bmod->getNewVal();
+  } else {
+    bmod2 = boost::dynamic_pointer_cast<VarBoundMod2>(mod);
+    if (bmod2) {
+      k = 2*bmod2->getVar()->getIndex();
+      (*bnds)[k] = bmod2->getNewLb();
+      (*bnds)[k+1] = bmod2->getNewUb();
+    }
+  }
+}
+
+
+static void ckptPutBounds(std::vector<char> *buf, const CkptBounds &bnds)
+{
+  ckptPut<UInt>(buf, bnds.size());
+  for (CkptBounds::const_iterator it=bnds.begin(); it!=bnds.end(); ++it) {
+    ckptPut<UInt>(buf, it->first);
+    ckptPut<double>(buf, it->second);
+  }
+}
+
+
+static bool ckptGetBounds(const char **pos, const char *end,
+                          UIntVector *keys, DoubleVector *vals)
+{
+  UInt n = 0, k = 0;
+  double d = 0.0;
+
+  if (!ckptGet<UInt>(pos, end, &n)) {
+    return false;
+  }
+  for (UInt i=0; i<n; ++i) {
+    if (!ckptGet<UInt>(pos, end, &k) || !ckptGet<double>(pos, end, &d)) {
+      return false;
+    }
+    keys->push_back(k);
+    vals->push_back(d);
+  }
+  return true;
+}
+
+
+BabCheckpoint::BabCheckpoint(EnvPtr env, ProblemPtr p)
+  : env_(env),
+    firstCut_(0),
+    incVal_(INFINITY),
+    next_(0.0),
+    nodesProc_(0),
+    p_(p),
+    restarts_(0),
+    time_(0.0),
+    writes_(0)
+{
+  OptionDBPtr options = env->getOptions();
+
+  logger_ = env->getLogger();
+  fname_ = options->findString("bnb_checkpoint_file")->getValue();
+  interval_ = options->findDouble("bnb_checkpoint_interval")->getValue();
+  resumeName_ = options->findString("bnb_resume_file")->getValue();
+  next_ = interval_;
+  timer_ = env->getNewTimer();
+}
+
+
+BabCheckpoint::~BabCheckpoint()
+{
+  delete timer_;
+  p_.reset();
+}
+
+
+void BabCheckpoint::addCuts(RelaxationPtr rel)
+{
+  LinearFunctionPtr lf;
+  FunctionPtr f;
+  UInt n = rel->getNumVars();
+  UInt added = 0;
+  bool ok;
+
+  for (UInt i=0; i+1<cutStart_.size(); ++i) {
+    ok = true;
+    lf = (LinearFunctionPtr) new LinearFunction();
+    for (UInt j=cutStart_[i]; j<cutStart_[i+1]; ++j) {
+      if (cutInd_[j]>=n) {
+        ok = false;
+        break;
+      }
+      lf->addTerm(rel->getVariable(cutInd_[j]), cutCoef_[j]);
+    }
+    if (ok) {
+      f = (FunctionPtr) new Function(lf);
+      rel->newConstraint(f, cutBnds_[2*i], cutBnds_[2*i+1]);
+      ++added;
+    }
+  }
+  logger_->msgStream(LogExtraInfo) << me_ << "added " << added << " cuts"
+                                   << std::endl;
+}
+
+
+const DoubleVector & BabCheckpoint::getBrancherState() const
+{
+  return brState_;
+}
+
+
+const double * BabCheckpoint::getIncumbent() const
+{
+  return inc_.empty() ? 0 : &(inc_[0]);
+}
+
+
+double BabCheckpoint::getIncumbentValue() const
+{
+  return incVal_;
+}
+
+
+void BabCheckpoint::getNodes(NodePtr root, RelaxationPtr rel,
+                             NodePtrVector *nodes)
+{
+  NodePtr node;
+  VarBoundModPtr mod;
+  UInt k, nr = rel->getNumVars(), np = p_->getNumVars();
+
+  for (UInt i=0; 3*i<nodeInfo_.size(); ++i) {
+    node = (NodePtr) new Node(root, BranchPtr());
+    node->setLb(nodeInfo_[3*i]);
+    node->setDepth((UInt) nodeInfo_[3*i+1]);
+    node->setTbScore(nodeInfo_[3*i+2]);
+    for (UInt j=nodeStart_[2*i]; j<nodeStart_[2*i+1]; ++j) {
+      k = nodeKey_[j];
+      if (k/2<nr) {
+        mod = (VarBoundModPtr) new VarBoundMod(rel->getVariable(k/2),
+                                               (k%2) ? Upper : Lower,
+                                               nodeVal_[j]);
+        node->addRMod(mod);
+      }
+    }
+    for (UInt j=nodeStart_[2*i+1]; j<nodeStart_[2*i+2]; ++j) {
+      k = nodeKey_[j];
+      if (k/2<np) {
+        mod = (VarBoundModPtr) new VarBoundMod(p_->getVariable(k/2),
+                                               (k%2) ? Upper : Lower,
+                                               nodeVal_[j]);
+        node->addPMod(mod);
+      }
+    }
+    root->addChild(node);
+    nodes->push_back(node);
+  }
+}
+
+
+UInt BabCheckpoint::getNodesProc() const
+{
+  return nodesProc_;
+}
+
+
+UInt BabCheckpoint::getRestarts() const
+{
+  return restarts_;
+}
+
+
+double BabCheckpoint::getTime() const
+{
+  return time_;
+}
+
+
+bool BabCheckpoint::isDue(double now) const
+{
+  return (!fname_.empty() && now>=next_);
+}
+
+
+bool BabCheckpoint::isOn() const
+{
+  return !fname_.empty();
+}
+
+
+void BabCheckpoint::putPath_(std::vector<char> *buf, NodePtr node)
+{
+  NodePtrVector path;
+  CkptBounds rbnds, pbnds;
+  BranchPtr br;
+  NodePtr n;
+
+  for (n=node; n; n=n->getParent()) {
+    path.push_back(n);
+  }
+  // later changes overwrite earlier ones.
+  for (NodePtrVector::reverse_iterator it=path.rbegin(); it!=path.rend();
+       ++it) {
+    n = *it;
+    br = n->getBranch();
+    if (br) {
+      for (ModificationConstIterator mit=br->rModsBegin();
+           mit!=br->rModsEnd(); ++mit) {
+        ckptAddMod(&rbnds, *mit);
+      }
+      for (ModificationConstIterator mit=br->pModsBegin();
+           mit!=br->pModsEnd(); ++mit) {
+        ckptAddMod(&pbnds, *mit);
+      }
+    }
+    for (ModificationConstIterator mit=n->rModsBegin(); mit!=n->rModsEnd();
+         ++mit) {
+      ckptAddMod(&rbnds, *mit);
+    }
+    for (ModificationConstIterator mit=n->modsBegin(); mit!=n->modsEnd();
+         ++mit) {
+      ckptAddMod(&pbnds, *mit);
+    }
+  }
+  ckptPutBounds(buf, rbnds);
+  ckptPutBounds(buf, pbnds);
+}
+
+
+bool BabCheckpoint::read()
+{
+  std::ifstream in;
+  std::vector<char> buf;
+  const char *pos, *end;
+  UInt version = 0, order = 0, n = 0, ncuts = 0, nnodes = 0, depth = 0;
+  double d[3] = {0.0, 0.0, 0.0};
+  bool ok;
+
+  if (resumeName_.empty()) {
+    return false;
+  }
+  in.open(resumeName_.c_str(), std::ios::binary);
+  if (in.is_open()) {
+    in.seekg(0, std::ios::end);
+    buf.resize((size_t) in.tellg());
+    in.seekg(0, std::ios::beg);
+    if (!buf.empty()) {
+      in.read(&(buf[0]), buf.size());
+    }
+  }
+  if (in.fail() || buf.size()<=sizeof(ckptMagic)) {
+    logger_->errStream() << me_ << "can not read file " << resumeName_
+                         << std::endl;
+    return false;
+  }
+  in.close();
+  pos = &(buf[0]) + sizeof(ckptMagic);
+  end = &(buf[0]) + buf.size();
+
+  ok = 0==memcmp(&(buf[0]), ckptMagic, sizeof(ckptMagic)) &&
+    ckptGet<UInt>(&pos, end, &version) && ckptGet<UInt>(&pos, end, &order);
+  if (!ok || version!=version_ || order!=ckptOrder) {
+    logger_->errStream() << me_ << resumeName_ << " is not a checkpoint of "
+                         << "version " << version_ << " for this machine."
+                         << std::endl;
+    return false;
+  }
+
+  ok = ckptGet<UInt>(&pos, end, &n);
+  if (ok && n!=p_->getNumVars()) {
+    logger_->errStream() << me_ << resumeName_ << " was saved for a problem "
+                         << "with " << n << " variables, not "
+                         << p_->getNumVars() << std::endl;
+    return false;
+  }
+
+  rootLb_.clear();
+  rootUb_.clear();
+  inc_.clear();
+  brState_.clear();
+  ok = ok && ckptGetVec<double>(&pos, end, &rootLb_) &&
+    ckptGetVec<double>(&pos, end, &rootUb_) &&
+    ckptGet<UInt>(&pos, end, &nodesProc_) &&
+    ckptGet<UInt>(&pos, end, &restarts_) &&
+    ckptGet<double>(&pos, end, &time_) &&
+    ckptGetVec<double>(&pos, end, &inc_) &&
+    ckptGet<double>(&pos, end, &incVal_) &&
+    ckptGetVec<double>(&pos, end, &brState_) &&
+    ckptGet<UInt>(&pos, end, &ncuts);
+  ok = ok && rootLb_.size()==n && rootUb_.size()==n &&
+    (inc_.empty() || inc_.size()==n);
+
+  cutBnds_.clear();
+  cutInd_.clear();
+  cutCoef_.clear();
+  cutStart_.assign(1, 0);
+  for (UInt i=0; ok && i<ncuts; ++i) {
+    ok = ckptGet<double>(&pos, end, d) && ckptGet<double>(&pos, end, d+1) &&
+      ckptGetVec<UInt>(&pos, end, &cutInd_) &&
+      ckptGetVec<double>(&pos, end, &cutCoef_) &&
+      cutInd_.size()==cutCoef_.size();
+    cutBnds_.push_back(d[0]);
+    cutBnds_.push_back(d[1]);
+    cutStart_.push_back(cutInd_.size());
+  }
+
+  nodeInfo_.clear();
+  nodeKey_.clear();
+  nodeVal_.clear();
+  nodeStart_.assign(1, 0);
+  ok = ok && ckptGet<UInt>(&pos, end, &nnodes);
+  for (UInt i=0; ok && i<nnodes; ++i) {
+    ok = ckptGet<double>(&pos, end, d) && ckptGet<UInt>(&pos, end, &depth) &&
+      ckptGet<double>(&pos, end, d+2) &&
+      ckptGetBounds(&pos, end, &nodeKey_, &nodeVal_);
+    nodeStart_.push_back(nodeKey_.size());
+    ok = ok && ckptGetBounds(&pos, end, &nodeKey_, &nodeVal_);
+    nodeStart_.push_back(nodeKey_.size());
+    nodeInfo_.push_back(d[0]);
+    nodeInfo_.push_back(depth);
+    nodeInfo_.push_back(d[2]);
+  }
+
+  if (!ok || pos!=end) {
+    logger_->errStream() << me_ << resumeName_ << " is damaged."
+                         << std::endl;
+    nodeInfo_.clear();
+    return false;
+  }
+  logger_->msgStream(LogInfo) << me_ << "resuming from " << resumeName_
+                              << " with " << nnodes << " open nodes, "
+                              << ncuts << " cuts and " << nodesProc_
+                              << " nodes processed" << std::endl;
+  return true;
+}
+
+
+void BabCheckpoint::restoreBounds(RelaxationPtr rel)
+{
+  VariablePtr v, rv;
+  double lb, ub;
+
+  for (UInt i=0; i<rootLb_.size(); ++i) {
+    v = p_->getVariable(i);
+    lb = std::max(rootLb_[i], v->getLb());
+    ub = std::min(rootUb_[i], v->getUb());
+    if (lb > v->getLb() || ub < v->getUb()) {
+      p_->changeBound(v, lb, ub);
+    }
+    rv = (rel && i<rel->getNumVars()) ? rel->getRelaxationVar(v) :
+      VariablePtr();
+    if (rv) {
+      lb = std::max(lb, rv->getLb());
+      ub = std::min(ub, rv->getUb());
+      if (lb > rv->getLb() || ub < rv->getUb()) {
+        rel->changeBound(rv, lb, ub);
+      }
+    }
+  }
+}
+
+
+void BabCheckpoint::setRoot(RelaxationPtr rel)
+{
+  rootLb_.clear();
+  rootUb_.clear();
+  for (VariableConstIterator it=p_->varsBegin(); it!=p_->varsEnd(); ++it) {
+    rootLb_.push_back((*it)->getLb());
+    rootUb_.push_back((*it)->getUb());
+  }
+  firstCut_ = 0;
+  if (rel) {
+    for (ConstraintConstIterator it=rel->consBegin(); it!=rel->consEnd();
+         ++it) {
+      firstCut_ = std::max(firstCut_, (*it)->getId()+1);
+    }
+  }
+}
+
+
+bool BabCheckpoint::shouldResume() const
+{
+  return !resumeName_.empty();
+}
+
+
+bool BabCheckpoint::write(const NodePtrVector &nodes, RelaxationPtr rel,
+                          ConstSolutionPtr sol, BrancherPtr br,
+                          UInt nodes_proc, UInt restarts, double now)
+{
+  std::vector<char> buf;
+  std::vector<char> cuts;
+  std::ofstream out;
+  std::string tmp = fname_ + ".tmp";
+  DoubleVector state;
+  ConstraintPtr c;
+  FunctionPtr f;
+  LinearFunctionPtr lf;
+  UIntVector ind;
+  DoubleVector coef;
+  UInt ncuts = 0;
+  double wtime;
+
+  timer_->start();
+  buf.insert(buf.end(), ckptMagic, ckptMagic+sizeof(ckptMagic));
+  ckptPut<UInt>(&buf, version_);
+  ckptPut<UInt>(&buf, ckptOrder);
+  ckptPut<UInt>(&buf, p_->getNumVars());
+  ckptPutVec<double>(&buf, rootLb_);
+  ckptPutVec<double>(&buf, rootUb_);
+  ckptPut<UInt>(&buf, nodes_proc);
+  ckptPut<UInt>(&buf, restarts);
+  ckptPut<double>(&buf, time_+now);
+  if (sol) {
+    ckptPutVec<double>(&buf, DoubleVector(sol->getPrimal(),
+                                          sol->getPrimal()+
+                                          p_->getNumVars()));
+    ckptPut<double>(&buf, sol->getObjValue());
+  } else {
+    ckptPutVec<double>(&buf, DoubleVector());
+    ckptPut<double>(&buf, INFINITY);
+  }
+  if (br) {
+    br->saveState(&state);
+  }
+  ckptPutVec<double>(&buf, state);
+
+  // only linear cuts can be saved.
+  for (ConstraintConstIterator it=rel->consBegin(); it!=rel->consEnd();
+       ++it) {
+    c = *it;
+    f = c->getFunction();
+    if (c->getId()<firstCut_ || DeletedCons==c->getState() || !f ||
+        f->getType()!=Linear || !f->getLinearFunction()) {
+      continue;
+    }
+    lf = f->getLinearFunction();
+    ind.clear();
+    coef.clear();
+    for (VariableGroupConstIterator vit=lf->termsBegin();
+         vit!=lf->termsEnd(); ++vit) {
+      ind.push_back(vit->first->getIndex());
+      coef.push_back(vit->second);
+    }
+    ckptPut<double>(&cuts, c->getLb());
+    ckptPut<double>(&cuts, c->getUb());
+    ckptPutVec<UInt>(&cuts, ind);
+    ckptPutVec<double>(&cuts, coef);
+    ++ncuts;
+  }
+  ckptPut<UInt>(&buf, ncuts);
+  buf.insert(buf.end(), cuts.begin(), cuts.end());
+
+  ckptPut<UInt>(&buf, nodes.size());
+  for (NodePtrVector::const_iterator it=nodes.begin(); it!=nodes.end();
+       ++it) {
+    ckptPut<double>(&buf, (*it)->getLb());
+    ckptPut<UInt>(&buf, (*it)->getDepth());
+    ckptPut<double>(&buf, (*it)->getTbScore());
+    putPath_(&buf, *it);
+  }
+
+  out.open(tmp.c_str(), std::ios::binary);
+  out.write(&(buf[0]), buf.size());
+  out.close();
+  if (out.fail() || 0!=rename(tmp.c_str(), fname_.c_str())) {
+    logger_->errStream() << me_ << "can not write file " << fname_
+                         << std::endl;
+    timer_->stop();
+    next_ = now + interval_;
+    return false;
+  }
+  wtime = timer_->query();
+  timer_->stop();
+  ++writes_;
+  next_ = now + wtime + std::max(interval_, 20.0*wtime);
+  logger_->msgStream(LogExtraInfo) << me_ << "saved " << nodes.size()
+                                   << " open nodes and " << ncuts
+                                   << " cuts in " << wtime << " seconds"
+                                   << std::endl;
+  return true;
+}
+
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
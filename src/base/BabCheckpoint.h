@@ -0,0 +1,271 @@
+//
+//     MINOTAUR -- It's only 1/2 bull
+//
+//     (C)opyright 2008 - 2014 The MINOTAUR Team.
+//
+
+/**
+ * \file BabCheckpoint.h
+ * \brief Declare the BabCheckpoint class that saves the state of
+ * branch-and-bound in a file so that the search can be resumed later.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#ifndef MINOTAURBABCHECKPOINT_H
+#define MINOTAURBABCHECKPOINT_H
+
+#include <string>
+
+#include "Types.h"
+
+namespace Minotaur {
+
+  class Brancher;
+  class Logger;
+  class Node;
+  class Problem;
+  class Relaxation;
+  class Solution;
+  class Timer;
+  typedef boost::shared_ptr<Brancher> BrancherPtr;
+  typedef boost::shared_ptr<const Solution> ConstSolutionPtr;
+  typedef boost::shared_ptr<Logger> LoggerPtr;
+  typedef boost::shared_ptr<Node> NodePtr;
+  typedef boost::shared_ptr<Problem> ProblemPtr;
+  typedef boost::shared_ptr<Relaxation> RelaxationPtr;
+
+  /**
+   * \brief Save the state of branch-and-bound in a binary file and restore
+   * it, so that a search that is stopped, e.g. by a batch scheduler, can be
+   * continued without starting again from the root.
+   *
+   * A checkpoint has:
+   * - the bounds on the variables of the problem after the root, which
+   *   include the tightening done before a restart,
+   * - for each open node, its lower bound, depth, tie-breaking score and the
+   *   bounds on variables on the path from the root to it, for the
+   *   relaxation and the problem. Only the last change of each bound is
+   *   saved,
+   * - the linear cuts that were added to the relaxation after the root
+   *   relaxation was created,
+   * - the incumbent, the state of the brancher (e.g. pseudo costs), and the
+   *   number of nodes processed, restarts done and time used.
+   *
+   * Warm starts and modifications other than changes of bounds of variables
+   * are not saved. The resumed nodes are children of a new root that is not
+   * processed again.
+   *
+   * The file is written to a temporary file that is then renamed, so that a
+   * checkpoint is never left half written. The time between two checkpoints
+   * is at least the option bnb_checkpoint_interval, and at least twenty
+   * times the time taken to write the last one, so that writing does not
+   * take more than about 5% of the time even for large trees.
+   */
+  class BabCheckpoint {
+    public:
+      /// Constructor. Options are read from the environment.
+      BabCheckpoint(EnvPtr env, ProblemPtr p);
+
+      /// Destroy.
+      ~BabCheckpoint();
+
+      /**
+       * \brief Add the saved cuts to the relaxation rel. Cuts that have
+       * variables that are not in rel are skipped.
+       */
+      void addCuts(RelaxationPtr rel);
+
+      /// Return the state of the brancher that was read.
+      const DoubleVector & getBrancherState() const;
+
+      /// Return the saved incumbent, or NULL if there is none.
+      const double * getIncumbent() const;
+
+      /// Return the objective value of the saved incumbent.
+      double getIncumbentValue() const;
+
+      /**
+       * \brief Create the saved open nodes as children of root, and append
+       * them to nodes.
+       *
+       * \param[in] root The new root node. It must have id 0.
+       * \param[in] rel The relaxation, whose variables are modified by the
+       * relaxation modifications of the nodes.
+       * \param[out] nodes The vector to which new nodes are appended.
+       */
+      void getNodes(NodePtr root, RelaxationPtr rel, NodePtrVector *nodes);
+
+      /// Return the number of nodes processed before the checkpoint.
+      UInt getNodesProc() const;
+
+      /// Return the number of restarts done before the checkpoint.
+      UInt getRestarts() const;
+
+      /// Return the time used before the checkpoint.
+      double getTime() const;
+
+      /**
+       * \brief Return true if a checkpoint should be written now.
+       *
+       * \param[in] now The time since branch-and-bound started.
+       */
+      bool isDue(double now) const;
+
+      /// Return true if a file for checkpoints is given.
+      bool isOn() const;
+
+      /**
+       * \brief Read the file given in the option bnb_resume_file.
+       *
+       * \return False if no file is given, or if it can not be read, or if
+       * it was saved for a problem of another size.
+       */
+      bool read();
+
+      /**
+       * \brief Tighten the bounds of the variables of the problem and the
+       * relaxation rel to those saved after the root.
+       */
+      void restoreBounds(RelaxationPtr rel);
+
+      /**
+       * \brief Save the state at the root: the bounds on the variables of
+       * the problem, and the ids of the constraints of rel that are not
+       * cuts.
+       *
+       * It is called after the root relaxation is created and before any
+       * cut is added to it.
+       */
+      void setRoot(RelaxationPtr rel);
+
+      /// Return true if a file to resume from is given.
+      bool shouldResume() const;
+
+      /**
+       * \brief Write a checkpoint.
+       *
+       * \param[in] nodes All open nodes.
+       * \param[in] rel The relaxation, from which cuts are saved.
+       * \param[in] sol The incumbent. It may be NULL.
+       * \param[in] br The brancher.
+       * \param[in] nodes_proc The number of nodes processed.
+       * \param[in] restarts The number of restarts done.
+       * \param[in] now The time since branch-and-bound started.
+       * \return False if the file can not be written.
+       */
+      bool write(const NodePtrVector &nodes, RelaxationPtr rel,
+                 ConstSolutionPtr sol, BrancherPtr br, UInt nodes_proc,
+                 UInt restarts, double now);
+
+    private:
+      /// State of the brancher that was read.
+      DoubleVector brState_;
+
+      /// Lower and upper bound of each saved cut.
+      DoubleVector cutBnds_;
+
+      /// Coefficients of the variables of each saved cut.
+      DoubleVector cutCoef_;
+
+      /// Indices of the variables of each saved cut.
+      UIntVector cutInd_;
+
+      /// Start of each saved cut in cutInd_ and cutCoef_.
+      UIntVector cutStart_;
+
+      /// Environment.
+      EnvPtr env_;
+
+      /// File to write checkpoints to.
+      std::string fname_;
+
+      /// Constraints of the relaxation with this id or more are cuts.
+      UInt firstCut_;
+
+      /// Saved incumbent. Empty if there is none.
+      DoubleVector inc_;
+
+      /// Objective value of the saved incumbent.
+      double incVal_;
+
+      /// Minimum time in seconds between two checkpoints.
+      double interval_;
+
+      /// Log.
+      LoggerPtr logger_;
+
+      /// For logging.
+      static const std::string me_;
+
+      /// Time after which the next checkpoint is due.
+      double next_;
+
+      /**
+       * Bound changes of each saved node, as key and value. The key is twice
+       * the index of the variable, plus one for an upper bound.
+       */
+      UIntVector nodeKey_;
+
+      /// Lower bound, depth and tie-breaking score of each saved node.
+      DoubleVector nodeInfo_;
+
+      /**
+       * Start of the relaxation and the problem changes of each saved node
+       * in nodeKey_ and nodeVal_.
+       */
+      UIntVector nodeStart_;
+
+      /// New values of the bound changes in nodeKey_.
+      DoubleVector nodeVal_;
+
+      /// Number of nodes processed before the checkpoint that was read.
+      UInt nodesProc_;
+
+      /// The problem being solved.
+      ProblemPtr p_;
+
+      /// Number of restarts before the checkpoint that was read.
+      UInt restarts_;
+
+      /// File to resume from.
+      std::string resumeName_;
+
+      /// Lower bounds on the variables of the problem after the root.
+      DoubleVector rootLb_;
+
+      /// Upper bounds on the variables of the problem after the root.
+      DoubleVector rootUb_;
+
+      /// Time used before the checkpoint that was read.
+      double time_;
+
+      /// Timer for measuring the time taken to write.
+      Timer *timer_;
+
+      /// Version of the format.
+      static const UInt version_;
+
+      /// Number of checkpoints written.
+      UInt writes_;
+
+      /**
+       * Append the last change of each bound of variables on the path from
+       * the root to node to buf, first for the relaxation, then for the
+       * problem.
+       */
+      void putPath_(std::vector<char> *buf, NodePtr node);
+  };
+  typedef boost::shared_ptr<BabCheckpoint> BabCheckpointPtr;
+}
+#endif
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
@@ -0,0 +1,576 @@
+//
+//     MINOTAUR -- It's only 1/2 bull
+//
+//     (C)opyright 2008 - 2014 The MINOTAUR Team.
+//
+
+/**
+ * \file BabReopt.cpp
+ * \brief Define the BabReopt class that keeps information from one solve
+ * of branch-and-bound for the next solve of a modified problem.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#include <cmath>
+#include <iostream>
+#include <map>
+
+#include "MinotaurConfig.h"
+#include "BabReopt.h"
+#include "Branch.h"
+#include "Constraint.h"
+#include "Environment.h"
+#include "Function.h"
+#include "LinearFunction.h"
+#include "Logger.h"
+#include "Modification.h"
+#include "Node.h"
+#include "Objective.h"
+#include "Option.h"
+#include "Relaxation.h"
+#include "Solution.h"
+#include "VarBoundMod.h"
+#include "Variable.h"
+
+using namespace Minotaur;
+
+const std::string BabReopt::me_ = "BabReopt: ";
+
+typedef std::map<UInt, double> ReoptBounds;
+
+
+static void reoptAddMod(ReoptBounds *bnds, ModificationPtr mod)
+{
+  VarBoundModPtr bmod = boost::dynamic_pointer_cast<VarBoundMod>(mod);
+  VarBoundMod2Ptr bmod2;
+  UInt k;
+
+  if (bmod) {
+    k = 2*bmod->getVar()->getIndex() + (Upper==bmod->getLU() ? 1 : 0);
+    (*bnds)[k] = bmod->getNewVal();
+  } else {
+    bmod2 = boost::dynamic_pointer_cast<VarBoundMod2>(mod);
+    if (bmod2) {
+      k = 2*bmod2->getVar()->getIndex();
+      (*bnds)[k] = bmod2->getNewLb();
+      (*bnds)[k+1] = bmod2->getNewUb();
+    }
+  }
+}
+
+
+static void reoptPutLin(LinearFunctionPtr lf, UIntVector *ind,
+                        DoubleVector *coef)
+{
+  if (lf) {
+    for (VariableGroupConstIterator it=lf->termsBegin(); it!=lf->termsEnd();
+         ++it) {
+      ind->push_back(it->first->getIndex());
+      coef->push_back(it->second);
+    }
+  }
+}
+
+
+// true if lf has exactly the terms ind[start..end) and coef[start..end).
+static bool reoptSameLin(LinearFunctionPtr lf, const UIntVector &ind,
+                         const DoubleVector &coef, UInt start, UInt end)
+{
+  UInt j = start;
+
+  if (!lf) {
+    return start==end;
+  }
+  if (lf->getNumTerms()!=end-start) {
+    return false;
+  }
+  for (VariableGroupConstIterator it=lf->termsBegin(); it!=lf->termsEnd();
+       ++it, ++j) {
+    if (it->first->getIndex()!=ind[j] || it->second!=coef[j]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+
+BabReopt::BabReopt(EnvPtr env, ProblemPtr p)
+  : env_(env),
+    firstCut_(0),
+    incOk_(false),
+    incVal_(INFINITY),
+    objChanged_(false),
+    objConst_(0.0),
+    objSense_(-1),
+    p_(p),
+    relaxed_(false),
+    saved_(false),
+    tol_(1e-6)
+{
+  logger_ = env->getLogger();
+  on_ = env->getOptions()->findBool("bnb_reopt")->getValue();
+  leafStart_.push_back(0);
+  cutStart_.push_back(0);
+}
+
+
+BabReopt::~BabReopt()
+{
+  p_.reset();
+}
+
+
+void BabReopt::addCuts(RelaxationPtr rel)
+{
+  LinearFunctionPtr lf;
+  FunctionPtr f;
+  UInt nr = rel->getNumVars();
+  UInt np = p_->getNumVars();
+  UInt added = 0, dropped = 0;
+  double act, tol;
+  bool ok;
+
+  if (!on_ || relaxed_) {
+    return;
+  }
+  for (UInt i=0; i+1<cutStart_.size(); ++i) {
+    ok = true;
+    act = 0.0;
+    for (UInt j=cutStart_[i]; j<cutStart_[i+1]; ++j) {
+      if (cutInd_[j]>=nr || (objChanged_ && cutInd_[j]>=np)) {
+        ok = false;
+        break;
+      }
+      if (cutInd_[j]>=np) {
+        act = NAN;
+      } else if (!inc_.empty()) {
+        act += cutCoef_[j]*inc_[cutInd_[j]];
+      }
+    }
+    // a cut that cuts off the old incumbent was not valid for the old
+    // problem, e.g. it came from an objective cut off.
+    if (ok && !inc_.empty() && !std::isnan(act)) {
+      tol = tol_*std::max(1.0, fabs(act));
+      ok = act>=cutBnds_[2*i]-tol && act<=cutBnds_[2*i+1]+tol;
+    }
+    if (!ok) {
+      ++dropped;
+      continue;
+    }
+    lf = (LinearFunctionPtr) new LinearFunction();
+    for (UInt j=cutStart_[i]; j<cutStart_[i+1]; ++j) {
+      lf->addTerm(rel->getVariable(cutInd_[j]), cutCoef_[j]);
+    }
+    f = (FunctionPtr) new Function(lf);
+    rel->newConstraint(f, cutBnds_[2*i], cutBnds_[2*i+1]);
+    ++added;
+  }
+  logger_->msgStream(LogExtraInfo) << me_ << "added " << added
+                                   << " cuts, dropped " << dropped
+                                   << std::endl;
+}
+
+
+void BabReopt::addLeaf(NodePtr node)
+{
+  ReoptBounds rbnds, pbnds;
+  NodePtrVector path;
+  BranchPtr br;
+
+  if (!on_) {
+    return;
+  }
+  for (NodePtr n=node; n; n=n->getParent()) {
+    path.push_back(n);
+  }
+  // only changes made by branching are kept. Later changes overwrite
+  // earlier ones.
+  for (NodePtrVector::reverse_iterator it=path.rbegin(); it!=path.rend();
+       ++it) {
+    br = (*it)->getBranch();
+    if (!br) {
+      continue;
+    }
+    for (ModificationConstIterator mit=br->rModsBegin();
+         mit!=br->rModsEnd(); ++mit) {
+      reoptAddMod(&rbnds, *mit);
+    }
+    for (ModificationConstIterator mit=br->pModsBegin();
+         mit!=br->pModsEnd(); ++mit) {
+      reoptAddMod(&pbnds, *mit);
+    }
+  }
+  for (ReoptBounds::const_iterator it=rbnds.begin(); it!=rbnds.end(); ++it) {
+    leafKey_.push_back(it->first);
+    leafVal_.push_back(it->second);
+  }
+  leafStart_.push_back(leafKey_.size());
+  for (ReoptBounds::const_iterator it=pbnds.begin(); it!=pbnds.end(); ++it) {
+    leafKey_.push_back(it->first);
+    leafVal_.push_back(it->second);
+  }
+  leafStart_.push_back(leafKey_.size());
+  leafInfo_.push_back(node->getLb());
+  leafInfo_.push_back(node->getDepth());
+  leafInfo_.push_back(node->getStatus());
+}
+
+
+bool BabReopt::canReuseTree() const
+{
+  return (on_ && saved_ && !relaxed_ && !leafInfo_.empty());
+}
+
+
+bool BabReopt::checkChanges()
+{
+  ConstraintPtr c;
+  FunctionPtr f;
+  ObjectivePtr o = p_->getObjective();
+  VariablePtr v;
+  UInt n = p_->getNumVars();
+  UInt k = 0;
+  bool restricted = false;
+  int err = 0;
+
+  if (!on_ || !saved_) {
+    return false;
+  }
+  relaxed_ = false;
+  objChanged_ = false;
+
+  if (2*n!=varBnds_.size() || consStart_.size()!=p_->getNumCons()+1) {
+    relaxed_ = true;
+  } else {
+    for (UInt i=0; i<n; ++i) {
+      v = p_->getVariable(i);
+      if (v->getLb()<varBnds_[2*i] || v->getUb()>varBnds_[2*i+1] ||
+          v->getType()!=varType_[i]) {
+        relaxed_ = true;
+      } else if (v->getLb()>varBnds_[2*i] || v->getUb()<varBnds_[2*i+1]) {
+        restricted = true;
+      }
+    }
+    for (ConstraintConstIterator it=p_->consBegin(); it!=p_->consEnd();
+         ++it, ++k) {
+      c = *it;
+      f = c->getFunction();
+      if (c->getLb()<consBnds_[2*k] || c->getUb()>consBnds_[2*k+1] ||
+          f.get()!=consFun_[3*k] ||
+          (f && (f->getQuadraticFunction().get()!=consFun_[3*k+1] ||
+                 f->getNonlinearFunction().get()!=consFun_[3*k+2] ||
+                 !reoptSameLin(f->getLinearFunction(), consInd_, consCoef_,
+                               consStart_[k], consStart_[k+1])))) {
+        relaxed_ = true;
+        break;
+      } else if (c->getLb()>consBnds_[2*k] || c->getUb()<consBnds_[2*k+1]) {
+        restricted = true;
+      }
+    }
+  }
+
+  if (!o) {
+    objChanged_ = (-1!=objSense_);
+  } else {
+    objChanged_ = o->getObjectiveType()!=objSense_ ||
+      o->getConstant()!=objConst_ ||
+      o->getQuadraticFunction().get()!=objFun_[0] ||
+      o->getNonlinearFunction().get()!=objFun_[1] ||
+      !reoptSameLin(o->getLinearFunction(), objInd_, objCoef_, 0,
+                    objInd_.size());
+  }
+
+  incOk_ = inc_.size()==n && isFeasible_(&(inc_[0]));
+  if (incOk_ && objChanged_) {
+    incVal_ = o ? o->eval(&(inc_[0]), &err) : 0.0;
+    if (err) {
+      incOk_ = false;
+    }
+  }
+  if (relaxed_) {
+    clearLeaves_();
+    cutBnds_.clear();
+    cutCoef_.clear();
+    cutInd_.clear();
+    cutStart_.resize(1);
+  }
+
+  logger_->msgStream(LogInfo) << me_ << "problem is "
+    << (relaxed_ ? "relaxed or changed" :
+        (restricted ? "restricted" : "unchanged"))
+    << (objChanged_ ? ", objective changed" : "")
+    << (incOk_ ? ", incumbent is feasible" : "") << std::endl;
+  return true;
+}
+
+
+void BabReopt::clearLeaves_()
+{
+  leafInfo_.clear();
+  leafKey_.clear();
+  leafVal_.clear();
+  leafStart_.resize(1);
+}
+
+
+void BabReopt::finish(const NodePtrVector &nodes, RelaxationPtr rel,
+                      ConstSolutionPtr sol)
+{
+  ConstraintPtr c;
+  FunctionPtr f;
+
+  if (!on_) {
+    return;
+  }
+  for (NodePtrVector::const_iterator it=nodes.begin(); it!=nodes.end();
+       ++it) {
+    addLeaf(*it);
+  }
+
+  // only linear cuts are saved.
+  cutBnds_.clear();
+  cutCoef_.clear();
+  cutInd_.clear();
+  cutStart_.resize(1);
+  if (rel) {
+    for (ConstraintConstIterator it=rel->consBegin(); it!=rel->consEnd();
+         ++it) {
+      c = *it;
+      f = c->getFunction();
+      if (c->getId()<firstCut_ || DeletedCons==c->getState() || !f ||
+          f->getType()!=Linear || !f->getLinearFunction()) {
+        continue;
+      }
+      reoptPutLin(f->getLinearFunction(), &cutInd_, &cutCoef_);
+      cutStart_.push_back(cutInd_.size());
+      cutBnds_.push_back(c->getLb());
+      cutBnds_.push_back(c->getUb());
+    }
+  }
+
+  if (sol) {
+    inc_.assign(sol->getPrimal(), sol->getPrimal()+p_->getNumVars());
+    incVal_ = sol->getObjValue();
+  } else {
+    inc_.clear();
+    incVal_ = INFINITY;
+  }
+  saveProblem_();
+  saved_ = true;
+  incOk_ = false;
+  objChanged_ = false;
+  relaxed_ = false;
+  logger_->msgStream(LogExtraInfo) << me_ << "saved " << leafInfo_.size()/3
+                                   << " leaves and " << cutBnds_.size()/2
+                                   << " cuts" << std::endl;
+}
+
+
+const double * BabReopt::getIncumbent() const
+{
+  return incOk_ ? &(inc_[0]) : 0;
+}
+
+
+double BabReopt::getIncumbentValue() const
+{
+  return incVal_;
+}
+
+
+void BabReopt::getNodes(NodePtr root, RelaxationPtr rel, NodePtrVector *nodes)
+{
+  NodePtr node;
+  BranchPtr br;
+  VariablePtr v;
+  UInt k, nr = rel->getNumVars(), np = p_->getNumVars();
+  UInt dropped = 0;
+  double lb, val;
+  bool ok;
+  // infeasible leaves were pruned with the old cut off. They can be dropped
+  // only if it is still valid.
+  bool drop_inf = !objChanged_ && (inc_.empty() || incOk_);
+  bool keep_lb = !objChanged_;
+
+  for (UInt i=0; 3*i<leafInfo_.size(); ++i) {
+    if (drop_inf && NodeInfeasible==(NodeStatus) leafInfo_[3*i+2]) {
+      ++dropped;
+      continue;
+    }
+    br = (BranchPtr) new Branch();
+    ok = true;
+    for (UInt j=leafStart_[2*i]; ok && j<leafStart_[2*i+2]; ++j) {
+      k = leafKey_[j];
+      if (j<leafStart_[2*i+1]) {
+        if (k/2>=nr) {
+          continue;
+        }
+        v = rel->getVariable(k/2);
+      } else {
+        if (k/2>=np) {
+          continue;
+        }
+        v = p_->getVariable(k/2);
+      }
+      // the bounds of the new problem may be tighter.
+      if (k%2) {
+        val = std::min(leafVal_[j], v->getUb());
+        ok = val>=v->getLb()-tol_;
+        if (ok && j>leafStart_[2*i] && leafKey_[j-1]==k-1) {
+          ok = val>=leafVal_[j-1]-tol_;
+        }
+        if (ok && val<v->getUb()) {
+          if (j<leafStart_[2*i+1]) {
+            br->addRMod((ModificationPtr) new VarBoundMod(v, Upper, val));
+          } else {
+            br->addPMod((ModificationPtr) new VarBoundMod(v, Upper, val));
+          }
+        }
+      } else {
+        val = std::max(leafVal_[j], v->getLb());
+        ok = val<=v->getUb()+tol_;
+        if (ok && val>v->getLb()) {
+          if (j<leafStart_[2*i+1]) {
+            br->addRMod((ModificationPtr) new VarBoundMod(v, Lower, val));
+          } else {
+            br->addPMod((ModificationPtr) new VarBoundMod(v, Lower, val));
+          }
+        }
+      }
+    }
+    if (!ok) {
+      ++dropped;
+      continue;
+    }
+    node = (NodePtr) new Node(root, br);
+    if (!keep_lb) {
+      lb = -INFINITY;
+    } else if (drop_inf) {
+      lb = leafInfo_[3*i];
+    } else {
+      lb = std::min(leafInfo_[3*i], incVal_);
+    }
+    node->setLb(std::max(lb, root->getLb()));
+    node->setDepth((UInt) leafInfo_[3*i+1]);
+    root->addChild(node);
+    nodes->push_back(node);
+  }
+  logger_->msgStream(LogInfo) << me_ << "reusing " << nodes->size()
+                              << " leaves, dropped " << dropped
+                              << std::endl;
+  clearLeaves_();
+}
+
+
+bool BabReopt::isFeasible_(const double *x) const
+{
+  VariablePtr v;
+  double act;
+  int err = 0;
+
+  for (UInt i=0; i<p_->getNumVars(); ++i) {
+    v = p_->getVariable(i);
+    if (x[i]<v->getLb()-tol_ || x[i]>v->getUb()+tol_) {
+      return false;
+    }
+    if ((Binary==v->getType() || Integer==v->getType()) &&
+        fabs(x[i]-floor(x[i]+0.5))>tol_) {
+      return false;
+    }
+  }
+  for (ConstraintConstIterator it=p_->consBegin(); it!=p_->consEnd(); ++it) {
+    if (DeletedCons==(*it)->getState()) {
+      continue;
+    }
+    act = (*it)->getActivity(x, &err);
+    if (err || act<(*it)->getLb()-tol_*std::max(1.0, fabs((*it)->getLb())) ||
+        act>(*it)->getUb()+tol_*std::max(1.0, fabs((*it)->getUb()))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+
+bool BabReopt::isOn() const
+{
+  return on_;
+}
+
+
+bool BabReopt::keepsConflicts() const
+{
+  return (!saved_ || (!relaxed_ && !objChanged_ && incOk_));
+}
+
+
+void BabReopt::saveProblem_()
+{
+  ObjectivePtr o = p_->getObjective();
+  FunctionPtr f;
+
+  varBnds_.clear();
+  varType_.clear();
+  for (VariableConstIterator it=p_->varsBegin(); it!=p_->varsEnd(); ++it) {
+    varBnds_.push_back((*it)->getLb());
+    varBnds_.push_back((*it)->getUb());
+    varType_.push_back((*it)->getType());
+  }
+
+  consBnds_.clear();
+  consCoef_.clear();
+  consFun_.clear();
+  consInd_.clear();
+  consStart_.assign(1, 0);
+  for (ConstraintConstIterator it=p_->consBegin(); it!=p_->consEnd(); ++it) {
+    f = (*it)->getFunction();
+    consBnds_.push_back((*it)->getLb());
+    consBnds_.push_back((*it)->getUb());
+    consFun_.push_back(f.get());
+    if (f) {
+      consFun_.push_back(f->getQuadraticFunction().get());
+      consFun_.push_back(f->getNonlinearFunction().get());
+      reoptPutLin(f->getLinearFunction(), &consInd_, &consCoef_);
+    } else {
+      consFun_.push_back(0);
+      consFun_.push_back(0);
+    }
+    consStart_.push_back(consInd_.size());
+  }
+
+  objCoef_.clear();
+  objInd_.clear();
+  objFun_.assign(2, (const void *) 0);
+  if (o) {
+    objConst_ = o->getConstant();
+    objSense_ = o->getObjectiveType();
+    objFun_[0] = o->getQuadraticFunction().get();
+    objFun_[1] = o->getNonlinearFunction().get();
+    reoptPutLin(o->getLinearFunction(), &objInd_, &objCoef_);
+  } else {
+    objConst_ = 0.0;
+    objSense_ = -1;
+  }
+}
+
+
+void BabReopt::setRoot(RelaxationPtr rel)
+{
+  firstCut_ = 0;
+  for (ConstraintConstIterator it=rel->consBegin(); it!=rel->consEnd();
+       ++it) {
+    firstCut_ = std::max(firstCut_, (*it)->getId()+1);
+  }
+}
+
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
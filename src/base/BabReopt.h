@@ -0,0 +1,272 @@
+//
+//     MINOTAUR -- It's only 1/2 bull
+//
+//     (C)opyright 2008 - 2014 The MINOTAUR Team.
+//
+
+/**
+ * \file BabReopt.h
+ * \brief Declare the BabReopt class that keeps information from one solve
+ * of branch-and-bound for the next solve of a modified problem.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#ifndef MINOTAURBABREOPT_H
+#define MINOTAURBABREOPT_H
+
+#include <string>
+
+#include "Types.h"
+
+namespace Minotaur {
+
+  class Logger;
+  class Node;
+  class Problem;
+  class Relaxation;
+  class Solution;
+  typedef boost::shared_ptr<const Solution> ConstSolutionPtr;
+  typedef boost::shared_ptr<Logger> LoggerPtr;
+  typedef boost::shared_ptr<Node> NodePtr;
+  typedef boost::shared_ptr<Problem> ProblemPtr;
+  typedef boost::shared_ptr<Relaxation> RelaxationPtr;
+
+  /**
+   * \brief Keep the frontier of the tree, the cuts and the incumbent of a
+   * solve of branch-and-bound, so that the next solve can reuse them after
+   * the problem has been changed slightly, e.g. the bounds, the right hand
+   * sides of constraints or the objective.
+   *
+   * The frontier is the set of leaves of the final tree: the nodes that
+   * were pruned and the nodes that were still open. For each leaf, the
+   * bound changes made by branching on the path from the root are kept.
+   * Changes made while processing nodes (e.g. by presolve or reduced cost
+   * fixing) may depend on the objective or the incumbent, and are not kept.
+   * The leaves therefore cover the whole root.
+   *
+   * Before the next solve, the problem is compared with the problem saved
+   * at the end of the last solve, and the following is reused.
+   * - Nothing is reused, except the state of the brancher, if bounds of
+   *   variables or constraints were relaxed, or if variables, constraints
+   *   or the functions in constraints were changed.
+   * - The incumbent is used if it is still feasible. Its value is
+   *   evaluated again if the objective changed.
+   * - The linear cuts are kept if they are satisfied by the old incumbent.
+   *   Cuts with variables that are not in the problem (e.g. the variable
+   *   for a nonlinear objective) are not kept if the objective changed.
+   * - The search starts from the leaves instead of the root. The lower
+   *   bounds of the leaves are kept if the objective is the same. Leaves
+   *   that were infeasible are dropped if also the incumbent, and hence the
+   *   cut off used to prune them, is still valid.
+   *
+   * The brancher (and its pseudo costs) is the same object in both solves
+   * and keeps its state itself.
+   */
+  class BabReopt {
+    public:
+      /// Constructor. Options are read from the environment.
+      BabReopt(EnvPtr env, ProblemPtr p);
+
+      /// Destroy.
+      ~BabReopt();
+
+      /**
+       * \brief Add the saved cuts that are still valid to the relaxation
+       * rel.
+       */
+      void addCuts(RelaxationPtr rel);
+
+      /**
+       * \brief Save a leaf of the tree. It is called just before the node
+       * is pruned.
+       */
+      void addLeaf(NodePtr node);
+
+      /// Return true if the search can start from the saved leaves.
+      bool canReuseTree() const;
+
+      /**
+       * \brief Compare the problem with the one saved after the last solve
+       * and decide what can be reused. It is called at the start of a
+       * solve.
+       *
+       * \return True if a solve was saved before.
+       */
+      bool checkChanges();
+
+      /**
+       * \brief Save the state at the end of a solve.
+       *
+       * \param[in] nodes The nodes that are still open.
+       * \param[in] rel The relaxation, from which cuts are saved.
+       * \param[in] sol The incumbent. It may be NULL.
+       */
+      void finish(const NodePtrVector &nodes, RelaxationPtr rel,
+                  ConstSolutionPtr sol);
+
+      /// Return the saved incumbent if it is still feasible, else NULL.
+      const double * getIncumbent() const;
+
+      /// Return the objective value of the saved incumbent.
+      double getIncumbentValue() const;
+
+      /**
+       * \brief Create the saved leaves as children of root, and append them
+       * to nodes. The saved leaves are then discarded.
+       *
+       * \param[in] root The new root node.
+       * \param[in] rel The relaxation of the root.
+       * \param[out] nodes The vector to which new nodes are appended.
+       */
+      void getNodes(NodePtr root, RelaxationPtr rel, NodePtrVector *nodes);
+
+      /// Return true if reoptimization is switched on.
+      bool isOn() const;
+
+      /**
+       * \brief Return true if conflicts learned in the last solve are still
+       * valid, i.e. the problem was only restricted, the objective did not
+       * change and the incumbent is still feasible. Conflicts from pruned
+       * nodes depend on the incumbent, and those from infeasible nodes on
+       * the constraints. Valid after checkChanges().
+       */
+      bool keepsConflicts() const;
+
+      /**
+       * \brief Note which constraints of rel are not cuts. It is called
+       * after the root relaxation is created and before cuts are added.
+       */
+      void setRoot(RelaxationPtr rel);
+
+    private:
+      /// Lower and upper bound of each saved cut.
+      DoubleVector cutBnds_;
+
+      /// Coefficients of the variables of each saved cut.
+      DoubleVector cutCoef_;
+
+      /// Indices of the variables of each saved cut.
+      UIntVector cutInd_;
+
+      /// Start of each saved cut in cutInd_ and cutCoef_.
+      UIntVector cutStart_;
+
+      /// Bounds of the constraints of the saved problem.
+      DoubleVector consBnds_;
+
+      /// Coefficients of the linear parts of the saved constraints.
+      DoubleVector consCoef_;
+
+      /**
+       * Functions, quadratic and nonlinear parts of the saved constraints,
+       * three for each constraint. They are only compared, never used.
+       */
+      std::vector<const void *> consFun_;
+
+      /// Indices of variables in the linear parts of the saved constraints.
+      UIntVector consInd_;
+
+      /// Start of each saved constraint in consInd_ and consCoef_.
+      UIntVector consStart_;
+
+      /// Environment.
+      EnvPtr env_;
+
+      /// Constraints of the relaxation with this id or more are cuts.
+      UInt firstCut_;
+
+      /// Saved incumbent. Empty if there is none.
+      DoubleVector inc_;
+
+      /// True if the saved incumbent is feasible for the changed problem.
+      bool incOk_;
+
+      /// Objective value of the saved incumbent.
+      double incVal_;
+
+      /**
+       * Bound changes of each saved leaf, as key and value. The key is twice
+       * the index of the variable, plus one for an upper bound.
+       */
+      UIntVector leafKey_;
+
+      /// Lower bound, depth and status of each saved leaf.
+      DoubleVector leafInfo_;
+
+      /**
+       * Start of the relaxation and the problem changes of each saved leaf
+       * in leafKey_ and leafVal_.
+       */
+      UIntVector leafStart_;
+
+      /// New values of the bound changes in leafKey_.
+      DoubleVector leafVal_;
+
+      /// Log.
+      LoggerPtr logger_;
+
+      /// For logging.
+      static const std::string me_;
+
+      /// Coefficients of the linear part of the saved objective.
+      DoubleVector objCoef_;
+
+      /// True if the objective changed since the last solve.
+      bool objChanged_;
+
+      /// Quadratic and nonlinear parts of the saved objective.
+      std::vector<const void *> objFun_;
+
+      /// Indices of variables in the linear part of the saved objective.
+      UIntVector objInd_;
+
+      /// Constant of the saved objective.
+      double objConst_;
+
+      /// Sense of the saved objective.
+      int objSense_;
+
+      /// True if reoptimization is switched on.
+      bool on_;
+
+      /// The problem being solved.
+      ProblemPtr p_;
+
+      /// True if bounds were relaxed or the structure changed.
+      bool relaxed_;
+
+      /// True if a solve was saved.
+      bool saved_;
+
+      /// Tolerance for checking feasibility of the incumbent.
+      const double tol_;
+
+      /// Bounds of the variables of the saved problem.
+      DoubleVector varBnds_;
+
+      /// Types of the variables of the saved problem.
+      std::vector<int> varType_;
+
+      /// Drop saved leaves.
+      void clearLeaves_();
+
+      /// Return true if x is feasible for the problem.
+      bool isFeasible_(const double *x) const;
+
+      /// Save the data of the problem for comparing it later.
+      void saveProblem_();
+  };
+  typedef boost::shared_ptr<BabReopt> BabReoptPtr;
+}
+#endif
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
@@ -13,6 +13,7 @@
 
 #include "MinotaurConfig.h"
 #include "Brancher.h"
+#include "ConflictAnalyzer.h"
 #include "Engine.h"
 #include "Environment.h"
 #include "Handler.h"
@@ -21,6 +22,7 @@
 #include "Node.h"
 #include "Option.h"
 #include "Modification.h"
+#include "Profiler.h"
 #include "Relaxation.h"
 #include "SolutionPool.h"
 
@@ -80,6 +82,14 @@ BndProcessor::~BndProcessor()
 }
 
 
+void BndProcessor::clearConflicts()
+{
+  if (conflicts_) {
+    conflicts_->clear();
+  }
+}
+
+
 bool BndProcessor::foundNewSolution()
 {
   return (numSolutions_ > 0);
@@ -139,6 +149,21 @@ void BndProcessor::process(NodePtr node, RelaxationPtr rel,
   ++stats_.proc;
   relaxation_ = rel;
 
+  if (conflicts_) {
+    should_prune = conflicts_->propagate(rel, mods);
+    for (ModificationConstIterator miter=mods.begin(); miter!=mods.end();
+         ++miter) {
+      node->addRMod(*miter);
+    }
+    mods.clear();
+    if (should_prune) {
+      node->setStatus(NodeInfeasible);
+      ++stats_.inf;
+      conflicts_->analyze(node, rel);
+      return;
+    }
+  }
+
 #if 0
   double *svar = new double[20];
   bool xfeas = true;
@@ -215,8 +240,11 @@ void BndProcessor::process(NodePtr node, RelaxationPtr rel,
 
     //save warm start information before branching. This step is expensive.
     ws_ = engine_->getWarmStartCopy();
-    branches_ = brancher_->findBranches(relaxation_, node, sol, s_pool, 
-                                        br_status, mods);
+    {
+      ProfZone zone(ProfBranch);
+      branches_ = brancher_->findBranches(relaxation_, node, sol, s_pool,
+                                          br_status, mods);
+    }
     if (br_status==PrunedByBrancher) {
 
       should_prune = true;
@@ -235,6 +263,9 @@ void BndProcessor::process(NodePtr node, RelaxationPtr rel,
       break;
     }
   }
+  if (conflicts_) {
+    conflicts_->analyze(node, rel);
+  }
 #if 0
   if ((true==should_prune || node->getLb() >-4150) && true==xfeas) {
     std::cout << "problem here!\n";
@@ -248,6 +279,12 @@ void BndProcessor::process(NodePtr node, RelaxationPtr rel,
 }
 
 
+void BndProcessor::setConflictAnalyzer(ConflictAnalyzerPtr conflicts)
+{
+  conflicts_ = conflicts;
+}
+
+
 bool BndProcessor::shouldPrune_(NodePtr node, double solval, 
                                SolutionPoolPtr s_pool)
 {
@@ -363,6 +400,7 @@ bool BndProcessor::shouldPrune_(NodePtr node, double solval,
 
 void BndProcessor::solveRelaxation_() 
 {
+  ProfZone zone(ProfEngine);
   engineStatus_ = EngineError;
   engine_->solve();
   engineStatus_ = engine_->getStatus();
@@ -383,6 +421,9 @@ void BndProcessor::writeStats(std::ostream &out) const
       << me_ << "nodes hit ub        = " << stats_.ub << std::endl 
       << me_ << "nodes with problems = " << stats_.prob << std::endl 
       ;
+  if (conflicts_) {
+    conflicts_->writeStats(out);
+  }
 }
 
 
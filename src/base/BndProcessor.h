@@ -65,6 +65,12 @@ namespace Minotaur {
       void process(NodePtr node, RelaxationPtr rel, 
                    SolutionPoolPtr s_pool);
 
+      // Base class method.
+      void clearConflicts();
+
+      // Base class method.
+      void setConflictAnalyzer(ConflictAnalyzerPtr conflicts);
+
       // write statistics. Base class method.
       void writeStats(std::ostream &out) const; 
 
@@ -76,6 +82,9 @@ namespace Minotaur {
       /// Branches found by this processor for this node
       Branches branches_;
 
+      /// Learns conflicts from pruned nodes. NULL if not used.
+      ConflictAnalyzerPtr conflicts_;
+
       /**
        * If true, we continue to search, if engine reports error. If false,
        * we assume that the relaxation is infeasible when engine returns error.
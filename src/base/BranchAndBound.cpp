@@ -14,6 +14,8 @@
 #include <iomanip>
 
 #include "MinotaurConfig.h"
+#include "BabCheckpoint.h"
+#include "BabReopt.h"
 #include "BranchAndBound.h"
 #include "Brancher.h"
 #include "Environment.h"
@@ -24,11 +26,13 @@
 #include "NodeRelaxer.h"
 #include "Option.h"
 #include "Problem.h"
+#include "Profiler.h"
 #include "Relaxation.h"
 #include "Solution.h"
 #include "SolutionPool.h"
 #include "Timer.h"
 #include "TreeManager.h"
+#include "Variable.h"
 
 
 //#define DEBUG 1
@@ -68,11 +72,24 @@ BranchAndBound::BranchAndBound(EnvPtr env, ProblemPtr p)
   tm_ = (TreeManagerPtr) new TreeManager(env);
   options_ = (BabOptionsPtr) new BabOptions(env);
   logger_ = (LoggerPtr) new Logger(options_->logLevel);
+  ckpt_ = (BabCheckpointPtr) new BabCheckpoint(env, p);
+  reopt_ = (BabReoptPtr) new BabReopt(env, p);
+  if (reopt_->isOn()) {
+    // a restart tightens the problem permanently.
+    if (options_->maxRestarts>0) {
+      logger_->msgStream(LogInfo) << me_ << "restarts are disabled for "
+        << "reoptimization" << std::endl;
+      options_->maxRestarts = 0;
+    }
+    tm_->setReopt(reopt_);
+  }
 }
 
 
 BranchAndBound::~BranchAndBound()
 {
+  ckpt_.reset();
+  reopt_.reset();
   options_.reset();
   logger_.reset();
   nodePrcssr_.reset();
@@ -96,6 +113,17 @@ void BranchAndBound::addPreRootHeur(HeurPtr h)
 }
 
 
+void BranchAndBound::checkpoint_()
+{
+  NodePtrVector nodes;
+
+  tm_->getOpenNodes(&nodes);
+  ckpt_->write(nodes, nodeRlxr_->getRelaxation(),
+               solPool_->getBestSolution(), nodePrcssr_->getBrancher(),
+               stats_->nodesProc, stats_->restarts, timer_->query());
+}
+
+
 double BranchAndBound::getPerGap() 
 { 
   return tm_->getPerGap(); 
@@ -158,11 +186,21 @@ NodePtr BranchAndBound::processRoot_(bool *should_prune, bool *should_dive)
   bool prune = *should_prune;
   Branches branches;
   WarmStartPtr ws;
+  UInt nfree = 0;
 #if SPEW
   logger_->msgStream(LogDebug) << me_ << "creating root node" << 
     std::endl;
 #endif
   tm_->insertRoot(current_node);
+  if (stats_->restarts < options_->maxRestarts) {
+    for (VariableConstIterator it=problem_->varsBegin();
+         it!=problem_->varsEnd(); ++it) {
+      if (((*it)->getType()==Binary || (*it)->getType()==Integer) &&
+          (*it)->getUb()-(*it)->getLb() > 0.5) {
+        ++nfree;
+      }
+    }
+  }
 
   if (options_->createRoot == true) {
     rel = nodeRlxr_->createRootRelaxation(current_node, prune);
@@ -170,6 +208,11 @@ NodePtr BranchAndBound::processRoot_(bool *should_prune, bool *should_dive)
   } else {
     rel = nodeRlxr_->getRelaxation();
   }
+  ckpt_->setRoot(rel);
+  if (reopt_->isOn() && !prune) {
+    reopt_->setRoot(rel);
+    reopt_->addCuts(rel);
+  }
 
   if (!prune) {
   // solve the root node only if the initial root relaxation is not pruned
@@ -186,6 +229,9 @@ NodePtr BranchAndBound::processRoot_(bool *should_prune, bool *should_dive)
     }
     
     prune = shouldPrune_(current_node);
+    if (false==prune && restart_(current_node, rel, nfree)) {
+      return processRoot_(should_prune, should_dive);
+    }
   }
   if (prune) {
     nodeRlxr_->reset(current_node, false);
@@ -218,6 +264,182 @@ NodePtr BranchAndBound::processRoot_(bool *should_prune, bool *should_dive)
 }
 
 
+bool BranchAndBound::restart_(NodePtr root, RelaxationPtr rel, UInt nfree)
+{
+  VarVector rvars, pvars;
+  DoubleVector rlb, rub, plb, pub;
+  VariablePtr v, rv;
+  double lb, ub;
+  UInt nfix = 0;
+  UInt nint = 0;
+
+  if (0==nfree || stats_->restarts >= options_->maxRestarts) {
+    return false;
+  }
+  for (VariableConstIterator it=problem_->varsBegin();
+       it!=problem_->varsEnd(); ++it) {
+    v = *it;
+    if (v->getType()!=Binary && v->getType()!=Integer) {
+      continue;
+    }
+    ++nint;
+    lb = v->getLb();
+    ub = v->getUb();
+    rv = rel->getRelaxationVar(v);
+    if (rv) {
+      lb = std::max(lb, rv->getLb());
+      ub = std::min(ub, rv->getUb());
+    }
+    if (ub-lb < 0.5) {
+      ++nfix;
+    }
+  }
+  // variables fixed before the root are not counted.
+  nfix -= std::min(nfix, nint-nfree);
+  if (nfix < options_->restartFrac*nfree) {
+    return false;
+  }
+
+  // bounds after the root are valid globally. Undoing the root restores the
+  // bounds from before the root, so they are saved first.
+  for (VariableConstIterator it=rel->varsBegin(); it!=rel->varsEnd(); ++it) {
+    rvars.push_back(*it);
+    rlb.push_back((*it)->getLb());
+    rub.push_back((*it)->getUb());
+  }
+  for (VariableConstIterator it=problem_->varsBegin();
+       it!=problem_->varsEnd(); ++it) {
+    pvars.push_back(*it);
+    plb.push_back((*it)->getLb());
+    pub.push_back((*it)->getUb());
+  }
+  nodeRlxr_->reset(root, false);
+  for (UInt i=0; i<rvars.size(); ++i) {
+    if (rlb[i] > rvars[i]->getLb() || rub[i] < rvars[i]->getUb()) {
+      rel->changeBound(rvars[i], rlb[i], rub[i]);
+    }
+  }
+  for (UInt i=0; i<pvars.size(); ++i) {
+    v = pvars[i];
+    rv = rel->getRelaxationVar(v);
+    lb = plb[i];
+    ub = pub[i];
+    if (rv && (v->getType()==Binary || v->getType()==Integer)) {
+      lb = std::max(lb, rv->getLb());
+      ub = std::min(ub, rv->getUb());
+    }
+    if (lb > v->getLb() || ub < v->getUb()) {
+      problem_->changeBound(v, lb, ub);
+    }
+  }
+
+  if (options_->createRoot) {
+    // the root relaxation is created again, cuts added to this one are lost.
+    nodePrcssr_->resetRelaxation();
+  }
+
+  ++stats_->restarts;
+  logger_->msgStream(LogInfo) << me_ << "restarting after root: " << nfix
+    << " of " << nfree << " integer variables fixed" << std::endl;
+  tm_ = (TreeManagerPtr) new TreeManager(env_);
+  tm_->setUb(solPool_->getBestSolutionValue());
+  if (reopt_->isOn()) {
+    tm_->setReopt(reopt_);
+  }
+  return true;
+}
+
+
+NodePtr BranchAndBound::reoptimize_()
+{
+  NodePtr root = (NodePtr) new Node();
+  NodePtr current_node = NodePtr(); // NULL
+  NodePtrVector nodes;
+  RelaxationPtr rel;
+  bool prune = false;
+
+  tm_->insertRoot(root);
+  if (options_->createRoot == true) {
+    rel = nodeRlxr_->createRootRelaxation(root, prune);
+    rel->setProblem(problem_);
+  } else {
+    rel = nodeRlxr_->getRelaxation();
+  }
+  ckpt_->setRoot(rel);
+  tm_->removeActiveNode(root);
+  if (!prune) {
+    reopt_->setRoot(rel);
+    reopt_->addCuts(rel);
+    reopt_->getNodes(root, rel, &nodes);
+    for (NodePtrVector::iterator it=nodes.begin(); it!=nodes.end(); ++it) {
+      tm_->insertSaved(*it);
+    }
+  }
+  if (nodes.empty()) {
+    nodeRlxr_->reset(root, false);
+    tm_->pruneNode(root);
+  } else {
+    current_node = tm_->getCandidate();
+  }
+
+  tm_->updateLb();
+  showStatus_(false);
+  return current_node;
+}
+
+
+NodePtr BranchAndBound::resume_()
+{
+  NodePtr root = (NodePtr) new Node();
+  NodePtr current_node = NodePtr(); // NULL
+  NodePtrVector nodes;
+  RelaxationPtr rel;
+  bool prune = false;
+
+  if (ckpt_->getIncumbent()) {
+    solPool_->addSolution(ckpt_->getIncumbent(),
+                          ckpt_->getIncumbentValue());
+    tm_->setUb(solPool_->getBestSolutionValue());
+  }
+  ckpt_->restoreBounds(RelaxationPtr());
+  stats_->nodesProc = ckpt_->getNodesProc();
+  stats_->restarts = ckpt_->getRestarts();
+
+  tm_->insertRoot(root);
+  if (options_->createRoot == true) {
+    rel = nodeRlxr_->createRootRelaxation(root, prune);
+    rel->setProblem(problem_);
+  } else {
+    rel = nodeRlxr_->getRelaxation();
+  }
+  tm_->removeActiveNode(root);
+  if (!prune) {
+    ckpt_->restoreBounds(rel);
+    ckpt_->setRoot(rel);
+    ckpt_->addCuts(rel);
+    if (!nodePrcssr_->getBrancher()->loadState(ckpt_->getBrancherState())) {
+      logger_->msgStream(LogInfo) << me_ << "state of brancher in "
+        << "checkpoint does not fit, starting with no pseudo costs."
+        << std::endl;
+    }
+    ckpt_->getNodes(root, rel, &nodes);
+    for (NodePtrVector::iterator it=nodes.begin(); it!=nodes.end(); ++it) {
+      tm_->insertSaved(*it);
+    }
+  }
+  if (nodes.empty()) {
+    nodeRlxr_->reset(root, false);
+    tm_->pruneNode(root);
+  } else {
+    current_node = tm_->getCandidate();
+  }
+
+  tm_->updateLb();
+  showStatus_(false);
+  return current_node;
+}
+
+
 void BranchAndBound::setLogLevel(LogLevel level) 
 {
   logger_->setMaxLevel(level);
@@ -333,6 +555,7 @@ void BranchAndBound::solve()
 
   // initialize timer
   timer_->start();
+  Profiler::start(env_);
   logger_->msgStream(LogInfo) << me_ << "starting branch-and-bound"
     << std::endl;
 
@@ -352,14 +575,39 @@ void BranchAndBound::solve()
   // TODO: use user options to set the pool size. For now it is 1.
   solPool_ = (SolutionPoolPtr) new SolutionPool(env_, problem_, 1);
 
+  // the tree of the last solve is replaced by a new one.
+  if (reopt_->isOn() && reopt_->checkChanges()) {
+    tm_ = (TreeManagerPtr) new TreeManager(env_);
+    tm_->setReopt(reopt_);
+    if (!reopt_->keepsConflicts()) {
+      nodePrcssr_->clearConflicts();
+    }
+    if (options_->createRoot) {
+      // the root relaxation is created again, cuts added to the last one
+      // are lost. Valid cuts are added again from reopt_.
+      nodePrcssr_->resetRelaxation();
+    }
+  }
+
   // call heuristics before the root, if needed 
   for (HeurVector::iterator it=preHeurs_.begin(); it!=preHeurs_.end(); ++it) {
+    ProfZone zone(ProfHeur);
     (*it)->solve(current_node, rel, solPool_);
   }
+  if (reopt_->getIncumbent()) {
+    solPool_->addSolution(reopt_->getIncumbent(),
+                          reopt_->getIncumbentValue());
+  }
   tm_->setUb(solPool_->getBestSolutionValue());
 
-  // do the root
-  current_node = processRoot_(&should_prune, &dived_prev);
+  // do the root, start from the last tree, or resume from a checkpoint.
+  if (ckpt_->shouldResume() && ckpt_->read()) {
+    current_node = resume_();
+  } else if (reopt_->canReuseTree()) {
+    current_node = reoptimize_();
+  } else {
+    current_node = processRoot_(&should_prune, &dived_prev);
+  }
 
   // stop if done
   if (!current_node) {
@@ -378,6 +626,9 @@ void BranchAndBound::solve()
     should_stop = true;
   } else if (shouldStop_()) {
     tm_->updateLb();
+    if (ckpt_->isOn()) {
+      checkpoint_();
+    }
     should_stop = true;
   } else {
 #if SPEW
@@ -453,6 +704,9 @@ void BranchAndBound::solve()
     current_node = new_node;
 
     showStatus_(should_dive);
+    if (current_node && ckpt_->isDue(timer_->query())) {
+      checkpoint_();
+    }
 
     // stop if done
     if (!current_node) {
@@ -471,6 +725,9 @@ void BranchAndBound::solve()
       break;
     } else if (shouldStop_()) {
       tm_->updateLb();
+      if (ckpt_->isOn()) {
+        checkpoint_();
+      }
       break;
     } else {
 #if SPEW
@@ -480,10 +737,27 @@ void BranchAndBound::solve()
 #endif
     }
   } 
+
+  // handlers may have put off work that finds solutions, e.g. NLPs.
+  nodePrcssr_->flushDeferred(solPool_);
+  if (solPool_->getBestSolutionValue() < tm_->getUb()) {
+    tm_->setUb(solPool_->getBestSolutionValue());
+    tm_->updateLb();
+    if (SolvedInfeasible == status_) {
+      status_ = SolvedOptimal;
+    }
+  }
+  if (reopt_->isOn()) {
+    NodePtrVector nodes;
+    tm_->getOpenNodes(&nodes);
+    reopt_->finish(nodes, nodeRlxr_->getRelaxation(),
+                   solPool_->getBestSolution());
+  }
   logger_->msgStream(LogInfo) << me_ << "stopping branch-and-bound"
     << std::endl;
   stats_->timeUsed = timer_->query();
   timer_->stop();
+  Profiler::finish(env_);
 }
 
 
@@ -492,13 +766,15 @@ void BranchAndBound::writeStats(std::ostream &out)
   out << me_ << "time taken      = " << std::fixed << std::setprecision(2)
     << stats_->timeUsed << std::endl
     << me_ << "nodes processed = " << stats_->nodesProc << std::endl
-    << me_ << "nodes created   = " << tm_->getSize() << std::endl;
+    << me_ << "nodes created   = " << tm_->getSize() << std::endl
+    << me_ << "restarts        = " << stats_->restarts << std::endl;
   nodePrcssr_->writeStats(out);
   nodePrcssr_->getBrancher()->writeStats(out);
   for (HeurVector::iterator it=preHeurs_.begin(); it!=preHeurs_.end(); ++it) {
     (*it)->writeStats(out);
   }
   solPool_->writeStats(out);
+  Profiler::writeStats(out);
 }
 
 
@@ -513,6 +789,7 @@ double BranchAndBound::totalTime()
 
 BabStats::BabStats()
   :nodesProc(0),
+   restarts(0),
    timeUsed(0),
    updateTime(0)
 {
@@ -524,8 +801,10 @@ BabStats::BabStats()
 BabOptions::BabOptions()
   : createRoot(true),
     logLevel(LogInfo),
+    maxRestarts(0),
     nodeLimit(0),
     perGapLimit(0.),
+    restartFrac(1.0),
     solLimit(0),
     timeLimit(0.)
     
@@ -539,8 +818,10 @@ BabOptions::BabOptions(EnvPtr env)
 
   logInterval = options->findDouble("bnb_log_interval")->getValue();
   logLevel    = (LogLevel) options->findInt("log_level")->getValue();
+  maxRestarts = options->findInt("bnb_restarts")->getValue();
   nodeLimit   = options->findInt("bnb_node_limit")->getValue();
   perGapLimit = options->findDouble("obj_gap_percent")->getValue();
+  restartFrac = options->findDouble("bnb_restart_frac")->getValue();
   solLimit    = options->findInt("bnb_sol_limit")->getValue();
   timeLimit   = options->findDouble("bnb_time_limit")->getValue();
   createRoot  = true;
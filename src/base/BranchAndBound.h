@@ -17,19 +17,25 @@
 
 namespace Minotaur {
 
+  class   BabCheckpoint;
   struct  BabOptions;
+  class   BabReopt;
   struct  BabStats;
   class   NodeProcessor;
   class   NodeRelaxer;
   class   Problem;
+  class   Relaxation;
   class   Solution;
   class   SolutionPool;
   class   Timer;
   class   TreeManager;
+  typedef boost::shared_ptr <BabCheckpoint> BabCheckpointPtr;
   typedef boost::shared_ptr <BabOptions> BabOptionsPtr;
+  typedef boost::shared_ptr <BabReopt> BabReoptPtr;
   typedef boost::shared_ptr <NodeProcessor> NodeProcessorPtr;
   typedef boost::shared_ptr <NodeRelaxer> NodeRelaxerPtr;
   typedef boost::shared_ptr <Problem> ProblemPtr;
+  typedef boost::shared_ptr <Relaxation> RelaxationPtr;
   typedef boost::shared_ptr <Solution> SolutionPtr;
   typedef boost::shared_ptr <SolutionPool> SolutionPoolPtr;
   typedef boost::shared_ptr <TreeManager> TreeManagerPtr;
@@ -138,7 +144,14 @@ namespace Minotaur {
      */
     void shouldCreateRoot(bool b);
 
-    /// Start solving the Problem using branch-and-bound
+    /**
+     * \brief Start solving the Problem using branch-and-bound.
+     *
+     * If the option bnb_reopt is set, solve() may be called again after the
+     * bounds, constraints or objective of the problem are changed. The
+     * leaves of the last tree, the cuts and the incumbent are then reused as
+     * far as they are still valid.
+     */
     void solve();
 
     /// Return total time taken
@@ -151,6 +164,9 @@ namespace Minotaur {
     void writeStats();
 
   private:
+    /// Saves the state of the search and resumes it.
+    BabCheckpointPtr ckpt_;
+
     /// Pointer to the enviroment.
     EnvPtr env_;
 
@@ -178,6 +194,9 @@ namespace Minotaur {
     /// The Problem that is solved using branch-and-bound.
     ProblemPtr problem_;
 
+    /// Keeps the tree, cuts and incumbent for the next solve.
+    BabReoptPtr reopt_;
+
     /// The TreeManager used to manage the search tree.
     SolutionPoolPtr solPool_;
 
@@ -202,6 +221,9 @@ namespace Minotaur {
     /// The TreeManager used to manage the search tree.
     TreeManagerPtr tm_;
 
+    /// Save the open nodes and other state in a checkpoint.
+    void checkpoint_();
+
     /**
      * \brief Process the root node.
      *
@@ -210,6 +232,52 @@ namespace Minotaur {
      */
     NodePtr processRoot_(bool *should_prune, bool *should_dive);
 
+    /**
+     * \brief Start the search from the leaves saved after the last solve,
+     * instead of processing the root.
+     *
+     * A root is created and its relaxation is set up as in processRoot_(),
+     * but the root is not processed. The saved cuts that are still valid are
+     * added and the saved leaves are inserted as its children.
+     *
+     * \return The first node to process, or NULL if no leaf is left.
+     */
+    NodePtr reoptimize_();
+
+    /**
+     * \brief Restart from a new root if enough integer variables were fixed
+     * in the root.
+     *
+     * Bounds of the relaxation and the problem after processing the root
+     * are valid in the whole tree. If they fix enough integer variables,
+     * the root is undone, the bounds are applied to the problem and the
+     * relaxation permanently and the tree is started again. Cuts in the
+     * relaxation and the state of the brancher (pseudocosts) are kept. If
+     * the root relaxation is created by branch-and-bound, it is created
+     * again from the tightened problem.
+     *
+     * \param [in] root The root node. It is processed and not pruned.
+     * \param [in] rel The relaxation of the root.
+     * \param [in] nfree Number of integer variables that were not fixed
+     * before the root.
+     * \return True if the tree was reset and the root should be processed
+     * again.
+     */
+    bool restart_(NodePtr root, RelaxationPtr rel, UInt nfree);
+
+    /**
+     * \brief Resume the search from a checkpoint that has been read,
+     * instead of processing the root.
+     *
+     * A root is created and its relaxation is set up as in processRoot_(),
+     * but the root is not processed. The saved open nodes are inserted as
+     * its children, and the incumbent, the cuts, the state of the brancher
+     * and the statistics are restored.
+     *
+     * \return The first node to process, or NULL if no open node was saved.
+     */
+    NodePtr resume_();
+
     /// Return True if a node can be pruned.
     bool shouldPrune_(NodePtr node);
 
@@ -238,6 +306,9 @@ namespace Minotaur {
     /// Number of nodes processed.
     UInt nodesProc;
 
+    /// Number of restarts after the root.
+    UInt restarts;
+
     /// Total time used in branch-and-bound.
     double timeUsed;
 
@@ -267,6 +338,9 @@ namespace Minotaur {
     /// Verbosity of log.
     LogLevel logLevel;
 
+    /// Maximum number of restarts after the root.
+    UInt maxRestarts;
+
     /// Limit on number of nodes processed.
     UInt nodeLimit;
 
@@ -276,6 +350,12 @@ namespace Minotaur {
      */
     double perGapLimit;
 
+    /**
+     * \brief Restart if at least this fraction of the integer variables
+     * that were free before the root are fixed after the root.
+     */
+    double restartFrac;
+
     /// Limit on number of nodes processed.
     UInt solLimit;
 
@@ -27,6 +27,12 @@ Brancher::~Brancher()
 }
 
 
+bool Brancher::loadState(const DoubleVector &state)
+{
+  return state.empty();
+}
+
+
 void Brancher::updateAfterLP(NodePtr , ConstSolutionPtr )
 {
 }
@@ -63,6 +63,21 @@ namespace Minotaur {
       /// Return the name of this brancher.
       virtual std::string getName() const = 0;
 
+      /**
+       * \brief Restore the state saved by saveState(), e.g. when
+       * branch-and-bound is resumed from a checkpoint.
+       *
+       * \param[in] state The saved state.
+       * \return False if the state does not fit this brancher.
+       */
+      virtual bool loadState(const DoubleVector &state);
+
+      /**
+       * \brief Append the state that this brancher has learnt, e.g. pseudo
+       * costs, to state. Nothing is saved by default.
+       */
+      virtual void saveState(DoubleVector *) const {};
+
       /**
        * \brief Update pseudo-costs after LP is solved.
        *
@@ -0,0 +1,356 @@
+//
+//     MINOTAUR -- It's only 1/2 bull
+//
+//     (C)opyright 2008 - 2014 The MINOTAUR Team.
+//
+
+/**
+ * \file CliqueHandler.cpp
+ * \brief Implement the methods of class CliqueHandler.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <set>
+
+#include "MinotaurConfig.h"
+#include "CliqueHandler.h"
+#include "CliquePropagator.h"
+#include "CutManager.h"
+#include "Environment.h"
+#include "Function.h"
+#include "LinearFunction.h"
+#include "Logger.h"
+#include "Option.h"
+#include "PropEngine.h"
+#include "Relaxation.h"
+#include "Solution.h"
+#include "Timer.h"
+#include "VarBoundMod.h"
+#include "Variable.h"
+
+using namespace Minotaur;
+
+const std::string CliqueHandler::me_ = "CliqueHandler: ";
+
+typedef std::pair<double, UInt> ValueLit;
+
+static bool largerValue(const ValueLit &a, const ValueLit &b)
+{
+  return (a.first > b.first);
+}
+
+
+CliqueHandler::CliqueHandler(EnvPtr env, ProblemPtr problem)
+  : env_(env),
+    eps_(1e-6),
+    maxCuts_(50),
+    p_(problem)
+{
+  logger_ = (LoggerPtr) new Logger((LogLevel)(env->getOptions()->
+      findInt("handler_log_level")->getValue()));
+  modProb_ = false;
+  modRel_ = true;
+  stats_.cliques = 0;
+  stats_.cuts = 0;
+  stats_.fixed = 0;
+  stats_.inf = 0;
+  stats_.time = 0.0;
+  table_ = (CliqueTablePtr) new CliqueTable(problem->getNumVars());
+}
+
+
+CliqueHandler::~CliqueHandler()
+{
+  engine_.reset();
+  env_.reset();
+  p_.reset();
+  rel_.reset();
+  table_.reset();
+}
+
+
+void CliqueHandler::build_()
+{
+  // implications saved by probing are kept only if presolve has not
+  // changed the variables since.
+  table_->build(p_, eps_);
+  stats_.cliques = table_->getNumCliques();
+  engine_.reset();
+  rel_.reset();
+  logger_->msgStream(LogInfo) << me_ << "cliques found = "
+                              << stats_.cliques << std::endl;
+#if SPEW
+  table_->write(logger_->msgStream(LogDebug2), p_);
+#endif
+}
+
+
+double CliqueHandler::extend_(UInt c, const DoubleVector &val,
+                              UIntVector &lits) const
+{
+  double sum = 0.0;
+  UInt best = *(table_->cliqueBegin(c));
+  UIntVector nbrs;
+  std::vector<ValueLit> cands;
+  bool adj;
+
+  lits.assign(table_->cliqueBegin(c), table_->cliqueEnd(c));
+  for (UIntVector::const_iterator it=lits.begin(); it!=lits.end(); ++it) {
+    sum += val[*it];
+    if (val[*it] > val[best]) {
+      best = *it;
+    }
+  }
+
+  // every literal that can be added is a neighbor of the best one.
+  table_->getImplied(best, nbrs);
+  for (UIntVector::const_iterator it=nbrs.begin(); it!=nbrs.end(); ++it) {
+    if (val[*it] > eps_ &&
+        false==std::binary_search(table_->cliqueBegin(c),
+                                  table_->cliqueEnd(c), *it)) {
+      cands.push_back(ValueLit(val[*it], *it));
+    }
+  }
+  std::sort(cands.begin(), cands.end(), largerValue);
+  for (std::vector<ValueLit>::const_iterator it=cands.begin();
+       it!=cands.end(); ++it) {
+    adj = true;
+    for (UIntVector::const_iterator it2=lits.begin(); it2!=lits.end();
+         ++it2) {
+      if (*it2==CliqueTable::negate(it->second) ||
+          (*it2!=best && false==table_->isAdjacent(it->second, *it2))) {
+        adj = false;
+        break;
+      }
+    }
+    if (adj) {
+      lits.push_back(it->second);
+      sum += it->first;
+    }
+  }
+  return sum;
+}
+
+
+std::string CliqueHandler::getName() const
+{
+  return "CliqueHandler (Cliques of binary variables)";
+}
+
+
+bool CliqueHandler::isNeeded()
+{
+  if (0==table_->getNumCliques()) {
+    build_();
+  }
+  return (table_->getNumCliques() > 0);
+}
+
+
+SolveStatus CliqueHandler::presolve(PreModQ *, bool *changed)
+{
+  Timer *timer = env_->getNewTimer();
+
+  timer->start();
+  build_();
+  *changed = false;
+  stats_.time += timer->query();
+  delete timer;
+  return Finished;
+}
+
+
+bool CliqueHandler::presolveNode(RelaxationPtr rel, NodePtr,
+                                 SolutionPoolPtr, ModVector &p_mods,
+                                 ModVector &r_mods)
+{
+  bool is_inf;
+  UInt n0 = r_mods.size();
+  Timer *timer;
+  VariablePtr xr, xp;
+  VarBoundMod2Ptr mod;
+  VarVector rvars;
+
+  if (0==table_->getNumCliques()) {
+    return false;
+  }
+  timer = env_->getNewTimer();
+  timer->start();
+  if (!engine_ || rel!=rel_) {
+    rel_ = rel;
+    // the table is indexed by variables of p_, not of rel.
+    table_->getRelVars(p_, rel, rvars, 0);
+    engine_ = (PropEnginePtr) new PropEngine(rel);
+    engine_->addPropagator((CliquePropagatorPtr)
+                           new CliquePropagator(table_, rel, rvars));
+    engine_->init();
+  } else {
+    engine_->sync();
+    engine_->update();
+  }
+  is_inf = engine_->propagate(&r_mods, 0);
+  stats_.fixed += r_mods.size()-n0;
+  if (is_inf) {
+    ++stats_.inf;
+  } else if (true==modProb_ && r_mods.size() > n0) {
+    for (VariableConstIterator it=p_->varsBegin(); it!=p_->varsEnd(); ++it) {
+      xp = *it;
+      xr = rel->getRelaxationVar(xp);
+      if (xr && (xr->getLb() > xp->getLb()+eps_ ||
+                 xr->getUb() < xp->getUb()-eps_)) {
+        mod = (VarBoundMod2Ptr) new VarBoundMod2(xp,
+                                                 std::max(xp->getLb(),
+                                                          xr->getLb()),
+                                                 std::min(xp->getUb(),
+                                                          xr->getUb()));
+        mod->applyToProblem(p_);
+        p_mods.push_back(mod);
+      }
+    }
+  }
+  stats_.time += timer->query();
+  delete timer;
+  return is_inf;
+}
+
+
+void CliqueHandler::relaxInitFull(RelaxationPtr, bool *is_inf)
+{
+  if (0==table_->getNumCliques() || false==table_->hasVars(p_)) {
+    build_();
+  }
+  *is_inf = false;
+}
+
+
+void CliqueHandler::relaxInitInc(RelaxationPtr, bool *is_inf)
+{
+  if (0==table_->getNumCliques() || false==table_->hasVars(p_)) {
+    build_();
+  }
+  *is_inf = false;
+}
+
+
+void CliqueHandler::separate(ConstSolutionPtr sol, NodePtr,
+                             RelaxationPtr rel, CutManager *cutman,
+                             SolutionPoolPtr, bool *,
+                             SeparationStatus *status)
+{
+  const double *x = sol->getPrimal();
+  UInt n, ncomp, j;
+  double sum, xj;
+  bool frac;
+  DoubleVector val;
+  VarVector rvars;
+  UIntVector lits;
+  std::set<UIntVector> seen;
+  LinearFunctionPtr lf;
+  FunctionPtr f;
+  Timer *timer;
+  UInt ncuts = 0;
+
+  if (0==table_->getNumCliques()) {
+    return;
+  }
+  timer = env_->getNewTimer();
+  timer->start();
+
+  // value of every literal, zero if its variable is not in rel. The table
+  // is indexed by variables of p_, which may be numbered differently in rel.
+  n = table_->getNumVars();
+  val.assign(2*n, 0.0);
+  table_->getRelVars(p_, rel, rvars, 0);
+  for (j=0; j<n; ++j) {
+    if (!rvars[j]) {
+      continue;
+    }
+    xj = std::max(0.0, std::min(1.0, x[rvars[j]->getIndex()]));
+    val[CliqueTable::getLit(j, false)] = xj;
+    val[CliqueTable::getLit(j, true)] = 1.0-xj;
+  }
+
+  for (UInt c=0; c<table_->getNumCliques() && ncuts<maxCuts_; ++c) {
+    sum = 0.0;
+    frac = false;
+    for (const UInt *lit=table_->cliqueBegin(c); lit!=table_->cliqueEnd(c);
+         ++lit) {
+      if (!rvars[CliqueTable::getVarIndex(*lit)]) {
+        frac = false;
+        break;
+      }
+      sum += val[*lit];
+      if (val[*lit] > eps_ && val[*lit] < 1.0-eps_) {
+        frac = true;
+      }
+    }
+    if (false==frac || sum < 0.5) {
+      continue;
+    }
+    sum = extend_(c, val, lits);
+    if (sum < 1.0+1e-4) {
+      continue;
+    }
+    std::sort(lits.begin(), lits.end());
+    if (false==seen.insert(lits).second) {
+      continue;
+    }
+
+    // sum_{x in C} x + sum_{~x in C} (1-x) <= 1.
+    lf = (LinearFunctionPtr) new LinearFunction();
+    ncomp = 0;
+    for (UIntVector::const_iterator it=lits.begin(); it!=lits.end(); ++it) {
+      j = CliqueTable::getVarIndex(*it);
+      if (CliqueTable::isComplemented(*it)) {
+        lf->addTerm(rvars[j], -1.0);
+        ++ncomp;
+      } else {
+        lf->addTerm(rvars[j], 1.0);
+      }
+    }
+    f = (FunctionPtr) new Function(lf);
+    if (cutman) {
+      cutman->addCut(rel, f, -INFINITY, 1.0-ncomp, true, false);
+    } else {
+      rel->newConstraint(f, -INFINITY, 1.0-ncomp, "clique_cut");
+    }
+    table_->addClique(lits);
+    ++ncuts;
+  }
+
+  if (ncuts > 0) {
+    *status = SepaResolve;
+    stats_.cuts += ncuts;
+  }
+  stats_.time += timer->query();
+  delete timer;
+}
+
+
+void CliqueHandler::writeStats(std::ostream &out) const
+{
+  out << me_ << "cliques in table            = " << stats_.cliques
+      << std::endl
+      << me_ << "cliques added by cuts       = "
+      << table_->getNumCliques()-stats_.cliques << std::endl
+      << me_ << "clique cuts                 = " << stats_.cuts << std::endl
+      << me_ << "variables fixed in nodes    = " << stats_.fixed << std::endl
+      << me_ << "nodes found infeasible      = " << stats_.inf << std::endl
+      << me_ << "time used                   = " << stats_.time
+      << std::endl;
+}
+
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
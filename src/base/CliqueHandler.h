@@ -0,0 +1,177 @@
+//
+//     MINOTAUR -- It's only 1/2 bull
+//
+//     (C)opyright 2008 - 2014 The MINOTAUR Team.
+//
+
+/**
+ * \file CliqueHandler.h
+ * \brief Declare the CliqueHandler class that builds a clique table of
+ * binary variables, fixes variables using it and separates clique cuts.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#ifndef MINOTAURCLIQUEHANDLER_H
+#define MINOTAURCLIQUEHANDLER_H
+
+#include "CliqueTable.h"
+#include "Handler.h"
+
+namespace Minotaur {
+
+  class Logger;
+  class PropEngine;
+  typedef boost::shared_ptr<Logger> LoggerPtr;
+  typedef boost::shared_ptr<PropEngine> PropEnginePtr;
+
+  /// Statistics of the clique handler.
+  struct CliqueStats {
+    UInt cliques;  ///< Number of cliques in the table.
+    UInt cuts;     ///< Number of clique cuts added.
+    UInt fixed;    ///< Number of variables fixed in nodes.
+    UInt inf;      ///< Number of nodes found infeasible.
+    double time;   ///< Time spent in presolve, propagation and separation.
+  };
+
+  /**
+   * \brief Handler for the cliques of binary variables.
+   *
+   * The constraints of the problem are not changed by this handler. A clique
+   * table is built from the linear constraints in presolve, or when the
+   * relaxation is first created, and is kept for the rest of the solve. Other components can use it through
+   * getCliqueTable(), e.g. to add implications found by probing or to
+   * strengthen lifted cover inequalities.
+   *
+   * In each node, bounds changed by branching are propagated through the
+   * cliques containing the fixed variables. When the relaxation solution is
+   * fractional, cliques of the table are extended greedily with literals of
+   * large value that are adjacent to all of their members, and those with
+   * value more than one are added as cuts.
+   */
+  class CliqueHandler : public Handler {
+  public:
+    /// Constructor.
+    CliqueHandler(EnvPtr env, ProblemPtr problem);
+
+    /// Destroy.
+    ~CliqueHandler();
+
+    /// Does nothing.
+    Branches getBranches(BrCandPtr, DoubleVector &, RelaxationPtr,
+                         SolutionPoolPtr)
+    {return Branches();};
+
+    /// Does nothing.
+    void getBranchingCandidates(RelaxationPtr, const DoubleVector &,
+                                ModVector &, BrVarCandSet &, BrCandVector &,
+                                bool &) {};
+
+    /// Does nothing.
+    ModificationPtr getBrMod(BrCandPtr, DoubleVector &, RelaxationPtr,
+                             BranchDirection)
+    {return ModificationPtr();};
+
+    /**
+     * \brief Return the clique table. It is empty until presolve() is
+     * called, and the same object is filled again if it is rebuilt.
+     */
+    CliqueTablePtr getCliqueTable() const { return table_; }
+
+    // base class method.
+    std::string getName() const;
+
+    /// Cliques are implied by other constraints. Always returns true.
+    bool isFeasible(ConstSolutionPtr, RelaxationPtr, bool &, double &)
+    {return true;};
+
+    /// Return true if the table has at least one clique.
+    bool isNeeded();
+
+    /// Build the clique table. The problem is not changed.
+    SolveStatus presolve(PreModQ *pre_mods, bool *changed);
+
+    /// Propagate bounds changed since the last call through the cliques.
+    bool presolveNode(RelaxationPtr rel, NodePtr node,
+                      SolutionPoolPtr s_pool, ModVector &p_mods,
+                      ModVector &r_mods);
+
+    /// Build the table if it is empty or variables were removed.
+    void relaxInitFull(RelaxationPtr rel, bool *is_inf);
+
+    /// Build the table if it is empty or variables were removed.
+    void relaxInitInc(RelaxationPtr rel, bool *is_inf);
+
+    /// Does nothing.
+    void relaxNodeFull(NodePtr, RelaxationPtr, bool *) {};
+
+    /// Does nothing.
+    void relaxNodeInc(NodePtr, RelaxationPtr, bool *) {};
+
+    /// Add violated clique cuts.
+    void separate(ConstSolutionPtr sol, NodePtr node, RelaxationPtr rel,
+                  CutManager *cutman, SolutionPoolPtr s_pool,
+                  bool *sol_found, SeparationStatus *status);
+
+    // base class method.
+    void writeStats(std::ostream &out) const;
+
+  private:
+    /// Propagates cliques in nodes. Built on the first call of presolveNode.
+    PropEnginePtr engine_;
+
+    /// Environment.
+    EnvPtr env_;
+
+    /// Tolerance.
+    double eps_;
+
+    /// Log.
+    LoggerPtr logger_;
+
+    /// Maximum number of cuts added in one call to separate().
+    UInt maxCuts_;
+
+    /// For logging.
+    static const std::string me_;
+
+    /// The problem whose variables are in the table.
+    ProblemPtr p_;
+
+    /// The relaxation used by engine_.
+    RelaxationPtr rel_;
+
+    /// Statistics.
+    CliqueStats stats_;
+
+    /// The clique table.
+    CliqueTablePtr table_;
+
+    /// Build the table from the constraints of p_.
+    void build_();
+
+    /**
+     * \brief Extend clique c with literals of large value.
+     *
+     * \param[in] c The clique.
+     * \param[in] val Value of every literal in the solution.
+     * \param[out] lits The literals of the extended clique.
+     * \return The sum of values of the literals.
+     */
+    double extend_(UInt c, const DoubleVector &val, UIntVector &lits) const;
+  };
+
+  typedef boost::shared_ptr<CliqueHandler> CliqueHandlerPtr;
+  typedef boost::shared_ptr<const CliqueHandler> ConstCliqueHandlerPtr;
+}
+#endif
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
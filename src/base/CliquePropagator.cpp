@@ -0,0 +1,131 @@
+//
+//     MINOTAUR -- It's only 1/2 bull
+//
+//     (C)opyright 2008 - 2014 The MINOTAUR Team.
+//
+
+/**
+ * \file CliquePropagator.cpp
+ * \brief Implement the methods of class CliquePropagator.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#include <cmath>
+#include <iostream>
+
+#include "MinotaurConfig.h"
+#include "CliquePropagator.h"
+#include "Problem.h"
+#include "PropEngine.h"
+#include "Variable.h"
+
+using namespace Minotaur;
+
+const std::string CliquePropagator::me_ = "CliquePropagator: ";
+
+
+CliquePropagator::CliquePropagator(ConstCliqueTablePtr table, ProblemPtr p)
+  : p_(p),
+    table_(table)
+{
+}
+
+
+CliquePropagator::CliquePropagator(ConstCliqueTablePtr table, ProblemPtr p,
+                                   const VarVector &vars)
+  : p_(p),
+    table_(table),
+    vars_(vars)
+{
+}
+
+
+CliquePropagator::~CliquePropagator()
+{
+  p_.reset();
+  table_.reset();
+  vars_.clear();
+}
+
+
+std::string CliquePropagator::getName() const
+{
+  return "CliquePropagator";
+}
+
+
+VariablePtr CliquePropagator::getVar_(UInt j) const
+{
+  if (!vars_.empty()) {
+    return (j < vars_.size()) ? vars_[j] : VariablePtr();
+  }
+  return (j < p_->getNumVars()) ? p_->getVariable(j) : VariablePtr();
+}
+
+
+void CliquePropagator::getVars(UInt i, VarVector &vars) const
+{
+  VariablePtr v;
+  for (const UInt *lit=table_->cliqueBegin(i); lit!=table_->cliqueEnd(i);
+       ++lit) {
+    v = getVar_(CliqueTable::getVarIndex(*lit));
+    if (v) {
+      vars.push_back(v);
+    }
+  }
+}
+
+
+bool CliquePropagator::propagate(UInt i, PropEngine *engine)
+{
+  const UInt *one = 0;
+  VariablePtr v;
+  int r;
+
+  for (const UInt *lit=table_->cliqueBegin(i); lit!=table_->cliqueEnd(i);
+       ++lit) {
+    v = getVar_(CliqueTable::getVarIndex(*lit));
+    if (!v) {
+      return false;
+    }
+    if ((CliqueTable::isComplemented(*lit) && v->getUb() < 0.5) ||
+        (!CliqueTable::isComplemented(*lit) && v->getLb() > 0.5)) {
+      if (one) {
+        return true;
+      }
+      one = lit;
+    }
+  }
+
+  if (0==one) {
+    return false;
+  }
+  for (const UInt *lit=table_->cliqueBegin(i); lit!=table_->cliqueEnd(i);
+       ++lit) {
+    if (lit==one) {
+      continue;
+    }
+    v = getVar_(CliqueTable::getVarIndex(*lit));
+    if (CliqueTable::isComplemented(*lit)) {
+      r = engine->tighten(v, 1.0, INFINITY);
+    } else {
+      r = engine->tighten(v, -INFINITY, 0.0);
+    }
+    if (r < 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
@@ -0,0 +1,99 @@
+//
+//     MINOTAUR -- It's only 1/2 bull
+//
+//     (C)opyright 2008 - 2014 The MINOTAUR Team.
+//
+
+/**
+ * \file CliquePropagator.h
+ * \brief Declare class CliquePropagator for fixing binary variables using a
+ * clique table.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#ifndef MINOTAURCLIQUEPROPAGATOR_H
+#define MINOTAURCLIQUEPROPAGATOR_H
+
+#include "CliqueTable.h"
+#include "Propagator.h"
+
+namespace Minotaur {
+
+  /**
+   * \brief Fix binary variables using cliques.
+   *
+   * Each clique of the table is an item. If a literal of a clique is fixed
+   * to one, all other literals of the clique are fixed to zero. If two
+   * literals are fixed to one, the node is infeasible. Cliques added to the
+   * table later become new items after PropEngine::update() is called.
+   */
+  class CliquePropagator : public Propagator {
+  public:
+    /**
+     * \brief Constructor.
+     *
+     * \param[in] table The clique table.
+     * \param[in] p The problem whose variables are fixed. Its variables must
+     * have the same indices as those used in the table.
+     */
+    CliquePropagator(ConstCliqueTablePtr table, ProblemPtr p);
+
+    /**
+     * \brief Constructor for a problem that numbers its variables
+     * differently from the table, e.g. a relaxation.
+     *
+     * \param[in] table The clique table.
+     * \param[in] p The problem whose variables are fixed.
+     * \param[in] vars vars[j] is the variable of p for index j of the
+     * table, or NULL. See CliqueTable::getRelVars(). Cliques with a
+     * literal that has no variable are not used.
+     */
+    CliquePropagator(ConstCliqueTablePtr table, ProblemPtr p,
+                     const VarVector &vars);
+
+    /// Destroy.
+    ~CliquePropagator();
+
+    // base class method.
+    std::string getName() const;
+
+    // base class method.
+    UInt getNumItems() const { return table_->getNumCliques(); }
+
+    // base class method.
+    void getVars(UInt i, VarVector &vars) const;
+
+    // base class method.
+    bool propagate(UInt i, PropEngine *engine);
+
+  private:
+    /// For logging.
+    static const std::string me_;
+
+    /// The problem.
+    ProblemPtr p_;
+
+    /// The cliques.
+    ConstCliqueTablePtr table_;
+
+    /// Variable of p_ for each index of the table. Empty if they are equal.
+    VarVector vars_;
+
+    /// Return the variable of p_ for index j of the table, or NULL.
+    VariablePtr getVar_(UInt j) const;
+  };
+
+  typedef boost::shared_ptr<CliquePropagator> CliquePropagatorPtr;
+}
+#endif
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
@@ -0,0 +1,364 @@
+//
+//     MINOTAUR -- It's only 1/2 bull
+//
+//     (C)opyright 2008 - 2014 The MINOTAUR Team.
+//
+
+/**
+ * \file CliqueTable.cpp
+ * \brief Implement the methods of class CliqueTable.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#include "MinotaurConfig.h"
+#include "CliqueTable.h"
+#include "Constraint.h"
+#include "Function.h"
+#include "LinearFunction.h"
+#include "Problem.h"
+#include "Relaxation.h"
+#include "Variable.h"
+
+using namespace Minotaur;
+
+const std::string CliqueTable::me_ = "CliqueTable: ";
+
+typedef std::pair<double, UInt> WeightLit;
+
+static bool largerWeight(const WeightLit &a, const WeightLit &b)
+{
+  return (a.first > b.first);
+}
+
+
+CliqueTable::CliqueTable(UInt n)
+  : beg_(1, 0),
+    litCliques_(2*n)
+{
+}
+
+
+CliqueTable::~CliqueTable()
+{
+  beg_.clear();
+  litCliques_.clear();
+  lits_.clear();
+}
+
+
+bool CliqueTable::addClique(UIntVector &lits)
+{
+  UInt c = getNumCliques();
+  UInt n = 0;
+
+  std::sort(lits.begin(), lits.end());
+  lits.erase(std::unique(lits.begin(), lits.end()), lits.end());
+  if (lits.size() < 2 || lits.back() >= litCliques_.size()) {
+    return false;
+  }
+  for (UInt k=1; k<lits.size(); ++k) {
+    if (lits[k]==negate(lits[k-1])) {
+      return false;
+    }
+  }
+
+  // a clique containing these literals must contain the one with the
+  // fewest cliques. Check only those.
+  for (UInt k=1; k<lits.size(); ++k) {
+    if (litCliques_[lits[k]].size() < litCliques_[lits[n]].size()) {
+      n = k;
+    }
+  }
+  for (UIntVector::const_iterator it=litCliques_[lits[n]].begin();
+       it!=litCliques_[lits[n]].end(); ++it) {
+    if (getSize(*it) >= lits.size() && contains_(*it, lits)) {
+      return false;
+    }
+  }
+
+  for (UIntVector::const_iterator it=lits.begin(); it!=lits.end(); ++it) {
+    lits_.push_back(*it);
+    litCliques_[*it].push_back(c);
+  }
+  beg_.push_back(lits_.size());
+  return true;
+}
+
+
+bool CliqueTable::addImplication(UInt a, UInt b)
+{
+  UIntVector lits(2);
+  lits[0] = a;
+  lits[1] = negate(b);
+  return addClique(lits);
+}
+
+
+UInt CliqueTable::addRow_(std::vector<WeightLit> &terms, double r,
+                          double eps)
+{
+  UInt n = terms.size();
+  UInt k, m;
+  UInt added = 0;
+  UIntVector lits;
+
+  if (n < 2 || r < -eps) {
+    return 0;
+  }
+  std::sort(terms.begin(), terms.end(), largerWeight);
+
+  // terms[0..k-1] is a clique if the two smallest weights in it exceed r.
+  for (k=1; k<n && terms[k-1].first+terms[k].first > r+eps; ++k) {
+  }
+  if (k < 2) {
+    return 0;
+  }
+  for (UInt i=0; i<k; ++i) {
+    lits.push_back(terms[i].second);
+  }
+  if (addClique(lits)) {
+    ++added;
+  }
+
+  // every other literal forms a clique with the leading literals it can not
+  // be one with.
+  for (UInt j=k; j<n; ++j) {
+    for (m=0; m<k && terms[m].first+terms[j].first > r+eps; ++m) {
+    }
+    if (0==m) {
+      break;
+    }
+    lits.clear();
+    for (UInt i=0; i<m; ++i) {
+      lits.push_back(terms[i].second);
+    }
+    lits.push_back(terms[j].second);
+    if (addClique(lits)) {
+      ++added;
+    }
+  }
+  return added;
+}
+
+
+UInt CliqueTable::build(ProblemPtr p, double eps)
+{
+  ConstraintPtr c;
+  LinearFunctionPtr lf;
+  VariablePtr v;
+  double a, lb, ub, shift;
+  bool all_bin;
+  UInt added = 0;
+  std::vector<WeightLit> uterms, lterms;
+
+  setVars(p);
+  for (ConstraintConstIterator it=p->consBegin(); it!=p->consEnd(); ++it) {
+    c = *it;
+    if (DeletedCons==c->getState() || Linear!=c->getFunctionType()) {
+      continue;
+    }
+    lf = c->getLinearFunction();
+    if (!lf || lf->getNumTerms() < 2) {
+      continue;
+    }
+    lb = c->getLb();
+    ub = c->getUb();
+    all_bin = true;
+    shift = 0.0;
+    uterms.clear();
+    lterms.clear();
+    for (VariableGroupConstIterator vit=lf->termsBegin();
+         vit!=lf->termsEnd(); ++vit) {
+      v = vit->first;
+      a = vit->second;
+      if (v->getType()!=Binary &&
+          (v->getType()!=Integer || v->getLb() < -eps ||
+           v->getUb() > 1+eps)) {
+        all_bin = false;
+        break;
+      }
+      if (fabs(a) < eps) {
+        continue;
+      }
+      // for a > 0: a x <= ub. For a < 0: |a| (1-x) <= ub - a.
+      // the lower bound is the same after multiplying by -1.
+      if (a > 0) {
+        uterms.push_back(WeightLit(a, getLit(v->getIndex(), false)));
+        lterms.push_back(WeightLit(a, getLit(v->getIndex(), true)));
+      } else {
+        uterms.push_back(WeightLit(-a, getLit(v->getIndex(), true)));
+        lterms.push_back(WeightLit(-a, getLit(v->getIndex(), false)));
+        shift -= a;
+      }
+    }
+    if (false==all_bin) {
+      continue;
+    }
+    if (ub < INFINITY) {
+      added += addRow_(uterms, ub+shift, eps);
+    }
+    if (lb > -INFINITY) {
+      // -a^Tx <= -lb. Positive coefficients are now the complemented ones.
+      double sum = 0.0;
+      for (std::vector<WeightLit>::const_iterator wit=lterms.begin();
+           wit!=lterms.end(); ++wit) {
+        sum += wit->first;
+      }
+      added += addRow_(lterms, -lb+sum-shift, eps);
+    }
+  }
+  return added;
+}
+
+
+void CliqueTable::clear(UInt n)
+{
+  beg_.assign(1, 0);
+  ids_.clear();
+  lits_.clear();
+  litCliques_.assign(2*n, UIntVector());
+}
+
+
+bool CliqueTable::contains_(UInt c, const UIntVector &lits) const
+{
+  return std::includes(cliqueBegin(c), cliqueEnd(c), lits.begin(),
+                       lits.end());
+}
+
+
+const UIntVector & CliqueTable::getCliques(UInt l) const
+{
+  return litCliques_[l];
+}
+
+
+void CliqueTable::getImplied(UInt l, UIntVector &lits) const
+{
+  UInt n0 = lits.size();
+
+  if (l >= litCliques_.size()) {
+    return;
+  }
+  for (UIntVector::const_iterator it=litCliques_[l].begin();
+       it!=litCliques_[l].end(); ++it) {
+    for (const UInt *lit=cliqueBegin(*it); lit!=cliqueEnd(*it); ++lit) {
+      if (*lit != l) {
+        lits.push_back(*lit);
+      }
+    }
+  }
+  std::sort(lits.begin()+n0, lits.end());
+  lits.erase(std::unique(lits.begin()+n0, lits.end()), lits.end());
+}
+
+
+void CliqueTable::getRelVars(ProblemPtr p, RelaxationPtr rel,
+                             VarVector &vars, UIntVector *ind) const
+{
+  UInt n = std::min(getNumVars(), p->getNumVars());
+  VariablePtr v;
+
+  n = std::min(n, rel->getNumVars());
+  vars.assign(getNumVars(), VariablePtr());
+  if (ind) {
+    ind->assign(rel->getNumVars(), getNumVars());
+  }
+  for (UInt j=0; j<n; ++j) {
+    v = rel->getRelaxationVar(p->getVariable(j));
+    vars[j] = v;
+    if (v && ind && v->getIndex() < ind->size()) {
+      (*ind)[v->getIndex()] = j;
+    }
+  }
+}
+
+
+bool CliqueTable::hasVars(ProblemPtr p) const
+{
+  UInt j = 0;
+
+  if (ids_.size() != p->getNumVars()) {
+    return false;
+  }
+  for (VariableConstIterator it=p->varsBegin(); it!=p->varsEnd();
+       ++it, ++j) {
+    if ((*it)->getId() != ids_[j]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+
+bool CliqueTable::isAdjacent(UInt l1, UInt l2) const
+{
+  const UIntVector *cl;
+  UInt other;
+
+  if (l1 >= litCliques_.size() || l2 >= litCliques_.size() || l1==l2) {
+    return false;
+  }
+  if (litCliques_[l1].size() <= litCliques_[l2].size()) {
+    cl = &(litCliques_[l1]);
+    other = l2;
+  } else {
+    cl = &(litCliques_[l2]);
+    other = l1;
+  }
+  for (UIntVector::const_iterator it=cl->begin(); it!=cl->end(); ++it) {
+    if (std::binary_search(cliqueBegin(*it), cliqueEnd(*it), other)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+
+void CliqueTable::setVars(ProblemPtr p)
+{
+  if (true == hasVars(p)) {
+    return;
+  }
+  clear(p->getNumVars());
+  ids_.reserve(p->getNumVars());
+  for (VariableConstIterator it=p->varsBegin(); it!=p->varsEnd(); ++it) {
+    ids_.push_back((*it)->getId());
+  }
+}
+
+
+void CliqueTable::write(std::ostream &out, ProblemPtr p) const
+{
+  UInt j;
+
+  for (UInt c=0; c<getNumCliques(); ++c) {
+    out << me_ << "clique " << c << ":";
+    for (const UInt *lit=cliqueBegin(c); lit!=cliqueEnd(c); ++lit) {
+      j = getVarIndex(*lit);
+      out << " " << (isComplemented(*lit) ? "~" : "");
+      if (j < p->getNumVars()) {
+        out << p->getVariable(j)->getName();
+      } else {
+        out << "x" << j;
+      }
+    }
+    out << std::endl;
+  }
+}
+
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
@@ -0,0 +1,213 @@
+//
+//     MINOTAUR -- It's only 1/2 bull
+//
+//     (C)opyright 2008 - 2014 The MINOTAUR Team.
+//
+
+/**
+ * \file CliqueTable.h
+ * \brief Declare class CliqueTable for storing cliques and implications
+ * among binary variables.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#ifndef MINOTAURCLIQUETABLE_H
+#define MINOTAURCLIQUETABLE_H
+
+#include "Types.h"
+
+namespace Minotaur {
+
+  class Relaxation;
+  typedef boost::shared_ptr<Relaxation> RelaxationPtr;
+
+  /**
+   * \brief A table of cliques of binary variables.
+   *
+   * A literal is a binary variable \f$x_j\f$ or its complement
+   * \f$1-x_j\f$. Literal 2j is \f$x_j\f$ and literal 2j+1 is its complement.
+   * A clique is a set of literals, at most one of which can be one in a
+   * feasible solution. An implication \f$x_i = 1 \Rightarrow x_j = 1\f$ is
+   * saved as the clique \f$\{x_i, 1-x_j\}\f$, so that the table is also the
+   * implication graph of the binary variables.
+   *
+   * Literals of all cliques are kept in one array, sorted within each
+   * clique. For every literal, the list of cliques containing it is kept, so
+   * that the literals implied by fixing a literal can be found in time
+   * proportional to its degree.
+   *
+   * Variables are identified by their indices in the problem from which
+   * the table was built. A relaxation may number its variables differently,
+   * see getRelVars(). The ids of the variables of that problem are
+   * remembered, see setVars(), so that cliques are not used after presolve
+   * has deleted or added variables.
+   */
+  class CliqueTable {
+  public:
+    /// Constructor for a problem with n variables.
+    CliqueTable(UInt n);
+
+    /// Destroy.
+    ~CliqueTable();
+
+    /**
+     * \brief Add a clique.
+     *
+     * \param[in] lits The literals. They are sorted by this function.
+     * \return True if the clique was added. False if it has fewer than two
+     * literals, contains a literal and its complement, or is contained in a
+     * clique already in the table.
+     */
+    bool addClique(UIntVector &lits);
+
+    /**
+     * \brief Add an implication: if literal a is one, literal b is one.
+     *
+     * \return True if it was added.
+     */
+    bool addImplication(UInt a, UInt b);
+
+    /**
+     * \brief Find cliques in the linear constraints of a problem whose
+     * variables are all binary.
+     *
+     * After complementing variables with negative coefficients, a row is
+     * written as \f$\sum_j w_j l_j \leq r\f$ with \f$w_j > 0\f$. Every set
+     * of literals in which the two smallest weights add up to more than
+     * \f$r\f$ is a clique. The largest such set among the literals with
+     * largest weights is added, along with, for each remaining literal, the
+     * set of literals that can not be one together with it.
+     *
+     * Cliques saved for variables other than those of p are removed first,
+     * see setVars().
+     *
+     * \param[in] p The problem.
+     * \param[in] eps Tolerance.
+     * \return The number of cliques added.
+     */
+    UInt build(ProblemPtr p, double eps);
+
+    /// Remove all cliques and set the number of variables to n.
+    void clear(UInt n);
+
+    /// Return the first literal of clique c.
+    const UInt* cliqueBegin(UInt c) const { return &(lits_[0])+beg_[c]; }
+
+    /// Return the position after the last literal of clique c.
+    const UInt* cliqueEnd(UInt c) const { return &(lits_[0])+beg_[c+1]; }
+
+    /// Return the cliques containing a literal.
+    const UIntVector & getCliques(UInt l) const;
+
+    /**
+     * \brief Get the literals that must be zero when literal l is one.
+     *
+     * \param[in] l The literal.
+     * \param[out] lits The literals are appended to it. Each appears once.
+     */
+    void getImplied(UInt l, UIntVector &lits) const;
+
+    /// Return the literal of variable index j, complemented if comp is true.
+    static UInt getLit(UInt j, bool comp) { return 2*j + (comp ? 1 : 0); }
+
+    /// Return the number of cliques.
+    UInt getNumCliques() const { return beg_.size()-1; }
+
+    /// Return the number of literals in all cliques.
+    UInt getNumLits() const { return lits_.size(); }
+
+    /// Return the number of variables.
+    UInt getNumVars() const { return litCliques_.size()/2; }
+
+    /**
+     * \brief Find the variables of a relaxation that the indices of the
+     * table refer to.
+     *
+     * \param[in] p The problem whose variables the table uses.
+     * \param[in] rel A relaxation of p.
+     * \param[out] vars vars[j] is the variable of rel for index j, or NULL
+     * if there is none.
+     * \param[out] ind If not NULL, (*ind)[i] is the index in the table of
+     * variable i of rel, or getNumVars() if there is none.
+     */
+    void getRelVars(ProblemPtr p, RelaxationPtr rel, VarVector &vars,
+                    UIntVector *ind) const;
+
+    /// Return the size of clique c.
+    UInt getSize(UInt c) const { return beg_[c+1]-beg_[c]; }
+
+    /// Return the index of the variable of a literal.
+    static UInt getVarIndex(UInt l) { return l/2; }
+
+    /// Return true if l1 and l2 are in a common clique.
+    bool isAdjacent(UInt l1, UInt l2) const;
+
+    /**
+     * \brief Return true if the indices of the table refer to the variables
+     * of p.
+     *
+     * This is the case if p has the same variables, by id, as the problem
+     * last given to setVars() or build().
+     */
+    bool hasVars(ProblemPtr p) const;
+
+    /// Return true if literal l is a complemented variable.
+    static bool isComplemented(UInt l) { return (1==l%2); }
+
+    /// Return the complement of a literal.
+    static UInt negate(UInt l) { return l^1; }
+
+    /**
+     * \brief Let the indices of the table refer to the variables of p.
+     *
+     * If the variables of p are not the ones the cliques were saved for,
+     * e.g. because presolve deleted some variables and added others, all
+     * cliques are removed first.
+     */
+    void setVars(ProblemPtr p);
+
+    /// Write the cliques using the names of variables of p.
+    void write(std::ostream &out, ProblemPtr p) const;
+
+  private:
+    /// Position of the first literal of each clique, and the total size.
+    UIntVector beg_;
+
+    /// Ids of the variables, by index, for which the cliques are saved.
+    UIntVector ids_;
+
+    /// Cliques containing each literal.
+    std::vector<UIntVector> litCliques_;
+
+    /// Literals of all cliques.
+    UIntVector lits_;
+
+    /// For logging.
+    static const std::string me_;
+
+    /**
+     * Add cliques of the row \f$\sum_j w_j l_j \leq r\f$. The literals
+     * and weights are sorted by this function.
+     */
+    UInt addRow_(std::vector< std::pair<double, UInt> > &terms, double r,
+                 double eps);
+
+    /// Return true if the sorted literals are all in clique c.
+    bool contains_(UInt c, const UIntVector &lits) const;
+  };
+
+  typedef boost::shared_ptr<CliqueTable> CliqueTablePtr;
+  typedef boost::shared_ptr<const CliqueTable> ConstCliqueTablePtr;
+}
+#endif
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
@@ -0,0 +1,354 @@
+//
+//     MINOTAUR -- It's only 1/2 bull
+//
+//     (C)opyright 2008 - 2014 The MINOTAUR Team.
+//
+
+/**
+ * \file ConflictAnalyzer.cpp
+ * \brief Implement the methods of class ConflictAnalyzer.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#include "MinotaurConfig.h"
+#include "Branch.h"
+#include "ConflictAnalyzer.h"
+#include "ConflictPropagator.h"
+#include "Constraint.h"
+#include "Environment.h"
+#include "LinPropagator.h"
+#include "Node.h"
+#include "Option.h"
+#include "PropEngine.h"
+#include "Relaxation.h"
+#include "Timer.h"
+#include "VarBoundMod.h"
+#include "Variable.h"
+
+using namespace Minotaur;
+
+const std::string ConflictAnalyzer::me_ = "ConflictAnalyzer: ";
+
+
+ConflictAnalyzer::ConflictAnalyzer(EnvPtr env)
+  : env_(env),
+    eps_(1e-6),
+    maxTries_(20)
+{
+  pool_ = (ConflictPoolPtr) new ConflictPool(
+           env->getOptions()->findInt("conflict_max_age")->getValue(),
+           env->getOptions()->findInt("conflict_max_size")->getValue());
+  stats_.calls = 0;
+  stats_.found = 0;
+  stats_.byProp = 0;
+  stats_.lits = 0;
+  stats_.removed = 0;
+  stats_.fixed = 0;
+  stats_.inf = 0;
+  stats_.time = 0.0;
+}
+
+
+ConflictAnalyzer::~ConflictAnalyzer()
+{
+  engine_.reset();
+  linProp_.reset();
+  nodeEngine_.reset();
+  pool_.reset();
+  rel_.reset();
+}
+
+
+void ConflictAnalyzer::analyze(NodePtr node, RelaxationPtr rel)
+{
+  std::vector<ConflictLit> lits;
+  NodePtrVector path;
+  ModVector mods;
+  Timer *timer;
+  UInt last = 0;
+  UInt n0, tries;
+  bool proved = false;
+
+  if (NodeInfeasible!=node->getStatus() && NodeHitUb!=node->getStatus()) {
+    return;
+  }
+  syncEngines_(rel);
+  if (false==getDecisions_(node, lits, path) || lits.empty()) {
+    return;
+  }
+  timer = env_->getNewTimer();
+  timer->start();
+  ++stats_.calls;
+
+  // go back to the bounds of the root.
+  for (NodePtrVector::iterator it=path.begin(); it!=path.end(); ++it) {
+    (*it)->undoRMods(rel);
+  }
+  engine_->sync();
+  engine_->update();
+  if (false==engine_->propagate(&mods, 0)) {
+    proved = isInfeasible_(lits, lits.size(), &last);
+    if (proved) {
+      lits.resize(last+1);
+      // the last decision is needed, try to remove the others.
+      n0 = lits.size();
+      tries = 0;
+      for (UInt k=0; k+1<lits.size() && tries<maxTries_; ++tries) {
+        if (isInfeasible_(lits, k, &last)) {
+          lits.erase(lits.begin()+k);
+          if (last > k) {
+            --last;
+          }
+          lits.resize(last+1);
+        } else {
+          ++k;
+        }
+      }
+      stats_.removed += n0-lits.size();
+    }
+  }
+  engine_->undo(mods, 0);
+
+  for (NodePtrVector::reverse_iterator it=path.rbegin(); it!=path.rend();
+       ++it) {
+    (*it)->applyRMods(rel);
+  }
+
+  n0 = lits.size();
+  if (pool_->addConflict(lits)) {
+    ++stats_.found;
+    stats_.lits += n0;
+    if (proved) {
+      ++stats_.byProp;
+    }
+  }
+  stats_.time += timer->query();
+  delete timer;
+}
+
+
+void ConflictAnalyzer::clear()
+{
+  pool_ = (ConflictPoolPtr) new ConflictPool(
+           env_->getOptions()->findInt("conflict_max_age")->getValue(),
+           env_->getOptions()->findInt("conflict_max_size")->getValue());
+  engine_.reset();
+  linProp_.reset();
+  nodeEngine_.reset();
+  rel_.reset();
+}
+
+
+bool ConflictAnalyzer::getDecisions_(NodePtr node,
+                                     std::vector<ConflictLit> &lits,
+                                     NodePtrVector &path)
+{
+  BranchPtr br;
+  VarBoundModPtr bmod;
+  VarBoundMod2Ptr bmod2;
+  VariablePtr v;
+  ConflictLit lit;
+  UInt n0;
+
+  for (NodePtr n=node; n->getParent(); n=n->getParent()) {
+    path.push_back(n);
+    br = n->getBranch();
+    if (!br) {
+      continue;
+    }
+    // decisions are collected from the node upwards, and reversed below.
+    n0 = lits.size();
+    for (ModificationConstIterator it=br->rModsBegin(); it!=br->rModsEnd();
+         ++it) {
+      bmod = boost::dynamic_pointer_cast<VarBoundMod>(*it);
+      bmod2 = boost::dynamic_pointer_cast<VarBoundMod2>(*it);
+      if (bmod) {
+        v = bmod->getVar();
+        lit.lu = bmod->getLU();
+        lit.val = bmod->getNewVal();
+        lit.j = v->getIndex();
+        lits.push_back(lit);
+      } else if (bmod2) {
+        v = bmod2->getVar();
+        lit.j = v->getIndex();
+        if (bmod2->getNewLb() > -INFINITY) {
+          lit.lu = Lower;
+          lit.val = bmod2->getNewLb();
+          lits.push_back(lit);
+        }
+        if (bmod2->getNewUb() < INFINITY) {
+          lit.lu = Upper;
+          lit.val = bmod2->getNewUb();
+          lits.push_back(lit);
+        }
+      } else {
+        return false;
+      }
+      if (v->getIndex() >= rel_->getNumVars() ||
+          rel_->getVariable(v->getIndex())!=v) {
+        return false;
+      }
+    }
+    std::reverse(lits.begin()+n0, lits.end());
+  }
+  std::reverse(lits.begin(), lits.end());
+  return true;
+}
+
+
+bool ConflictAnalyzer::isInfeasible_(const std::vector<ConflictLit> &lits,
+                                     UInt skip, UInt *last)
+{
+  ModVector mods;
+  ModificationPtr mod;
+  VariablePtr v;
+  bool is_inf = false;
+
+  for (UInt k=0; k<lits.size() && false==is_inf; ++k) {
+    if (k==skip) {
+      continue;
+    }
+    *last = k;
+    v = rel_->getVariable(lits[k].j);
+    if (Lower==lits[k].lu) {
+      if (lits[k].val > v->getUb()+eps_) {
+        is_inf = true;
+      } else if (lits[k].val > v->getLb()) {
+        mod = (VarBoundModPtr) new VarBoundMod(v, Lower, lits[k].val);
+      }
+    } else {
+      if (lits[k].val < v->getLb()-eps_) {
+        is_inf = true;
+      } else if (lits[k].val < v->getUb()) {
+        mod = (VarBoundModPtr) new VarBoundMod(v, Upper, lits[k].val);
+      }
+    }
+    if (mod) {
+      mod->applyToProblem(rel_);
+      mods.push_back(mod);
+      engine_->varChanged(v);
+      is_inf = engine_->propagate(&mods, 0);
+      mod.reset();
+    }
+  }
+  engine_->undo(mods, 0);
+  return is_inf;
+}
+
+
+bool ConflictAnalyzer::propagate(RelaxationPtr rel, ModVector &r_mods)
+{
+  UInt n0 = r_mods.size();
+  bool is_inf;
+  Timer *timer = env_->getNewTimer();
+
+  timer->start();
+  if (pool_->age()) {
+    // conflicts have new numbers.
+    engine_.reset();
+    nodeEngine_.reset();
+  }
+  syncEngines_(rel);
+  is_inf = nodeEngine_->propagate(&r_mods, 0);
+  stats_.fixed += r_mods.size()-n0;
+  if (is_inf) {
+    ++stats_.inf;
+  }
+  stats_.time += timer->query();
+  delete timer;
+  return is_inf;
+}
+
+
+void ConflictAnalyzer::syncEngines_(RelaxationPtr rel)
+{
+  ConstraintPtr c;
+  UInt pos = 0;
+  bool rebuild = !engine_ || rel!=rel_;
+
+  if (false==rebuild) {
+    for (ConstraintConstIterator it=rel->consBegin(); it!=rel->consEnd();
+         ++it) {
+      c = *it;
+      if (c->getFunctionType()!=Linear) {
+        continue;
+      }
+      if (pos < linProp_->getNumItems()) {
+        if (c!=linProp_->getCons(pos)) {
+          rebuild = true;
+          break;
+        } else if (linProp_->refresh(pos)) {
+          engine_->itemChanged(0, pos);
+        }
+      } else {
+        linProp_->addCons(c);
+      }
+      ++pos;
+    }
+    if (pos < linProp_->getNumItems()) {
+      rebuild = true;
+    }
+  }
+
+  if (true==rebuild) {
+    rel_ = rel;
+    linProp_ = (LinPropagatorPtr) new LinPropagator(rel, 1e-8, 1e20);
+    for (ConstraintConstIterator it=rel->consBegin(); it!=rel->consEnd();
+         ++it) {
+      if ((*it)->getFunctionType()==Linear) {
+        linProp_->addCons(*it);
+      }
+    }
+    engine_ = (PropEnginePtr) new PropEngine(rel);
+    engine_->setTols(1e-8, 1e-6);
+    engine_->addPropagator(linProp_);
+    engine_->addPropagator((ConflictPropagatorPtr)
+                           new ConflictPropagator(pool_, rel, eps_));
+    engine_->init();
+  }
+  if (!nodeEngine_ || true==rebuild) {
+    nodeEngine_ = (PropEnginePtr) new PropEngine(rel);
+    nodeEngine_->setTols(1e-8, 1e-6);
+    nodeEngine_->addPropagator((ConflictPropagatorPtr)
+                               new ConflictPropagator(pool_, rel, eps_));
+    nodeEngine_->init();
+  } else {
+    nodeEngine_->sync();
+    nodeEngine_->update();
+  }
+}
+
+
+void ConflictAnalyzer::writeStats(std::ostream &out) const
+{
+  out << me_ << "nodes analyzed              = " << stats_.calls << std::endl
+      << me_ << "conflicts found             = " << stats_.found << std::endl
+      << me_ << "proved by propagation       = " << stats_.byProp
+      << std::endl
+      << me_ << "literals in conflicts       = " << stats_.lits << std::endl
+      << me_ << "literals removed            = " << stats_.removed
+      << std::endl
+      << me_ << "conflicts in pool           = " << pool_->getNumActive()
+      << std::endl
+      << me_ << "conflicts removed by age    = " << pool_->getNumRemoved()
+      << std::endl
+      << me_ << "bounds tightened            = " << stats_.fixed << std::endl
+      << me_ << "nodes found infeasible      = " << stats_.inf << std::endl
+      << me_ << "time used                   = " << stats_.time << std::endl;
+}
+
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
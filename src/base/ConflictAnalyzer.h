@@ -0,0 +1,176 @@
+//
+//     MINOTAUR -- It's only 1/2 bull
+//
+//     (C)opyright 2008 - 2014 The MINOTAUR Team.
+//
+
+/**
+ * \file ConflictAnalyzer.h
+ * \brief Declare class ConflictAnalyzer for learning conflicts from pruned
+ * nodes of branch-and-bound.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#ifndef MINOTAURCONFLICTANALYZER_H
+#define MINOTAURCONFLICTANALYZER_H
+
+#include "ConflictPool.h"
+
+namespace Minotaur {
+
+  class LinPropagator;
+  class PropEngine;
+  class Relaxation;
+  typedef boost::shared_ptr<LinPropagator> LinPropagatorPtr;
+  typedef boost::shared_ptr<PropEngine> PropEnginePtr;
+  typedef boost::shared_ptr<Relaxation> RelaxationPtr;
+
+  /// Statistics of conflict analysis.
+  struct ConflictStats {
+    UInt calls;    ///< Number of nodes analyzed.
+    UInt found;    ///< Number of conflicts added to the pool.
+    UInt byProp;   ///< Number of those proved by propagation.
+    UInt lits;     ///< Number of literals in conflicts added.
+    UInt removed;  ///< Number of literals removed from conflicts.
+    UInt fixed;    ///< Number of bounds tightened using conflicts.
+    UInt inf;      ///< Number of nodes found infeasible using conflicts.
+    double time;   ///< Time spent in analysis and propagation.
+  };
+
+  /**
+   * \brief Learn conflicts from nodes that are infeasible or pruned by
+   * bound, and use them in later nodes.
+   *
+   * The branching decisions on the path from the root to a pruned node can
+   * not all hold in a solution better than the incumbent. analyze() takes
+   * the relaxation back to the bounds of the root, applies the decisions
+   * one by one and propagates the linear constraints of the relaxation and
+   * the conflicts already known. If propagation shows infeasibility, the
+   * decisions applied so far are a conflict, and decisions that are not
+   * needed for the proof are removed from it. Otherwise, e.g. if only the
+   * relaxation was infeasible, all decisions are the conflict. Conflicts
+   * larger than the maximum size are thrown away.
+   *
+   * propagate() tightens bounds in a node using the conflicts of the pool.
+   * It also ages the pool, once per node. Since conflicts may depend on the
+   * incumbent, they are valid only while the search is for better
+   * solutions.
+   *
+   * Only bounds of variables of the relaxation are used as decisions. If a
+   * branch on the path changes anything else, the node is not analyzed.
+   */
+  class ConflictAnalyzer {
+  public:
+    /// Constructor.
+    ConflictAnalyzer(EnvPtr env);
+
+    /// Destroy.
+    ~ConflictAnalyzer();
+
+    /**
+     * \brief Find a conflict from a node that was pruned, and add it to the
+     * pool.
+     *
+     * \param[in] node The node. Its modifications must be applied to rel.
+     * They are undone and applied again.
+     * \param[in] rel The relaxation.
+     */
+    void analyze(NodePtr node, RelaxationPtr rel);
+
+    /**
+     * \brief Remove all conflicts, e.g. when the problem or the incumbent
+     * they were learned with has changed.
+     */
+    void clear();
+
+    /// Return the pool of conflicts.
+    ConflictPoolPtr getPool() const { return pool_; }
+
+    /**
+     * \brief Tighten bounds in a node using conflicts.
+     *
+     * \param[in] rel The relaxation of the node.
+     * \param[out] r_mods Changes to bounds are appended to it.
+     * \return True if the node is infeasible.
+     */
+    bool propagate(RelaxationPtr rel, ModVector &r_mods);
+
+    /// Write statistics.
+    void writeStats(std::ostream &out) const;
+
+  private:
+    /// Propagates linear constraints and conflicts in analyze().
+    PropEnginePtr engine_;
+
+    /// Environment.
+    EnvPtr env_;
+
+    /// Tolerance.
+    double eps_;
+
+    /// Linear constraints of the relaxation, used by engine_.
+    LinPropagatorPtr linProp_;
+
+    /// Maximum number of attempts to remove a literal from a conflict.
+    UInt maxTries_;
+
+    /// For logging.
+    static const std::string me_;
+
+    /// Propagates conflicts in nodes.
+    PropEnginePtr nodeEngine_;
+
+    /// The conflicts.
+    ConflictPoolPtr pool_;
+
+    /// The relaxation used by the engines.
+    RelaxationPtr rel_;
+
+    /// Statistics.
+    ConflictStats stats_;
+
+    /**
+     * \brief Get the bounds changed by branching on the path from the root
+     * to a node.
+     *
+     * \param[in] node The node.
+     * \param[out] lits The decisions, from the root to the node.
+     * \param[out] path The nodes below the root on the path, the deepest
+     * first.
+     * \return False if a branch changes something other than bounds of
+     * variables of rel_.
+     */
+    bool getDecisions_(NodePtr node, std::vector<ConflictLit> &lits,
+                       NodePtrVector &path);
+
+    /**
+     * \brief Apply literals one at a time and propagate. All changes are
+     * undone before returning.
+     *
+     * \param[in] lits The literals.
+     * \param[in] skip The literal at this position is not applied.
+     * \param[out] last Position of the literal after which infeasibility was
+     * found.
+     * \return True if infeasibility was found.
+     */
+    bool isInfeasible_(const std::vector<ConflictLit> &lits, UInt skip,
+                       UInt *last);
+
+    /// Create the engines, or update them if rel has new constraints.
+    void syncEngines_(RelaxationPtr rel);
+  };
+
+  typedef boost::shared_ptr<ConflictAnalyzer> ConflictAnalyzerPtr;
+}
+#endif
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
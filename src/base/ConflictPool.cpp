@@ -0,0 +1,140 @@
+//
+//     MINOTAUR -- It's only 1/2 bull
+//
+//     (C)opyright 2008 - 2014 The MINOTAUR Team.
+//
+
+/**
+ * \file ConflictPool.cpp
+ * \brief Implement the methods of class ConflictPool.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#include <algorithm>
+#include <iostream>
+
+#include "MinotaurConfig.h"
+#include "ConflictPool.h"
+
+using namespace Minotaur;
+
+const std::string ConflictPool::me_ = "ConflictPool: ";
+
+static bool lessLit(const ConflictLit &a, const ConflictLit &b)
+{
+  if (a.j != b.j) {
+    return (a.j < b.j);
+  }
+  if (a.lu != b.lu) {
+    return (a.lu < b.lu);
+  }
+  return (a.val < b.val);
+}
+
+
+static bool sameLit(const ConflictLit &a, const ConflictLit &b)
+{
+  return (a.j==b.j && a.lu==b.lu && a.val==b.val);
+}
+
+
+ConflictPool::ConflictPool(UInt max_age, UInt max_size)
+  : maxAge_(max_age),
+    maxSize_(max_size),
+    nActive_(0),
+    nRemoved_(0)
+{
+}
+
+
+ConflictPool::~ConflictPool()
+{
+  age_.clear();
+  lits_.clear();
+}
+
+
+bool ConflictPool::addConflict(std::vector<ConflictLit> &lits)
+{
+  if (lits.empty() || lits.size() > maxSize_) {
+    return false;
+  }
+  std::sort(lits.begin(), lits.end(), lessLit);
+  lits.erase(std::unique(lits.begin(), lits.end(), sameLit), lits.end());
+  for (UInt c=0; c<lits_.size(); ++c) {
+    if (lits_[c].size()==lits.size() &&
+        std::equal(lits.begin(), lits.end(), lits_[c].begin(), sameLit)) {
+      age_[c] = 0;
+      return false;
+    }
+  }
+  lits_.push_back(lits);
+  age_.push_back(0);
+  ++nActive_;
+  return true;
+}
+
+
+bool ConflictPool::age()
+{
+  for (UInt c=0; c<lits_.size(); ++c) {
+    if (false==lits_[c].empty() && ++age_[c] > maxAge_) {
+      lits_[c].clear();
+      --nActive_;
+      ++nRemoved_;
+    }
+  }
+
+  // compact only when most conflicts are removed, since numbers change.
+  if (lits_.size() > 2*nActive_ + 100) {
+    compact_();
+    return true;
+  }
+  return false;
+}
+
+
+void ConflictPool::compact_()
+{
+  UInt k = 0;
+
+  for (UInt c=0; c<lits_.size(); ++c) {
+    if (false==lits_[c].empty()) {
+      if (k < c) {
+        lits_[k].swap(lits_[c]);
+        age_[k] = age_[c];
+      }
+      ++k;
+    }
+  }
+  lits_.resize(k);
+  age_.resize(k);
+}
+
+
+void ConflictPool::write(std::ostream &out) const
+{
+  for (UInt c=0; c<lits_.size(); ++c) {
+    if (lits_[c].empty()) {
+      continue;
+    }
+    out << me_ << "conflict " << c << " age " << age_[c] << ":";
+    for (std::vector<ConflictLit>::const_iterator it=lits_[c].begin();
+         it!=lits_[c].end(); ++it) {
+      out << " x" << it->j << (it->lu==Lower ? " >= " : " <= ") << it->val;
+    }
+    out << std::endl;
+  }
+}
+
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
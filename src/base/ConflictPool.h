@@ -0,0 +1,143 @@
+//
+//     MINOTAUR -- It's only 1/2 bull
+//
+//     (C)opyright 2008 - 2014 The MINOTAUR Team.
+//
+
+/**
+ * \file ConflictPool.h
+ * \brief Declare class ConflictPool for storing conflicts learnt in
+ * branch-and-bound.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#ifndef MINOTAURCONFLICTPOOL_H
+#define MINOTAURCONFLICTPOOL_H
+
+#include "Types.h"
+
+namespace Minotaur {
+
+  /**
+   * \brief A bound of a variable in a conflict: \f$x_j \geq val\f$ if lu is
+   * Lower, \f$x_j \leq val\f$ if lu is Upper.
+   */
+  struct ConflictLit {
+    UInt j;        ///< Index of the variable.
+    BoundType lu;  ///< Lower or Upper.
+    double val;    ///< The bound.
+  };
+
+  /**
+   * \brief A pool of conflicts.
+   *
+   * A conflict is a set of bounds of variables that can not all hold in a
+   * solution better than the incumbent. Conflicts are found from nodes that
+   * were pruned, and are numbered in the order in which they are added.
+   *
+   * Every conflict has an age: the number of calls to age() since it was
+   * added or since it was last used to tighten a bound. Conflicts older
+   * than the maximum age are removed. A removed conflict keeps its number
+   * and has no literals, until the pool is compacted.
+   */
+  class ConflictPool {
+  public:
+    /**
+     * \brief Constructor.
+     *
+     * \param[in] max_age Conflicts older than this are removed.
+     * \param[in] max_size Conflicts with more literals are not added.
+     */
+    ConflictPool(UInt max_age, UInt max_size);
+
+    /// Destroy.
+    ~ConflictPool();
+
+    /**
+     * \brief Add a conflict.
+     *
+     * \param[in] lits The literals. They are sorted by this function.
+     * \return True if it was added. False if it is empty, too large, or
+     * already in the pool.
+     */
+    bool addConflict(std::vector<ConflictLit> &lits);
+
+    /**
+     * \brief Increase the age of all conflicts and remove old ones.
+     *
+     * \return True if the pool was compacted, so that conflicts have new
+     * numbers.
+     */
+    bool age();
+
+    /// Return the first literal of conflict c, which must be active.
+    const ConflictLit* begin(UInt c) const { return &(lits_[c][0]); }
+
+    /// Return the position after the last literal of conflict c.
+    const ConflictLit* end(UInt c) const
+    { return &(lits_[c][0])+lits_[c].size(); }
+
+    /// Return the maximum number of literals in a conflict.
+    UInt getMaxSize() const { return maxSize_; }
+
+    /// Return the number of conflicts, including removed ones.
+    UInt getNumConflicts() const { return lits_.size(); }
+
+    /// Return the number of conflicts that have not been removed.
+    UInt getNumActive() const { return nActive_; }
+
+    /// Return the number of conflicts removed because of age.
+    UInt getNumRemoved() const { return nRemoved_; }
+
+    /// Return the number of literals of conflict c.
+    UInt getSize(UInt c) const { return lits_[c].size(); }
+
+    /// Return true if conflict c has not been removed.
+    bool isActive(UInt c) const { return false==lits_[c].empty(); }
+
+    /// Mark conflict c as used, so that its age becomes zero.
+    void used(UInt c) { age_[c] = 0; }
+
+    /// Write the conflicts.
+    void write(std::ostream &out) const;
+
+  private:
+    /// Age of each conflict.
+    UIntVector age_;
+
+    /// Literals of each conflict. Empty if the conflict was removed.
+    std::vector< std::vector<ConflictLit> > lits_;
+
+    /// Maximum age.
+    UInt maxAge_;
+
+    /// Maximum number of literals.
+    UInt maxSize_;
+
+    /// For logging.
+    static const std::string me_;
+
+    /// Number of active conflicts.
+    UInt nActive_;
+
+    /// Number of conflicts removed.
+    UInt nRemoved_;
+
+    /// Remove the conflicts that have no literals, and renumber the rest.
+    void compact_();
+  };
+
+  typedef boost::shared_ptr<ConflictPool> ConflictPoolPtr;
+}
+#endif
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
@@ -0,0 +1,125 @@
+//
+//     MINOTAUR -- It's only 1/2 bull
+//
+//     (C)opyright 2008 - 2014 The MINOTAUR Team.
+//
+
+/**
+ * \file ConflictPropagator.cpp
+ * \brief Implement the methods of class ConflictPropagator.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#include <cmath>
+
+#include "MinotaurConfig.h"
+#include "ConflictPropagator.h"
+#include "Problem.h"
+#include "PropEngine.h"
+#include "Variable.h"
+
+using namespace Minotaur;
+
+const std::string ConflictPropagator::me_ = "ConflictPropagator: ";
+
+
+ConflictPropagator::ConflictPropagator(ConflictPoolPtr pool, ProblemPtr p,
+                                       double eps)
+  : eps_(eps),
+    p_(p),
+    pool_(pool)
+{
+}
+
+
+ConflictPropagator::~ConflictPropagator()
+{
+  p_.reset();
+  pool_.reset();
+}
+
+
+std::string ConflictPropagator::getName() const
+{
+  return "ConflictPropagator";
+}
+
+
+void ConflictPropagator::getVars(UInt i, VarVector &vars) const
+{
+  if (false==pool_->isActive(i)) {
+    return;
+  }
+  for (const ConflictLit *lit=pool_->begin(i); lit!=pool_->end(i); ++lit) {
+    if (lit->j < p_->getNumVars()) {
+      vars.push_back(p_->getVariable(lit->j));
+    }
+  }
+}
+
+
+bool ConflictPropagator::propagate(UInt i, PropEngine *engine)
+{
+  const ConflictLit *open = 0;
+  VariablePtr v;
+  bool is_int;
+  double b;
+  int r;
+
+  if (false==pool_->isActive(i)) {
+    return false;
+  }
+  for (const ConflictLit *lit=pool_->begin(i); lit!=pool_->end(i); ++lit) {
+    if (lit->j >= p_->getNumVars()) {
+      return false;
+    }
+    v = p_->getVariable(lit->j);
+    if (Lower==lit->lu) {
+      if (v->getLb() > lit->val-eps_) {
+        continue;
+      } else if (v->getUb() < lit->val-eps_) {
+        return false;
+      }
+    } else {
+      if (v->getUb() < lit->val+eps_) {
+        continue;
+      } else if (v->getLb() > lit->val+eps_) {
+        return false;
+      }
+    }
+    if (open) {
+      return false;
+    }
+    open = lit;
+  }
+
+  if (0==open) {
+    pool_->used(i);
+    return true;
+  }
+  v = p_->getVariable(open->j);
+  is_int = (v->getType()==Binary || v->getType()==Integer);
+  if (Lower==open->lu) {
+    b = is_int ? open->val-1.0 : open->val;
+    r = engine->tighten(v, -INFINITY, b);
+  } else {
+    b = is_int ? open->val+1.0 : open->val;
+    r = engine->tighten(v, b, INFINITY);
+  }
+  if (r != 0) {
+    pool_->used(i);
+  }
+  return (r < 0);
+}
+
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
@@ -0,0 +1,87 @@
+//
+//     MINOTAUR -- It's only 1/2 bull
+//
+//     (C)opyright 2008 - 2014 The MINOTAUR Team.
+//
+
+/**
+ * \file ConflictPropagator.h
+ * \brief Declare class ConflictPropagator for tightening bounds using
+ * conflicts.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#ifndef MINOTAURCONFLICTPROPAGATOR_H
+#define MINOTAURCONFLICTPROPAGATOR_H
+
+#include "ConflictPool.h"
+#include "Propagator.h"
+
+namespace Minotaur {
+
+  /**
+   * \brief Tighten bounds using the conflicts of a pool.
+   *
+   * Each conflict of the pool is an item. If all literals of a conflict
+   * hold, the node is infeasible. If all but one hold, and the last one is
+   * not already false, the opposite of the last one is imposed: a bound
+   * \f$x_j \leq u\f$ becomes \f$x_j \geq u+1\f$ for integer variables and
+   * \f$x_j \geq u\f$ for continuous ones. A conflict that is used has its
+   * age set to zero. Conflicts added later become new items after
+   * PropEngine::update() is called.
+   */
+  class ConflictPropagator : public Propagator {
+  public:
+    /**
+     * \brief Constructor.
+     *
+     * \param[in] pool The conflicts.
+     * \param[in] p The problem whose bounds are tightened. Its variables
+     * must have the indices used in the pool.
+     * \param[in] eps Tolerance for checking if a literal holds.
+     */
+    ConflictPropagator(ConflictPoolPtr pool, ProblemPtr p, double eps);
+
+    /// Destroy.
+    ~ConflictPropagator();
+
+    // base class method.
+    std::string getName() const;
+
+    // base class method.
+    UInt getNumItems() const { return pool_->getNumConflicts(); }
+
+    // base class method.
+    void getVars(UInt i, VarVector &vars) const;
+
+    // base class method.
+    bool propagate(UInt i, PropEngine *engine);
+
+  private:
+    /// Tolerance.
+    double eps_;
+
+    /// For logging.
+    static const std::string me_;
+
+    /// The problem.
+    ProblemPtr p_;
+
+    /// The conflicts.
+    ConflictPoolPtr pool_;
+  };
+
+  typedef boost::shared_ptr<ConflictPropagator> ConflictPropagatorPtr;
+}
+#endif
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
@@ -52,8 +52,10 @@ CoverCutGenerator::CoverCutGenerator(ProblemPtr , SolutionPtr , EnvPtr )
   // }
 }
 
-CoverCutGenerator::CoverCutGenerator(RelaxationPtr rel, ConstSolutionPtr sol, EnvPtr env)
-// : stats_(0)
+CoverCutGenerator::CoverCutGenerator(RelaxationPtr rel, ConstSolutionPtr sol, EnvPtr env,
+                                     ConstCliqueTablePtr cliques,
+                                     const UIntVector &clique_ind)
+  : cliques_(cliques), cliqueInd_(clique_ind) // stats_(0)
 {
   //ProblemPtr p;
   //p = rel;
@@ -640,6 +642,20 @@ void CoverCutGenerator::cBar(const ConstCoverSetPtr cover,
   }  
 }
 
+UInt CoverCutGenerator::cliqueLit_(ConstVariablePtr v) const
+{
+  UInt j = v->getIndex();
+
+  if (!cliques_) {
+    return 0;
+  }
+  if (!cliqueInd_.empty()) {
+    j = (j < cliqueInd_.size()) ? cliqueInd_[j] : cliques_->getNumVars();
+  }
+  return CliqueTable::getLit(std::min(j, cliques_->getNumVars()), false);
+}
+
+
 /*
   We have to check if these coefficients are integer, however they can be
   noninteger as well !!!!!
@@ -667,8 +683,15 @@ double CoverCutGenerator::lift(const ConstCoverSetPtr obj,
   CoverSetConstIterator begin = obj->begin();
   CoverSetConstIterator end   = obj->end();
   UInt i = 0;
+  // When the variable is lifted up, it is one in the lifting problem, so
+  // variables in a clique with it must be zero.
+  UInt lit = cliqueLit_(variable->first);
   for (it=begin; it!=end; ++it) {
     c[i] = it->second;
+    if (uplift && cliques_ &&
+        cliques_->isAdjacent(lit, cliqueLit_(it->first))) {
+      c[i] = 0.0;
+    }
     i += 1;
   }
   
@@ -966,44 +989,32 @@ bool CoverCutGenerator::checkExists(CoverSetPtr cov, double rhs)
   CoverSetIterator it;
   CoverSetIterator begin = cov->begin();
   CoverSetIterator end = cov->end();
-  // Number of variables in the linear function.
-  UInt numvars = p_->getNumVars();
-  // Vector to include the coefficients.
-  std::vector<double> coeffs(numvars,0);
-  // Index of the variable in the problem.
-  UInt index;
-  // Current variable considered.
-  VariablePtr var;
-  // Coefficient divided by rhs of cover inequality.
-  double dividedcoeff;
-  // Add the coefficients to coefficient vector one by one.
+  // Indices and coefficients of variables in the cut.
+  UIntVector ind;
+  DoubleVector val;
+  // Add the coefficients one by one.
   if (DEBUG_LEVEL >= 10) {
     cerr << "Coeffs: ";
   }
   for (it=begin; it!=end; ++it) {
-    var = it->first;
-    index  = var->getIndex();
-    // Serdar check this int, what it does, probably it should not be here.
-    dividedcoeff = double(it->second) / rhs;
-    coeffs[index] = dividedcoeff;
+    if (it->second != 0) {
+      ind.push_back(it->first->getIndex());
+      val.push_back(it->second);
+    }
     if (DEBUG_LEVEL >=  10) {
-      cerr << dividedcoeff << " ";
+      cerr << double(it->second) / rhs << " ";
     } 
   }
   if (DEBUG_LEVEL >= 10) {
     cerr << endl;
   }
 
-  // Check if the cut already exists.
-  std::map< std::vector<double>, UInt>::iterator found = cutmap.find(coeffs);
-  std::map< std::vector<double>, UInt>::iterator endmap = cutmap.end();
-  if (found == endmap) {
-    cutmap.insert(std::pair< std::vector<double>, UInt > (coeffs,stats_->totalcuts));
-    return false;
-  } else {
+  // Check if the cut (or a tighter one) already exists.
+  if (cutPool_.findDup(ind, val, 0.0, rhs) >= 0) {
     return true;
   }
-
+  cutPool_.addRow(ind, val, 0.0, rhs);
+  return false;
 }
 
 
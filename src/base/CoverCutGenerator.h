@@ -20,11 +20,13 @@ using std::ofstream;
 #include <string>
 using std::string;
 
+#include "CliqueTable.h"
 #include "KnapsackList.h"
 #include "Problem.h"
 #include "Solution.h"
 #include "Types.h"
 #include "Cut.h"
+#include "CutPool.h"
 #include "Relaxation.h"
 #include "Environment.h"
 
@@ -92,8 +94,17 @@ namespace Minotaur {
     // Constructor that uses a problem and a solution given.
     CoverCutGenerator(ProblemPtr p, SolutionPtr s, EnvPtr env);
 
-    // Constructor that uses a relaxation and a solution given.
-    CoverCutGenerator(RelaxationPtr rel, ConstSolutionPtr sol, EnvPtr env);
+    /**
+     * Constructor that uses a relaxation and a solution given. If a clique
+     * table is given, variables in a clique with the variable being
+     * up-lifted are kept at zero in the lifting problem. If the table is
+     * indexed by the variables of another problem, clique_ind gives the
+     * index in the table of each variable of rel, see
+     * CliqueTable::getRelVars().
+     */
+    CoverCutGenerator(RelaxationPtr rel, ConstSolutionPtr sol, EnvPtr env,
+                      ConstCliqueTablePtr cliques = ConstCliqueTablePtr(),
+                      const UIntVector &clique_ind = UIntVector());
 
     // Destructor
     ~CoverCutGenerator();
@@ -325,6 +336,15 @@ namespace Minotaur {
                        double alpha);
 
   private:
+    // Return the literal of variable v in cliques_, out of range if none.
+    UInt cliqueLit_(ConstVariablePtr v) const;
+
+    // Cliques of binary variables, may be empty.
+    ConstCliqueTablePtr cliques_;
+
+    // Index in cliques_ of each variable of p_. Empty if they are the same.
+    UIntVector cliqueInd_;
+
     // Environment.
     EnvPtr env_;
 
@@ -355,8 +375,8 @@ namespace Minotaur {
     // Statistics for cover cut generator.
     CovCutGenStatsPtr stats_;
 
-    // Hash map that is used to check if a cut is already created or not.
-    std::map< std::vector<double>, UInt> cutmap;  
+    // Cuts created so far, used to check if a cut is already created or not.
+    CutPool cutPool_;
 
     // Integer tolerance.
     double intTol_;
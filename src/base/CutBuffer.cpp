@@ -0,0 +1,137 @@
+//
+//     MINOTAUR -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2014 The MINOTAUR Team.
+//
+
+/**
+ * \file CutBuffer.cpp
+ * \brief Implement the methods of CutBuffer class.
+ * \author Ashutosh Mahajan, Argonne National Laboratory
+ */
+
+#include <cmath>
+#include <iostream>
+#include <sys/time.h>
+
+#include "MinotaurConfig.h"
+#include "Cut.h"
+#include "CutBuffer.h"
+#include "Problem.h"
+#include "Solution.h"
+
+using namespace Minotaur;
+
+const std::string CutBuffer::me_ = "CutBuffer: ";
+
+
+CutBuffer::CutBuffer()
+  : startTime_(0.0),
+    time_(0.0),
+    violAbs_(1e-6)
+{
+}
+
+
+CutBuffer::~CutBuffer()
+{
+  cuts_.clear();
+}
+
+
+void CutBuffer::addCut(CutPtr c)
+{
+  cuts_.push_back(c);
+}
+
+
+ConstraintPtr CutBuffer::addCut(ProblemPtr p, FunctionPtr f, double lb,
+                                double ub, bool, bool never_del)
+{
+  CutPtr c = (CutPtr) new Cut(p->getNumVars(), f, lb, ub, never_del, false);
+  cuts_.push_back(c);
+  return ConstraintPtr(); // NULL
+}
+
+
+void CutBuffer::addCuts(CutVectorIter cbeg, CutVectorIter cend)
+{
+  cuts_.insert(cuts_.end(), cbeg, cend);
+}
+
+
+void CutBuffer::clear()
+{
+  cuts_.clear();
+  startTime_ = 0.0;
+  time_ = 0.0;
+}
+
+
+double CutBuffer::getWallTime()
+{
+  struct timeval tv;
+  if (gettimeofday(&tv, NULL)) {
+    return 0.0;
+  }
+  return (double) tv.tv_sec + (double) tv.tv_usec * 1e-6;
+}
+
+
+void CutBuffer::separate(ProblemPtr, ConstSolutionPtr sol, bool *separated,
+                         UInt *n_added)
+{
+  const double *x = sol->getPrimal();
+  double act;
+  int err;
+
+  *n_added = 0;
+  for (CutVectorIter it=cuts_.begin(); it!=cuts_.end(); ++it) {
+    err = 0;
+    act = (*it)->eval(x, &err);
+    if (0==err && (act > (*it)->getUb()+violAbs_ ||
+                   act < (*it)->getLb()-violAbs_)) {
+      ++(*n_added);
+    }
+  }
+  *separated = (*n_added > 0);
+}
+
+
+void CutBuffer::start()
+{
+  startTime_ = getWallTime();
+}
+
+
+void CutBuffer::stop()
+{
+  time_ = getWallTime() - startTime_;
+}
+
+
+void CutBuffer::write(std::ostream &out) const
+{
+  for (CutVector::const_iterator it=cuts_.begin(); it!=cuts_.end(); ++it) {
+    (*it)->write(out);
+  }
+}
+
+
+void CutBuffer::writeStats(std::ostream &out) const
+{
+  out << me_ << "cuts stored = " << cuts_.size() << std::endl
+      << me_ << "time        = " << time_ << std::endl;
+}
+
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
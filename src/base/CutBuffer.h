@@ -0,0 +1,136 @@
+//
+//     MINOTAUR -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2014 The MINOTAUR Team.
+//
+
+/**
+ * \file CutBuffer.h
+ * \brief Declare the CutBuffer class that collects cuts generated by one
+ * separator without touching the relaxation.
+ * \author Ashutosh Mahajan, Argonne National Laboratory
+ */
+
+#ifndef MINOTAURCUTBUFFER_H
+#define MINOTAURCUTBUFFER_H
+
+#include "CutManager.h"
+
+namespace Minotaur {
+
+  /**
+   * \brief A CutManager that only stores the cuts sent to it.
+   *
+   * CutBuffer is handed to a Handler when its separate() routine is called
+   * concurrently with other handlers. None of the cuts are added to the
+   * relaxation. Once all separators are done, the caller walks through the
+   * buffers (in a fixed order, so that results do not depend on thread
+   * scheduling), removes duplicates and adds the remaining cuts to the
+   * relaxation or to the real cut manager.
+   */
+  class CutBuffer : public CutManager {
+
+  public:
+    /// Default constructor.
+    CutBuffer();
+
+    /// Destroy.
+    ~CutBuffer();
+
+    // base class method.
+    void addCut(CutPtr c);
+
+    /**
+     * \brief Store a cut. Nothing is added to the problem.
+     *
+     * \return NULL because no constraint is created.
+     */
+    ConstraintPtr addCut(ProblemPtr p, FunctionPtr f, double lb, double ub,
+                         bool direct_to_rel, bool never_del);
+
+    // base class method.
+    void addCuts(CutVectorIter cbeg, CutVectorIter cend);
+
+    /// Remove all stored cuts and reset the clock.
+    void clear();
+
+    /// Iterator to the first stored cut.
+    CutVectorIter cutsBegin() { return cuts_.begin(); }
+
+    /// Iterator to the end of stored cuts.
+    CutVectorIter cutsEnd() { return cuts_.end(); }
+
+    // base class method.
+    UInt getNumCuts() const { return cuts_.size(); }
+
+    // base class method. Stored cuts are never enabled.
+    UInt getNumEnabledCuts() const { return 0; }
+
+    // base class method.
+    UInt getNumDisabledCuts() const { return cuts_.size(); }
+
+    // base class method.
+    UInt getNumNewCuts() const { return cuts_.size(); }
+
+    /// Wall-clock time (seconds) spent between the last clear() and stop().
+    double getTime() const { return time_; }
+
+    // base class method. Does nothing.
+    void postSolveUpdate(ConstSolutionPtr, EngineStatus) {};
+
+    /**
+     * \brief Count the stored cuts that are violated by sol.
+     *
+     * The problem is not modified. n_added is the number of stored cuts
+     * that will be added later if they survive duplicate removal.
+     */
+    void separate(ProblemPtr p, ConstSolutionPtr sol, bool *separated,
+                  UInt *n_added);
+
+    /// Start the wall clock for this separator.
+    void start();
+
+    /// Stop the wall clock and save the elapsed time.
+    void stop();
+
+    // base class method.
+    void write(std::ostream &out) const;
+
+    // base class method.
+    void writeStats(std::ostream &out) const;
+
+    /// Get the current wall-clock time in seconds.
+    static double getWallTime();
+
+  private:
+    /// Cuts received since the last call to clear().
+    CutVector cuts_;
+
+    /// Wall-clock time at the last call to start().
+    double startTime_;
+
+    /// Time between the last start() and stop().
+    double time_;
+
+    /// Absolute violation tolerance used in separate().
+    double violAbs_;
+
+    /// For logging.
+    static const std::string me_;
+  };
+
+  typedef boost::shared_ptr<CutBuffer> CutBufferPtr;
+  typedef std::vector<CutBufferPtr> CutBufferVector;
+}
+#endif
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
@@ -133,6 +133,13 @@ void CutMan1::postSolveUpdate(ConstSolutionPtr sol, EngineStatus)
 }
 
 
+void CutMan1::resetRel()
+{
+  enCuts_.clear();
+  pool_.clear();
+}
+
+
 void CutMan1::separate(ProblemPtr p, ConstSolutionPtr sol, bool *, UInt *)
 {
   UInt n = p->getNumVars();
@@ -65,6 +65,9 @@ public:
   // Base class method.
   void postSolveUpdate(ConstSolutionPtr sol, EngineStatus eng_status);
 
+  // Base class method.
+  void resetRel();
+
   // Base class method.
   void separate(ProblemPtr p, ConstSolutionPtr sol, bool *separated,
                 UInt *n_added);
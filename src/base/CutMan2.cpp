@@ -12,6 +12,7 @@
 
 #include <cmath>
 #include <iostream>
+#include <set>
 
 #include "MinotaurConfig.h"
 #include "Cut.h"
@@ -23,6 +24,7 @@
 #include "LinearFunction.h"
 #include "Logger.h"
 #include "Node.h"
+#include "Option.h"
 #include "Problem.h"
 #include "ProblemSize.h"
 #include "Relaxation.h"
@@ -39,15 +41,18 @@ typedef std::vector<ConstraintPtr>::const_iterator ConstIter;
 
 CutMan2::CutMan2()
   : env_(EnvPtr()),   // NULL
-    hashVec_(0),
     p_(ProblemPtr()),  // NULL
     absTol_(5e-2),
     MaxInactiveInRel_(10000),
+    delBatch_(6),
+    maxCos_(1.0),
     PoolSize_(200),
     CtThrsh_(0),
+    timer_(0),
     ctMngrtime_(0),
     PrntCntThrsh_(0),
-    numCuts_(0)
+    numCuts_(0),
+    slackTol_(1e-6)
 {
   stats_ = new CutStat();
   logger_ = (LoggerPtr) new Logger(LogDebug2);
@@ -56,6 +61,8 @@ CutMan2::CutMan2()
   stats_->numPoolToRel = 0;
   stats_->numRelToPool = 0 ;
   stats_->numCuts= 0;
+  stats_->numDupCuts = 0;
+  allCuts_ = (CutPoolPtr) new CutPool();
 
   ctmngrInfo_.t = ctMngrtime_;
   ctmngrInfo_.RelTr = MaxInactiveInRel_;
@@ -68,19 +75,26 @@ CutMan2::CutMan2(EnvPtr env, ProblemPtr p)
     p_(ProblemPtr()),
     absTol_(5e-2),
     MaxInactiveInRel_(100),
+    delBatch_(6),
+    maxCos_(1.0),
     PoolSize_(70),
     ctMngrtime_(0),
-    PrntCntThrsh_(0)
+    PrntCntThrsh_(0),
+    numCuts_(0),
+    slackTol_(1e-6)
 {
+  int del_batch;
+
   stats_ = new CutStat();
   timer_ = env_->getNewTimer();
+  MaxInactiveInRel_ = env_->getOptions()->findInt("cut_age_limit")->
+    getValue();
+  del_batch = env_->getOptions()->findInt("cut_del_batch")->getValue();
+  delBatch_ = (del_batch < 1) ? 1 : (UInt) del_batch;
   UInt n = p->getNumVars();
-  hashVec_ = new double[n];
   CtThrsh_ = 6 * (n + p->getNumCons());
-
-  for (UInt i = 0; i < n; i++) {
-    hashVec_[i] = rand()/double (RAND_MAX);
-  }
+  maxCos_ = env_->getOptions()->findDouble("cut_max_cos")->getValue();
+  allCuts_ = (CutPoolPtr) new CutPool();
 
   updateTime_ = 0.0;
   checkTime_ = 0.0;
@@ -95,7 +109,9 @@ CutMan2::CutMan2(EnvPtr env, ProblemPtr p)
   stats_->PoolSize = 0;
   stats_->RelSize = 0;
   stats_->numCuts= 0;
+  stats_->numDupCuts = 0;
   ctmngrInfo_.t = ctMngrtime_;
+  ctmngrInfo_.RelTr = MaxInactiveInRel_;
   ctmngrInfo_.PoolTr = PoolSize_;
   ctmngrInfo_.PrntActCnt = PrntCntThrsh_;
 }
@@ -106,41 +122,61 @@ CutMan2::~CutMan2()
     writeStat();
     delete stats_;
   }
-  if (hashVec_) {
-    delete[] hashVec_;
-  }
   env_.reset();
+  allCuts_.reset();
   pool_.clear();
   rel_.clear();
   p_.reset();
   delete timer_;
 }
 
+void CutMan2::resetRel()
+{
+  rel_.clear();
+  pool_.clear();
+  NodeCutsMap_.clear();
+  ChildNum_.clear();
+  allCuts_->clear();
+  numCuts_ = 0;
+}
+
+
 void CutMan2::updateRel(ConstSolutionPtr sol, ProblemPtr rel)
 {
   if ( numCuts_ >= CtThrsh_){
     timer_->start();
-    UInt m = rel->getNumCons();
-    const double *y = new double[m];
-    y = sol->getDualOfCons();
-    int i;
+    const double *x = sol->getPrimal();
+    const double *y = sol->getDualOfCons();
+    double act, slack;
+    int err;
+    UInt i;
     CutPtr cut;
+    CutInfo *info;
     cutList temp;
 
+    if (!y) {
+      timer_->stop();
+      return;
+    }
     for (std::list<CutPtr>::iterator it = rel_.begin(); it != rel_.end();)
     {
       cut = *it;
-      i =cut->getConstraint()->getId();
-      if (y[i] > 1e-6 || y[i] < -1e-6)
-      {
-        ++(cut->getInfo()->cntSinceActive);
-        cut->getInfo()->cntSinceActive = 0;
+      info = cut->getInfo();
+      // duals are stored by position of the constraint, not by its id.
+      i = cut->getConstraint()->getIndex();
+      err = 0;
+      act = cut->eval(x, &err);
+      slack = std::min(cut->getUb()-act, act-cut->getLb());
+      if (y[i] > 1e-6 || y[i] < -1e-6 || 0 != err ||
+          slack <= slackTol_*(1.0+fabs(act))) {
+        info->cntSinceActive = 0;
       } else {
-        ++(cut->getInfo()->cntSinceActive);
+        ++(info->cntSinceActive);
       } 
 
-      if ( (y[i] > -1e-6 && y[i] < 1e-6) && cut->getInfo()->parent_active_cnts <=PrntCntThrsh_ &&  
-	   cut->getInfo()->cntSinceActive > MaxInactiveInRel_) 
+      if (false == info->neverDelete &&
+          info->parent_active_cnts <= PrntCntThrsh_ &&
+          info->cntSinceActive > MaxInactiveInRel_) 
       {
         temp.push_back(cut);
         it = rel_.erase(it);
@@ -160,7 +196,8 @@ void CutMan2::updateRel(ConstSolutionPtr sol, ProblemPtr rel)
       }
       ctmngrInfo_.RelTr = MaxInactiveInRel_;
     }
-    if (temp.size() > 5){
+    if (temp.size() >= delBatch_){
+      // all aged cuts leave the engine in one call to removeCons.
       for (std::list<CutPtr>::iterator it = temp.begin(); 
   	   it != temp.end();++it){
 	cut = *it;
@@ -171,7 +208,7 @@ void CutMan2::updateRel(ConstSolutionPtr sol, ProblemPtr rel)
       }
       rel->delMarkedCons();
     } else {
-	rel_.merge(temp);        
+      rel_.splice(rel_.end(), temp);
     }
     double a1 = timer_->query();
     ctMngrtime_ += a1;
@@ -185,29 +222,55 @@ void CutMan2::updatePool(ProblemPtr rel, ConstSolutionPtr sol)
   if ( numCuts_ >= CtThrsh_){
     timer_->start();
     const double *x = sol->getPrimal();
+    DoubleVector obj, act, eff, objpar;
+    UIntVector rows;
+    std::set<Cut *> sel;
     double viol;
-    double score;
-    int toRel = 0;
-    int deleted = 0;
+    int err;
     CutPtr cut;
+
+    // score all linear cuts in one pass. Cuts already in the relaxation are
+    // not candidates.
+    allCuts_->evalScores(x, obj, act, eff, objpar);
+    for (UInt r=0; r<eff.size(); ++r) {
+      cut = allCuts_->getCut(r);
+      if (!cut) {
+        continue;
+      }
+      if (true == cut->getInfo()->inRel) {
+        eff[r] = 0.0;
+      } else if (eff[r] < 1e-6) {
+        ++(cut->getInfo()->cntSinceViol);
+      }
+    }
+    allCuts_->selectCuts(eff, objpar, absTol_, 0.0, maxCos_, 0, rows);
+    for (UIntVector::iterator it=rows.begin(); it!=rows.end(); ++it) {
+      sel.insert(allCuts_->getCut(*it).get());
+    }
+
     for (std::list<CutPtr>::iterator it = pool_.begin(); it != pool_.end();)
     {
       cut = *it;
-      cut->evalScore(x, &viol, &score);
-
-      if (score < 1e-6){
-        ++(cut->getInfo()->cntSinceViol);
+      if (cut->getFunction()->getType() != Linear) {
+        // not in allCuts_, check the violation directly.
+        err = 0;
+        viol = cut->eval(x, &err);
+        viol = std::max(cut->getLb()-viol, viol-cut->getUb());
+        if (0 != err || viol < absTol_) {
+          if (0 == err && viol < 1e-6) {
+            ++(cut->getInfo()->cntSinceViol);
+          }
+          ++it;
+          continue;
+        }
+      } else if (sel.find(cut.get()) == sel.end()) {
         ++it;
-      }else if (score < absTol_){ 
-	++it;
-      } else {    
-	addToRel_(rel,cut,false);
-	toRel++;
-        stats_->numPoolToRel++;
-  	it = pool_.erase(it);
-      } 
+        continue;
+      }
+      addToRel_(rel,cut,false);
+      stats_->numPoolToRel++;
+      it = pool_.erase(it);
     }
-    stats_->numDeletedCuts += deleted;
     ctMngrtime_ += timer_->query();
     checkTime_ += timer_->query();
     timer_->stop(); 
@@ -216,11 +279,28 @@ void CutMan2::updatePool(ProblemPtr rel, ConstSolutionPtr sol)
 
 ConstraintPtr CutMan2::addCut(ProblemPtr rel,FunctionPtr fn, double lb, double ub, bool, bool neverDelete)
 {
-  CutPtr cut = (CutPtr) new Cut(rel,fn, lb, ub,neverDelete,false);
+  CutPtr cut = (CutPtr) new Cut(rel->getNumVars(), fn, lb, ub, neverDelete,
+                                false);
+  CutPtr dup = allCuts_->findDup(cut);
+
+  if (dup) {
+    ++(stats_->numDupCuts);
+    if (false == dup->getInfo()->inRel) {
+      // the stored cut is as good, but it is not in the relaxation.
+      pool_.remove(dup);
+      addToRel_(rel, dup, false);
+      stats_->numPoolToRel++;
+      return dup->getConstraint();
+    }
+    return ConstraintPtr(); // NULL
+  }
+  cut->applyToProblem(rel);
+  allCuts_->addCut(cut);
   addToRel_(rel,cut,true);
   stats_->numAddedCuts++;
   cut->getInfo()->inRel = true;
   stats_->numCuts++;
+  ++numCuts_;
   return cut->getConstraint();
 }
 
@@ -267,7 +347,9 @@ void CutMan2::addToPool_(CutPtr cut)
 */
   if (pool_.size() > PoolSize_ - 1){
     std::list<CutPtr>::iterator it = pool_.begin();
+    allCuts_->removeCut(*it);
     it = pool_.erase(it);
+    ++(stats_->numDeletedCuts);
   }
 
   pool_.push_back(cut);
@@ -353,6 +435,7 @@ void CutMan2::addCuts(CutVectorIter cbeg,CutVectorIter cend)
 
 void CutMan2::addCut(CutPtr c)
 {
+  allCuts_->addCut(c);
   addToRel_(c);
 }
 
@@ -365,6 +448,7 @@ void CutMan2::writeStat()
   std::cout
     << "CutManager: number of cuts added........................ = " << stats_->numAddedCuts << std::endl
     << "CutManager: number of cuts deleted...................... = " << stats_->numDeletedCuts << std::endl
+    << "CutManager: number of duplicate cuts rejected........... = " << stats_->numDupCuts << std::endl
     << "CutManager: number of cuts moved from relaxation to pool = " << stats_->numRelToPool << std::endl
     << "CutManager: number of cuts moved from pool to relaxation = " << stats_->numPoolToRel << std::endl
     << "CutManager: number of calls............................. = " << stats_->callNums << std::endl
@@ -16,6 +16,7 @@
 #include <list>
 #include <map>
 #include "CutManager.h"
+#include "CutPool.h"
 
 namespace Minotaur {
 
@@ -30,6 +31,13 @@ namespace Minotaur {
   /**
    * The CutManager class is meant to manage the cutting planes generated by
    * different cut generators and handlers. 
+   *
+   * A cut in the relaxation ages by one every time the relaxation is solved
+   * and the cut has neither a nonzero dual nor a small slack. Cuts older
+   * than a limit are moved to the pool and removed from the relaxation (and
+   * its engine) together, once enough of them have aged. Cuts in the pool
+   * that become violated are added back to the relaxation. This keeps the
+   * size of the LP from growing with the number of cuts generated.
    */
 
   struct CutStat {
@@ -41,6 +49,7 @@ namespace Minotaur {
     int PoolSize;
     int RelSize;
     int numCuts;
+    int numDupCuts;
   };
 
   class CutMan2 : public CutManager {
@@ -82,6 +91,9 @@ namespace Minotaur {
     // base class method
     void postSolveUpdate(ConstSolutionPtr , EngineStatus ) {};
 
+    // base class method
+    void resetRel();
+
     // base class method
     void separate(ProblemPtr, ConstSolutionPtr, bool*, UInt*) {};
 
@@ -130,8 +142,11 @@ namespace Minotaur {
     /// Environment.
     EnvPtr env_;
 
-    /// Random vector to check for duplicacy.
-    double* hashVec_;
+    /**
+     * All linear cuts in the relaxation or in the pool. Used for rejecting
+     * new cuts that are duplicates of (or parallel to) existing ones.
+     */
+    CutPoolPtr allCuts_;
 
     /// For logging.
     LoggerPtr logger_;
@@ -160,6 +175,15 @@ namespace Minotaur {
      */
     UInt MaxInactiveInRel_;
 
+    /// Minimum number of aged cuts that are removed together.
+    UInt delBatch_;
+
+    /**
+     * Pool cuts whose cosine with a cut already picked for the relaxation
+     * is at least this value are left in the pool.
+     */
+    double maxCos_;
+
     /// Maximum pool size
     UInt PoolSize_;
 
@@ -190,8 +214,15 @@ namespace Minotaur {
     /// Maximum number of active children for a node to removing its active cuts
     int PrntCntThrsh_;
 
+    /// Number of cuts added by addCut(). Cuts are aged only after
+    /// CtThrsh_ cuts have been added.
     UInt numCuts_;
 
+    /**
+     * A cut whose slack is at most this value (scaled by 1 + |rhs|) is
+     * treated as active even if its dual is zero.
+     */
+    double slackTol_;
 
 };
   typedef boost::shared_ptr <CutMan2> CutMan2Ptr;
@@ -125,6 +125,15 @@ public:
    */
   virtual void postSolveUpdate(ConstSolutionPtr sol, EngineStatus e_status) = 0;
 
+  /**
+   * \brief Forget the cuts added to the relaxation.
+   *
+   * Called when the relaxation is created again, e.g. when the root is
+   * restarted. The cuts refer to the constraints and variables of the old
+   * relaxation, so they are all dropped.
+   */
+  virtual void resetRel() { };
+
   /**
    * \brief Separate a given point using the cuts in the storage.
    * \param[in] sol Solution that needs to be separated.
@@ -0,0 +1,526 @@
+//
+//     MINOTAUR -- It's only 1/2 bull
+//
+//     (C)opyright 2010 - 2014 The MINOTAUR Team.
+//
+
+/**
+ * \file CutPool.cpp
+ * \brief Implement the methods of CutPool class.
+ * \author Ashutosh Mahajan, Argonne National Laboratory
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#include "MinotaurConfig.h"
+#include "Cut.h"
+#include "CutPool.h"
+#include "Function.h"
+#include "LinearFunction.h"
+#include "Variable.h"
+
+using namespace Minotaur;
+
+const std::string CutPool::me_ = "CutPool: ";
+
+
+CutPool::CutPool()
+  : buckets_(1024),
+    numDead_(0),
+    numDup_(0),
+    quant_(1e8)
+{
+  rowStart_.push_back(0);
+}
+
+
+CutPool::~CutPool()
+{
+  clear();
+}
+
+
+void CutPool::add_(const UIntVector &ind, const DoubleVector &val,
+                   double lb, double ub, CutPtr cut)
+{
+  UInt r = lb_.size();
+  double nrm = 0.0;
+
+  for (UInt k=0; k<val.size(); ++k) {
+    nrm += val[k]*val[k];
+  }
+  nrm = sqrt(nrm);
+
+  colInd_.insert(colInd_.end(), ind.begin(), ind.end());
+  coef_.insert(coef_.end(), val.begin(), val.end());
+  rowStart_.push_back(colInd_.size());
+  lb_.push_back(lb);
+  ub_.push_back(ub);
+  norm_.push_back(nrm);
+  cuts_.push_back(cut);
+  dead_.push_back(false);
+  sig_.push_back(signature_(ind, val, nrm));
+
+  if (lb_.size() > 2*buckets_.size()) {
+    buckets_.resize(2*buckets_.size());
+    rehash_();
+  } else {
+    buckets_[sig_[r] & (buckets_.size()-1)].push_back(r);
+  }
+}
+
+
+bool CutPool::addCut(CutPtr cut)
+{
+  UIntVector ind;
+  DoubleVector val;
+
+  if (false == getRow_(cut, ind, val)) {
+    return false;
+  }
+  add_(ind, val, cut->getLb(), cut->getUb(), cut);
+  return true;
+}
+
+
+void CutPool::addRow(const UIntVector &ind, const DoubleVector &val,
+                     double lb, double ub)
+{
+  UIntVector ind2(ind);
+  DoubleVector val2(val);
+
+  sortRow_(ind2, val2);
+  add_(ind2, val2, lb, ub, CutPtr());
+}
+
+
+void CutPool::clear()
+{
+  buckets_.assign(1024, UIntVector());
+  coef_.clear();
+  colInd_.clear();
+  cuts_.clear();
+  dead_.clear();
+  lb_.clear();
+  norm_.clear();
+  numDead_ = 0;
+  rowStart_.assign(1, 0);
+  sig_.clear();
+  ub_.clear();
+}
+
+
+void CutPool::compact_()
+{
+  UInt nr = 0;
+  UInt nz = 0;
+
+  for (UInt r=0; r<lb_.size(); ++r) {
+    if (true == dead_[r]) {
+      continue;
+    }
+    for (UInt k=rowStart_[r]; k<rowStart_[r+1]; ++k, ++nz) {
+      colInd_[nz] = colInd_[k];
+      coef_[nz] = coef_[k];
+    }
+    rowStart_[nr+1] = nz;
+    lb_[nr] = lb_[r];
+    ub_[nr] = ub_[r];
+    norm_[nr] = norm_[r];
+    cuts_[nr] = cuts_[r];
+    sig_[nr] = sig_[r];
+    ++nr;
+  }
+  colInd_.resize(nz);
+  coef_.resize(nz);
+  rowStart_.resize(nr+1);
+  lb_.resize(nr);
+  ub_.resize(nr);
+  norm_.resize(nr);
+  cuts_.resize(nr);
+  sig_.resize(nr);
+  dead_.assign(nr, false);
+  numDead_ = 0;
+
+  rehash_();
+}
+
+
+double CutPool::dot_(UInt r1, UInt r2) const
+{
+  UInt j1 = rowStart_[r1];
+  UInt j2 = rowStart_[r2];
+  double d = 0.0;
+
+  // both rows are sorted by index.
+  while (j1<rowStart_[r1+1] && j2<rowStart_[r2+1]) {
+    if (colInd_[j1] == colInd_[j2]) {
+      d += coef_[j1]*coef_[j2];
+      ++j1;
+      ++j2;
+    } else if (colInd_[j1] < colInd_[j2]) {
+      ++j1;
+    } else {
+      ++j2;
+    }
+  }
+  return d;
+}
+
+
+void CutPool::evalActivity(const double *x, DoubleVector &act) const
+{
+  UInt nr = lb_.size();
+  double s;
+
+  act.assign(nr, 0.0);
+  for (UInt r=0; r<nr; ++r) {
+    if (true == dead_[r]) {
+      continue;
+    }
+    s = 0.0;
+    for (UInt k=rowStart_[r]; k<rowStart_[r+1]; ++k) {
+      s += coef_[k]*x[colInd_[k]];
+    }
+    act[r] = s;
+  }
+}
+
+
+void CutPool::evalViolation(const double *x, DoubleVector &viol) const
+{
+  evalActivity(x, viol);
+  for (UInt r=0; r<viol.size(); ++r) {
+    if (true == dead_[r]) {
+      continue;
+    }
+    if (viol[r] > ub_[r]) {
+      viol[r] -= ub_[r];
+    } else if (viol[r] < lb_[r]) {
+      viol[r] = lb_[r] - viol[r];
+    } else {
+      viol[r] = 0.0;
+    }
+  }
+}
+
+
+void CutPool::evalScores(const double *x, const DoubleVector &obj,
+                         DoubleVector &act, DoubleVector &eff,
+                         DoubleVector &objpar) const
+{
+  UInt nr = lb_.size();
+  UInt nobj = obj.size();
+  double onrm = 0.0;
+  double s, d, v;
+  UInt j;
+
+  for (j=0; j<nobj; ++j) {
+    onrm += obj[j]*obj[j];
+  }
+  onrm = sqrt(onrm);
+
+  act.assign(nr, 0.0);
+  eff.assign(nr, 0.0);
+  objpar.assign(nr, 0.0);
+  for (UInt r=0; r<nr; ++r) {
+    if (true == dead_[r] || norm_[r] <= 0.0) {
+      continue;
+    }
+    s = 0.0;
+    d = 0.0;
+    for (UInt k=rowStart_[r]; k<rowStart_[r+1]; ++k) {
+      j = colInd_[k];
+      s += coef_[k]*x[j];
+      if (j < nobj) {
+        d += coef_[k]*obj[j];
+      }
+    }
+    act[r] = s;
+    if (s > ub_[r]) {
+      v = s - ub_[r];
+    } else if (s < lb_[r]) {
+      v = lb_[r] - s;
+    } else {
+      v = 0.0;
+    }
+    eff[r] = v/norm_[r];
+    if (onrm > 0.0) {
+      objpar[r] = fabs(d)/(norm_[r]*onrm);
+    }
+  }
+}
+
+
+CutPtr CutPool::findDup(CutPtr cut) const
+{
+  UIntVector ind;
+  DoubleVector val;
+  int r;
+
+  if (false == getRow_(cut, ind, val)) {
+    return CutPtr(); // NULL
+  }
+  r = findDup(ind, val, cut->getLb(), cut->getUb());
+  if (r < 0) {
+    return CutPtr(); // NULL
+  }
+  return cuts_[r];
+}
+
+
+int CutPool::findDup(const UIntVector &ind, const DoubleVector &val,
+                     double lb, double ub) const
+{
+  UIntVector ind2(ind);
+  DoubleVector val2(val);
+  double nrm = 0.0;
+  double lbn, ubn;
+  size_t sig;
+  bool same;
+  UInt k;
+
+  sortRow_(ind2, val2);
+  for (k=0; k<val2.size(); ++k) {
+    nrm += val2[k]*val2[k];
+  }
+  if (nrm <= 0.0) {
+    return -1;
+  }
+  nrm = sqrt(nrm);
+  lbn = (lb > -INFINITY) ? lb/nrm : -INFINITY;
+  ubn = (ub < INFINITY) ? ub/nrm : INFINITY;
+
+  // rows with the same signature.
+  sig = signature_(ind2, val2, nrm);
+  const UIntVector &bucket = buckets_[sig & (buckets_.size()-1)];
+  for (UIntVector::const_iterator it=bucket.begin(); it!=bucket.end();
+       ++it) {
+    UInt r = *it;
+    if (dead_[r] || sig_[r] != sig ||
+        rowStart_[r+1]-rowStart_[r] != ind2.size()) {
+      continue;
+    }
+    same = true;
+    for (k=0; k<ind2.size(); ++k) {
+      UInt j = rowStart_[r]+k;
+      if (colInd_[j] != ind2[k] ||
+          fabs(coef_[j]/norm_[r] - val2[k]/nrm) > 1.0/quant_) {
+        same = false;
+        break;
+      }
+    }
+    if (same && isTighter_(r, lbn, ubn)) {
+      ++numDup_;
+      return r;
+    }
+  }
+
+  return -1;
+}
+
+
+bool CutPool::getRow_(CutPtr cut, UIntVector &ind, DoubleVector &val) const
+{
+  FunctionPtr f = cut->getFunction();
+  LinearFunctionPtr lf;
+
+  if (!f || f->getType() != Linear) {
+    return false;
+  }
+  lf = f->getLinearFunction();
+  if (!lf) {
+    return false;
+  }
+  ind.reserve(lf->getNumTerms());
+  val.reserve(lf->getNumTerms());
+  for (VariableGroupConstIterator it=lf->termsBegin(); it!=lf->termsEnd();
+       ++it) {
+    if (it->second != 0.0) {
+      ind.push_back(it->first->getIndex());
+      val.push_back(it->second);
+    }
+  }
+  sortRow_(ind, val);
+  return true;
+}
+
+
+bool CutPool::isTighter_(UInt r, double lbn, double ubn) const
+{
+  double tol = 1.0/quant_;
+  if (ubn < INFINITY &&
+      (ub_[r] >= INFINITY || ub_[r]/norm_[r] > ubn + tol)) {
+    return false;
+  }
+  if (lbn > -INFINITY &&
+      (lb_[r] <= -INFINITY || lb_[r]/norm_[r] < lbn - tol)) {
+    return false;
+  }
+  return true;
+}
+
+
+void CutPool::rehash_()
+{
+  UInt mask = buckets_.size()-1;
+  for (std::vector<UIntVector>::iterator it=buckets_.begin();
+       it!=buckets_.end(); ++it) {
+    it->clear();
+  }
+  for (UInt r=0; r<lb_.size(); ++r) {
+    if (false == dead_[r]) {
+      buckets_[sig_[r] & mask].push_back(r);
+    }
+  }
+}
+
+
+bool CutPool::removeCut(CutPtr cut)
+{
+  UIntVector ind;
+  DoubleVector val;
+  double nrm = 0.0;
+  size_t sig;
+
+  if (false == getRow_(cut, ind, val)) {
+    return false;
+  }
+  for (UInt k=0; k<val.size(); ++k) {
+    nrm += val[k]*val[k];
+  }
+  sig = signature_(ind, val, sqrt(nrm));
+  UIntVector &bucket = buckets_[sig & (buckets_.size()-1)];
+  for (UIntVector::iterator it=bucket.begin(); it!=bucket.end(); ++it) {
+    if (cuts_[*it] == cut) {
+      dead_[*it] = true;
+      cuts_[*it].reset();
+      ++numDead_;
+      bucket.erase(it);
+      if (numDead_ > 64 && 2*numDead_ > lb_.size()) {
+        compact_();
+      }
+      return true;
+    }
+  }
+  return false;
+}
+
+
+size_t CutPool::signature_(const UIntVector &ind, const DoubleVector &val,
+                           double nrm) const
+{
+  size_t h = ind.size();
+  long q;
+
+  if (nrm <= 0.0) {
+    return h;
+  }
+  for (UInt k=0; k<ind.size(); ++k) {
+    q = (long) floor(val[k]/nrm*quant_ + 0.5);
+    h = h*1000003 ^ (size_t) ind[k];
+    h = h*1000003 ^ (size_t) q;
+  }
+  return h;
+}
+
+
+void CutPool::sortRow_(UIntVector &ind, DoubleVector &val) const
+{
+  std::vector<std::pair<UInt, double> > terms;
+  bool sorted = true;
+
+  for (UInt k=1; k<ind.size(); ++k) {
+    if (ind[k-1] > ind[k]) {
+      sorted = false;
+      break;
+    }
+  }
+  if (true == sorted) {
+    return;
+  }
+  terms.reserve(ind.size());
+  for (UInt k=0; k<ind.size(); ++k) {
+    terms.push_back(std::make_pair(ind[k], val[k]));
+  }
+  std::sort(terms.begin(), terms.end());
+  for (UInt k=0; k<ind.size(); ++k) {
+    ind[k] = terms[k].first;
+    val[k] = terms[k].second;
+  }
+}
+
+
+void CutPool::selectCuts(const DoubleVector &eff,
+                         const DoubleVector &objpar, double min_eff,
+                         double obj_wt, double max_cos, UInt k,
+                         UIntVector &rows) const
+{
+  std::vector<std::pair<double, UInt> > cands;
+  bool ok;
+
+  rows.clear();
+  for (UInt r=0; r<eff.size(); ++r) {
+    if (false == dead_[r] && eff[r] > min_eff) {
+      cands.push_back(std::make_pair(-(eff[r] + obj_wt*objpar[r]), r));
+    }
+  }
+  // ascending order of negative scores puts the best row first.
+  std::sort(cands.begin(), cands.end());
+
+  for (UInt i=0; i<cands.size(); ++i) {
+    UInt r = cands[i].second;
+    if (k > 0 && rows.size() >= k) {
+      break;
+    }
+    ok = true;
+    if (max_cos < 1.0) {
+      for (UIntVector::const_iterator it=rows.begin(); it!=rows.end();
+           ++it) {
+        if (fabs(dot_(r, *it)) >= max_cos*norm_[r]*norm_[*it]) {
+          ok = false;
+          break;
+        }
+      }
+    }
+    if (true == ok) {
+      rows.push_back(r);
+    }
+  }
+}
+
+
+void CutPool::write(std::ostream &out) const
+{
+  for (UInt r=0; r<lb_.size(); ++r) {
+    if (true == dead_[r]) {
+      continue;
+    }
+    out << lb_[r] << " <= ";
+    for (UInt k=rowStart_[r]; k<rowStart_[r+1]; ++k) {
+      out << coef_[k] << "*x" << colInd_[k] << " ";
+    }
+    out << "<= " << ub_[r] << std::endl;
+  }
+}
+
+
+void CutPool::writeStats(std::ostream &out) const
+{
+  out << me_ << "cuts in pool          = " << getNumCuts() << std::endl
+      << me_ << "redundant cuts found  = " << numDup_ << std::endl;
+}
+
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
@@ -6,7 +6,8 @@
 
 /**
  * \file CutPool.h
- * \brief Declare class CutPool for storing cuts.
+ * \brief Declare class CutPool for storing linear cuts and finding
+ * duplicates quickly.
  * \author Ashutosh Mahajan, Argonne National Laboratory
  */
 
@@ -17,79 +18,250 @@
 
 namespace Minotaur {
 
-class Environment;
-class Cut;
-class Problem;
-class Solution;
+  /**
+   * \brief Store linear cuts row-wise, detect duplicate cuts and select
+   * nearly orthogonal ones.
+   *
+   * Each row \f$l \leq a^Tx \leq u\f$ is stored in arrays that are shared by
+   * all rows (compressed sparse rows), so that activities of all cuts at a
+   * point are computed in one pass. A row is also given a signature: the
+   * coefficients are scaled by \f$1/\|a\|\f$, rounded to a grid and hashed
+   * together with the variable indices. Rows with the same signature are
+   * kept in the same bucket of a hash table, so a duplicate is found without
+   * looking at other rows.
+   *
+   * A new row is reported as redundant if a stored row has the same
+   * direction and its bounds, after scaling, are at least as tight. Rows
+   * that are only nearly parallel are not redundant, since a point can
+   * satisfy one and violate the other. The angle between rows is used only
+   * when selecting cuts, see selectCuts().
+   *
+   * Scores used for selecting cuts (efficacy and parallelism with the
+   * objective) are also computed for all rows in one pass, see evalScores().
+   *
+   * Removed rows are only marked. The arrays are compacted when more than
+   * half of the rows are marked, which changes the positions of rows.
+   */
+  class CutPool {
 
-typedef boost::shared_ptr<Environment> EnvironmentPtr;
-typedef boost::shared_ptr<Cut> CutPtr;
-typedef boost::shared_ptr<Problem> ProblemPtr;
-typedef boost::shared_ptr<Solution> SolutionPtr;
+  public:
+    /// Default constructor.
+    CutPool();
 
-typedef std::vector<CutPtr> CutVector;
-typedef std::deque<CutPtr> CutQ;
+    /// Destroy.
+    ~CutPool();
 
-/**
- * The CutPool class is meant to store the cutting planes generated by
- * different cut generators and handlers. 
- */
-class CutPool {
+    /**
+     * \brief Add a linear cut to the pool.
+     *
+     * \return True if the cut was added. False if its function is not
+     * linear.
+     */
+    bool addCut(CutPtr cut);
+
+    /**
+     * \brief Add a row that does not belong to any Cut.
+     *
+     * \param[in] ind Indices of variables, need not be sorted.
+     * \param[in] val Coefficients of the variables in ind.
+     * \param[in] lb Lower bound of the row.
+     * \param[in] ub Upper bound of the row.
+     */
+    void addRow(const UIntVector &ind, const DoubleVector &val, double lb,
+                double ub);
+
+    /// Remove all rows.
+    void clear();
+
+    /**
+     * \brief Compute the activity of every row at x.
+     *
+     * \param[in] x The point. It must have a value for every variable that
+     * appears in the pool.
+     * \param[out] act Activity of each row, in the order of rows. Removed
+     * rows get 0.
+     */
+    void evalActivity(const double *x, DoubleVector &act) const;
+
+    /**
+     * \brief Compute the violation of every row at x.
+     *
+     * \param[in] x The point.
+     * \param[out] viol Violation of each row, 0 if it is satisfied or
+     * removed.
+     */
+    void evalViolation(const double *x, DoubleVector &viol) const;
+
+    /**
+     * \brief Compute the activity and scores of every row at x.
+     *
+     * The efficacy of a row is its violation divided by the two-norm of its
+     * coefficients, i.e., the distance of x from the hyperplane. The
+     * objective parallelism is \f$|a^Tc|/(\|a\|\|c\|)\f$, where c are the
+     * coefficients of the objective.
+     *
+     * \param[in] x The point.
+     * \param[in] obj Dense vector of objective coefficients. May be empty,
+     * in which case the objective parallelism is zero for all rows.
+     * \param[out] act Activity of each row.
+     * \param[out] eff Efficacy of each row, 0 if it is satisfied.
+     * \param[out] objpar Objective parallelism of each row.
+     */
+    void evalScores(const double *x, const DoubleVector &obj,
+                    DoubleVector &act, DoubleVector &eff,
+                    DoubleVector &objpar) const;
+
+    /// Return the cut that makes the given cut redundant. NULL if none.
+    CutPtr findDup(CutPtr cut) const;
+
+    /**
+     * \brief Find a row that makes the given row redundant.
+     *
+     * \return Position of the stored row, or -1 if there is none.
+     */
+    int findDup(const UIntVector &ind, const DoubleVector &val, double lb,
+                double ub) const;
+
+    /// Cut stored in a row. NULL if the row was added by addRow().
+    CutPtr getCut(UInt row) const { return cuts_[row]; }
+
+    /// Lower bound of a row.
+    double getLb(UInt row) const { return lb_[row]; }
+
+    /// Upper bound of a row.
+    double getUb(UInt row) const { return ub_[row]; }
+
+    /// Number of rows stored, including removed ones.
+    UInt getNumRows() const { return lb_.size(); }
+
+    /// Number of rows that have not been removed.
+    UInt getNumCuts() const { return lb_.size() - numDead_; }
+
+    /// Return true if the row has been removed.
+    bool isRemoved(UInt row) const { return dead_[row]; }
+
+    /**
+     * \brief Remove a cut from the pool.
+     *
+     * \return False if the cut is not in the pool.
+     */
+    bool removeCut(CutPtr cut);
+
+    /**
+     * \brief Select a set of good and nearly orthogonal rows.
+     *
+     * Rows whose efficacy exceeds min_eff are ranked by
+     * eff + obj_wt*objpar. They are then picked greedily in this order. A
+     * row is skipped if the cosine of its angle with a row already picked is
+     * at least max_cos.
+     *
+     * \param[in] eff Efficacy of each row, from evalScores().
+     * \param[in] objpar Objective parallelism of each row, from
+     * evalScores().
+     * \param[in] min_eff Rows with efficacy not more than this are ignored.
+     * \param[in] obj_wt Weight of the objective parallelism in the score.
+     * \param[in] max_cos Maximum cosine allowed between two picked rows. 1
+     * (or more) turns off the check.
+     * \param[in] k Maximum number of rows to pick. 0 means no limit.
+     * \param[out] rows Positions of the picked rows, best first.
+     */
+    void selectCuts(const DoubleVector &eff, const DoubleVector &objpar,
+                    double min_eff, double obj_wt, double max_cos, UInt k,
+                    UIntVector &rows) const;
+
+    /// Write all rows.
+    void write(std::ostream &out) const;
+
+    /// Write statistics.
+    void writeStats(std::ostream &out) const;
+
+  private:
+    /**
+     * Buckets of the hash table. Each bucket has positions of rows whose
+     * signature has the same lowest bits.
+     */
+    std::vector<UIntVector> buckets_;
+
+    /// Coefficients of all rows, row after row.
+    DoubleVector coef_;
+
+    /// Variable index of each entry of coef_. Sorted within a row.
+    UIntVector colInd_;
+
+    /// Cut of each row. NULL for rows added by addRow().
+    CutVector cuts_;
+
+    /// True for rows that have been removed.
+    BoolVector dead_;
+
+    /// Lower bound of each row.
+    DoubleVector lb_;
+
+    /// For logging.
+    static const std::string me_;
+
+    /// Two-norm of the coefficients of each row.
+    DoubleVector norm_;
+
+    /// Number of rows that have been removed but are still stored.
+    UInt numDead_;
 
-public:
-  /// Default constructor.
-  CutPool();
+    /// Number of times findDup() found a redundant row.
+    mutable UInt numDup_;
 
-  /// Constructor that loads the relaxation problem. 
-  CutManager(EnvPtr env);
+    /// Grid on which scaled coefficients are rounded for signatures.
+    double quant_;
 
-  /// Destroy.
-  ~CutManager();
+    /// Position in coef_ where each row starts. One more than the rows.
+    UIntVector rowStart_;
 
-  /// Add to pool.
-  void addCut(CutPtr cut);
+    /// Signature of each row.
+    std::vector<size_t> sig_;
 
-  /// Add to pool.
-  void addCuts(CutVector cuts);
+    /// Upper bound of each row.
+    DoubleVector ub_;
 
-  /// Find duplicate.
-  CutPtr findDup(CutPtr cut);
+    /// Store a row. ind and val must be sorted by index.
+    void add_(const UIntVector &ind, const DoubleVector &val, double lb,
+              double ub, CutPtr cut);
 
-  /// Remove a cut.
-  void removeCut(CutPtr cut);
+    /// Dot product of rows r1 and r2.
+    double dot_(UInt r1, UInt r2) const;
 
-  /// Remove a cut.
-  void removeCuts(CutVector cuts);
+    /// Remove marked rows and rebuild the hash table and column lists.
+    void compact_();
 
-  /// Write to output.
-  void write(std::ostream &out) const;
+    /// Get the terms of a linear cut sorted by index. False if not linear.
+    bool getRow_(CutPtr cut, UIntVector &ind, DoubleVector &val) const;
 
-private:
-  /// Environment.
-  EnvPtr env_;
+    /**
+     * Return true if bounds of row r, scaled by its norm, are at least as
+     * tight as lbn and ubn (which are already scaled).
+     */
+    bool isTighter_(UInt r, double lbn, double ubn) const;
 
-  /// For logging.
-  LoggerPtr logger_;
+    /// Put rows in buckets again, after the table has been resized.
+    void rehash_();
 
-  /// Globally valid cuts that are in the relaxation. 
-  CutQ glAct_;
+    /// Signature of a row whose coefficients have two-norm nrm.
+    size_t signature_(const UIntVector &ind, const DoubleVector &val,
+                      double nrm) const;
 
-  /// Globally valid cuts that are not in the relaxation. 
-  CutQ glInact_;
+    /// Sort ind and val together by index.
+    void sortRow_(UIntVector &ind, DoubleVector &val) const;
+  };
 
-  /// For logging.
-  const static std::string me_;
-};
+  typedef boost::shared_ptr<CutPool> CutPoolPtr;
 }
 #endif
 
-// Local Variables: 
-// mode: c++ 
-// eval: (c-set-style "k&r") 
-// eval: (c-set-offset 'innamespace 0) 
-// eval: (setq c-basic-offset 2) 
-// eval: (setq fill-column 78) 
-// eval: (auto-fill-mode 1) 
-// eval: (setq column-number-mode 1) 
-// eval: (setq indent-tabs-mode nil) 
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
 // End:
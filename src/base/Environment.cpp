@@ -85,6 +85,11 @@ void Environment::createDefaultOptions_()
       "Should presolve be used: <0/1>", true, false);
   options_->insert(b_option);
 
+  b_option = (BoolOptionPtr) new Option<bool>("profile",
+      "Should the time spent in parts of branch-and-bound be profiled: <0/1>",
+      true, false);
+  options_->insert(b_option);
+
   b_option = (BoolOptionPtr) new Option<bool>("separability",
       "Should separability be used: <0/1>", true, false);
   options_->insert(b_option);
@@ -130,6 +135,11 @@ void Environment::createDefaultOptions_()
       "Should solve the problem: <0/1>", true, true);
   options_->insert(b_option);
 
+  b_option = (BoolOptionPtr) new Option<bool>("bnb_reopt", 
+      "Keep the tree, cuts and incumbent to reoptimize after the problem is changed: <0/1>",
+      true, false);
+  options_->insert(b_option);
+
   b_option = (BoolOptionPtr) new Option<bool>("lin_presolve", 
       "Should presolve using linear handler: <0/1>", true, true);
   options_->insert(b_option);
@@ -150,6 +160,40 @@ void Environment::createDefaultOptions_()
       "Should presolve using nonlinear presolver: <0/1>", true, true);
   options_->insert(b_option);
 
+  b_option = (BoolOptionPtr) new Option<bool>("lin_dup_cols", 
+      "Fix variables dominated by duplicate columns in linear presolve: <0/1>",
+      true, false);
+  options_->insert(b_option);
+
+  b_option = (BoolOptionPtr) new Option<bool>("prop_engine", 
+      "Tighten bounds in nodes by propagating only constraints whose variables changed: <0/1>",
+      true, false);
+  options_->insert(b_option);
+
+  b_option = (BoolOptionPtr) new Option<bool>("lin_probe", 
+      "Probe on binary variables in linear presolve: <0/1>", true, false);
+  options_->insert(b_option);
+
+  b_option = (BoolOptionPtr) new Option<bool>("conflict_analysis", 
+      "Learn conflicts from pruned nodes and propagate them: <0/1>",
+      true, false);
+  options_->insert(b_option);
+
+  b_option = (BoolOptionPtr) new Option<bool>("clique_table", 
+      "Build a clique table of binary variables for propagation and clique cuts: <0/1>",
+      true, false);
+  options_->insert(b_option);
+
+  b_option = (BoolOptionPtr) new Option<bool>("obbt", 
+      "Tighten bounds of variables in nonconvex terms by solving LPs: <0/1>",
+      true, false);
+  options_->insert(b_option);
+
+  b_option = (BoolOptionPtr) new Option<bool>("rc_fix", 
+      "Tighten bounds using reduced costs of relaxations in every node: <0/1>",
+      true, false);
+  options_->insert(b_option);
+
   b_option = (BoolOptionPtr) new Option<bool>("lin_show_stats", 
       "Should show statistics of linear handler: <0/1>", true, 
       true);
@@ -164,6 +208,11 @@ void Environment::createDefaultOptions_()
       "Use feasibility pump heuristic for MINLP: <0/1>", true, false);
   options_->insert(b_option);
 
+  b_option = (BoolOptionPtr) new Option<bool>("mipstart_use_x0", 
+      "Use the initial point of the problem as a MIP start: <0/1>", 
+      true, false);
+  options_->insert(b_option);
+
   b_option = (BoolOptionPtr) new Option<bool>("modify_rel_only", 
       "If true, apply all modifications to relaxation only  <0/1>",
       true, true);
@@ -179,6 +228,11 @@ void Environment::createDefaultOptions_()
       true, false);
   options_->insert(b_option);
 
+  b_option = (BoolOptionPtr) new Option<bool>("qg_cut_aging",
+      "Remove inactive cuts from the LP relaxation in qg and add them back when violated: <0/1>",
+      true, false);
+  options_->insert(b_option);
+
   b_option = (BoolOptionPtr) new Option<bool>("partial_BB",
       "Fix the bounds partially in QGHandler: <0/1>",
       true, false);
@@ -198,6 +252,10 @@ void Environment::createDefaultOptions_()
      "If true, use Minotaur's computational graph to evaluate nonlinear functions and their derivatives. <0/1>", true, false);
   options_->insert(b_option);
 
+  b_option = (BoolOptionPtr) new Option<bool> ("native_nl_reader", 
+     "If true, and if use_native_cgraph is true, read .nl files with Minotaur's own reader instead of the AMPL Solver Library. <0/1>", true, false);
+  options_->insert(b_option);
+
   b_option = (BoolOptionPtr) new Option<bool>("mcbnb_iter_mode",
       "If true, synchronize node processing in each round across all threads in parallel branch-and-bound: <0/1>", true, false);
   options_->insert(b_option);
@@ -220,14 +278,37 @@ void Environment::createDefaultOptions_()
       true, 1000000000);
   options_->insert(i_option);
 
+  i_option = (IntOptionPtr) new Option<int>("bnb_restarts", 
+      "Maximum number of times branch-and-bound is restarted after the root: >=0",
+      true, 0);
+  options_->insert(i_option);
+
   i_option = (IntOptionPtr) new Option<int>("bnb_sol_limit", 
       "Limit on the number of solutions found: >0", true, 
       1000000000);
   options_->insert(i_option);
 
+  i_option = (IntOptionPtr) new Option<int>("conflict_max_age", 
+      "Conflicts not used in these many nodes are removed: >0", true, 1000);
+  options_->insert(i_option);
+
+  i_option = (IntOptionPtr) new Option<int>("conflict_max_size", 
+      "Conflicts with more bounds are not kept: >0", true, 10);
+  options_->insert(i_option);
+
+  i_option = (IntOptionPtr) new Option<int>("obbt_depth", 
+      "Optimization-based bound tightening is done in nodes up to this depth: -1 never, 0 only root, >0",
+      true, 0);
+  options_->insert(i_option);
+
   i_option = (IntOptionPtr) new Option<int>("pres_freq", 
       "Frequency of node-presolves in branch-and-bound", true, 5);
   options_->insert(i_option);
+
+  i_option = (IntOptionPtr) new Option<int>("profile_trace_max",
+      "Maximum number of events traced in each thread by the profiler",
+      true, 1000000);
+  options_->insert(i_option);
   
   i_option = (IntOptionPtr) new Option<int>("ampl_log_level", 
       "Verbosity of ampl interface: 0-6", true, LogInfo);
@@ -257,6 +338,21 @@ void Environment::createDefaultOptions_()
       "Verbosity of the main solving process: 0-6", true, LogInfo);
   options_->insert(i_option);
 
+  i_option = (IntOptionPtr) new Option<int>("cut_age_limit", 
+      "Number of LP solves after which a cut with zero dual and positive slack is moved out of the relaxation: >=0",
+      true, 100);
+  options_->insert(i_option);
+
+  i_option = (IntOptionPtr) new Option<int>("cut_del_batch", 
+      "Minimum number of aged cuts removed from the relaxation together: >=1",
+      true, 6);
+  options_->insert(i_option);
+
+  i_option = (IntOptionPtr) new Option<int>("cut_sel_max", 
+      "Maximum number of cuts moved from pool to relaxation in one round: >=0 (0 = no limit)",
+      true, 0);
+  options_->insert(i_option);
+
   i_option = (IntOptionPtr) new Option<int>("divheur", 
       "Use diving heuristic for MINLP: <-1/0/1>", 
       true, -1);
@@ -273,6 +369,11 @@ void Environment::createDefaultOptions_()
   i_option = (IntOptionPtr) new Option<int>("heur_log_level", 
       "Verbosity of Multi Start Heuristic: 0-6", true, LogInfo);
   options_->insert(i_option);
+
+  i_option = (IntOptionPtr) new Option<int>("mipstart_rins_nlps", 
+      "Max relaxations solved in the dive around a MIP start, 0 for none: >=0",
+      true, 0);
+  options_->insert(i_option);
   
   // Serdar added these options for MultilinearTermsHandler class
   i_option = (IntOptionPtr) new Option<int>("ml_max_group_size",
@@ -296,10 +397,25 @@ void Environment::createDefaultOptions_()
       "Verbosity of perspective cut generation: 0-6", true, LogInfo);
   options_->insert(i_option);
 
+  i_option = (IntOptionPtr) new Option<int>("qg_nlp_queue", 
+      "Number of fixed-integer NLPs queued and solved together in qg: >=0 (0 = solve each one right away)",
+      true, 0);
+  options_->insert(i_option);
+
   i_option = (IntOptionPtr) new Option<int>("rand_seed", 
       "Seed to random number generator: >=0 (0 = time(NULL))", true, 0);
   options_->insert(i_option);
 
+  i_option = (IntOptionPtr) new Option<int>("sep_threads", 
+      "Number of threads used for calling separators of handlers in a node: >=1",
+      true, 1);
+  options_->insert(i_option);
+
+  i_option = (IntOptionPtr) new Option<int>("symmetry", 
+      "Use symmetries of the formulation: 0 no, 1 symmetry-breaking constraints, 2 orbital fixing in nodes: <0/1/2>",
+      true, 0);
+  options_->insert(i_option);
+
    i_option = (IntOptionPtr) new Option<int>("strbr_pivot_limit",
       "Limit on number of iterations allowed during strong branching: >0",
       true, 25);
@@ -340,16 +456,36 @@ void Environment::createDefaultOptions_()
       "MultilinearTermsHandler feasibility tolerance.", true, 0.00001);
   options_->insert(d_option);
 
+  d_option = (DoubleOptionPtr) new Option<double>("lin_probe_time", 
+      "Limit on time for probing in linear presolve in seconds: >0",
+      true, 10.);
+  options_->insert(d_option);
+
   d_option = (DoubleOptionPtr) new Option<double>("bnb_time_limit", 
       "Limit on time in branch-and-bound in seconds: >0",
       true, 1e20);
   options_->insert(d_option);
   
+  d_option = (DoubleOptionPtr) new Option<double>("bnb_checkpoint_interval", 
+      "Minimum time in seconds between two checkpoints of branch-and-bound: >0",
+      true, 600.);
+  options_->insert(d_option);
+
+  d_option = (DoubleOptionPtr) new Option<double>("bnb_restart_frac", 
+      "Restart if this fraction of the free integer variables is fixed in the root: (0,1]",
+      true, 0.2);
+  options_->insert(d_option);
+
   d_option = (DoubleOptionPtr) new Option<double>("bnb_log_interval", 
       "Display interval in seconds for branch-and-bound status: >0", true, 
       5.);
   options_->insert(d_option);
 
+  d_option = (DoubleOptionPtr) new Option<double>("cut_max_cos", 
+      "Cuts whose cosine with a cut already selected is at least this value are not selected by cut managers: (0,1] (1 = no limit)",
+      true, 1.0);
+  options_->insert(d_option);
+
   d_option = (DoubleOptionPtr) new Option<double>("int_tol", 
       "Tolerance for checking integrality",
       true, 0.000001);
@@ -361,6 +497,11 @@ void Environment::createDefaultOptions_()
   options_->insert(d_option);
   // Serdar ended.
 
+  d_option = (DoubleOptionPtr) new Option<double>("obbt_time", 
+      "Time limit (in seconds) on optimization-based bound tightening in one node: >0",
+      true, 30.0);
+  options_->insert(d_option);
+
   d_option = (DoubleOptionPtr) new Option<double>("obj_cut_off", 
       "Nodes with objective value above obj_cut_off are assumed infeasible",
       true, INFINITY);
@@ -371,9 +512,23 @@ void Environment::createDefaultOptions_()
       true, 0.0);
   options_->insert(d_option);
 
+  d_option = (DoubleOptionPtr) new Option<double>("sep_time_budget", 
+      "Wall-clock seconds a separator may use in a node before it is called only when others find no cuts: >=0 (0 = no limit)",
+      true, 0.0);
+  options_->insert(d_option);
+
   d_option.reset();
  
   // string options
+  s_option = (StringOptionPtr) new Option<std::string>("bnb_checkpoint_file", 
+      "File in which the state of branch-and-bound is saved from time to time",
+      true, "");
+  options_->insert(s_option);
+
+  s_option = (StringOptionPtr) new Option<std::string>("bnb_resume_file", 
+      "Checkpoint file from which branch-and-bound is resumed", true, "");
+  options_->insert(s_option);
+
   s_option = (StringOptionPtr) new Option<std::string>("brancher", 
       "Name of brancher: rel, maxvio, lex, rand, maxfreq", 
       true, "rel");
@@ -393,6 +548,11 @@ void Environment::createDefaultOptions_()
       true, "OsiClp");
   options_->insert(s_option);
 
+  s_option = (StringOptionPtr) new Option<std::string>("mipstart_file", 
+      "Files with (partial) starting solutions, separated by commas", 
+      true, "");
+  options_->insert(s_option);
+
   // Serdar added default options for MultilinearTermsHandler.
   s_option = (StringOptionPtr) new Option<std::string>("ml_group_strategy",
       "Group strategy", true, "TC");
@@ -409,11 +569,31 @@ void Environment::createDefaultOptions_()
       true, "");
   options_->insert(s_option);
 
+  s_option = (StringOptionPtr) new Option<std::string>("profile_file",
+      "Prefix of the .json and .csv files the profile is written to, empty for none",
+      true, "");
+  options_->insert(s_option);
+
+  s_option = (StringOptionPtr) new Option<std::string>("profile_trace_file",
+      "File the profiled events are written to in Chrome trace format, empty for none",
+      true, "");
+  options_->insert(s_option);
+
   s_option = (StringOptionPtr) new Option<std::string>("qp_engine", 
       "Engine for solving QP relaxations: bqpd, None", 
       true, "bqpd");
   options_->insert(s_option);
 
+  s_option = (StringOptionPtr) new Option<std::string>("server_socket",
+      "Path of the Unix socket on which a solve server listens, empty to read requests from stdin",
+      true, "");
+  options_->insert(s_option);
+
+  s_option = (StringOptionPtr) new Option<std::string>("snapshot_file",
+      "Binary snapshot of the problem: loaded instead of the instance if it is newer, else written after reading the instance",
+      true, "");
+  options_->insert(s_option);
+
   s_option = (StringOptionPtr) new Option<std::string>("tb_rule",
       "Tie breaking rule for node selection in branch-and-bound: twoChild, FIFO", true, "");
   options_->insert(s_option);
@@ -712,7 +892,11 @@ void Environment::readOptions(int argc, char **argv)
       } else {
         if (s_value=="" && (b_option || i_option || d_option || s_option)) {
           // the next argv is the argument
-          assert(i+1<argc);       // throw exception instead
+          if (i+1>=argc) {
+            logger_->errStream() << me_ << "no value given for option "
+                                 << name << std::endl;
+            break;
+          }
           ++i;
           s_value = argv[i];
         }
@@ -752,6 +936,30 @@ void Environment::readOptions(int argc, char **argv)
 }
 
 
+void Environment::readOptions(const std::string &str)
+{
+  std::vector<std::string> words;
+  std::vector<char *> argv;
+  size_t start = 0, end;
+  const char *seps = " ,\t\n\r";
+
+  // the first word is taken to be the name of the program.
+  words.push_back("minotaur");
+  while ((start=str.find_first_not_of(seps, start))!=std::string::npos) {
+    end = str.find_first_of(seps, start);
+    if (end==std::string::npos) {
+      end = str.size();
+    }
+    words.push_back(str.substr(start, end-start));
+    start = end;
+  }
+  for (UInt i=0; i<words.size(); ++i) {
+    argv.push_back(&(words[i][0]));
+  }
+  readOptions((int) argv.size(), &(argv[0]));
+}
+
+
 UInt Environment::removeDashes_(std::string &name)
 {
   size_t first_occ;
@@ -74,6 +74,18 @@ namespace Minotaur {
     virtual ConstraintVector::const_iterator consEnd() const
     {return cons_.end();};
 
+    /**
+     * \brief Finish the work that separate() has put off.
+     *
+     * A handler may queue work, e.g. NLPs, and do it later in batches. This
+     * is called when the search ends, so that no solution found by such
+     * work is lost.
+     *
+     * \param[in] s_pool The SolutionPool to which new solutions are added.
+     * \param[out] sol_found True if a new solution has been found.
+     */
+    virtual void flushDeferred(SolutionPoolPtr, bool *) {};
+
     /**
      * \brief Return branches for branching.
      *
@@ -158,6 +170,19 @@ namespace Minotaur {
     virtual bool isFeasible(ConstSolutionPtr sol, RelaxationPtr rel,
                             bool &should_prune, double &inf_meas) = 0;
 
+    /**
+     * \brief Return true if separate() can run concurrently with other
+     * handlers.
+     *
+     * A handler may return true only if its separate() routine does not
+     * modify the relaxation, sends every cut it generates to the CutManager
+     * passed to it, and does not touch any data used by other handlers.
+     * The node processor may then call it from a separate thread with a
+     * CutBuffer as the cut manager, and add the cuts to the relaxation
+     * afterwards.
+     */
+    virtual bool isConcurrentSep() const { return false; }
+
     /**
      * \brief Return true if this handler is needed for the problem.
      *
@@ -19,6 +19,8 @@
 #include "Problem.h"
 #include "Node.h"
 #include "CoverCutGenerator.h"
+#include "Cut.h"
+#include "CutBuffer.h"
 #include "CutManager.h"
 #include "Option.h"
 
@@ -97,7 +99,6 @@ void KnapCovHandler::separate(ConstSolutionPtr sol, NodePtr,
   ConstVariablePtr var; 
   // Value of variable.
   double value;
-  bool separated = false;
   UInt n_added = 0;
 
   // Check if integrality is satisfied for each integer variable. 
@@ -117,18 +118,31 @@ void KnapCovHandler::separate(ConstSolutionPtr sol, NodePtr,
     // We do another check in CoverCutGneerator for integrality, may be we
     // should eliminate it and use the one above.
     // Generate cover cuts from current relaxation.
-    CoverCutGeneratorPtr cover = (CoverCutGeneratorPtr) new CoverCutGenerator(rel,sol, env_);
-    // Add cuts to the relaxation by using cut manager.
+    // The clique table is indexed by variables of minlp_, not of rel.
+    ConstCliqueTablePtr cliques;
+    UIntVector cind;
+    VarVector cvars;
+    if (cliques_ && minlp_ && cliques_->hasVars(minlp_)) {
+      cliques = cliques_;
+      cliques_->getRelVars(minlp_, rel, cvars, &cind);
+    }
+    CoverCutGeneratorPtr cover = (CoverCutGeneratorPtr) new CoverCutGenerator(rel,sol, env_, cliques, cind);
+    // Add cuts to the relaxation in the same way as the other handlers: to
+    // the buffer when separating concurrently, directly otherwise.
     CutVector violatedcuts = cover->getViolatedCutList();
-    CutIterator itc;
-    CutIterator beginc = violatedcuts.begin();
-    CutIterator endc   = violatedcuts.end();
-    
-    // Serdar I am not sure if we should add the constraints generated by
-    // addCuts to the constraint vector of knapsack cover handler.
-    // Currently CutMan2::addCuts does not add the cuts to the relaxation formulation.
-    cmanager->addCuts(beginc, endc);
-    cmanager->separate(rel, sol, &separated, &n_added);
+    CutBuffer *cbuf = dynamic_cast<CutBuffer *>(cmanager);
+    CutPtr c;
+    for (CutIterator itc=violatedcuts.begin(); itc!=violatedcuts.end();
+         ++itc) {
+      c = *itc;
+      if (cbuf) {
+        cbuf->addCut(rel, c->getFunction(), c->getLb(), c->getUb(), true,
+                     false);
+      } else {
+        rel->newConstraint(c->getFunction(), c->getLb(), c->getUb());
+      }
+      ++n_added;
+    }
     if (n_added>0) {
       *status = SepaResolve;
     }
@@ -74,6 +74,9 @@ public:
   /// Does nothing.
   void relaxNodeInc(NodePtr , RelaxationPtr , bool * ) {};
 
+  /// Cover cuts are sent to the cut manager, the relaxation is only read.
+  bool isConcurrentSep() const { return true; }
+
   /// Check if solution is feasible.
   /// Checks all the constraints if they are satisfied by the given solution.
   bool isFeasible(ConstSolutionPtr sol, RelaxationPtr relaxation,
@@ -118,6 +121,9 @@ public:
   // Write name.
   std::string getName() const;
 
+  /// Use cliques of binary variables for lifting cover inequalities.
+  void setCliqueTable(ConstCliqueTablePtr cliques) {cliques_ = cliques;}
+
   /// Show statistics.
   void writeStats(std::ostream &) const;
 
@@ -135,6 +141,9 @@ public:
   double KC_time()       {return stats_->time;}
 
 private:
+  /// Cliques of binary variables, may be empty.
+  ConstCliqueTablePtr cliques_;
+
   /// Environment.
   EnvPtr env_;
 
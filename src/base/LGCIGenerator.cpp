@@ -42,8 +42,11 @@ using namespace Minotaur;
 LGCIGenerator::LGCIGenerator() {}
 
 LGCIGenerator::LGCIGenerator(ProblemPtr p, SolutionPtr s, 
-                             EnvPtr env, LPEnginePtr lpengine)
-  :  env_(env), p_(p), s_(s), lpengine_(lpengine)
+                             EnvPtr env, LPEnginePtr lpengine,
+                             ConstCliqueTablePtr cliques,
+                             const UIntVector &clique_ind)
+  :  cliques_(cliques), cliqueInd_(clique_ind), env_(env), p_(p), s_(s),
+     lpengine_(lpengine)
 {
   initialize();
   generateAllCuts();
@@ -1041,6 +1044,19 @@ VariablePtr LGCIGenerator::addVar(VariablePtr var, OrigLiftVarsPtr varmap,
   
 }
 
+UInt LGCIGenerator::cliqueLit_(ConstVariablePtr v) const
+{
+  UInt j = v->getIndex();
+
+  if (!cliques_) {
+    return 0;
+  }
+  if (!cliqueInd_.empty()) {
+    j = (j < cliqueInd_.size()) ? cliqueInd_[j] : cliques_->getNumVars();
+  }
+  return CliqueTable::getLit(std::min(j, cliques_->getNumVars()), false);
+}
+
 double LGCIGenerator::lift(CoverSetPtr obj,
                            boost::shared_ptr<std::vector<CoverSetPtr> > origgubs,
                            CoverSetPtr consknap,
@@ -1127,8 +1143,22 @@ double LGCIGenerator::lift(CoverSetPtr obj,
     bgub = copybgub;
   }
 
+  // When uplifting, the variable is one in the lifting problem, so variables
+  // in a clique with it are zero and do not add to the objective.
+  CoverSetPtr liftobj = obj;
+  if (liftup == true && cliques_) {
+    UInt lit = cliqueLit_(variable->first);
+    liftobj = (CoverSetPtr) new CoverSet(*obj);
+    for (CoverSetIterator itobj=liftobj->begin(); itobj!=liftobj->end();
+         ++itobj) {
+      if (cliques_->isAdjacent(lit, cliqueLit_(itobj->first))) {
+        itobj->second = 0.0;
+      }
+    }
+  }
+
   // Define problem.
-  addCons(obj, consknap, knapb, gubcons, bgub, varmap, liftprob); 
+  addCons(liftobj, consknap, knapb, gubcons, bgub, varmap, liftprob); 
 
   // Prepare for solve    
   liftprob->prepareForSolve();
@@ -1705,44 +1735,29 @@ void LGCIGenerator::generateCut(const ConstCoverSetPtr inequality, double rhs, C
   cut = (CutPtr) new Cut(p_->getNumVars(), f, lb, rhs, false, false);
 }
 
-/**
- * TODO: Create a new index for variables in the knapsack only.
- * Do not consider all variables for coefficients.
- */
 bool LGCIGenerator::checkExists(CoverSetPtr inequality, double rhs)
 {
   // Iterators for variables in cut.
   CoverSetConstIterator it;
   CoverSetConstIterator begin = inequality->begin();
   CoverSetConstIterator end   = inequality->end();
-  // Number of variables in the problem.
-  // Later change this to number of variables in the linear function.
-  UInt numvars = p_->getNumVars();
-  // Vector to include coefficients.
-  std::vector<double> coeffs(numvars,0);
-  // Index of the variable in the problem.
-  UInt index = 0;
-  // Current variable considered.
-  VariablePtr var;
-  // Coefficient divided by rhs of cover inequality.
-  double dividedcoeff;
-  // Add coefficients to coefficient vector one by one.
+  // Indices and coefficients of variables in the cut.
+  UIntVector ind;
+  DoubleVector val;
+  // Add coefficients one by one.
   for (it=begin; it!=end; ++it) {
-    var           = it->first;
-    index         = var->getIndex();
-    dividedcoeff  = it->second / rhs;
-    coeffs[index] = dividedcoeff;
+    if (it->second != 0) {
+      ind.push_back(it->first->getIndex());
+      val.push_back(it->second);
+    }
   }
   
-  // Check if the cut already exists.
-  std::map< std::vector<double>, UInt>::iterator found  = cutmap_.find(coeffs);
-  std::map< std::vector<double>, UInt>::iterator endmap = cutmap_.end();
-  if (found == endmap) {
-    cutmap_.insert(std::pair< std::vector<double>, UInt > (coeffs,stats_->totalcuts));
-    return false; 
-  } else {    
+  // Check if the cut (or a tighter one) already exists.
+  if (cutPool_.findDup(ind, val, 0.0, rhs) >= 0) {
     return true;
   }
+  cutPool_.addRow(ind, val, 0.0, rhs);
+  return false;
 }
 
 double LGCIGenerator::violation(CutPtr cut)
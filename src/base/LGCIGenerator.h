@@ -21,11 +21,13 @@ using std::ofstream;
 using std::string;
 
 
+#include "CliqueTable.h"
 #include "KnapsackList.h"
 #include "Problem.h"
 #include "Solution.h"
 #include "Types.h"
 #include "Cut.h"
+#include "CutPool.h"
 #include "Relaxation.h"
 #include "Environment.h"
 #include "ProbStructure.h"
@@ -97,9 +99,18 @@ public:
   // Default constructor.
   LGCIGenerator();
     
-  // Constructor that uses a problem and a solution.
+  /**
+   * Constructor that uses a problem and a solution. If a clique table is
+   * given, variables in a clique with the variable being up-lifted are
+   * kept at zero in the lifting problem. If the table is indexed by the
+   * variables of another problem, e.g. when p is a relaxation, clique_ind
+   * gives the index in the table of each variable of p, see
+   * CliqueTable::getRelVars().
+   */
   LGCIGenerator(ProblemPtr p, SolutionPtr s, 
-                EnvPtr env, LPEnginePtr lpengine);
+                EnvPtr env, LPEnginePtr lpengine,
+                ConstCliqueTablePtr cliques = ConstCliqueTablePtr(),
+                const UIntVector &clique_ind = UIntVector());
 
   // Constructor that uses a relaxation and a solution given.
   LGCIGenerator(RelaxationPtr rel, ConstSolutionPtr sol, 
@@ -302,6 +313,12 @@ public:
   // Return const pointer for problem.
 
 private:
+  // Return the literal of variable v in cliques_, out of range if none.
+  UInt cliqueLit_(ConstVariablePtr v) const;
+  // Cliques of binary variables, may be empty.
+  ConstCliqueTablePtr cliques_;
+  // Index in cliques_ of each variable of p_. Empty if they are the same.
+  UIntVector cliqueInd_;
   // Environment.
   EnvPtr env_;
   // Problem that cover cuts will be generated for.
@@ -325,8 +342,8 @@ private:
   UInt numCons_; 
   // Statistics for LGCI generator.
   LGCIGenStatsPtr stats_;
-  // Hash map that is used to check if a cut is already created or not.
-  std::map< std::vector<double>, UInt> cutmap_;
+  // Cuts created so far, used to check if a cut is already created or not.
+  CutPool cutPool_;
   // Integer tolerance.
   double intTol_;
 
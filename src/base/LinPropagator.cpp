@@ -0,0 +1,330 @@
+//
+//     MINOTAUR -- It's only 1/2 bull
+//
+//     (C)opyright 2008 - 2014 The MINOTAUR Team.
+//
+
+/**
+ * \file LinPropagator.cpp
+ * \brief Implement the methods of class LinPropagator.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#include "MinotaurConfig.h"
+#include "Constraint.h"
+#include "LinearFunction.h"
+#include "LinPropagator.h"
+#include "Problem.h"
+#include "PropEngine.h"
+#include "Variable.h"
+
+using namespace Minotaur;
+
+const std::string LinPropagator::me_ = "LinPropagator: ";
+
+
+LinPropagator::LinPropagator(ProblemPtr p, double eps, double infty)
+  : eps_(eps),
+    infty_(infty),
+    p_(p)
+{
+}
+
+
+LinPropagator::~LinPropagator()
+{
+  cols_.clear();
+  cons_.clear();
+  lf_.clear();
+  rowVars_.clear();
+  p_.reset();
+}
+
+
+void LinPropagator::addCons(ConstraintPtr c)
+{
+  UInt r = cons_.size();
+
+  cons_.push_back(c);
+  dirty_.push_back(false);
+  lb_.push_back(c->getLb());
+  lf_.push_back(LinearFunctionPtr());
+  maxAct_.push_back(0.0);
+  maxInf_.push_back(0);
+  minAct_.push_back(0.0);
+  minInf_.push_back(0);
+  nUpd_.push_back(0);
+  rowCoefs_.push_back(DoubleVector());
+  rowVars_.push_back(VarVector());
+  ub_.push_back(c->getUb());
+  load_(r);
+}
+
+
+void LinPropagator::addTerm_(UInt r, double a, double lb, double ub, int s)
+{
+  double l = (a > 0) ? lb : ub;
+  double u = (a > 0) ? ub : lb;
+
+  if (0.0==a) {
+    return;
+  }
+  if (l <= -infty_ || l >= infty_) {
+    minInf_[r] += s;
+  } else {
+    minAct_[r] += s*a*l;
+    if (fabs(a*l) > 1e8) {
+      dirty_[r] = true;
+    }
+  }
+  if (u <= -infty_ || u >= infty_) {
+    maxInf_[r] += s;
+  } else {
+    maxAct_[r] += s*a*u;
+    if (fabs(a*u) > 1e8) {
+      dirty_[r] = true;
+    }
+  }
+  ++nUpd_[r];
+}
+
+
+void LinPropagator::boundsChanged(ConstVariablePtr v, double olb, double oub)
+{
+  UInt j = v->getIndex();
+  double nlb = v->getLb();
+  double nub = v->getUb();
+
+  if (j >= cols_.size()) {
+    return;
+  }
+  for (std::vector<RowCoef>::const_iterator it=cols_[j].begin();
+       it!=cols_[j].end(); ++it) {
+    addTerm_(it->first, it->second, olb, oub, -1);
+    addTerm_(it->first, it->second, nlb, nub, 1);
+  }
+}
+
+
+std::string LinPropagator::getName() const
+{
+  return "LinPropagator";
+}
+
+
+void LinPropagator::getVars(UInt i, VarVector &vars) const
+{
+  vars.insert(vars.end(), rowVars_[i].begin(), rowVars_[i].end());
+}
+
+
+void LinPropagator::init()
+{
+  for (UInt r=0; r<cons_.size(); ++r) {
+    recompute_(r);
+  }
+}
+
+
+void LinPropagator::load_(UInt r)
+{
+  LinearFunctionPtr lf = cons_[r]->getLinearFunction();
+  VariablePtr v;
+  UInt j;
+
+  lf_[r] = lf;
+  rowVars_[r].clear();
+  rowCoefs_[r].clear();
+  if (lf) {
+    for (VariableGroupConstIterator it=lf->termsBegin(); it!=lf->termsEnd();
+         ++it) {
+      j = it->first->getIndex();
+      v = p_->getVariable(j);
+      rowVars_[r].push_back(v);
+      rowCoefs_[r].push_back(it->second);
+      if (j >= cols_.size()) {
+        cols_.resize(j+1);
+      }
+      cols_[j].push_back(RowCoef(r, it->second));
+    }
+  }
+  recompute_(r);
+}
+
+
+bool LinPropagator::propagate(UInt r, PropEngine *engine)
+{
+  ConstraintPtr c = cons_[r];
+  const VarVector &vars = rowVars_[r];
+  const DoubleVector &coefs = rowCoefs_[r];
+  double lb = c->getLb();
+  double ub = c->getUb();
+  double a, rest, nb;
+  VariablePtr v;
+
+  if (DeletedCons==c->getState() || c->getLinearFunction()!=lf_[r]) {
+    return false;
+  }
+  if (dirty_[r] || nUpd_[r] > 100) {
+    recompute_(r);
+  }
+
+  if (0==minInf_[r] && minAct_[r] > ub+eps_*std::max(1.0, fabs(ub))) {
+    return true;
+  }
+  if (0==maxInf_[r] && maxAct_[r] < lb-eps_*std::max(1.0, fabs(lb))) {
+    return true;
+  }
+
+  // a^Tx <= ub gives upper bounds for a > 0 and lower bounds for a < 0.
+  if (ub < infty_) {
+    for (UInt k=0; k<vars.size() && minInf_[r]<=1; ++k) {
+      a = coefs[k];
+      v = vars[k];
+      if (fabs(a) < eps_) {
+        continue;
+      }
+      if (a > 0) {
+        if (v->getLb() > -infty_) {
+          if (minInf_[r] > 0) {
+            continue;
+          }
+          rest = minAct_[r] - a*v->getLb();
+        } else {
+          rest = minAct_[r];
+        }
+        nb = (ub - rest)/a;
+        if (nb < infty_ && engine->tighten(v, -INFINITY, nb) < 0) {
+          return true;
+        }
+      } else {
+        if (v->getUb() < infty_) {
+          if (minInf_[r] > 0) {
+            continue;
+          }
+          rest = minAct_[r] - a*v->getUb();
+        } else {
+          rest = minAct_[r];
+        }
+        nb = (ub - rest)/a;
+        if (nb > -infty_ && engine->tighten(v, nb, INFINITY) < 0) {
+          return true;
+        }
+      }
+    }
+  }
+
+  // a^Tx >= lb gives lower bounds for a > 0 and upper bounds for a < 0.
+  if (lb > -infty_) {
+    for (UInt k=0; k<vars.size() && maxInf_[r]<=1; ++k) {
+      a = coefs[k];
+      v = vars[k];
+      if (fabs(a) < eps_) {
+        continue;
+      }
+      if (a > 0) {
+        if (v->getUb() < infty_) {
+          if (maxInf_[r] > 0) {
+            continue;
+          }
+          rest = maxAct_[r] - a*v->getUb();
+        } else {
+          rest = maxAct_[r];
+        }
+        nb = (lb - rest)/a;
+        if (nb > -infty_ && engine->tighten(v, nb, INFINITY) < 0) {
+          return true;
+        }
+      } else {
+        if (v->getLb() > -infty_) {
+          if (maxInf_[r] > 0) {
+            continue;
+          }
+          rest = maxAct_[r] - a*v->getLb();
+        } else {
+          rest = maxAct_[r];
+        }
+        nb = (lb - rest)/a;
+        if (nb < infty_ && engine->tighten(v, -INFINITY, nb) < 0) {
+          return true;
+        }
+      }
+    }
+  }
+  return false;
+}
+
+
+void LinPropagator::recompute_(UInt r)
+{
+  const VarVector &vars = rowVars_[r];
+  const DoubleVector &coefs = rowCoefs_[r];
+
+  minAct_[r] = maxAct_[r] = 0.0;
+  minInf_[r] = maxInf_[r] = 0;
+  for (UInt k=0; k<vars.size(); ++k) {
+    addTerm_(r, coefs[k], vars[k]->getLb(), vars[k]->getUb(), 1);
+  }
+  dirty_[r] = false;
+  nUpd_[r] = 0;
+}
+
+
+bool LinPropagator::refresh(UInt i)
+{
+  ConstraintPtr c = cons_[i];
+
+  if (c->getLinearFunction() != lf_[i]) {
+    unload_(i);
+    lb_[i] = c->getLb();
+    ub_[i] = c->getUb();
+    load_(i);
+    return true;
+  }
+  if (c->getLb() != lb_[i] || c->getUb() != ub_[i]) {
+    lb_[i] = c->getLb();
+    ub_[i] = c->getUb();
+    return true;
+  }
+  return false;
+}
+
+
+void LinPropagator::unload_(UInt r)
+{
+  std::vector<RowCoef> *col;
+  UInt j;
+
+  for (VarVector::const_iterator it=rowVars_[r].begin();
+       it!=rowVars_[r].end(); ++it) {
+    j = (*it)->getIndex();
+    if (j >= cols_.size()) {
+      continue;
+    }
+    col = &(cols_[j]);
+    for (UInt k=0; k<col->size(); ) {
+      if ((*col)[k].first==r) {
+        (*col)[k] = col->back();
+        col->pop_back();
+      } else {
+        ++k;
+      }
+    }
+  }
+}
+
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
@@ -0,0 +1,168 @@
+//
+//     MINOTAUR -- It's only 1/2 bull
+//
+//     (C)opyright 2008 - 2014 The MINOTAUR Team.
+//
+
+/**
+ * \file LinPropagator.h
+ * \brief Declare class LinPropagator for tightening bounds using linear
+ * constraints.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#ifndef MINOTAURLINPROPAGATOR_H
+#define MINOTAURLINPROPAGATOR_H
+
+#include "Propagator.h"
+
+namespace Minotaur {
+
+  class LinearFunction;
+  typedef boost::shared_ptr<LinearFunction> LinearFunctionPtr;
+
+  /**
+   * \brief Tighten bounds of variables using linear constraints
+   * \f$l \leq a^Tx \leq u\f$.
+   *
+   * Each constraint is an item. For every row, the minimum and maximum
+   * activity over the current bounds are kept as a finite sum and the number
+   * of terms whose contribution is infinite. These are updated in
+   * boundsChanged() by looking only at the rows of the changed variable, so
+   * that propagating a row does not need a pass to compute its activity. A
+   * row is recomputed from scratch after many updates, or after an update
+   * involving large numbers, to limit the loss of accuracy.
+   */
+  class LinPropagator : public Propagator {
+  public:
+    /**
+     * \brief Constructor.
+     *
+     * \param[in] p The problem whose variables appear in the constraints.
+     * \param[in] eps Coefficients smaller than this are not used for
+     * tightening bounds. It is also the tolerance for infeasibility.
+     * \param[in] infty Bounds beyond this number are treated as infinite.
+     */
+    LinPropagator(ProblemPtr p, double eps, double infty);
+
+    /// Destroy.
+    ~LinPropagator();
+
+    /// Add a linear constraint as a new item.
+    void addCons(ConstraintPtr c);
+
+    // base class method.
+    void boundsChanged(ConstVariablePtr v, double olb, double oub);
+
+    /// Return the constraint of an item.
+    ConstraintPtr getCons(UInt i) const { return cons_[i]; }
+
+    // base class method.
+    std::string getName() const;
+
+    // base class method.
+    UInt getNumItems() const { return cons_.size(); }
+
+    // base class method.
+    void getVars(UInt i, VarVector &vars) const;
+
+    // base class method.
+    void init();
+
+    // base class method.
+    bool propagate(UInt i, PropEngine *engine);
+
+    /**
+     * \brief Check if the function or bounds of the constraint of item i
+     * have changed since it was added or last refreshed, and reload it if
+     * they have.
+     *
+     * \return True if anything changed.
+     */
+    bool refresh(UInt i);
+
+  private:
+    /// A row in which a variable appears, and its coefficient.
+    typedef std::pair<UInt, double> RowCoef;
+
+    /// Rows and coefficients of each variable.
+    std::vector< std::vector<RowCoef> > cols_;
+
+    /// Constraint of each row.
+    ConstraintVector cons_;
+
+    /// Rows that must be recomputed before they are propagated.
+    BoolVector dirty_;
+
+    /// Tolerance.
+    double eps_;
+
+    /// Infinity.
+    double infty_;
+
+    /// Lower bound of each row, as last seen.
+    DoubleVector lb_;
+
+    /// Linear function of each row, as last seen.
+    std::vector<LinearFunctionPtr> lf_;
+
+    /// Finite part of the maximum activity of each row.
+    DoubleVector maxAct_;
+
+    /// Number of terms with infinite contribution to the maximum activity.
+    std::vector<int> maxInf_;
+
+    /// For logging.
+    static const std::string me_;
+
+    /// Finite part of the minimum activity of each row.
+    DoubleVector minAct_;
+
+    /// Number of terms with infinite contribution to the minimum activity.
+    std::vector<int> minInf_;
+
+    /// Number of incremental updates of each row since it was computed.
+    UIntVector nUpd_;
+
+    /// The problem.
+    ProblemPtr p_;
+
+    /// Coefficients of each row.
+    std::vector<DoubleVector> rowCoefs_;
+
+    /// Variables of each row.
+    std::vector<VarVector> rowVars_;
+
+    /// Upper bound of each row, as last seen.
+    DoubleVector ub_;
+
+    /**
+     * Add (s=1) or remove (s=-1) the contribution of a term with
+     * coefficient a and variable bounds lb, ub to the activities of row r.
+     */
+    void addTerm_(UInt r, double a, double lb, double ub, int s);
+
+    /// Copy terms of the constraint of row r and compute its activities.
+    void load_(UInt r);
+
+    /// Compute activities of row r from the current bounds.
+    void recompute_(UInt r);
+
+    /// Remove row r from the lists of its variables.
+    void unload_(UInt r);
+  };
+
+  typedef boost::shared_ptr<LinPropagator> LinPropagatorPtr;
+}
+#endif
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
@@ -74,6 +74,19 @@ void LinearFunction::addTerm(ConstVariablePtr var, const double a)
 }
 
 
+void LinearFunction::appendTerm(ConstVariablePtr var, const double a)
+{
+  if (terms_.empty() || terms_.key_comp()(terms_.rbegin()->first, var)) {
+    if (fabs(a) > tol_) {
+      terms_.insert(terms_.end(), std::make_pair(var, a));
+      hasChanged_ = true;
+    }
+  } else {
+    incTerm(var, a);
+  }
+}
+
+
 LinearFunctionPtr LinearFunction::clone() const
 {
    LinearFunctionPtr lf = (LinearFunctionPtr) new LinearFunction();
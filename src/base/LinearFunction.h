@@ -61,6 +61,14 @@ namespace Minotaur {
      */
     void addTerm(ConstVariablePtr var, const double a); 
 
+    /**
+     * Add a term whose variable has a larger id than all variables already
+     * in this function, e.g. when copying a sparse row whose entries are
+     * sorted. The term is put at the end of the map without searching it. If
+     * the order is not kept, the term is added as in incTerm().
+     */
+    void appendTerm(ConstVariablePtr var, const double a);
+
     /**
      * Removes all terms from the function
      */
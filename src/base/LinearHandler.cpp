@@ -12,6 +12,7 @@
  * \author Ashutosh Mahajan, Argonne National Laboratory
  */
 
+#include <algorithm>
 #include <cmath>
 #include <iomanip>
 #include <iostream>
@@ -19,17 +20,21 @@
 #include "MinotaurConfig.h"
 #include "Branch.h"
 #include "BrCand.h"
+#include "CliquePropagator.h"
 #include "Constraint.h"
 #include "Environment.h"
 #include "Function.h"
 #include "LinearFunction.h"
+#include "LinPropagator.h"
 #include "Logger.h"
 #include "Node.h"
 #include "NonlinearFunction.h"
 #include "Objective.h"
 #include "Option.h"
+#include "PostsolveStack.h"
 #include "PreDelVars.h"
-#include "PreSubstVars.h"
+#include "Prober.h"
+#include "PropEngine.h"
 #include "Relaxation.h"
 #include "Solution.h"
 #include "SolutionPool.h"
@@ -80,6 +85,14 @@ LinearHandler::LinearHandler(EnvPtr env, ProblemPtr problem)
   pOpts_->purgeCons   = true;
   pOpts_->dualFix     = true;
   pOpts_->coeffImp    = true;
+  pOpts_->dupCols     = env->getOptions()->findBool("lin_dup_cols")
+    ->getValue();
+  pOpts_->propEngine  = env->getOptions()->findBool("prop_engine")
+    ->getValue();
+  pOpts_->probe       = env->getOptions()->findBool("lin_probe")
+    ->getValue();
+  pOpts_->probeTime   = env->getOptions()->findDouble("lin_probe_time")
+    ->getValue();
 
   pStats_->iters = 0;
   pStats_->varDel = 0;
@@ -100,6 +113,8 @@ LinearHandler::~LinearHandler()
 {
   delete pStats_;
   delete pOpts_;
+  prop_.reset();
+  linProp_.reset();
   problem_.reset();
   env_.reset();
   linVars_.clear();
@@ -230,6 +245,7 @@ SolveStatus LinearHandler::presolve(PreModQ *pre_mods, bool *changed0)
   ModQ *dmods = 0; // NULL
   Timer *timer = env_->getNewTimer();
   UInt itemp=0;
+  bool probed = false;
 
   timer->start();
   if (false == pOpts_->doPresolve) {
@@ -267,15 +283,26 @@ SolveStatus LinearHandler::presolve(PreModQ *pre_mods, bool *changed0)
     if (true == pOpts_->purgeCons) problem_->delMarkedCons();
     if (true == pOpts_->purgeVars) purgeVars_(pre_mods);
     if (true == pOpts_->purgeVars && pStats_->iters+1 < pOpts_->maxIters) { 
-      chkSing_(&changed);
+      chkSing_(&changed, pre_mods);
       purgeVars_(pre_mods);
     }
     if (true == pOpts_->purgeCons) {
       dupRows_(&changed);
       problem_->delMarkedCons();
     }
+    if (true == pOpts_->dupCols) dupCols_(&changed);
     if (true == pOpts_->coeffImp) coeffImp_(&changed);
     ++(pStats_->iters);
+    if (true == pOpts_->probe && false == probed &&
+        (false == changed || pStats_->iters >= pOpts_->maxIters)) {
+      // probe once, when other reductions are done.
+      probed = true;
+      status = probe_(&changed);
+      if (status == SolvedInfeasible) {
+        delete timer;
+        return SolvedInfeasible;
+      }
+    }
     if (changed) {
       *changed0 = true;
     }
@@ -323,14 +350,15 @@ SolveStatus LinearHandler::checkBounds_(ProblemPtr p)
 }
 
 
-void LinearHandler::chkSing_(bool *changed)
+void LinearHandler::chkSing_(bool *changed, PreModQ *pre_mods)
 {
   ConstraintPtr c;
   LinearFunctionPtr lf;
   FunctionPtr of = problem_->getObjective()->getFunction();
   VariablePtr v;
-  double coeff;
+  double coeff, val;
   bool del_var;
+  PostsolveStackPtr stack = PostsolveStack::get(pre_mods, problem_);
 
   findLinVars_();
   for (VarQueueConstIter vit=linVars_.begin(); vit!=linVars_.end(); ++vit) {
@@ -340,22 +368,35 @@ void LinearHandler::chkSing_(bool *changed)
       lf = c->getFunction()->getLinearFunction();
       coeff = lf->getWeight(v);
       del_var = false;
-      if (coeff>0) {
-        if (c->getLb()>-INFINITY && c->getUb()>=INFINITY) {
-          problem_->changeBound(c, Lower, c->getLb()-coeff*v->getUb());
-          del_var = true;
-        } else if (c->getUb()<INFINITY && c->getLb()<=-INFINITY) {
-          problem_->changeBound(c, Upper, c->getUb()-coeff*v->getLb());
-          del_var = true;
+      if (c->getLb()>-INFINITY && c->getUb()>=INFINITY) {
+        // v is fixed at the bound that makes c easiest to satisfy. If the
+        // bound is infinite, c can always be satisfied by v.
+        val = (coeff>0) ? v->getUb() : v->getLb();
+        if (fabs(val)<INFINITY) {
+          del_var = stack->fixCol(v, val, problem_);
+        } else {
+          del_var = stack->substCol(v, c, c->getLb(), problem_);
         }
-      } else {
-        if (c->getLb()>-INFINITY && c->getUb()>=INFINITY) {
-          problem_->changeBound(c, Lower, c->getLb()-coeff*v->getLb());
-          del_var = true;
-        } else  if (c->getUb()<INFINITY && c->getLb()<=-INFINITY) {
-          problem_->changeBound(c, Upper, c->getUb()-coeff*v->getUb());
-          del_var = true;
+        if (del_var) {
+          problem_->changeBound(c, Lower, c->getLb()-coeff*val);
         }
+      } else if (c->getUb()<INFINITY && c->getLb()<=-INFINITY) {
+        val = (coeff>0) ? v->getLb() : v->getUb();
+        if (fabs(val)<INFINITY) {
+          del_var = stack->fixCol(v, val, problem_);
+        } else {
+          del_var = stack->substCol(v, c, c->getUb(), problem_);
+        }
+        if (del_var) {
+          problem_->changeBound(c, Upper, c->getUb()-coeff*val);
+        }
+      } else if (true==pOpts_->purgeCons &&
+                 c->getUb()-c->getLb() < eTol_ && isImplFree_(v, c) &&
+                 stack->substCol(v, c, c->getLb(), problem_)) {
+        // free column singleton: c and v are both removed.
+        problem_->markDelete(c);
+        ++(pStats_->conDel);
+        del_var = true;
       }
       if (del_var) {
         problem_->changeBound(v, 0.0, 0.0);
@@ -372,6 +413,55 @@ void LinearHandler::chkSing_(bool *changed)
 }
 
 
+void LinearHandler::syncProp_(RelaxationPtr rel)
+{
+  ConstraintPtr c;
+  UInt pos = 0;
+  bool rebuild = !prop_ || prop_->getProblem()!=rel;
+
+  if (false==rebuild) {
+    prop_->sync();
+    for (ConstraintConstIterator it=rel->consBegin(); it!=rel->consEnd();
+         ++it) {
+      c = *it;
+      if (c->getFunctionType()!=Linear) {
+        continue;
+      }
+      if (pos < linProp_->getNumItems()) {
+        if (c!=linProp_->getCons(pos)) {
+          rebuild = true;
+          break;
+        } else if (linProp_->refresh(pos)) {
+          prop_->itemChanged(0, pos);
+        }
+      } else {
+        linProp_->addCons(c);
+      }
+      ++pos;
+    }
+    if (pos < linProp_->getNumItems()) {
+      rebuild = true;
+    }
+  }
+
+  if (true==rebuild) {
+    linProp_ = (LinPropagatorPtr) new LinPropagator(rel, eTol_, infty_);
+    for (ConstraintConstIterator it=rel->consBegin(); it!=rel->consEnd();
+         ++it) {
+      if ((*it)->getFunctionType()==Linear) {
+        linProp_->addCons(*it);
+      }
+    }
+    prop_ = (PropEnginePtr) new PropEngine(rel);
+    prop_->setTols(eTol_, 1e-6);
+    prop_->addPropagator(linProp_);
+    prop_->init();
+  } else {
+    prop_->update();
+  }
+}
+
+
 void LinearHandler::tightenInts_(ProblemPtr p, bool apply_to_prob, 
                                  bool *changed, ModQ *mods)
 {
@@ -813,28 +903,128 @@ void LinearHandler::dualFix_(bool *changed)
 }
 
 
+void LinearHandler::dupCols_(bool *changed)
+{
+  const UInt m = problem_->getNumCons();
+  DoubleVector r1;
+  std::vector<std::pair<double, UInt> > keys;
+  UIntVector grp;
+  VarVector vars;
+  LinearFunctionPtr olf = problem_->getObjective()->getLinearFunction();
+  VariablePtr v1, v2;
+  ConstraintPtr c;
+  double g, o1, o2;
+  UInt i, j, k;
+  ModificationPtr mod = ModificationPtr(); //null
+
+  if (problem_->sos1Begin() != problem_->sos1End() ||
+      problem_->sos2Begin() != problem_->sos2End()) {
+    return;
+  }
+
+  r1.reserve(m);
+  for (i=0; i<m; ++i) {
+    r1.push_back((double) rand()/(RAND_MAX)*10.0);
+  }
+
+  // signature of a column: its coefficients weighted by random numbers.
+  findLinVars_();
+  for (VarQueueConstIter vit=linVars_.begin(); vit!=linVars_.end(); ++vit) {
+    v1 = *vit;
+    if (v1->getUb() - v1->getLb() < eTol_ || 0 == v1->getNumCons()) {
+      continue;
+    }
+    g = 0.0;
+    for (ConstrSet::iterator cit=v1->consBegin(); cit!=v1->consEnd(); ++cit) {
+      c = *cit;
+      if (!c->getLinearFunction()) {
+        g = INFINITY;
+        break;
+      }
+      g += r1[c->getIndex()]*c->getLinearFunction()->getWeight(v1);
+    }
+    if (g < INFINITY) {
+      keys.push_back(std::make_pair(g, vars.size()));
+      vars.push_back(v1);
+    }
+  }
+  std::sort(keys.begin(), keys.end());
+
+  for (i=0; i<keys.size(); i=j) {
+    grp.clear();
+    grp.push_back(keys[i].second);
+    for (j=i+1; j<keys.size() &&
+         fabs(keys[j].first-keys[j-1].first) <=
+         1e-6*(1.0+fabs(keys[j-1].first)); ++j) {
+      grp.push_back(keys[j].second);
+    }
+    if (grp.size() < 2) {
+      continue;
+    }
+    std::sort(grp.begin(), grp.end());
+    for (k=0; k<grp.size(); ++k) {
+      v1 = vars[grp[k]];
+      for (UInt l=0; l<grp.size(); ++l) {
+        v2 = vars[grp[l]];
+        if (l == k || v1->getUb() - v1->getLb() < eTol_ ||
+            false == sameCols_(v1, v2)) {
+          continue;
+        }
+        // the amount by which v1 leaves a bound must be taken by v2.
+        if (v2->getType() != Continuous && v1->getType() == Continuous) {
+          continue;
+        }
+        o1 = (olf) ? olf->getWeight(v1) : 0.0;
+        o2 = (olf) ? olf->getWeight(v2) : 0.0;
+        if (o1 >= o2 && v2->getUb() >= INFINITY && v1->getLb() > -INFINITY) {
+          mod = (VarBoundModPtr) new VarBoundMod(v1, Upper, v1->getLb());
+        } else if (o1 <= o2 && v2->getLb() <= -INFINITY &&
+                   v1->getUb() < INFINITY) {
+          mod = (VarBoundModPtr) new VarBoundMod(v1, Lower, v1->getUb());
+        } else {
+          continue;
+        }
+        mod->applyToProblem(problem_);
+        *changed = true;
+        ++(pStats_->vBnd);
+#if SPEW
+        logger_->msgStream(LogDebug) << me_ << "variable " << v1->getName()
+                                     << " fixed, it is dominated by "
+                                     << v2->getName() << std::endl;
+#endif
+      }
+    }
+  }
+}
+
+
 void LinearHandler::dupRows_(bool *changed)
 {
   const UInt n = problem_->getNumVars();
   const UInt m = problem_->getNumCons();
-  UInt i,j;
+  UInt i, j, k, l, nk;
   int err = 0;
   DoubleVector r1, r2;
   DoubleVector h1;
   DoubleVector h2;
+  std::vector<std::pair<double, UInt> > keys, zkeys;
+  UIntVector grp;
   ConstraintPtr c1, c2;
   bool is_deleted;
 
   r1.reserve(n);
   r2.reserve(n);
-  h1.reserve(m);
-  h2.reserve(m);
+  h1.assign(m, 1e30);
+  h2.assign(m, 1e30);
 
   for (i=0; i<n; ++i) {
     r1.push_back((double) rand()/(RAND_MAX)*10.0);
     r2.push_back((double) rand()/(RAND_MAX)*10.0);
   }
 
+  // Parallel rows have the same ratio h1/h2. Sort rows on this ratio so
+  // that only rows with nearly the same ratio are compared. Rows with h2 = 0
+  // are sorted on |h1| instead.
   i=0;
   for (ConstraintConstIterator it=problem_->consBegin();
        it!=problem_->consEnd(); ++it, ++i) {
@@ -842,22 +1032,45 @@ void LinearHandler::dupRows_(bool *changed)
     if (c1->getFunctionType()==Linear) {
       h1[i] = c1->getActivity(&(r1[0]), &err);
       h2[i] = c1->getActivity(&(r2[0]), &err);
-    } else {
-      h1[i] = h2[i] = 1e30;
+      if (h2[i] != 0.0) {
+        keys.push_back(std::make_pair(h1[i]/h2[i], i));
+      } else {
+        zkeys.push_back(std::make_pair(fabs(h1[i]), i));
+      }
     }
   }
+  std::sort(keys.begin(), keys.end());
+  std::sort(zkeys.begin(), zkeys.end());
+  nk = keys.size();
+  keys.insert(keys.end(), zkeys.begin(), zkeys.end());
+
+  for (k=0; k<keys.size(); k=l) {
+    grp.clear();
+    grp.push_back(keys[k].second);
+    for (l=k+1; l<keys.size() && (l<nk)==(k<nk) &&
+         fabs(keys[l].first-keys[l-1].first) <=
+         1e-6*(1.0+fabs(keys[l-1].first)); ++l) {
+      grp.push_back(keys[l].second);
+    }
+    if (grp.size() < 2) {
+      continue;
+    }
 
-  for (i=0; i<m; ++i) {
-    if (h1[i]<1e29) {
-      for (j=i+1; j<m; ++j) {
+    // compare rows in the same order as the pairwise check over all rows,
+    // so that the same rows are kept.
+    std::sort(grp.begin(), grp.end());
+    for (UInt a=0; a<grp.size(); ++a) {
+      i = grp[a];
+      if (h1[i]>=1e29) {
+        continue;
+      }
+      for (UInt b=a+1; b<grp.size(); ++b) {
+        j = grp[b];
         if (fabs(h1[j]-h1[i])<1e-10 ||
             fabs(h1[j]+h1[i])<1e-10) {
           c1 = problem_->getConstraint(i);
           c2 = problem_->getConstraint(j);
           is_deleted = treatDupRows_(c1, c2, 1.0, changed);
-          //c1->write(std::cout);
-          //c2->write(std::cout);
-          //std::cout << h1[i] << " xxx " << h1[j] << "\n";
           if (is_deleted) {
             h1[j] = h2[j] = 1e30;
           }
@@ -865,9 +1078,6 @@ void LinearHandler::dupRows_(bool *changed)
           c1 = problem_->getConstraint(i);
           c2 = problem_->getConstraint(j);
           is_deleted = treatDupRows_(c1, c2, h1[i]/h1[j], changed);
-          //c1->write(std::cout);
-          //c2->write(std::cout);
-          //std::cout << h1[i] << " *** " << h1[j] << "\n";
           if (is_deleted) {
             h1[j] = h2[j] = 1e30;
           }
@@ -1231,6 +1441,37 @@ void LinearHandler::getSingLfBnds_(LinearFunctionPtr lf, double *lo,
 }
 
 
+bool LinearHandler::isImplFree_(VariablePtr v, ConstraintPtr c)
+{
+  LinearFunctionPtr lf = c->getLinearFunction();
+  double a = lf->getWeight(v);
+  double lo = 0.0;
+  double up = 0.0;
+  double w, vlo, vup;
+
+  // bounds on the activity of the other variables.
+  for (VariableGroupConstIterator it=lf->termsBegin(); it!=lf->termsEnd();
+       ++it) {
+    if (it->first==v) {
+      continue;
+    }
+    w = it->second;
+    vlo = (w>0) ? w*it->first->getLb() : w*it->first->getUb();
+    vup = (w>0) ? w*it->first->getUb() : w*it->first->getLb();
+    lo += vlo;
+    up += vup;
+  }
+  if (lo < -infty_ || up > infty_) {
+    return false;
+  }
+
+  // v = (b - activity)/a.
+  vlo = (a>0) ? (c->getLb()-up)/a : (c->getLb()-lo)/a;
+  vup = (a>0) ? (c->getLb()-lo)/a : (c->getLb()-up)/a;
+  return (vlo > v->getLb()-eTol_ && vup < v->getUb()+eTol_);
+}
+
+
 void LinearHandler::delFixedVars_(bool *changed)
 {
   VariablePtr v;
@@ -1344,7 +1585,7 @@ void LinearHandler::substVars_(bool *, PreModQ *mods)
   VariableType intype, outtype;
   double a1, a2;
   VariableGroupConstIterator git;
-  PreSubstVarsPtr smod = (PreSubstVarsPtr) new PreSubstVars();
+  PostsolveStackPtr stack = PostsolveStack::get(mods, problem_);
   VarBoundModPtr mod;
 
 #if SPEW
@@ -1374,6 +1615,9 @@ void LinearHandler::substVars_(bool *, PreModQ *mods)
           in = v1;
           out = v2;
         }
+        if (false==stack->substCol(out, c, 0.0, problem_)) {
+          continue;
+        }
         // the 'in' variable should get the right type.
         intype = in->getType();
         outtype = out->getType();
@@ -1407,7 +1651,6 @@ void LinearHandler::substVars_(bool *, PreModQ *mods)
         problem_->markDelete(out);
         ++(pStats_->varDel);
         ++(pStats_->conDel);
-        smod->insert(out, in);
       } else if (v1->getType() == Continuous && v2->getType() == Continuous) {
         double rat = 1.0;
         if (v1->getNumCons()<v2->getNumCons()) {
@@ -1419,6 +1662,9 @@ void LinearHandler::substVars_(bool *, PreModQ *mods)
           out = v1;
           rat = -a2/a1;
         }
+        if (false==stack->substCol(out, c, 0.0, problem_)) {
+          continue;
+        }
         if (rat>0) {
           a1 = out->getLb()/rat;
           a2 = out->getUb()/rat;
@@ -1440,7 +1686,6 @@ void LinearHandler::substVars_(bool *, PreModQ *mods)
         problem_->markDelete(out);
         ++(pStats_->varDel);
         ++(pStats_->conDel);
-        smod->insert(out, in, rat);
 #if SPEW
         logger_->msgStream(LogDebug) << me_ << "substituting " 
                                      << out->getName() << " in constraint " 
@@ -1450,9 +1695,38 @@ void LinearHandler::substVars_(bool *, PreModQ *mods)
       }  
     }
   }
-  if (smod->getSize()>0) {
-    mods->push_front(smod);
+}
+
+
+SolveStatus LinearHandler::probe_(bool *changed)
+{
+  PropEnginePtr engine = (PropEnginePtr) new PropEngine(problem_);
+  LinPropagatorPtr lprop = (LinPropagatorPtr) 
+    new LinPropagator(problem_, eTol_, infty_);
+  ConstraintPtr c;
+
+  for (ConstraintConstIterator it=problem_->consBegin();
+       it!=problem_->consEnd(); ++it) {
+    c = *it;
+    if (c->getFunctionType()==Linear && c->getState()!=DeletedCons) {
+      lprop->addCons(c);
+    }
+  }
+  engine->addPropagator(lprop);
+  if (cliques_) {
+    // cliques saved before variables were deleted are not used.
+    cliques_->setVars(problem_);
+  }
+  if (cliques_ && cliques_->getNumCliques()>0) {
+    engine->addPropagator((CliquePropagatorPtr)
+                          new CliquePropagator(cliques_, problem_));
   }
+  engine->setTols(eTol_, 1e-6);
+
+  prober_ = (ProberPtr) new Prober(env_, problem_, engine);
+  prober_->setCliqueTable(cliques_);
+  prober_->setTimeLimit(pOpts_->probeTime);
+  return prober_->probe(changed);
 }
 
 
@@ -1470,11 +1744,13 @@ void LinearHandler::purgeVars_(PreModQ *pre_mods)
 
   if (problem_->getNumDVars()>0) {
     PreDelVarsPtr dmod = (PreDelVarsPtr) new PreDelVars();
+    PostsolveStackPtr stack = PostsolveStack::get(pre_mods, problem_);
     for (VariableConstIterator it=problem_->varsBegin(); 
         it!=problem_->varsEnd(); ++it) {
       v = *it;
       if (problem_->isMarkedDel(v)) {
         dmod->insert(v);
+        stack->fixCol(v, v->getLb(), problem_);
         //preDelVars_.push_front(v);
       }
     }
@@ -1490,7 +1766,11 @@ bool LinearHandler::presolveNode(RelaxationPtr rel, NodePtr,
                                  ModVector &r_mods)
 {
   SolveStatus status = Started;
-  simplePresolve(rel, spool, r_mods, status);
+  if (pOpts_->propEngine) {
+    propNode_(rel, spool, r_mods, status);
+  } else {
+    simplePresolve(rel, spool, r_mods, status);
+  }
   if (true==modProb_) {
     copyBndsFromRel_(rel, p_mods);
   }
@@ -1498,6 +1778,45 @@ bool LinearHandler::presolveNode(RelaxationPtr rel, NodePtr,
 }
 
 
+void LinearHandler::propNode_(RelaxationPtr rel, SolutionPoolPtr spool,
+                              ModVector &t_mods, SolveStatus &status)
+{
+  bool changed = true;
+  ModQ mods;
+  UInt n0 = t_mods.size();
+  UInt max_iters = 5;
+  UInt iters = 0;
+  Timer *timer = env_->getNewTimer();
+
+  timer->start();
+  syncProp_(rel);
+  while (true==changed && iters<max_iters) {
+    ++iters;
+    changed = false;
+    if (prop_->propagate(&t_mods, 0)) {
+      status = SolvedInfeasible;
+      break;
+    }
+    if (spool && spool->getNumSols()>0) {
+      status = varBndsFromObj_(rel, spool->getBestSolutionValue(), false,
+                               &changed, &mods);
+      if (SolvedInfeasible==status) {
+        break;
+      }
+      if (true==changed) {
+        t_mods.insert(t_mods.end(), mods.begin(), mods.end());
+        mods.clear();
+        prop_->sync();
+      }
+    }
+  }
+
+  pStats_->nMods += t_mods.size()-n0;
+  pStats_->timeN += timer->query();
+  delete timer;
+}
+
+
 void LinearHandler::simplePresolve(ProblemPtr p, SolutionPoolPtr spool,
                                    ModVector &t_mods, SolveStatus &status) 
 {
@@ -1546,6 +1865,26 @@ void LinearHandler::chkIntToBin_(VariablePtr v)
 }
 
 
+bool LinearHandler::sameCols_(VariablePtr v1, VariablePtr v2)
+{
+  ConstrSet::iterator it1, it2;
+
+  if (v1->getNumCons() != v2->getNumCons()) {
+    return false;
+  }
+  // both sets are ordered in the same way.
+  for (it1=v1->consBegin(), it2=v2->consBegin(); it1!=v1->consEnd();
+       ++it1, ++it2) {
+    if (*it1 != *it2 ||
+        fabs((*it1)->getLinearFunction()->getWeight(v1) -
+             (*it2)->getLinearFunction()->getWeight(v2)) > 1e-12) {
+      return false;
+    }
+  }
+  return true;
+}
+
+
 const LinPresolveOpts* LinearHandler::getOpts() const
 {
   return pOpts_;
@@ -1635,6 +1974,12 @@ void LinearHandler::writePreStats(std::ostream &out) const
 void LinearHandler::writeStats(std::ostream &out) const
 {
   writePreStats(out);
+  if (prober_) {
+    prober_->writeStats(out);
+  }
+  if (prop_) {
+    prop_->writeStats(out);
+  }
 }
 
 
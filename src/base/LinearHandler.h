@@ -18,8 +18,16 @@
 
 namespace Minotaur {
 
+class CliqueTable;
 class LinearFunction;
+class LinPropagator;
+class Prober;
+class PropEngine;
+typedef boost::shared_ptr<CliqueTable> CliqueTablePtr;
 typedef boost::shared_ptr<LinearFunction> LinearFunctionPtr;
+typedef boost::shared_ptr<LinPropagator> LinPropagatorPtr;
+typedef boost::shared_ptr<Prober> ProberPtr;
+typedef boost::shared_ptr<PropEngine> PropEnginePtr;
 
 /// Store statistics of presolving.
 struct LinPresolveStats 
@@ -53,6 +61,14 @@ struct LinPresolveOpts {
   bool dualFix;    /// If True, do dual cost fixing.
 
   bool coeffImp;   /// If True, do coefficient improvement.
+
+  bool dupCols;    /// If True, fix variables dominated by duplicate columns.
+
+  bool propEngine; /// If True, use a PropEngine for tightening in nodes.
+
+  bool probe;      /// If True, probe on binary variables.
+
+  double probeTime;/// Limit on time for probing, in seconds.
 }; 
 
 
@@ -147,6 +163,13 @@ public:
 
   void setPreOptCoeffImp(bool val) {pOpts_->coeffImp = val;}; 
 
+  /**
+   * \brief Save implications found by probing in this table. The indices
+   * of variables in it are those of the problem after probing, they are
+   * not updated if presolve deletes variables later.
+   */
+  void setCliqueTable(CliqueTablePtr table) {cliques_ = table;};
+
   void simplePresolve(ProblemPtr p, SolutionPoolPtr spool, ModVector &t_mods,
                       SolveStatus &status);
 
@@ -157,6 +180,9 @@ public:
   void writeStats(std::ostream &out) const;
 
 protected:
+  /// Implications found by probing are saved here, if it is not NULL.
+  CliqueTablePtr cliques_;
+
   /// Environment.
   EnvPtr env_;
 
@@ -179,12 +205,21 @@ protected:
   /// Infinity. Bounds beyond this number are treated as infinity.
   const double infty_;
 
+  /// Propagator for linear constraints of the relaxation, used by prop_.
+  LinPropagatorPtr linProp_;
+
   /// Statistics of presolve.
   LinPresolveStats *pStats_;
 
   /// Options for presolve.
   LinPresolveOpts *pOpts_;
 
+  /// Probing in presolve. Kept for statistics.
+  ProberPtr prober_;
+
+  /// Engine for tightening bounds of the relaxation in nodes.
+  PropEnginePtr prop_;
+
   /**
    * Linear variables: variables that do not appear in nonlinear
    * functions, both in objective and constraints.
@@ -197,7 +232,11 @@ protected:
 
   void chkIntToBin_(VariablePtr v);
 
-  void chkSing_(bool *changed);
+  /**
+   * Remove continuous variables that appear in only one constraint and not
+   * in the objective. The reductions are saved in the PostsolveStack.
+   */
+  void chkSing_(bool *changed, PreModQ *pre_mods);
   void coeffImp_(bool *changed);
   void computeImpBounds_(ConstraintPtr c, VariablePtr z, double zval,
                          double *lb, double *ub);
@@ -206,6 +245,20 @@ protected:
   void delFixedVars_(bool *changed);
 
   void dualFix_(bool *changed);
+
+  /**
+   * Find pairs of variables with the same coefficients in all constraints,
+   * by sorting on a random combination of the coefficients. If one of them
+   * is unbounded in the direction that its objective coefficient allows,
+   * the other one can be fixed at a bound.
+   */
+  void dupCols_(bool *changed);
+
+  /**
+   * Find rows that are multiples of each other, by sorting on the ratio of
+   * two random combinations of the coefficients, and remove them with
+   * treatDupRows_().
+   */
   void dupRows_(bool *changed);
 
   /// check if lb <= ub for all variables and constraints.
@@ -222,6 +275,35 @@ protected:
   SolveStatus linBndTighten_(ProblemPtr p, bool apply_to_prob, 
                       ConstraintPtr c_ptr, bool *changed, ModQ *mods, UInt *nintmods);
 
+  /**
+   * \brief Tighten bounds of the relaxation at a node using prop_. Only the
+   * constraints with variables whose bounds changed since the last call
+   * are visited.
+   *
+   * \param[in] rel The relaxation.
+   * \param[in] spool Pool of solutions. The best objective value, if any,
+   * is used for tightening bounds as well.
+   * \param[out] t_mods Changes to the bounds are appended to it.
+   * \param[out] status SolvedInfeasible if the node is infeasible.
+   */
+  void propNode_(RelaxationPtr rel, SolutionPoolPtr spool, ModVector &t_mods,
+                 SolveStatus &status);
+
+  /**
+   * \brief Probe on binary variables of the problem, propagating all
+   * linear constraints, and the cliques in cliques_, if any.
+   *
+   * \param[out] changed Set to true if the problem was changed.
+   * \return SolvedInfeasible if the problem is found infeasible.
+   */
+  SolveStatus probe_(bool *changed);
+
+  /**
+   * Return true if the bounds of v are implied by the equality c and the
+   * bounds of the other variables in c.
+   */
+  bool isImplFree_(VariablePtr v, ConstraintPtr c);
+
   void purgeVars_(PreModQ *pre_mods);
 
   /**
@@ -236,8 +318,18 @@ protected:
    */
   void relax_(ProblemPtr p, RelaxationPtr rel, bool *is_inf);
 
+  /// Return true if v1 and v2 have the same coefficients in all constraints.
+  bool sameCols_(VariablePtr v1, VariablePtr v2);
+
   void substVars_(bool *changed, PreModQ *pre_mods);
 
+  /**
+   * \brief Make prop_ agree with the relaxation: pass changes of bounds to
+   * it, add new constraints and reload changed ones. prop_ is created again
+   * if constraints were removed or variables were added.
+   */
+  void syncProp_(RelaxationPtr rel);
+
   /// Round the bounds
   void tightenInts_(ProblemPtr p, bool apply_to_prob, bool *changed, 
                     ModQ *mods);
@@ -0,0 +1,496 @@
+//
+//     MINOTAUR -- It's only 1/2 bull
+//
+//     (C)opyright 2008 - 2014 The MINOTAUR Team.
+//
+
+/**
+ * \file MipStart.cpp
+ * \brief Define the MipStart heuristic that completes and repairs
+ * user-provided starting solutions.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+
+#include "MinotaurConfig.h"
+#include "Constraint.h"
+#include "Engine.h"
+#include "Environment.h"
+#include "Logger.h"
+#include "MipStart.h"
+#include "Option.h"
+#include "Problem.h"
+#include "Relaxation.h"
+#include "Solution.h"
+#include "SolutionPool.h"
+#include "Timer.h"
+#include "Variable.h"
+
+using namespace Minotaur;
+
+const std::string MipStart::me_ = "MIP start: ";
+
+MipStart::MipStart(EnvPtr env, ProblemPtr p, EnginePtr e)
+: e_(e),
+  env_(env),
+  feasTol_(1e-6),
+  p_(p),
+  timer_(0)
+{
+  OptionDBPtr options = env->getOptions();
+  std::string files = options->findString("mipstart_file")->getValue();
+  std::string fname;
+  const double *x0;
+
+  intTol_ = options->findDouble("int_tol")->getValue();
+  logger_ = (LoggerPtr) new Logger((LogLevel) options->
+                                   findInt("heur_log_level")->getValue());
+  rinsNlps_ = (UInt) std::max(0, options->findInt("mipstart_rins_nlps")
+                              ->getValue());
+  timer_ = env_->getNewTimer();
+
+  stats_.starts = 0;
+  stats_.completed = 0;
+  stats_.repaired = 0;
+  stats_.failed = 0;
+  stats_.nlps = 0;
+  stats_.rinsSols = 0;
+  stats_.time = 0.0;
+
+  // several files may be given, separated by commas or spaces.
+  for (std::string::iterator it=files.begin(); it!=files.end(); ++it) {
+    if (',' == *it) {
+      *it = ' ';
+    }
+  }
+  std::istringstream iss(files);
+  while (iss >> fname) {
+    readFile(fname);
+  }
+
+  x0 = p_->getInitialPoint();
+  if (x0 && true==options->findBool("mipstart_use_x0")->getValue()) {
+    addStart(DoubleVector(x0, x0+p_->getNumVars()));
+  }
+}
+
+
+MipStart::~MipStart()
+{
+  if (timer_) {
+    delete timer_;
+  }
+  starts_.clear();
+}
+
+
+void MipStart::addStart(const DoubleVector &x)
+{
+  if (x.size() != p_->getNumVars()) {
+    logger_->msgStream(LogError) << me_ << "start has " << x.size()
+      << " values, problem has " << p_->getNumVars() << " variables."
+      << " Ignoring it." << std::endl;
+    return;
+  }
+  starts_.push_back(x);
+}
+
+
+bool MipStart::addSol_(EngineStatus status, SolutionPoolPtr s_pool)
+{
+  ConstSolutionPtr sol = e_->getSolution();
+
+  if (ProvenOptimal!=status && ProvenLocalOptimal!=status &&
+      false==isFeasible_(sol->getPrimal())) {
+    logger_->msgStream(LogDebug) << me_ << "solution with engine status "
+      << e_->getStatusString() << " is not feasible" << std::endl;
+    return false;
+  }
+  s_pool->addSolution(sol);
+  return true;
+}
+
+
+bool MipStart::complete_(const double *x, SolutionPoolPtr s_pool)
+{
+  EngineStatus status = solveRel_(x);
+  ConstSolutionPtr sol;
+  DoubleVector z;
+
+  if (false==isFeasStatus_(status)) {
+    return false;
+  }
+  sol = e_->getSolution();
+  if (0==numFrac_(sol->getPrimal()) && true==addSol_(status, s_pool)) {
+    return true;
+  }
+
+  // round and fix the fractional ones too.
+  z.assign(sol->getPrimal(), sol->getPrimal()+p_->getNumVars());
+  for (VariableConstIterator it=p_->varsBegin(); it!=p_->varsEnd(); ++it) {
+    if ((*it)->getType()==Binary || (*it)->getType()==Integer) {
+      fixInt_(*it, z[(*it)->getIndex()]);
+    }
+  }
+  status = solveRel_(&z[0]);
+  return (true==isFeasStatus_(status) && true==addSol_(status, s_pool));
+}
+
+
+MipStartPtr MipStart::create(EnvPtr env, ProblemPtr p, RelaxationPtr rel,
+                             EnginePtr e)
+{
+  OptionDBPtr options = env->getOptions();
+
+  if (options->findString("mipstart_file")->getValue()=="" &&
+      false==options->findBool("mipstart_use_x0")->getValue()) {
+    return MipStartPtr(); // NULL
+  }
+  if (true==options->findBool("use_native_cgraph")->getValue() ||
+      rel->isQP() || rel->isQuadratic()) {
+    p->setNativeDer();
+  }
+  return (MipStartPtr) new MipStart(env, p, e->emptyCopy());
+}
+
+
+void MipStart::fixInt_(VariablePtr v, double x)
+{
+  x = floor(x+0.5);
+  x = std::max(std::min(x, floor(v->getUb()+intTol_)),
+               ceil(v->getLb()-intTol_));
+  p_->changeBound(v, x, x);
+}
+
+
+UInt MipStart::getNumStarts() const
+{
+  return starts_.size();
+}
+
+
+const DoubleVector & MipStart::getStart(UInt i) const
+{
+  return starts_[i];
+}
+
+
+bool MipStart::isFeasible_(const double *x) const
+{
+  VariablePtr v;
+  double act;
+  int err = 0;
+
+  for (VariableConstIterator it=p_->varsBegin(); it!=p_->varsEnd(); ++it) {
+    v = *it;
+    if (x[v->getIndex()]<v->getLb()-feasTol_ ||
+        x[v->getIndex()]>v->getUb()+feasTol_) {
+      return false;
+    }
+    if ((Binary==v->getType() || Integer==v->getType()) &&
+        fabs(x[v->getIndex()]-floor(x[v->getIndex()]+0.5))>intTol_) {
+      return false;
+    }
+  }
+  for (ConstraintConstIterator it=p_->consBegin(); it!=p_->consEnd(); ++it) {
+    if (DeletedCons==(*it)->getState()) {
+      continue;
+    }
+    act = (*it)->getActivity(x, &err);
+    if (err ||
+        act<(*it)->getLb()-feasTol_*std::max(1.0, fabs((*it)->getLb())) ||
+        act>(*it)->getUb()+feasTol_*std::max(1.0, fabs((*it)->getUb()))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+
+bool MipStart::isFeasStatus_(EngineStatus status) const
+{
+  return (ProvenOptimal==status || ProvenLocalOptimal==status ||
+          ProvenFailedCQFeas==status || FailedFeas==status);
+}
+
+
+UInt MipStart::numFrac_(const double *x) const
+{
+  UInt nfrac = 0;
+  for (VariableConstIterator it=p_->varsBegin(); it!=p_->varsEnd(); ++it) {
+    if (((*it)->getType()==Binary || (*it)->getType()==Integer) &&
+        fabs(x[(*it)->getIndex()]-floor(x[(*it)->getIndex()]+0.5))>intTol_) {
+      ++nfrac;
+    }
+  }
+  return nfrac;
+}
+
+
+bool MipStart::readFile(std::string fname)
+{
+  std::ifstream in(fname.c_str());
+  std::map<std::string, UInt> index;
+  std::map<std::string, UInt>::iterator mit;
+  std::string line, name;
+  DoubleVector x(p_->getNumVars(), NAN);
+  UInt given = 0;
+  UInt unknown = 0;
+  double val;
+
+  if (!in.is_open()) {
+    logger_->msgStream(LogError) << me_ << "unable to open file " << fname
+      << std::endl;
+    return false;
+  }
+
+  for (VariableConstIterator it=p_->varsBegin(); it!=p_->varsEnd(); ++it) {
+    index[(*it)->getName()] = (*it)->getIndex();
+  }
+
+  while (std::getline(in, line)) {
+    std::istringstream iss(line);
+    if (!(iss >> name) || '#'==name[0]) {
+      continue;
+    }
+    if (!(iss >> val)) {
+      logger_->msgStream(LogInfo) << me_ << fname << ": ignoring line \""
+        << line << "\"" << std::endl;
+      continue;
+    }
+    mit = index.find(name);
+    if (mit == index.end()) {
+      // variables removed by presolve are not in the problem.
+      logger_->msgStream(LogDebug) << me_ << fname << ": unknown variable "
+        << name << std::endl;
+      ++unknown;
+      continue;
+    }
+    if (std::isnan(x[mit->second])) {
+      ++given;
+    }
+    x[mit->second] = val;
+  }
+  in.close();
+
+  logger_->msgStream(LogInfo) << me_ << fname << ": values of " << given
+    << " of " << p_->getNumVars() << " variables read, " << unknown
+    << " unknown." << std::endl;
+  if (0==given) {
+    return false;
+  }
+  starts_.push_back(x);
+  return true;
+}
+
+
+void MipStart::restoreBounds_()
+{
+  for (UInt i=0; i<lb_.size(); ++i) {
+    p_->changeBound(i, lb_[i], ub_[i]);
+  }
+}
+
+
+void MipStart::rinsDive_(SolutionPoolPtr s_pool)
+{
+  ConstSolutionPtr sol = s_pool->getBestSolution();
+  const UInt n = p_->getNumVars();
+  DoubleVector inc, r;
+  EngineStatus status;
+  VariablePtr v, best;
+  double d, best_d;
+
+  inc.assign(sol->getPrimal(), sol->getPrimal()+n);
+  status = solveRel_(&inc[0]);
+  if (false==isFeasStatus_(status)) {
+    return;
+  }
+  r.assign(e_->getSolution()->getPrimal(),
+           e_->getSolution()->getPrimal()+n);
+  for (VariableConstIterator it=p_->varsBegin(); it!=p_->varsEnd(); ++it) {
+    v = *it;
+    if ((v->getType()==Binary || v->getType()==Integer) &&
+        fabs(r[v->getIndex()]-inc[v->getIndex()])<=intTol_) {
+      fixInt_(v, inc[v->getIndex()]);
+    }
+  }
+
+  for (UInt k=1; k<rinsNlps_; ++k) {
+    status = solveRel_(&r[0]);
+    if (false==isFeasStatus_(status)) {
+      break;
+    }
+    sol = e_->getSolution();
+    if (0==numFrac_(sol->getPrimal())) {
+      if (sol->getObjValue() < s_pool->getBestSolutionValue() - 1e-6 &&
+          true==addSol_(status, s_pool)) {
+        logger_->msgStream(LogInfo) << me_ << "neighbourhood dive found "
+          << "solution with value " << sol->getObjValue() << std::endl;
+        ++stats_.rinsSols;
+      }
+      break;
+    }
+
+    // fix the fractional variable nearest to an integer.
+    r.assign(sol->getPrimal(), sol->getPrimal()+n);
+    best.reset();
+    best_d = INFINITY;
+    for (VariableConstIterator it=p_->varsBegin(); it!=p_->varsEnd(); ++it) {
+      v = *it;
+      if (v->getType()==Binary || v->getType()==Integer) {
+        d = fabs(r[v->getIndex()]-floor(r[v->getIndex()]+0.5));
+        if (d>intTol_ && d<best_d) {
+          best_d = d;
+          best = v;
+        }
+      }
+    }
+    fixInt_(best, r[best->getIndex()]);
+  }
+}
+
+
+void MipStart::solve(NodePtr, RelaxationPtr, SolutionPoolPtr s_pool)
+{
+  const UInt n = p_->getNumVars();
+  DoubleVector x0;
+
+  if (starts_.empty()) {
+    return;
+  }
+  timer_->start();
+  if (p_->getInitialPoint()) {
+    x0.assign(p_->getInitialPoint(), p_->getInitialPoint()+n);
+  }
+  lb_.resize(n);
+  ub_.resize(n);
+  for (UInt i=0; i<n; ++i) {
+    lb_[i] = p_->getVariable(i)->getLb();
+    ub_[i] = p_->getVariable(i)->getUb();
+  }
+
+  e_->clear();
+  e_->load(p_);
+  for (UInt i=0; i<starts_.size(); ++i) {
+    if (tryStart_(starts_[i], s_pool)) {
+      logger_->msgStream(LogInfo) << me_ << "start " << i
+        << " gives solution with value " << std::setprecision(8)
+        << s_pool->getBestSolutionValue() << std::endl;
+    } else {
+      logger_->msgStream(LogInfo) << me_ << "no solution found from start "
+        << i << std::endl;
+    }
+  }
+  if (rinsNlps_>0 && s_pool->getNumSols()>0) {
+    rinsDive_(s_pool);
+    restoreBounds_();
+  }
+  e_->clear();
+
+  // other heuristics may use the initial point of the problem.
+  if (!x0.empty()) {
+    p_->setInitialPoint(&x0[0]);
+  }
+  stats_.time += timer_->query();
+  timer_->stop();
+}
+
+
+EngineStatus MipStart::solveRel_(const double *x)
+{
+  p_->setInitialPoint(x);
+  ++stats_.nlps;
+  return e_->solve();
+}
+
+
+bool MipStart::tryStart_(const DoubleVector &x, SolutionPoolPtr s_pool)
+{
+  const UInt n = p_->getNumVars();
+  const double *x0 = p_->getInitialPoint();
+  DoubleVector y(n);
+  ConstSolutionPtr sol;
+  VariablePtr v;
+  bool found = false;
+
+  ++stats_.starts;
+  for (UInt i=0; i<n; ++i) {
+    v = p_->getVariable(i);
+    if (std::isnan(x[i])) {
+      y[i] = x0 ? x0[i] : 0.0;
+    } else {
+      y[i] = x[i];
+      if (v->getType()==Binary || v->getType()==Integer) {
+        fixInt_(v, x[i]);
+        y[i] = v->getLb();
+      }
+    }
+    y[i] = std::max(std::min(y[i], v->getUb()), v->getLb());
+  }
+
+  if (complete_(&y[0], s_pool)) {
+    ++stats_.completed;
+    found = true;
+  } else {
+    // repair: keep only the integers on which the start and the relaxation
+    // agree.
+    restoreBounds_();
+    if (isFeasStatus_(solveRel_(&y[0]))) {
+      sol = e_->getSolution();
+      y.assign(sol->getPrimal(), sol->getPrimal()+n);
+      for (UInt i=0; i<n; ++i) {
+        v = p_->getVariable(i);
+        if ((v->getType()==Binary || v->getType()==Integer) &&
+            !std::isnan(x[i]) && fabs(y[i]-floor(x[i]+0.5))<=intTol_) {
+          fixInt_(v, x[i]);
+        }
+      }
+      if (complete_(&y[0], s_pool)) {
+        ++stats_.repaired;
+        found = true;
+      }
+    }
+  }
+  if (!found) {
+    ++stats_.failed;
+  }
+  restoreBounds_();
+  return found;
+}
+
+
+void MipStart::writeStats(std::ostream &out) const
+{
+  out << me_ << "number of starts tried          = " << stats_.starts
+    << std::endl
+    << me_ << "number of starts completed      = " << stats_.completed
+    << std::endl
+    << me_ << "number of starts repaired       = " << stats_.repaired
+    << std::endl
+    << me_ << "number of starts failed         = " << stats_.failed
+    << std::endl
+    << me_ << "number of relaxations solved    = " << stats_.nlps
+    << std::endl
+    << me_ << "solutions from neighbourhood    = " << stats_.rinsSols
+    << std::endl
+    << me_ << "time taken                      = " << stats_.time
+    << std::endl;
+}
+
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
@@ -0,0 +1,208 @@
+//
+//     MINOTAUR -- It's only 1/2 bull
+//
+//     (C)opyright 2008 - 2014 The MINOTAUR Team.
+//
+
+/**
+ * \file MipStart.h
+ * \brief Declare the MipStart heuristic that completes and repairs
+ * user-provided starting solutions.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#ifndef MINOTAURMIPSTART_H
+#define MINOTAURMIPSTART_H
+
+#include "Heuristic.h"
+
+namespace Minotaur {
+
+  class Engine;
+  class MipStart;
+  class Problem;
+  class Timer;
+  typedef boost::shared_ptr<Engine> EnginePtr;
+  typedef boost::shared_ptr<MipStart> MipStartPtr;
+  typedef boost::shared_ptr<Problem> ProblemPtr;
+
+
+  /// Statistics for the MipStart heuristic.
+  struct MipStartStats {
+    UInt starts;    ///< Number of starts tried.
+    UInt completed; ///< Starts that were feasible after fixing integers.
+    UInt repaired;  ///< Starts that needed repair.
+    UInt failed;    ///< Starts for which no solution was found.
+    UInt nlps;      ///< Number of relaxations solved.
+    UInt rinsSols;  ///< Solutions found by the neighbourhood dive.
+    double time;    ///< Total time taken.
+  };
+
+
+  /**
+   * \brief Heuristic that turns starting solutions, e.g. the solution of a
+   * similar instance solved earlier, into an incumbent before the root.
+   *
+   * A start may be partial: values of some variables may be missing. For
+   * each start, the integer variables whose values are given are fixed to
+   * the rounded values and the continuous relaxation is solved to complete
+   * the start. If its solution is fractional in the remaining integer
+   * variables, they are rounded and fixed, and the relaxation is solved
+   * again. If the fixed relaxation is infeasible, the start is repaired:
+   * the relaxation is solved with all integers free and only the integer
+   * variables on which the start and this solution agree are kept fixed.
+   *
+   * Optionally, a dive in the neighbourhood of the best solution is done
+   * after the starts: integer variables whose values in the incumbent and
+   * in the solution of the relaxation agree are fixed (as in RINS), and
+   * then the remaining fractional variable that is nearest to an integer is
+   * fixed, one at a time.
+   *
+   * Starts are read from the files in the option mipstart_file. Each line
+   * of a file has the name of a variable and its value. Lines starting
+   * with '#' are ignored.
+   */
+  class MipStart : public Heuristic {
+
+    public:
+      /// Constructor. Starts in files given in options are read.
+      MipStart(EnvPtr env, ProblemPtr p, EnginePtr e);
+
+      /// Destroy.
+      ~MipStart();
+
+      /**
+       * \brief Add a start. x must have a value for each variable of the
+       * problem. Missing values are NaN.
+       */
+      void addStart(const DoubleVector &x);
+
+      /**
+       * \brief Create the heuristic for p if options mipstart_file or
+       * mipstart_use_x0 ask for it, as the drivers do before the root.
+       *
+       * \param[in] env The environment.
+       * \param[in] p The problem. Native derivatives are set for it if
+       * option use_native_cgraph is set or if rel is a QP or quadratic.
+       * \param[in] rel The relaxation of p.
+       * \param[in] e The engine of rel. An empty copy of it is used.
+       * \return The heuristic, or NULL if no starts are asked for.
+       */
+      static MipStartPtr create(EnvPtr env, ProblemPtr p, RelaxationPtr rel,
+                                EnginePtr e);
+
+      /// Return the number of starts added so far.
+      UInt getNumStarts() const;
+
+      /// Return the i-th start.
+      const DoubleVector & getStart(UInt i) const;
+
+      /**
+       * \brief Read a start from a file.
+       *
+       * \param[in] fname The name of the file.
+       * \return False if the file can not be opened or has no values.
+       */
+      bool readFile(std::string fname);
+
+      /// Try all starts and add the solutions found to s_pool.
+      void solve(NodePtr node, RelaxationPtr rel, SolutionPoolPtr s_pool);
+
+      /// Write statistics to out.
+      void writeStats(std::ostream &out) const;
+
+    private:
+      /// Engine used to solve the relaxations.
+      EnginePtr e_;
+
+      /// Environment.
+      EnvPtr env_;
+
+      /// Tolerance for checking bounds and constraints of a solution.
+      const double feasTol_;
+
+      /// Tolerance for checking integrality.
+      double intTol_;
+
+      /// Log.
+      LoggerPtr logger_;
+
+      /// Lower bounds of variables before the heuristic changed them.
+      DoubleVector lb_;
+
+      /// For logging.
+      static const std::string me_;
+
+      /// Problem that is being solved.
+      ProblemPtr p_;
+
+      /// Maximum number of relaxations solved in the neighbourhood dive.
+      UInt rinsNlps_;
+
+      /// The starts. Missing values are NaN.
+      std::vector<DoubleVector> starts_;
+
+      /// Statistics.
+      MipStartStats stats_;
+
+      /// Timer.
+      Timer *timer_;
+
+      /// Upper bounds of variables before the heuristic changed them.
+      DoubleVector ub_;
+
+      /**
+       * Add the solution of the engine to s_pool. If status does not prove
+       * that it is optimal, it is added only if it is feasible for p_.
+       * Return true if it is added.
+       */
+      bool addSol_(EngineStatus status, SolutionPoolPtr s_pool);
+
+      /**
+       * Solve the relaxation with the current bounds from the point x. If
+       * the solution is fractional, fix all integer variables to rounded
+       * values and solve again. Return true and add the solution to s_pool
+       * if a feasible solution is found.
+       */
+      bool complete_(const double *x, SolutionPoolPtr s_pool);
+
+      /// Fix the integer variable v to the value of x rounded to its bounds.
+      void fixInt_(VariablePtr v, double x);
+
+      /**
+       * Return true if x satisfies the bounds, the integrality of integer
+       * variables and the constraints of p_.
+       */
+      bool isFeasible_(const double *x) const;
+
+      /// Return true if status means that a feasible point may be found.
+      bool isFeasStatus_(EngineStatus status) const;
+
+      /// Return the number of integer variables fractional in x.
+      UInt numFrac_(const double *x) const;
+
+      /// Restore the bounds saved in lb_ and ub_.
+      void restoreBounds_();
+
+      /// Dive in the neighbourhood of the best solution in s_pool.
+      void rinsDive_(SolutionPoolPtr s_pool);
+
+      /// Solve the relaxation from the point x. Return the status.
+      EngineStatus solveRel_(const double *x);
+
+      /// Try the start x. Return true if a solution was added to s_pool.
+      bool tryStart_(const DoubleVector &x, SolutionPoolPtr s_pool);
+  };
+}
+#endif
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
@@ -31,6 +31,7 @@
 #include "Option.h"
 #include "PreAuxVars.h"
 #include "ProblemSize.h"
+#include "PropEngine.h"
 #include "Relaxation.h"
 #include "SolutionPool.h"
 #include "Timer.h"
@@ -47,6 +48,7 @@ NlPresHandler::NlPresHandler()
     eTol_(1e-6),
     logger_(LoggerPtr()),
     p_(ProblemPtr()),
+    propEngine_(false),
     zTol_(1e-6)
 {
   stats_.cBnd = 0;
@@ -73,6 +75,7 @@ NlPresHandler::NlPresHandler(EnvPtr env, ProblemPtr p)
                                               getValue()));
   doPersp_ = env->getOptions()->findBool("persp_ref")->getValue();
   doQuadCone_ = env->getOptions()->findBool("quad_cone_ref")->getValue();
+  propEngine_ = env->getOptions()->findBool("prop_engine")->getValue();
   stats_.cBnd = 0;
   stats_.cImp = 0;
   stats_.conDel = 0;
@@ -899,6 +902,23 @@ SolveStatus NlPresHandler::varBndsFromCons_(bool *changed)
   VarBoundModVector mods;
   SolveStatus status = Started;
 
+  if (propEngine_) {
+    PropEngine engine(p_);
+    ModVector emods;
+
+    engine.setTols(eTol_, 0.0);
+    engine.addPropagator((PropagatorPtr) new NlPropagator(p_));
+    engine.init();
+    if (engine.propagate(&emods, 0)) {
+      status = SolvedInfeasible;
+    }
+    stats_.vBnd += emods.size();
+    if (false==emods.empty()) {
+      *changed = true;
+    }
+    return status;
+  }
+
   for (ConstraintConstIterator cit=p_->consBegin(); cit!=p_->consEnd();
        ++cit) {
     c = *cit;
@@ -937,6 +957,76 @@ SolveStatus NlPresHandler::varBndsFromCons_(bool *changed)
 }
 
 
+NlPropagator::NlPropagator(ProblemPtr p)
+{
+  ConstraintPtr c;
+  for (ConstraintConstIterator it=p->consBegin(); it!=p->consEnd(); ++it) {
+    c = *it;
+    if (c->getFunctionType()!=Linear && c->getFunctionType()!=Constant &&
+        c->getFunction()->getNonlinearFunction()) {
+      cons_.push_back(c);
+    }
+  }
+}
+
+
+NlPropagator::~NlPropagator()
+{
+  cons_.clear();
+}
+
+
+std::string NlPropagator::getName() const
+{
+  return "NlPropagator";
+}
+
+
+void NlPropagator::getVars(UInt i, VarVector &vars) const
+{
+  FunctionPtr f = cons_[i]->getFunction();
+  for (VarSetConstIterator it=f->varsBegin(); it!=f->varsEnd(); ++it) {
+    vars.push_back(*it);
+  }
+}
+
+
+bool NlPropagator::propagate(UInt i, PropEngine *engine)
+{
+  ConstraintPtr c = cons_[i];
+  LinearFunctionPtr lf = c->getFunction()->getLinearFunction();
+  NonlinearFunctionPtr nlf = c->getFunction()->getNonlinearFunction();
+  double lfl = 0.0, lfu = 0.0;
+  VarBoundModVector mods;
+  SolveStatus status = Started;
+  int err;
+
+  if (DeletedCons==c->getState()) {
+    return false;
+  }
+  if (lf) {
+    lf->computeBounds(&lfl, &lfu);
+  }
+  nlf->varBoundMods(c->getLb()-lfu, c->getUb()-lfl, mods, &status);
+  if (SolvedInfeasible==status) {
+    return true;
+  } else if (SolveError==status) {
+    return false;
+  }
+  for (VarBoundModVector::iterator it=mods.begin(); it!=mods.end(); ++it) {
+    if (Lower==(*it)->getLU()) {
+      err = engine->tighten((*it)->getVar(), (*it)->getNewVal(), INFINITY);
+    } else {
+      err = engine->tighten((*it)->getVar(), -INFINITY, (*it)->getNewVal());
+    }
+    if (err < 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+
 void NlPresHandler::writePreStats(std::ostream &out) const
 {
   out << me_ << "Statistics for presolve by NlPresHandler:"        << std::endl
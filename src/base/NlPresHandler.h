@@ -14,6 +14,7 @@
 #define MINOTAURNLPRESHANDLER_H
 
 #include "Handler.h"
+#include "Propagator.h"
 
 namespace Minotaur {
 
@@ -50,6 +51,41 @@ struct NlPresOpts {
 }; 
 
 
+/**
+ * \brief Let a PropEngine tighten bounds using nonlinear constraints.
+ *
+ * Each constraint is an item. Bounds on the nonlinear part are found from
+ * the bounds of the constraint and of its linear part, and passed down the
+ * computational graph (CNode::propBounds) by
+ * NonlinearFunction::varBoundMods(). The new bounds of variables are then
+ * sent to the engine.
+ */
+class NlPropagator : public Propagator {
+public:
+  /// Constructor. All nonlinear constraints of p are added as items.
+  NlPropagator(ProblemPtr p);
+
+  /// Destroy.
+  ~NlPropagator();
+
+  // base class method.
+  std::string getName() const;
+
+  // base class method.
+  UInt getNumItems() const { return cons_.size(); }
+
+  // base class method.
+  void getVars(UInt i, VarVector &vars) const;
+
+  // base class method.
+  bool propagate(UInt i, PropEngine *engine);
+
+private:
+  /// Nonlinear constraints.
+  ConstraintVector cons_;
+};
+
+
 /**
  * A NlPresHandler presolves nonlinear constraints. Experimental.
  */
@@ -142,6 +178,9 @@ private:
   /// Problem that will be presolved.
   ProblemPtr p_;
 
+  /// If true, propagate bounds with a PropEngine in varBndsFromCons_.
+  bool propEngine_;
+
   NlPresStats stats_;
 
   /// Tolerance for checking zero.
@@ -0,0 +1,1075 @@
+//
+//     MINOTAUR -- It's only 1/2 bull
+//
+//     (C)opyright 2008 - 2014 The MINOTAUR Team.
+//
+
+/**
+ * \file NlReader.cpp
+ * \brief Define the NlReader class that reads a problem from a .nl file
+ * without the AMPL Solver Library.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#if USE_OPENMP
+#include <omp.h>
+#endif
+
+#include "MinotaurConfig.h"
+#include "CGraph.h"
+#include "CNode.h"
+#include "Environment.h"
+#include "Function.h"
+#include "LinearFunction.h"
+#include "Logger.h"
+#include "NlReader.h"
+#include "Option.h"
+#include "Problem.h"
+#include "Timer.h"
+#include "Variable.h"
+
+using namespace Minotaur;
+
+const std::string NlReader::me_ = "NlReader: ";
+
+// Positions of the numbers of the header in NlReader::hdr_.
+enum {
+  NlNVar = 0, NlNCon, NlNObj, NlNRange, NlNEqn, NlNLcon,  // line 2
+  NlNlc, NlNlo,                                           // line 3
+  NlNlnc, NlLnc,                                          // line 4
+  NlNlvc, NlNlvo, NlNlvb,                                 // line 5
+  NlNwv, NlNFunc, NlArith, NlFlags,                       // line 6
+  NlNbv, NlNiv, NlNlvbi, NlNlvci, NlNlvoi,                // line 7
+  NlNzc, NlNzo,                                           // line 8
+  NlMaxRow, NlMaxCol,                                     // line 9
+  NlComb, NlComc, NlComo, NlComc1, NlComo1                // line 10
+};
+
+
+// Number of operands of operator k of the .nl format. 0 if the number
+// follows the operator, -1 if the operator is not supported.
+static int nlArity(int k)
+{
+  switch (k) {
+  case 0: case 1: case 2: case 3: case 5: case 55: case 76: case 78:
+    return 2;
+  case 13: case 14: case 15: case 16: case 37: case 38: case 39: case 40:
+  case 41: case 42: case 43: case 44: case 45: case 46: case 47: case 49:
+  case 50: case 51: case 52: case 53: case 77:
+    return 1;
+  case 54:
+    return 0;
+  default:
+    break;
+  }
+  return -1;
+}
+
+
+NlStream::NlStream(const char *beg, const char *end, bool binary)
+  : binary_(binary),
+    end_(end),
+    p_(beg)
+{
+}
+
+
+bool NlStream::atEnd()
+{
+  if (!binary_) {
+    skipSpace_();
+  }
+  return (p_>=end_);
+}
+
+
+char NlStream::getKey()
+{
+  if (!binary_) {
+    skipSpace_();
+  }
+  if (p_>=end_) {
+    return 0;
+  }
+  return *p_++;
+}
+
+
+bool NlStream::getInt(int *i)
+{
+  return getInt(i, 4);
+}
+
+
+bool NlStream::getInt(int *i, UInt w)
+{
+  bool neg = false;
+  const char *q;
+
+  if (binary_) {
+    if (p_+w>end_) {
+      return false;
+    }
+    if (2==w) {
+      short k;
+      memcpy(&k, p_, 2);
+      *i = k;
+    } else if (8==w) {
+      long long k;
+      memcpy(&k, p_, 8);
+      *i = (int) k;
+    } else {
+      memcpy(i, p_, 4);
+    }
+    p_ += w;
+    return true;
+  }
+
+  skipSpace_();
+  if (p_<end_ && ('-'==*p_ || '+'==*p_)) {
+    neg = ('-'==*p_);
+    ++p_;
+  }
+  q = p_;
+  *i = 0;
+  while (p_<end_ && isdigit(*p_)) {
+    *i = 10*(*i) + (*p_-'0');
+    ++p_;
+  }
+  if (neg) {
+    *i = -(*i);
+  }
+  return (p_>q);
+}
+
+
+bool NlStream::getReal(double *d)
+{
+  char buf[64];
+  char *e;
+  UInt k = 0;
+
+  if (binary_) {
+    if (p_+8>end_) {
+      return false;
+    }
+    memcpy(d, p_, 8);
+    p_ += 8;
+    return true;
+  }
+
+  skipSpace_();
+  while (p_<end_ && k<63 && !isspace(*p_) && '#'!=*p_) {
+    buf[k] = *p_;
+    ++k;
+    ++p_;
+  }
+  buf[k] = '\0';
+  *d = strtod(buf, &e);
+  return (k>0 && '\0'==*e);
+}
+
+
+bool NlStream::getString(std::string *s, bool counted)
+{
+  int len = 0;
+  const char *q;
+
+  if (binary_ || counted) {
+    if (!getInt(&len) || len<0) {
+      return false;
+    }
+    if (!binary_) {
+      if (p_>=end_ || ':'!=*p_) {
+        return false;
+      }
+      ++p_;
+    }
+    if (p_+len>end_) {
+      return false;
+    }
+    s->assign(p_, len);
+    p_ += len;
+    return true;
+  }
+
+  skipSpace_();
+  q = p_;
+  while (p_<end_ && !isspace(*p_) && '#'!=*p_) {
+    ++p_;
+  }
+  s->assign(q, p_-q);
+  return (p_>q);
+}
+
+
+void NlStream::skipSpace_()
+{
+  while (p_<end_) {
+    if ('#'==*p_) {
+      while (p_<end_ && '\n'!=*p_) {
+        ++p_;
+      }
+    } else if (isspace(*p_)) {
+      ++p_;
+    } else {
+      break;
+    }
+  }
+}
+
+
+NlReader::NlReader(EnvPtr env)
+  : binary_(false),
+    env_(env),
+    nDefs_(0),
+    time_(0.0)
+{
+  logger_ = env->getLogger();
+  nThreads_ = env->getOptions()->findInt("threads")->getValue();
+#if !(USE_OPENMP)
+  nThreads_ = 1;
+#endif
+  if (nThreads_<1) {
+    nThreads_ = 1;
+  }
+  memset(hdr_, 0, sizeof(hdr_));
+  segOff_[0] = segOff_[1] = segOff_[2] = 0;
+}
+
+
+NlReader::~NlReader()
+{
+  conOff_.clear();
+  defOff_.clear();
+  jacOff_.clear();
+  objGOff_.clear();
+  objOff_.clear();
+  vars_.clear();
+  x0_.clear();
+}
+
+
+bool NlReader::addFuns_(ProblemPtr p, const char *end)
+{
+  UInt m = hdr_[NlNCon];
+  UInt nlc = hdr_[NlNlc];
+  UInt nfuns = m + nDefs_ + hdr_[NlNObj];
+  std::vector<NlFun> funs(nfuns);
+  std::vector<DoubleVector> xs(nThreads_), grads(nThreads_);
+  std::vector<std::string> names;
+  DoubleVector lb(m, -INFINITY), ub(m, INFINITY);
+  QuadraticFunctionPtr qf = QuadraticFunctionPtr(); // NULL
+  FunctionPtr f;
+  NlStream s(segOff_[1], end, binary_);
+  std::string name;
+
+  if (m>0 && segOff_[1]) {
+    for (UInt i=0; i<m; ++i) {
+      if (!readBound_(&s, &(lb[i]), &(ub[i]))) {
+        logger_->errStream() << me_ << "bad bounds of constraint " << i
+                             << std::endl;
+        return false;
+      }
+    }
+  }
+
+  // constraints, definitions of defined variables and the objective are
+  // independent of each other once all variables exist.
+#if USE_OPENMP
+#pragma omp parallel for num_threads(nThreads_) schedule(dynamic, 64)
+#endif
+  for (int t=0; t<(int) nfuns; ++t) {
+    int tid = 0;
+    UInt i = t;
+#if USE_OPENMP
+    tid = omp_get_thread_num();
+#endif
+    if (i<m) {
+      parseFun_(jacOff_[i], conOff_[i], end, false, &(funs[i]),
+                &(xs[tid]), &(grads[tid]));
+    } else if (i<m+nDefs_) {
+      parseFun_(defOff_[i-m], 0, end, true, &(funs[i]), &(xs[tid]),
+                &(grads[tid]));
+    } else {
+      i -= m+nDefs_;
+      parseFun_(objGOff_[i], objOff_[i], end, false, &(funs[t]),
+                &(xs[tid]), &(grads[tid]));
+    }
+  }
+
+  for (UInt i=0; i<nfuns; ++i) {
+    if (funs[i].err) {
+      logger_->errStream() << me_ << "can not parse "
+                           << ((i<m) ? "constraint " : (i<m+nDefs_) ?
+                               "defined variable " : "objective ")
+                           << ((i<m) ? i : (i<m+nDefs_) ? i-m : i-m-nDefs_)
+                           << std::endl;
+      return false;
+    }
+  }
+
+  // same order as AMPLInterface: nonlinear constraints, definitions of
+  // defined variables and then linear constraints.
+  readNames_(stub_, ".row", &names);
+  for (UInt k=0; k<m+nDefs_; ++k) {
+    UInt i = (k<nlc) ? k : (k<nlc+nDefs_) ? m+k-nlc : k-nDefs_;
+    NlFun &fun = funs[i];
+
+    f = (FunctionPtr) new Function(fun.lf, qf, fun.cg);
+    if (i<m) {
+      if (i<names.size()) {
+        name = names[i];
+      } else {
+        std::stringstream name_stream;
+        name_stream << "_scon[" << i+1 << "]";
+        name = name_stream.str();
+      }
+      p->newConstraint(f, lb[i]-fun.c, ub[i]-fun.c, name);
+    } else {
+      // lf + nlf + c - defvar = 0.
+      p->newConstraint(f, -fun.c, -fun.c);
+    }
+    fun.lf.reset();
+    fun.cg.reset();
+  }
+
+  if (hdr_[NlNObj]>0) {
+    NlFun &fun = funs[m+nDefs_];
+
+    f = (FunctionPtr) new Function(fun.lf, qf, fun.cg);
+    if (m<names.size()) {
+      name = names[m];
+    } else {
+      name = "_sobj[1]";
+    }
+    p->newObjective(f, fun.c, (1==objSense_[0]) ? Maximize : Minimize,
+                    name);
+  }
+  return true;
+}
+
+
+bool NlReader::addVars_(ProblemPtr p, const char *end)
+{
+  int n = hdr_[NlNVar];
+  int k, m;
+  double lb = -INFINITY, ub = INFINITY, d;
+  std::vector<std::string> names;
+  NlStream s(segOff_[0], end, binary_);
+  std::string name;
+
+  readNames_(stub_, ".col", &names);
+  vars_.reserve(n+nDefs_);
+  for (int i=0; i<n; ++i) {
+    if (segOff_[0] && !readBound_(&s, &lb, &ub)) {
+      logger_->errStream() << me_ << "bad bounds of variable " << i
+                           << std::endl;
+      return false;
+    }
+    if (i<(int) names.size()) {
+      name = names[i];
+    } else {
+      std::stringstream name_stream;
+      name_stream << "_svar[" << i+1 << "]";
+      name = name_stream.str();
+    }
+    vars_.push_back(p->newVariable(lb, ub, getVarType_(i), name));
+  }
+
+  for (UInt i=0; i<nDefs_; ++i) {
+    std::stringstream name_stream;
+    name_stream << "defvar" << i;
+    vars_.push_back(p->newVariable(-INFINITY, INFINITY, Continuous,
+                                   name_stream.str()));
+  }
+
+  x0_.assign(n, 0.0);
+  if (segOff_[2]) {
+    s.setPos(segOff_[2]);
+    s.getInt(&m);
+    for (int i=0; i<m; ++i) {
+      if (!s.getInt(&k) || !s.getReal(&d) || k<0 || k>=n) {
+        logger_->errStream() << me_ << "bad initial point" << std::endl;
+        return false;
+      }
+      x0_[k] = d;
+    }
+  }
+  return true;
+}
+
+
+ProblemPtr NlReader::build_(const char *beg, const char *end,
+                            std::string stub)
+{
+  ProblemPtr p;
+  const char *body = readHeader_(beg, end);
+
+  if (!body) {
+    logger_->errStream() << me_ << "bad header in " << stub << std::endl;
+    return ProblemPtr();
+  } else if (hdr_[NlNwv]>0 || hdr_[NlNlnc]>0 || hdr_[NlLnc]>0) {
+    logger_->errStream() << me_ << "network constraints are not supported."
+                         << std::endl;
+    return ProblemPtr();
+  } else if (hdr_[NlNFunc]>0) {
+    logger_->errStream() << me_ << "imported functions are not supported."
+                         << std::endl;
+    return ProblemPtr();
+  } else if (hdr_[NlNLcon]>0) {
+    logger_->errStream() << me_ << "logical constraints are not supported."
+                         << std::endl;
+    return ProblemPtr();
+  } else if (hdr_[NlNObj]>1) {
+    logger_->errStream() << me_ << "only one objective is supported."
+                         << std::endl;
+    return ProblemPtr();
+  }
+  stub_ = stub;
+  nDefs_ = hdr_[NlComb] + hdr_[NlComc] + hdr_[NlComo] + hdr_[NlComc1]
+    + hdr_[NlComo1];
+
+  if (!indexSegs_(NlStream(body, end, binary_))) {
+    return ProblemPtr();
+  }
+
+  p = (ProblemPtr) new Problem();
+  vars_.clear();
+  if (!addVars_(p, end) || !addFuns_(p, end)) {
+    vars_.clear();
+    return ProblemPtr();
+  }
+  vars_.clear();
+  return p;
+}
+
+
+const double * NlReader::getInitialPoint() const
+{
+  if (x0_.empty()) {
+    return 0;
+  }
+  return &(x0_[0]);
+}
+
+
+VariableType NlReader::getVarType_(int i) const
+{
+  int n = hdr_[NlNVar];
+
+  // see AMPLInterface::addVariablesFromASL_() for the order of variables.
+  if (i<hdr_[NlNlvb]) {
+    return (i>=hdr_[NlNlvb]-hdr_[NlNlvbi]) ? Integer : Continuous;
+  } else if (i<hdr_[NlNlvc]) {
+    return (i>=hdr_[NlNlvc]-hdr_[NlNlvci]) ? Integer : Continuous;
+  } else if (hdr_[NlNlvo]>hdr_[NlNlvc] && i<hdr_[NlNlvo]) {
+    return (i>=hdr_[NlNlvo]-hdr_[NlNlvoi]) ? Integer : Continuous;
+  } else if (i>=n-hdr_[NlNiv]) {
+    return Integer;
+  } else if (i>=n-hdr_[NlNiv]-hdr_[NlNbv]) {
+    return Binary;
+  }
+  return Continuous;
+}
+
+
+bool NlReader::indexSegs_(NlStream s)
+{
+  int i, j, k, n;
+  UInt w;
+  double d;
+  char key = 0;
+  const char *pos;
+  std::string name;
+  bool ok = true;
+  UInt nsuf = 0;
+
+  conOff_.assign(hdr_[NlNCon], (const char *) 0);
+  jacOff_.assign(hdr_[NlNCon], (const char *) 0);
+  objOff_.assign(hdr_[NlNObj], (const char *) 0);
+  objGOff_.assign(hdr_[NlNObj], (const char *) 0);
+  objSense_.assign(hdr_[NlNObj], 0);
+  defOff_.assign(nDefs_, (const char *) 0);
+  segOff_[0] = segOff_[1] = segOff_[2] = 0;
+
+  while (ok && !s.atEnd()) {
+    key = s.getKey();
+    pos = s.getPos();
+    switch (key) {
+    case 'C':
+      ok = s.getInt(&i) && i>=0 && i<hdr_[NlNCon];
+      if (ok) {
+        conOff_[i] = s.getPos();
+        ok = skipExpr_(&s);
+      }
+      break;
+    case 'O':
+      ok = s.getInt(&i) && s.getInt(&j) && i>=0 && i<hdr_[NlNObj];
+      if (ok) {
+        objOff_[i] = s.getPos();
+        objSense_[i] = j;
+        ok = skipExpr_(&s);
+      }
+      break;
+    case 'V':
+      ok = s.getInt(&i) && s.getInt(&j) && s.getInt(&k) &&
+        i>=hdr_[NlNVar] && i<hdr_[NlNVar]+(int) nDefs_;
+      if (ok) {
+        defOff_[i-hdr_[NlNVar]] = pos;
+        for (int t=0; ok && t<j; ++t) {
+          ok = s.getInt(&k) && s.getReal(&d);
+        }
+        ok = ok && skipExpr_(&s);
+      }
+      break;
+    case 'J':
+    case 'G':
+      ok = s.getInt(&i) && s.getInt(&j) && i>=0 &&
+        i<hdr_[('J'==key) ? NlNCon : NlNObj];
+      if (ok) {
+        if ('J'==key) {
+          jacOff_[i] = pos;
+        } else {
+          objGOff_[i] = pos;
+        }
+        for (int t=0; ok && t<j; ++t) {
+          ok = s.getInt(&k) && s.getReal(&d);
+        }
+      }
+      break;
+    case 'b':
+    case 'r':
+      segOff_[('b'==key) ? 0 : 1] = pos;
+      n = hdr_[('b'==key) ? NlNVar : NlNCon];
+      for (int t=0; ok && t<n; ++t) {
+        ok = readBound_(&s, &d, &d);
+      }
+      break;
+    case 'x':
+    case 'd':
+      if ('x'==key) {
+        segOff_[2] = pos;
+      }
+      ok = s.getInt(&n);
+      for (int t=0; ok && t<n; ++t) {
+        ok = s.getInt(&k) && s.getReal(&d);
+      }
+      break;
+    case 'k':
+      // cumulative column counts, not needed. In the binary format they
+      // may be 4 or 8 bytes long. With the right length, the last count is
+      // at most the number of nonzeros and a segment follows.
+      ok = s.getInt(&n);
+      w = 4;
+      if (ok && binary_ && n>0) {
+        NlStream s2 = s;
+        s2.setPos(s.getPos()+4*(n-1));
+        if (!s2.getInt(&k) || k<0 || k>hdr_[NlNzc] ||
+            (!s2.atEnd() && !strchr("CGJOSVbdrx", s2.getKey()))) {
+          w = 8;
+        }
+      }
+      for (int t=0; ok && t<n; ++t) {
+        ok = s.getInt(&k, w);
+      }
+      break;
+    case 'S':
+      ok = s.getInt(&k) && s.getInt(&n) && s.getString(&name, false);
+      for (int t=0; ok && t<n; ++t) {
+        ok = s.getInt(&i) && ((k&4) ? s.getReal(&d) : s.getInt(&j));
+      }
+      ++nsuf;
+      break;
+    default:
+      unsupported_(key, -1);
+      return false;
+    }
+  }
+
+  if (!ok) {
+    logger_->errStream() << me_ << "can not read segment " << key
+                         << std::endl;
+    return false;
+  }
+  if (nsuf>0) {
+    logger_->msgStream(LogInfo) << me_ << "ignored " << nsuf
+                                << " suffixes." << std::endl;
+  }
+  return true;
+}
+
+
+CNode *NlReader::newOpNode_(CGraphPtr cg, int k, CNode **child, UInt n,
+                            int *err)
+{
+  CNode *l = (n>0) ? child[0] : 0;
+  CNode *r = (n>1) ? child[1] : 0;
+
+  switch (k) {
+  case 0:  return cg->newNode(OpPlus, l, r);
+  case 1:  return cg->newNode(OpMinus, l, r);
+  case 2:  return cg->newNode(OpMult, l, r);
+  case 3:  return cg->newNode(OpDiv, l, r);
+  case 5:
+    // ASL reads x^c, x^2 and c^x as separate operators.
+    if (OpNum==r->getOp() && 2.0==r->getVal()) {
+      return cg->newNode(OpSqr, l, 0);
+    } else if (OpNum==r->getOp()) {
+      return cg->newNode(OpPowK, l, r);
+    } else if (OpNum==l->getOp()) {
+      return cg->newNode(OpCPow, l, r);
+    }
+    return cg->newNode(OpPow, l, r);
+  case 13: return cg->newNode(OpFloor, l, 0);
+  case 14: return cg->newNode(OpCeil, l, 0);
+  case 15: return cg->newNode(OpAbs, l, 0);
+  case 16: return cg->newNode(OpUMinus, l, 0);
+  case 37: return cg->newNode(OpTanh, l, 0);
+  case 38: return cg->newNode(OpTan, l, 0);
+  case 39: return cg->newNode(OpSqrt, l, 0);
+  case 40: return cg->newNode(OpSinh, l, 0);
+  case 41: return cg->newNode(OpSin, l, 0);
+  case 42: return cg->newNode(OpLog10, l, 0);
+  case 43: return cg->newNode(OpLog, l, 0);
+  case 44: return cg->newNode(OpExp, l, 0);
+  case 45: return cg->newNode(OpCosh, l, 0);
+  case 46: return cg->newNode(OpCos, l, 0);
+  case 47: return cg->newNode(OpAtanh, l, 0);
+  case 49: return cg->newNode(OpAtan, l, 0);
+  case 50: return cg->newNode(OpAsinh, l, 0);
+  case 51: return cg->newNode(OpAsin, l, 0);
+  case 52: return cg->newNode(OpAcosh, l, 0);
+  case 53: return cg->newNode(OpAcos, l, 0);
+  case 54:
+    if (0==n) {
+      return cg->newNode(0.0);
+    } else if (1==n) {
+      return l;
+    }
+    return cg->newNode(OpSumList, child, n);
+  case 55: return cg->newNode(OpIntDiv, l, r);
+  case 76: return cg->newNode(OpPowK, l, r);
+  case 77: return cg->newNode(OpSqr, l, 0);
+  case 78: return cg->newNode(OpCPow, l, r);
+  default:
+    break;
+  }
+  *err = 1;
+  return 0;
+}
+
+
+CNode *NlReader::parseExpr_(NlStream *s, CGraphPtr cg, int *err)
+{
+  std::vector<CNode *> vals;
+  std::vector<int> ops, need, beg;
+  CNode *node;
+  double d;
+  int k, n;
+  char key;
+
+  // operators wait on a stack until all their operands are read.
+  for (;;) {
+    key = s->getKey();
+    node = 0;
+    switch (key) {
+    case 'n':
+      if (s->getReal(&d)) {
+        node = cg->newNode(d);
+      }
+      break;
+    case 's':
+    case 'l':
+      if (s->getInt(&k, ('s'==key) ? 2 : 4)) {
+        node = cg->newNode((double) k);
+      }
+      break;
+    case 'v':
+      if (s->getInt(&k) && k>=0 && k<(int) vars_.size()) {
+        node = cg->newNode(vars_[k]);
+      }
+      break;
+    case 'o':
+      if (s->getInt(&k)) {
+        n = nlArity(k);
+        if (0==n && (!s->getInt(&n) || n<0)) {
+          n = -1;
+        }
+        if (n>0) {
+          ops.push_back(k);
+          need.push_back(n);
+          beg.push_back(vals.size());
+          continue;
+        } else if (0==n) {
+          node = newOpNode_(cg, k, 0, 0, err);
+        }
+      }
+      break;
+    default:
+      break;
+    }
+    if (!node) {
+      *err = 1;
+      return 0;
+    }
+
+    vals.push_back(node);
+    while (!ops.empty() && (int) vals.size()-beg.back()==need.back()) {
+      node = newOpNode_(cg, ops.back(), &(vals[beg.back()]), need.back(),
+                        err);
+      if (!node) {
+        *err = 1;
+        return 0;
+      }
+      vals.resize(beg.back());
+      vals.push_back(node);
+      ops.pop_back();
+      need.pop_back();
+      beg.pop_back();
+    }
+    if (ops.empty()) {
+      return vals.back();
+    }
+  }
+  return 0;
+}
+
+
+void NlReader::parseFun_(const char *lin, const char *body, const char *end,
+                         bool defvar, NlFun *fun, DoubleVector *x,
+                         DoubleVector *grad)
+{
+  NlStream s(lin, end, binary_);
+  CNode *root;
+  double a, d;
+  int i, j, k, nlin;
+  FunctionType ftype;
+
+  fun->c = 0.0;
+  fun->err = 0;
+  fun->lf = (LinearFunctionPtr) new LinearFunction();
+  if (defvar && !lin) {
+    fun->err = 1;
+    return;
+  } else if (lin) {
+    if (!s.getInt(&i) || !s.getInt(&nlin) || (defvar && !s.getInt(&k))) {
+      fun->err = 1;
+      return;
+    }
+    for (int t=0; t<nlin; ++t) {
+      if (!s.getInt(&j) || !s.getReal(&a) || j<0 || j>=(int) vars_.size()) {
+        fun->err = 1;
+        return;
+      }
+      // J and G segments are sorted, V segments may not be.
+      fun->lf->appendTerm(vars_[j], a);
+    }
+    if (defvar) {
+      fun->lf->incTerm(vars_[i], -1.0);
+      body = s.getPos();
+    }
+  }
+
+  if (body) {
+    s.setPos(body);
+    // linear constraints have only a number here.
+    if ('n'==s.getKey() && s.getReal(&d)) {
+      fun->c = d;
+    } else {
+      s.setPos(body);
+      fun->cg = (CGraphPtr) new CGraph();
+      root = parseExpr_(&s, fun->cg, &(fun->err));
+      if (fun->err) {
+        fun->cg.reset();
+        return;
+      }
+      fun->cg->setOut(root);
+      fun->cg->finalize();
+      ftype = fun->cg->getType();
+      if (Constant==ftype || Linear==ftype) {
+        // move it to the linear part and the constant.
+        if (x->empty()) {
+          x->assign(vars_.size(), 0.0);
+          grad->assign(vars_.size(), 0.0);
+        }
+        fun->c = fun->cg->eval(&((*x)[0]), &(fun->err));
+        if (Linear==ftype) {
+          fun->cg->evalGradient(&((*x)[0]), &((*grad)[0]), &(fun->err));
+          for (VariableSet::iterator it=fun->cg->varsBegin();
+               it!=fun->cg->varsEnd(); ++it) {
+            fun->lf->incTerm(*it, (*grad)[(*it)->getIndex()]);
+            (*grad)[(*it)->getIndex()] = 0.0;
+          }
+        }
+        fun->cg.reset();
+      }
+    }
+  }
+  if (0==fun->lf->getNumTerms()) {
+    fun->lf.reset();
+  }
+}
+
+
+ProblemPtr NlReader::readInstance(std::string fname)
+{
+  int fd;
+  struct stat st;
+  char *buf;
+  bool mapped = true;
+  ProblemPtr p;
+  Timer *timer = env_->getNewTimer();
+  std::string stub;
+
+  timer->start();
+  fd = open(fname.c_str(), O_RDONLY);
+  if (fd<0) {
+    fname += ".nl";
+    fd = open(fname.c_str(), O_RDONLY);
+  }
+  if (fd<0 || 0!=fstat(fd, &st) || st.st_size<=0) {
+    logger_->errStream() << me_ << "can not read file " << fname
+                         << std::endl;
+    if (fd>=0) {
+      close(fd);
+    }
+    delete timer;
+    return ProblemPtr();
+  }
+
+  // map the file into memory, or read it all if it can not be mapped.
+  buf = (char *) mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  if (MAP_FAILED==buf) {
+    mapped = false;
+    buf = new char[st.st_size];
+    if (read(fd, buf, st.st_size)!=st.st_size) {
+      logger_->errStream() << me_ << "can not read file " << fname
+                           << std::endl;
+      delete [] buf;
+      close(fd);
+      delete timer;
+      return ProblemPtr();
+    }
+  } else {
+    madvise(buf, st.st_size, MADV_SEQUENTIAL);
+  }
+
+  stub = fname;
+  if (stub.size()>3 && 0==stub.compare(stub.size()-3, 3, ".nl")) {
+    stub.erase(stub.size()-3);
+  }
+  p = build_(buf, buf+st.st_size, stub);
+
+  if (mapped) {
+    munmap(buf, st.st_size);
+  } else {
+    delete [] buf;
+  }
+  close(fd);
+  time_ = timer->query();
+  delete timer;
+  if (p) {
+    logger_->msgStream(LogInfo) << me_ << "read " << p->getNumVars()
+                                << " variables and " << p->getNumCons()
+                                << " constraints in " << time_
+                                << " seconds." << std::endl;
+  }
+  return p;
+}
+
+
+bool NlReader::readBound_(NlStream *s, double *lb, double *ub)
+{
+  char key = s->getKey();
+  double d = 0.0;
+
+  switch (key) {
+  case '0':
+    if (!s->getReal(lb) || !s->getReal(&d)) {
+      return false;
+    }
+    *ub = d;
+    break;
+  case '1':
+    *lb = -INFINITY;
+    return s->getReal(ub);
+  case '2':
+    *ub = INFINITY;
+    return s->getReal(lb);
+  case '3':
+    *lb = -INFINITY;
+    *ub = INFINITY;
+    break;
+  case '4':
+    if (!s->getReal(&d)) {
+      return false;
+    }
+    *lb = *ub = d;
+    break;
+  default:
+    // '5' is a complementarity constraint.
+    unsupported_(key, -1);
+    return false;
+  }
+  return true;
+}
+
+
+const char *NlReader::readHeader_(const char *beg, const char *end)
+{
+  // where the numbers of each line start in hdr_ and how many there are.
+  static const int first[10] = {0, NlNVar, NlNlc, NlNlnc, NlNlvc, NlNwv,
+                                NlNbv, NlNzc, NlMaxRow, NlComb};
+  static const int cnt[10] = {0, 6, 2, 2, 3, 4, 5, 2, 2, 5};
+  static const int least[10] = {0, 5, 2, 2, 3, 3, 5, 2, 2, 5};
+  const char *p = beg;
+  int k, v;
+  bool neg;
+
+  if (p>=end || ('g'!=*p && 'b'!=*p)) {
+    return 0;
+  }
+  binary_ = ('b'==*p);
+  memset(hdr_, 0, sizeof(hdr_));
+  for (int l=0; l<10; ++l) {
+    k = 0;
+    if (0==l) {
+      ++p;
+    }
+    while (p<end && '\n'!=*p && '#'!=*p) {
+      if (isdigit(*p) || '-'==*p) {
+        neg = ('-'==*p);
+        if (neg) {
+          ++p;
+        }
+        v = 0;
+        while (p<end && isdigit(*p)) {
+          v = 10*v + (*p-'0');
+          ++p;
+        }
+        if (l>0 && k<cnt[l]) {
+          hdr_[first[l]+k] = (neg) ? -v : v;
+        }
+        ++k;
+      } else {
+        ++p;
+      }
+    }
+    while (p<end && '\n'!=*p) {
+      ++p;
+    }
+    if (p>=end || k<least[l]) {
+      return 0;
+    }
+    ++p;
+  }
+  return p;
+}
+
+
+void NlReader::readNames_(std::string stub, std::string suffix,
+                          std::vector<std::string> *names)
+{
+  std::ifstream in((stub+suffix).c_str());
+  std::string line;
+
+  names->clear();
+  while (in.good() && std::getline(in, line)) {
+    if (!line.empty() && '\r'==line[line.size()-1]) {
+      line.erase(line.size()-1);
+    }
+    names->push_back(line);
+  }
+}
+
+
+bool NlReader::skipExpr_(NlStream *s)
+{
+  int need = 1;
+  int k, n;
+  double d;
+  char key;
+
+  while (need>0) {
+    key = s->getKey();
+    switch (key) {
+    case 'n':
+      if (!s->getReal(&d)) {
+        return false;
+      }
+      break;
+    case 's':
+    case 'l':
+      if (!s->getInt(&k, ('s'==key) ? 2 : 4)) {
+        return false;
+      }
+      break;
+    case 'v':
+      if (!s->getInt(&k) || k<0 || k>=hdr_[NlNVar]+(int) nDefs_) {
+        return false;
+      }
+      break;
+    case 'o':
+      if (!s->getInt(&k)) {
+        return false;
+      }
+      n = nlArity(k);
+      if (n<0) {
+        unsupported_(key, k);
+        return false;
+      } else if (0==n && (!s->getInt(&n) || n<0)) {
+        return false;
+      }
+      need += n;
+      break;
+    default:
+      unsupported_(key, -1);
+      return false;
+    }
+    --need;
+  }
+  return true;
+}
+
+
+void NlReader::unsupported_(char key, int k)
+{
+  logger_->errStream() << me_ << "unsupported ";
+  if ('o'==key) {
+    logger_->errStream() << "operator o" << k;
+  } else {
+    logger_->errStream() << "token or segment '" << key << "'";
+  }
+  logger_->errStream() << " in .nl file." << std::endl;
+}
+
+
+void NlReader::writeStats(std::ostream &out) const
+{
+  out << me_ << "time used in reading = " << time_ << std::endl
+      << me_ << "threads used = " << nThreads_ << std::endl;
+}
+
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
@@ -0,0 +1,255 @@
+//
+//     MINOTAUR -- It's only 1/2 bull
+//
+//     (C)opyright 2008 - 2014 The MINOTAUR Team.
+//
+
+/**
+ * \file NlReader.h
+ * \brief Declare the NlReader class that reads a problem from a .nl file
+ * without the AMPL Solver Library.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#ifndef MINOTAURNLREADER_H
+#define MINOTAURNLREADER_H
+
+#include <string>
+
+#include "Types.h"
+
+namespace Minotaur {
+
+  class CGraph;
+  class CNode;
+  class LinearFunction;
+  class Logger;
+  class Problem;
+  typedef boost::shared_ptr<CGraph> CGraphPtr;
+  typedef boost::shared_ptr<LinearFunction> LinearFunctionPtr;
+  typedef boost::shared_ptr<Logger> LoggerPtr;
+  typedef boost::shared_ptr<Problem> ProblemPtr;
+
+  /**
+   * \brief A cursor in the body of a .nl file, in the text ('g') or the
+   * binary ('b') format.
+   *
+   * It is only a pair of pointers, so that each thread can parse a
+   * different segment of the same buffer. In the text format, comments
+   * after '#' are skipped like white space.
+   */
+  class NlStream {
+    public:
+      /// Constructor. The body is in [beg, end).
+      NlStream(const char *beg, const char *end, bool binary);
+
+      /// Return true if the end of the buffer is reached.
+      bool atEnd();
+
+      /// Read the key of a segment or of a token of an expression.
+      char getKey();
+
+      /// Read an integer.
+      bool getInt(int *i);
+
+      /// Read an integer of w bytes in the binary format.
+      bool getInt(int *i, UInt w);
+
+      /// Read a real number.
+      bool getReal(double *d);
+
+      /// Read the name of a suffix or a string of an expression.
+      bool getString(std::string *s, bool counted);
+
+      /// Return the current position.
+      const char *getPos() const { return p_; };
+
+      /// Move to a position returned by getPos().
+      void setPos(const char *p) { p_ = p; };
+
+    private:
+      /// True if the body is binary.
+      bool binary_;
+
+      /// End of the buffer.
+      const char *end_;
+
+      /// Current position.
+      const char *p_;
+
+      /// Skip white space and comments in the text format.
+      void skipSpace_();
+  };
+
+
+  /**
+   * \brief Read a problem from a .nl file, in the text or the binary
+   * format, without the AMPL Solver Library.
+   *
+   * The file is mapped into memory and read in two passes. The first pass
+   * only finds where each segment starts. The second builds the variables,
+   * the linear parts of constraints and the objective, and their
+   * nonlinear parts as CGraph objects directly, without an intermediate
+   * tree. Constraints are independent of each other, so that they are
+   * parsed in parallel when Minotaur is built with OpenMP. Expressions are
+   * parsed without recursion.
+   *
+   * The problem is built as AMPLInterface does with the native CGraph:
+   * nonlinear constraints, then the constraints that define the 'defined
+   * variables' of AMPL, then linear constraints. Logical constraints,
+   * complementarity constraints, imported functions and operators that
+   * have no OpCode are not supported. Suffixes, including those for SOS,
+   * are ignored.
+   */
+  class NlReader {
+    public:
+      /// Constructor.
+      NlReader(EnvPtr env);
+
+      /// Destroy.
+      ~NlReader();
+
+      /// Return the initial point given in the last file read.
+      const double *getInitialPoint() const;
+
+      /**
+       * \brief Read a problem from file fname. The suffix ".nl" is added
+       * if fname does not exist. Names are read from the .col and .row
+       * files if they exist.
+       *
+       * \return The problem, or NULL if the file can not be read or has
+       * something that is not supported.
+       */
+      ProblemPtr readInstance(std::string fname);
+
+      /// Write statistics about the last file read.
+      void writeStats(std::ostream &out) const;
+
+    private:
+      /**
+       * Parsed function of a constraint, the objective, or the definition
+       * of a defined variable.
+       */
+      struct NlFun {
+        LinearFunctionPtr lf;
+        CGraphPtr cg;
+        double c;      /// Constant term.
+        int err;       /// Zero if parsed correctly.
+      };
+
+      /// True if the body of the last file is binary.
+      bool binary_;
+
+      /// Start of the body of each constraint 'C' segment.
+      std::vector<const char *> conOff_;
+
+      /// Start of the body of each defined variable 'V' segment.
+      std::vector<const char *> defOff_;
+
+      /// Environment.
+      EnvPtr env_;
+
+      /// Header of the .nl file.
+      int hdr_[32];
+
+      /// Start of each 'J' segment, after its key.
+      std::vector<const char *> jacOff_;
+
+      /// Log.
+      LoggerPtr logger_;
+
+      /// For logging.
+      static const std::string me_;
+
+      /// Number of defined variables.
+      UInt nDefs_;
+
+      /// Number of threads used for parsing constraints.
+      int nThreads_;
+
+      /// Start of each 'G' segment, after its key.
+      std::vector<const char *> objGOff_;
+
+      /// Start of the body of each objective 'O' segment.
+      std::vector<const char *> objOff_;
+
+      /// Sense of each objective, 1 if maximized.
+      std::vector<int> objSense_;
+
+      /// Start of the 'b', 'r' and 'x' segments, after their keys.
+      const char *segOff_[3];
+
+      /// Name of the last file without the suffix ".nl".
+      std::string stub_;
+
+      /// Time taken to read the last file.
+      double time_;
+
+      /// Variables of the problem, including defined variables.
+      VarVector vars_;
+
+      /// Initial point.
+      DoubleVector x0_;
+
+      /// Add constraints, objective and defined variables to p.
+      bool addFuns_(ProblemPtr p, const char *end);
+
+      /// Add variables of the file to p with their bounds.
+      bool addVars_(ProblemPtr p, const char *end);
+
+      /// Read the file in [beg, end) into a new problem.
+      ProblemPtr build_(const char *beg, const char *end, std::string stub);
+
+      /// Return the type of the i-th variable from the header.
+      VariableType getVarType_(int i) const;
+
+      /// Find the start of each segment of the body.
+      bool indexSegs_(NlStream s);
+
+      /// Build the node of op code k of the .nl file with given children.
+      CNode *newOpNode_(CGraphPtr cg, int k, CNode **child, UInt n,
+                        int *err);
+
+      /// Parse an expression into cg. Return its root node.
+      CNode *parseExpr_(NlStream *s, CGraphPtr cg, int *err);
+
+      /**
+       * Parse a function: the linear terms in a 'J', 'G' or 'V' segment at
+       * lin (if not NULL), and the expression at body. For a 'V' segment,
+       * the expression follows the linear terms. x and grad are work
+       * arrays of zeros, resized when needed.
+       */
+      void parseFun_(const char *lin, const char *body, const char *end,
+                     bool defvar, NlFun *fun, DoubleVector *x,
+                     DoubleVector *grad);
+
+      /// Read the header of a .nl file. Return the start of the body.
+      const char *readHeader_(const char *beg, const char *end);
+
+      /// Read names from stub.suffix into names, if the file exists.
+      void readNames_(std::string stub, std::string suffix,
+                      std::vector<std::string> *names);
+
+      /// Read the bounds on one line of a 'b' or 'r' segment.
+      bool readBound_(NlStream *s, double *lb, double *ub);
+
+      /// Skip an expression. Return false if it has an unsupported token.
+      bool skipExpr_(NlStream *s);
+
+      /// Report an unsupported segment or operator.
+      void unsupported_(char key, int k);
+  };
+  typedef boost::shared_ptr<NlReader> NlReaderPtr;
+}
+#endif
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
@@ -165,6 +165,15 @@ namespace Minotaur {
     /// Reverse iterators.
     ModificationRConstIterator modsREnd() const { return pMods_.rend(); }
 
+    /**
+     * Get the first modification that was applied at this node to the
+     * relaxation. Modifications of the branch are not included.
+     */
+    ModificationConstIterator rModsBegin() const { return rMods_.begin(); }
+
+    /// End of modifications applied at this node to the relaxation.
+    ModificationConstIterator rModsEnd() const { return rMods_.end(); }
+
     /// Set the status of this node.
     void setStatus(NodeStatus status) { status_ = status; }
 
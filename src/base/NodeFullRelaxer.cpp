@@ -21,6 +21,7 @@
 #include "Node.h"
 #include "NodeFullRelaxer.h"
 #include "Objective.h"
+#include "Profiler.h"
 #include "Relaxation.h"
 #include "Variable.h"
 #include "VarBoundMod.h"
@@ -71,6 +72,7 @@ NodeFullRelaxer::~NodeFullRelaxer ()
 RelaxationPtr NodeFullRelaxer::createRootRelaxation(NodePtr rootNode,
                                                     bool &prune)
 {
+  ProfZone zone(ProfRelax);
 
   prune = false;
   rel_ = (RelaxationPtr) new Relaxation();
@@ -116,6 +118,7 @@ void NodeFullRelaxer::setEngine(EnginePtr e)
 RelaxationPtr NodeFullRelaxer::createNodeRelaxation(NodePtr node, bool, 
                                                     bool &prune)
 {
+  ProfZone zone(ProfRelax);
 
 #if defined(DEBUG_NODEFULLRELAXER)
     std::cout << "Before relaxing node.  Relaxation is: " << std::endl;
@@ -106,6 +106,12 @@ UInt NodeHeap::getDeepestLevel() const
 }
 
 
+void NodeHeap::getNodes(NodePtrVector *nodes) const
+{
+  nodes->insert(nodes->end(), nodes_.begin(), nodes_.end());
+}
+
+
 void NodeHeap::write(std::ostream &) const
 {
    //for(std::vector<NodePtr>::const_iterator it = nodes_.begin();
@@ -60,6 +60,9 @@ namespace Minotaur {
         /// Find the maximum depth of all active nodes.
         virtual UInt getDeepestLevel() const;
 
+        /// Append all active nodes to nodes.
+        virtual void getNodes(NodePtrVector *nodes) const;
+
         /// Remove the best node from the heap.
         virtual void pop();
 
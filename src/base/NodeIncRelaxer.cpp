@@ -19,6 +19,7 @@
 #include "Node.h"
 #include "NodeIncRelaxer.h"
 #include "Option.h"
+#include "Profiler.h"
 #include "Relaxation.h"
 
 
@@ -46,6 +47,7 @@ NodeIncRelaxer::~NodeIncRelaxer ()
 
 RelaxationPtr NodeIncRelaxer::createRootRelaxation(NodePtr, bool &prune)
 {
+  ProfZone zone(ProfRelax);
   prune = false;
   rel_ = (RelaxationPtr) new Relaxation();
   for (HandlerIterator h = handlers_.begin(); h != handlers_.end() && !prune; 
@@ -94,6 +96,7 @@ void NodeIncRelaxer::setModFlag(bool mod_prob)
 RelaxationPtr NodeIncRelaxer::createNodeRelaxation(NodePtr node, bool dived, 
                                                    bool &prune)
 {
+  ProfZone zone(ProfRelax);
   NodePtr t_node; // temporary
   WarmStartPtr ws;
   prune = false;
@@ -20,11 +20,13 @@
 namespace Minotaur {
 
   class Brancher;
+  class ConflictAnalyzer;
   class Relaxation;
   class SolutionPool;
   class WarmStart;
   class CutManager;
   typedef boost::shared_ptr <Brancher> BrancherPtr;
+  typedef boost::shared_ptr <ConflictAnalyzer> ConflictAnalyzerPtr;
   typedef boost::shared_ptr <Relaxation> RelaxationPtr;
   typedef boost::shared_ptr <SolutionPool> SolutionPoolPtr;
   typedef boost::shared_ptr <WarmStart> WarmStartPtr;
@@ -77,6 +79,19 @@ namespace Minotaur {
        */
       virtual bool foundNewSolution() = 0;
 
+      /**
+       * Let the handlers finish the work that they put off while processing
+       * nodes. Called when the search ends. New solutions are added to
+       * s_pool.
+       */
+      virtual void flushDeferred(SolutionPoolPtr) {};
+
+      /**
+       * The relaxation is created again, e.g. when the root is restarted.
+       * Drop the references to constraints of the old relaxation.
+       */
+      virtual void resetRelaxation() {};
+
       /**
        * Return the warm start information that will be used to start
        * processing children.
@@ -93,6 +108,18 @@ namespace Minotaur {
       virtual void writeStats() const {};
 
       virtual void setCutManager(CutManager *) {};
+
+      /**
+       * Set the analyzer that learns conflicts from pruned nodes and uses
+       * them in later nodes. Ignored by processors that do not use it.
+       */
+      virtual void setConflictAnalyzer(ConflictAnalyzerPtr) {};
+
+      /**
+       * Remove the conflicts learned so far, because the problem or the
+       * incumbent changed, e.g. between two solves with reoptimization.
+       */
+      virtual void clearConflicts() {};
     protected:
       /// What brancher is used for this processor
       BrancherPtr brancher_;
@@ -62,6 +62,12 @@ UInt NodeStack::getDeepestLevel() const
 }
 
 
+void NodeStack::getNodes(NodePtrVector *nodes) const
+{
+  nodes->insert(nodes->end(), nodes_.begin(), nodes_.end());
+}
+
+
 void NodeStack::pop() 
 {
   nodes_.pop_front();
@@ -53,6 +53,9 @@ namespace Minotaur {
       /// The maximum depth is the depth of the topmost node in the stack.
       virtual UInt getDeepestLevel() const;
 
+      /// Append all active nodes to nodes.
+      virtual void getNodes(NodePtrVector *nodes) const;
+
       /// Remove the best node from the heap.
       virtual void pop();
 
@@ -0,0 +1,359 @@
+//
+//     MINOTAUR -- It's only 1/2 bull
+//
+//     (C)opyright 2008 - 2014 The MINOTAUR Team.
+//
+
+/**
+ * \file ObbtHandler.cpp
+ * \brief Implement the methods of class ObbtHandler.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#include "MinotaurConfig.h"
+#include "Constraint.h"
+#include "Engine.h"
+#include "Environment.h"
+#include "Function.h"
+#include "LinearFunction.h"
+#include "Logger.h"
+#include "Node.h"
+#include "NonlinearFunction.h"
+#include "ObbtHandler.h"
+#include "Objective.h"
+#include "Option.h"
+#include "QuadraticFunction.h"
+#include "Relaxation.h"
+#include "Solution.h"
+#include "Timer.h"
+#include "VarBoundMod.h"
+#include "Variable.h"
+
+using namespace Minotaur;
+
+const std::string ObbtHandler::me_ = "ObbtHandler: ";
+
+
+ObbtHandler::ObbtHandler(EnvPtr env, ProblemPtr problem, EnginePtr engine)
+  : engine_(engine),
+    env_(env),
+    eps_(1e-6),
+    nVars_(0),
+    p_(problem)
+{
+  logger_ = (LoggerPtr) new Logger((LogLevel)(env->getOptions()->
+      findInt("handler_log_level")->getValue()));
+  depth_ = env->getOptions()->findInt("obbt_depth")->getValue();
+  timeLimit_ = env->getOptions()->findDouble("obbt_time")->getValue();
+  numThreads_ = env->getOptions()->findInt("threads")->getValue();
+#if !(USE_OPENMP)
+  numThreads_ = 1;
+#endif
+  numThreads_ = std::max(numThreads_, 1);
+  modProb_ = true;
+  modRel_ = true;
+  stats_.calls = 0;
+  stats_.lps = 0;
+  stats_.filtered = 0;
+  stats_.bnds = 0;
+  stats_.inf = 0;
+  stats_.time = 0.0;
+}
+
+
+ObbtHandler::~ObbtHandler()
+{
+  engine_.reset();
+  env_.reset();
+  p_.reset();
+}
+
+
+void ObbtHandler::findCands_()
+{
+  VariableSet vars;
+  FunctionPtr f;
+  QuadraticFunctionPtr qf;
+  NonlinearFunctionPtr nlf;
+  ConstVariablePtr v;
+
+  cands_.clear();
+  for (ConstraintConstIterator it=p_->consBegin(); it!=p_->consEnd(); ++it) {
+    f = (*it)->getFunction();
+    qf = f->getQuadraticFunction();
+    if (qf) {
+      for (VarIntMapConstIterator it2=qf->varsBegin(); it2!=qf->varsEnd();
+           ++it2) {
+        vars.insert(p_->getVariable(it2->first->getIndex()));
+      }
+    }
+    nlf = f->getNonlinearFunction();
+    if (nlf) {
+      nlf->getVars(&vars);
+    }
+  }
+  if (p_->getObjective() && p_->getObjective()->getFunction()) {
+    f = p_->getObjective()->getFunction();
+    qf = f->getQuadraticFunction();
+    if (qf) {
+      for (VarIntMapConstIterator it2=qf->varsBegin(); it2!=qf->varsEnd();
+           ++it2) {
+        vars.insert(p_->getVariable(it2->first->getIndex()));
+      }
+    }
+    nlf = f->getNonlinearFunction();
+    if (nlf) {
+      nlf->getVars(&vars);
+    }
+  }
+
+  for (VariableSet::const_iterator it=vars.begin(); it!=vars.end(); ++it) {
+    v = *it;
+    if (v->getType()!=Binary && v->getType()!=ImplBin &&
+        v->getUb()-v->getLb() > eps_) {
+      cands_.push_back(v->getIndex());
+    }
+  }
+  std::sort(cands_.begin(), cands_.end());
+  nVars_ = p_->getNumVars();
+  logger_->msgStream(LogInfo) << me_ << "variables in nonconvex terms = "
+                              << cands_.size() << std::endl;
+}
+
+
+void ObbtHandler::filter_(const VarVector &cvars, const double *x, UInt t,
+                          UInt nt, BoolVector &at_lb, BoolVector &at_ub)
+{
+  VariablePtr v;
+
+  for (UInt k=t; k<cands_.size(); k+=nt) {
+    v = cvars[k];
+    if (!v) {
+      continue;
+    }
+    if (x[v->getIndex()] < v->getLb()+eps_) {
+      at_lb[k] = true;
+    }
+    if (x[v->getIndex()] > v->getUb()-eps_) {
+      at_ub[k] = true;
+    }
+  }
+}
+
+
+std::string ObbtHandler::getName() const
+{
+  return "ObbtHandler (Optimization-based bound tightening)";
+}
+
+
+bool ObbtHandler::presolveNode(RelaxationPtr rel, NodePtr node,
+                               SolutionPoolPtr, ModVector &p_mods,
+                               ModVector &r_mods)
+{
+  UInt n, nt;
+  DoubleVector lb, ub;
+  std::vector<ObbtStats> tstats;
+  std::vector<int> tinf;
+  VariablePtr xp, xr;
+  double nlb, nub;
+  bool is_inf = false;
+  ModificationPtr mod;
+  Timer *timer;
+
+  if (depth_ < 0 || (int) node->getDepth() > depth_ || !engine_) {
+    return false;
+  }
+  if (nVars_!=p_->getNumVars()) {
+    findCands_();
+  }
+  n = cands_.size();
+  if (0==n) {
+    return false;
+  }
+  timer = env_->getNewTimer();
+  timer->start();
+  ++stats_.calls;
+
+  lb.assign(n, -INFINITY);
+  ub.assign(n, INFINITY);
+  nt = std::min((UInt) numThreads_, n);
+  tstats.assign(nt, stats_);
+  tinf.assign(nt, 0);
+#if USE_OPENMP
+#pragma omp parallel for
+#endif
+  for (UInt t=0; t<nt; ++t) {
+    tstats[t].lps = tstats[t].filtered = 0;
+    tinf[t] = solveLPs_(rel, t, nt, timer, lb, ub, tstats[t]) ? 1 : 0;
+  }
+  for (UInt t=0; t<nt; ++t) {
+    stats_.lps += tstats[t].lps;
+    stats_.filtered += tstats[t].filtered;
+    if (tinf[t]) {
+      is_inf = true;
+    }
+  }
+
+  for (UInt k=0; k<n && false==is_inf; ++k) {
+    xp = p_->getVariable(cands_[k]);
+    xr = rel->getRelaxationVar(xp);
+    if (!xr) {
+      continue;
+    }
+    nlb = xr->getLb();
+    nub = xr->getUb();
+    if (lb[k] > nlb+1e-4*(1.0+fabs(nlb))) {
+      nlb = lb[k];
+    }
+    if (ub[k] < nub-1e-4*(1.0+fabs(nub))) {
+      nub = ub[k];
+    }
+    if (nlb > nub+eps_) {
+      is_inf = true;
+      break;
+    } else if (nlb > nub) {
+      nlb = nub;
+    }
+    if (nlb > xr->getLb() || nub < xr->getUb()) {
+      mod = (VarBoundMod2Ptr) new VarBoundMod2(xr, nlb, nub);
+      mod->applyToProblem(rel);
+      r_mods.push_back(mod);
+      ++stats_.bnds;
+      if (nlb > xp->getLb() || nub < xp->getUb()) {
+        mod = (VarBoundMod2Ptr) new VarBoundMod2(xp,
+                                                 std::max(nlb, xp->getLb()),
+                                                 std::min(nub, xp->getUb()));
+        mod->applyToProblem(p_);
+        p_mods.push_back(mod);
+      }
+    }
+  }
+  if (is_inf) {
+    ++stats_.inf;
+  }
+  stats_.time += timer->query();
+  delete timer;
+  return is_inf;
+}
+
+
+bool ObbtHandler::solveLPs_(RelaxationPtr rel, UInt t, UInt nt, Timer *timer,
+                            DoubleVector &lb, DoubleVector &ub,
+                            ObbtStats &stats)
+{
+  RelaxationPtr relc;
+  EnginePtr e = engine_->emptyCopy();
+  EngineStatus status;
+  BoolVector at_lb, at_ub;
+  VarVector cvars;
+  LinearFunctionPtr lf;
+  VariablePtr v;
+  double val;
+  bool is_int;
+
+  if (!e) {
+    return false;
+  }
+  relc = (RelaxationPtr) new Relaxation(rel);
+  e->clear();
+  relc->prepareForSolve();
+  e->load(relc);
+
+  // candidates are indexed by variables of p_. Map them to rel, and then to
+  // its copy relc.
+  cvars.assign(cands_.size(), VariablePtr());
+  for (UInt k=t; k<cands_.size(); k+=nt) {
+    v = rel->getRelaxationVar(p_->getVariable(cands_[k]));
+    if (v) {
+      cvars[k] = relc->getRelaxationVar(v);
+    }
+  }
+
+  // the first solve is with the original objective. Its basis is used to
+  // start the next LP, and so on.
+  at_lb.assign(cands_.size(), false);
+  at_ub.assign(cands_.size(), false);
+  status = e->solve();
+  ++stats.lps;
+  if (ProvenInfeasible==status || ProvenLocalInfeasible==status) {
+    return true;
+  } else if (ProvenOptimal==status) {
+    filter_(cvars, e->getSolution()->getPrimal(), t, nt, at_lb, at_ub);
+  }
+
+  for (UInt k=t; k<cands_.size(); k+=nt) {
+    v = cvars[k];
+    if (!v) {
+      continue;
+    }
+    is_int = (v->getType()==Integer || v->getType()==ImplInt);
+    for (int dir=0; dir<2; ++dir) {
+      // dir 0: minimize v, 1: maximize v.
+      if ((0==dir && at_lb[k]) || (1==dir && at_ub[k])) {
+        ++stats.filtered;
+        continue;
+      }
+      if (timer->query() > timeLimit_) {
+        return false;
+      }
+      lf = (LinearFunctionPtr) new LinearFunction();
+      lf->addTerm(v, (0==dir) ? 1.0 : -1.0);
+      e->changeObj((FunctionPtr) new Function(lf), 0.0);
+      status = e->solve();
+      ++stats.lps;
+      if (ProvenInfeasible==status || ProvenLocalInfeasible==status) {
+        return true;
+      } else if (ProvenOptimal!=status) {
+        continue;
+      }
+      filter_(cvars, e->getSolution()->getPrimal(), t, nt, at_lb, at_ub);
+
+      // relc is tightened too, so that the next LPs are tighter.
+      val = e->getSolutionValue();
+      if (0==dir) {
+        val -= eps_*(1.0+fabs(val));
+        lb[k] = is_int ? ceil(val-eps_) : val;
+        if (lb[k] > v->getLb()) {
+          relc->changeBound(v, Lower, std::min(lb[k], v->getUb()));
+        }
+      } else {
+        val = -val + eps_*(1.0+fabs(val));
+        ub[k] = is_int ? floor(val+eps_) : val;
+        if (ub[k] < v->getUb()) {
+          relc->changeBound(v, Upper, std::max(ub[k], v->getLb()));
+        }
+      }
+    }
+  }
+  return false;
+}
+
+
+void ObbtHandler::writeStats(std::ostream &out) const
+{
+  out << me_ << "nodes                       = " << stats_.calls << std::endl
+      << me_ << "LPs solved                  = " << stats_.lps << std::endl
+      << me_ << "bounds filtered             = " << stats_.filtered
+      << std::endl
+      << me_ << "bounds tightened            = " << stats_.bnds << std::endl
+      << me_ << "nodes found infeasible      = " << stats_.inf << std::endl
+      << me_ << "time used                   = " << stats_.time
+      << std::endl;
+}
+
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
@@ -0,0 +1,199 @@
+//
+//     MINOTAUR -- It's only 1/2 bull
+//
+//     (C)opyright 2008 - 2014 The MINOTAUR Team.
+//
+
+/**
+ * \file ObbtHandler.h
+ * \brief Declare the ObbtHandler class for optimization-based bound
+ * tightening of variables in nonconvex terms.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#ifndef MINOTAUROBBTHANDLER_H
+#define MINOTAUROBBTHANDLER_H
+
+#include "Handler.h"
+
+namespace Minotaur {
+
+  class Engine;
+  class Logger;
+  class Timer;
+  typedef boost::shared_ptr<Engine> EnginePtr;
+  typedef boost::shared_ptr<Logger> LoggerPtr;
+
+  /// Statistics of optimization-based bound tightening.
+  struct ObbtStats {
+    UInt calls;    ///< Number of nodes in which OBBT was done.
+    UInt lps;      ///< Number of LPs solved.
+    UInt filtered; ///< Bounds not tried because a solution was at them.
+    UInt bnds;     ///< Number of bounds tightened.
+    UInt inf;      ///< Number of nodes found infeasible.
+    double time;   ///< Time spent.
+  };
+
+  /**
+   * \brief Handler that tightens bounds of variables in nonconvex terms by
+   * minimizing and maximizing them over the relaxation.
+   *
+   * The quality of McCormick and secant relaxations depends on bounds of
+   * the variables in quadratic and nonlinear functions. In the root, and in
+   * nodes up to depth "obbt_depth", each such variable is minimized and
+   * maximized over the current relaxation. The relaxation is copied and
+   * loaded into empty copies of the engine, one for each of "threads"
+   * threads; the variables are shared among them. Each copy is first
+   * solved with the original objective, and every later LP starts from the
+   * basis of the previous one. A bound is not tried if a variable was at it
+   * in any solution found so far by the copy.
+   *
+   * New bounds are applied to the relaxation and to the problem in
+   * presolveNode(), so this handler should be placed before the handlers
+   * that update their relaxations from bounds, e.g. QuadHandler.
+   */
+  class ObbtHandler : public Handler {
+  public:
+    /**
+     * \brief Constructor.
+     *
+     * \param[in] env Environment.
+     * \param[in] problem The problem whose relaxation is tightened.
+     * \param[in] engine The LP engine that solves the relaxation. Only its
+     * empty copies are used.
+     */
+    ObbtHandler(EnvPtr env, ProblemPtr problem, EnginePtr engine);
+
+    /// Destroy.
+    ~ObbtHandler();
+
+    /// Does nothing.
+    Branches getBranches(BrCandPtr, DoubleVector &, RelaxationPtr,
+                         SolutionPoolPtr)
+    {return Branches();};
+
+    /// Does nothing.
+    void getBranchingCandidates(RelaxationPtr, const DoubleVector &,
+                                ModVector &, BrVarCandSet &, BrCandVector &,
+                                bool &) {};
+
+    /// Does nothing.
+    ModificationPtr getBrMod(BrCandPtr, DoubleVector &, RelaxationPtr,
+                             BranchDirection)
+    {return ModificationPtr();};
+
+    // base class method.
+    std::string getName() const;
+
+    /// Bounds do not make a solution infeasible. Always returns true.
+    bool isFeasible(ConstSolutionPtr, RelaxationPtr, bool &, double &)
+    {return true;};
+
+    /// Does nothing.
+    SolveStatus presolve(PreModQ *, bool *changed)
+    {*changed = false; return Finished;};
+
+    /// Tighten bounds if the node is not deeper than "obbt_depth".
+    bool presolveNode(RelaxationPtr rel, NodePtr node,
+                      SolutionPoolPtr s_pool, ModVector &p_mods,
+                      ModVector &r_mods);
+
+    /// Does nothing.
+    void relaxInitFull(RelaxationPtr, bool *is_inf) {*is_inf = false;};
+
+    /// Does nothing.
+    void relaxInitInc(RelaxationPtr, bool *is_inf) {*is_inf = false;};
+
+    /// Does nothing.
+    void relaxNodeFull(NodePtr, RelaxationPtr, bool *) {};
+
+    /// Does nothing.
+    void relaxNodeInc(NodePtr, RelaxationPtr, bool *) {};
+
+    /// Does nothing.
+    void separate(ConstSolutionPtr, NodePtr, RelaxationPtr, CutManager *,
+                  SolutionPoolPtr, bool *, SeparationStatus *) {};
+
+    // base class method.
+    void writeStats(std::ostream &out) const;
+
+  private:
+    /// Indices of variables whose bounds are tightened.
+    UIntVector cands_;
+
+    /// Maximum depth of nodes in which OBBT is done.
+    int depth_;
+
+    /// The engine whose copies are used.
+    EnginePtr engine_;
+
+    /// Environment.
+    EnvPtr env_;
+
+    /// Tolerance.
+    double eps_;
+
+    /// Log.
+    LoggerPtr logger_;
+
+    /// For logging.
+    static const std::string me_;
+
+    /// Number of threads.
+    int numThreads_;
+
+    /// Number of variables of p_ when cands_ were found.
+    UInt nVars_;
+
+    /// The problem.
+    ProblemPtr p_;
+
+    /// Statistics.
+    ObbtStats stats_;
+
+    /// Time limit of one call to presolveNode(), in seconds.
+    double timeLimit_;
+
+    /**
+     * \brief Mark the candidates whose values in x are at their bounds.
+     * cvars has the variable of each candidate in the relaxation that was
+     * solved, or NULL. Only candidates t, t+nt, ... are checked.
+     */
+    void filter_(const VarVector &cvars, const double *x, UInt t, UInt nt,
+                 BoolVector &at_lb, BoolVector &at_ub);
+
+    /// Find the variables in quadratic and nonlinear functions of p_.
+    void findCands_();
+
+    /**
+     * \brief Minimize and maximize some candidates over a copy of the
+     * relaxation.
+     *
+     * \param[in] rel The relaxation.
+     * \param[in] t This copy takes candidates t, t+nt, t+2nt, ...
+     * \param[in] nt Number of copies.
+     * \param[in] timer Started when OBBT started in this node.
+     * \param[out] lb New lower bound of each candidate.
+     * \param[out] ub New upper bound of each candidate.
+     * \param[out] stats Statistics of this copy.
+     * \return True if the relaxation is infeasible.
+     */
+    bool solveLPs_(RelaxationPtr rel, UInt t, UInt nt, Timer *timer,
+                   DoubleVector &lb, DoubleVector &ub, ObbtStats &stats);
+  };
+
+  typedef boost::shared_ptr<ObbtHandler> ObbtHandlerPtr;
+  typedef boost::shared_ptr<const ObbtHandler> ConstObbtHandlerPtr;
+}
+#endif
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
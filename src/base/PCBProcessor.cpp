@@ -9,11 +9,18 @@
  * \brief Define base class Node Processor.
  * \author Ashutosh Mahajan, Argonne National Laboratory
  */
+#include <algorithm>
 #include <cmath> // for INFINITY
+#if USE_OPENMP
+#include <omp.h>
+#endif
 
 #include "MinotaurConfig.h"
 #include "Brancher.h"
+#include "ConflictAnalyzer.h"
+#include "Cut.h"
 #include "CutMan2.h"
+#include "CutPool.h"
 #include "Engine.h"
 #include "Environment.h"
 #include "Handler.h"
@@ -23,8 +30,11 @@
 #include "Node.h"
 #include "Option.h"
 #include "Modification.h"
+#include "Profiler.h"
 #include "Relaxation.h"
 #include "SolutionPool.h"
+#include "VarBoundMod.h"
+#include "Variable.h"
 
 using namespace Minotaur;
 
@@ -37,9 +47,11 @@ const std::string PCBProcessor::me_ = "PCBProcessor: ";
 PCBProcessor::PCBProcessor (EnvPtr env, EnginePtr engine, HandlerVector handlers)
   : contOnErr_(false),
     cutMan_(0),
+    numDupCuts_(0),
     numSolutions_(0),
     oATol_(1e-5),
-    oRTol_(1e-5)
+    oRTol_(1e-5),
+    rootVal_(-INFINITY)
 {
   cutOff_ = env->getOptions()->findDouble("obj_cut_off")->getValue();
   engine_ = engine;
@@ -48,29 +60,102 @@ PCBProcessor::PCBProcessor (EnvPtr env, EnginePtr engine, HandlerVector handlers
                                    findInt("node_processor_log_level")->
                                    getValue());
   presFreq_ = env->getOptions()-> findInt("pres_freq")->getValue();
+  rcFix_ = env->getOptions()->findBool("rc_fix")->getValue();
+  sepBudget_ = env->getOptions()->findDouble("sep_time_budget")->getValue();
+  sepThreads_ = env->getOptions()->findInt("sep_threads")->getValue();
+#if !(USE_OPENMP)
+  sepThreads_ = 1;
+#endif
+  sepTime_.resize(handlers_.size(), 0.0);
+  for (UInt i=0; i<handlers_.size(); ++i) {
+    sepBufs_.push_back((CutBufferPtr) new CutBuffer());
+  }
   stats_.bra = 0;
   stats_.inf = 0;
   stats_.opt = 0;
   stats_.prob = 0;
   stats_.proc = 0;
+  stats_.rc = 0;
   stats_.ub = 0;
 }
 
 
 PCBProcessor::~PCBProcessor()
 {
+  sepBufs_.clear();
+  sepNode_.reset();
   handlers_.clear();
   logger_.reset();
   engine_.reset();
 }
 
 
+void PCBProcessor::addBufferedCuts_(ConstSolutionPtr sol,
+                                   const UIntVector &hids)
+{
+  ProfZone zone(ProfSeparate);
+  CutPool added;
+  CutPtr c;
+  bool separated = false;
+  UInt n_added = 0;
+  UInt n_cuts = 0;
+
+  for (UIntVector::const_iterator it=hids.begin(); it!=hids.end(); ++it) {
+    CutBufferPtr buf = sepBufs_[*it];
+    for (CutVectorIter cit=buf->cutsBegin(); cit!=buf->cutsEnd(); ++cit) {
+      c = *cit;
+      if (added.findDup(c)) {
+        ++numDupCuts_;
+        continue;
+      }
+      added.addCut(c);
+      ++n_cuts;
+      if (cutMan_) {
+        cutMan_->addCut(relaxation_, c->getFunction(), c->getLb(),
+                        c->getUb(), true, c->getInfo()->neverDelete);
+      } else {
+        c->applyToProblem(relaxation_);
+      }
+    }
+    buf->clear();
+  }
+
+  // some cut managers only queue the cuts sent to them.
+  if (cutMan_ && n_cuts > 0) {
+    cutMan_->separate(relaxation_, sol, &separated, &n_added);
+  }
+}
+
+
 void PCBProcessor::addHeur(HeurPtr h)
 {
   heurs_.push_back(h);
 }
 
 
+void PCBProcessor::clearConflicts()
+{
+  if (conflicts_) {
+    conflicts_->clear();
+  }
+}
+
+
+void PCBProcessor::flushDeferred(SolutionPoolPtr s_pool)
+{
+  bool sol_found;
+
+  numSolutions_ = 0;
+  for (HandlerIterator h=handlers_.begin(); h!=handlers_.end(); ++h) {
+    sol_found = false;
+    (*h)->flushDeferred(s_pool, &sol_found);
+    if (sol_found) {
+      ++numSolutions_;
+    }
+  }
+}
+
+
 bool PCBProcessor::foundNewSolution()
 {
   return (numSolutions_ > 0);
@@ -120,6 +205,7 @@ bool PCBProcessor::isFeasible_(NodePtr node, ConstSolutionPtr sol,
 
 bool PCBProcessor::presolveNode_(NodePtr node, SolutionPoolPtr s_pool) 
 {
+  ProfZone zone(ProfPropagate);
   ModVector p_mods;      // Mods that are applied to the problem
   ModVector r_mods;      // Mods that are applied to the relaxation.
   bool is_inf = false;
@@ -223,9 +309,28 @@ void PCBProcessor::process(NodePtr node, RelaxationPtr rel,
   }
 #endif 
 
+  // conflicts are used in every node, not only when presolving.
+  if (conflicts_) {
+    should_prune = conflicts_->propagate(rel, mods);
+    for (ModificationConstIterator miter=mods.begin(); miter!=mods.end();
+         ++miter) {
+      node->addRMod(*miter);
+    }
+    mods.clear();
+    if (should_prune) {
+      node->setStatus(NodeInfeasible);
+      ++stats_.inf;
+      conflicts_->analyze(node, rel);
+      return;
+    }
+  }
+
   // presolve
   should_prune = presolveNode_(node, s_pool);
   if (should_prune) {
+    if (conflicts_) {
+      conflicts_->analyze(node, rel);
+    }
     return;
   }
 
@@ -274,6 +379,7 @@ void PCBProcessor::process(NodePtr node, RelaxationPtr rel,
 
     if (iter == 1 && !node->getParent()) {
       // in root, in first iteration, run a heuristic. XXX: better management.
+      ProfZone zone(ProfHeur);
       for (HeurVector::iterator it=heurs_.begin(); it!=heurs_.end(); ++it) {
         (*it)->solve(node, rel, s_pool);
       }
@@ -282,7 +388,7 @@ void PCBProcessor::process(NodePtr node, RelaxationPtr rel,
 
     // the node can not be pruned because of infeasibility or high cost.
     // continue processing.
-    tightenBounds_();
+    tightenBounds_(node, sol, s_pool);
     separate_(sol, node, s_pool, &sep_status);
 
 //    relaxation_->write(std::cout);
@@ -297,8 +403,11 @@ void PCBProcessor::process(NodePtr node, RelaxationPtr rel,
     } else {
       // save warm start information before branching. This step is expensive.
       ws_ = engine_->getWarmStartCopy();
-      branches_ = brancher_->findBranches(relaxation_, node, sol, s_pool, 
-                                          br_status, mods);
+      {
+        ProfZone zone(ProfBranch);
+        branches_ = brancher_->findBranches(relaxation_, node, sol, s_pool,
+                                            br_status, mods);
+      }
       if (br_status==PrunedByBrancher) {
 
         should_prune = true;
@@ -328,6 +437,9 @@ void PCBProcessor::process(NodePtr node, RelaxationPtr rel,
     cutMan_->updatePool(relaxation_,sol);
     cutMan_->updateRel(sol,relaxation_);
   } 
+  if (conflicts_) {
+    conflicts_->analyze(node, rel);
+  }
 #if 0
   if ((true==should_prune || node->getLb() >-4150) && true==xfeas) {
     std::cout << "problem here!\n";
@@ -344,26 +456,114 @@ void PCBProcessor::process(NodePtr node, RelaxationPtr rel,
 void PCBProcessor::separate_(ConstSolutionPtr sol, NodePtr node, 
                             SolutionPoolPtr s_pool, SeparationStatus *status) 
 {
-  ModVector mods;
-  HandlerIterator h;
-  ModificationConstIterator m_iter;
-  SeparationStatus st = SepaContinue;
-  bool sol_found;
+  ProfZone zone(ProfSeparate);
+  bool sol_found = false;
+
+  if (node != sepNode_) {
+    sepNode_ = node;
+    std::fill(sepTime_.begin(), sepTime_.end(), 0.0);
+  }
 
   *status = SepaContinue;
-  sol_found = false;
-  for (h = handlers_.begin(); h != handlers_.end(); ++h) {
-    (*h)->separate(sol, node, relaxation_, cutMan_, s_pool, &sol_found, &st);
-    if (st == SepaPrune) {
+  separateSome_(sol, node, s_pool, false, status, &sol_found);
+
+  // handlers that used up their time in this node are called only if no
+  // other handler could separate the point.
+  if (SepaContinue == *status && sepBudget_ > 0.0) {
+    separateSome_(sol, node, s_pool, true, status, &sol_found);
+  }
+  if (true == sol_found) {
+    ++numSolutions_;
+  }
+}
+
+
+void PCBProcessor::separateSome_(ConstSolutionPtr sol, NodePtr node,
+                                 SolutionPoolPtr s_pool, bool over_budget,
+                                 SeparationStatus *status, bool *sol_found)
+{
+  UInt nh = handlers_.size();
+  UIntVector conc, serial;
+  std::vector<SeparationStatus> st(nh, SepaContinue);
+  std::vector<int> found(nh, 0);
+  bool b, is_over;
+  double t;
+
+  for (UInt i=0; i<nh; ++i) {
+    is_over = (sepBudget_ > 0.0 && sepTime_[i] >= sepBudget_);
+    if (is_over != over_budget) {
+      continue;
+    }
+    if (sepThreads_ > 1 && handlers_[i]->isConcurrentSep()) {
+      conc.push_back(i);
+    } else {
+      serial.push_back(i);
+    }
+  }
+
+  if (conc.size() > 1) {
+#if USE_OPENMP
+#pragma omp parallel for num_threads(sepThreads_) schedule(dynamic, 1)
+#endif
+    for (int k=0; k<(int) conc.size(); ++k) {
+      UInt i = conc[k];
+      bool sf = false;
+      sepBufs_[i]->clear();
+      sepBufs_[i]->start();
+      handlers_[i]->separate(sol, node, relaxation_, sepBufs_[i].get(),
+                             s_pool, &sf, &(st[i]));
+      sepBufs_[i]->stop();
+      found[i] = (sf) ? 1 : 0;
+    }
+
+    for (UIntVector::iterator it=conc.begin(); it!=conc.end(); ++it) {
+      sepTime_[*it] += sepBufs_[*it]->getTime();
+      if (found[*it]) {
+        *sol_found = true;
+      }
+      if (st[*it] == SepaPrune) {
+        *status = SepaPrune;
+      } else if (st[*it] == SepaResolve && *status != SepaPrune) {
+        *status = SepaResolve;
+      }
+    }
+    if (*status == SepaPrune) {
+      for (UIntVector::iterator it=conc.begin(); it!=conc.end(); ++it) {
+        sepBufs_[*it]->clear();
+      }
+      return;
+    }
+    addBufferedCuts_(sol, conc);
+  } else {
+    // not worth spawning threads, call them in the original order.
+    serial.insert(serial.end(), conc.begin(), conc.end());
+    std::sort(serial.begin(), serial.end());
+  }
+
+  for (UIntVector::iterator it=serial.begin(); it!=serial.end(); ++it) {
+    b = false;
+    t = (sepBudget_ > 0.0) ? CutBuffer::getWallTime() : 0.0;
+    handlers_[*it]->separate(sol, node, relaxation_, cutMan_, s_pool, &b,
+                             &(st[*it]));
+    if (sepBudget_ > 0.0) {
+      sepTime_[*it] += CutBuffer::getWallTime() - t;
+    }
+    if (true == b) {
+      *sol_found = true;
+    }
+    if (st[*it] == SepaPrune) {
       *status = SepaPrune;
       break;
-    } else if (st == SepaResolve) {
+    } else if (st[*it] == SepaResolve) {
       *status = SepaResolve;
     }
   }
-  if (true == sol_found) {
-    ++numSolutions_;
-  }
+}
+
+
+void PCBProcessor::setConflictAnalyzer(ConflictAnalyzerPtr conflicts)
+{
+  conflicts_ = conflicts;
 }
 
 
@@ -373,6 +573,14 @@ void PCBProcessor::setCutManager(CutManager* cutman)
 }
 
 
+void PCBProcessor::resetRelaxation()
+{
+  if (cutMan_) {
+    cutMan_->resetRel();
+  }
+}
+
+
 bool PCBProcessor::shouldPrune_(NodePtr node, double solval, 
                                SolutionPoolPtr s_pool)
 {
@@ -485,6 +693,7 @@ bool PCBProcessor::shouldPrune_(NodePtr node, double solval,
 
 void PCBProcessor::solveRelaxation_() 
 {
+  ProfZone zone(ProfEngine);
   engineStatus_ = EngineError;
   engine_->solve();
   engineStatus_ = engine_->getStatus();
@@ -497,9 +706,96 @@ void PCBProcessor::solveRelaxation_()
 }
 
 
-void PCBProcessor::tightenBounds_() 
+void PCBProcessor::tightenBounds_(NodePtr node, ConstSolutionPtr sol,
+                                  SolutionPoolPtr s_pool)
 {
+  ProfZone zone(ProfPropagate);
+  const double *x = sol->getPrimal();
+  const double *rc = sol->getDualOfVars();
+  double cutoff = std::min(s_pool->getBestSolutionValue(), cutOff_);
+  UInt n = relaxation_->getNumVars();
+  VariablePtr v;
+
+  if (false==rcFix_ || !x || !rc || (engineStatus_!=ProvenOptimal &&
+                                     engineStatus_!=ProvenLocalOptimal)) {
+    return;
+  }
+
+  // save the root relaxation before its bounds are tightened.
+  if (!node->getParent()) {
+    rootX_.assign(x, x+n);
+    rootRc_.assign(rc, rc+n);
+    rootLb_.resize(n);
+    rootUb_.resize(n);
+    for (UInt j=0; j<n; ++j) {
+      v = relaxation_->getVariable(j);
+      rootLb_[j] = v->getLb();
+      rootUb_[j] = v->getUb();
+    }
+    rootVal_ = sol->getObjValue();
+  }
+  if (cutoff >= INFINITY) {
+    return;
+  }
+
+  for (UInt j=0; j<n; ++j) {
+    v = relaxation_->getVariable(j);
+    tightenVar_(v, x[j], v->getLb(), v->getUb(), rc[j],
+                cutoff-sol->getObjValue(), node);
+  }
+
+  // root reduced costs are valid in every node.
+  if (node->getParent() && rootVal_ > -INFINITY) {
+    n = std::min(n, (UInt) rootX_.size());
+    for (UInt j=0; j<n; ++j) {
+      tightenVar_(relaxation_->getVariable(j), rootX_[j], rootLb_[j],
+                  rootUb_[j], rootRc_[j], cutoff-rootVal_, node);
+    }
+  }
+}
 
+
+void PCBProcessor::tightenVar_(VariablePtr v, double x, double lb,
+                               double ub, double rc, double gap,
+                               NodePtr node)
+{
+  const double eps = 1e-6;
+  bool is_int = (v->getType()==Binary || v->getType()==Integer ||
+                 v->getType()==ImplBin || v->getType()==ImplInt);
+  double nb;
+  ModificationPtr mod;
+
+  if (gap < 0.0) {
+    return;
+  }
+  if (rc > eps && lb > -INFINITY && x < lb+eps) {
+    // x <= lb + gap/rc.
+    nb = lb + gap/rc;
+    if (is_int) {
+      nb = floor(nb+eps);
+    }
+    if (nb < v->getUb()-eps &&
+        (is_int || nb < v->getUb()-1e-3*(1.0+fabs(nb)))) {
+      mod = (VarBoundModPtr) new VarBoundMod(v, Upper,
+                                             std::max(nb, v->getLb()));
+    }
+  } else if (rc < -eps && ub < INFINITY && x > ub-eps) {
+    // x >= ub - gap/|rc|.
+    nb = ub + gap/rc;
+    if (is_int) {
+      nb = ceil(nb-eps);
+    }
+    if (nb > v->getLb()+eps &&
+        (is_int || nb > v->getLb()+1e-3*(1.0+fabs(nb)))) {
+      mod = (VarBoundModPtr) new VarBoundMod(v, Lower,
+                                             std::min(nb, v->getUb()));
+    }
+  }
+  if (mod) {
+    mod->applyToProblem(relaxation_);
+    node->addRMod(mod);
+    ++stats_.rc;
+  }
 }
 
 
@@ -511,7 +807,14 @@ void PCBProcessor::writeStats(std::ostream &out) const
       << me_ << "nodes optimal       = " << stats_.opt << std::endl 
       << me_ << "nodes hit ub        = " << stats_.ub << std::endl 
       << me_ << "nodes with problems = " << stats_.prob << std::endl 
+      << me_ << "rc tightenings      = " << stats_.rc << std::endl
       ;
+  if (sepThreads_ > 1) {
+    out << me_ << "duplicate cuts      = " << numDupCuts_ << std::endl;
+  }
+  if (conflicts_) {
+    conflicts_->writeStats(out);
+  }
 }
 
 
@@ -15,6 +15,7 @@
 #define MINOTAURPCBPROCESSOR_H
 
 #include "NodeProcessor.h"
+#include "CutBuffer.h"
 
 namespace Minotaur {
 
@@ -28,6 +29,7 @@ namespace Minotaur {
     UInt opt;    /// Number of times relaxation gave optimal feasible solution
     UInt prob;   /// Number of times problem ocurred in solving
     UInt proc;   /// Number of nodes processed
+    UInt rc;     /// Number of bounds tightened using reduced costs
     UInt ub;     /// Number of nodes pruned because of bound
   };
 
@@ -43,7 +45,7 @@ namespace Minotaur {
 
     public:
       /// Default constructor
-      PCBProcessor() { }
+      PCBProcessor() : numDupCuts_(0), sepBudget_(0.0), sepThreads_(1) { }
 
       /// Constructor with a given engine.
       PCBProcessor(EnvPtr env, EnginePtr engine, HandlerVector handlers_);
@@ -54,6 +56,12 @@ namespace Minotaur {
       // Add a heuristic.
       void addHeur(HeurPtr h);
 
+      // Base class method.
+      void flushDeferred(SolutionPoolPtr s_pool);
+
+      // Base class method.
+      void resetRelaxation();
+
       // True if a new solution was found while processing this node.
       bool foundNewSolution(); 
 
@@ -67,6 +75,12 @@ namespace Minotaur {
       void process(NodePtr node, RelaxationPtr rel, 
                    SolutionPoolPtr s_pool);
 
+      // Base class method.
+      void clearConflicts();
+
+      // Base class method.
+      void setConflictAnalyzer(ConflictAnalyzerPtr conflicts);
+
       void setCutManager(CutManager* cutman);
 
       // write statistics. Base class method.
@@ -88,6 +102,9 @@ namespace Minotaur {
       /// The cut manager.
       CutManager *cutMan_;
 
+      /// Learns conflicts from pruned nodes. NULL if not used.
+      ConflictAnalyzerPtr conflicts_;
+
       /// If lb is greater than cutOff_, we can prune this node.
       double cutOff_;
 
@@ -116,6 +133,9 @@ namespace Minotaur {
       /// all nodes. If 0, then never. If 4, then every fourth node, etc.
       int presFreq_;
 
+      /// Number of duplicate cuts dropped after concurrent separation.
+      UInt numDupCuts_;
+
       /// How many new solutions were found by the processor.
       UInt numSolutions_;
 
@@ -128,9 +148,47 @@ namespace Minotaur {
       /// Pointer to original problem
       ConstProblemPtr problem_;
 
+      /// If true, bounds are tightened using reduced costs in every node.
+      bool rcFix_;
+
       /// Relaxation that is processed by this processor.
       RelaxationPtr relaxation_;
 
+      /// Lower bounds of variables in the last solved root relaxation.
+      DoubleVector rootLb_;
+
+      /// Reduced costs in the last solved root relaxation.
+      DoubleVector rootRc_;
+
+      /// Upper bounds of variables in the last solved root relaxation.
+      DoubleVector rootUb_;
+
+      /// Objective value of the last solved root relaxation.
+      double rootVal_;
+
+      /// Solution of the last solved root relaxation.
+      DoubleVector rootX_;
+
+      /// Buffers that collect cuts of each handler in concurrent separation.
+      CutBufferVector sepBufs_;
+
+      /**
+       * Wall-clock time (seconds) each handler may use for separation in a
+       * node. If a handler exceeds it, it is called in the remaining rounds
+       * of this node only when no other handler finds a cut. 0 means no
+       * limit.
+       */
+      double sepBudget_;
+
+      /// Node for which sepTime_ is being accumulated.
+      NodePtr sepNode_;
+
+      /// Number of threads used for calling separators concurrently.
+      int sepThreads_;
+
+      /// Time used by each handler for separation in the current node.
+      DoubleVector sepTime_;
+
       /// Statistics
       NodeStats stats_;
 
@@ -171,8 +229,55 @@ namespace Minotaur {
       void separate_(ConstSolutionPtr sol, NodePtr node, SolutionPoolPtr s_pool, 
                      SeparationStatus *status);
 
-      // Implement NodeProcessor::tightenBounds_()
-      virtual void tightenBounds_(); 
+      /**
+       * \brief Add cuts collected by concurrent separators to the
+       * relaxation.
+       *
+       * Buffers are visited in the order of hids so that the relaxation
+       * does not depend on the order in which threads finish. A cut that
+       * is made redundant by one added earlier in the same round is
+       * dropped.
+       */
+      void addBufferedCuts_(ConstSolutionPtr sol, const UIntVector &hids);
+
+      /**
+       * \brief Call separators of handlers that are (or are not) over their
+       * time budget in this node.
+       *
+       * Handlers that allow it are called concurrently if more than one
+       * thread is available. All other handlers are then called one after
+       * another, as before.
+       */
+      void separateSome_(ConstSolutionPtr sol, NodePtr node,
+                         SolutionPoolPtr s_pool, bool over_budget,
+                         SeparationStatus *status, bool *sol_found);
+
+      /**
+       * \brief Tighten bounds of variables using reduced costs.
+       *
+       * If x_j is at its lower bound l_j with reduced cost d_j > 0 in a
+       * relaxation with value z, then x_j <= l_j + (cutoff-z)/d_j in every
+       * solution better than the cutoff. Bounds are tightened so with the
+       * reduced costs of sol, and with those of the root relaxation, which
+       * become stronger whenever the incumbent improves. The changes are
+       * added to the node as modifications.
+       */
+      virtual void tightenBounds_(NodePtr node, ConstSolutionPtr sol,
+                                  SolutionPoolPtr s_pool);
+
+      /**
+       * \brief Tighten a bound of variable v using reduced cost rc.
+       *
+       * \param[in] v The variable of the relaxation.
+       * \param[in] x Value of v in the relaxation solution.
+       * \param[in] lb Lower bound of v when the relaxation was solved.
+       * \param[in] ub Upper bound of v when the relaxation was solved.
+       * \param[in] rc Reduced cost of v.
+       * \param[in] gap Cutoff minus the value of the relaxation.
+       * \param[in] node The node to which modifications are added.
+       */
+      void tightenVar_(VariablePtr v, double x, double lb, double ub,
+                       double rc, double gap, NodePtr node);
 
   };
 
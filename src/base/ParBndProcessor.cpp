@@ -23,6 +23,7 @@
 #include "Node.h"
 #include "Option.h"
 #include "Modification.h"
+#include "Profiler.h"
 #include "Relaxation.h"
 #include "SolutionPool.h"
 
@@ -220,8 +221,11 @@ void ParBndProcessor::process(NodePtr node, RelaxationPtr rel,
 
     //save warm start information before branching. This step is expensive.
     ws_ = engine_->getWarmStartCopy();
-    branches_ = brancher_->findBranches(relaxation_, node, sol, s_pool, 
-                                        br_status, mods);
+    {
+      ProfZone zone(ProfBranch);
+      branches_ = brancher_->findBranches(relaxation_, node, sol, s_pool,
+                                          br_status, mods);
+    }
     if (br_status==PrunedByBrancher) {
 
       should_prune = true;
@@ -360,6 +364,7 @@ bool ParBndProcessor::shouldPrune_(NodePtr node, double solval,
 
 void ParBndProcessor::solveRelaxation_() 
 {
+  ProfZone zone(ProfEngine);
   engineStatus_ = EngineError;
   engine_->solve();
   engineStatus_ = engine_->getStatus();
@@ -18,6 +18,7 @@
 #include <omp.h>
 #endif
 #include "MinotaurConfig.h"
+#include "BabCheckpoint.h"
 #include "Brancher.h"
 #include "Environment.h"
 #include "Heuristic.h"
@@ -31,6 +32,7 @@
 #include "ParNodeIncRelaxer.h"
 #include "ParTreeManager.h"
 #include "Problem.h"
+#include "Profiler.h"
 #include "Relaxation.h"
 #include "Solution.h"
 #include "SolutionPool.h"
@@ -77,11 +79,13 @@ ParBranchAndBound::ParBranchAndBound(EnvPtr env, ProblemPtr p)
   tm_ = (ParTreeManagerPtr) new ParTreeManager(env);
   options_ = (ParBabOptionsPtr) new ParBabOptions(env);
   logger_ = (LoggerPtr) new Logger(options_->logLevel);
+  ckpt_ = (BabCheckpointPtr) new BabCheckpoint(env, p);
 }
 
 
 ParBranchAndBound::~ParBranchAndBound()
 {
+  ckpt_.reset();
   options_.reset();
   logger_.reset();
   nodePrcssr_.reset();
@@ -105,6 +109,25 @@ void ParBranchAndBound::addPreRootHeur(HeurPtr h)
 }
 
 
+void ParBranchAndBound::checkpoint_(NodePtr current_node[],
+                                    UInt numThreads,
+                                    ParNodeIncRelaxerPtr parNodeRlxr0,
+                                    ParBndProcessorPtr nodePrcssr0)
+{
+  NodePtrVector nodes;
+
+  tm_->getOpenNodes(&nodes);
+  for (UInt j=0; j<numThreads; ++j) {
+    if (current_node[j]) {
+      nodes.push_back(current_node[j]);
+    }
+  }
+  ckpt_->write(nodes, parNodeRlxr0->getRelaxation(),
+               solPool_->getBestSolution(), nodePrcssr0->getBrancher(),
+               stats_->nodesProc, 0, timer_->query());
+}
+
+
 double ParBranchAndBound::getPerGap() 
 { 
   return tm_->getPerGap(); 
@@ -281,6 +304,7 @@ NodePtr ParBranchAndBound::processRoot_(bool *should_prune, bool *should_dive,
   } else {
     rel = parNodeRlxr0->getRelaxation();
   }
+  ckpt_->setRoot(rel);
 
   // solve the root node
 #if SPEW
@@ -349,6 +373,63 @@ readSerialOutput(const char* myFile)
 }
 
 
+NodePtr ParBranchAndBound::resume_(ParNodeIncRelaxerPtr parNodeRlxr[],
+                                   ParBndProcessorPtr nodePrcssr[],
+                                   UInt numThreads, bool *initialized)
+{
+  NodePtr root = (NodePtr) new Node();
+  NodePtr current_node = NodePtr(); // NULL
+  NodePtrVector nodes;
+  RelaxationPtr rel, reli;
+  const DoubleVector &state = ckpt_->getBrancherState();
+  bool prune = false;
+
+  if (ckpt_->getIncumbent()) {
+    solPool_->addSolution(ckpt_->getIncumbent(),
+                          ckpt_->getIncumbentValue());
+    tm_->setUb(solPool_->getBestSolutionValue());
+  }
+  ckpt_->restoreBounds(RelaxationPtr());
+  stats_->nodesProc = ckpt_->getNodesProc();
+
+  tm_->insertRoot(root);
+  if (options_->createRoot == true) {
+    rel = parNodeRlxr[0]->createRootRelaxation(root, prune);
+    rel->setProblem(problem_);
+  } else {
+    rel = parNodeRlxr[0]->getRelaxation();
+  }
+  tm_->removeActiveNode(root);
+  if (!prune) {
+    ckpt_->setRoot(rel);
+    for (UInt i=0; i<numThreads; ++i) {
+      reli = (0==i) ? rel : parNodeRlxr[i]->getRelaxation();
+      ckpt_->restoreBounds(reli);
+      ckpt_->addCuts(reli);
+      initialized[i] = nodePrcssr[i]->getBrancher()->loadState(state) &&
+        !state.empty();
+    }
+    ckpt_->getNodes(root, rel, &nodes);
+    for (NodePtrVector::iterator it=nodes.begin(); it!=nodes.end(); ++it) {
+      tm_->insertSaved(*it);
+    }
+  }
+  if (nodes.empty()) {
+    parNodeRlxr[0]->reset(root, false);
+    tm_->pruneNode(root);
+  } else {
+    current_node = tm_->getCandidate();
+    if (current_node) {
+      tm_->removeActiveNode(current_node);
+    }
+  }
+
+  tm_->updateLb();
+  showStatus_(false);
+  return current_node;
+}
+
+
 void ParBranchAndBound::setLogLevel(LogLevel level) 
 {
   logger_->setMaxLevel(level);
@@ -569,6 +650,7 @@ void ParBranchAndBound::parsolve(ParNodeIncRelaxerPtr parNodeRlxr[],
 
   // initialize timer
   timer_->start();
+  Profiler::start(env_);
 
   logger_->msgStream(LogInfo) << me_ << "starting branch-and-bound ";
   if(numThreads > 1) {
@@ -596,13 +678,20 @@ void ParBranchAndBound::parsolve(ParNodeIncRelaxerPtr parNodeRlxr[],
 
   // call heuristics before the root, if needed 
   for (HeurVector::iterator it=preHeurs_.begin(); it!=preHeurs_.end(); ++it) {
+    ProfZone zone(ProfHeur);
     (*it)->solve(current_node[0], rel[0], solPool_);
   }
   tm_->setUb(solPool_->getBestSolutionValue());
 
-  // do the root
-  current_node[0] = processRoot_(&should_prune[0], &dived_prev[0],
-                                 parNodeRlxr[0], nodePrcssr[0], ws[0]);
+  // do the root, or resume from a checkpoint.
+  if (ckpt_->shouldResume() && ckpt_->read()) {
+    current_node[0] = resume_(parNodeRlxr, nodePrcssr, numThreads,
+                              initialized);
+  } else {
+    current_node[0] = processRoot_(&should_prune[0], &dived_prev[0],
+                                   parNodeRlxr[0], nodePrcssr[0], ws[0]);
+    initialized[0] = true; // pseudoCosts for thread0 initialized in root
+  }
 
   // stop if done
   if (!current_node[0]) { 
@@ -621,6 +710,9 @@ void ParBranchAndBound::parsolve(ParNodeIncRelaxerPtr parNodeRlxr[],
     nodeCount = 0;
   } else if (shouldStopPar_(wallTimeStart, tm_->getLb())) {
     tm_->updateLb();
+    if (ckpt_->isOn()) {
+      checkpoint_(current_node, numThreads, parNodeRlxr[0], nodePrcssr[0]);
+    }
     nodeCount = 1;
   } else {
 #if SPEW
@@ -633,7 +725,6 @@ void ParBranchAndBound::parsolve(ParNodeIncRelaxerPtr parNodeRlxr[],
 
   // solve root outside the loop. save the useful information.
   bool shouldRun = true;
-  initialized[0] = true; //pseudoCosts for thread0 initialized while doing root
 
   while(nodeCount > 0 && shouldRun) {
 #if SPEW
@@ -923,12 +1014,21 @@ void ParBranchAndBound::parsolve(ParNodeIncRelaxerPtr parNodeRlxr[],
         } else if (shouldStopPar_(wallTimeStart, treeLb)) {
           tm_->updateLb();
           shouldRun = false;
+          if (ckpt_->isOn()) {
+            checkpoint_(current_node, numThreads, parNodeRlxr[0],
+                        nodePrcssr[0]);
+          }
         } else {
 #if SPEW
           logger_->msgStream(LogDebug) << std::setprecision(8)
             << me_ << "lb = " << tm_->updateLb() << std::endl 
             << me_ << "ub = " << tm_->getUb() << std::endl;
 #endif
+          // all threads wait here, so that the tree does not change.
+          if (ckpt_->isDue(timer_->query())) {
+            checkpoint_(current_node, numThreads, parNodeRlxr[0],
+                        nodePrcssr[0]);
+          }
         }
       } //omp master/single ended
     }   //parallel region ends
@@ -950,6 +1050,7 @@ void ParBranchAndBound::parsolve(ParNodeIncRelaxerPtr parNodeRlxr[],
 
   stats_->timeUsed = timer_->query();
   timer_->stop();
+  Profiler::finish(env_);
 
   delete[] should_dive;
   delete[] dived_prev;
@@ -981,6 +1082,7 @@ void ParBranchAndBound::writeStats(std::ostream &out)
     (*it)->writeStats(out);
   }
   solPool_->writeStats(out);
+  Profiler::writeStats(out);
 }
 
 void ParBranchAndBound::writeParStats(std::ostream &out, ParBndProcessorPtr nodePrcssr[])
@@ -996,6 +1098,7 @@ void ParBranchAndBound::writeParStats(std::ostream &out, ParBndProcessorPtr node
     (*it)->writeStats(out);
   }
   solPool_->writeStats(out);
+  Profiler::writeStats(out);
 }
 
 double ParBranchAndBound::totalTime()
@@ -20,6 +20,7 @@ namespace Minotaur {
 
   struct  ParBabOptions;
   struct  ParBabStats;
+  class   BabCheckpoint;
   class   Engine;
   class   NodeProcessor;
   class   NodeRelaxer;
@@ -31,6 +32,7 @@ namespace Minotaur {
   class   SolutionPool;
   class   WarmStart;
   class   Timer;
+  typedef boost::shared_ptr <BabCheckpoint> BabCheckpointPtr;
   typedef boost::shared_ptr <Engine> EnginePtr;
   typedef boost::shared_ptr <ParBabOptions> ParBabOptionsPtr;
   typedef boost::shared_ptr <NodeProcessor> NodeProcessorPtr;
@@ -217,6 +219,9 @@ namespace Minotaur {
     }
 
   private:
+    /// Saves the state of the search and resumes it.
+    BabCheckpointPtr ckpt_;
+
     /// Pointer to the enviroment.
     EnvPtr env_;
 
@@ -268,6 +273,20 @@ namespace Minotaur {
     /// The TreeManager used to manage the search tree.
     ParTreeManagerPtr tm_;
 
+    /**
+     * \brief Save the open nodes and other state in a checkpoint. Cuts and
+     * pseudo costs are taken from the first thread.
+     *
+     * \param [in] current_node Nodes that threads will process next. They
+     * are not in the tree manager. Entries may be NULL.
+     * \param [in] numThreads Number of threads.
+     * \param [in] parNodeRlxr0 Relaxer of the first thread.
+     * \param [in] nodePrcssr0 Node processor of the first thread.
+     */
+    void checkpoint_(NodePtr current_node[], UInt numThreads,
+                     ParNodeIncRelaxerPtr parNodeRlxr0,
+                     ParBndProcessorPtr nodePrcssr0);
+
     /**
      * \brief Process the root node.
      *
@@ -289,6 +308,23 @@ namespace Minotaur {
                          ParNodeIncRelaxerPtr parNodeRlxr,
                          ParBndProcessorPtr nodePrcssr, WarmStartPtr ws);
 
+    /**
+     * \brief Resume the search from a checkpoint that has been read,
+     * instead of processing the root. The incumbent and the saved open
+     * nodes are restored, and the cuts and pseudo costs are added to the
+     * relaxation and the brancher of every thread.
+     *
+     * \param [in] parNodeRlxr Relaxers of all threads.
+     * \param [in] nodePrcssr Node processors of all threads.
+     * \param [in] numThreads Number of threads.
+     * \param [out] initialized True for threads whose pseudo costs were
+     * restored.
+     * \return The first node to process. It is removed from the tree
+     * manager. NULL if no open node was saved.
+     */
+    NodePtr resume_(ParNodeIncRelaxerPtr parNodeRlxr[],
+                    ParBndProcessorPtr nodePrcssr[], UInt numThreads,
+                    bool *initialized);
 
     /// Return True if a node can be pruned.
     bool shouldPrune_(NodePtr node);
@@ -19,6 +19,7 @@
 #include "Node.h"
 #include "ParNodeIncRelaxer.h"
 #include "Option.h"
+#include "Profiler.h"
 #include "Relaxation.h"
 
 using namespace Minotaur;
@@ -45,6 +46,7 @@ ParNodeIncRelaxer::~ParNodeIncRelaxer ()
 
 RelaxationPtr ParNodeIncRelaxer::createRootRelaxation(NodePtr, bool &prune)
 {
+  ProfZone zone(ProfRelax);
   prune = false;
   rel_ = (RelaxationPtr) new Relaxation();
   for (HandlerIterator h = handlers_.begin(); h != handlers_.end() && !prune; 
@@ -91,6 +93,7 @@ void ParNodeIncRelaxer::setModFlag(bool mod_prob)
 RelaxationPtr ParNodeIncRelaxer::createNodeRelaxation(NodePtr node, bool dived, 
                                                    bool &prune)
 {
+  ProfZone zone(ProfRelax);
   NodePtr t_node; // temporary
   WarmStartPtr ws;
   prune = false;
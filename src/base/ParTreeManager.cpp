@@ -19,6 +19,7 @@
 #include "NodeStack.h"
 #include "Operations.h"
 #include "Option.h"
+#include "Profiler.h"
 #include "Timer.h"
 #include "ParTreeManager.h"
 
@@ -98,6 +99,7 @@ bool ParTreeManager::anyActiveNodesLeft()
 
 NodePtr ParTreeManager::branch(Branches branches, NodePtr node, WarmStartPtr ws)
 {
+  ProfZone zone(ProfBranch);
   BranchPtr branch_p;
   NodePtr new_cand = NodePtr(); // NULL
   NodePtr child;
@@ -162,6 +164,7 @@ UInt ParTreeManager::getActiveNodes() const
 
 NodePtr ParTreeManager::getCandidate()
 {
+  ProfZone zone(ProfNodeSel);
   NodePtr node = NodePtr(); // NULL
   aNode_.reset();
   while (active_nodes_->getSize() > 0) {
@@ -191,6 +194,12 @@ double ParTreeManager::getCutOff()
 }
 
 
+void ParTreeManager::getOpenNodes(NodePtrVector *nodes)
+{
+  active_nodes_->getNodes(nodes);
+}
+
+
 double ParTreeManager::getPerGap()
 {
   // for minimization problems, gap = (ub - lb)/(ub) * 100
@@ -303,6 +312,20 @@ void ParTreeManager::insertRoot(NodePtr node)
 }
 
 
+void ParTreeManager::insertSaved(NodePtr node)
+{
+  assert(size_>0);
+  node->setId(size_);
+  ++size_;
+  active_nodes_->push(node);
+  if (doVbc_) {
+    vbcFile_ << toClockTime(timer_->query()) << " N "
+      << node->getParent()->getId()+1 << " " << node->getId()+1
+      << " " << VbcActive << std::endl;
+  }
+}
+
+
 void ParTreeManager::pruneNode(NodePtr node)
 {
   // XXX: if required do something before deleting the node.
@@ -101,6 +101,12 @@ namespace Minotaur {
      */
     double getLb();
 
+    /**
+     * \brief Append all nodes in the store of active nodes to nodes. Nodes
+     * that threads are diving into are not included.
+     */
+    void getOpenNodes(NodePtrVector *nodes);
+
     /// Return the best known upper bound.
     double getUb();
 
@@ -127,6 +133,14 @@ namespace Minotaur {
      */
     void insertRoot(NodePtr node);
 
+    /**
+     * \brief Insert a node that was saved in a checkpoint. Its parent must
+     * be the root. Its depth and lower bound are not changed.
+     *
+     * \param[in] node The node to be inserted.
+     */
+    void insertSaved(NodePtr node);
+
     /**
      * \brief Prune a given node from the tree
      *
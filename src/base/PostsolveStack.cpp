@@ -0,0 +1,329 @@
+//
+//     MINOTAUR -- It's only 1/2 bull
+//
+//     (C)opyright 2008 - 2014 The MINOTAUR Team.
+//
+
+/**
+ * \file PostsolveStack.cpp
+ * \brief Define the PostsolveStack class that records reductions of
+ * presolve and undoes them for primal and dual solutions.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#include "MinotaurConfig.h"
+#include "Constraint.h"
+#include "Function.h"
+#include "LinearFunction.h"
+#include "Objective.h"
+#include "PostsolveStack.h"
+#include "Problem.h"
+#include "Variable.h"
+
+using namespace Minotaur;
+
+const std::string PostsolveStack::me_ = "PostsolveStack: ";
+
+
+PostsolveStack::PostsolveStack(ConstProblemPtr p)
+  : m_(p->getNumCons()),
+    mSlots_(p->getNumCons()),
+    n_(p->getNumVars())
+{
+  UInt i;
+
+  colDone_.assign(n_, false);
+  i = 0;
+  for (VariableConstIterator it=p->varsBegin(); it!=p->varsEnd(); ++it, ++i) {
+    if ((*it)->getId() >= varIdx_.size()) {
+      varIdx_.resize((*it)->getId()+1, n_);
+    }
+    varIdx_[(*it)->getId()] = i;
+  }
+  i = 0;
+  for (ConstraintConstIterator it=p->consBegin(); it!=p->consEnd();
+       ++it, ++i) {
+    if ((*it)->getId() >= conSlot_.size()) {
+      conSlot_.resize((*it)->getId()+1, 0);
+    }
+    conSlot_[(*it)->getId()] = i+1;
+  }
+  beg_.push_back(0);
+  vbeg_.push_back(0);
+}
+
+
+PostsolveStack::~PostsolveStack()
+{
+  beg_.clear();
+  ind_.clear();
+  types_.clear();
+  val_.clear();
+  vbeg_.clear();
+}
+
+
+void PostsolveStack::addCol_(VariablePtr v, ConstraintPtr skip)
+{
+  LinearFunctionPtr lf;
+
+  for (ConstrSet::iterator it=v->consBegin(); it!=v->consEnd(); ++it) {
+    lf = (*it)->getLinearFunction();
+    if (*it!=skip && lf) {
+      ind_.push_back(getSlot_((*it)->getId()));
+      val_.push_back(lf->getWeight(v));
+    }
+  }
+}
+
+
+bool PostsolveStack::fixCol(VariablePtr v, double val, ConstProblemPtr p)
+{
+  UInt j = getIdx_(v->getId());
+  LinearFunctionPtr olf;
+
+  if (j>=n_) {
+    return false;
+  } else if (true==colDone_[j]) {
+    return true;
+  }
+  if (p->getObjective()) {
+    olf = p->getObjective()->getLinearFunction();
+  }
+
+  ind_.push_back(j);
+  val_.push_back(val);
+  val_.push_back((olf) ? olf->getWeight(v) : 0.0);
+  addCol_(v, ConstraintPtr());
+
+  types_.push_back(PsFixCol);
+  beg_.push_back(ind_.size());
+  vbeg_.push_back(val_.size());
+  colDone_[j] = true;
+  return true;
+}
+
+
+UInt PostsolveStack::getIdx_(UInt id) const
+{
+  return (id<varIdx_.size()) ? varIdx_[id] : n_;
+}
+
+
+UInt PostsolveStack::getSize() const
+{
+  return types_.size();
+}
+
+
+UInt PostsolveStack::getSlot_(UInt id)
+{
+  if (id>=conSlot_.size()) {
+    conSlot_.resize(id+1, 0);
+  }
+  if (0==conSlot_[id]) {
+    ++mSlots_;
+    conSlot_[id] = mSlots_;
+  }
+  return conSlot_[id]-1;
+}
+
+
+PostsolveStackPtr PostsolveStack::get(PreModQ *mods, ConstProblemPtr p)
+{
+  PostsolveStackPtr stack;
+
+  for (PreModQ::iterator it=mods->begin(); it!=mods->end(); ++it) {
+    stack = boost::dynamic_pointer_cast<PostsolveStack>(*it);
+    if (stack) {
+      return stack;
+    }
+  }
+  stack = (PostsolveStackPtr) new PostsolveStack(p);
+  mods->push_back(stack);
+  return stack;
+}
+
+
+void PostsolveStack::postsolveGetDual(ConstProblemPtr p, const double *y,
+                                      const double *rc, DoubleVector *newy,
+                                      DoubleVector *newrc)
+{
+  UInt id, i, j, q, b, e;
+  double d;
+
+  newy->assign(mSlots_, 0.0);
+  newrc->assign(n_, 0.0);
+  i = 0;
+  for (ConstraintConstIterator it=p->consBegin(); it!=p->consEnd();
+       ++it, ++i) {
+    id = (*it)->getId();
+    if (id<conSlot_.size() && conSlot_[id]>0) {
+      (*newy)[conSlot_[id]-1] = y[i];
+    }
+  }
+  i = 0;
+  for (VariableConstIterator it=p->varsBegin(); it!=p->varsEnd(); ++it, ++i) {
+    j = getIdx_((*it)->getId());
+    if (j<n_) {
+      (*newrc)[j] = rc[i];
+    }
+  }
+
+  for (UInt k=types_.size(); k>0; --k) {
+    b = beg_[k-1];
+    e = beg_[k];
+    j = ind_[b];
+    switch (types_[k-1]) {
+    case PsFixCol:
+      // rc_j = c_j - sum_i a_ij y_i.
+      d = val_[vbeg_[k-1]+1];
+      for (i=b+1; i<e; ++i) {
+        d -= val_[vbeg_[k-1]+1+i-b]*(*newy)[ind_[i]];
+      }
+      (*newrc)[j] = d;
+      break;
+    case PsSubstCol:
+      // rc_j = 0, so y_r = (c_j - sum_{i!=r} a_ij y_i)/a_rj.
+      q = ind_[b+2];
+      d = val_[vbeg_[k-1]+2];
+      for (i=b+3+q; i<e; ++i) {
+        d -= val_[vbeg_[k-1]+2+i-b]*(*newy)[ind_[i]];
+      }
+      (*newy)[ind_[b+1]] = d/val_[vbeg_[k-1]+1];
+      (*newrc)[j] = 0.0;
+      break;
+    default:
+      break;
+    }
+  }
+  newy->resize(m_);
+}
+
+
+void PostsolveStack::postsolveGetX(const DoubleVector &x, DoubleVector *newx)
+{
+  UInt b, j, q, vb;
+  double d;
+
+  assert(x.size()==n_);
+  *newx = x;
+  for (UInt k=types_.size(); k>0; --k) {
+    b = beg_[k-1];
+    vb = vbeg_[k-1];
+    j = ind_[b];
+    switch (types_[k-1]) {
+    case PsFixCol:
+      (*newx)[j] = val_[vb];
+      break;
+    case PsSubstCol:
+      q = ind_[b+2];
+      d = val_[vb];
+      for (UInt i=b+3; i<b+3+q; ++i) {
+        d -= val_[vb+2+i-b]*(*newx)[ind_[i]];
+      }
+      d /= val_[vb+1];
+      (*newx)[j] = std::max(val_[vb+3], std::min(val_[vb+4], d));
+      break;
+    default:
+      break;
+    }
+  }
+}
+
+
+bool PostsolveStack::substCol(VariablePtr v, ConstraintPtr c, double b,
+                              ConstProblemPtr p)
+{
+  UInt j = getIdx_(v->getId());
+  LinearFunctionPtr lf = c->getLinearFunction();
+  LinearFunctionPtr olf;
+  UInt q = 0;
+
+  if (j>=n_ || true==colDone_[j] || Linear!=c->getFunctionType() ||
+      fabs(lf->getWeight(v)) <= 0.0) {
+    return false;
+  }
+  for (VariableGroupConstIterator it=lf->termsBegin(); it!=lf->termsEnd();
+       ++it) {
+    if (it->first!=v && getIdx_(it->first->getId())>=n_) {
+      return false;
+    }
+  }
+  if (p->getObjective()) {
+    olf = p->getObjective()->getLinearFunction();
+  }
+
+  ind_.push_back(j);
+  ind_.push_back(getSlot_(c->getId()));
+  ind_.push_back(0);
+  val_.push_back(b);
+  val_.push_back(lf->getWeight(v));
+  val_.push_back((olf) ? olf->getWeight(v) : 0.0);
+  val_.push_back(v->getLb());
+  val_.push_back(v->getUb());
+  for (VariableGroupConstIterator it=lf->termsBegin(); it!=lf->termsEnd();
+       ++it) {
+    if (it->first!=v) {
+      ind_.push_back(getIdx_(it->first->getId()));
+      val_.push_back(it->second);
+      ++q;
+    }
+  }
+  ind_[beg_.back()+2] = q;
+  addCol_(v, c);
+
+  types_.push_back(PsSubstCol);
+  beg_.push_back(ind_.size());
+  vbeg_.push_back(val_.size());
+  colDone_[j] = true;
+  return true;
+}
+
+
+void PostsolveStack::write(std::ostream &out) const
+{
+  UInt b, e, vb;
+
+  out << me_ << "reductions = " << types_.size() << std::endl;
+  for (UInt k=0; k<types_.size(); ++k) {
+    b = beg_[k];
+    e = beg_[k+1];
+    vb = vbeg_[k];
+    switch (types_[k]) {
+    case PsFixCol:
+      out << "fix x" << ind_[b] << " = " << val_[vb] << ", rows";
+      for (UInt i=b+1; i<e; ++i) {
+        out << " " << ind_[i];
+      }
+      out << std::endl;
+      break;
+    case PsSubstCol:
+      out << "x" << ind_[b] << " from row " << ind_[b+1] << " = ("
+          << val_[vb];
+      for (UInt i=b+3; i<b+3+ind_[b+2]; ++i) {
+        out << " - " << val_[vb+2+i-b] << "*x" << ind_[i];
+      }
+      out << ")/" << val_[vb+1] << std::endl;
+      break;
+    default:
+      break;
+    }
+  }
+}
+
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
@@ -0,0 +1,202 @@
+//
+//     MINOTAUR -- It's only 1/2 bull
+//
+//     (C)opyright 2008 - 2014 The MINOTAUR Team.
+//
+
+/**
+ * \file PostsolveStack.h
+ * \brief Declare the PostsolveStack class that records reductions of
+ * presolve and undoes them for primal and dual solutions.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#ifndef MINOTAURPOSTSOLVESTACK_H
+#define MINOTAURPOSTSOLVESTACK_H
+
+#include "PreMod.h"
+
+namespace Minotaur {
+
+  class Constraint;
+  class Problem;
+  class Variable;
+  typedef boost::shared_ptr<Constraint> ConstraintPtr;
+  typedef boost::shared_ptr<const Problem> ConstProblemPtr;
+  typedef boost::shared_ptr<Variable> VariablePtr;
+  typedef boost::shared_ptr<PreMod> PreModPtr;
+  typedef std::deque<PreModPtr> PreModQ;
+
+  /// Types of reductions that can be saved in a PostsolveStack.
+  typedef enum {
+    PsFixCol,   /// A variable was fixed and deleted.
+    PsSubstCol  /// A variable was removed together with a constraint.
+  } PostsolveType;
+
+  class PostsolveStack;
+  typedef boost::shared_ptr<PostsolveStack> PostsolveStackPtr;
+
+  /**
+   * \brief A log of reductions of presolve, with enough data to undo each
+   * one for the primal and the dual solution.
+   *
+   * Variables and constraints are identified by their ids, which do not
+   * change when other variables or constraints are deleted. Each reduction
+   * is saved in the index space of the problem that was given to the
+   * constructor, the original problem. Constraints added later get new
+   * slots after the original ones. The log is flat: reduction k uses
+   * entries beg_[k] to beg_[k+1]-1 of ind_ and vbeg_[k] to vbeg_[k+1]-1 of
+   * val_:
+   *
+   * - PsFixCol, x_j fixed at value v. ind_: j, i_1 ... i_p; val_: v, c_j,
+   *   a_{i_1 j} ... a_{i_p j}, where i_1 ... i_p are the rows that contain
+   *   x_j.
+   * - PsSubstCol, x_j removed with row r. It is restored to (b - sum_k
+   *   a_{rk} x_k)/a_{rj}, moved into [l_j, u_j], where b is a side of r.
+   *   ind_: j, r, q, k_1 ... k_q, i_1 ... i_p; val_: b, a_{rj}, c_j, l_j,
+   *   u_j, a_{r k_1} ... a_{r k_q}, a_{i_1 j} ... a_{i_p j}, where i_1 ...
+   *   i_p are the other rows that contain x_j before it is removed. This
+   *   covers substitution using an equality, e.g. aggregation of a
+   *   doubleton equation, and a free column singleton.
+   *
+   * Reductions are undone in the reverse order in O(size of the log). The
+   * duals follow the convention that the reduced cost of x_j is c_j - sum_i
+   * a_{ij} y_i. They are restored exactly for linear constraints and the
+   * linear part of the objective.
+   *
+   * The stack is kept in the queue of PreMod objects of the presolver so
+   * that handlers can find it. Since its indices are those of the original
+   * problem, the presolver moves it to the back of the queue.
+   */
+  class PostsolveStack : public PreMod {
+    public:
+      /// Constructor. The variables and constraints of p are the original.
+      PostsolveStack(ConstProblemPtr p);
+
+      /// Destroy.
+      ~PostsolveStack();
+
+      /**
+       * \brief Find the stack in a queue of presolve modifications. If
+       * there is none, create one for p and add it at the back.
+       */
+      static PostsolveStackPtr get(PreModQ *mods, ConstProblemPtr p);
+
+      /**
+       * \brief Save that variable v of problem p is fixed at val and will
+       * be deleted. Must be called before v is removed from its
+       * constraints.
+       *
+       * \return False if v is not a variable of the original problem and
+       * the reduction is not saved. True if it is saved, or if v was
+       * already removed by an earlier saved reduction.
+       */
+      bool fixCol(VariablePtr v, double val, ConstProblemPtr p);
+
+      /**
+       * \brief Save that variable v of problem p is removed together with
+       * the linear constraint c, or with its side b. Must be called before
+       * the problem is changed.
+       *
+       * The caller must make sure that a value of v in its bounds that
+       * satisfies the side b of c, given the other variables, makes c
+       * feasible.
+       *
+       * \return False if the reduction can not be saved, i.e. if c is not
+       * linear or has a variable that is not in the original problem. The
+       * reduction must then not be made.
+       */
+      bool substCol(VariablePtr v, ConstraintPtr c, double b,
+                    ConstProblemPtr p);
+
+      /// Return the number of reductions saved.
+      UInt getSize() const;
+
+      /**
+       * \brief Restore the values of the variables removed by saved
+       * reductions. x has the values of all the original variables.
+       */
+      void postsolveGetX(const DoubleVector &x, DoubleVector *newx);
+
+      /**
+       * \brief Restore the duals of the original problem from those of the
+       * presolved problem.
+       *
+       * \param[in] p The presolved problem.
+       * \param[in] y Duals of the constraints of p.
+       * \param[in] rc Reduced costs of the variables of p.
+       * \param[out] newy Duals of the constraints of the original problem.
+       * \param[out] newrc Reduced costs of the variables of the original
+       * problem.
+       */
+      void postsolveGetDual(ConstProblemPtr p, const double *y,
+                            const double *rc, DoubleVector *newy,
+                            DoubleVector *newrc);
+
+      /// Write the log.
+      void write(std::ostream &out) const;
+
+    private:
+      friend class ProblemSnapshot;
+
+      /// Start of each reduction in ind_, and the end of the last.
+      UIntVector beg_;
+
+      /// colDone_[j] is true if original variable j was removed.
+      BoolVector colDone_;
+
+      /**
+       * Slot of the constraint with a given id, plus one. Zero if the
+       * constraint has no slot. Slots m_ and more are for new constraints.
+       */
+      UIntVector conSlot_;
+
+      /// Indices in the log.
+      UIntVector ind_;
+
+      /// For logging.
+      static const std::string me_;
+
+      /// Number of constraints in the original problem.
+      UInt m_;
+
+      /// Number of slots for constraints: original and new ones.
+      UInt mSlots_;
+
+      /// Number of variables in the original problem.
+      UInt n_;
+
+      /// Type of each reduction.
+      std::vector<PostsolveType> types_;
+
+      /// Values in the log.
+      DoubleVector val_;
+
+      /// Start of each reduction in val_, and the end of the last.
+      UIntVector vbeg_;
+
+      /// Index in the original problem of the variable with a given id.
+      UIntVector varIdx_;
+
+      /// Add the rows of v other than skip and their coefficients to the log.
+      void addCol_(VariablePtr v, ConstraintPtr skip);
+
+      /// Return the original index of the variable with a given id or n_.
+      UInt getIdx_(UInt id) const;
+
+      /// Return the slot of the constraint with a given id. Add if new.
+      UInt getSlot_(UInt id);
+  };
+}
+#endif
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
@@ -21,6 +21,7 @@
 #include "QuadraticFunction.h"
 #include "Objective.h"
 #include "Option.h"
+#include "PostsolveStack.h"
 #include "PreMod.h"
 #include "Presolver.h"
 #include "Problem.h"
@@ -97,6 +98,7 @@ SolveStatus Presolver::solve()
   int subiters = 0;
   int n_hand = handlers_.size();
   int last_ch_subiter = -10000;
+  PostsolveStackPtr stack = PostsolveStack::get(&mods_, problem_);
 
   env_->getLogger()->msgStream(LogInfo) << me_ << "Presolving ... "
     << std::endl;
@@ -126,6 +128,17 @@ SolveStatus Presolver::solve()
     status_ = Finished;
   }
 
+  // the stack works on indices of the original problem. undo it last.
+  for (PreModQIter m=mods_.begin(); m!=mods_.end(); ++m) {
+    if (*m==stack) {
+      mods_.erase(m);
+      break;
+    }
+  }
+  mods_.push_back(stack);
+  logger_->msgStream(LogDebug) << me_ << "reductions in postsolve stack = "
+                               << stack->getSize() << std::endl;
+
   // wrap up.
   env_->getLogger()->msgStream(LogInfo) << me_ << "Finished presolving."
     << std::endl;
@@ -250,6 +263,28 @@ void Presolver::getX(const double *x, DoubleVector *newx)
 }
 
 
+void Presolver::getDual(ConstSolutionPtr s, DoubleVector *y,
+                        DoubleVector *rc)
+{
+  PostsolveStackPtr stack;
+
+  assert(s && s->getDualOfCons() && s->getDualOfVars());
+  for (PreModQIter m=mods_.begin(); m!=mods_.end(); ++m) {
+    stack = boost::dynamic_pointer_cast<PostsolveStack>(*m);
+    if (stack) {
+      break;
+    }
+  }
+  if (stack) {
+    stack->postsolveGetDual(problem_, s->getDualOfCons(), s->getDualOfVars(),
+                            y, rc);
+  } else {
+    y->assign(s->getDualOfCons(), s->getDualOfCons()+problem_->getNumCons());
+    rc->assign(s->getDualOfVars(), s->getDualOfVars()+problem_->getNumVars());
+  }
+}
+
+
 SolutionPtr Presolver::getPostSol(SolutionPtr s)
 {
   DoubleVector  *newx = 0;
@@ -20,6 +20,7 @@ namespace Minotaur {
   class   PreMod;
   typedef boost::shared_ptr<PreMod> PreModPtr;
   typedef boost::shared_ptr<Solution> SolutionPtr;
+  typedef boost::shared_ptr<const Solution> ConstSolutionPtr;
   typedef std::deque<PreModPtr> PreModQ;
   typedef PreModQ::iterator PreModQIter;
   typedef PreModQ::const_iterator PreModQConstIter;
@@ -77,6 +78,16 @@ namespace Minotaur {
      */
     SolutionPtr getPostSol(SolutionPtr s);
 
+    /**
+     * \brief Construct duals of the constraints and reduced costs of the
+     * variables of the original problem from those of a solution of the
+     * presolved problem.
+     *
+     * Duals are restored for the reductions saved in the PostsolveStack.
+     * Constraints deleted otherwise get a zero dual.
+     */
+    void getDual(ConstSolutionPtr s, DoubleVector *y, DoubleVector *rc);
+
   protected:
     /*
      * The problem being presolved. Only one problem may be presolved by one
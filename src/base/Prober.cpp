@@ -0,0 +1,293 @@
+//
+//     MINOTAUR -- It's only 1/2 bull
+//
+//     (C)opyright 2008 - 2014 The MINOTAUR Team.
+//
+
+/**
+ * \file Prober.cpp
+ * \brief Implement the methods of class Prober.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#include "MinotaurConfig.h"
+#include "Environment.h"
+#include "Function.h"
+#include "LinearFunction.h"
+#include "Modification.h"
+#include "Problem.h"
+#include "Prober.h"
+#include "Timer.h"
+#include "VarBoundMod.h"
+#include "Variable.h"
+
+using namespace Minotaur;
+
+const std::string Prober::me_ = "Prober: ";
+
+
+Prober::Prober(EnvPtr env, ProblemPtr p, PropEnginePtr engine)
+  : eps_(1e-6),
+    engine_(engine),
+    env_(env),
+    p_(p),
+    timeLimit_(INFINITY)
+{
+  stats_.probes = 0;
+  stats_.fixed = 0;
+  stats_.bnds = 0;
+  stats_.impls = 0;
+  stats_.aggrs = 0;
+  stats_.limit = false;
+  stats_.time = 0.0;
+}
+
+
+Prober::~Prober()
+{
+  engine_.reset();
+  p_.reset();
+  table_.reset();
+}
+
+
+void Prober::aggregate_(VariablePtr x, VariablePtr y, bool comp)
+{
+  LinearFunctionPtr lf = (LinearFunctionPtr) new LinearFunction();
+
+  lf->addTerm(y, 1.0);
+  if (comp) {
+    // y + x = 1.
+    lf->addTerm(x, 1.0);
+    p_->newConstraint((FunctionPtr) new Function(lf), 1.0, 1.0);
+  } else {
+    // y - x = 0.
+    lf->addTerm(x, -1.0);
+    p_->newConstraint((FunctionPtr) new Function(lf), 0.0, 0.0);
+  }
+  ++stats_.aggrs;
+}
+
+
+bool Prober::isBin_(ConstVariablePtr v) const
+{
+  return ((v->getType()==Binary || v->getType()==Integer) &&
+          v->getLb() > -eps_ && v->getUb() < 1.0+eps_);
+}
+
+
+bool Prober::moreCons_(const VariablePtr &v1, const VariablePtr &v2)
+{
+  return (v1->getNumCons() > v2->getNumCons());
+}
+
+
+SolveStatus Prober::probe(bool *changed)
+{
+  Timer *timer = env_->getNewTimer();
+  VarVector bins;
+  VariablePtr x, y;
+  std::vector<ProbeBnd> bnds0, bnds1;
+  DoubleVector lb0, ub0;
+  UIntVector seen0;
+  BoolVector aggr;
+  bool inf0, inf1;
+  double lb, ub;
+  UInt n = p_->getNumVars();
+  SolveStatus status = Finished;
+
+  timer->start();
+  if (table_) {
+    // implications are saved by the current indices of the variables.
+    table_->setVars(p_);
+  }
+  engine_->init();
+  if (engine_->propagate(0, 0)) {
+    delete timer;
+    return SolvedInfeasible;
+  }
+
+  for (VariableConstIterator it=p_->varsBegin(); it!=p_->varsEnd(); ++it) {
+    if (isBin_(*it) && (*it)->getUb()-(*it)->getLb() > 0.5) {
+      bins.push_back(*it);
+    }
+  }
+  std::stable_sort(bins.begin(), bins.end(), moreCons_);
+
+  // bounds of the zero branch, by index. seen0[j] is the probe in which
+  // they were saved, plus one.
+  lb0.resize(n);
+  ub0.resize(n);
+  seen0.assign(n, 0);
+  aggr.assign(n, false);
+  for (UInt k=0; k<bins.size(); ++k) {
+    if (timer->query() > timeLimit_) {
+      stats_.limit = true;
+      break;
+    }
+    x = bins[k];
+    if (x->getUb()-x->getLb() < 0.5 || aggr[x->getIndex()]) {
+      continue;
+    }
+    ++stats_.probes;
+    inf0 = probeVal_(x, 0.0, bnds0);
+    inf1 = probeVal_(x, 1.0, bnds1);
+    if (inf0 && inf1) {
+      status = SolvedInfeasible;
+      break;
+    } else if (inf0 || inf1) {
+      ++stats_.fixed;
+      *changed = true;
+      if (false==setBnds_(x, inf0 ? 1.0 : 0.0, inf0 ? 1.0 : 0.0)) {
+        status = SolvedInfeasible;
+        break;
+      }
+      continue;
+    }
+
+    for (std::vector<ProbeBnd>::const_iterator it=bnds0.begin();
+         it!=bnds0.end(); ++it) {
+      lb0[it->j] = it->lb;
+      ub0[it->j] = it->ub;
+      seen0[it->j] = k+1;
+      y = p_->getVariable(it->j);
+      if (y!=x && table_ && isBin_(y) && it->ub-it->lb < 0.5) {
+        // x = 0 implies y = lb.
+        if (table_->addImplication(CliqueTable::getLit(x->getIndex(), true),
+                                   CliqueTable::getLit(it->j,
+                                                       it->lb < 0.5))) {
+          ++stats_.impls;
+        }
+      }
+    }
+    for (std::vector<ProbeBnd>::const_iterator it=bnds1.begin();
+         it!=bnds1.end(); ++it) {
+      y = p_->getVariable(it->j);
+      if (y==x) {
+        continue;
+      }
+      if (table_ && isBin_(y) && it->ub-it->lb < 0.5) {
+        if (table_->addImplication(CliqueTable::getLit(x->getIndex(), false),
+                                   CliqueTable::getLit(it->j,
+                                                       it->lb < 0.5))) {
+          ++stats_.impls;
+        }
+      }
+      if (seen0[it->j]!=k+1) {
+        continue;
+      }
+      lb = std::min(lb0[it->j], it->lb);
+      ub = std::max(ub0[it->j], it->ub);
+      if (isBin_(y) && ub-lb > 0.5 && ub0[it->j]-lb0[it->j] < 0.5 &&
+          it->ub-it->lb < 0.5) {
+        // y is fixed to different values by the two values of x.
+        if (false==aggr[it->j]) {
+          aggregate_(x, y, it->lb < 0.5);
+          aggr[it->j] = true;
+          *changed = true;
+        }
+        continue;
+      }
+      if (lb > y->getLb()+eps_ || ub < y->getUb()-eps_) {
+        ++stats_.bnds;
+        *changed = true;
+        if (false==setBnds_(y, std::max(lb, y->getLb()),
+                            std::min(ub, y->getUb()))) {
+          status = SolvedInfeasible;
+          break;
+        }
+      }
+    }
+    if (SolvedInfeasible==status) {
+      break;
+    }
+  }
+
+  stats_.time += timer->query();
+  delete timer;
+  return status;
+}
+
+
+static bool lessIndex(const VariablePtr &v1, const VariablePtr &v2)
+{
+  return (v1->getIndex() < v2->getIndex());
+}
+
+
+bool Prober::probeVal_(VariablePtr x, double val, std::vector<ProbeBnd> &bnds)
+{
+  ModVector mods;
+  ModificationPtr mod;
+  VarBoundModPtr bmod;
+  VarBoundMod2Ptr bmod2;
+  VarVector vars;
+  ProbeBnd b;
+  bool is_inf;
+
+  bnds.clear();
+  mod = (VarBoundMod2Ptr) new VarBoundMod2(x, val, val);
+  mod->applyToProblem(p_);
+  mods.push_back(mod);
+  engine_->varChanged(x);
+  is_inf = engine_->propagate(&mods, 0);
+
+  if (false==is_inf) {
+    for (ModVector::const_iterator it=mods.begin(); it!=mods.end(); ++it) {
+      bmod = boost::dynamic_pointer_cast<VarBoundMod>(*it);
+      if (bmod) {
+        vars.push_back(bmod->getVar());
+      } else {
+        bmod2 = boost::dynamic_pointer_cast<VarBoundMod2>(*it);
+        if (bmod2) {
+          vars.push_back(bmod2->getVar());
+        }
+      }
+    }
+    std::sort(vars.begin(), vars.end(), lessIndex);
+    vars.erase(std::unique(vars.begin(), vars.end()), vars.end());
+    for (VarVector::const_iterator it=vars.begin(); it!=vars.end(); ++it) {
+      b.j = (*it)->getIndex();
+      b.lb = (*it)->getLb();
+      b.ub = (*it)->getUb();
+      bnds.push_back(b);
+    }
+  }
+  engine_->undo(mods, 0);
+  return is_inf;
+}
+
+
+bool Prober::setBnds_(VariablePtr v, double lb, double ub)
+{
+  return (engine_->tighten(v, lb, ub) >= 0 &&
+          false==engine_->propagate(0, 0));
+}
+
+
+void Prober::writeStats(std::ostream &out) const
+{
+  out << me_ << "variables probed            = " << stats_.probes << std::endl
+      << me_ << "binary variables fixed      = " << stats_.fixed << std::endl
+      << me_ << "bounds tightened            = " << stats_.bnds << std::endl
+      << me_ << "implications found          = " << stats_.impls << std::endl
+      << me_ << "variables aggregated        = " << stats_.aggrs << std::endl
+      << me_ << "stopped at time limit       = " << stats_.limit << std::endl
+      << me_ << "time used                   = " << stats_.time << std::endl;
+}
+
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
@@ -0,0 +1,156 @@
+//
+//     MINOTAUR -- It's only 1/2 bull
+//
+//     (C)opyright 2008 - 2014 The MINOTAUR Team.
+//
+
+/**
+ * \file Prober.h
+ * \brief Declare class Prober for probing on binary variables.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#ifndef MINOTAURPROBER_H
+#define MINOTAURPROBER_H
+
+#include "CliqueTable.h"
+#include "PropEngine.h"
+
+namespace Minotaur {
+
+  /// Statistics of probing.
+  struct ProbeStats {
+    UInt probes;  ///< Number of variables probed.
+    UInt fixed;   ///< Number of binary variables fixed.
+    UInt bnds;    ///< Number of bounds tightened on both branches.
+    UInt impls;   ///< Number of implications found.
+    UInt aggrs;   ///< Number of variables aggregated.
+    bool limit;   ///< True if probing stopped at the time limit.
+    double time;  ///< Time spent in probing.
+  };
+
+  /**
+   * \brief Probe on binary variables of a problem at the root.
+   *
+   * Every binary variable is fixed to zero and then to one, and bounds are
+   * propagated by a PropEngine in each case. The changes are undone with
+   * PropEngine::undo(), which restores the incremental data of the
+   * propagators without recomputing it, so that a probe costs about as much
+   * as the propagation it triggers. From the two outcomes:
+   * - if one value is infeasible, the variable is fixed to the other,
+   * - a bound implied by both values is set,
+   * - a binary fixed by one value is an implication, which is added to the
+   *   clique table if one is given,
+   * - a binary fixed to opposite values by the two values is aggregated by
+   *   adding the constraint \f$y = x\f$ or \f$y = 1-x\f$. Presolve can then
+   *   substitute it.
+   *
+   * Variables are probed in decreasing order of the number of constraints
+   * they appear in, until all are probed or the time limit is reached.
+   */
+  class Prober {
+  public:
+    /**
+     * \brief Constructor.
+     *
+     * \param[in] env The environment, for timers.
+     * \param[in] p The problem. Bounds are changed and constraints are added
+     * to it.
+     * \param[in] engine A PropEngine with propagators for p. init() is
+     * called by probe().
+     */
+    Prober(EnvPtr env, ProblemPtr p, PropEnginePtr engine);
+
+    /// Destroy.
+    ~Prober();
+
+    /// Return the statistics.
+    const ProbeStats & getStats() const { return stats_; }
+
+    /**
+     * \brief Probe all binary variables that are not fixed.
+     *
+     * \param[out] changed Set to true if anything in the problem changed.
+     * \return SolvedInfeasible if the problem is found infeasible, Finished
+     * otherwise.
+     */
+    SolveStatus probe(bool *changed);
+
+    /// Record implications in this table.
+    void setCliqueTable(CliqueTablePtr table) { table_ = table; }
+
+    /// Set the limit on time used by probe(), in seconds.
+    void setTimeLimit(double t) { timeLimit_ = t; }
+
+    /// Write statistics.
+    void writeStats(std::ostream &out) const;
+
+  private:
+    /// Bounds of a variable changed in a probe.
+    struct ProbeBnd {
+      UInt j;
+      double lb;
+      double ub;
+    };
+
+    /// Tolerance.
+    double eps_;
+
+    /// The engine.
+    PropEnginePtr engine_;
+
+    /// Environment.
+    EnvPtr env_;
+
+    /// For logging.
+    static const std::string me_;
+
+    /// The problem.
+    ProblemPtr p_;
+
+    /// Statistics.
+    ProbeStats stats_;
+
+    /// The clique table in which implications are saved. May be NULL.
+    CliqueTablePtr table_;
+
+    /// Time limit.
+    double timeLimit_;
+
+    /// Add the constraint y = x, or y = 1-x if comp is true.
+    void aggregate_(VariablePtr x, VariablePtr y, bool comp);
+
+    /// Return true if v is binary.
+    bool isBin_(ConstVariablePtr v) const;
+
+    /**
+     * \brief Fix x to val, propagate, save the changed bounds and undo.
+     *
+     * \return True if fixing x to val is infeasible.
+     */
+    bool probeVal_(VariablePtr x, double val, std::vector<ProbeBnd> &bnds);
+
+    /**
+     * Change bounds of v permanently and propagate.
+     * \return False if the problem is found infeasible.
+     */
+    bool setBnds_(VariablePtr v, double lb, double ub);
+
+    /// Compare two probed variables by number of constraints.
+    static bool moreCons_(const VariablePtr &v1, const VariablePtr &v2);
+  };
+
+  typedef boost::shared_ptr<Prober> ProberPtr;
+}
+#endif
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
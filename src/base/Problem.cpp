@@ -1077,7 +1077,7 @@ ObjectivePtr Problem::newObjective(FunctionPtr f, double cb,
 SOSPtr Problem::newSOS(int n, SOSType type, const double *weights,
                        const VarVector &vars, int priority, std::string name)
 {
-  SOSPtr sos = new SOS(n, type, weights, vars, nextSId_, priority, name);
+  SOSPtr sos = new SOS(n, type, weights, vars, priority, nextSId_, name);
   ++nextSId_;
   if (SOS1 == type) {
     sos1_.push_back(sos);
@@ -0,0 +1,700 @@
+//
+//     MINOTAUR -- It's only 1/2 bull
+//
+//     (C)opyright 2008 - 2014 The MINOTAUR Team.
+//
+
+/**
+ * \file ProblemSnapshot.cpp
+ * \brief Define the ProblemSnapshot class that saves a problem in a binary
+ * file and loads it again.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <stack>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "MinotaurConfig.h"
+#include "CGraph.h"
+#include "CNode.h"
+#include "Constraint.h"
+#include "Environment.h"
+#include "Function.h"
+#include "LinearFunction.h"
+#include "Logger.h"
+#include "Objective.h"
+#include "PostsolveStack.h"
+#include "Problem.h"
+#include "ProblemSnapshot.h"
+#include "QuadraticFunction.h"
+#include "SOS.h"
+#include "Variable.h"
+
+using namespace Minotaur;
+
+const std::string ProblemSnapshot::me_ = "ProblemSnapshot: ";
+const UInt ProblemSnapshot::version_ = 1;
+
+// First bytes of a snapshot file.
+static const char snapMagic[8] = {'M', 'N', 'T', 'R', 'S', 'N', 'A', 'P'};
+
+// Written as a number to check the byte order.
+static const UInt snapOrder = 0x01020304;
+
+
+template <class T> static void snapPut(std::vector<char> *buf, T v)
+{
+  const char *c = (const char *) &v;
+  buf->insert(buf->end(), c, c+sizeof(T));
+}
+
+
+template <class T> static bool snapGet(const char **pos, const char *end,
+                                       T *v)
+{
+  if ((size_t) (end-*pos)<sizeof(T)) {
+    return false;
+  }
+  memcpy(v, *pos, sizeof(T));
+  *pos += sizeof(T);
+  return true;
+}
+
+
+template <class T> static void snapPutVec(std::vector<char> *buf,
+                                          const std::vector<T> &v)
+{
+  snapPut<UInt>(buf, v.size());
+  for (typename std::vector<T>::const_iterator it=v.begin(); it!=v.end();
+       ++it) {
+    snapPut<T>(buf, *it);
+  }
+}
+
+
+template <class T> static bool snapGetVec(const char **pos,
+                                          const char *end,
+                                          std::vector<T> *v)
+{
+  UInt n = 0;
+
+  if (!snapGet<UInt>(pos, end, &n) || (size_t) (end-*pos)<n*sizeof(T)) {
+    return false;
+  }
+  v->resize(n);
+  if (n>0) {
+    memcpy(&((*v)[0]), *pos, n*sizeof(T));
+  }
+  *pos += n*sizeof(T);
+  return true;
+}
+
+
+static void snapPutStr(std::vector<char> *buf, const std::string &s)
+{
+  snapPut<UInt>(buf, s.size());
+  buf->insert(buf->end(), s.begin(), s.end());
+}
+
+
+static bool snapGetStr(const char **pos, const char *end, std::string *s)
+{
+  UInt n = 0;
+
+  if (!snapGet<UInt>(pos, end, &n) || (size_t) (end-*pos)<n) {
+    return false;
+  }
+  s->assign(*pos, n);
+  *pos += n;
+  return true;
+}
+
+
+// True if a node with opcode op may have nc children.
+static bool snapCheckOp(UInt op, UInt nc)
+{
+  if (op>OpVar) {
+    return false;
+  }
+  switch ((OpCode) op) {
+  case OpInt:
+  case OpNum:
+  case OpVar:
+    return 0==nc;
+  case OpNone:
+    return false;
+  case OpSumList:
+    return nc>0;
+  case OpCPow:
+  case OpDiv:
+  case OpIntDiv:
+  case OpMinus:
+  case OpMult:
+  case OpPlus:
+  case OpPow:
+  case OpPowK:
+    return nc>=2;
+  default:
+    return 1==nc;
+  }
+}
+
+
+ProblemSnapshot::ProblemSnapshot(EnvPtr env)
+  : env_(env)
+{
+  logger_ = env->getLogger();
+}
+
+
+ProblemSnapshot::~ProblemSnapshot()
+{
+  stack_.reset();
+  varMap_.clear();
+}
+
+
+CGraphPtr ProblemSnapshot::getCGraph_(const char **pos, const char *end,
+                                      ProblemPtr p, bool *ok)
+{
+  UInt nnodes = 0, op = 0, nc = 0, k = 0, vi = 0;
+  double d = 0.0;
+  std::vector<CNode *> nodes, child;
+  CGraphPtr cg;
+  CNode *node;
+
+  *ok = snapGet<UInt>(pos, end, &nnodes);
+  if (!(*ok) || 0==nnodes) {
+    return cg;
+  }
+  // each node takes at least its opcode and number of children.
+  if ((size_t) (end-*pos)/(2*sizeof(UInt))<nnodes) {
+    *ok = false;
+    return cg;
+  }
+  cg = (CGraphPtr) new CGraph();
+  nodes.reserve(nnodes);
+  for (UInt i=0; i<nnodes; ++i) {
+    *ok = snapGet<UInt>(pos, end, &op) && snapGet<UInt>(pos, end, &nc) &&
+      (size_t) (end-*pos)/sizeof(UInt)>=nc && snapCheckOp(op, nc);
+    if (!(*ok)) {
+      return CGraphPtr();
+    }
+    child.assign(nc+1, 0);
+    for (UInt j=0; *ok && j<nc; ++j) {
+      *ok = snapGet<UInt>(pos, end, &k) && k<i;
+      child[j] = (*ok) ? nodes[k] : 0;
+    }
+    if (!(*ok)) {
+      return CGraphPtr();
+    }
+    if (OpVar==(OpCode) op) {
+      *ok = snapGet<UInt>(pos, end, &vi) && vi<p->getNumVars();
+      node = (*ok) ? cg->newNode(p->getVariable(vi)) : 0;
+    } else if (OpNum==(OpCode) op || OpInt==(OpCode) op) {
+      *ok = snapGet<double>(pos, end, &d);
+      node = (OpNum==(OpCode) op) ? cg->newNode(d) : cg->newNode((int) d);
+    } else if (nc>2 || OpSumList==(OpCode) op) {
+      node = cg->newNode((OpCode) op, &(child[0]), nc);
+    } else {
+      node = cg->newNode((OpCode) op, child[0], child[1]);
+    }
+    if (!(*ok)) {
+      return CGraphPtr();
+    }
+    nodes.push_back(node);
+  }
+  cg->setOut(nodes.back());
+  cg->finalize();
+  return cg;
+}
+
+
+FunctionPtr ProblemSnapshot::getFun_(const char **pos, const char *end,
+                                     ProblemPtr p, bool *ok)
+{
+  UIntVector ind, jnd;
+  DoubleVector val;
+  LinearFunctionPtr lf = LinearFunctionPtr();       // NULL
+  QuadraticFunctionPtr qf = QuadraticFunctionPtr(); // NULL
+  CGraphPtr cg;
+  UInt n = p->getNumVars();
+
+  *ok = snapGetVec<UInt>(pos, end, &ind) && snapGetVec<double>(pos, end, &val)
+    && ind.size()==val.size();
+  if (*ok && !ind.empty()) {
+    lf = (LinearFunctionPtr) new LinearFunction();
+    for (UInt i=0; *ok && i<ind.size(); ++i) {
+      *ok = ind[i]<n;
+      if (*ok) {
+        lf->appendTerm(p->getVariable(ind[i]), val[i]);
+      }
+    }
+  }
+
+  *ok = *ok && snapGetVec<UInt>(pos, end, &ind) &&
+    snapGetVec<UInt>(pos, end, &jnd) && snapGetVec<double>(pos, end, &val)
+    && ind.size()==val.size() && jnd.size()==val.size();
+  if (*ok && !ind.empty()) {
+    qf = (QuadraticFunctionPtr) new QuadraticFunction();
+    for (UInt i=0; *ok && i<ind.size(); ++i) {
+      *ok = ind[i]<n && jnd[i]<n;
+      if (*ok) {
+        qf->addTerm(p->getVariable(ind[i]), p->getVariable(jnd[i]), val[i]);
+      }
+    }
+  }
+
+  if (*ok) {
+    cg = getCGraph_(pos, end, p, ok);
+  }
+  if (!(*ok)) {
+    return FunctionPtr();
+  }
+  return (FunctionPtr) new Function(lf, qf, cg);
+}
+
+
+PostsolveStackPtr ProblemSnapshot::getPostsolveStack() const
+{
+  return stack_;
+}
+
+
+bool ProblemSnapshot::getStack_(const char **pos, const char *end,
+                                ProblemPtr p)
+{
+  UIntVector types, done;
+  PostsolveStackPtr st = (PostsolveStackPtr) new PostsolveStack(p);
+  bool ok;
+
+  ok = snapGet<UInt>(pos, end, &(st->m_)) &&
+    snapGet<UInt>(pos, end, &(st->mSlots_)) &&
+    snapGet<UInt>(pos, end, &(st->n_)) &&
+    snapGetVec<UInt>(pos, end, &types) &&
+    snapGetVec<UInt>(pos, end, &(st->beg_)) &&
+    snapGetVec<UInt>(pos, end, &(st->vbeg_)) &&
+    snapGetVec<UInt>(pos, end, &(st->ind_)) &&
+    snapGetVec<double>(pos, end, &(st->val_)) &&
+    snapGetVec<UInt>(pos, end, &done) &&
+    snapGetVec<UInt>(pos, end, &(st->conSlot_)) &&
+    snapGetVec<UInt>(pos, end, &(st->varIdx_));
+  if (!ok || st->beg_.size()!=types.size()+1 ||
+      st->vbeg_.size()!=types.size()+1) {
+    return false;
+  }
+  st->types_.resize(types.size());
+  for (UInt i=0; i<types.size(); ++i) {
+    st->types_[i] = (PostsolveType) types[i];
+  }
+  st->colDone_.assign(done.begin(), done.end());
+  stack_ = st;
+  return true;
+}
+
+
+const IntVector & ProblemSnapshot::getVarMap() const
+{
+  return varMap_;
+}
+
+
+void ProblemSnapshot::putCGraph_(std::vector<char> *buf, CGraphPtr cg,
+                                 const UIntVector &vidx)
+{
+  std::map<const CNode *, UInt> ids;
+  std::vector<const CNode *> order;
+  std::stack<const CNode *> st;
+  std::vector<const CNode *> child;
+  const CNode *node;
+  bool ready;
+
+  if (!cg || !cg->getOut()) {
+    snapPut<UInt>(buf, 0);
+    return;
+  }
+
+  // children are numbered before their parents.
+  st.push(cg->getOut());
+  while (!st.empty()) {
+    node = st.top();
+    if (ids.find(node)!=ids.end()) {
+      st.pop();
+      continue;
+    }
+    ready = true;
+    if (node->numChild()>2 || OpSumList==node->getOp()) {
+      for (CNode **c=node->getListL(); c<node->getListR(); ++c) {
+        if (ids.find(*c)==ids.end()) {
+          st.push(*c);
+          ready = false;
+        }
+      }
+    } else {
+      if (node->getL() && ids.find(node->getL())==ids.end()) {
+        st.push(node->getL());
+        ready = false;
+      }
+      if (node->getR() && ids.find(node->getR())==ids.end()) {
+        st.push(node->getR());
+        ready = false;
+      }
+    }
+    if (ready) {
+      st.pop();
+      ids[node] = order.size();
+      order.push_back(node);
+    }
+  }
+
+  snapPut<UInt>(buf, order.size());
+  for (std::vector<const CNode *>::iterator it=order.begin();
+       it!=order.end(); ++it) {
+    node = *it;
+    child.clear();
+    if (node->numChild()>2 || OpSumList==node->getOp()) {
+      child.assign(node->getListL(), node->getListR());
+    } else {
+      if (node->getL()) {
+        child.push_back(node->getL());
+      }
+      if (node->getR()) {
+        child.push_back(node->getR());
+      }
+    }
+    snapPut<UInt>(buf, node->getOp());
+    snapPut<UInt>(buf, child.size());
+    for (UInt j=0; j<child.size(); ++j) {
+      snapPut<UInt>(buf, ids[child[j]]);
+    }
+    if (OpVar==node->getOp()) {
+      snapPut<UInt>(buf, vidx[node->getV()->getId()]);
+    } else if (OpNum==node->getOp() || OpInt==node->getOp()) {
+      snapPut<double>(buf, node->getVal());
+    }
+  }
+}
+
+
+bool ProblemSnapshot::putFun_(std::vector<char> *buf, FunctionPtr f,
+                              const UIntVector &vidx)
+{
+  LinearFunctionPtr lf;
+  QuadraticFunctionPtr qf;
+  NonlinearFunctionPtr nlf;
+  CGraphPtr cg;
+  UIntVector ind, jnd;
+  DoubleVector val;
+
+  if (f) {
+    lf = f->getLinearFunction();
+    qf = f->getQuadraticFunction();
+    nlf = f->getNonlinearFunction();
+  }
+  if (nlf) {
+    cg = boost::dynamic_pointer_cast<CGraph>(nlf);
+    if (!cg) {
+      logger_->errStream() << me_ << "only CGraph nonlinear functions can "
+                           << "be saved." << std::endl;
+      return false;
+    }
+  }
+
+  if (lf) {
+    for (VariableGroupConstIterator it=lf->termsBegin(); it!=lf->termsEnd();
+         ++it) {
+      ind.push_back(vidx[it->first->getId()]);
+      val.push_back(it->second);
+    }
+  }
+  snapPutVec<UInt>(buf, ind);
+  snapPutVec<double>(buf, val);
+
+  ind.clear();
+  val.clear();
+  if (qf) {
+    for (VariablePairGroupConstIterator it=qf->begin(); it!=qf->end();
+         ++it) {
+      ind.push_back(vidx[it->first.first->getId()]);
+      jnd.push_back(vidx[it->first.second->getId()]);
+      val.push_back(it->second);
+    }
+  }
+  snapPutVec<UInt>(buf, ind);
+  snapPutVec<UInt>(buf, jnd);
+  snapPutVec<double>(buf, val);
+
+  putCGraph_(buf, cg, vidx);
+  return true;
+}
+
+
+void ProblemSnapshot::putStack_(std::vector<char> *buf)
+{
+  UIntVector types(stack_->types_.begin(), stack_->types_.end());
+  UIntVector done(stack_->colDone_.begin(), stack_->colDone_.end());
+
+  snapPut<UInt>(buf, stack_->m_);
+  snapPut<UInt>(buf, stack_->mSlots_);
+  snapPut<UInt>(buf, stack_->n_);
+  snapPutVec<UInt>(buf, types);
+  snapPutVec<UInt>(buf, stack_->beg_);
+  snapPutVec<UInt>(buf, stack_->vbeg_);
+  snapPutVec<UInt>(buf, stack_->ind_);
+  snapPutVec<double>(buf, stack_->val_);
+  snapPutVec<UInt>(buf, done);
+  snapPutVec<UInt>(buf, stack_->conSlot_);
+  snapPutVec<UInt>(buf, stack_->varIdx_);
+}
+
+
+ProblemPtr ProblemSnapshot::read(std::string fname)
+{
+  int fd;
+  struct stat st;
+  char *buf;
+  const char *pos, *end;
+  ProblemPtr p = (ProblemPtr) new Problem();
+  FunctionPtr f;
+  VarVector vars;
+  DoubleVector lb, ub, wts;
+  UIntVector ind;
+  std::string name;
+  double cb = 0.0;
+  UInt version = 0, order = 0, n = 0, m = 0, nobj = 0, nsos = 0;
+  UInt has_stack = 0, has_map = 0, type = 0, stype = 0, sense = 0;
+  int priority = 0;
+  bool ok;
+
+  fd = open(fname.c_str(), O_RDONLY);
+  if (fd<0 || 0!=fstat(fd, &st) || st.st_size<=(off_t) sizeof(snapMagic)) {
+    logger_->errStream() << me_ << "can not read file " << fname
+                         << std::endl;
+    if (fd>=0) {
+      close(fd);
+    }
+    return ProblemPtr();
+  }
+  buf = (char *) mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (MAP_FAILED==buf) {
+    logger_->errStream() << me_ << "can not map file " << fname
+                         << std::endl;
+    return ProblemPtr();
+  }
+  pos = buf + sizeof(snapMagic);
+  end = buf + st.st_size;
+
+  ok = 0==memcmp(buf, snapMagic, sizeof(snapMagic)) &&
+    snapGet<UInt>(&pos, end, &version) && snapGet<UInt>(&pos, end, &order);
+  if (!ok || version!=version_ || order!=snapOrder) {
+    logger_->errStream() << me_ << fname << " is not a snapshot of version "
+                         << version_ << " for this machine." << std::endl;
+    munmap(buf, st.st_size);
+    return ProblemPtr();
+  }
+
+  ok = snapGet<UInt>(&pos, end, &n) && snapGet<UInt>(&pos, end, &m) &&
+    snapGet<UInt>(&pos, end, &nobj) && snapGet<UInt>(&pos, end, &nsos) &&
+    snapGet<UInt>(&pos, end, &has_stack) &&
+    snapGet<UInt>(&pos, end, &has_map);
+
+  for (UInt i=0; ok && i<n; ++i) {
+    double l, u;
+    ok = snapGet<double>(&pos, end, &l) && snapGet<double>(&pos, end, &u) &&
+      snapGet<UInt>(&pos, end, &type) && snapGet<UInt>(&pos, end, &stype) &&
+      type<=Continuous && stype<=VarOtherSrc && snapGetStr(&pos, end, &name);
+    if (ok) {
+      p->newVariable(l, u, (VariableType) type, name, (VarSrcType) stype);
+    }
+  }
+
+  for (UInt i=0; ok && i<m; ++i) {
+    double l, u;
+    ok = snapGet<double>(&pos, end, &l) && snapGet<double>(&pos, end, &u) &&
+      snapGetStr(&pos, end, &name);
+    if (ok) {
+      f = getFun_(&pos, end, p, &ok);
+    }
+    if (ok) {
+      p->newConstraint(f, l, u, name);
+    }
+  }
+
+  if (ok && nobj>0) {
+    ok = snapGet<UInt>(&pos, end, &sense) && sense<=Maximize &&
+      snapGet<double>(&pos, end, &cb) && snapGetStr(&pos, end, &name);
+    if (ok) {
+      f = getFun_(&pos, end, p, &ok);
+    }
+    if (ok) {
+      p->newObjective(f, cb, (ObjectiveType) sense, name);
+    }
+  }
+
+  for (UInt i=0; ok && i<nsos; ++i) {
+    ok = snapGet<UInt>(&pos, end, &type) && type<=SOS2 &&
+      snapGet<int>(&pos, end, &priority) &&
+      snapGetVec<UInt>(&pos, end, &ind) &&
+      snapGetVec<double>(&pos, end, &wts) && wts.size()==ind.size() &&
+      snapGetStr(&pos, end, &name);
+    vars.clear();
+    for (UInt j=0; ok && j<ind.size(); ++j) {
+      ok = ind[j]<p->getNumVars();
+      if (ok) {
+        vars.push_back(p->getVariable(ind[j]));
+      }
+    }
+    if (ok) {
+      p->newSOS(ind.size(), (SOSType) type, (ind.empty()) ? 0 : &(wts[0]),
+                vars, priority, name);
+    }
+  }
+
+  stack_.reset();
+  varMap_.clear();
+  if (ok && has_stack) {
+    ok = getStack_(&pos, end, p);
+  }
+  if (ok && has_map) {
+    ok = snapGetVec<int>(&pos, end, &varMap_);
+  }
+  munmap(buf, st.st_size);
+
+  if (!ok) {
+    logger_->errStream() << me_ << "file " << fname << " is damaged."
+                         << std::endl;
+    return ProblemPtr();
+  }
+  logger_->msgStream(LogInfo) << me_ << "loaded " << n << " variables and "
+                              << m << " constraints from " << fname
+                              << std::endl;
+  return p;
+}
+
+
+void ProblemSnapshot::setPostsolveStack(PostsolveStackPtr stack)
+{
+  stack_ = stack;
+}
+
+
+void ProblemSnapshot::setVarMap(const IntVector &map)
+{
+  varMap_ = map;
+}
+
+
+bool ProblemSnapshot::write(ConstProblemPtr p, std::string fname)
+{
+  std::vector<char> buf;
+  UIntVector vidx;
+  UIntVector ind;
+  ObjectivePtr o = p->getObjective();
+  SOSPtr sos;
+  std::ofstream out;
+  UInt i;
+
+  // index of each variable from its id.
+  i = 0;
+  for (VariableConstIterator it=p->varsBegin(); it!=p->varsEnd(); ++it, ++i) {
+    if ((*it)->getId() >= vidx.size()) {
+      vidx.resize((*it)->getId()+1, 0);
+    }
+    vidx[(*it)->getId()] = i;
+  }
+
+  buf.insert(buf.end(), snapMagic, snapMagic+sizeof(snapMagic));
+  snapPut<UInt>(&buf, version_);
+  snapPut<UInt>(&buf, snapOrder);
+  snapPut<UInt>(&buf, p->getNumVars());
+  snapPut<UInt>(&buf, p->getNumCons());
+  snapPut<UInt>(&buf, (o) ? 1 : 0);
+  snapPut<UInt>(&buf, (p->sos1End()-p->sos1Begin()) +
+                (p->sos2End()-p->sos2Begin()));
+  snapPut<UInt>(&buf, (stack_) ? 1 : 0);
+  snapPut<UInt>(&buf, (varMap_.empty()) ? 0 : 1);
+
+  for (VariableConstIterator it=p->varsBegin(); it!=p->varsEnd(); ++it) {
+    snapPut<double>(&buf, (*it)->getLb());
+    snapPut<double>(&buf, (*it)->getUb());
+    snapPut<UInt>(&buf, (*it)->getType());
+    snapPut<UInt>(&buf, (*it)->getSrcType());
+    snapPutStr(&buf, (*it)->getName());
+  }
+
+  for (ConstraintConstIterator it=p->consBegin(); it!=p->consEnd(); ++it) {
+    snapPut<double>(&buf, (*it)->getLb());
+    snapPut<double>(&buf, (*it)->getUb());
+    snapPutStr(&buf, (*it)->getName());
+    if (!putFun_(&buf, (*it)->getFunction(), vidx)) {
+      return false;
+    }
+  }
+
+  if (o) {
+    snapPut<UInt>(&buf, o->getObjectiveType());
+    snapPut<double>(&buf, o->getConstant());
+    snapPutStr(&buf, o->getName());
+    if (!putFun_(&buf, o->getFunction(), vidx)) {
+      return false;
+    }
+  }
+
+  for (int k=0; k<2; ++k) {
+    for (SOSConstIterator it=(0==k) ? p->sos1Begin() : p->sos2Begin();
+         it!=((0==k) ? p->sos1End() : p->sos2End()); ++it) {
+      sos = *it;
+      ind.clear();
+      for (VariableConstIterator vit=sos->varsBegin(); vit!=sos->varsEnd();
+           ++vit) {
+        ind.push_back(vidx[(*vit)->getId()]);
+      }
+      snapPut<UInt>(&buf, sos->getType());
+      snapPut<int>(&buf, sos->getPriority());
+      snapPutVec<UInt>(&buf, ind);
+      snapPutVec<double>(&buf, DoubleVector(sos->getWeights(),
+                                            sos->getWeights()+ind.size()));
+      snapPutStr(&buf, sos->getName());
+    }
+  }
+
+  if (stack_) {
+    putStack_(&buf);
+  }
+  if (!varMap_.empty()) {
+    snapPutVec<int>(&buf, varMap_);
+  }
+
+  out.open(fname.c_str(), std::ios::binary);
+  out.write(&(buf[0]), buf.size());
+  out.close();
+  if (out.fail()) {
+    logger_->errStream() << me_ << "can not write file " << fname
+                         << std::endl;
+    return false;
+  }
+  logger_->msgStream(LogInfo) << me_ << "saved " << p->getNumVars()
+                              << " variables and " << p->getNumCons()
+                              << " constraints in " << fname << std::endl;
+  return true;
+}
+
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
@@ -0,0 +1,153 @@
+//
+//     MINOTAUR -- It's only 1/2 bull
+//
+//     (C)opyright 2008 - 2014 The MINOTAUR Team.
+//
+
+/**
+ * \file ProblemSnapshot.h
+ * \brief Declare the ProblemSnapshot class that saves a problem in a binary
+ * file and loads it again.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#ifndef MINOTAURPROBLEMSNAPSHOT_H
+#define MINOTAURPROBLEMSNAPSHOT_H
+
+#include <string>
+
+#include "Types.h"
+
+namespace Minotaur {
+
+  class CGraph;
+  class Logger;
+  class PostsolveStack;
+  class Problem;
+  typedef boost::shared_ptr<CGraph> CGraphPtr;
+  typedef boost::shared_ptr<const Problem> ConstProblemPtr;
+  typedef boost::shared_ptr<Logger> LoggerPtr;
+  typedef boost::shared_ptr<PostsolveStack> PostsolveStackPtr;
+  typedef boost::shared_ptr<Problem> ProblemPtr;
+
+  /**
+   * \brief Save a problem in a versioned binary file and load it again,
+   * e.g. to start from a presolved or reformulated problem without reading
+   * and transforming the original again.
+   *
+   * The file has a header with a magic string, the version of the format
+   * and a number to check the byte order, followed by:
+   * - variables: bounds, type, source and name,
+   * - constraints: bounds, name and function,
+   * - the objective: sense, constant, name and function,
+   * - SOS constraints: type, priority, variables, weights and name,
+   * - optionally, the log of a PostsolveStack,
+   * - optionally, a map from variables to those of the original problem,
+   *   e.g. of a Transformer.
+   *
+   * A function is saved as flat arrays of indices and coefficients of its
+   * linear and quadratic parts, and the nodes of its CGraph in an order in
+   * which children come before parents, so that common subexpressions are
+   * saved once. Variables are referred to by their index. Other nonlinear
+   * functions can not be saved.
+   *
+   * The file is mapped into memory when it is loaded, and the problem is
+   * built directly from it. Handlers are not saved; they must be created
+   * again for the loaded problem.
+   */
+  class ProblemSnapshot {
+    public:
+      /// Constructor.
+      ProblemSnapshot(EnvPtr env);
+
+      /// Destroy.
+      ~ProblemSnapshot();
+
+      /// Return the postsolve stack that was saved or loaded, if any.
+      PostsolveStackPtr getPostsolveStack() const;
+
+      /// Return the map of variables that was saved or loaded, if any.
+      const IntVector & getVarMap() const;
+
+      /**
+       * \brief Load a problem from file fname.
+       *
+       * \return The problem, or NULL if the file can not be read or was
+       * saved with another version of the format.
+       */
+      ProblemPtr read(std::string fname);
+
+      /// Save the given postsolve stack with the next problem.
+      void setPostsolveStack(PostsolveStackPtr stack);
+
+      /**
+       * \brief Save the given map with the next problem. map[i] is the
+       * index of variable i in the original problem, or -1.
+       */
+      void setVarMap(const IntVector &map);
+
+      /**
+       * \brief Save problem p in file fname.
+       *
+       * \return False if p has a nonlinear function that is not a CGraph
+       * or if the file can not be written.
+       */
+      bool write(ConstProblemPtr p, std::string fname);
+
+    private:
+      /// Environment.
+      EnvPtr env_;
+
+      /// Log.
+      LoggerPtr logger_;
+
+      /// For logging.
+      static const std::string me_;
+
+      /// Postsolve stack saved or loaded.
+      PostsolveStackPtr stack_;
+
+      /// Map of variables saved or loaded.
+      IntVector varMap_;
+
+      /// Version of the format.
+      static const UInt version_;
+
+      /// Read a CGraph of problem p. Return NULL if there is none.
+      CGraphPtr getCGraph_(const char **pos, const char *end, ProblemPtr p,
+                           bool *ok);
+
+      /// Read a function of problem p.
+      FunctionPtr getFun_(const char **pos, const char *end, ProblemPtr p,
+                          bool *ok);
+
+      /// Read the log of a postsolve stack.
+      bool getStack_(const char **pos, const char *end, ProblemPtr p);
+
+      /**
+       * Save the CGraph cg. vidx gives the index of a variable from its
+       * id.
+       */
+      void putCGraph_(std::vector<char> *buf, CGraphPtr cg,
+                      const UIntVector &vidx);
+
+      /// Save a function. Return false if it can not be saved.
+      bool putFun_(std::vector<char> *buf, FunctionPtr f,
+                   const UIntVector &vidx);
+
+      /// Save the log of the postsolve stack.
+      void putStack_(std::vector<char> *buf);
+  };
+}
+#endif
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
@@ -0,0 +1,479 @@
+//
+//     MINOTAUR -- It's only 1/2 bull
+//
+//     (C)opyright 2008 - 2014 The MINOTAUR Team.
+//
+
+/**
+ * \file Profiler.cpp
+ * \brief Define the Profiler that measures the time spent in different
+ * parts (zones) of branch-and-bound.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <time.h>
+
+#include "MinotaurConfig.h"
+#include "Environment.h"
+#include "Logger.h"
+#include "Option.h"
+#include "Profiler.h"
+
+using namespace Minotaur;
+
+// A zone in the tree of zones of a thread. The root is not a zone.
+struct ProfNode {
+  int child[ProfNumZones];
+  UInt calls;
+  unsigned long long ns;
+  int parent;
+  int zone;
+
+  ProfNode(int p, int z) : calls(0), ns(0), parent(p), zone(z)
+  {
+    for (int i=0; i<ProfNumZones; ++i) {
+      child[i] = -1;
+    }
+  }
+};
+
+// A zone that was left, for the trace.
+struct ProfEvent {
+  int zone;
+  unsigned long long start;
+  unsigned long long dur;
+};
+
+// Everything a thread measures. Only the thread itself writes to it.
+struct ProfThread {
+  UInt id;
+  std::vector<ProfNode> nodes;
+  std::vector<int> stack;
+  std::vector<unsigned long long> starts;
+  std::vector<ProfEvent> events;
+
+  ProfThread(UInt i) : id(i) { clear(); }
+
+  void clear()
+  {
+    nodes.clear();
+    nodes.push_back(ProfNode(-1, ProfNumZones));
+    stack.clear();
+    stack.push_back(0);
+    starts.clear();
+    events.clear();
+  }
+
+  int getChild(int n, int z)
+  {
+    int c = nodes[n].child[z];
+    if (c<0) {
+      c = nodes.size();
+      nodes.push_back(ProfNode(n, z));
+      nodes[n].child[z] = c;
+    }
+    return c;
+  }
+};
+
+// All threads that have entered a zone. They are kept till the end of the
+// program because threads of OpenMP are reused.
+struct ProfThreadList {
+  std::vector<ProfThread*> threads;
+
+  ~ProfThreadList()
+  {
+    for (UInt i=0; i<threads.size(); ++i) {
+      delete threads[i];
+    }
+  }
+};
+
+static ProfThreadList profThreads;
+static __thread ProfThread *profMine = 0;
+
+static const char *profZoneNames[] = {
+  "branching",
+  "engine_solve",
+  "heuristics",
+  "node_selection",
+  "propagation",
+  "relaxation",
+  "separation"
+};
+
+static inline unsigned long long profNow()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (unsigned long long) ts.tv_sec*1000000000ULL + ts.tv_nsec;
+}
+
+// Add the subtree of n in src to the subtree of m in dst.
+static void profMerge(const ProfThread &src, int n, ProfThread &dst, int m)
+{
+  int c, d;
+  for (int z=0; z<ProfNumZones; ++z) {
+    c = src.nodes[n].child[z];
+    if (c>=0) {
+      d = dst.getChild(m, z);
+      dst.nodes[d].calls += src.nodes[c].calls;
+      dst.nodes[d].ns += src.nodes[c].ns;
+      profMerge(src, c, dst, d);
+    }
+  }
+}
+
+static double profSelf(const ProfThread &t, int n)
+{
+  unsigned long long ns = t.nodes[n].ns;
+  int c;
+  for (int z=0; z<ProfNumZones; ++z) {
+    c = t.nodes[n].child[z];
+    if (c>=0) {
+      ns -= t.nodes[c].ns;
+    }
+  }
+  return ns*1e-9;
+}
+
+static void profWriteCSV(const ProfThread &t, int n,
+                         const std::string &thread, const std::string &path,
+                         UInt depth, std::ostream &out)
+{
+  std::string p;
+  int c;
+  for (int z=0; z<ProfNumZones; ++z) {
+    c = t.nodes[n].child[z];
+    if (c>=0) {
+      p = (path.empty() ? "" : path + "/") + profZoneNames[z];
+      out << thread << "," << p << "," << profZoneNames[z] << ","
+          << depth << "," << t.nodes[c].calls << ","
+          << t.nodes[c].ns*1e-9 << "," << profSelf(t, c) << std::endl;
+      profWriteCSV(t, c, thread, p, depth+1, out);
+    }
+  }
+}
+
+static void profWriteJSON(const ProfThread &t, int n, std::ostream &out)
+{
+  bool first = true;
+  int c;
+  out << "[";
+  for (int z=0; z<ProfNumZones; ++z) {
+    c = t.nodes[n].child[z];
+    if (c>=0) {
+      if (!first) {
+        out << ", ";
+      }
+      first = false;
+      out << "{\"zone\": \"" << profZoneNames[z] << "\", \"calls\": "
+          << t.nodes[c].calls << ", \"time\": " << t.nodes[c].ns*1e-9
+          << ", \"self\": " << profSelf(t, c) << ", \"children\": ";
+      profWriteJSON(t, c, out);
+      out << "}";
+    }
+  }
+  out << "]";
+}
+
+// Merge the trees of all threads.
+static void profMergeAll(ProfThread &all)
+{
+  all.clear();
+  for (UInt i=0; i<profThreads.threads.size(); ++i) {
+    profMerge(*profThreads.threads[i], 0, all, 0);
+  }
+}
+
+
+bool Profiler::on_ = false;
+int Profiler::depth_ = 0;
+UInt Profiler::maxEvents_ = 0;
+const std::string Profiler::me_ = "Profiler: ";
+unsigned long long Profiler::t0_ = 0;
+double Profiler::time_ = 0.0;
+bool Profiler::trace_ = false;
+
+
+void Profiler::begin(ProfZoneType z)
+{
+  ProfThread *t = profMine;
+  if (!t) {
+#if USE_OPENMP
+#pragma omp critical (MinotaurProfiler)
+#endif
+    {
+      t = new ProfThread(profThreads.threads.size());
+      profThreads.threads.push_back(t);
+    }
+    profMine = t;
+  }
+  t->stack.push_back(t->getChild(t->stack.back(), z));
+  t->starts.push_back(profNow());
+}
+
+
+void Profiler::end()
+{
+  ProfThread *t = profMine;
+  ProfEvent e;
+
+  // the zone may have been entered before the measurements were reset, or
+  // the profiler may have been stopped since.
+  if (!on_ || !t || t->stack.size()<2) {
+    return;
+  }
+  ProfNode &node = t->nodes[t->stack.back()];
+  e.start = t->starts.back();
+  e.dur = profNow() - e.start;
+  ++node.calls;
+  node.ns += e.dur;
+  if (trace_ && t->events.size()<maxEvents_) {
+    e.zone = node.zone;
+    t->events.push_back(e);
+  }
+  t->stack.pop_back();
+  t->starts.pop_back();
+}
+
+
+void Profiler::finish(EnvPtr env)
+{
+  OptionDBPtr options = env->getOptions();
+  std::string fname;
+  std::ofstream out;
+
+  if (depth_>0) {
+    --depth_;
+  }
+  if (0<depth_ || false==on_) {
+    return;
+  }
+  on_ = false;
+  time_ = (profNow() - t0_)*1e-9;
+
+  fname = options->findString("profile_file")->getValue();
+  if (!fname.empty()) {
+    out.open((fname + ".json").c_str());
+    if (out) {
+      writeJSON(out);
+    } else {
+      env->getLogger()->errStream() << me_ << "could not write to "
+        << fname << ".json" << std::endl;
+    }
+    out.close();
+    out.clear();
+    out.open((fname + ".csv").c_str());
+    if (out) {
+      writeCSV(out);
+    } else {
+      env->getLogger()->errStream() << me_ << "could not write to "
+        << fname << ".csv" << std::endl;
+    }
+    out.close();
+    out.clear();
+  }
+
+  fname = options->findString("profile_trace_file")->getValue();
+  if (trace_ && !fname.empty()) {
+    out.open(fname.c_str());
+    if (out) {
+      writeTrace(out);
+    } else {
+      env->getLogger()->errStream() << me_ << "could not write to "
+        << fname << std::endl;
+    }
+    out.close();
+  }
+}
+
+
+UInt Profiler::getCalls(ProfZoneType z)
+{
+  UInt calls = 0;
+  for (UInt i=0; i<profThreads.threads.size(); ++i) {
+    const std::vector<ProfNode> &nodes = profThreads.threads[i]->nodes;
+    for (UInt j=1; j<nodes.size(); ++j) {
+      if (nodes[j].zone==z) {
+        calls += nodes[j].calls;
+      }
+    }
+  }
+  return calls;
+}
+
+
+UInt Profiler::getNumThreads()
+{
+  UInt n = 0;
+  for (UInt i=0; i<profThreads.threads.size(); ++i) {
+    if (profThreads.threads[i]->nodes.size()>1) {
+      ++n;
+    }
+  }
+  return n;
+}
+
+
+double Profiler::getTime(ProfZoneType z)
+{
+  unsigned long long ns = 0;
+  int p;
+  for (UInt i=0; i<profThreads.threads.size(); ++i) {
+    const std::vector<ProfNode> &nodes = profThreads.threads[i]->nodes;
+    for (UInt j=1; j<nodes.size(); ++j) {
+      if (nodes[j].zone!=z) {
+        continue;
+      }
+      // skip if an outer zone is the same as this one.
+      for (p=nodes[j].parent; p>0 && nodes[p].zone!=z; p=nodes[p].parent) {
+      }
+      if (p<=0) {
+        ns += nodes[j].ns;
+      }
+    }
+  }
+  return ns*1e-9;
+}
+
+
+const char* Profiler::getZoneName(ProfZoneType z)
+{
+  if (z<0 || z>=ProfNumZones) {
+    return "unknown";
+  }
+  return profZoneNames[z];
+}
+
+
+void Profiler::reset()
+{
+  for (UInt i=0; i<profThreads.threads.size(); ++i) {
+    profThreads.threads[i]->clear();
+  }
+  t0_ = profNow();
+  time_ = 0.0;
+}
+
+
+void Profiler::start(EnvPtr env)
+{
+  OptionDBPtr options = env->getOptions();
+
+  ++depth_;
+  if (1<depth_) {
+    return;
+  }
+  reset();
+  on_ = options->findBool("profile")->getValue();
+  trace_ = on_ &&
+    (false==options->findString("profile_trace_file")->getValue().empty());
+  if (options->findInt("profile_trace_max")->getValue()>0) {
+    maxEvents_ = options->findInt("profile_trace_max")->getValue();
+  } else {
+    maxEvents_ = 0;
+  }
+}
+
+
+void Profiler::writeCSV(std::ostream &out)
+{
+  ProfThread all(0);
+  std::ostringstream thread;
+
+  out << "thread,path,zone,depth,calls,time,self" << std::endl;
+  out << std::setprecision(9);
+  for (UInt i=0; i<profThreads.threads.size(); ++i) {
+    thread.str("");
+    thread << profThreads.threads[i]->id;
+    profWriteCSV(*profThreads.threads[i], 0, thread.str(), "", 0, out);
+  }
+  profMergeAll(all);
+  profWriteCSV(all, 0, "all", "", 0, out);
+}
+
+
+void Profiler::writeJSON(std::ostream &out)
+{
+  ProfThread all(0);
+  bool first = true;
+
+  out << std::setprecision(9)
+      << "{\"clock\": \"CLOCK_MONOTONIC\", \"time\": " << time_
+      << ", \"threads\": [";
+  for (UInt i=0; i<profThreads.threads.size(); ++i) {
+    if (profThreads.threads[i]->nodes.size()<2) {
+      continue;
+    }
+    if (!first) {
+      out << ", ";
+    }
+    first = false;
+    out << "{\"thread\": " << profThreads.threads[i]->id << ", \"zones\": ";
+    profWriteJSON(*profThreads.threads[i], 0, out);
+    out << "}";
+  }
+  profMergeAll(all);
+  out << "], \"all\": ";
+  profWriteJSON(all, 0, out);
+  out << "}" << std::endl;
+}
+
+
+void Profiler::writeStats(std::ostream &out)
+{
+  if (0==getNumThreads()) {
+    return;
+  }
+  out << me_ << "threads          = " << getNumThreads() << std::endl;
+  for (int z=0; z<ProfNumZones; ++z) {
+    out << me_ << std::setw(16) << std::left << profZoneNames[z] << std::right
+        << " = " << std::fixed << std::setprecision(2)
+        << getTime((ProfZoneType) z) << " s in " << getCalls((ProfZoneType) z)
+        << " calls" << std::endl;
+  }
+}
+
+
+void Profiler::writeTrace(std::ostream &out)
+{
+  ProfThread *t;
+  bool first = true;
+
+  // time stamps of the trace format are in microseconds.
+  out << std::fixed << std::setprecision(3) << "{\"traceEvents\": [";
+  for (UInt i=0; i<profThreads.threads.size(); ++i) {
+    t = profThreads.threads[i];
+    if (t->events.empty()) {
+      continue;
+    }
+    out << (first ? "\n" : ",\n")
+        << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 0, \"tid\": "
+        << t->id << ", \"args\": {\"name\": \"thread " << t->id << "\"}}";
+    first = false;
+    for (UInt j=0; j<t->events.size(); ++j) {
+      out << ",\n{\"name\": \"" << profZoneNames[t->events[j].zone]
+          << "\", \"cat\": \"bnb\", \"ph\": \"X\", \"pid\": 0, \"tid\": "
+          << t->id << ", \"ts\": "
+          << (t->events[j].start<t0_ ? 0.0 : (t->events[j].start-t0_)*1e-3)
+          << ", \"dur\": " << t->events[j].dur*1e-3 << "}";
+    }
+  }
+  out << "\n], \"displayTimeUnit\": \"ms\"}" << std::endl;
+}
+
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
@@ -0,0 +1,181 @@
+//
+//     MINOTAUR -- It's only 1/2 bull
+//
+//     (C)opyright 2008 - 2014 The MINOTAUR Team.
+//
+
+/**
+ * \file Profiler.h
+ * \brief Declare the Profiler that measures the time spent in different
+ * parts (zones) of branch-and-bound.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#ifndef MINOTAURPROFILER_H
+#define MINOTAURPROFILER_H
+
+#include <iostream>
+
+#include "Types.h"
+
+namespace Minotaur {
+
+  /// Parts of branch-and-bound whose time is measured by the Profiler.
+  typedef enum {
+    ProfBranch,      ///< Finding branching candidates and creating children.
+    ProfEngine,      ///< Solving a relaxation with an engine.
+    ProfHeur,        ///< Running heuristics.
+    ProfNodeSel,     ///< Selecting the next node to process.
+    ProfPropagate,   ///< Presolving and propagating bounds in a node.
+    ProfRelax,       ///< Creating the relaxation of a node.
+    ProfSeparate,    ///< Separating cuts.
+    ProfNumZones     ///< Number of zones. Not a zone.
+  } ProfZoneType;
+
+
+  /**
+   * \brief Measure the time spent in zones of branch-and-bound.
+   *
+   * A zone is timed by creating a ProfZone object at the start of a scope.
+   * Zones may be nested, and the time of a zone is kept separately for each
+   * path of zones that leads to it, e.g. the engine solves done while
+   * branching are kept apart from those done while processing the node.
+   * Each thread keeps its own tree of zones, so that no locks are needed
+   * while timing. The trees are merged only when a report is written.
+   *
+   * Time is measured by clock_gettime(CLOCK_MONOTONIC). When the option
+   * "profile" is not set, a ProfZone only checks a flag, and so zones can
+   * stay in the code.
+   *
+   * The profiler is turned on by start() and turned off by finish(), which
+   * also writes the reports asked for in the options. Calls of start() and
+   * finish() may be nested, e.g. when a heuristic runs its own
+   * branch-and-bound; only the outermost pair has an effect.
+   */
+  class Profiler {
+    public:
+      /// Enter zone z in the calling thread.
+      static void begin(ProfZoneType z);
+
+      /// Leave the zone entered last in the calling thread.
+      static void end();
+
+      /**
+       * Turn the profiler off and write the .json and .csv report and the
+       * Chrome trace, if asked for in options "profile_file" and
+       * "profile_trace_file".
+       */
+      static void finish(EnvPtr env);
+
+      /// Number of times zone z was left, summed over all threads.
+      static UInt getCalls(ProfZoneType z);
+
+      /// Number of threads that entered a zone.
+      static UInt getNumThreads();
+
+      /**
+       * Time in seconds spent in zone z, summed over all threads. Time of a
+       * zone nested in itself is not counted twice.
+       */
+      static double getTime(ProfZoneType z);
+
+      /// Name of zone z used in reports.
+      static const char* getZoneName(ProfZoneType z);
+
+      /// Return true if zones are being timed.
+      static bool isOn() { return on_; };
+
+      /// Discard all measurements.
+      static void reset();
+
+      /// Discard old measurements and turn on if option "profile" is set.
+      static void start(EnvPtr env);
+
+      /**
+       * Write the tree of zones of each thread and the tree merged from all
+       * threads, with rows "thread,path,zone,depth,calls,time,self".
+       */
+      static void writeCSV(std::ostream &out);
+
+      /// Write the trees of zones as nested JSON objects.
+      static void writeJSON(std::ostream &out);
+
+      /// Write the time of each zone to out. Nothing if nothing was timed.
+      static void writeStats(std::ostream &out);
+
+      /// Write the timed events in the Chrome trace (JSON) format.
+      static void writeTrace(std::ostream &out);
+
+    private:
+      /// Number of calls to start() not yet matched by finish().
+      static int depth_;
+
+      /// Maximum number of events traced in each thread.
+      static UInt maxEvents_;
+
+      /// For logging.
+      static const std::string me_;
+
+      /// True if zones are being timed.
+      static bool on_;
+
+      /// Time at which the profiler was started, in nanoseconds.
+      static unsigned long long t0_;
+
+      /// Time between start() and finish(), in seconds.
+      static double time_;
+
+      /// True if events should be saved for a trace.
+      static bool trace_;
+  };
+
+
+  /**
+   * \brief Time a zone from the creation of this object till it goes out of
+   * scope.
+   *
+   * Whether the profiler is on is checked only once at creation, so a zone
+   * is closed only if it was opened.
+   */
+  class ProfZone {
+    public:
+      /// Enter zone z if the profiler is on.
+      ProfZone(ProfZoneType z)
+        : on_(Profiler::isOn())
+      {
+        if (on_) {
+          Profiler::begin(z);
+        }
+      };
+
+      /// Leave the zone.
+      ~ProfZone()
+      {
+        if (on_) {
+          Profiler::end();
+        }
+      };
+
+    private:
+      /// True if the zone was entered.
+      bool on_;
+
+      /// Copy constructor is not allowed.
+      ProfZone(const ProfZone &);
+
+      /// Copy by assignment is not allowed.
+      ProfZone & operator = (const ProfZone &);
+  };
+}
+#endif
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
@@ -0,0 +1,374 @@
+//
+//     MINOTAUR -- It's only 1/2 bull
+//
+//     (C)opyright 2008 - 2014 The MINOTAUR Team.
+//
+
+/**
+ * \file PropEngine.cpp
+ * \brief Implement the methods of class PropEngine.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#include "MinotaurConfig.h"
+#include "Problem.h"
+#include "PropEngine.h"
+#include "VarBoundMod.h"
+#include "Variable.h"
+
+using namespace Minotaur;
+
+const std::string PropEngine::me_ = "PropEngine: ";
+
+
+PropEngine::PropEngine(ProblemPtr p)
+  : absTol_(1e-8),
+    intTol_(1e-6),
+    mods_(0),
+    nChanges_(0),
+    nIntMods_(0),
+    nInf_(0),
+    nLimit_(0),
+    nRuns_(0),
+    nVisits_(0),
+    p_(p),
+    relTol_(0.0),
+    workFactor_(10.0)
+{
+}
+
+
+PropEngine::~PropEngine()
+{
+  props_.clear();
+  varItems_.clear();
+  vars_.clear();
+  p_.reset();
+}
+
+
+void PropEngine::addItem_(UInt k, UInt i)
+{
+  VarVector vars;
+  UInt j;
+
+  props_[k]->getVars(i, vars);
+  for (VarVector::const_iterator it=vars.begin(); it!=vars.end(); ++it) {
+    j = (*it)->getIndex();
+    if (j < varItems_.size() && (varItems_[j].empty() ||
+                                 varItems_[j].back()!=PropItem(k, i))) {
+      varItems_[j].push_back(PropItem(k, i));
+    }
+  }
+}
+
+
+void PropEngine::addPropagator(PropagatorPtr prop)
+{
+  props_.push_back(prop);
+  nItems_.push_back(0);
+  inQueue_.push_back(BoolVector());
+}
+
+
+void PropEngine::clearQueue_()
+{
+  for (std::deque<PropItem>::const_iterator it=queue_.begin();
+       it!=queue_.end(); ++it) {
+    inQueue_[it->first][it->second] = false;
+  }
+  queue_.clear();
+}
+
+
+void PropEngine::init()
+{
+  UInt n = p_->getNumVars();
+  VariablePtr v;
+
+  clearQueue_();
+  vars_.resize(n);
+  lb_.resize(n);
+  ub_.resize(n);
+  varItems_.assign(n, std::vector<PropItem>());
+  for (VariableConstIterator it=p_->varsBegin(); it!=p_->varsEnd(); ++it) {
+    v = *it;
+    vars_[v->getIndex()] = v;
+    lb_[v->getIndex()] = v->getLb();
+    ub_[v->getIndex()] = v->getUb();
+  }
+
+  for (UInt k=0; k<props_.size(); ++k) {
+    props_[k]->init();
+    nItems_[k] = 0;
+    inQueue_[k].clear();
+  }
+  update();
+}
+
+
+void PropEngine::itemChanged(UInt k, UInt i)
+{
+  VarVector vars;
+  UInt j;
+  PropItem item(k, i);
+
+  props_[k]->getVars(i, vars);
+  for (VarVector::const_iterator it=vars.begin(); it!=vars.end(); ++it) {
+    j = (*it)->getIndex();
+    if (j < varItems_.size() &&
+        std::find(varItems_[j].begin(), varItems_[j].end(), item) ==
+        varItems_[j].end()) {
+      varItems_[j].push_back(item);
+    }
+  }
+  push_(k, i);
+}
+
+
+void PropEngine::notify_(ConstVariablePtr v, bool push)
+{
+  UInt j = v->getIndex();
+  double olb = lb_[j];
+  double oub = ub_[j];
+  std::vector<PropItem> &items = varItems_[j];
+
+  lb_[j] = v->getLb();
+  ub_[j] = v->getUb();
+  for (PropagatorVector::iterator it=props_.begin(); it!=props_.end();
+       ++it) {
+    (*it)->boundsChanged(v, olb, oub);
+  }
+  if (push) {
+    for (std::vector<PropItem>::const_iterator it=items.begin();
+         it!=items.end(); ++it) {
+      push_(it->first, it->second);
+    }
+  }
+}
+
+
+bool PropEngine::propagate(ModVector *mods, UInt *nintmods)
+{
+  bool is_inf = false;
+  UInt nitems = 0;
+  UInt visits = 0;
+  double limit;
+  PropItem item;
+
+  for (UIntVector::const_iterator it=nItems_.begin(); it!=nItems_.end();
+       ++it) {
+    nitems += *it;
+  }
+  limit = workFactor_*nitems + 1.0;
+
+  ++nRuns_;
+  mods_ = mods;
+  nIntMods_ = nintmods;
+  while (false==queue_.empty()) {
+    if (visits >= limit) {
+      ++nLimit_;
+      break;
+    }
+    item = queue_.front();
+    queue_.pop_front();
+    inQueue_[item.first][item.second] = false;
+    ++visits;
+    if (props_[item.first]->propagate(item.second, this)) {
+      // keep it for the next call, the bounds that made it infeasible may
+      // be seen again without any change.
+      push_(item.first, item.second);
+      ++nInf_;
+      is_inf = true;
+      break;
+    }
+  }
+  nVisits_ += visits;
+  mods_ = 0;
+  nIntMods_ = 0;
+  return is_inf;
+}
+
+
+void PropEngine::push_(UInt k, UInt i)
+{
+  if (false==inQueue_[k][i]) {
+    inQueue_[k][i] = true;
+    queue_.push_back(PropItem(k, i));
+  }
+}
+
+
+void PropEngine::setTols(double abs_tol, double rel_tol)
+{
+  absTol_ = abs_tol;
+  relTol_ = rel_tol;
+}
+
+
+void PropEngine::setWorkLimit(double factor)
+{
+  workFactor_ = factor;
+}
+
+
+void PropEngine::sync()
+{
+  VariablePtr v;
+
+  if (p_->getNumVars() != vars_.size()) {
+    init();
+    return;
+  }
+  for (VarVector::const_iterator it=vars_.begin(); it!=vars_.end(); ++it) {
+    v = *it;
+    if (v->getLb() != lb_[v->getIndex()] ||
+        v->getUb() != ub_[v->getIndex()]) {
+      notify_(v, true);
+    }
+  }
+}
+
+
+int PropEngine::tighten(VariablePtr v, double lb, double ub)
+{
+  double vlb = v->getLb();
+  double vub = v->getUb();
+  bool is_int = (v->getType()==Binary || v->getType()==Integer);
+  bool chlb, chub;
+  ModificationPtr mod;
+
+  if (is_int) {
+    if (lb > -INFINITY) {
+      lb = (fabs(lb-floor(lb+0.5)) < intTol_) ? floor(lb+0.5) : ceil(lb);
+    }
+    if (ub < INFINITY) {
+      ub = (fabs(ub-floor(ub+0.5)) < intTol_) ? floor(ub+0.5) : floor(ub);
+    }
+  }
+  if (lb > vub+absTol_ || ub < vlb-absTol_ || lb > ub+absTol_) {
+    return -1;
+  }
+
+  if (is_int) {
+    chlb = (lb > vlb+intTol_);
+    chub = (ub < vub-intTol_);
+  } else {
+    chlb = (lb > vlb+absTol_+relTol_*std::min(fabs(vlb), fabs(lb)));
+    chub = (ub < vub-absTol_-relTol_*std::min(fabs(vub), fabs(ub)));
+  }
+  if (false==chlb && false==chub) {
+    return 0;
+  }
+
+  if (chlb && lb > vub) {
+    lb = vub;
+  }
+  if (chub && ub < vlb) {
+    ub = vlb;
+  }
+  if (chlb && chub) {
+    if (lb > ub) {
+      ub = lb;
+    }
+    mod = (VarBoundMod2Ptr) new VarBoundMod2(v, lb, ub);
+  } else if (chlb) {
+    mod = (VarBoundModPtr) new VarBoundMod(v, Lower, lb);
+  } else {
+    mod = (VarBoundModPtr) new VarBoundMod(v, Upper, ub);
+  }
+  mod->applyToProblem(p_);
+  if (mods_) {
+    mods_->push_back(mod);
+  }
+  if (is_int && nIntMods_) {
+    ++(*nIntMods_);
+  }
+  ++nChanges_;
+  varChanged(v);
+  return 1;
+}
+
+
+void PropEngine::undo(ModVector &mods, UInt n0)
+{
+  ModificationPtr mod;
+  VarBoundModPtr bmod;
+  VarBoundMod2Ptr bmod2;
+  VariablePtr v;
+
+  while (mods.size() > n0) {
+    mod = mods.back();
+    mods.pop_back();
+    mod->undoToProblem(p_);
+    bmod = boost::dynamic_pointer_cast<VarBoundMod>(mod);
+    if (bmod) {
+      v = bmod->getVar();
+    } else {
+      bmod2 = boost::dynamic_pointer_cast<VarBoundMod2>(mod);
+      v = bmod2 ? bmod2->getVar() : VariablePtr();
+    }
+    if (v && v->getIndex() < lb_.size() &&
+        (v->getLb() != lb_[v->getIndex()] ||
+         v->getUb() != ub_[v->getIndex()])) {
+      notify_(v, false);
+    }
+  }
+  clearQueue_();
+}
+
+
+void PropEngine::update()
+{
+  UInt n;
+
+  for (UInt k=0; k<props_.size(); ++k) {
+    n = props_[k]->getNumItems();
+    inQueue_[k].resize(n, false);
+    for (UInt i=nItems_[k]; i<n; ++i) {
+      addItem_(k, i);
+      push_(k, i);
+    }
+    nItems_[k] = n;
+  }
+}
+
+
+void PropEngine::varChanged(ConstVariablePtr v)
+{
+  UInt j = v->getIndex();
+  if (j < lb_.size() && (v->getLb() != lb_[j] || v->getUb() != ub_[j])) {
+    notify_(v, true);
+  }
+}
+
+
+void PropEngine::writeStats(std::ostream &out) const
+{
+  out << me_ << "number of runs              = " << nRuns_   << std::endl
+      << me_ << "items visited               = " << nVisits_ << std::endl
+      << me_ << "bounds changed              = " << nChanges_ << std::endl
+      << me_ << "infeasibility detected      = " << nInf_    << std::endl
+      << me_ << "work limit reached          = " << nLimit_  << std::endl;
+  for (PropagatorVector::const_iterator it=props_.begin(); it!=props_.end();
+       ++it) {
+    out << me_ << "propagator " << (*it)->getName() << " items = "
+        << (*it)->getNumItems() << std::endl;
+  }
+}
+
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
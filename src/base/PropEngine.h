@@ -0,0 +1,247 @@
+//
+//     MINOTAUR -- It's only 1/2 bull
+//
+//     (C)opyright 2008 - 2014 The MINOTAUR Team.
+//
+
+/**
+ * \file PropEngine.h
+ * \brief Declare class PropEngine for worklist driven bound propagation.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#ifndef MINOTAURPROPENGINE_H
+#define MINOTAURPROPENGINE_H
+
+#include <deque>
+
+#include "Propagator.h"
+
+namespace Minotaur {
+
+  /**
+   * \brief Tighten bounds of variables of a problem by calling propagators
+   * only on items whose variables have changed.
+   *
+   * The engine remembers the bounds of all variables that it saw last. When
+   * a bound changes, either because a propagator tightened it or because
+   * the problem was changed from outside (branching, moving to another
+   * node), the propagators are told about it and all items that use the
+   * variable are put in a queue. propagate() takes items from the queue
+   * until it is empty, an item is found infeasible, or a work limit is
+   * reached.
+   *
+   * At a node of the tree, sync() finds the bounds changed since the last
+   * call by comparing them with the saved ones, so that propagation starts
+   * from the branching changes only. Items left in the queue when
+   * propagate() stops early are kept, and visited in the next call.
+   */
+  class PropEngine {
+  public:
+    /// Constructor. Bounds of variables of p are tightened.
+    PropEngine(ProblemPtr p);
+
+    /// Destroy.
+    ~PropEngine();
+
+    /// Add a propagator. init() must be called afterwards.
+    void addPropagator(PropagatorPtr prop);
+
+    /// Return the problem whose bounds are tightened.
+    ProblemPtr getProblem() const { return p_; }
+
+    /**
+     * \brief Save current bounds, build the lists of items of each variable
+     * and put all items in the queue.
+     */
+    void init();
+
+    /**
+     * \brief Tell the engine that an item has changed, e.g. a row got new
+     * coefficients, and put it in the queue.
+     *
+     * Variables that are new in the item are added to its lists. Variables
+     * that are no longer used by it are left as they are.
+     *
+     * \param[in] k The position of the propagator, in the order in which
+     * they were added.
+     * \param[in] i The item.
+     */
+    void itemChanged(UInt k, UInt i);
+
+    /**
+     * \brief Propagate until no item is in the queue.
+     *
+     * \param[out] mods If not NULL, the bound changes are appended to it.
+     * \param[out] nintmods If not NULL, it is incremented for every change of
+     * bounds of an integer variable.
+     * \return True if the problem is found infeasible. False otherwise.
+     */
+    bool propagate(ModVector *mods, UInt *nintmods);
+
+    /**
+     * \brief Set the tolerances used in tighten().
+     *
+     * \param[in] abs_tol A bound of a continuous variable is changed only if
+     * it improves by more than abs_tol + rel_tol*|bound|. New bounds that
+     * cross by at most abs_tol are set equal.
+     * \param[in] rel_tol See above.
+     */
+    void setTols(double abs_tol, double rel_tol);
+
+    /**
+     * \brief Set the work limit.
+     *
+     * \param[in] factor One call to propagate() visits at most factor times
+     * the number of items.
+     */
+    void setWorkLimit(double factor);
+
+    /**
+     * \brief Find the variables whose bounds changed since they were last
+     * seen by the engine, and queue their items.
+     *
+     * If the number of variables has changed, init() is called instead.
+     */
+    void sync();
+
+    /**
+     * \brief Change the bounds of a variable, if they are tighter.
+     *
+     * Bounds of integer variables are rounded. The change is applied to the
+     * problem, saved in the vector passed to propagate() and the items
+     * of the variable are queued.
+     *
+     * \param[in] v The variable.
+     * \param[in] lb The new lower bound. -INFINITY if unchanged.
+     * \param[in] ub The new upper bound. INFINITY if unchanged.
+     * \return -1 if the new bounds are infeasible, 1 if some bound was
+     * changed, 0 otherwise.
+     */
+    int tighten(VariablePtr v, double lb, double ub);
+
+    /**
+     * \brief Undo bound changes made by tighten() and tell the propagators.
+     *
+     * The modifications are undone in reverse order, and the queue is
+     * emptied, so that a tentative change, e.g. fixing a variable in
+     * probing, can be tried and taken back without propagating again.
+     *
+     * \param[in] mods The modifications saved by propagate(). Those from
+     * position n0 onwards are undone and removed.
+     * \param[in] n0 See above.
+     */
+    void undo(ModVector &mods, UInt n0);
+
+    /**
+     * \brief Find items that have been added to the propagators since the
+     * last call to init() or update() and put them in the queue.
+     */
+    void update();
+
+    /**
+     * \brief Tell the engine that bounds of a variable may have been
+     * changed by someone else. Its items are queued if they have.
+     */
+    void varChanged(ConstVariablePtr v);
+
+    /// Write statistics.
+    void writeStats(std::ostream &out) const;
+
+  private:
+    /// An item of a propagator: the position of propagator and the item.
+    typedef std::pair<UInt, UInt> PropItem;
+
+    /// Tolerance for change in bounds of continuous variables.
+    double absTol_;
+
+    /// True for items that are in the queue, one vector per propagator.
+    std::vector<BoolVector> inQueue_;
+
+    /// Tolerance for checking integrality.
+    double intTol_;
+
+    /// Lower bounds of variables as last seen.
+    DoubleVector lb_;
+
+    /// Modifications made in the current call to propagate().
+    ModVector *mods_;
+
+    /// For logging.
+    static const std::string me_;
+
+    /// Number of items of each propagator seen in init() or update().
+    UIntVector nItems_;
+
+    /// Number of bounds changed by tighten().
+    UInt nChanges_;
+
+    /// Number of changes to integer variables in the current propagate().
+    UInt *nIntMods_;
+
+    /// Number of times propagate() found infeasibility.
+    UInt nInf_;
+
+    /// Number of times propagate() stopped at the work limit.
+    UInt nLimit_;
+
+    /// Number of calls to propagate().
+    UInt nRuns_;
+
+    /// Number of items visited.
+    UInt nVisits_;
+
+    /// The problem.
+    ProblemPtr p_;
+
+    /// Propagators.
+    PropagatorVector props_;
+
+    /// Items waiting to be propagated.
+    std::deque<PropItem> queue_;
+
+    /// Tolerance for relative change in bounds of continuous variables.
+    double relTol_;
+
+    /// Upper bounds of variables as last seen.
+    DoubleVector ub_;
+
+    /// Items that use each variable.
+    std::vector< std::vector<PropItem> > varItems_;
+
+    /// Variables of the problem, by index.
+    VarVector vars_;
+
+    /// Multiple of the number of items that can be visited in one call.
+    double workFactor_;
+
+    /// Add the item i of propagator k to the lists of its variables.
+    void addItem_(UInt k, UInt i);
+
+    /// Empty the queue.
+    void clearQueue_();
+
+    /**
+     * Tell propagators about changed bounds of v. Queue its items if push
+     * is true.
+     */
+    void notify_(ConstVariablePtr v, bool push);
+
+    /// Put an item in the queue if it is not already there.
+    void push_(UInt k, UInt i);
+  };
+
+  typedef boost::shared_ptr<PropEngine> PropEnginePtr;
+}
+#endif
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
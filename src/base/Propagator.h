@@ -0,0 +1,98 @@
+//
+//     MINOTAUR -- It's only 1/2 bull
+//
+//     (C)opyright 2008 - 2014 The MINOTAUR Team.
+//
+
+/**
+ * \file Propagator.h
+ * \brief Declare the abstract base class Propagator, used by PropEngine for
+ * tightening bounds of variables.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#ifndef MINOTAURPROPAGATOR_H
+#define MINOTAURPROPAGATOR_H
+
+#include "Types.h"
+
+namespace Minotaur {
+
+  class PropEngine;
+
+  /**
+   * \brief Base class for anything that can tighten bounds of variables
+   * using a set of items (rows, bilinear terms, nonlinear constraints ...).
+   *
+   * Items are numbered from zero. The PropEngine asks for the variables of
+   * each item once, and later calls propagate() on an item only when the
+   * bounds of one of its variables have changed. A propagator that keeps
+   * data depending on the bounds (e.g. activities of rows) updates it in
+   * boundsChanged(), which the engine calls for every change, including
+   * changes made by other propagators and by branching.
+   */
+  class Propagator {
+  public:
+    /// Default constructor.
+    Propagator() {};
+
+    /// Destroy.
+    virtual ~Propagator() {};
+
+    /**
+     * \brief Update internal data after bounds of a variable change.
+     *
+     * \param[in] v The variable. Its new bounds are already set.
+     * \param[in] olb The lower bound of v before the change.
+     * \param[in] oub The upper bound of v before the change.
+     */
+    virtual void boundsChanged(ConstVariablePtr, double, double) {};
+
+    /// Return the name of the propagator.
+    virtual std::string getName() const = 0;
+
+    /// Return the number of items. Items may be appended later.
+    virtual UInt getNumItems() const = 0;
+
+    /**
+     * \brief Get the variables of an item.
+     *
+     * \param[in] i The item.
+     * \param[out] vars The variables whose bounds are used by the item are
+     * appended to it.
+     */
+    virtual void getVars(UInt i, VarVector &vars) const = 0;
+
+    /// Recompute all internal data from the current bounds.
+    virtual void init() {};
+
+    /**
+     * \brief Tighten bounds of variables using an item.
+     *
+     * New bounds must be sent to the engine by calling
+     * PropEngine::tighten(), or, if the propagator changed them itself, the
+     * engine must be told by calling PropEngine::varChanged().
+     *
+     * \param[in] i The item.
+     * \param[in] engine The engine that called this function.
+     * \return True if the item can not be satisfied within the current
+     * bounds. False otherwise.
+     */
+    virtual bool propagate(UInt i, PropEngine *engine) = 0;
+  };
+
+  typedef boost::shared_ptr<Propagator> PropagatorPtr;
+  typedef std::vector<PropagatorPtr> PropagatorVector;
+}
+#endif
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
@@ -17,11 +17,16 @@
 #include <iomanip>
 #include <iostream>
 #include <fstream>
+#if USE_OPENMP
+#include <omp.h>
+#endif
 
 #include "MinotaurConfig.h"
 
 #include "CNode.h"
 #include "Constraint.h"
+#include "CutBuffer.h"
+#include "CutManager.h"
 #include "Engine.h"
 #include "Environment.h"
 #include "Function.h"
@@ -49,12 +54,16 @@ typedef std::vector<ConstraintPtr>::const_iterator CCIter;
 const std::string QGHandler::me_ = "QGHandler: ";
 
 QGHandler::QGHandler()
-: env_(EnvPtr()),      
+: cutMan_(0),
+  relCutMan_(0),
+  env_(EnvPtr()),      
   intTol_(1e-6),
   linCoeffTol_(1e-6),
+  maxJobs_(10000),
   minlp_(ProblemPtr()),
   nlCons_(0),
   nlpe_(EnginePtr()),
+  nlpWorkers_(0),
   nlpStatus_(EngineUnknownStatus),
   nlpWs_(WarmStartPtr()),
   numCuts_(0),
@@ -69,12 +78,16 @@ QGHandler::QGHandler()
 }
 
 QGHandler::QGHandler(EnvPtr env, ProblemPtr minlp, EnginePtr nlpe) 
-: env_(env),
+: cutMan_(0),
+  relCutMan_(0),
+  env_(env),
   intTol_(1e-6),
   linCoeffTol_(1e-6),
+  maxJobs_(10000),
   minlp_(minlp),
   nlCons_(0),
   nlpe_(nlpe),
+  nlpWorkers_(0),
   nlpStatus_(EngineUnknownStatus),
   nlpWs_(WarmStartPtr()),
   numCuts_(0),
@@ -86,12 +99,14 @@ QGHandler::QGHandler(EnvPtr env, ProblemPtr minlp, EnginePtr nlpe)
 {
   logger_ = (LoggerPtr) new Logger((LogLevel)env->getOptions()->
                                    findInt("handler_log_level")->getValue());
+  nlpWorkers_ = env->getOptions()->findInt("qg_nlp_queue")->getValue();
 
   stats_   = new QGStats();
   stats_->nlpS = 0;
   stats_->nlpF = 0;
   stats_->nlpI = 0;
   stats_->cuts = 0;
+  stats_->nlpD = 0;
 }
 
 QGHandler::~QGHandler()
@@ -99,12 +114,31 @@ QGHandler::~QGHandler()
   if (stats_) {
     delete stats_;
   }
+  for (std::multimap<size_t, QGNlpJob *>::iterator it=nlpJobs_.begin();
+       it!=nlpJobs_.end(); ++it) {
+    delete it->second;
+  }
+  nlpJobs_.clear();
+  nlpQueue_.clear();
+  wEngines_.clear();
+  wProbs_.clear();
 
   env_.reset();
   minlp_.reset();
   nlpe_.reset();
 }
 
+ConstraintPtr QGHandler::addCut_(FunctionPtr f, double lb, double ub,
+                                const std::string &name)
+{
+  if (cutMan_) {
+    return cutMan_->addCut(rel_, f, lb, ub, true, false);
+  } else if (relCutMan_) {
+    return relCutMan_->addCut(rel_, f, lb, ub, true, false);
+  }
+  return rel_->newConstraint(f, lb, ub, name);
+}
+
 void QGHandler::addInitLinearX_(const double *x)
 { 
   ConstraintPtr con, newcon;
@@ -124,22 +158,25 @@ void QGHandler::addInitLinearX_(const double *x)
       linearAt_(f, act, x, &c, &lf);
       f2 = (FunctionPtr) new Function(lf);
       if (con->getUb() < INFINITY) {
-        newcon = rel_->newConstraint(f2, -INFINITY, con->getUb()-c,
-                                     "lnrztn_cut");
+        newcon = addCut_(f2, -INFINITY, con->getUb()-c, "lnrztn_cut");
         ++(stats_->cuts);
 #if SPEW
         logger_->msgStream(LogDebug) << me_ << "initial constr. cut: ";
-        newcon->write(logger_->msgStream(LogDebug));
+        if (newcon) {
+          newcon->write(logger_->msgStream(LogDebug));
+        }
 #endif
       }
 
       if (con->getLb() > -INFINITY) {
-        newcon = rel_->newConstraint(f2, con->getLb()-c, INFINITY, "lnrztn_cut");
+        newcon = addCut_(f2, con->getLb()-c, INFINITY, "lnrztn_cut");
         ++(stats_->cuts);  
 
 #if SPEW
         logger_->msgStream(LogDebug) << me_ << "initial constr. cut: ";
-        newcon->write(logger_->msgStream(LogDebug));
+        if (newcon) {
+          newcon->write(logger_->msgStream(LogDebug));
+        }
 #endif
       }
     }	else {
@@ -156,12 +193,14 @@ void QGHandler::addInitLinearX_(const double *x)
       linearAt_(f, act, x, &c, &lf);
       lf->addTerm(objVar_, -1.0);
       f2 = (FunctionPtr) new Function(lf);
-      newcon = rel_->newConstraint(f2, -INFINITY, -1.0*c, "objlnrztn_cut");
+      newcon = addCut_(f2, -INFINITY, -1.0*c, "objlnrztn_cut");
       ++(stats_->cuts);
 #if SPEW
       logger_->msgStream(LogDebug) << me_ << "initial obj cut: " << std::endl
         << std::setprecision(9);
-      newcon->write(logger_->msgStream(LogDebug));
+      if (newcon) {
+        newcon->write(logger_->msgStream(LogDebug));
+      }
 #endif
     }	else {
       logger_->msgStream(LogError) << me_ <<"Objective not defined at this point"
@@ -180,6 +219,11 @@ void QGHandler::cutIntSol_(ConstSolutionPtr sol, SolutionPoolPtr s_pool,
   double nlpval = INFINITY;
   const double *x = sol->getPrimal();
   double lp_obj = (sol) ? sol->getObjValue() : -INFINITY;
+
+  if (nlpWorkers_ > 0) {
+    cutIntSolQueued_(sol, s_pool, sol_found, status);
+    return;
+  }
   numCuts_=0;
   fixInts_(x);
   solveNLP_();
@@ -257,6 +301,127 @@ void QGHandler::cutIntSol_(ConstSolutionPtr sol, SolutionPoolPtr s_pool,
   }
 }
 
+void QGHandler::cutIntSolQueued_(ConstSolutionPtr sol,
+                                 SolutionPoolPtr s_pool, bool *sol_found,
+                                 SeparationStatus *status)
+{
+  const double *x = sol->getPrimal();
+  double lp_obj = sol->getObjValue();
+  QGNlpJob *job;
+
+  if (nlpJobs_.size() >= maxJobs_) {
+    evictJobs_();
+  }
+  job = findJob_(x);
+  numCuts_ = 0;
+  if (job) {
+    ++(stats_->nlpD);
+  } else {
+    job = new QGNlpJob();
+    for (VariableConstIterator vit=minlp_->varsBegin();
+         vit!=minlp_->varsEnd(); ++vit) {
+      if ((*vit)->getType()==Binary || (*vit)->getType()==Integer) {
+        job->ints.push_back(floor(x[(*vit)->getIndex()] + 0.5));
+      }
+    }
+    job->lpx.assign(x, x+numvars_);
+    job->lpObj = lp_obj;
+    job->done = false;
+    job->status = EngineUnknownStatus;
+    job->nlpVal = INFINITY;
+    nlpJobs_.insert(std::make_pair(intHash_(job->ints), job));
+    nlpQueue_.push_back(job);
+  }
+
+  if (false == job->done) {
+    // linearizations at x itself are valid and cut it off in most cases.
+    relobj_ = lp_obj;
+    numCuts_ = OAFromPoint_(x, x, status);
+    if (0 == numCuts_ || nlpQueue_.size() >= nlpWorkers_) {
+      solveQueued_(s_pool, sol_found, (numCuts_ > 0) ? 0 : job);
+    }
+    if (numCuts_ > 0) {
+      *status = SepaResolve;
+      return;
+    }
+  }
+
+  switch(job->status) {
+  case (ProvenOptimal):
+  case (ProvenLocalOptimal):
+    if (lp_obj > job->nlpVal-solAbsTol_ && 
+        lp_obj > job->nlpVal-(fabs(job->nlpVal))*solRelTol_) {
+      // the node is pruned, queued NLPs may still give solutions.
+      solveQueued_(s_pool, sol_found, 0);
+      *status = SepaPrune;
+      return;
+    }
+    relobj_ = lp_obj;
+    numCuts_ = OAFromPoint_(&(job->nlpx[0]), x, status);
+    break;
+  case (ProvenInfeasible):
+  case (ProvenLocalInfeasible): 
+  case (ProvenObjectiveCutOff):
+    if (false == job->nlpx.empty()) {
+      relobj_ = lp_obj;
+      numCuts_ = OAFromPointInf_(&(job->nlpx[0]), x, status);
+    }
+    break;
+  default:
+    logger_->msgStream(LogError) << me_ << "NLP engine status = " 
+      << job->status << std::endl
+      << me_ << "No cut generated, may cycle!" << std::endl;
+    *status = SepaError;
+  }
+
+  if (numCuts_ != 0) {
+    *status = SepaResolve;
+  } else {
+    solveQueued_(s_pool, sol_found, 0);
+    *status = SepaPrune;
+  }
+}
+
+
+void QGHandler::evictJobs_()
+{
+  std::multimap<size_t, QGNlpJob *>::iterator it = nlpJobs_.begin();
+
+  // jobs still in the queue are not done and are kept.
+  while (it!=nlpJobs_.end()) {
+    if (it->second->done) {
+      delete it->second;
+      nlpJobs_.erase(it++);
+    } else {
+      ++it;
+    }
+  }
+}
+
+
+QGNlpJob *QGHandler::findJob_(const double *x)
+{
+  DoubleVector ints;
+  std::pair<std::multimap<size_t, QGNlpJob *>::iterator,
+            std::multimap<size_t, QGNlpJob *>::iterator> range;
+
+  for (VariableConstIterator vit=minlp_->varsBegin(); vit!=minlp_->varsEnd(); 
+       ++vit) {
+    if ((*vit)->getType()==Binary || (*vit)->getType()==Integer) {
+      ints.push_back(floor(x[(*vit)->getIndex()] + 0.5));
+    }
+  }
+  range = nlpJobs_.equal_range(intHash_(ints));
+  for (std::multimap<size_t, QGNlpJob *>::iterator it=range.first;
+       it!=range.second; ++it) {
+    if (it->second->ints == ints) {
+      return it->second;
+    }
+  }
+  return 0;
+}
+
+
 void QGHandler::fixInts_(const double *x)
 {
   VariablePtr v;
@@ -275,6 +440,12 @@ void QGHandler::fixInts_(const double *x)
   }
 }
 
+void QGHandler::flushDeferred(SolutionPoolPtr s_pool, bool *sol_found)
+{
+  solveQueued_(s_pool, sol_found, 0);
+}
+
+
 void QGHandler::initLinear_(bool *isInf)
 {
 
@@ -313,6 +484,46 @@ void QGHandler::initLinear_(bool *isInf)
   }
 }
 
+void QGHandler::initWorkers_()
+{
+#if USE_OPENMP
+  // each thread gets its own copy, so that minlp_ is never changed while
+  // other threads read it.
+  if (nlpWorkers_ > 1 && minlp_->hasNativeDer()) {
+    ProblemPtr p;
+    EnginePtr e;
+    for (UInt i=0; i<nlpWorkers_; ++i) {
+      e = nlpe_->emptyCopy();
+      if (!e) {
+        break;
+      }
+      p = minlp_->clone();
+      p->setNativeDer();
+      e->load(p);
+      wProbs_.push_back(p);
+      wEngines_.push_back(e);
+    }
+  }
+#endif
+  if (wEngines_.empty()) {
+    wProbs_.push_back(minlp_);
+    wEngines_.push_back(nlpe_);
+  }
+  logger_->msgStream(LogDebug) << me_ << "engines for queued NLPs = " 
+    << wEngines_.size() << std::endl;
+}
+
+
+size_t QGHandler::intHash_(const DoubleVector &ints) const
+{
+  size_t h = ints.size();
+  for (DoubleVector::const_iterator it=ints.begin(); it!=ints.end(); ++it) {
+    h = h*1000003 + (size_t) ((long) *it);
+  }
+  return h;
+}
+
+
 bool QGHandler::isFeasible(ConstSolutionPtr sol, RelaxationPtr rel, 
                            bool &, double & )
 {
@@ -460,15 +671,16 @@ int QGHandler::OAFromPoint_(const double *x, const double *inf_x,
 
           if (lpvio>1e-4 && lpvio > (fabs(con->getUb()-c)*solRelTol_) ) {
             f2 = (FunctionPtr) new Function(lf);
-            newcon = rel_->newConstraint(f2, -INFINITY, con->getUb()-c,
-                                         "lnrztn_cut");
+            newcon = addCut_(f2, -INFINITY, con->getUb()-c, "lnrztn_cut");
             ++(stats_->cuts);
             ++num_cuts;
             *status = SepaResolve;
 #if SPEW
             logger_->msgStream(LogDebug) << me_ <<" OA cut: " << std::endl
               << std::setprecision(9);
-            newcon->write(logger_->msgStream(LogDebug));
+            if (newcon) {
+              newcon->write(logger_->msgStream(LogDebug));
+            }
 #endif
           } else{
 #if SPEW
@@ -488,15 +700,16 @@ int QGHandler::OAFromPoint_(const double *x, const double *inf_x,
           if (lpvio>1e-4 && lpvio >(fabs(con->getLb()-c)*solRelTol_)) {
             f2 = (FunctionPtr) new Function(lf);
 
-            newcon = rel_->newConstraint(f2, con->getLb()-c, INFINITY,
-                                         "lnrztn_cut");
+            newcon = addCut_(f2, con->getLb()-c, INFINITY, "lnrztn_cut");
             ++(stats_->cuts);
             ++num_cuts; 
             *status = SepaResolve;
 #if SPEW
             logger_->msgStream(LogDebug) << me_ << "OA cut: " << std::endl
               << std::setprecision(9);
-            newcon->write(logger_->msgStream(LogDebug));
+            if (newcon) {
+              newcon->write(logger_->msgStream(LogDebug));
+            }
 #endif
           }
         }
@@ -523,14 +736,16 @@ int QGHandler::OAFromPoint_(const double *x, const double *inf_x,
         if (lpvio>1e-4 && lpvio >(fabs(relobj_+c)*solRelTol_)) {
           lf->addTerm(objVar_, -1.0);
           f2 = (FunctionPtr) new Function(lf);
-          newcon = rel_->newConstraint(f2, -INFINITY, -1.0*c, "objlnrztn_cut"); 
+          newcon = addCut_(f2, -INFINITY, -1.0*c, "objlnrztn_cut"); 
           ++(stats_->cuts);
           ++num_cuts;
           *status = SepaResolve;
 #if SPEW
           logger_->msgStream(LogDebug) << me_ << "OA cut: " << std::endl
             << std::setprecision(9);
-          newcon->write(logger_->msgStream(LogDebug));
+          if (newcon) {
+            newcon->write(logger_->msgStream(LogDebug));
+          }
 #endif
         } else{
 #if SPEW
@@ -575,15 +790,16 @@ int QGHandler::OAFromPointInf_(const double *x, const double *inf_x,
         lpact = f2->eval(inf_x, &error);
         if (lpact - con->getUb() + c > solAbsTol_ && 
             lpact - con->getUb() + c >(fabs(con->getUb()-c)*solRelTol_)) {
-          newcon = rel_->newConstraint(f2, -INFINITY, con->getUb()-c,
-                                       "lnrztn_cut");
+          newcon = addCut_(f2, -INFINITY, con->getUb()-c, "lnrztn_cut");
           ++(stats_->cuts);
           ++ncuts;
           *status = SepaResolve;
 #if SPEW
           logger_->msgStream(LogDebug) << me_ << "OA cut: " << std::endl
             << std::setprecision(9);
-          newcon->write(logger_->msgStream(LogDebug));
+          if (newcon) {
+            newcon->write(logger_->msgStream(LogDebug));
+          }
 #endif
         }
       }
@@ -594,15 +810,16 @@ int QGHandler::OAFromPointInf_(const double *x, const double *inf_x,
         lpact = f2->eval(inf_x, &error);
         if (lpact - con->getLb() + c < -solAbsTol_  || 
             lpact - con->getLb() + c <-(fabs(con->getLb()-c)*solRelTol_)) {
-          newcon = rel_->newConstraint(f2, con->getLb()-c, INFINITY,
-                                       "lnrztn_cut");
+          newcon = addCut_(f2, con->getLb()-c, INFINITY, "lnrztn_cut");
           ++(stats_->cuts);
           ++ncuts; 
           *status = SepaResolve;
 #if SPEW
           logger_->msgStream(LogDebug) << me_ << "OA cut: " << std::endl
             << std::setprecision(9);
-          newcon->write(logger_->msgStream(LogDebug));
+          if (newcon) {
+            newcon->write(logger_->msgStream(LogDebug));
+          }
 #endif
         }
       }
@@ -669,7 +886,7 @@ void QGHandler::relax_(RelaxationPtr rel, bool *is_inf)
 }
 
 void QGHandler::separate(ConstSolutionPtr sol, NodePtr , RelaxationPtr rel, 
-                         CutManager *, SolutionPoolPtr s_pool,
+                         CutManager *cutman, SolutionPoolPtr s_pool,
                          bool *sol_found, SeparationStatus *status)
 {      
   numvars_ = minlp_->getNumVars();
@@ -679,6 +896,9 @@ void QGHandler::separate(ConstSolutionPtr sol, NodePtr , RelaxationPtr rel,
   const double *x = sol->getPrimal();
   bool is_int_feas = true; 
   rel_=rel;
+  // only the buffer of a concurrent round collects the cuts; otherwise they
+  // go to the relaxation as before.
+  cutMan_ = dynamic_cast<CutBuffer *>(cutman);
 
   for (v_iter=rel_->varsBegin(); v_iter!=rel_->varsEnd(); 
        ++v_iter) {
@@ -705,6 +925,7 @@ void QGHandler::separate(ConstSolutionPtr sol, NodePtr , RelaxationPtr rel,
       << me_ << "solution is not integer feasible" << std::endl;	  
 #endif
   }
+  cutMan_ = 0;
 }
 
 void QGHandler::solveNLP_()
@@ -713,6 +934,114 @@ void QGHandler::solveNLP_()
   ++(stats_->nlpS);
 }
 
+void QGHandler::solveJob_(QGNlpJob *job, ProblemPtr p, EnginePtr e,
+                          const DoubleVector &lb, const DoubleVector &ub)
+{
+  VariablePtr v;
+  UInt i = 0;
+  UInt k = 0;
+
+  for (VariableConstIterator vit=p->varsBegin(); vit!=p->varsEnd();
+       ++vit, ++i) {
+    v = *vit;
+    if (v->getType()==Binary || v->getType()==Integer) {
+      p->changeBound(v, job->ints[k], job->ints[k]);
+      ++k;
+    } else {
+      // copies do not see bound changes made to minlp_ after cloning.
+      p->changeBound(v, lb[i], ub[i]);
+    }
+  }
+
+  job->status = e->solve();
+  if (e->getSolution()) {
+    job->nlpx.assign(e->getSolution()->getPrimal(),
+                     e->getSolution()->getPrimal()+p->getNumVars());
+    job->nlpVal = e->getSolutionValue();
+  }
+  job->done = true;
+
+  i = 0;
+  for (VariableConstIterator vit=p->varsBegin(); vit!=p->varsEnd();
+       ++vit, ++i) {
+    p->changeBound(*vit, lb[i], ub[i]);
+  }
+}
+
+
+void QGHandler::solveQueued_(SolutionPoolPtr s_pool, bool *sol_found,
+                             QGNlpJob *cur)
+{
+  int n = nlpQueue_.size();
+  QGNlpJob *job;
+  SeparationStatus st;
+  DoubleVector lb, ub;
+
+  if (0 == n) {
+    return;
+  }
+  if (wEngines_.empty()) {
+    initWorkers_();
+  }
+
+  // threads read the bounds from here and not from minlp_.
+  lb.reserve(minlp_->getNumVars());
+  ub.reserve(minlp_->getNumVars());
+  for (VariableConstIterator vit=minlp_->varsBegin(); 
+       vit!=minlp_->varsEnd(); ++vit) {
+    lb.push_back((*vit)->getLb());
+    ub.push_back((*vit)->getUb());
+  }
+
+#if USE_OPENMP
+#pragma omp parallel for num_threads(wEngines_.size()) schedule(dynamic, 1)
+#endif
+  for (int i=0; i<n; ++i) {
+    UInt w = 0;
+#if USE_OPENMP
+    w = omp_get_thread_num();
+#endif
+    solveJob_(nlpQueue_[i], wProbs_[w], wEngines_[w], lb, ub);
+  }
+
+  for (int i=0; i<n; ++i) {
+    job = nlpQueue_[i];
+    ++(stats_->nlpS);
+    switch(job->status) {
+    case (ProvenOptimal):
+    case (ProvenLocalOptimal):
+      ++(stats_->nlpF);
+      if (job->nlpVal <= s_pool->getBestSolutionValue()) {
+        s_pool->addSolution(&(job->nlpx[0]), job->nlpVal);
+        *sol_found = true;
+      }
+      if (job != cur && 
+          (job->lpObj < job->nlpVal-solAbsTol_ ||
+           job->lpObj < job->nlpVal-(fabs(job->nlpVal))*solRelTol_)) {
+        relobj_ = job->lpObj;
+        OAFromPoint_(&(job->nlpx[0]), &(job->lpx[0]), &st);
+      }
+      break;
+    case (ProvenInfeasible):
+    case (ProvenLocalInfeasible): 
+    case (ProvenObjectiveCutOff):
+      ++(stats_->nlpI);
+      if (job != cur && false == job->nlpx.empty()) {
+        relobj_ = job->lpObj;
+        OAFromPointInf_(&(job->nlpx[0]), &(job->lpx[0]), &st);
+      }
+      break;
+    default:
+      logger_->msgStream(LogError) << me_ << "queued NLP engine status = " 
+        << job->status << std::endl;
+    }
+    // the LP point is not needed any more.
+    DoubleVector().swap(job->lpx);
+  }
+  nlpQueue_.clear();
+}
+
+
 void QGHandler::updateUb_(SolutionPoolPtr s_pool, double *nlpval, 
                           bool *sol_found)
 {
@@ -749,7 +1078,8 @@ void QGHandler::writeStats(std::ostream &out) const
     << me_ << "number of nlps solved       = " << stats_->nlpS << std::endl
     << me_ << "number of infeasible nlps   = " << stats_->nlpI << std::endl
     << me_ << "number of feasible nlps     = " << stats_->nlpF << std::endl
-    << me_ << "number of cuts added        = " << stats_->cuts << std::endl;
+    << me_ << "number of cuts added        = " << stats_->cuts << std::endl
+    << me_ << "number of repeated nlps     = " << stats_->nlpD << std::endl;
 }
 
 std::string QGHandler::getName() const
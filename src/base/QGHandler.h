@@ -14,6 +14,7 @@
 #ifndef MINOTAURQGHANDLER_H
 #define MINOTAURQGHANDLER_H
 
+#include <map>
 #include <stack>
 
 #include "Handler.h"
@@ -31,9 +32,22 @@ struct QGStats {
   size_t nlpF;      /// Number of nlps feasible.
   size_t nlpI;      /// Number of nlps infeasible.
   size_t cuts;      /// Number of cuts added to the LP.
+  size_t nlpD;      /// Number of nlps skipped because already queued/solved.
 }; 
 
 
+/// A fixed-integer NLP queued by QGHandler and its result.
+struct QGNlpJob {
+  DoubleVector ints;    /// Values of integer variables, in order of index.
+  DoubleVector lpx;     /// LP point for which the NLP was queued.
+  double lpObj;         /// Objective value of lpx in the relaxation.
+  bool done;            /// True once the NLP has been solved.
+  EngineStatus status;  /// Status of the NLP engine.
+  DoubleVector nlpx;    /// Solution of the NLP, empty if none.
+  double nlpVal;        /// Objective value of nlpx.
+};
+
+
 /**
  * \brief Handler for convex constraints, based on quesada-grossmann
  * algorithm.
@@ -44,6 +58,19 @@ struct QGStats {
 class QGHandler : public Handler {
 
 private: 
+  /**
+   * CutBuffer passed to separate() when it runs concurrently with other
+   * handlers. Cuts are sent to it when it is not NULL, otherwise they are
+   * added as they were before concurrent separation.
+   */
+  CutManager *cutMan_;
+
+  /**
+   * Cut manager for cuts generated outside separate(), e.g., in
+   * isFeasible() or when the relaxation is created. NULL if not set.
+   */
+  CutManager *relCutMan_;
+
   /// Pointer to environment.
   EnvPtr env_;
 
@@ -65,6 +92,9 @@ private:
 	/// Log.
   LoggerPtr logger_;
 
+  /// Number of NLPs in nlpJobs_ at which solved ones are deleted.
+  const UInt maxJobs_;
+
   /// For log:
   static const std::string me_;
 
@@ -77,9 +107,24 @@ private:
   /// NLP/QP Engine used to solve the NLP/QP relaxations.
   EnginePtr nlpe_;
 
+  /**
+   * All fixed-integer NLPs queued so far, keyed by intHash_(). Solved ones
+   * are deleted when there are maxJobs_ of them.
+   */
+  std::multimap<size_t, QGNlpJob *> nlpJobs_;
+
   /// Modifications done to NLP before solving it.
   std::stack<Modification *> nlpMods_;
 
+  /// Fixed-integer NLPs that have been queued but not solved yet.
+  std::vector<QGNlpJob *> nlpQueue_;
+
+  /**
+   * Number of fixed-integer NLPs solved together. If 0, the NLP is solved
+   * as soon as an integer point is found, and the tree search waits for it.
+   */
+  UInt nlpWorkers_;
+
 	/// Status of the NLP/QP engine.
   EngineStatus nlpStatus_;
 
@@ -126,6 +171,12 @@ private:
   /// Statistics.
   QGStats *stats_;
 
+  /// NLP engines used for solving queued NLPs, one for each thread.
+  std::vector<EnginePtr> wEngines_;
+
+  /// Copies of the original problem loaded into wEngines_.
+  std::vector<ProblemPtr> wProbs_;
+
 
   
 public:
@@ -161,9 +212,19 @@ public:
   {return ModificationPtr();}; // NULL
 
        
+  /**
+   * Solve the NLPs still in the queue. New solutions are added to s_pool
+   * and sol_found is set to true if there are any.
+   */
+  void flushDeferred(SolutionPoolPtr s_pool, bool *sol_found);
+
   // Base class method. 
   std::string getName() const;
 
+  // Base class method. Only the original problem and the NLP engine owned
+  // by this handler are modified during separation.
+  bool isConcurrentSep() const { return true; }
+
   // Base class method. Check if x is feasible. x has to satisfy integrality
   // and also nonlinear constraints.
   bool isFeasible(ConstSolutionPtr sol, RelaxationPtr relaxation, 
@@ -193,6 +254,15 @@ public:
   void relaxNodeInc(NodePtr node, RelaxationPtr rel, bool *is_inf);
 
  
+  /**
+   * \brief Send all cuts to a cut manager.
+   *
+   * Cuts generated outside separate() are added to the relaxation directly
+   * unless a cut manager is set here. A manager set here can then remove
+   * them when they are no longer active.
+   */
+  void setCutManager(CutManager *cutman) { relCutMan_ = cutman; }
+
   // Base class method. Find cuts.
   void separate(ConstSolutionPtr sol, NodePtr node, RelaxationPtr rel, 
                 CutManager *cutman, SolutionPoolPtr s_pool, bool *sol_found,
@@ -202,6 +272,14 @@ public:
   void writeStats(std::ostream &out) const;
 
 private:
+  /**
+   * Add the cut lb <= f <= ub to the cut manager if there is one, and to
+   * the relaxation otherwise. Returns the new constraint, which is NULL
+   * when the cut manager does not add the cut right away.
+   */
+  ConstraintPtr addCut_(FunctionPtr f, double lb, double ub,
+                        const std::string &name);
+
 	/**
    * Find the linearization of nonlinear functions at point x* and add
    * them to the relaxation only (not to the lp engine)
@@ -215,6 +293,24 @@ private:
   void cutIntSol_(ConstSolutionPtr sol, SolutionPoolPtr s_pool, 
                   bool *sol_found, SeparationStatus *status);
 
+  /**
+   * Same as cutIntSol_(), but the NLP is only queued if it has not been
+   * seen before. The point is cut off by linearizing at the point itself,
+   * so that the tree search need not wait for the NLP. The queue is solved
+   * when it is full, or when no such linearization cuts the point off.
+   */
+  void cutIntSolQueued_(ConstSolutionPtr sol, SolutionPoolPtr s_pool,
+                        bool *sol_found, SeparationStatus *status);
+
+  /// Delete the solved NLPs from nlpJobs_. Queued ones are kept.
+  void evictJobs_();
+
+  /**
+   * Return the queued or solved NLP in which integer variables are fixed to
+   * their (rounded) values in x. NULL if there is none.
+   */
+  QGNlpJob *findJob_(const double *x);
+
   /**
    * Fix integer constrained variables to integer values in x. Called
    * before solving NLP.
@@ -228,6 +324,17 @@ private:
    */
   void initLinear_(bool *isInf);
 
+  /**
+   * Create the engines and problem copies used for solving queued NLPs,
+   * one for each thread. Copies are created only when OpenMP is available
+   * and the engine can be copied. Otherwise nlpe_ and minlp_ are the only
+   * worker.
+   */
+  void initWorkers_();
+
+  /// Hash value of the values of integer variables.
+  size_t intHash_(const DoubleVector &ints) const;
+
   /**
    * Obtain the linear function (lf) and constant (c) from the
    * linearization of function f at point x.
@@ -257,6 +364,21 @@ private:
   /// Solve the nlp.
   void solveNLP_();
 
+  /**
+   * Solve a queued NLP using problem p loaded in engine e. The bounds of
+   * the continuous variables are taken from lb and ub, and all bounds of p
+   * are set to lb and ub when done. Only the job and p are modified.
+   */
+  void solveJob_(QGNlpJob *job, ProblemPtr p, EnginePtr e,
+                 const DoubleVector &lb, const DoubleVector &ub);
+
+  /**
+   * Solve all queued NLPs, in parallel if there are several engines. New
+   * solutions are added to s_pool and cuts are added for each NLP, except
+   * for cur, whose result is used by the caller.
+   */
+  void solveQueued_(SolutionPoolPtr s_pool, bool *sol_found, QGNlpJob *cur);
+
 	/// Undo the changes done in fixInts_().
   void unfixInts_();
 
@@ -22,6 +22,8 @@
 #include "Branch.h"
 #include "BrVarCand.h"
 #include "Constraint.h"
+#include "CutBuffer.h"
+#include "CutManager.h"
 #include "Environment.h"
 #include "Function.h"
 #include "LinBil.h"
@@ -34,6 +36,7 @@
 #include "Operations.h"
 #include "Option.h"
 #include "ProblemSize.h"
+#include "PropEngine.h"
 #include "QuadHandler.h"
 #include "QuadraticFunction.h"
 #include "Relaxation.h"
@@ -60,6 +63,7 @@ QuadHandler::QuadHandler(EnvPtr env, ProblemPtr problem)
   p_ = problem; 
   modProb_ = false;
   modRel_ = true;
+  propEngine_ = env->getOptions()->findBool("prop_engine")->getValue();
   logger_  = (LoggerPtr) new Logger((LogLevel) 
                                     env->getOptions()->
                                     findInt("handler_log_level")->getValue());
@@ -71,6 +75,8 @@ QuadHandler::QuadHandler(EnvPtr env, ProblemPtr problem)
 
 QuadHandler::~QuadHandler()
 {
+  prop_.reset();
+  quadProp_.reset();
   for (LinSqrMapIter it=x2Funs_.begin(); it != x2Funs_.end(); ++it) {
     delete it->second;
   }
@@ -539,7 +545,8 @@ LinearFunctionPtr QuadHandler::getNewSqLf_(VariablePtr x, VariablePtr y,
 
 void QuadHandler::addCut_(VariablePtr x, VariablePtr y, 
                           double xl, double yl, double xval, double yval,
-                          RelaxationPtr rel, bool &ifcuts)
+                          RelaxationPtr rel, CutManager *cutman,
+                          bool &ifcuts)
 {
   // add the cut 2*xl*x - y - yl <= 0
   ifcuts = false;
@@ -552,12 +559,18 @@ void QuadHandler::addCut_(VariablePtr x, VariablePtr y,
     lf->addTerm(x, 2*xl);
     lf->addTerm(y, -1.0);
     f = (FunctionPtr) new Function(lf);
-    c = rel->newConstraint(f, -INFINITY, xl*xl);
+    if (cutman) {
+      c = cutman->addCut(rel, f, -INFINITY, xl*xl, true, false);
+    } else {
+      c = rel->newConstraint(f, -INFINITY, xl*xl);
+    }
     ifcuts = true;
     ++sStats_.cuts;
 #if SPEW
     logger_->msgStream(LogDebug2) << me_ << "new cut added" << std::endl;
-    c->write(logger_->msgStream(LogDebug2));
+    if (c) {
+      c->write(logger_->msgStream(LogDebug2));
+    }
 #endif
   } else {
 #if SPEW
@@ -643,6 +656,26 @@ bool QuadHandler::presolveNode(RelaxationPtr rel, NodePtr, SolutionPoolPtr,
   bool is_inf = false;
   double stime = timer_->query();
 
+  if (propEngine_) {
+    if (!prop_) {
+      quadProp_ = (QuadPropagatorPtr) new QuadPropagator(this);
+      prop_ = (PropEnginePtr) new PropEngine(p_);
+      prop_->addPropagator(quadProp_);
+      prop_->init();
+    } else {
+      prop_->sync();
+    }
+    ++pStats_.iters;
+    quadProp_->setNode(rel, &p_mods, &r_mods);
+    is_inf = prop_->propagate(0, 0);
+    quadProp_->setNode(RelaxationPtr(), 0, 0);
+    if (is_inf) {
+      pStats_.timeN += timer_->query()-stime;
+      return true;
+    }
+    changed = false;
+  }
+
   // visit each quadratic constraint and see if bounds can be improved.
   while (true==changed) {
     ++pStats_.iters;
@@ -902,7 +935,7 @@ void QuadHandler::resetStats_()
 
 
 void QuadHandler::separate(ConstSolutionPtr sol, NodePtr , RelaxationPtr rel,
-                           CutManager *, SolutionPoolPtr , bool *,
+                           CutManager *cutman, SolutionPoolPtr , bool *,
                            SeparationStatus *status)
 {
   double yval, xval;
@@ -911,6 +944,7 @@ void QuadHandler::separate(ConstSolutionPtr sol, NodePtr , RelaxationPtr rel,
   bool ifcuts;
 
   ++sStats_.iters;
+  // cuts go to cutman only if it buffers them for a concurrent round.
   for (LinSqrMapIter it=x2Funs_.begin(); it != x2Funs_.end(); ++it) {
     xval = x[it->first->getIndex()];
     yval = x[it->second->y->getIndex()];
@@ -924,7 +958,7 @@ void QuadHandler::separate(ConstSolutionPtr sol, NodePtr , RelaxationPtr rel,
       findLinPt_(xval, yval, xl, yl);
       addCut_(rel->getRelaxationVar(it->first), 
               rel->getRelaxationVar(it->second->y), xl, yl, xval, yval, 
-              rel, ifcuts);
+              rel, dynamic_cast<CutBuffer *>(cutman), ifcuts);
       if (true==ifcuts) {
         *status = SepaResolve;
       }
@@ -1175,6 +1209,81 @@ void QuadHandler::writeStats(std::ostream &out) const
     << me_ << "Number of cuts added           = "<< sStats_.cuts   << std::endl
     << me_ << "Time taken in separation       = "<< sStats_.time   << std::endl
     ;
+  if (prop_) {
+    prop_->writeStats(out);
+  }
+}
+
+
+QuadPropagator::QuadPropagator(QuadHandler *qh)
+  : pMods_(0),
+    qh_(qh),
+    rMods_(0)
+{
+  for (LinSqrMapIter it=qh->x2Funs_.begin(); it!=qh->x2Funs_.end(); ++it) {
+    sqrs_.push_back(it);
+  }
+  bils_.insert(bils_.end(), qh->x0x1Funs_.begin(), qh->x0x1Funs_.end());
+}
+
+
+QuadPropagator::~QuadPropagator()
+{
+  bils_.clear();
+  sqrs_.clear();
+  rel_.reset();
+}
+
+
+std::string QuadPropagator::getName() const
+{
+  return "QuadPropagator";
+}
+
+
+void QuadPropagator::getVars(UInt i, VarVector &vars) const
+{
+  if (i < sqrs_.size()) {
+    vars.push_back(sqrs_[i]->first);
+    vars.push_back(sqrs_[i]->second->y);
+  } else {
+    i -= sqrs_.size();
+    vars.push_back(bils_[i]->getX0());
+    vars.push_back(bils_[i]->getX1());
+    vars.push_back(bils_[i]->getY());
+  }
+}
+
+
+bool QuadPropagator::propagate(UInt i, PropEngine *engine)
+{
+  bool changed = false;
+  bool is_inf;
+  VarVector vars;
+
+  if (i < sqrs_.size()) {
+    is_inf = qh_->propSqrBnds_(sqrs_[i], rel_, qh_->modRel_, &changed,
+                               *pMods_, *rMods_);
+  } else {
+    is_inf = qh_->propBilBnds_(bils_[i-sqrs_.size()], rel_, qh_->modRel_,
+                               &changed, *pMods_, *rMods_);
+  }
+  if (true==changed && false==is_inf) {
+    getVars(i, vars);
+    for (VarVector::const_iterator it=vars.begin(); it!=vars.end(); ++it) {
+      engine->varChanged(*it);
+    }
+  }
+  return is_inf;
+}
+
+
+void QuadPropagator::setNode(RelaxationPtr rel, ModVector *p_mods,
+                             ModVector *r_mods)
+{
+  rel_ = rel;
+  pMods_ = p_mods;
+  rMods_ = r_mods;
 }
 
 // Local Variables: 
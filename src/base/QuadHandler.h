@@ -19,12 +19,16 @@
 
 #include "Handler.h"
 #include "LinBil.h"
+#include "Propagator.h"
 
 namespace Minotaur {
 
 class LinearFunction;
+class PropEngine;
+class QuadHandler;
 class Timer;
 typedef boost::shared_ptr<LinearFunction> LinearFunctionPtr;
+typedef boost::shared_ptr<PropEngine> PropEnginePtr;
 
 /**
  * \brief A structure to save information about constraints of the form \f$ y
@@ -44,6 +48,62 @@ typedef std::map<VariablePtr, LinSqrPtr, CompareVariablePtr> LinSqrMap;
 typedef LinSqrMap::iterator LinSqrMapIter; ///> Iterator for LinSqrMap
 
 
+/**
+ * \brief Let a PropEngine tighten bounds using the square and bilinear
+ * constraints of a QuadHandler.
+ *
+ * Items are the squares followed by the bilinear terms. Bounds are changed
+ * by QuadHandler::propSqrBnds_() and QuadHandler::propBilBnds_(), which
+ * also save the modifications, and the engine is then told about them.
+ */
+class QuadPropagator : public Propagator {
+public:
+  /// Constructor. The handler must not change its terms afterwards.
+  QuadPropagator(QuadHandler *qh);
+
+  /// Destroy.
+  ~QuadPropagator();
+
+  // base class method.
+  std::string getName() const;
+
+  // base class method.
+  UInt getNumItems() const { return sqrs_.size()+bils_.size(); }
+
+  // base class method.
+  void getVars(UInt i, VarVector &vars) const;
+
+  // base class method.
+  bool propagate(UInt i, PropEngine *engine);
+
+  /**
+   * \brief Set the relaxation and the vectors in which modifications are
+   * saved during the next propagation. Pass NULL rel when done.
+   */
+  void setNode(RelaxationPtr rel, ModVector *p_mods, ModVector *r_mods);
+
+private:
+  /// Bilinear terms.
+  std::vector<LinBil*> bils_;
+
+  /// Modifications to the problem are appended here.
+  ModVector *pMods_;
+
+  /// The handler.
+  QuadHandler *qh_;
+
+  /// Relaxation at the current node.
+  RelaxationPtr rel_;
+
+  /// Modifications to the relaxation are appended here.
+  ModVector *rMods_;
+
+  /// Square terms.
+  std::vector<LinSqrMapIter> sqrs_;
+};
+typedef boost::shared_ptr<QuadPropagator> QuadPropagatorPtr;
+
+
 /**
  * A QuadHandler handles the quadratic functions of a problem in a simplistic
  * fashion. For now, we will just handle squares of singleton variables e.g.
@@ -76,6 +136,9 @@ public:
   // base class method
   std::string getName() const;
 
+  // base class method. Separation only reads the point and the variables.
+  bool isConcurrentSep() const { return true; }
+
   // base class method.
   bool isFeasible(ConstSolutionPtr sol, RelaxationPtr relaxation, 
                   bool &should_prune, double &inf_meas);
@@ -110,6 +173,8 @@ public:
   void writeStats(std::ostream &out) const;
 
 private:
+  friend class QuadPropagator;
+
   /// Store statistics of presolving.
   struct SepaStats 
   {
@@ -143,9 +208,18 @@ private:
   /// Transformed problem (not the relaxation).
   ProblemPtr p_;
 
+  /// Engine that propagates only the terms whose variables changed.
+  PropEnginePtr prop_;
+
+  /// If true, use prop_ in presolveNode.
+  bool propEngine_;
+
   /// Statistics about presolve
   PresolveStats pStats_;
 
+  /// The propagator of the terms, used by prop_.
+  QuadPropagatorPtr quadProp_;
+
   /// Relative feasibility tolerance
   double rTol_;
 
@@ -176,11 +250,14 @@ private:
    * \param[in] xval    x coordinate of point that is to be cut off
    * \param[in] yval    y coordinate of point that is to be cut off
    * \param[in] rel     Relaxation pointer to which the cut is added
+   * \param[in] cutman  If not NULL, the cut is sent to this cut manager
+   *                    instead of being added to rel directly.
    * \param[out] ifcuts True if the new inequality cuts off the point
    *                    (xval,yval)
    */
   void addCut_(VariablePtr x, VariablePtr y, double xl, double yl, double xval,
-               double yval, RelaxationPtr rel, bool &ifcuts);
+               double yval, RelaxationPtr rel, CutManager *cutman,
+               bool &ifcuts);
 
   /**
    * \brief Find the point at which a gradient-based linearization inequality
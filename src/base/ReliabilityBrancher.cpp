@@ -25,6 +25,7 @@
 #include "Node.h"
 #include "Option.h"
 #include "ProblemSize.h"
+#include "Profiler.h"
 #include "Relaxation.h"
 #include "ReliabilityBrancher.h"
 #include "Solution.h"
@@ -391,6 +392,47 @@ void ReliabilityBrancher::initialize(RelaxationPtr rel)
 }
 
 
+bool ReliabilityBrancher::loadState(const DoubleVector &state)
+{
+  UInt n;
+  if (state.empty()) {
+    return true;
+  }
+  n = (UInt) state[0];
+  if (state.size() != 4*n+1) {
+    return false;
+  }
+  pseudoUp_.assign(state.begin()+1, state.begin()+n+1);
+  pseudoDown_.assign(state.begin()+n+1, state.begin()+2*n+1);
+  timesUp_.resize(n);
+  timesDown_.resize(n);
+  for (UInt i=0; i<n; ++i) {
+    timesUp_[i] = (UInt) state[2*n+1+i];
+    timesDown_[i] = (UInt) state[3*n+1+i];
+  }
+  lastStrBranched_ = UIntVector(n,20000);
+  relCands_.reserve(n);
+  unrelCands_.reserve(n);
+  x_.reserve(n);
+  init_ = true;
+  return true;
+}
+
+
+void ReliabilityBrancher::saveState(DoubleVector *state) const
+{
+  UInt n = pseudoUp_.size();
+  if (0==n) {
+    return;
+  }
+  state->push_back(n);
+  state->insert(state->end(), pseudoUp_.begin(), pseudoUp_.end());
+  state->insert(state->end(), pseudoDown_.begin(), pseudoDown_.end());
+  state->insert(state->end(), timesUp_.begin(), timesUp_.end());
+  state->insert(state->end(), timesDown_.begin(), timesDown_.end());
+}
+
+
 void ReliabilityBrancher::setTrustCutoff(bool val)
 {
   trustCutoff_ = val;
@@ -473,6 +515,7 @@ void ReliabilityBrancher::strongBranch_(BrCandPtr cand, double & obj_up,
                                         EngineStatus & status_up, 
                                         EngineStatus & status_down)
 {
+  ProfZone zone(ProfEngine);
   HandlerPtr h = cand->getHandler();
   ModificationPtr mod;
 
@@ -510,7 +553,8 @@ void ReliabilityBrancher::updateAfterLP(NodePtr node, ConstSolutionPtr sol)
 {
   const double *x = sol->getPrimal();
   NodePtr parent = node->getParent();
-  if (parent) {
+  // nodes resumed from a checkpoint have no branch.
+  if (parent && node->getBranch() && node->getBranch()->getBrCand()) {
     BrCandPtr cand = node->getBranch()->getBrCand();
     int index = cand->getPCostIndex();
     if (index>-1) {
@@ -72,6 +72,18 @@ public:
    */
   void initialize(RelaxationPtr rel);
 
+  /**
+   * \brief Restore the pseudo costs saved by saveState(). Candidates are
+   * treated as if they were not strong branched recently.
+   */
+  bool loadState(const DoubleVector &state);
+
+  /**
+   * \brief Save the pseudo costs and the number of times they were updated,
+   * if they are initialized.
+   */
+  void saveState(DoubleVector *state) const;
+
   /// Set value of trustCutoff parameter.
   void setTrustCutoff(bool val);
 
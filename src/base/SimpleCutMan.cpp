@@ -17,10 +17,14 @@
 #include "Environment.h"
 #include "Function.h"
 #include "Cut.h"
+#include "LinearFunction.h"
 #include "Logger.h"
+#include "Objective.h"
+#include "Option.h"
 #include "Problem.h"
 #include "SimpleCutMan.h"
 #include "Solution.h"
+#include "Variable.h"
 #include "Types.h"
 
 //#define SPEW 1
@@ -34,8 +38,12 @@ const std::string SimpleCutMan::me_ = "SimpleCutMan: ";
 
 
 SimpleCutMan::SimpleCutMan()
-  : env_(EnvPtr()),   // NULL
+  : enCuts_(0),
+    env_(EnvPtr()),   // NULL
+    maxCos_(1.0),
+    maxSel_(0),
     p_(ProblemPtr()), // NULL
+    objWt_(0.1),
     violAbs_(1e-4),
     violRel_(1e-3)
 {
@@ -44,18 +52,28 @@ SimpleCutMan::SimpleCutMan()
 
 
 SimpleCutMan::SimpleCutMan(EnvPtr env, ProblemPtr p)
-  : env_(env),
+  : enCuts_(0),
+    env_(env),
+    maxCos_(1.0),
+    maxSel_(0),
     p_(p),
+    objWt_(0.1),
     violAbs_(1e-4),
     violRel_(1e-3)
 {
   logger_ = (LoggerPtr) new Logger(LogDebug2);
+  if (env_) {
+    maxCos_ = env_->getOptions()->findDouble("cut_max_cos")->getValue();
+    maxSel_ = env_->getOptions()->findInt("cut_sel_max")->getValue();
+  }
 }
 
 
 SimpleCutMan::~SimpleCutMan()
 {
   newCuts_.clear();
+  nlPool_.clear();
+  pool_.clear();
 }
 
 
@@ -96,7 +114,7 @@ UInt SimpleCutMan::getNumEnabledCuts() const
 
 UInt SimpleCutMan::getNumDisabledCuts() const
 {
-  return 0;
+  return pool_.getNumCuts() + nlPool_.size();
 }
 
 
@@ -109,8 +127,11 @@ UInt SimpleCutMan::getNumNewCuts() const
 void SimpleCutMan::mvNewToPool_()
 {
   for (CLIter it=newCuts_.begin(); it!=newCuts_.end(); ++it) {
-    pool_.push_back(*it);
+    if (false == pool_.addCut(*it)) {
+      nlPool_.push_back(*it);
+    }
   }
+  newCuts_.clear();
 }
 
 
@@ -119,22 +140,69 @@ void SimpleCutMan::postSolveUpdate(ConstSolutionPtr, EngineStatus)
 }
 
 
-void SimpleCutMan::separate(ProblemPtr p, ConstSolutionPtr sol, bool *, UInt *)
+void SimpleCutMan::separate(ProblemPtr p, ConstSolutionPtr sol,
+                            bool *separated, UInt *added)
 {
   const double *x = sol->getPrimal();
+  DoubleVector obj, act, eff, objpar;
+  UIntVector rows;
+  CutVector sel;
+  LinearFunctionPtr olf;
   CutPtr cut;
-  double viol, act;
+  double lhs, viol;
   int err;
+  UInt n = 0;
 
   mvNewToPool_();
- 
-  for (CLIter it=pool_.begin(); it!=pool_.end();) {
+
+  // linear cuts: score all of them in one pass and pick the best.
+  if (pool_.getNumCuts() > 0) {
+    if (p->getObjective()) {
+      olf = p->getObjective()->getLinearFunction();
+    }
+    if (olf) {
+      obj.assign(p->getNumVars(), 0.0);
+      for (VariableGroupConstIterator it=olf->termsBegin();
+           it!=olf->termsEnd(); ++it) {
+        obj[it->first->getIndex()] = it->second;
+      }
+    }
+    pool_.evalScores(x, obj, act, eff, objpar);
+    for (UInt r=0; r<eff.size(); ++r) {
+      if (eff[r] > 0.0) {
+        viol = std::max(pool_.getLb(r)-act[r], act[r]-pool_.getUb(r));
+        if (viol <= violAbs_ + violRel_*fabs(act[r])) {
+          eff[r] = 0.0;
+        }
+      }
+    }
+    pool_.selectCuts(eff, objpar, 0.0, objWt_, maxCos_, maxSel_, rows);
+
+    // removing a cut may move rows of the pool, so get all cuts first.
+    for (UIntVector::iterator it=rows.begin(); it!=rows.end(); ++it) {
+      sel.push_back(pool_.getCut(*it));
+    }
+    for (CutVectorIter it=sel.begin(); it!=sel.end(); ++it) {
+#if SPEW
+      logger_->msgStream(LogInfo) << me_ << "Solution violates cut, "
+                                  << "adding cut to relaxation. Cut is: "
+                                  << std::endl;
+      (*it)->write(logger_->msgStream(LogInfo));
+#endif
+      (*it)->applyToProblem(p);
+      pool_.removeCut(*it);
+      ++enCuts_;
+      ++n;
+    }
+  }
+
+  for (CLIter it=nlPool_.begin(); it!=nlPool_.end();) {
     cut = *it;
 #if SPEW
     cut->write(logger_->msgStream(LogInfo));
 #endif
     err = 0;
-    act = cut->eval(x, &err);
+    lhs = cut->eval(x, &err);
     if (err!=0) {
       logger_->msgStream(LogInfo) << me_ << "Error evaluating activity of cut. "
                                   << "Not adding to relaxation. Cut is: "
@@ -142,16 +210,17 @@ void SimpleCutMan::separate(ProblemPtr p, ConstSolutionPtr sol, bool *, UInt *)
       ++it;
       continue;
     }
-    viol = std::max(cut->getLb()-act, act-cut->getUb());
-    if (viol > violAbs_ + violRel_*fabs(act)) {
+    viol = std::max(cut->getLb()-lhs, lhs-cut->getUb());
+    if (viol > violAbs_ + violRel_*fabs(lhs)) {
 #if SPEW
       logger_->msgStream(LogInfo) << me_ << "Solution violates cut, "
                                   << "adding cut to relaxation. Cut is: "
                                   << std::endl;
 #endif
       ++enCuts_;
+      ++n;
       cut->applyToProblem(p);
-      it = pool_.erase(it);
+      it = nlPool_.erase(it);
     } else {
 #if SPEW
       logger_->msgStream(LogInfo) << me_ << "Solution does not violate cut. "
@@ -160,6 +229,13 @@ void SimpleCutMan::separate(ProblemPtr p, ConstSolutionPtr sol, bool *, UInt *)
       ++it;
     }
   }
+
+  if (added) {
+    *added = n;
+  }
+  if (separated) {
+    *separated = (n > 0);
+  }
 }
 
 
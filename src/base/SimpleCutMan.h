@@ -15,6 +15,7 @@
 
 #include <list>
 #include "CutManager.h"
+#include "CutPool.h"
 #include "Types.h"
 
 
@@ -24,8 +25,10 @@ namespace Minotaur {
    * \brief Derived class for managing cuts. Adds all violated cuts from the
    * storage to the relaxation and never removes any. If a new cut is reported
    * but not violated by the current solution then it is added to storage.
-   * This manager does not check for duplicacy or any other numerical problems
-   * in cuts.
+   * Linear cuts in the storage are scored together (see CutPool), and the
+   * most efficacious ones that are not nearly parallel to each other are
+   * added. This manager does not check for duplicacy or any other numerical
+   * problems in cuts.
    */
   class SimpleCutMan : public CutManager {
 
@@ -89,6 +92,12 @@ namespace Minotaur {
     /// For logging.
     LoggerPtr logger_;
 
+    /// Maximum cosine between two cuts added in the same round.
+    double maxCos_;
+
+    /// Maximum number of cuts added in one round. 0 means no limit.
+    UInt maxSel_;
+
     /// For logging.
     const static std::string me_;
 
@@ -101,8 +110,15 @@ namespace Minotaur {
     /// The relaxation problem that cuts are added to and deleted from.
     ProblemPtr p_;
 
-    /// Pool of cuts that were left unviolated. They may be added in the future.
-    CutList pool_;
+    /// Non-linear cuts that were left unviolated.
+    CutList nlPool_;
+
+    /// Weight of the objective parallelism in the score of a cut.
+    double objWt_;
+
+    /// Linear cuts that were left unviolated. They may be added in the
+    /// future.
+    CutPool pool_;
 
     /// A cut will be added only if the violation exceeds violAbs_.
     double violAbs_;
@@ -111,7 +127,7 @@ namespace Minotaur {
     /// value of the the activity times the violRel_.
     double violRel_;
 
-    /// Append the newCuts_ to pool_ and clear newCuts_.
+    /// Move the newCuts_ to pool_ (or nlPool_) and clear newCuts_.
     void mvNewToPool_();
   };
 
@@ -0,0 +1,567 @@
+//
+//     MINOTAUR -- It's only 1/2 bull
+//
+//     (C)opyright 2008 - 2014 The MINOTAUR Team.
+//
+
+/**
+ * \file SymmetryGroup.cpp
+ * \brief Implement the methods of class SymmetryGroup.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#include "MinotaurConfig.h"
+#include "CGraph.h"
+#include "CNode.h"
+#include "Constraint.h"
+#include "Function.h"
+#include "LinearFunction.h"
+#include "Objective.h"
+#include "Problem.h"
+#include "QuadraticFunction.h"
+#include "SymmetryGroup.h"
+#include "Variable.h"
+
+using namespace Minotaur;
+
+const std::string SymmetryGroup::me_ = "SymmetryGroup: ";
+
+/// Orders vertices by their signatures.
+struct LessSig {
+  const std::vector<UIntVector> *sig;
+  bool operator()(UInt a, UInt b) const { return (*sig)[a] < (*sig)[b]; }
+};
+
+/// Orders vertices by their keys.
+struct LessKey {
+  const std::vector< std::vector<double> > *key;
+  bool operator()(UInt a, UInt b) const { return (*key)[a] < (*key)[b]; }
+};
+
+
+static UInt findRoot(UIntVector &uf, UInt i)
+{
+  UInt r = i;
+  while (uf[r] != r) {
+    r = uf[r];
+  }
+  while (uf[i] != r) {
+    UInt next = uf[i];
+    uf[i] = r;
+    i = next;
+  }
+  return r;
+}
+
+
+static void join(UIntVector &uf, UInt i, UInt j)
+{
+  i = findRoot(uf, i);
+  j = findRoot(uf, j);
+  if (i < j) {
+    uf[j] = i;
+  } else if (j < i) {
+    uf[i] = j;
+  }
+}
+
+
+SymmetryGroup::SymmetryGroup(ProblemPtr p)
+  : limit_(false),
+    maxWork_(0.0),
+    nVars_(p->getNumVars()),
+    work_(0.0)
+{
+  std::vector<double> key(4);
+  ConstraintPtr c;
+  ObjectivePtr obj = p->getObjective();
+  UIntVector fixed;
+  UInt u;
+
+  for (VariableConstIterator it=p->varsBegin(); it!=p->varsEnd(); ++it) {
+    key[0] = 0;
+    key[1] = (*it)->getType();
+    key[2] = (*it)->getLb();
+    key[3] = (*it)->getUb();
+    addVertex_(key);
+  }
+
+  key.resize(3);
+  if (obj) {
+    key[0] = 2;
+    key[1] = obj->getObjectiveType();
+    key[2] = 0;
+    u = addVertex_(key);
+    addFunction_(obj->getFunction(), u, fixed);
+  }
+  for (ConstraintConstIterator it=p->consBegin(); it!=p->consEnd(); ++it) {
+    c = *it;
+    if (DeletedCons==c->getState()) {
+      continue;
+    }
+    key[0] = 1;
+    key[1] = c->getLb();
+    key[2] = c->getUb();
+    u = addVertex_(key);
+    addFunction_(c->getFunction(), u, fixed);
+  }
+
+  // variables that can not be moved get colors of their own.
+  for (UIntVector::const_iterator it=fixed.begin(); it!=fixed.end(); ++it) {
+    keys_[*it].push_back(1.0+*it);
+  }
+  for (UInt v=0; v<adj_.size(); ++v) {
+    std::sort(adj_[v].begin(), adj_[v].end());
+  }
+}
+
+
+SymmetryGroup::~SymmetryGroup()
+{
+  adj_.clear();
+  ecolors_.clear();
+  gens_.clear();
+  keys_.clear();
+}
+
+
+void SymmetryGroup::addEdge_(UInt u, UInt w, int kind, double val)
+{
+  std::map<std::pair<int, double>, UInt>::iterator it;
+  UInt ec;
+
+  it = ecolors_.find(std::make_pair(kind, val));
+  if (it==ecolors_.end()) {
+    ec = ecolors_.size();
+    ecolors_[std::make_pair(kind, val)] = ec;
+  } else {
+    ec = it->second;
+  }
+  // the direction of an edge is part of its color.
+  adj_[u].push_back(Adj(w, 2*ec));
+  adj_[w].push_back(Adj(u, 2*ec+1));
+}
+
+
+void SymmetryGroup::addFunction_(FunctionPtr f, UInt u, UIntVector &fixed)
+{
+  LinearFunctionPtr lf;
+  QuadraticFunctionPtr qf;
+  NonlinearFunctionPtr nlf;
+  CGraphPtr cg;
+  VariableSet vars;
+  std::map<const CNode*, UInt> done;
+  std::vector<double> key(2);
+  UInt t;
+
+  if (!f) {
+    return;
+  }
+  lf = f->getLinearFunction();
+  if (lf) {
+    for (VariableGroupConstIterator it=lf->termsBegin(); it!=lf->termsEnd();
+         ++it) {
+      addEdge_(u, it->first->getIndex(), 0, it->second);
+    }
+  }
+  qf = f->getQuadraticFunction();
+  if (qf) {
+    for (VariablePairGroupConstIterator it=qf->begin(); it!=qf->end();
+         ++it) {
+      key[0] = 3;
+      key[1] = it->second;
+      t = addVertex_(key);
+      addEdge_(u, t, 1, 0.0);
+      if (it->first.first==it->first.second) {
+        addEdge_(t, it->first.first->getIndex(), 2, 0.0);
+      } else {
+        addEdge_(t, it->first.first->getIndex(), 1, 0.0);
+        addEdge_(t, it->first.second->getIndex(), 1, 0.0);
+      }
+    }
+  }
+  nlf = f->getNonlinearFunction();
+  if (nlf) {
+    cg = boost::dynamic_pointer_cast<CGraph>(nlf);
+    if (cg && cg->getOut()) {
+      addEdge_(u, addNode_(cg->getOut(), done), 1, 0.0);
+    } else {
+      nlf->getVars(&vars);
+      for (VariableSet::const_iterator it=vars.begin(); it!=vars.end();
+           ++it) {
+        fixed.push_back((*it)->getIndex());
+      }
+    }
+  }
+}
+
+
+UInt SymmetryGroup::addNode_(const CNode *cnode,
+                             std::map<const CNode*, UInt> &done)
+{
+  std::map<const CNode*, UInt>::const_iterator it;
+  std::vector<double> key(3);
+  OpCode op = cnode->getOp();
+  bool comm = (OpPlus==op || OpMult==op);
+  UInt u;
+
+  if (OpVar==op) {
+    return cnode->getV()->getIndex();
+  }
+  it = done.find(cnode);
+  if (it!=done.end()) {
+    return it->second;
+  }
+  key[0] = 4;
+  key[1] = op;
+  key[2] = (OpNum==op || OpInt==op) ? cnode->getVal() : 0.0;
+  u = addVertex_(key);
+  done[cnode] = u;
+  if (OpSumList==op) {
+    for (CNode **c=cnode->getListL(); c<cnode->getListR(); ++c) {
+      addEdge_(u, addNode_(*c, done), 1, 0.0);
+    }
+  } else {
+    if (cnode->getL()) {
+      addEdge_(u, addNode_(cnode->getL(), done), 1, comm ? 0.0 : 1.0);
+    }
+    if (cnode->getR()) {
+      addEdge_(u, addNode_(cnode->getR(), done), 1, comm ? 0.0 : 2.0);
+    }
+  }
+  return u;
+}
+
+
+UInt SymmetryGroup::addVertex_(const std::vector<double> &key)
+{
+  keys_.push_back(key);
+  adj_.push_back(std::vector<Adj>());
+  return keys_.size()-1;
+}
+
+
+bool SymmetryGroup::compatible_(const UIntVector &c1, const UIntVector &c2,
+                                UInt ncolors) const
+{
+  UIntVector n1(ncolors, 0), n2(ncolors, 0);
+
+  for (UInt v=0; v<c1.size(); ++v) {
+    if (c1[v] >= ncolors || c2[v] >= ncolors) {
+      return false;
+    }
+    ++n1[c1[v]];
+    ++n2[c2[v]];
+  }
+  return (n1==n2);
+}
+
+
+UInt SymmetryGroup::findGenerators(double max_work)
+{
+  UInt nv = adj_.size();
+  UIntVector col(nv), order(nv), uf(nv), b, perm(nv);
+  std::vector<UIntVector> path, full;
+  UIntVector base, ncolors;
+  LessKey less;
+  UInt n, v, root;
+
+  maxWork_ = max_work;
+  work_ = 0.0;
+  limit_ = false;
+  gens_.clear();
+  if (0==nVars_) {
+    return 0;
+  }
+
+  // initial colors are ranks of the keys.
+  for (v=0; v<nv; ++v) {
+    order[v] = v;
+  }
+  less.key = &keys_;
+  std::sort(order.begin(), order.end(), less);
+  n = 0;
+  for (UInt i=0; i<nv; ++i) {
+    if (i>0 && keys_[order[i]]!=keys_[order[i-1]]) {
+      ++n;
+    }
+    col[order[i]] = n;
+  }
+  n = refine_(col);
+  path.push_back(col);
+  ncolors.push_back(n);
+
+  // the leftmost path, down to a discrete partition.
+  while (n < nv) {
+    if (work_ > maxWork_) {
+      limit_ = true;
+      return 0;
+    }
+    v = firstInCell_(col, n);
+    base.push_back(v);
+    individualize_(col, v);
+    n = refine_(col);
+    path.push_back(col);
+    ncolors.push_back(n);
+  }
+
+  // generators found at deeper levels fix the base above them.
+  for (UInt k=base.size(); k>0 && false==limit_; --k) {
+    for (v=0; v<nv; ++v) {
+      uf[v] = v;
+    }
+    for (std::vector<UIntVector>::const_iterator it=full.begin();
+         it!=full.end(); ++it) {
+      for (v=0; v<nv; ++v) {
+        join(uf, v, (*it)[v]);
+      }
+    }
+    const UIntVector &pk = path[k-1];
+    for (UInt w=0; w<nv && false==limit_; ++w) {
+      if (pk[w]!=pk[base[k-1]] || w==base[k-1] ||
+          findRoot(uf, w)==findRoot(uf, base[k-1])) {
+        continue;
+      }
+      b = pk;
+      individualize_(b, w);
+      n = refine_(b);
+      if (n==ncolors[k] && compatible_(b, path[k], n) &&
+          match_(path, base, ncolors, k, b, perm)) {
+        full.push_back(perm);
+        for (v=0; v<nv; ++v) {
+          join(uf, v, perm[v]);
+        }
+      }
+    }
+  }
+
+  for (std::vector<UIntVector>::const_iterator it=full.begin();
+       it!=full.end(); ++it) {
+    root = 0;
+    for (v=0; v<nVars_; ++v) {
+      if ((*it)[v]!=v) {
+        ++root;
+        break;
+      }
+    }
+    if (root > 0) {
+      gens_.push_back(UIntVector(it->begin(), it->begin()+nVars_));
+    }
+  }
+  return gens_.size();
+}
+
+
+UInt SymmetryGroup::firstInCell_(const UIntVector &col, UInt ncolors) const
+{
+  UIntVector size(ncolors, 0);
+  UInt c = ncolors;
+
+  for (UInt v=0; v<col.size(); ++v) {
+    ++size[col[v]];
+  }
+  for (UInt i=0; i<ncolors; ++i) {
+    if (size[i] > 1) {
+      c = i;
+      break;
+    }
+  }
+  for (UInt v=0; v<col.size(); ++v) {
+    if (col[v]==c) {
+      return v;
+    }
+  }
+  return 0;
+}
+
+
+void SymmetryGroup::getOrbits(const BoolVector &use, UIntVector &orbit) const
+{
+  orbit.resize(nVars_);
+  for (UInt j=0; j<nVars_; ++j) {
+    orbit[j] = j;
+  }
+  for (UInt i=0; i<gens_.size(); ++i) {
+    if (false==use.empty() && false==use[i]) {
+      continue;
+    }
+    for (UInt j=0; j<nVars_; ++j) {
+      join(orbit, j, gens_[i][j]);
+    }
+  }
+  for (UInt j=0; j<nVars_; ++j) {
+    orbit[j] = findRoot(orbit, j);
+  }
+}
+
+
+UInt SymmetryGroup::individualize_(UIntVector &col, UInt v) const
+{
+  UIntVector vals(col.size());
+
+  for (UInt x=0; x<col.size(); ++x) {
+    col[x] = 2*col[x] + (x==v ? 0 : 1);
+    vals[x] = col[x];
+  }
+  std::sort(vals.begin(), vals.end());
+  vals.erase(std::unique(vals.begin(), vals.end()), vals.end());
+  for (UInt x=0; x<col.size(); ++x) {
+    col[x] = std::lower_bound(vals.begin(), vals.end(), col[x])
+      - vals.begin();
+  }
+  return vals.size();
+}
+
+
+bool SymmetryGroup::match_(const std::vector<UIntVector> &path,
+                           const UIntVector &base, const UIntVector &ncolors,
+                           UInt j, const UIntVector &b, UIntVector &perm)
+{
+  UIntVector inv, b2;
+  UInt c, n;
+
+  if (j==base.size()) {
+    // both partitions are discrete.
+    inv.resize(b.size());
+    for (UInt x=0; x<b.size(); ++x) {
+      inv[b[x]] = x;
+    }
+    for (UInt x=0; x<b.size(); ++x) {
+      perm[x] = inv[path[j][x]];
+    }
+    return verify_(perm);
+  }
+
+  c = path[j][base[j]];
+  for (UInt w=0; w<b.size(); ++w) {
+    if (b[w]!=c) {
+      continue;
+    }
+    if (work_ > maxWork_) {
+      limit_ = true;
+      return false;
+    }
+    b2 = b;
+    individualize_(b2, w);
+    n = refine_(b2);
+    if (n==ncolors[j+1] && compatible_(b2, path[j+1], n) &&
+        match_(path, base, ncolors, j+1, b2, perm)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+
+UInt SymmetryGroup::refine_(UIntVector &col)
+{
+  UInt nv = adj_.size();
+  std::vector<UIntVector> sig(nv);
+  std::vector<Adj> nbrs;
+  UIntVector order(nv);
+  LessSig less;
+  UInt ncolors, k;
+
+  ncolors = 0;
+  for (UInt v=0; v<nv; ++v) {
+    ncolors = std::max(ncolors, col[v]+1);
+  }
+  less.sig = &sig;
+  while (true) {
+    // signature: own color, then colors of edges and neighbors.
+    for (UInt v=0; v<nv; ++v) {
+      nbrs.clear();
+      for (std::vector<Adj>::const_iterator it=adj_[v].begin();
+           it!=adj_[v].end(); ++it) {
+        nbrs.push_back(Adj(it->second, col[it->first]));
+      }
+      std::sort(nbrs.begin(), nbrs.end());
+      sig[v].clear();
+      sig[v].push_back(col[v]);
+      for (std::vector<Adj>::const_iterator it=nbrs.begin();
+           it!=nbrs.end(); ++it) {
+        sig[v].push_back(it->first);
+        sig[v].push_back(it->second);
+      }
+      work_ += adj_[v].size()+1;
+      order[v] = v;
+    }
+    std::sort(order.begin(), order.end(), less);
+    k = 0;
+    for (UInt i=0; i<nv; ++i) {
+      if (i>0 && sig[order[i]]!=sig[order[i-1]]) {
+        ++k;
+      }
+      col[order[i]] = k;
+    }
+    if (k+1==ncolors) {
+      break;
+    }
+    ncolors = k+1;
+  }
+  return ncolors;
+}
+
+
+bool SymmetryGroup::verify_(const UIntVector &perm) const
+{
+  std::vector<Adj> nbrs;
+
+  for (UInt x=0; x<perm.size(); ++x) {
+    if (keys_[x]!=keys_[perm[x]] ||
+        adj_[x].size()!=adj_[perm[x]].size()) {
+      return false;
+    }
+  }
+  for (UInt x=0; x<perm.size(); ++x) {
+    nbrs.clear();
+    for (std::vector<Adj>::const_iterator it=adj_[x].begin();
+         it!=adj_[x].end(); ++it) {
+      nbrs.push_back(Adj(perm[it->first], it->second));
+    }
+    std::sort(nbrs.begin(), nbrs.end());
+    if (nbrs!=adj_[perm[x]]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+
+void SymmetryGroup::write(std::ostream &out, ProblemPtr p) const
+{
+  BoolVector seen;
+
+  for (UInt i=0; i<gens_.size(); ++i) {
+    out << me_ << "generator " << i << ":";
+    seen.assign(nVars_, false);
+    for (UInt j=0; j<nVars_; ++j) {
+      if (seen[j] || gens_[i][j]==j) {
+        continue;
+      }
+      out << " (";
+      for (UInt k=j; false==seen[k]; k=gens_[i][k]) {
+        seen[k] = true;
+        out << (k==j ? "" : " ") << p->getVariable(k)->getName();
+      }
+      out << ")";
+    }
+    out << std::endl;
+  }
+}
+
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
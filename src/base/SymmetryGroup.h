@@ -0,0 +1,186 @@
+//
+//     MINOTAUR -- It's only 1/2 bull
+//
+//     (C)opyright 2008 - 2014 The MINOTAUR Team.
+//
+
+/**
+ * \file SymmetryGroup.h
+ * \brief Declare class SymmetryGroup for finding symmetries of the
+ * formulation of a problem.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#ifndef MINOTAURSYMMETRYGROUP_H
+#define MINOTAURSYMMETRYGROUP_H
+
+#include "Types.h"
+
+namespace Minotaur {
+
+  class CNode;
+  class Function;
+  typedef boost::shared_ptr<Function> FunctionPtr;
+
+  /**
+   * \brief Permutations of variables that map the formulation of a problem
+   * to itself.
+   *
+   * A colored graph is built from the problem. It has a vertex for every
+   * variable, constraint, the objective, every quadratic term and every
+   * node of the computational graphs (CGraph) of nonlinear functions.
+   * Vertices are colored by their kind and data: type and bounds of
+   * variables, bounds of constraints, coefficients of quadratic terms,
+   * operators and constants of graph nodes. Edges are colored by
+   * coefficients of linear terms and, for operators whose arguments can not
+   * be exchanged, by the position of the argument. Variables of nonlinear
+   * functions of other kinds get colors of their own, so that they are not
+   * moved.
+   *
+   * Automorphisms of this graph are found by partition refinement and a
+   * search that individualizes one vertex at a time. The leftmost path of
+   * the search tree is followed to a discrete partition, and at every level,
+   * from the bottom up, the first vertex of the individualized cell is
+   * mapped to the other vertices of the cell that are not yet in its orbit.
+   * Every permutation found is checked on all edges. The generators found
+   * thus generate a subgroup of the automorphism group, which is all of it
+   * unless the search stops at the work limit.
+   */
+  class SymmetryGroup {
+  public:
+    /// Constructor. The graph of p is built.
+    SymmetryGroup(ProblemPtr p);
+
+    /// Destroy.
+    ~SymmetryGroup();
+
+    /**
+     * \brief Find generators of the group.
+     *
+     * \param[in] max_work Limit on the work, in number of edges visited
+     * while refining partitions.
+     * \return The number of generators found.
+     */
+    UInt findGenerators(double max_work);
+
+    /**
+     * \brief Return generator i as a permutation of the indices of
+     * variables: variable j is mapped to variable gen[j].
+     */
+    const UIntVector & getGenerator(UInt i) const { return gens_[i]; }
+
+    /// Return the number of generators.
+    UInt getNumGenerators() const { return gens_.size(); }
+
+    /// Return the number of variables of the problem.
+    UInt getNumVars() const { return nVars_; }
+
+    /**
+     * \brief Find the orbits of variables under the group generated by some
+     * generators.
+     *
+     * \param[in] use If not empty, only generators i with use[i] true are
+     * used.
+     * \param[out] orbit The smallest index of a variable in the orbit of
+     * each variable.
+     */
+    void getOrbits(const BoolVector &use, UIntVector &orbit) const;
+
+    /// Return true if the work limit was reached in findGenerators().
+    bool hitLimit() const { return limit_; }
+
+    /// Write the generators as cycles, using names of variables of p.
+    void write(std::ostream &out, ProblemPtr p) const;
+
+  private:
+    /// A neighbor of a vertex and the color of the edge.
+    typedef std::pair<UInt, UInt> Adj;
+
+    /// Neighbors of every vertex, sorted.
+    std::vector< std::vector<Adj> > adj_;
+
+    /// Colors of edges, by kind and value.
+    std::map<std::pair<int, double>, UInt> ecolors_;
+
+    /// Generators, as permutations of variables.
+    std::vector<UIntVector> gens_;
+
+    /// Keys from which the colors of vertices are found.
+    std::vector< std::vector<double> > keys_;
+
+    /// True if the work limit was reached.
+    bool limit_;
+
+    /// Work limit.
+    double maxWork_;
+
+    /// For logging.
+    static const std::string me_;
+
+    /// Number of variables. Vertex j is variable j.
+    UInt nVars_;
+
+    /// Work done.
+    double work_;
+
+    /// Add an edge from vertex u to vertex w with the given kind and value.
+    void addEdge_(UInt u, UInt w, int kind, double val);
+
+    /// Add vertices and edges of function f, with output vertex u.
+    void addFunction_(FunctionPtr f, UInt u, UIntVector &fixed);
+
+    /// Add vertices of the graph below cnode. Return its vertex.
+    UInt addNode_(const CNode *cnode, std::map<const CNode*, UInt> &done);
+
+    /// Add a vertex. Return its index.
+    UInt addVertex_(const std::vector<double> &key);
+
+    /// Return true if two partitions have the same size of every cell.
+    bool compatible_(const UIntVector &c1, const UIntVector &c2,
+                     UInt ncolors) const;
+
+    /// Return the first vertex in the first cell that has more than one.
+    UInt firstInCell_(const UIntVector &col, UInt ncolors) const;
+
+    /// Give vertex v a color of its own, before the rest of its cell.
+    UInt individualize_(UIntVector &col, UInt v) const;
+
+    /**
+     * \brief Map the partition b to the partition at level j of the
+     * leftmost path.
+     *
+     * \return True if a permutation was found and saved in perm.
+     */
+    bool match_(const std::vector<UIntVector> &path, const UIntVector &base,
+                const UIntVector &ncolors, UInt j, const UIntVector &b,
+                UIntVector &perm);
+
+    /**
+     * \brief Refine a partition until it is equitable.
+     *
+     * New colors depend only on the colors and the graph, not on the
+     * numbering of vertices, so that partitions refined from two
+     * individualized vertices can be compared.
+     *
+     * \return The number of colors.
+     */
+    UInt refine_(UIntVector &col);
+
+    /// Return true if perm maps every edge to an edge of the same color.
+    bool verify_(const UIntVector &perm) const;
+  };
+
+  typedef boost::shared_ptr<SymmetryGroup> SymmetryGroupPtr;
+}
+#endif
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
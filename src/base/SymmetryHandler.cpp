@@ -0,0 +1,304 @@
+//
+//     MINOTAUR -- It's only 1/2 bull
+//
+//     (C)opyright 2008 - 2014 The MINOTAUR Team.
+//
+
+/**
+ * \file SymmetryHandler.cpp
+ * \brief Implement the methods of class SymmetryHandler.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#include <cmath>
+#include <iostream>
+#include <set>
+
+#include "MinotaurConfig.h"
+#include "Branch.h"
+#include "Environment.h"
+#include "Function.h"
+#include "LinearFunction.h"
+#include "Logger.h"
+#include "Node.h"
+#include "Option.h"
+#include "Relaxation.h"
+#include "SymmetryHandler.h"
+#include "Timer.h"
+#include "VarBoundMod.h"
+#include "Variable.h"
+
+using namespace Minotaur;
+
+const std::string SymmetryHandler::me_ = "SymmetryHandler: ";
+
+
+SymmetryHandler::SymmetryHandler(EnvPtr env, ProblemPtr problem)
+  : consInProb_(false),
+    env_(env),
+    eps_(1e-6),
+    maxWork_(1e7),
+    p_(problem)
+{
+  logger_ = (LoggerPtr) new Logger((LogLevel)(env->getOptions()->
+      findInt("handler_log_level")->getValue()));
+  mode_ = env->getOptions()->findInt("symmetry")->getValue();
+  modProb_ = false;
+  modRel_ = true;
+  stats_.gens = 0;
+  stats_.orbits = 0;
+  stats_.cons = 0;
+  stats_.fixed = 0;
+  stats_.inf = 0;
+  stats_.time = 0.0;
+}
+
+
+SymmetryHandler::~SymmetryHandler()
+{
+  env_.reset();
+  group_.reset();
+  p_.reset();
+}
+
+
+void SymmetryHandler::addCons_(ProblemPtr p)
+{
+  std::set<std::pair<UInt, UInt> > seen;
+  LinearFunctionPtr lf;
+  UInt i, n;
+
+  for (UInt g=0; g<group_->getNumGenerators(); ++g) {
+    const UIntVector &gen = group_->getGenerator(g);
+    n = gen.size();
+    for (i=0; i<n && gen[i]==i; ++i) {
+    }
+    if (i==n || false==seen.insert(std::make_pair(i, gen[i])).second) {
+      continue;
+    }
+    // x_i - x_g(i) >= 0.
+    lf = (LinearFunctionPtr) new LinearFunction();
+    lf->addTerm(p->getVariable(i), 1.0);
+    lf->addTerm(p->getVariable(gen[i]), -1.0);
+    p->newConstraint((FunctionPtr) new Function(lf), 0.0, INFINITY);
+    ++stats_.cons;
+  }
+}
+
+
+void SymmetryHandler::findGroup_()
+{
+  UIntVector orbit;
+  UIntVector size;
+
+  if (group_ && group_->getNumVars()==p_->getNumVars()) {
+    return;
+  }
+  group_ = (SymmetryGroupPtr) new SymmetryGroup(p_);
+  stats_.gens = group_->findGenerators(maxWork_);
+  group_->getOrbits(BoolVector(), orbit);
+  size.assign(orbit.size(), 0);
+  stats_.orbits = 0;
+  for (UInt j=0; j<orbit.size(); ++j) {
+    if (2==++size[orbit[j]]) {
+      ++stats_.orbits;
+    }
+  }
+  logger_->msgStream(LogInfo) << me_ << "generators found = "
+                              << stats_.gens << std::endl
+                              << me_ << "orbits found = "
+                              << stats_.orbits << std::endl;
+  if (group_->hitLimit()) {
+    logger_->msgStream(LogInfo) << me_ << "work limit reached" << std::endl;
+  }
+#if SPEW
+  group_->write(logger_->msgStream(LogDebug2), p_);
+#endif
+}
+
+
+std::string SymmetryHandler::getName() const
+{
+  return "SymmetryHandler (Symmetries of the formulation)";
+}
+
+
+bool SymmetryHandler::isBin_(ConstVariablePtr v) const
+{
+  return ((v->getType()==Binary || v->getType()==Integer) &&
+          v->getLb() > -eps_ && v->getUb() < 1.0+eps_);
+}
+
+
+SolveStatus SymmetryHandler::presolve(PreModQ *, bool *changed)
+{
+  Timer *timer = env_->getNewTimer();
+
+  timer->start();
+  *changed = false;
+  findGroup_();
+  if (1==mode_ && false==consInProb_) {
+    addCons_(p_);
+    consInProb_ = true;
+    *changed = (stats_.cons > 0);
+  }
+  stats_.time += timer->query();
+  delete timer;
+  return Finished;
+}
+
+
+bool SymmetryHandler::presolveNode(RelaxationPtr rel, NodePtr node,
+                                   SolutionPoolPtr, ModVector &,
+                                   ModVector &r_mods)
+{
+  UInt n;
+  BranchPtr br;
+  VarBoundModPtr bmod;
+  VarBoundMod2Ptr bmod2;
+  VariablePtr v;
+  double lb, ub;
+  BoolVector b1, b0, other, use;
+  UIntVector orbit;
+  BoolVector fix;
+  ModificationPtr mod;
+  bool is_inf = false;
+  Timer *timer;
+
+  if (2!=mode_ || !group_ || 0==group_->getNumGenerators() ||
+      rel->getNumVars() < group_->getNumVars()) {
+    return false;
+  }
+  timer = env_->getNewTimer();
+  timer->start();
+
+  // decisions on the path from the root.
+  n = group_->getNumVars();
+  b1.assign(n, false);
+  b0.assign(n, false);
+  other.assign(n, false);
+  for (NodePtr nd=node; nd->getParent(); nd=nd->getParent()) {
+    br = nd->getBranch();
+    if (!br) {
+      continue;
+    }
+    for (ModificationConstIterator it=br->rModsBegin(); it!=br->rModsEnd();
+         ++it) {
+      bmod = boost::dynamic_pointer_cast<VarBoundMod>(*it);
+      bmod2 = boost::dynamic_pointer_cast<VarBoundMod2>(*it);
+      lb = -INFINITY;
+      ub = INFINITY;
+      if (bmod) {
+        v = bmod->getVar();
+        if (Lower==bmod->getLU()) {
+          lb = bmod->getNewVal();
+        } else {
+          ub = bmod->getNewVal();
+        }
+      } else if (bmod2) {
+        v = bmod2->getVar();
+        lb = bmod2->getNewLb();
+        ub = bmod2->getNewUb();
+      } else {
+        stats_.time += timer->query();
+        delete timer;
+        return false;
+      }
+      if (v->getIndex() >= n) {
+        continue;
+      }
+      if (isBin_(p_->getVariable(v->getIndex())) && lb > 1.0-eps_) {
+        b1[v->getIndex()] = true;
+      } else if (isBin_(p_->getVariable(v->getIndex())) && ub < eps_) {
+        b0[v->getIndex()] = true;
+      } else {
+        other[v->getIndex()] = true;
+      }
+    }
+  }
+
+  // generators that map B1 to itself and fix other decisions.
+  use.assign(group_->getNumGenerators(), true);
+  for (UInt g=0; g<group_->getNumGenerators(); ++g) {
+    const UIntVector &gen = group_->getGenerator(g);
+    for (UInt j=0; j<n; ++j) {
+      if ((b1[j] && false==b1[gen[j]]) || (other[j] && gen[j]!=j)) {
+        use[g] = false;
+        break;
+      }
+    }
+  }
+  group_->getOrbits(use, orbit);
+
+  fix.assign(n, false);
+  for (UInt j=0; j<n; ++j) {
+    if (b0[j]) {
+      fix[orbit[j]] = true;
+    }
+  }
+  for (UInt j=0; j<n && false==is_inf; ++j) {
+    v = rel->getVariable(j);
+    if (b0[j] || false==fix[orbit[j]] || false==isBin_(p_->getVariable(j))
+        || v->getUb() < eps_) {
+      continue;
+    }
+    if (v->getLb() > eps_) {
+      is_inf = true;
+      ++stats_.inf;
+    } else {
+      mod = (VarBoundModPtr) new VarBoundMod(v, Upper, 0.0);
+      mod->applyToProblem(rel);
+      r_mods.push_back(mod);
+      ++stats_.fixed;
+    }
+  }
+  stats_.time += timer->query();
+  delete timer;
+  return is_inf;
+}
+
+
+void SymmetryHandler::relaxInitFull(RelaxationPtr rel, bool *is_inf)
+{
+  Timer *timer = env_->getNewTimer();
+
+  timer->start();
+  findGroup_();
+  if (1==mode_ && false==consInProb_) {
+    addCons_(rel);
+  }
+  *is_inf = false;
+  stats_.time += timer->query();
+  delete timer;
+}
+
+
+void SymmetryHandler::relaxInitInc(RelaxationPtr rel, bool *is_inf)
+{
+  relaxInitFull(rel, is_inf);
+}
+
+
+void SymmetryHandler::writeStats(std::ostream &out) const
+{
+  out << me_ << "generators                  = " << stats_.gens << std::endl
+      << me_ << "orbits                      = " << stats_.orbits
+      << std::endl
+      << me_ << "symmetry-breaking cons      = " << stats_.cons << std::endl
+      << me_ << "variables fixed in nodes    = " << stats_.fixed << std::endl
+      << me_ << "nodes found infeasible      = " << stats_.inf << std::endl
+      << me_ << "time used                   = " << stats_.time
+      << std::endl;
+}
+
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
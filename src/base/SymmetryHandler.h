@@ -0,0 +1,180 @@
+//
+//     MINOTAUR -- It's only 1/2 bull
+//
+//     (C)opyright 2008 - 2014 The MINOTAUR Team.
+//
+
+/**
+ * \file SymmetryHandler.h
+ * \brief Declare the SymmetryHandler class that finds symmetries of the
+ * formulation and uses them to prune equivalent parts of the tree.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#ifndef MINOTAURSYMMETRYHANDLER_H
+#define MINOTAURSYMMETRYHANDLER_H
+
+#include "Handler.h"
+#include "SymmetryGroup.h"
+
+namespace Minotaur {
+
+  class Logger;
+  typedef boost::shared_ptr<Logger> LoggerPtr;
+
+  /// Statistics of the symmetry handler.
+  struct SymmetryStats {
+    UInt gens;     ///< Number of generators found.
+    UInt orbits;   ///< Number of orbits with more than one variable.
+    UInt cons;     ///< Number of symmetry-breaking constraints added.
+    UInt fixed;    ///< Number of variables fixed by orbital fixing.
+    UInt inf;      ///< Number of nodes found infeasible.
+    double time;   ///< Time spent in finding and using symmetries.
+  };
+
+  /**
+   * \brief Handler that exploits symmetries of the formulation.
+   *
+   * Generators of the group of permutations of variables that map the
+   * problem to itself are found by SymmetryGroup, once, from the presolved
+   * problem. The option "symmetry" decides how they are used:
+   *
+   * 1: for every generator g, with i the smallest index of a variable moved
+   * by g, the constraint x_i >= x_g(i) is added. These constraints are
+   * implied by the lexicographic-leader constraints of the group and keep
+   * at least one optimal solution.
+   *
+   * 2: orbital fixing in nodes. Let B1 (B0) be the binary variables that
+   * were fixed to one (zero) by branching on the path to the node. All
+   * variables in the orbit of a variable of B0, under the generators that
+   * map B1 to itself and fix all other branching variables, are fixed to
+   * zero.
+   *
+   * The two ways can not be used together, because constraints of the
+   * first kind are not mapped to themselves by the group.
+   */
+  class SymmetryHandler : public Handler {
+  public:
+    /// Constructor.
+    SymmetryHandler(EnvPtr env, ProblemPtr problem);
+
+    /// Destroy.
+    ~SymmetryHandler();
+
+    /// Does nothing.
+    Branches getBranches(BrCandPtr, DoubleVector &, RelaxationPtr,
+                         SolutionPoolPtr)
+    {return Branches();};
+
+    /// Does nothing.
+    void getBranchingCandidates(RelaxationPtr, const DoubleVector &,
+                                ModVector &, BrVarCandSet &, BrCandVector &,
+                                bool &) {};
+
+    /// Does nothing.
+    ModificationPtr getBrMod(BrCandPtr, DoubleVector &, RelaxationPtr,
+                             BranchDirection)
+    {return ModificationPtr();};
+
+    /// Return the group. NULL until it is found.
+    SymmetryGroupPtr getGroup() const { return group_; }
+
+    // base class method.
+    std::string getName() const;
+
+    /// Symmetries do not make a solution infeasible. Always returns true.
+    bool isFeasible(ConstSolutionPtr, RelaxationPtr, bool &, double &)
+    {return true;};
+
+    /// Find the group and add symmetry-breaking constraints to the problem.
+    SolveStatus presolve(PreModQ *pre_mods, bool *changed);
+
+    /// Orbital fixing, if it is used.
+    bool presolveNode(RelaxationPtr rel, NodePtr node,
+                      SolutionPoolPtr s_pool, ModVector &p_mods,
+                      ModVector &r_mods);
+
+    /**
+     * \brief Find the group if presolve() was not called, and add
+     * symmetry-breaking constraints to the relaxation if they are not in the
+     * problem.
+     */
+    void relaxInitFull(RelaxationPtr rel, bool *is_inf);
+
+    /// Same as relaxInitFull().
+    void relaxInitInc(RelaxationPtr rel, bool *is_inf);
+
+    /// Does nothing.
+    void relaxNodeFull(NodePtr, RelaxationPtr, bool *) {};
+
+    /// Does nothing.
+    void relaxNodeInc(NodePtr, RelaxationPtr, bool *) {};
+
+    /// Does nothing.
+    void separate(ConstSolutionPtr, NodePtr, RelaxationPtr, CutManager *,
+                  SolutionPoolPtr, bool *, SeparationStatus *) {};
+
+    // base class method.
+    void writeStats(std::ostream &out) const;
+
+  private:
+    /// True if symmetry-breaking constraints are in the problem.
+    bool consInProb_;
+
+    /// Environment.
+    EnvPtr env_;
+
+    /// Tolerance.
+    double eps_;
+
+    /// The group. Found from p_.
+    SymmetryGroupPtr group_;
+
+    /// Log.
+    LoggerPtr logger_;
+
+    /// Limit on the work done in finding the group.
+    double maxWork_;
+
+    /// For logging.
+    static const std::string me_;
+
+    /// 0: not used, 1: symmetry-breaking constraints, 2: orbital fixing.
+    int mode_;
+
+    /// The problem.
+    ProblemPtr p_;
+
+    /// Statistics.
+    SymmetryStats stats_;
+
+    /**
+     * \brief Add symmetry-breaking constraints to p.
+     *
+     * \param[in] p The problem or the relaxation. Variables of p have the
+     * same indices as those of p_.
+     */
+    void addCons_(ProblemPtr p);
+
+    /// Find the group of p_ if it is not found or variables changed.
+    void findGroup_();
+
+    /// Return true if variable v of p_ is binary.
+    bool isBin_(ConstVariablePtr v) const;
+  };
+
+  typedef boost::shared_ptr<SymmetryHandler> SymmetryHandlerPtr;
+  typedef boost::shared_ptr<const SymmetryHandler> ConstSymmetryHandlerPtr;
+}
+#endif
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
@@ -13,6 +13,7 @@
 #include <cmath>
 
 #include "MinotaurConfig.h"
+#include "BabReopt.h"
 #include "Branch.h"
 #include "Environment.h"
 #include "Node.h"
@@ -20,6 +21,7 @@
 #include "NodeStack.h"
 #include "Operations.h"
 #include "Option.h"
+#include "Profiler.h"
 #include "Timer.h"
 #include "TreeManager.h"
 
@@ -98,6 +100,7 @@ bool TreeManager::anyActiveNodesLeft()
 
 NodePtr TreeManager::branch(Branches branches, NodePtr node, WarmStartPtr ws)
 {
+  ProfZone zone(ProfBranch);
   BranchPtr branch_p;
   NodePtr new_cand = NodePtr(); // NULL
   NodePtr child;
@@ -163,6 +166,7 @@ UInt TreeManager::getActiveNodes() const
 
 NodePtr TreeManager::getCandidate()
 {
+  ProfZone zone(ProfNodeSel);
   NodePtr node = NodePtr(); // NULL
   aNode_.reset();
   while (active_nodes_->getSize() > 0) {
@@ -192,6 +196,15 @@ double TreeManager::getCutOff()
 }
 
 
+void TreeManager::getOpenNodes(NodePtrVector *nodes)
+{
+  if (aNode_) {
+    nodes->push_back(aNode_);
+  }
+  active_nodes_->getNodes(nodes);
+}
+
+
 double TreeManager::getPerGap()
 {
   // for minimization problems, gap = (ub - lb)/(ub) * 100
@@ -272,9 +285,26 @@ void TreeManager::insertRoot(NodePtr node)
 }
 
 
+void TreeManager::insertSaved(NodePtr node)
+{
+  assert(size_>0);
+  node->setId(size_);
+  ++size_;
+  active_nodes_->push(node);
+  if (doVbc_) {
+    vbcFile_ << toClockTime(timer_->query()) << " N "
+      << node->getParent()->getId()+1 << " " << node->getId()+1
+      << " " << VbcActive << std::endl;
+  }
+}
+
+
 void TreeManager::pruneNode(NodePtr node)
 {
   // XXX: if required do something before deleting the node.
+  if (reopt_) {
+    reopt_->addLeaf(node);
+  }
   removeNode_(node);
 }
 
@@ -355,6 +385,12 @@ void TreeManager::setCutOff(double value)
 }
 
 
+void TreeManager::setReopt(BabReoptPtr reopt)
+{
+  reopt_ = reopt;
+}
+
+
 void TreeManager::setUb(double value)
 {
   bestUpperBound_ = value;
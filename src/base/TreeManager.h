@@ -21,8 +21,10 @@
 namespace Minotaur {
   
   class ActiveNodeStore;
+  class BabReopt;
   class WarmStart;
   typedef boost::shared_ptr<ActiveNodeStore> ActiveNodeStorePtr;
+  typedef boost::shared_ptr<BabReopt> BabReoptPtr;
   typedef boost::shared_ptr<WarmStart> WarmStartPtr;
 
   // 1=like_red, 2=blue, 4=red, 5=yellow, 6=black, 7=pink, 8=cyan, 9=green
@@ -91,6 +93,12 @@ namespace Minotaur {
      */
     double getLb();
 
+    /**
+     * \brief Append all nodes that are created but not processed to nodes,
+     * including the node being dived into, if any.
+     */
+    void getOpenNodes(NodePtrVector *nodes);
+
     /// Return the best known upper bound.
     double getUb();
 
@@ -117,6 +125,14 @@ namespace Minotaur {
      */
     void insertRoot(NodePtr node);
 
+    /**
+     * \brief Insert a node that was saved in a checkpoint. Its parent must
+     * be the root. Its depth and lower bound are not changed.
+     *
+     * \param[in] node The node to be inserted.
+     */
+    void insertSaved(NodePtr node);
+
     /**
      * \brief Prune a given node from the tree
      *
@@ -140,6 +156,12 @@ namespace Minotaur {
      */
     void setCutOff(double value);
 
+    /**
+     * \brief Set the object that keeps the leaves of the tree for solving a
+     * modified problem later. Each pruned node is passed to it.
+     */
+    void setReopt(BabReoptPtr reopt);
+
     /** 
      * \brief Set the best known objective function value.
      *
@@ -205,6 +227,9 @@ namespace Minotaur {
     /// File name to store tree information for vbc.
     std::ofstream vbcFile_;
 
+    /// Object that keeps pruned nodes for reoptimization. May be NULL.
+    BabReoptPtr reopt_;
+
     /// Check if the node can be pruned because of its bound.
     bool shouldPrune_(NodePtr node);
 
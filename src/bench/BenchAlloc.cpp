@@ -0,0 +1,94 @@
+//
+//    MINOTAUR -- It's only 1/2 bull
+//
+//    (C)opyright 2009 - 2014 The MINOTAUR Team.
+//
+
+/**
+ * \file BenchAlloc.cpp
+ * \brief Replace the global operator new and delete to count allocations.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#include <cstdlib>
+#include <new>
+
+#include "BenchAlloc.h"
+
+// Number of calls to operator new. Readers may allocate from several
+// threads, so it is only changed atomically.
+static unsigned long long benchAllocs = 0;
+
+
+unsigned long long benchGetAllocs()
+{
+  return benchAllocs;
+}
+
+
+// No exception specifications: throw(std::bad_alloc) is not valid from
+// C++17 on, and operator delete is implicitly noexcept from C++11 on.
+void* operator new(std::size_t size)
+{
+  void *p = malloc(size ? size : 1);
+  if (!p) {
+    throw std::bad_alloc();
+  }
+#if USE_OPENMP
+#pragma omp atomic
+#endif
+  ++benchAllocs;
+  return p;
+}
+
+
+void* operator new[](std::size_t size)
+{
+  void *p = malloc(size ? size : 1);
+  if (!p) {
+    throw std::bad_alloc();
+  }
+#if USE_OPENMP
+#pragma omp atomic
+#endif
+  ++benchAllocs;
+  return p;
+}
+
+
+void operator delete(void *p)
+{
+  free(p);
+}
+
+
+void operator delete[](void *p)
+{
+  free(p);
+}
+
+
+#if defined(__cpp_sized_deallocation)
+void operator delete(void *p, std::size_t)
+{
+  free(p);
+}
+
+
+void operator delete[](void *p, std::size_t)
+{
+  free(p);
+}
+#endif
+
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
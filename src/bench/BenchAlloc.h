@@ -0,0 +1,35 @@
+//
+//    MINOTAUR -- It's only 1/2 bull
+//
+//    (C)opyright 2009 - 2014 The MINOTAUR Team.
+//
+
+/**
+ * \file BenchAlloc.h
+ * \brief Count the allocations made while the microbenchmarks run.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#ifndef MINOTAURBENCHALLOC_H
+#define MINOTAURBENCHALLOC_H
+
+/**
+ * Return the number of calls to operator new and new[] so far, including
+ * those made from the library. The operators are replaced in
+ * BenchAlloc.cpp, which is kept apart so that the compiler does not inline
+ * them into the benchmarks.
+ */
+unsigned long long benchGetAllocs();
+
+#endif
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
@@ -0,0 +1,737 @@
+//
+//    MINOTAUR -- It's only 1/2 bull
+//
+//    (C)opyright 2009 - 2014 The MINOTAUR Team.
+//
+
+/**
+ * \file MicroBench.cpp
+ * \brief Microbenchmarks of the kernels that evaluate functions and their
+ * derivatives.
+ * \author Ashutosh Mahajan, IIT Bombay
+ *
+ * The kernels are timed on synthetic problems, whose size and sparsity are
+ * given on the command line, and on .nl files. Each kernel is run till it
+ * takes at least the given time, and this is repeated a few times. The
+ * median time per operation, the number of nonzeros processed per second
+ * and the number of allocations per operation are reported. Results can
+ * also be written in JSON format so that they can be compared across
+ * commits.
+ *
+ * Kernels (one operation evaluates all functions of the problem):
+ *   cgraph_eval, cgraph_gradient, cgraph_hessian: CGraph::eval,
+ *   evalGradient and evalHessian of the nonlinear functions.
+ *   linear_eval: LinearFunction::eval of the linear functions.
+ *   quadratic_gradient: QuadraticFunction::evalGradient.
+ *   jacobian_values: Jacobian::fillRowColValues.
+ *   hessian_values: HessianOfLag::fillRowColValues.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <time.h>
+
+#include "MinotaurConfig.h"
+#include "BenchAlloc.h"
+#include "CGraph.h"
+#include "Constraint.h"
+#include "Environment.h"
+#include "Function.h"
+#include "HessianOfLag.h"
+#include "Jacobian.h"
+#include "LinearFunction.h"
+#include "Logger.h"
+#include "NlReader.h"
+#include "Objective.h"
+#include "Option.h"
+#include "Problem.h"
+#include "QuadraticFunction.h"
+#include "Variable.h"
+
+using namespace Minotaur;
+
+// Options of the benchmark.
+struct BenchOpts {
+  double density;           // Fraction of variables in each function.
+  std::string json;         // File for the JSON output, "-" for stdout.
+  double minTime;           // Minimum time of each repetition in seconds.
+  UInt numCons;             // Constraints in synthetic problems, 0 for n/10.
+  UInt reps;                // Repetitions of each kernel.
+  UInt seed;                // Seed of the generator of synthetic problems.
+  std::vector<UInt> sizes;  // Number of variables in synthetic problems.
+  std::vector<std::string> files; // .nl files.
+};
+
+
+// Result of timing one kernel on one input.
+struct BenchResult {
+  std::string kernel;
+  std::string input;
+  UInt vars;
+  UInt cons;
+  UInt nnz;
+  UInt iters;
+  double nsPerOp;
+  double minNsPerOp;
+  double allocsPerOp;
+};
+
+
+// A problem and the parts of it that the kernels evaluate.
+struct BenchInput {
+  std::string name;
+  ProblemPtr p;
+  std::vector<NonlinearFunctionPtr> nlfs;
+  std::vector<LinearFunctionPtr> lfs;
+  std::vector<QuadraticFunctionPtr> qfs;
+  DoubleVector x;
+  DoubleVector mult;
+  LTHessStor stor;
+};
+
+
+// One operation of a kernel.
+class BenchKernel {
+  public:
+    BenchKernel(const std::string &name, UInt nnz)
+      : name_(name), nnz_(nnz), sink_(0.0) {};
+    virtual ~BenchKernel() {};
+    const std::string & getName() const { return name_; };
+    UInt getNnz() const { return nnz_; };
+    virtual void run() = 0;
+
+  protected:
+    std::string name_;
+    UInt nnz_;
+    double sink_;
+};
+
+
+class CGraphEvalKernel : public BenchKernel {
+  public:
+    CGraphEvalKernel(BenchInput *in, UInt nnz)
+      : BenchKernel("cgraph_eval", nnz), in_(in) {};
+    void run()
+    {
+      int err = 0;
+      for (UInt i=0; i<in_->nlfs.size(); ++i) {
+        sink_ += in_->nlfs[i]->eval(&(in_->x[0]), &err);
+      }
+    };
+
+  private:
+    BenchInput *in_;
+};
+
+
+class CGraphGradKernel : public BenchKernel {
+  public:
+    CGraphGradKernel(BenchInput *in, UInt nnz)
+      : BenchKernel("cgraph_gradient", nnz), in_(in),
+        grad_(in->x.size(), 0.0) {};
+    void run()
+    {
+      int err = 0;
+      for (UInt i=0; i<in_->nlfs.size(); ++i) {
+        in_->nlfs[i]->evalGradient(&(in_->x[0]), &(grad_[0]), &err);
+      }
+    };
+
+  private:
+    BenchInput *in_;
+    DoubleVector grad_;
+};
+
+
+class CGraphHessKernel : public BenchKernel {
+  public:
+    CGraphHessKernel(BenchInput *in)
+      : BenchKernel("cgraph_hessian", in->stor.nz), in_(in),
+        values_(in->stor.nz+1, 0.0) {};
+    void run()
+    {
+      int err = 0;
+      for (UInt i=0; i<in_->nlfs.size(); ++i) {
+        in_->nlfs[i]->evalHessian(1.0, &(in_->x[0]), &(in_->stor),
+                                  &(values_[0]), &err);
+      }
+    };
+
+  private:
+    BenchInput *in_;
+    DoubleVector values_;
+};
+
+
+class LinEvalKernel : public BenchKernel {
+  public:
+    LinEvalKernel(BenchInput *in, UInt nnz)
+      : BenchKernel("linear_eval", nnz), in_(in) {};
+    void run()
+    {
+      for (UInt i=0; i<in_->lfs.size(); ++i) {
+        sink_ += in_->lfs[i]->eval(&(in_->x[0]));
+      }
+    };
+
+  private:
+    BenchInput *in_;
+};
+
+
+class QuadGradKernel : public BenchKernel {
+  public:
+    QuadGradKernel(BenchInput *in, UInt nnz)
+      : BenchKernel("quadratic_gradient", nnz), in_(in),
+        grad_(in->x.size(), 0.0) {};
+    void run()
+    {
+      for (UInt i=0; i<in_->qfs.size(); ++i) {
+        in_->qfs[i]->evalGradient(&(in_->x[0]), &(grad_[0]));
+      }
+    };
+
+  private:
+    BenchInput *in_;
+    DoubleVector grad_;
+};
+
+
+class JacKernel : public BenchKernel {
+  public:
+    JacKernel(BenchInput *in)
+      : BenchKernel("jacobian_values", in->p->getJacobian()->getNumNz()),
+        in_(in), values_(nnz_+1, 0.0) {};
+    void run()
+    {
+      int err = 0;
+      in_->p->getJacobian()->fillRowColValues(&(in_->x[0]), &(values_[0]),
+                                              &err);
+    };
+
+  private:
+    BenchInput *in_;
+    DoubleVector values_;
+};
+
+
+class HessKernel : public BenchKernel {
+  public:
+    HessKernel(BenchInput *in)
+      : BenchKernel("hessian_values", in->p->getHessian()->getNumNz()),
+        in_(in), values_(nnz_+1, 0.0) {};
+    void run()
+    {
+      int err = 0;
+      in_->p->getHessian()->fillRowColValues(&(in_->x[0]), 1.0,
+                                             &(in_->mult[0]), &(values_[0]),
+                                             &err);
+    };
+
+  private:
+    BenchInput *in_;
+    DoubleVector values_;
+};
+
+
+static unsigned long long benchNow()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (unsigned long long) ts.tv_sec*1000000000ULL + ts.tv_nsec;
+}
+
+
+// A small generator so that synthetic problems are the same on all
+// machines.
+static UInt benchRand(UInt *state)
+{
+  *state = *state * 1103515245u + 12345u;
+  return (*state >> 8) & 0xffffff;
+}
+
+
+static void benchAddFun(BenchInput *in, FunctionPtr f)
+{
+  CGraphPtr cg;
+
+  if (!f) {
+    return;
+  }
+  if (f->getLinearFunction()) {
+    in->lfs.push_back(f->getLinearFunction());
+  }
+  if (f->getQuadraticFunction()) {
+    in->qfs.push_back(f->getQuadraticFunction());
+  }
+  cg = boost::dynamic_pointer_cast <CGraph> (f->getNonlinearFunction());
+  if (cg) {
+    in->nlfs.push_back(cg);
+  }
+}
+
+
+// Set up the storage of the hessian in the same way as HessianOfLag, so
+// that the functions can be evaluated on their own.
+static void benchHessStor(BenchInput *in)
+{
+  ProblemPtr p = in->p;
+  LTHessStor *stor = &(in->stor);
+  FunctionPtr obj;
+  UInt i, nz;
+
+  stor->nlVars = 0;
+  for (VariableConstIterator it=p->varsBegin(); it!=p->varsEnd(); ++it) {
+    if (Linear!=(*it)->getFunType() && Constant!=(*it)->getFunType()) {
+      ++(stor->nlVars);
+    }
+  }
+  stor->rows = new VariablePtr[stor->nlVars];
+  stor->colQs = new std::deque<UInt>[stor->nlVars];
+  stor->starts = new UInt[stor->nlVars+1];
+  i = 0;
+  for (VariableConstIterator it=p->varsBegin(); it!=p->varsEnd(); ++it) {
+    if (Linear!=(*it)->getFunType() && Constant!=(*it)->getFunType()) {
+      stor->rows[i] = *it;
+      ++i;
+    }
+  }
+
+  if (p->getObjective()) {
+    obj = p->getObjective()->getFunction();
+  }
+  if (obj) {
+    obj->fillHessStor(stor);
+  }
+  for (ConstraintConstIterator it=p->consBegin(); it!=p->consEnd(); ++it) {
+    (*it)->getFunction()->fillHessStor(stor);
+  }
+
+  nz = 0;
+  for (i=0; i<stor->nlVars; ++i) {
+    stor->starts[i] = nz;
+    nz += stor->colQs[i].size();
+  }
+  stor->starts[stor->nlVars] = nz;
+  stor->nz = nz;
+  stor->cols = new UInt[nz+1];
+  nz = 0;
+  for (i=0; i<stor->nlVars; ++i) {
+    for (std::deque<UInt>::iterator it=stor->colQs[i].begin();
+         it!=stor->colQs[i].end(); ++it, ++nz) {
+      stor->cols[nz] = *it;
+    }
+  }
+
+  if (obj) {
+    obj->finalHessStor(stor);
+  }
+  for (ConstraintConstIterator it=p->consBegin(); it!=p->consEnd(); ++it) {
+    (*it)->getFunction()->finalHessStor(stor);
+  }
+  delete [] stor->colQs;
+  stor->colQs = 0;
+}
+
+
+static void benchFreeInput(BenchInput *in)
+{
+  delete [] in->stor.rows;
+  delete [] in->stor.starts;
+  delete [] in->stor.cols;
+  in->nlfs.clear();
+  in->lfs.clear();
+  in->qfs.clear();
+  in->p.reset();
+}
+
+
+// Collect the functions of p and choose the point and multipliers.
+static void benchSetup(BenchInput *in, UInt *state)
+{
+  ProblemPtr p = in->p;
+  double lb, ub;
+
+  p->setNativeDer();
+  if (p->getObjective()) {
+    benchAddFun(in, p->getObjective()->getFunction());
+  }
+  for (ConstraintConstIterator it=p->consBegin(); it!=p->consEnd(); ++it) {
+    benchAddFun(in, (*it)->getFunction());
+  }
+
+  // a point inside the bounds, away from zero so that log and sqrt are
+  // defined.
+  in->x.resize(p->getNumVars()+1);
+  for (UInt i=0; i<p->getNumVars(); ++i) {
+    lb = p->getVariable(i)->getLb();
+    ub = p->getVariable(i)->getUb();
+    lb = (lb > -1e3) ? lb : -1e3;
+    ub = (ub < 1e3) ? ub : 1e3;
+    in->x[i] = (lb>0 || ub<0) ? lb + 0.5*(ub-lb) : 1.0;
+    in->x[i] += 1e-3*(benchRand(state) % 100);
+    if (in->x[i]>ub) {
+      in->x[i] = ub;
+    }
+  }
+  in->mult.assign(p->getNumCons()+1, 1.0);
+  benchHessStor(in);
+}
+
+
+// A problem with n variables in [1, 2] and m constraints. Each constraint
+// has k = density*n linear terms, k quadratic terms and a CGraph that is a
+// sum of k products, squares and logarithms of variables. The objective is
+// linear.
+static void benchGenerate(UInt n, UInt m, double density, UInt seed,
+                          BenchInput *in)
+{
+  ProblemPtr p = (ProblemPtr) new Problem();
+  UInt k = (UInt) ceil(density*n);
+  UInt state = seed;
+  LinearFunctionPtr lf;
+  QuadraticFunctionPtr qf;
+  CGraphPtr cg;
+  std::vector<CNode *> terms;
+  CNode *n0, *n1;
+  VariablePtr v0, v1;
+  std::ostringstream name;
+
+  name << "synthetic_n" << n << "_m" << m << "_d" << density;
+  in->name = name.str();
+  for (UInt i=0; i<n; ++i) {
+    p->newVariable(1.0, 2.0, Continuous);
+  }
+
+  for (UInt i=0; i<m; ++i) {
+    lf = (LinearFunctionPtr) new LinearFunction();
+    qf = (QuadraticFunctionPtr) new QuadraticFunction();
+    cg = (CGraphPtr) new CGraph();
+    terms.clear();
+    for (UInt j=0; j<k; ++j) {
+      v0 = p->getVariable(benchRand(&state) % n);
+      v1 = p->getVariable(benchRand(&state) % n);
+      lf->incTerm(v0, 1.0 + j % 3);
+      qf->incTerm(v0, v1, 0.5);
+      n0 = cg->newNode(v0);
+      switch (j % 3) {
+      case 0:
+        n1 = cg->newNode(v1);
+        n0 = cg->newNode(OpMult, n0, n1);
+        break;
+      case 1:
+        n0 = cg->newNode(OpSqr, n0, 0);
+        break;
+      default:
+        n0 = cg->newNode(OpLog, n0, 0);
+        break;
+      }
+      terms.push_back(n0);
+    }
+    n0 = (1==terms.size()) ? terms[0] :
+      cg->newNode(OpSumList, &(terms[0]), terms.size());
+    cg->setOut(n0);
+    cg->finalize();
+    p->newConstraint((FunctionPtr) new Function(lf, qf, cg), -INFINITY,
+                     1e6);
+  }
+
+  lf = (LinearFunctionPtr) new LinearFunction();
+  for (UInt j=0; j<k; ++j) {
+    lf->incTerm(p->getVariable(benchRand(&state) % n), 1.0);
+  }
+  p->newObjective((FunctionPtr) new Function(lf), 0.0, Minimize);
+
+  in->p = p;
+  benchSetup(in, &state);
+}
+
+
+static bool benchRead(EnvPtr env, const std::string &fname, UInt seed,
+                      BenchInput *in)
+{
+  NlReader reader(env);
+  UInt state = seed;
+  size_t pos;
+
+  in->p = reader.readInstance(fname);
+  if (!in->p) {
+    return false;
+  }
+  pos = fname.find_last_of('/');
+  in->name = (std::string::npos==pos) ? fname : fname.substr(pos+1);
+  benchSetup(in, &state);
+  return true;
+}
+
+
+// Time k. The number of iterations is doubled till one repetition takes
+// minTime. Then reps repetitions are timed.
+static void benchMeasure(BenchKernel *k, BenchInput *in,
+                         const BenchOpts &opts, BenchResult *res)
+{
+  unsigned long long start, allocs, ns = 0;
+  UInt iters = 1;
+  std::vector<double> times;
+
+  k->run();
+  while (true) {
+    start = benchNow();
+    for (UInt i=0; i<iters; ++i) {
+      k->run();
+    }
+    ns = benchNow() - start;
+    if (ns >= opts.minTime*1e9 || iters >= (1u<<30)) {
+      break;
+    }
+    iters *= 2;
+  }
+
+  allocs = benchGetAllocs();
+  for (UInt r=0; r<opts.reps; ++r) {
+    start = benchNow();
+    for (UInt i=0; i<iters; ++i) {
+      k->run();
+    }
+    ns = benchNow() - start;
+    times.push_back((double) ns / iters);
+  }
+  allocs = benchGetAllocs() - allocs;
+  std::sort(times.begin(), times.end());
+
+  res->kernel = k->getName();
+  res->input = in->name;
+  res->vars = in->p->getNumVars();
+  res->cons = in->p->getNumCons();
+  res->nnz = k->getNnz();
+  res->iters = iters;
+  res->nsPerOp = times[times.size()/2];
+  res->minNsPerOp = times[0];
+  res->allocsPerOp = (double) allocs / (iters*opts.reps);
+}
+
+
+static void benchRun(BenchInput *in, const BenchOpts &opts,
+                     std::vector<BenchResult> *results)
+{
+  std::vector<BenchKernel *> kernels;
+  UInt nnz;
+  BenchResult res;
+
+  if (!in->nlfs.empty()) {
+    nnz = 0;
+    for (UInt i=0; i<in->nlfs.size(); ++i) {
+      nnz += boost::static_pointer_cast <CGraph> (in->nlfs[i])->getNumNodes();
+    }
+    kernels.push_back(new CGraphEvalKernel(in, nnz));
+    kernels.push_back(new CGraphGradKernel(in, nnz));
+    kernels.push_back(new CGraphHessKernel(in));
+  }
+  if (!in->lfs.empty()) {
+    nnz = 0;
+    for (UInt i=0; i<in->lfs.size(); ++i) {
+      nnz += in->lfs[i]->getNumTerms();
+    }
+    kernels.push_back(new LinEvalKernel(in, nnz));
+  }
+  if (!in->qfs.empty()) {
+    nnz = 0;
+    for (UInt i=0; i<in->qfs.size(); ++i) {
+      nnz += in->qfs[i]->getNumTerms();
+    }
+    kernels.push_back(new QuadGradKernel(in, nnz));
+  }
+  if (in->p->getNumCons()>0) {
+    kernels.push_back(new JacKernel(in));
+  }
+  kernels.push_back(new HessKernel(in));
+
+  for (UInt i=0; i<kernels.size(); ++i) {
+    benchMeasure(kernels[i], in, opts, &res);
+    results->push_back(res);
+    std::cout << std::left << std::setw(20) << res.kernel
+              << std::setw(32) << res.input << std::right
+              << std::setw(10) << res.nnz
+              << std::fixed << std::setprecision(1)
+              << std::setw(14) << res.nsPerOp
+              << std::setw(12) << res.nnz*1e3/res.nsPerOp
+              << std::setprecision(2)
+              << std::setw(10) << res.allocsPerOp << std::endl;
+    delete kernels[i];
+  }
+}
+
+
+static void benchWriteJSON(EnvPtr env, const BenchOpts &opts,
+                           const std::vector<BenchResult> &results,
+                           std::ostream &out)
+{
+  out << std::setprecision(6)
+      << "{\"benchmark\": \"minotaur-microbench\", \"version\": \""
+      << env->getVersion() << "\", \"min_time\": " << opts.minTime
+      << ", \"reps\": " << opts.reps << ", \"results\": [";
+  for (UInt i=0; i<results.size(); ++i) {
+    const BenchResult &r = results[i];
+    out << (0==i ? "\n" : ",\n")
+        << "{\"kernel\": \"" << r.kernel << "\", \"input\": \"" << r.input
+        << "\", \"vars\": " << r.vars << ", \"cons\": " << r.cons
+        << ", \"nnz\": " << r.nnz << ", \"iterations\": " << r.iters
+        << ", \"ns_per_op\": " << r.nsPerOp
+        << ", \"min_ns_per_op\": " << r.minNsPerOp
+        << ", \"ops_per_sec\": " << 1e9/r.nsPerOp
+        << ", \"nnz_per_sec\": " << r.nnz*1e9/r.nsPerOp
+        << ", \"allocs_per_op\": " << r.allocsPerOp << "}";
+  }
+  out << "\n]}" << std::endl;
+}
+
+
+static void showHelp()
+{
+  std::cout << "Microbenchmarks of function and derivative evaluations"
+            << std::endl
+            << "Usage: microbench [options] [nl-files]" << std::endl
+            << "  --sizes n1,n2,...  variables in synthetic problems "
+            << "(default 100,1000,10000, 0 for none)" << std::endl
+            << "  --density d        fraction of variables in each function "
+            << "(default 0.01)" << std::endl
+            << "  --cons m           constraints in synthetic problems "
+            << "(default n/10)" << std::endl
+            << "  --min-time t       minimum seconds for each repetition "
+            << "(default 0.1)" << std::endl
+            << "  --reps r           repetitions of each kernel (default 5)"
+            << std::endl
+            << "  --seed s           seed for synthetic problems (default 1)"
+            << std::endl
+            << "  --json file        write results in JSON format, - for "
+            << "stdout" << std::endl;
+}
+
+
+static int readOpts(int argc, char **argv, BenchOpts *opts)
+{
+  std::string arg, val;
+  std::istringstream iss;
+  UInt n;
+
+  opts->density = 0.01;
+  opts->minTime = 0.1;
+  opts->numCons = 0;
+  opts->reps = 5;
+  opts->seed = 1;
+  opts->sizes.push_back(100);
+  opts->sizes.push_back(1000);
+  opts->sizes.push_back(10000);
+
+  for (int i=1; i<argc; ++i) {
+    arg = argv[i];
+    if (0!=arg.compare(0, 2, "--")) {
+      opts->files.push_back(arg);
+      continue;
+    }
+    if ("--help"==arg || i+1>=argc) {
+      showHelp();
+      return 1;
+    }
+    val = argv[++i];
+    iss.clear();
+    iss.str(val);
+    if ("--sizes"==arg) {
+      opts->sizes.clear();
+      for (std::string s; std::getline(iss, s, ',');) {
+        n = atoi(s.c_str());
+        if (n>0) {
+          opts->sizes.push_back(n);
+        }
+      }
+    } else if ("--density"==arg) {
+      iss >> opts->density;
+    } else if ("--cons"==arg) {
+      iss >> opts->numCons;
+    } else if ("--min-time"==arg) {
+      iss >> opts->minTime;
+    } else if ("--reps"==arg) {
+      iss >> opts->reps;
+    } else if ("--seed"==arg) {
+      iss >> opts->seed;
+    } else if ("--json"==arg) {
+      opts->json = val;
+    } else {
+      std::cerr << "microbench: unknown option " << arg << std::endl;
+      showHelp();
+      return 1;
+    }
+  }
+  if (opts->density<=0.0 || opts->density>1.0 || 0==opts->reps) {
+    std::cerr << "microbench: density must be in (0, 1] and reps positive"
+              << std::endl;
+    return 1;
+  }
+  return 0;
+}
+
+
+int main(int argc, char** argv)
+{
+  EnvPtr env = (EnvPtr) new Environment();
+  BenchOpts opts;
+  std::vector<BenchResult> results;
+  std::ofstream fout;
+  UInt m;
+
+  if (0!=readOpts(argc, argv, &opts)) {
+    return 1;
+  }
+  env->setLogLevel(LogError);
+
+  std::cout << std::left << std::setw(20) << "kernel" << std::setw(32)
+            << "input" << std::right << std::setw(10) << "nnz"
+            << std::setw(14) << "ns/op" << std::setw(12) << "Mnz/s"
+            << std::setw(10) << "allocs/op" << std::endl;
+  for (UInt i=0; i<opts.sizes.size(); ++i) {
+    BenchInput in;
+    m = opts.numCons ? opts.numCons : (opts.sizes[i]+9)/10;
+    benchGenerate(opts.sizes[i], m, opts.density, opts.seed, &in);
+    benchRun(&in, opts, &results);
+    benchFreeInput(&in);
+  }
+  for (UInt i=0; i<opts.files.size(); ++i) {
+    BenchInput in;
+    if (false==benchRead(env, opts.files[i], opts.seed, &in)) {
+      std::cerr << "microbench: skipping " << opts.files[i] << std::endl;
+      continue;
+    }
+    benchRun(&in, opts, &results);
+    benchFreeInput(&in);
+  }
+
+  if ("-"==opts.json) {
+    benchWriteJSON(env, opts, results, std::cout);
+  } else if (!opts.json.empty()) {
+    fout.open(opts.json.c_str());
+    if (!fout) {
+      std::cerr << "microbench: can not write to " << opts.json << std::endl;
+      return 1;
+    }
+    benchWriteJSON(env, opts, results, fout);
+    fout.close();
+  }
+  return 0;
+}
+
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
@@ -584,6 +584,7 @@ void OsiLPEngine::removeCons(std::vector<ConstraintPtr> &delcons)
   }
   osilp_->deleteRows(num, inds);
   consChanged_ = true;
+  delete [] inds;
 }
 
 
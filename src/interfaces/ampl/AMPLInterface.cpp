@@ -10,6 +10,7 @@
  * \author Ashutosh Mahajan, Argonne National Laboratory
  */
 
+#include <algorithm>
 #include <sstream>
 #include <stdint.h>
 #include <iostream>
@@ -25,6 +26,7 @@
 #include "Function.h"
 #include "Logger.h"
 #include "LinearFunction.h"
+#include "NlReader.h"
 #include "Option.h"
 #include "PolynomialFunction.h"
 #include "Problem.h"
@@ -686,19 +688,17 @@ Minotaur::ProblemPtr AMPLInterface::copyInstanceFromASL_()
 
 Minotaur::ProblemPtr AMPLInterface::copyInstanceFromASL2_()
 {
-  Minotaur::UInt stop_index;
-  Minotaur::UInt start_index;
   Minotaur::LinearFunctionPtr lf = Minotaur::LinearFunctionPtr();  //NULL
   Minotaur::QuadraticFunctionPtr qf = Minotaur::QuadraticFunctionPtr();  //NULL
   Minotaur::FunctionPtr f = Minotaur::FunctionPtr();  //NULL
-  cde *constraint_cde = 0, *obj_cde = 0;
+  std::vector<Minotaur::FunctionPtr> funs;
+  cde *obj_cde = 0;
   ASL_fg *asl_fg = (ASL_fg *)myAsl_;
   Minotaur::CGraphPtr cgraph;
   Minotaur::CNode *cnode = 0;
   std::string name;
   Minotaur::ObjectiveType obj_sense = Minotaur::Minimize;
-  double *x = 0, *grad = 0;
-  int err = 0;
+  int nlcons;
 
   // new instance
   Minotaur::ProblemPtr instance = (Minotaur::ProblemPtr) 
@@ -706,48 +706,41 @@ Minotaur::ProblemPtr AMPLInterface::copyInstanceFromASL2_()
   addVariablesFromASL_(instance);
   addDefinedVars_(instance);
 
-  x = new double[instance->getNumVars()];
-  grad = new double[instance->getNumVars()];
-  memset(x, 0, instance->getNumVars()*sizeof(double));
-  memset(grad, 0, instance->getNumVars()*sizeof(double));
-
   // visit each constraint and copy the linear parts and nonlinear parts.
-  start_index = 0;
-  stop_index = myAsl_->i.nlc_ - myAsl_->i.nlnc_;
-  for (Minotaur::UInt i=start_index; i<stop_index; ++i) {
-    cgraph = (Minotaur::CGraphPtr) new Minotaur::CGraph();
-    lf = (Minotaur::LinearFunctionPtr) new Minotaur::LinearFunction();
-    addLinearTermsFromConstr_(lf, i);
-    constraint_cde = asl_fg->I.con_de_+i;
-    cnode = getCGraph_(constraint_cde->e, cgraph, instance);
-    cgraph->setOut(cnode);
-    cgraph->finalize();
-    assert(Minotaur::Constant!=cgraph->getType());
-
-    // If a constraint has a 'defined variable (AMPL specific)' then even if
-    // the constraint is linear, AMPL may still give a cgraph. We convert such
-    // a cgraph into a linear function, and add a linear constraint. The
-    // 'defined variable' is separately added as a nonlinear constraint later
-    // on.
-    if (Minotaur::Linear==cgraph->getType()) {
-      if (!lf) {
-        lf = (Minotaur::LinearFunctionPtr) new Minotaur::LinearFunction();
-      }
-      cgraph->evalGradient(x, grad, &err);
-      assert(0==err);
-      for (Minotaur::UInt j=0; j<instance->getNumVars(); ++j) {
-        if (fabs(grad[j])>1e-10) {
-          lf->incTerm(instance->getVariable(j), grad[j]);
-        }
+  // The functions of constraints are independent of each other and are
+  // built in parallel, each with its own CGraph. They are added to the
+  // instance afterwards in the order of ASL, so that the instance does not
+  // depend on the number of threads.
+  nlcons = myAsl_->i.nlc_ - myAsl_->i.nlnc_;
+  funs.resize(myAsl_->i.n_con_);
+#if USE_OPENMP
+#pragma omp parallel num_threads(getNumThreads_())
+#endif
+  {
+    double *x = new double[instance->getNumVars()];
+    double *grad = new double[instance->getNumVars()];
+    memset(x, 0, instance->getNumVars()*sizeof(double));
+    memset(grad, 0, instance->getNumVars()*sizeof(double));
+#if USE_OPENMP
+#pragma omp for schedule(dynamic, 64)
+#endif
+    for (int i=0; i<myAsl_->i.n_con_; ++i) {
+      if (i<nlcons) {
+        funs[i] = getCGraphFun_(i, instance, x, grad);
+      } else {
+        Minotaur::LinearFunctionPtr llf = Minotaur::LinearFunctionPtr();
+        addLinearTermsFromConstr_(llf, i);
+        funs[i] = (Minotaur::FunctionPtr) new Minotaur::Function(llf);
       }
-      memset(grad, 0, instance->getNumVars()*sizeof(double));
-      cgraph.reset();
     }
+    delete [] grad;
+    delete [] x;
+  }
 
-    f = (Minotaur::FunctionPtr) new Minotaur::Function(lf, qf, cgraph);
+  for (int i=0; i<nlcons; ++i) {
     name = std::string(con_name_ASL(myAsl_, i));
-    instance->newConstraint(f, myAsl_->i.LUrhs_[2*i], myAsl_->i.LUrhs_[2*i+1],
-                            name); 
+    instance->newConstraint(funs[i], myAsl_->i.LUrhs_[2*i],
+                            myAsl_->i.LUrhs_[2*i+1], name); 
   }
 
   // add constraints that are used to define 'defined variables'
@@ -758,11 +751,12 @@ Minotaur::ProblemPtr AMPLInterface::copyInstanceFromASL2_()
   assert (myAsl_->i.lnc_ == 0);
 
   // add linear constraints
-  start_index = stop_index;
-  stop_index  = myAsl_->i.n_con_;
-  for (Minotaur::UInt i=start_index; i<stop_index; ++i) {
-    addLinearConstraint_(i, instance);
+  for (int i=nlcons; i<myAsl_->i.n_con_; ++i) {
+    name = std::string(con_name_ASL(myAsl_, i));
+    instance->newConstraint(funs[i], myAsl_->i.LUrhs_[2*i],
+                            myAsl_->i.LUrhs_[2*i+1], name); 
   }
+  funs.clear();
 
   assert (myAsl_->i.n_obj_ < 2);
   if (myAsl_->i.nlo_ > 0) {
@@ -786,9 +780,6 @@ Minotaur::ProblemPtr AMPLInterface::copyInstanceFromASL2_()
 
   addSOS_(instance);
 
-  delete [] grad;
-  delete [] x;
-
   return instance;
 }
 
@@ -900,7 +891,7 @@ Minotaur::ProblemType AMPLInterface::findProblemType_()
 
 void AMPLInterface::findVars_(expr *e_ptr, std::set<int> & vars)
 {
-  int opcode = functionMap_.find(e_ptr->op)->second;
+  int opcode = getOpCode_(e_ptr);
   switch (opcode) {
    case (OPPLUS):   // expr1 + expr2
    case (OPMINUS):  // expr1 - expr2
@@ -1003,7 +994,7 @@ Minotaur::CNode *AMPLInterface::getCGraph_(expr *e_ptr,
   Minotaur::CNode *rchild = 0;
   Minotaur::CNode **childr = 0;
   Minotaur::CNode *n = 0;
-  int opcode = functionMap_[e_ptr->op];
+  int opcode = getOpCode_(e_ptr);
   switch (opcode) {
   case (OPPLUS):   // expr1 + expr2
     lchild = getCGraph_(e_ptr->L.e, cgraph, instance);
@@ -1175,18 +1166,69 @@ Minotaur::CNode *AMPLInterface::getCGraph_(expr *e_ptr,
 }
 
 
+Minotaur::FunctionPtr AMPLInterface::getCGraphFun_(int i,
+                                                  Minotaur::ProblemPtr instance,
+                                                  double *x, double *grad)
+{
+  Minotaur::LinearFunctionPtr lf = (Minotaur::LinearFunctionPtr) 
+                                   new Minotaur::LinearFunction();
+  Minotaur::QuadraticFunctionPtr qf = Minotaur::QuadraticFunctionPtr();  //NULL
+  Minotaur::CGraphPtr cgraph = (Minotaur::CGraphPtr) new Minotaur::CGraph();
+  cde *constraint_cde = ((ASL_fg *)myAsl_)->I.con_de_+i;
+  Minotaur::CNode *cnode = 0;
+  int err = 0;
+
+  addLinearTermsFromConstr_(lf, i);
+  cnode = getCGraph_(constraint_cde->e, cgraph, instance);
+  cgraph->setOut(cnode);
+  cgraph->finalize();
+  assert(Minotaur::Constant!=cgraph->getType());
+
+  // If a constraint has a 'defined variable (AMPL specific)' then even if
+  // the constraint is linear, AMPL may still give a cgraph. We convert such
+  // a cgraph into a linear function, and add a linear constraint. The
+  // 'defined variable' is separately added as a nonlinear constraint later
+  // on.
+  if (Minotaur::Linear==cgraph->getType()) {
+    if (!lf) {
+      lf = (Minotaur::LinearFunctionPtr) new Minotaur::LinearFunction();
+    }
+    cgraph->evalGradient(x, grad, &err);
+    assert(0==err);
+    for (Minotaur::UInt j=0; j<instance->getNumVars(); ++j) {
+      if (fabs(grad[j])>1e-10) {
+        lf->incTerm(instance->getVariable(j), grad[j]);
+      }
+    }
+    memset(grad, 0, instance->getNumVars()*sizeof(double));
+    cgraph.reset();
+  }
+
+  return (Minotaur::FunctionPtr) new Minotaur::Function(lf, qf, cgraph);
+}
+
+
 Minotaur::FunctionType AMPLInterface::getConstraintsType_() 
 {
   Minotaur::FunctionType function_type, overall_type;
+  std::vector<Minotaur::FunctionType> types;
   if (myAsl_->i.nlc_ == 0 && nDefVars_==0) {
     return Minotaur::Linear;
   }
 
   overall_type = Minotaur::Constant;
   // visit all nonlinear constraints that are not network-constraints and
-  // check if all are Quadratic. 
-  for (int i=0; i<myAsl_->i.nlc_ - myAsl_->i.nlnc_; ++i) {
-    function_type = getConstraintType_(i);
+  // check if all are Quadratic. The expressions are classified in parallel
+  // and the types are combined in order afterwards.
+  types.resize(myAsl_->i.nlc_ - myAsl_->i.nlnc_);
+#if USE_OPENMP
+#pragma omp parallel for num_threads(getNumThreads_()) schedule(dynamic, 64)
+#endif
+  for (int i=0; i<(int) types.size(); ++i) {
+    types[i] = getConstraintType_(i);
+  }
+  for (Minotaur::UInt i=0; i<types.size(); ++i) {
+    function_type = types[i];
     logger_->msgStream(Minotaur::LogDebug) << "Constraint (nonlin) is " <<
       getFunctionTypeString(function_type) << std::endl;
     overall_type = Minotaur::funcTypesAdd(overall_type, function_type);
@@ -1265,7 +1307,7 @@ Minotaur::FunctionType AMPLInterface::getExpressionType_(expr *e_ptr)
   int opcode;
   Minotaur::FunctionType fun_type1, fun_type2;
 
-  opcode = functionMap_[e_ptr->op];
+  opcode = getOpCode_(e_ptr);
   switch (opcode) {
    case (OPPLUS):   // expr1 + expr2
    case (OPMINUS):  // expr1 - expr2
@@ -1552,6 +1594,27 @@ AMPLInterface::getObjFunctionType_(Minotaur::UInt obj_index)
 }
 
 
+int AMPLInterface::getNumThreads_() const
+{
+  int n = 1;
+#if USE_OPENMP
+  n = env_->getOptions()->findInt("threads")->getValue();
+#endif
+  return (n<1) ? 1 : n;
+}
+
+
+int AMPLInterface::getOpCode_(expr *e_ptr) const
+{
+  std::map<efunc*, int>::const_iterator it = functionMap_.find(e_ptr->op);
+
+  if (it==functionMap_.end()) {
+    return -1;
+  }
+  return it->second;
+}
+
+
 void AMPLInterface::getOptionsFromEnv_(std::string pre)
 {
   std::string str;
@@ -1915,9 +1978,14 @@ void AMPLInterface::readFile_(std::string *fname, ReaderType readerType)
 
 Minotaur::ProblemPtr AMPLInterface::readInstance(std::string fname) 
 {
+  // the same interface may read several instances one after the other.
+  freeASL();
+  vars_.clear();
   if (false==env_->getOptions()->findBool("use_native_cgraph")->getValue()) {
     return readInstanceASL_(fname);
-  } 
+  } else if (env_->getOptions()->findBool("native_nl_reader")->getValue()) {
+    return readInstanceNl_(fname);
+  }
   return readInstanceCG_(fname);
 }
 
@@ -2041,6 +2109,52 @@ Minotaur::ProblemPtr AMPLInterface::readInstanceCG_(std::string fname)
 }
 
 
+Minotaur::ProblemPtr AMPLInterface::readInstanceNl_(std::string fname) 
+{
+  Minotaur::NlReader reader(env_);
+  Minotaur::ProblemPtr instance;
+  FILE *nl = NULL;
+  char *fname_chars;
+  const double *x0;
+
+  // ASL reads only the header. Everything else is read by NlReader, which
+  // builds the computational graphs directly.
+  fname_chars = (char *)malloc((fname.length()+1)*sizeof(char));
+  strcpy(fname_chars, fname.c_str());
+  readerType_ = FGReader;
+  myAsl_ = ASL_alloc(ASL_read_fg); 
+  nl = jac0dim_ASL(myAsl_, fname_chars, (fint) (fname.length()));
+  free(fname_chars);
+  if (nl) {
+    fclose(nl);
+  }
+
+  nVars_ = myAsl_->i.n_var_;
+  nDefVarsBco_ = myAsl_->i.comb_ + myAsl_->i.comc_ + myAsl_->i.como_; 
+  nDefVarsCo1_ = myAsl_->i.comc1_ + myAsl_->i.como1_; 
+  nDefVars_    = nDefVarsBco_ + nDefVarsCo1_;
+  nCons_ = myAsl_->i.n_con_;
+  myAsl_->i.X0_ = (real *)mymalloc_ASL(nVars_*sizeof(real));
+
+  instance = reader.readInstance(fname);
+  if (!instance) {
+    logger_->errStream() << me_ << "NlReader could not read " << fname
+                         << std::endl;
+    assert(!"NlReader could not read the .nl file.");
+    return instance;
+  }
+  x0 = reader.getInitialPoint();
+  std::copy(x0, x0+nVars_, myAsl_->i.X0_);
+  for (Minotaur::UInt i=0; i<instance->getNumVars(); ++i) {
+    vars_.push_back(instance->getVariable(i));
+  }
+
+  env_->getLogger()->msgStream(Minotaur::LogInfo) << me_ << "problem type is "
+    << getProblemTypeString(instance->findType()) << std::endl;
+  return instance;
+}
+
+
 void AMPLInterface::saveNlVars_(std::vector<std::set<int> > &vars)
 {
   std::set<int> vset;
@@ -2197,7 +2311,7 @@ void AMPLInterface::writeExpression_(int i, bool is_obj, std::ostream &out)
 
 void AMPLInterface::writeExpression_(expr *e_ptr, std::ostream &out) const
 {
-  int opcode = functionMap_.find(e_ptr->op)->second;
+  int opcode = getOpCode_(e_ptr);
   switch (opcode) {
    case (OPPLUS):   // expr1 + expr2
      out << "(";
@@ -23,6 +23,7 @@ namespace Minotaur {
 class   CGraph;
 class   CNode;
 class   Environment;
+class   Function;
 class   LinearFunction;
 class   PolynomialFunction;
 class   Problem;
@@ -30,6 +31,7 @@ class   QuadraticFunction;
 class   Solution;
 typedef boost::shared_ptr<CGraph> CGraphPtr;
 typedef boost::shared_ptr<Environment> EnvironmentPtr;
+typedef boost::shared_ptr<Function> FunctionPtr;
 typedef boost::shared_ptr<LinearFunction> LinearFunctionPtr;
 typedef boost::shared_ptr<PolynomialFunction> PolyFunPtr;
 typedef boost::shared_ptr<Problem> ProblemPtr;
@@ -92,7 +94,11 @@ public:
   /// What kind of reader from ASL was used to read the .nl file.
   ReaderType getReaderType();
 
-  /// Read an instance from a .nl file 'fname'.
+  /**
+   * Read an instance from a .nl file 'fname'. The ASL data of the instance
+   * read before, if any, is freed, so problems that use it must not be
+   * solved any more.
+   */
   Minotaur::ProblemPtr readInstance(std::string fname);
 
   /// Write the solution to the AMPL acceptable .sol file.
@@ -231,6 +237,18 @@ private:
   Minotaur::CNode* getCGraph_(expr *e_ptr, Minotaur::CGraphPtr cgraph, 
                               Minotaur::ProblemPtr instance);
 
+  /**
+   * \brief Get the function of the i-th nonlinear constraint, with its
+   * own CGraph. It may be called from several threads at once.
+   * \param [in] i Index of the constraint in ASL.
+   * \param [in] instance The instance whose variables are used.
+   * \param [in] x Array of zeros, of size equal to the number of variables.
+   * \param [in] grad Array of zeros, of the same size. It is zero again on
+   * return.
+   */
+  Minotaur::FunctionPtr getCGraphFun_(int i, Minotaur::ProblemPtr instance,
+                                      double *x, double *grad);
+
   /// Get the most general function type that describes all constraints.
   Minotaur::FunctionType getConstraintsType_();
 
@@ -266,9 +284,23 @@ private:
    */
   Minotaur::FunctionType getMultExpressionType_(expr *e_ptr);
 
+  /**
+   * Return the number of threads used to convert constraints from ASL. The
+   * option "threads" is read each time, since drivers create the interface
+   * before they read the options.
+   */
+  int getNumThreads_() const;
+
   /// Return the function type of objective.
   Minotaur::FunctionType getObjFunctionType_(Minotaur::UInt obj_index=0);
 
+  /**
+   * Return the operation-code of the root of e_ptr, or -1 if its function
+   * is not in functionMap_. The map is only read, so this may be called
+   * from several threads.
+   */
+  int getOpCode_(expr *e_ptr) const;
+
   /** 
    * When a solver is called from ampl, options are passed as
    * environment variables. For e.g. if the solver name is qg, and
@@ -309,6 +341,12 @@ private:
   Minotaur::ProblemPtr readInstanceASL_(std::string fname);
   Minotaur::ProblemPtr readInstanceCG_(std::string fname);
 
+  /**
+   * \brief Read the instance with Minotaur's NlReader. ASL reads only the
+   * header, so that the solution can be written in the .sol file.
+   */
+  Minotaur::ProblemPtr readInstanceNl_(std::string fname);
+
   void saveNlVars_(std::vector<std::set<int> > &vars);
 
   /**
@@ -0,0 +1,733 @@
+//
+//     MINOTAUR -- It's only 1/2 bull
+//
+//     (C)opyright 2008 - 2014 The MINOTAUR Team.
+//
+
+/**
+ * \file MpsReader.cpp
+ * \brief Define the MpsReader class that reads a linear or quadratic
+ * problem from an MPS file.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#if USE_OPENMP
+#include <omp.h>
+#endif
+
+#include "MinotaurConfig.h"
+#include "Environment.h"
+#include "Function.h"
+#include "LinearFunction.h"
+#include "Logger.h"
+#include "MpsReader.h"
+#include "Option.h"
+#include "Problem.h"
+#include "QuadraticFunction.h"
+#include "Timer.h"
+#include "Variable.h"
+
+using namespace Minotaur;
+
+const std::string MpsReader::me_ = "MpsReader: ";
+
+// Sections of an MPS file.
+typedef enum {
+  MpsNone,
+  MpsObjSense,
+  MpsRows,
+  MpsColumns,
+  MpsRhs,
+  MpsRanges,
+  MpsBounds,
+  MpsQTri,    // one triangle of Q, 1/2 x'Qx.
+  MpsQFull,   // full Q, 1/2 x'Qx.
+  MpsQCon,    // full Q of a constraint, x'Qx.
+  MpsSkip,    // ignored, e.g. NAME.
+  MpsEnd
+} MpsSection;
+
+
+// Return true if the field [s, s+len) is word, ignoring case.
+static bool mpsIs(const char *s, UInt len, const char *word)
+{
+  UInt i = 0;
+  for (; i<len && word[i]; ++i) {
+    if (toupper(s[i])!=word[i]) {
+      return false;
+    }
+  }
+  return (i==len && 0==word[i]);
+}
+
+
+// Read a number from the field [s, s+len).
+static bool mpsNum(const char *s, UInt len, double *d)
+{
+  char buf[64];
+  char *e;
+
+  if (0==len || len>=sizeof(buf)) {
+    return false;
+  }
+  memcpy(buf, s, len);
+  buf[len] = 0;
+  *d = strtod(buf, &e);
+  return (e==buf+len);
+}
+
+
+MpsNames::MpsNames()
+  : slots_(1024, 0)
+{
+}
+
+
+UInt MpsNames::add(const char *s, UInt len, bool *isnew)
+{
+  UInt h;
+
+  if (2*(beg_.size()+1)>slots_.size()) {
+    grow_();
+  }
+  h = hash_(s, len) & (slots_.size()-1);
+  while (slots_[h]) {
+    UInt i = slots_[h]-1;
+    if (len_[i]==len && 0==memcmp(beg_[i], s, len)) {
+      *isnew = false;
+      return i;
+    }
+    h = (h+1) & (slots_.size()-1);
+  }
+  beg_.push_back(s);
+  len_.push_back(len);
+  slots_[h] = beg_.size();
+  *isnew = true;
+  return beg_.size()-1;
+}
+
+
+int MpsNames::find(const char *s, UInt len) const
+{
+  UInt h = hash_(s, len) & (slots_.size()-1);
+
+  while (slots_[h]) {
+    UInt i = slots_[h]-1;
+    if (len_[i]==len && 0==memcmp(beg_[i], s, len)) {
+      return i;
+    }
+    h = (h+1) & (slots_.size()-1);
+  }
+  return -1;
+}
+
+
+std::string MpsNames::get(UInt i) const
+{
+  return std::string(beg_[i], len_[i]);
+}
+
+
+void MpsNames::grow_()
+{
+  slots_.assign(2*slots_.size(), 0);
+  for (UInt i=0; i<beg_.size(); ++i) {
+    UInt h = hash_(beg_[i], len_[i]) & (slots_.size()-1);
+    while (slots_[h]) {
+      h = (h+1) & (slots_.size()-1);
+    }
+    slots_[h] = i+1;
+  }
+}
+
+
+UInt MpsNames::hash_(const char *s, UInt len) const
+{
+  // FNV-1a.
+  UInt h = 2166136261u;
+  for (UInt i=0; i<len; ++i) {
+    h = (h ^ (unsigned char) s[i]) * 16777619u;
+  }
+  return h;
+}
+
+
+MpsReader::MpsReader(EnvPtr env)
+  : env_(env),
+    fixed_(false),
+    nnz_(0),
+    nQnz_(0),
+    time_(0.0)
+{
+  logger_ = env->getLogger();
+  nThreads_ = env->getOptions()->findInt("threads")->getValue();
+#if !(USE_OPENMP)
+  nThreads_ = 1;
+#endif
+  if (nThreads_<1) {
+    nThreads_ = 1;
+  }
+}
+
+
+MpsReader::~MpsReader()
+{
+}
+
+
+ProblemPtr MpsReader::build_(const std::vector<std::vector<MpsLine> > &chunks)
+{
+  MpsNames rows, cols;
+  MpsSection sec = MpsNone;
+  std::vector<char> rtype;
+  DoubleVector rhs, range;
+  BoolVector has_range;
+  UIntVector er, ec, rbeg;
+  DoubleVector ev;
+  DoubleVector lb, ub;
+  BoolVector is_int, has_bnd;
+  UIntVector qr, qi, qj;
+  DoubleVector qv;
+  const char *set[3] = {0, 0, 0};    // first set of RHS, RANGES, BOUNDS.
+  UInt set_len[3] = {0, 0, 0};
+  int obj = -1, qrow = -1, r, c;
+  double objc = 0.0, d, d2;
+  bool maximize = false, integer = false, isnew;
+  ProblemPtr p;
+  VarVector vars;
+  std::vector<LinearFunctionPtr> lfs;
+  std::vector<QuadraticFunctionPtr> qfs;
+
+  for (UInt t=0; t<chunks.size() && MpsEnd!=sec; ++t) {
+    for (std::vector<MpsLine>::const_iterator it=chunks[t].begin();
+         it!=chunks[t].end() && MpsEnd!=sec; ++it) {
+      const MpsLine &l = *it;
+      if (l.head) {
+        if (mpsIs(l.f[0], l.len[0], "NAME")) {
+          sec = MpsSkip;
+        } else if (mpsIs(l.f[0], l.len[0], "OBJSENSE")) {
+          sec = MpsObjSense;
+          if (l.nf>1) {
+            maximize = mpsIs(l.f[1], l.len[1], "MAX") ||
+              mpsIs(l.f[1], l.len[1], "MAXIMIZE");
+            sec = MpsSkip;
+          }
+        } else if (mpsIs(l.f[0], l.len[0], "ROWS")) {
+          sec = MpsRows;
+        } else if (mpsIs(l.f[0], l.len[0], "COLUMNS")) {
+          sec = MpsColumns;
+        } else if (mpsIs(l.f[0], l.len[0], "RHS")) {
+          sec = MpsRhs;
+        } else if (mpsIs(l.f[0], l.len[0], "RANGES")) {
+          sec = MpsRanges;
+        } else if (mpsIs(l.f[0], l.len[0], "BOUNDS")) {
+          sec = MpsBounds;
+        } else if (mpsIs(l.f[0], l.len[0], "QUADOBJ") ||
+                   mpsIs(l.f[0], l.len[0], "QSECTION") ||
+                   mpsIs(l.f[0], l.len[0], "QMATRIX") ||
+                   mpsIs(l.f[0], l.len[0], "QCMATRIX")) {
+          sec = mpsIs(l.f[0], l.len[0], "QMATRIX") ? MpsQFull :
+            mpsIs(l.f[0], l.len[0], "QCMATRIX") ? MpsQCon : MpsQTri;
+          qrow = obj;
+          if (l.nf>1) {
+            qrow = rows.find(l.f[1], l.len[1]);
+          }
+          if (qrow<0 || 'X'==rtype[qrow]) {
+            error_(l, "unknown row of quadratic section");
+            return ProblemPtr();
+          }
+        } else if (mpsIs(l.f[0], l.len[0], "ENDATA")) {
+          sec = MpsEnd;
+        } else {
+          error_(l, "unsupported section");
+          return ProblemPtr();
+        }
+        continue;
+      }
+
+      switch (sec) {
+      case MpsObjSense:
+        maximize = mpsIs(l.f[0], l.len[0], "MAX") ||
+          mpsIs(l.f[0], l.len[0], "MAXIMIZE");
+        break;
+      case MpsRows:
+        if (l.nf<2) {
+          error_(l, "bad row");
+          return ProblemPtr();
+        }
+        r = rows.add(l.f[1], l.len[1], &isnew);
+        if (!isnew) {
+          error_(l, "repeated row");
+          return ProblemPtr();
+        }
+        rtype.push_back(toupper(l.f[0][0]));
+        if ('N'==rtype.back()) {
+          if (obj<0) {
+            obj = r;
+          } else {
+            rtype.back() = 'X';
+          }
+        } else if ('E'!=rtype.back() && 'L'!=rtype.back() &&
+                   'G'!=rtype.back()) {
+          error_(l, "bad type of row");
+          return ProblemPtr();
+        }
+        break;
+      case MpsColumns:
+        if (l.nf>=3 && mpsIs(l.f[1], l.len[1], "'MARKER'")) {
+          integer = mpsIs(l.f[2], l.len[2], "'INTORG'");
+          break;
+        }
+        if (l.nf!=3 && l.nf!=5) {
+          error_(l, "bad entry of column");
+          return ProblemPtr();
+        }
+        c = cols.add(l.f[0], l.len[0], &isnew);
+        if (isnew) {
+          lb.push_back(0.0);
+          ub.push_back(INFINITY);
+          is_int.push_back(integer);
+          has_bnd.push_back(false);
+        }
+        for (UInt k=1; k<l.nf; k+=2) {
+          r = rows.find(l.f[k], l.len[k]);
+          if (r<0 || !mpsNum(l.f[k+1], l.len[k+1], &d)) {
+            error_(l, "unknown row or bad number");
+            return ProblemPtr();
+          }
+          if ('X'!=rtype[r]) {
+            er.push_back(r);
+            ec.push_back(c);
+            ev.push_back(d);
+          }
+        }
+        break;
+      case MpsRhs:
+      case MpsRanges:
+        {
+          UInt s = (MpsRhs==sec) ? 0 : 1;
+          UInt k = l.nf%2;
+          if (l.nf<2) {
+            error_(l, "bad entry");
+            return ProblemPtr();
+          }
+          if (1==k) {
+            if (!set[s]) {
+              set[s] = l.f[0];
+              set_len[s] = l.len[0];
+            } else if (set_len[s]!=l.len[0] ||
+                       0!=memcmp(set[s], l.f[0], l.len[0])) {
+              break;
+            }
+          }
+          if (rhs.empty()) {
+            rhs.resize(rtype.size(), 0.0);
+            range.resize(rtype.size(), 0.0);
+            has_range.resize(rtype.size(), false);
+          }
+          for (; k+1<l.nf; k+=2) {
+            r = rows.find(l.f[k], l.len[k]);
+            if (r<0 || !mpsNum(l.f[k+1], l.len[k+1], &d)) {
+              error_(l, "unknown row or bad number");
+              return ProblemPtr();
+            }
+            if (0==s && r==obj) {
+              objc = -d;
+            } else if (0==s) {
+              rhs[r] = d;
+            } else {
+              range[r] = d;
+              has_range[r] = true;
+            }
+          }
+        }
+        break;
+      case MpsBounds:
+        {
+          bool noval = mpsIs(l.f[0], l.len[0], "FR") ||
+            mpsIs(l.f[0], l.len[0], "MI") || mpsIs(l.f[0], l.len[0], "PL") ||
+            mpsIs(l.f[0], l.len[0], "BV");
+          UInt nv = (noval) ? 0 : 1;   // number of values.
+          UInt ci;
+
+          // BV may have a value, e.g. "BV set col 1".
+          if (mpsIs(l.f[0], l.len[0], "BV") && l.nf>=3 &&
+              mpsNum(l.f[l.nf-1], l.len[l.nf-1], &d) &&
+              (4==l.nf || cols.find(l.f[1], l.len[1])>=0)) {
+            nv = 1;
+          }
+          if (l.nf<2+nv || l.nf>3+nv) {
+            error_(l, "bad bound");
+            return ProblemPtr();
+          }
+          ci = (3+nv==l.nf) ? 2 : 1;
+          if (2==ci) {
+            if (!set[2]) {
+              set[2] = l.f[1];
+              set_len[2] = l.len[1];
+            } else if (set_len[2]!=l.len[1] ||
+                       0!=memcmp(set[2], l.f[1], l.len[1])) {
+              break;
+            }
+          }
+          c = cols.find(l.f[ci], l.len[ci]);
+          d = 0.0;
+          if (c<0 || (1==nv && !mpsNum(l.f[ci+1], l.len[ci+1], &d))) {
+            error_(l, "unknown column or bad number");
+            return ProblemPtr();
+          }
+          has_bnd[c] = true;
+          if (mpsIs(l.f[0], l.len[0], "UP") ||
+              mpsIs(l.f[0], l.len[0], "UI")) {
+            ub[c] = d;
+            if (d<0.0 && 0.0==lb[c]) {
+              lb[c] = -INFINITY;
+            }
+            is_int[c] = is_int[c] || 'I'==toupper(l.f[0][1]);
+          } else if (mpsIs(l.f[0], l.len[0], "LO") ||
+                     mpsIs(l.f[0], l.len[0], "LI")) {
+            lb[c] = d;
+            is_int[c] = is_int[c] || 'I'==toupper(l.f[0][1]);
+          } else if (mpsIs(l.f[0], l.len[0], "FX")) {
+            lb[c] = ub[c] = d;
+          } else if (mpsIs(l.f[0], l.len[0], "FR")) {
+            lb[c] = -INFINITY;
+            ub[c] = INFINITY;
+          } else if (mpsIs(l.f[0], l.len[0], "MI")) {
+            lb[c] = -INFINITY;
+          } else if (mpsIs(l.f[0], l.len[0], "PL")) {
+            ub[c] = INFINITY;
+          } else if (mpsIs(l.f[0], l.len[0], "BV")) {
+            lb[c] = 0.0;
+            ub[c] = 1.0;
+            is_int[c] = true;
+          } else {
+            error_(l, "unsupported type of bound");
+            return ProblemPtr();
+          }
+        }
+        break;
+      case MpsQTri:
+      case MpsQFull:
+      case MpsQCon:
+        if (l.nf<3) {
+          error_(l, "bad quadratic entry");
+          return ProblemPtr();
+        }
+        r = cols.find(l.f[0], l.len[0]);
+        c = cols.find(l.f[1], l.len[1]);
+        if (r<0 || c<0 || !mpsNum(l.f[2], l.len[2], &d)) {
+          error_(l, "unknown column or bad number");
+          return ProblemPtr();
+        }
+        d2 = (MpsQCon==sec) ? d : (MpsQFull==sec || r==c) ? 0.5*d : d;
+        qr.push_back(qrow);
+        qi.push_back(r);
+        qj.push_back(c);
+        qv.push_back(d2);
+        break;
+      case MpsNone:
+        error_(l, "data before a section");
+        return ProblemPtr();
+      default:
+        break;
+      }
+    }
+  }
+
+  if (rhs.empty()) {
+    rhs.resize(rtype.size(), 0.0);
+    range.resize(rtype.size(), 0.0);
+    has_range.resize(rtype.size(), false);
+  }
+  nnz_ = ev.size();
+  nQnz_ = qv.size();
+
+  p = (ProblemPtr) new Problem();
+  for (UInt j=0; j<cols.getSize(); ++j) {
+    VariableType vtype = Continuous;
+    if (is_int[j]) {
+      if (!has_bnd[j]) {
+        ub[j] = 1.0;
+      }
+      vtype = (lb[j]>=0.0 && ub[j]<=1.0) ? Binary : Integer;
+    }
+    vars.push_back(p->newVariable(lb[j], ub[j], vtype, cols.get(j)));
+  }
+
+  // entries of each row are in the order of the columns.
+  rbeg.assign(rtype.size()+1, 0);
+  for (UInt k=0; k<er.size(); ++k) {
+    ++rbeg[er[k]+1];
+  }
+  for (UInt i=0; i<rtype.size(); ++i) {
+    rbeg[i+1] += rbeg[i];
+  }
+  {
+    UIntVector pos(rbeg.begin(), rbeg.end()-1);
+    UIntVector ec2(ec.size());
+    DoubleVector ev2(ev.size());
+    for (UInt k=0; k<er.size(); ++k) {
+      ec2[pos[er[k]]] = ec[k];
+      ev2[pos[er[k]]] = ev[k];
+      ++pos[er[k]];
+    }
+    ec.swap(ec2);
+    ev.swap(ev2);
+    er.clear();
+  }
+
+  lfs.resize(rtype.size());
+#if USE_OPENMP
+#pragma omp parallel for num_threads(nThreads_) schedule(dynamic, 256)
+#endif
+  for (int i=0; i<(int) rtype.size(); ++i) {
+    LinearFunctionPtr lf = (LinearFunctionPtr) new LinearFunction();
+    for (UInt k=rbeg[i]; k<rbeg[i+1]; ++k) {
+      lf->appendTerm(vars[ec[k]], ev[k]);
+    }
+    lfs[i] = lf;
+  }
+
+  qfs.resize(rtype.size());
+  for (UInt k=0; k<qr.size(); ++k) {
+    if (!qfs[qr[k]]) {
+      qfs[qr[k]] = (QuadraticFunctionPtr) new QuadraticFunction();
+    }
+    qfs[qr[k]]->incTerm(vars[qi[k]], vars[qj[k]], qv[k]);
+  }
+
+  for (UInt i=0; i<rtype.size(); ++i) {
+    double l = -INFINITY, u = INFINITY;
+    if ('N'==rtype[i] || 'X'==rtype[i]) {
+      continue;
+    }
+    if ('E'==rtype[i]) {
+      l = u = rhs[i];
+      if (has_range[i] && range[i]>0.0) {
+        u = rhs[i]+range[i];
+      } else if (has_range[i]) {
+        l = rhs[i]+range[i];
+      }
+    } else if ('L'==rtype[i]) {
+      u = rhs[i];
+      if (has_range[i]) {
+        l = rhs[i]-fabs(range[i]);
+      }
+    } else {
+      l = rhs[i];
+      if (has_range[i]) {
+        u = rhs[i]+fabs(range[i]);
+      }
+    }
+    p->newConstraint((FunctionPtr) new Function(lfs[i], qfs[i]), l, u,
+                     rows.get(i));
+  }
+
+  if (obj>=0) {
+    p->newObjective((FunctionPtr) new Function(lfs[obj], qfs[obj]), objc,
+                    (maximize) ? Maximize : Minimize, rows.get(obj));
+  }
+  return p;
+}
+
+
+void MpsReader::error_(const MpsLine &line, const char *msg)
+{
+  logger_->errStream() << me_ << msg << ": ";
+  if (line.nf>0) {
+    logger_->errStream() << std::string(line.f[0], line.f[line.nf-1] +
+                                        line.len[line.nf-1]);
+  }
+  logger_->errStream() << std::endl;
+}
+
+
+ProblemPtr MpsReader::readInstance(std::string fname)
+{
+  int fd;
+  struct stat st;
+  char *buf;
+  const char *end;
+  bool mapped = true;
+  ProblemPtr p;
+  Timer *timer = env_->getNewTimer();
+  std::vector<const char *> cuts;
+  std::vector<std::vector<MpsLine> > chunks;
+
+  timer->start();
+  fd = open(fname.c_str(), O_RDONLY);
+  if (fd<0 || 0!=fstat(fd, &st) || st.st_size<=0) {
+    logger_->errStream() << me_ << "can not read file " << fname
+                         << std::endl;
+    if (fd>=0) {
+      close(fd);
+    }
+    delete timer;
+    return ProblemPtr();
+  }
+
+  // map the file into memory, or read it all if it can not be mapped.
+  buf = (char *) mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  if (MAP_FAILED==buf) {
+    mapped = false;
+    buf = new char[st.st_size];
+    if (read(fd, buf, st.st_size)!=st.st_size) {
+      logger_->errStream() << me_ << "can not read file " << fname
+                           << std::endl;
+      delete [] buf;
+      close(fd);
+      delete timer;
+      return ProblemPtr();
+    }
+  } else {
+    madvise(buf, st.st_size, MADV_SEQUENTIAL);
+  }
+  end = buf+st.st_size;
+
+  // split the file into one chunk of whole lines for each thread.
+  cuts.push_back(buf);
+  for (int t=1; t<nThreads_; ++t) {
+    const char *c = buf + (size_t) st.st_size*t/nThreads_;
+    if (c<cuts.back()) {
+      c = cuts.back();
+    }
+    c = (const char *) memchr(c, '\n', end-c);
+    c = (c) ? c+1 : end;
+    cuts.push_back(c);
+  }
+  cuts.push_back(end);
+  chunks.resize(nThreads_);
+
+#if USE_OPENMP
+#pragma omp parallel for num_threads(nThreads_) schedule(static, 1)
+#endif
+  for (int t=0; t<nThreads_; ++t) {
+    tokenize_(cuts[t], cuts[t+1], &(chunks[t]));
+  }
+
+  p = build_(chunks);
+
+  if (mapped) {
+    munmap(buf, st.st_size);
+  } else {
+    delete [] buf;
+  }
+  close(fd);
+  time_ = timer->query();
+  delete timer;
+  if (p) {
+    logger_->msgStream(LogInfo) << me_ << "read " << p->getNumVars()
+                                << " variables and " << p->getNumCons()
+                                << " constraints in " << time_
+                                << " seconds." << std::endl;
+  }
+  return p;
+}
+
+
+void MpsReader::setFixedFormat(bool fixed)
+{
+  fixed_ = fixed;
+}
+
+
+void MpsReader::split_(const char *beg, const char *end, MpsLine *line) const
+{
+  // columns of the fields in the fixed format.
+  static const UInt fbeg[6] = {1, 4, 14, 24, 39, 49};
+  static const UInt fend[6] = {3, 12, 22, 36, 47, 61};
+  const char *s, *e;
+
+  line->nf = 0;
+  if (fixed_ && !line->head) {
+    for (UInt k=0; k<6 && beg+fbeg[k]<end; ++k) {
+      s = beg+fbeg[k];
+      e = (beg+fend[k]<end) ? beg+fend[k] : end;
+      while (s<e && isspace(*s)) {
+        ++s;
+      }
+      while (e>s && isspace(*(e-1))) {
+        --e;
+      }
+      if (e>s) {
+        line->f[line->nf] = s;
+        line->len[line->nf] = e-s;
+        ++(line->nf);
+      }
+    }
+    return;
+  }
+
+  s = beg;
+  while (line->nf<6) {
+    while (s<end && isspace(*s)) {
+      ++s;
+    }
+    if (s==end) {
+      break;
+    }
+    e = s;
+    while (e<end && !isspace(*e)) {
+      ++e;
+    }
+    line->f[line->nf] = s;
+    line->len[line->nf] = e-s;
+    ++(line->nf);
+    s = e;
+  }
+}
+
+
+void MpsReader::tokenize_(const char *beg, const char *end,
+                          std::vector<MpsLine> *lines) const
+{
+  const char *le;
+  MpsLine line;
+
+  lines->reserve((end-beg)/40+1);
+  while (beg<end) {
+    le = (const char *) memchr(beg, '\n', end-beg);
+    if (!le) {
+      le = end;
+    }
+    if ('*'!=*beg) {
+      line.head = !isspace(*beg);
+      split_(beg, le, &line);
+      if (line.nf>0) {
+        lines->push_back(line);
+      }
+    }
+    beg = le+1;
+  }
+}
+
+
+void MpsReader::writeStats(std::ostream &out) const
+{
+  out << me_ << "time used in reading = " << time_ << std::endl
+      << me_ << "nonzeros in linear parts = " << nnz_ << std::endl
+      << me_ << "nonzeros in quadratic parts = " << nQnz_ << std::endl
+      << me_ << "threads used = " << nThreads_ << std::endl;
+}
+
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
@@ -0,0 +1,177 @@
+//
+//     MINOTAUR -- It's only 1/2 bull
+//
+//     (C)opyright 2008 - 2014 The MINOTAUR Team.
+//
+
+/**
+ * \file MpsReader.h
+ * \brief Declare the MpsReader class that reads a linear or quadratic
+ * problem from an MPS file.
+ * \author Ashutosh Mahajan, IIT Bombay
+ */
+
+#ifndef MINOTAURMPSREADER_H
+#define MINOTAURMPSREADER_H
+
+#include <string>
+
+#include "Types.h"
+
+namespace Minotaur {
+
+  class Logger;
+  class Problem;
+  typedef boost::shared_ptr<Logger> LoggerPtr;
+  typedef boost::shared_ptr<Problem> ProblemPtr;
+
+  /**
+   * \brief A table of the names of rows or columns of an MPS file. A name
+   * is a pointer into the buffer of the file and a length, so that the
+   * buffer must stay in memory while the table is used.
+   */
+  class MpsNames {
+    public:
+      /// Constructor.
+      MpsNames();
+
+      /**
+       * \brief Add a name. Return its index, or the index of the same name
+       * added earlier.
+       */
+      UInt add(const char *s, UInt len, bool *isnew);
+
+      /// Return the index of a name, or -1 if it was not added.
+      int find(const char *s, UInt len) const;
+
+      /// Return the i-th name as a string.
+      std::string get(UInt i) const;
+
+      /// Return the number of names.
+      UInt getSize() const { return beg_.size(); };
+
+    private:
+      /// Start of each name.
+      std::vector<const char *> beg_;
+
+      /// Length of each name.
+      UIntVector len_;
+
+      /// Open hash table of indices plus one. Zero if empty.
+      UIntVector slots_;
+
+      /// Hash of a name.
+      UInt hash_(const char *s, UInt len) const;
+
+      /// Double the size of the hash table.
+      void grow_();
+  };
+
+
+  /**
+   * \brief Read a linear or quadratic problem with continuous and integer
+   * variables from a file in the free or the fixed MPS format.
+   *
+   * The file is mapped into memory and split into chunks of lines that are
+   * tokenized in parallel when Minotaur is built with OpenMP. The sections
+   * are then read in order. Coefficients of the matrix are kept in flat
+   * arrays and sorted by rows, and each row becomes a LinearFunction whose
+   * terms are appended in the order of the variables, again in parallel.
+   *
+   * Besides NAME, OBJSENSE, ROWS, COLUMNS (with integer MARKER lines), RHS,
+   * RANGES, BOUNDS and ENDATA, the quadratic sections QUADOBJ and QSECTION
+   * (one triangle of Q, objective 1/2 x'Qx), QMATRIX (full Q, objective
+   * 1/2 x'Qx) and QCMATRIX (full Q of a constraint, x'Qx) are read. Only
+   * the first N row is the objective; other N rows are dropped. Only the
+   * first set of RHS, RANGES and BOUNDS is used. Integer variables without
+   * bounds are binary, as in most readers. Semi-continuous bounds (SC) and
+   * SOS sections are not supported.
+   *
+   * In the free format, fields are separated by white space and names can
+   * not contain spaces. In the fixed format, fields are read from the
+   * standard columns. In both, a line that starts with a character other
+   * than a space starts a section and a line that starts with '*' is a
+   * comment.
+   */
+  class MpsReader {
+    public:
+      /// Constructor.
+      MpsReader(EnvPtr env);
+
+      /// Destroy.
+      ~MpsReader();
+
+      /**
+       * \brief Read a problem from file fname.
+       *
+       * \return The problem, or NULL if the file can not be read or has
+       * something that is not supported.
+       */
+      ProblemPtr readInstance(std::string fname);
+
+      /// Read files in the fixed MPS format if fixed is true.
+      void setFixedFormat(bool fixed);
+
+      /// Write statistics about the last file read.
+      void writeStats(std::ostream &out) const;
+
+    private:
+      /// Fields of a line of the file.
+      struct MpsLine {
+        const char *f[6];  /// Start of each field.
+        UInt len[6];       /// Length of each field.
+        UInt nf;           /// Number of fields.
+        bool head;         /// True if the line starts a section.
+      };
+
+      /// Environment.
+      EnvPtr env_;
+
+      /// True if files are in the fixed format.
+      bool fixed_;
+
+      /// Log.
+      LoggerPtr logger_;
+
+      /// For logging.
+      static const std::string me_;
+
+      /// Number of nonzeros in the linear part of the last file read.
+      size_t nnz_;
+
+      /// Number of nonzeros in the quadratic parts of the last file read.
+      size_t nQnz_;
+
+      /// Number of threads used for tokenizing and building functions.
+      int nThreads_;
+
+      /// Time taken to read the last file.
+      double time_;
+
+      /// Read the problem from the lines of the file.
+      ProblemPtr build_(const std::vector<std::vector<MpsLine> > &chunks);
+
+      /// Report an error on a line.
+      void error_(const MpsLine &line, const char *msg);
+
+      /// Split the line in [beg, end) into fields.
+      void split_(const char *beg, const char *end, MpsLine *line) const;
+
+      /// Tokenize the lines that start in [beg, end).
+      void tokenize_(const char *beg, const char *end,
+                     std::vector<MpsLine> *lines) const;
+  };
+  typedef boost::shared_ptr<MpsReader> MpsReaderPtr;
+}
+#endif
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
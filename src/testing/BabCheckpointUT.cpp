@@ -0,0 +1,228 @@
+//
+//    MINOTAUR -- It's only 1/2 bull
+//
+//    (C)opyright 2009 - 2014 The MINOTAUR Team.
+//
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+
+#include "MinotaurConfig.h"
+#include "BabCheckpoint.h"
+#include "BabCheckpointUT.h"
+#include "Branch.h"
+#include "Constraint.h"
+#include "Function.h"
+#include "Handler.h"
+#include "LinearFunction.h"
+#include "Node.h"
+#include "Option.h"
+#include "Relaxation.h"
+#include "ReliabilityBrancher.h"
+#include "Solution.h"
+#include "VarBoundMod.h"
+#include "Variable.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(BabCheckpointUT);
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(BabCheckpointUT, "BabCheckpointUT");
+
+using namespace Minotaur;
+
+
+void BabCheckpointUT::setUp()
+{
+  LinearFunctionPtr lf = (LinearFunctionPtr) new LinearFunction();
+  VariablePtr x0, x1, x2;
+
+  env_ = (EnvPtr) new Environment();
+  p_ = (ProblemPtr) new Problem();
+  x0 = p_->newVariable(0.0, 1.0, Binary, "x0");
+  x1 = p_->newVariable(0.0, 4.0, Integer, "x1");
+  x2 = p_->newVariable(-1.0, 1.0, Continuous, "x2");
+
+  // x0 + x1 + x2 <= 4.
+  lf->addTerm(x0, 1.0);
+  lf->addTerm(x1, 1.0);
+  lf->addTerm(x2, 1.0);
+  p_->newConstraint((FunctionPtr) new Function(lf), -INFINITY, 4.0, "c0");
+
+  // min x2 - x1.
+  lf = (LinearFunctionPtr) new LinearFunction();
+  lf->addTerm(x1, -1.0);
+  lf->addTerm(x2, 1.0);
+  p_->newObjective((FunctionPtr) new Function(lf), 0.0, Minimize, "obj");
+}
+
+
+void BabCheckpointUT::tearDown()
+{
+  p_.reset();
+  env_.reset();
+}
+
+
+void BabCheckpointUT::testRoundTrip()
+{
+  RelaxationPtr rel = (RelaxationPtr) new Relaxation(p_);
+  RelaxationPtr rel2;
+  BabCheckpointPtr ckpt;
+  LinearFunctionPtr lf = (LinearFunctionPtr) new LinearFunction();
+  NodePtr root = (NodePtr) new Node();
+  NodePtr n1, n2, n3, root2;
+  NodePtrVector nodes;
+  BranchPtr br = (BranchPtr) new Branch();
+  double x[3] = {1.0, 2.0, 0.5};
+  SolutionPtr sol = (SolutionPtr) new Solution(3.5, x, p_);
+
+  env_->getOptions()->findString("bnb_checkpoint_file")
+    ->setValue("ckptUT.ckpt");
+  env_->getOptions()->findString("bnb_resume_file")
+    ->setValue("ckptUT.ckpt");
+  ckpt = (BabCheckpointPtr) new BabCheckpoint(env_, p_);
+  CPPUNIT_ASSERT(ckpt->isOn());
+  CPPUNIT_ASSERT(ckpt->isDue(1e10));
+
+  // the root tightens x2 in the problem, then a cut is added.
+  p_->changeBound(p_->getVariable(2), Lower, 0.0);
+  ckpt->setRoot(rel);
+  lf->addTerm(rel->getVariable(1), 1.0);
+  lf->addTerm(rel->getVariable(2), -1.0);
+  rel->newConstraint((FunctionPtr) new Function(lf), -INFINITY, 3.0);
+
+  // n1: x0 <= 0 by branching, n2: child of n1 with x1 >= 2 and x1 >= 3,
+  // n3: x0 >= 1 by branching with x1 <= 1 in the problem.
+  br->addRMod((ModificationPtr) new VarBoundMod(rel->getVariable(0), Upper,
+                                                0.0));
+  n1 = (NodePtr) new Node(root, br);
+  n1->setLb(1.0);
+  n1->setDepth(1);
+  n1->addRMod((ModificationPtr) new VarBoundMod(rel->getVariable(1), Lower,
+                                                2.0));
+  n2 = (NodePtr) new Node(n1, BranchPtr());
+  n2->setLb(1.5);
+  n2->setDepth(2);
+  n2->setTbScore(7.0);
+  n2->addRMod((ModificationPtr) new VarBoundMod2(rel->getVariable(1), 3.0,
+                                                 4.0));
+  br = (BranchPtr) new Branch();
+  br->addRMod((ModificationPtr) new VarBoundMod(rel->getVariable(0), Lower,
+                                                1.0));
+  br->addPMod((ModificationPtr) new VarBoundMod(p_->getVariable(1), Upper,
+                                                1.0));
+  n3 = (NodePtr) new Node(root, br);
+  n3->setLb(2.0);
+  n3->setDepth(1);
+  nodes.push_back(n2);
+  nodes.push_back(n3);
+  CPPUNIT_ASSERT(true==ckpt->write(nodes, rel, sol, BrancherPtr(), 17, 1,
+                                   2.0));
+  CPPUNIT_ASSERT(!ckpt->isDue(2.5));
+
+  // resume in a fresh problem.
+  p_->changeBound(p_->getVariable(2), Lower, -1.0);
+  ckpt = (BabCheckpointPtr) new BabCheckpoint(env_, p_);
+  CPPUNIT_ASSERT(ckpt->shouldResume());
+  CPPUNIT_ASSERT(true==ckpt->read());
+  CPPUNIT_ASSERT(17==ckpt->getNodesProc());
+  CPPUNIT_ASSERT(1==ckpt->getRestarts());
+  CPPUNIT_ASSERT(fabs(ckpt->getTime()-2.0)<1e-12);
+  CPPUNIT_ASSERT(ckpt->getIncumbent());
+  CPPUNIT_ASSERT(fabs(ckpt->getIncumbent()[2]-0.5)<1e-12);
+  CPPUNIT_ASSERT(fabs(ckpt->getIncumbentValue()-3.5)<1e-12);
+  CPPUNIT_ASSERT(ckpt->getBrancherState().empty());
+
+  ckpt->restoreBounds(RelaxationPtr());
+  CPPUNIT_ASSERT(fabs(p_->getVariable(2)->getLb())<1e-12);
+  rel2 = (RelaxationPtr) new Relaxation(p_);
+  ckpt->addCuts(rel2);
+  CPPUNIT_ASSERT(2==rel2->getNumCons());
+
+  nodes.clear();
+  root2 = (NodePtr) new Node();
+  ckpt->getNodes(root2, rel2, &nodes);
+  CPPUNIT_ASSERT(2==nodes.size());
+  CPPUNIT_ASSERT(2==root2->getNumChildren());
+  CPPUNIT_ASSERT(fabs(nodes[0]->getLb()-1.5)<1e-12);
+  CPPUNIT_ASSERT(2==nodes[0]->getDepth());
+  CPPUNIT_ASSERT(fabs(nodes[0]->getTbScore()-7.0)<1e-12);
+  CPPUNIT_ASSERT(nodes[0]->getParent()==root2);
+
+  // only the last change of each bound is kept.
+  nodes[0]->applyRMods(rel2);
+  CPPUNIT_ASSERT(fabs(rel2->getVariable(0)->getUb())<1e-12);
+  CPPUNIT_ASSERT(fabs(rel2->getVariable(1)->getLb()-3.0)<1e-12);
+  CPPUNIT_ASSERT(fabs(rel2->getVariable(1)->getUb()-4.0)<1e-12);
+  nodes[0]->undoRMods(rel2);
+  CPPUNIT_ASSERT(fabs(rel2->getVariable(0)->getUb()-1.0)<1e-12);
+  CPPUNIT_ASSERT(fabs(rel2->getVariable(1)->getLb())<1e-12);
+
+  nodes[1]->applyPMods(p_);
+  CPPUNIT_ASSERT(fabs(p_->getVariable(1)->getUb()-1.0)<1e-12);
+  nodes[1]->undoPMods(p_);
+  CPPUNIT_ASSERT(fabs(p_->getVariable(1)->getUb()-4.0)<1e-12);
+
+  root2->removeChildren();
+  remove("ckptUT.ckpt");
+}
+
+
+void BabCheckpointUT::testBrancherState()
+{
+  RelaxationPtr rel = (RelaxationPtr) new Relaxation(p_);
+  HandlerVector handlers;
+  ReliabilityBrancherPtr br1, br2;
+  DoubleVector s1, s2;
+
+  br1 = (ReliabilityBrancherPtr) new ReliabilityBrancher(env_, handlers);
+  br2 = (ReliabilityBrancherPtr) new ReliabilityBrancher(env_, handlers);
+  br1->saveState(&s1);
+  CPPUNIT_ASSERT(s1.empty());
+
+  br1->initialize(rel);
+  br1->saveState(&s1);
+  CPPUNIT_ASSERT(13==s1.size());
+  CPPUNIT_ASSERT(true==br2->loadState(s1));
+  br2->saveState(&s2);
+  CPPUNIT_ASSERT(s1==s2);
+
+  s1.pop_back();
+  CPPUNIT_ASSERT(false==br2->loadState(s1));
+}
+
+
+void BabCheckpointUT::testBadFile()
+{
+  BabCheckpointPtr ckpt;
+  std::ofstream out;
+
+  ckpt = (BabCheckpointPtr) new BabCheckpoint(env_, p_);
+  CPPUNIT_ASSERT(!ckpt->isOn());
+  CPPUNIT_ASSERT(!ckpt->isDue(1e10));
+  CPPUNIT_ASSERT(!ckpt->read());
+
+  env_->getOptions()->findString("bnb_resume_file")
+    ->setValue("ckptUT.missing");
+  ckpt = (BabCheckpointPtr) new BabCheckpoint(env_, p_);
+  CPPUNIT_ASSERT(!ckpt->read());
+
+  out.open("ckptUT.bad", std::ios::binary);
+  out << "MNTRCKPT but not a checkpoint";
+  out.close();
+  env_->getOptions()->findString("bnb_resume_file")->setValue("ckptUT.bad");
+  ckpt = (BabCheckpointPtr) new BabCheckpoint(env_, p_);
+  CPPUNIT_ASSERT(!ckpt->read());
+  remove("ckptUT.bad");
+}
+
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
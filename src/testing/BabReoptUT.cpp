@@ -0,0 +1,249 @@
+//
+//    MINOTAUR -- It's only 1/2 bull
+//
+//    (C)opyright 2009 - 2014 The MINOTAUR Team.
+//
+
+#include <cmath>
+
+#include "MinotaurConfig.h"
+#include "BabReopt.h"
+#include "BabReoptUT.h"
+#include "Branch.h"
+#include "ConflictAnalyzer.h"
+#include "ConflictPool.h"
+#include "Constraint.h"
+#include "Function.h"
+#include "LinearFunction.h"
+#include "Node.h"
+#include "Option.h"
+#include "Relaxation.h"
+#include "Solution.h"
+#include "VarBoundMod.h"
+#include "Variable.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(BabReoptUT);
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(BabReoptUT, "BabReoptUT");
+
+using namespace Minotaur;
+
+
+void BabReoptUT::setUp()
+{
+  LinearFunctionPtr lf = (LinearFunctionPtr) new LinearFunction();
+  VariablePtr x0, x1, x2;
+
+  env_ = (EnvPtr) new Environment();
+  env_->getOptions()->findBool("bnb_reopt")->setValue(true);
+  p_ = (ProblemPtr) new Problem();
+  x0 = p_->newVariable(0.0, 1.0, Binary, "x0");
+  x1 = p_->newVariable(0.0, 4.0, Integer, "x1");
+  x2 = p_->newVariable(-1.0, 1.0, Continuous, "x2");
+
+  // x0 + x1 + x2 <= 4.
+  lf->addTerm(x0, 1.0);
+  lf->addTerm(x1, 1.0);
+  lf->addTerm(x2, 1.0);
+  p_->newConstraint((FunctionPtr) new Function(lf), -INFINITY, 4.0, "c0");
+
+  // min x2 - x1.
+  lf = (LinearFunctionPtr) new LinearFunction();
+  lf->addTerm(x1, -1.0);
+  lf->addTerm(x2, 1.0);
+  p_->newObjective((FunctionPtr) new Function(lf), 0.0, Minimize, "obj");
+}
+
+
+void BabReoptUT::tearDown()
+{
+  p_.reset();
+  env_.reset();
+}
+
+
+void BabReoptUT::testReuseTree()
+{
+  RelaxationPtr rel = (RelaxationPtr) new Relaxation(p_);
+  RelaxationPtr rel2;
+  BabReoptPtr reopt = (BabReoptPtr) new BabReopt(env_, p_);
+  LinearFunctionPtr lf = (LinearFunctionPtr) new LinearFunction();
+  NodePtr root = (NodePtr) new Node();
+  NodePtr n1, n2, n3, n4, root2;
+  NodePtrVector nodes;
+  BranchPtr br = (BranchPtr) new Branch();
+  double x[3] = {1.0, 3.0, 0.0};
+  SolutionPtr sol = (SolutionPtr) new Solution(-3.0, x, p_);
+
+  CPPUNIT_ASSERT(reopt->isOn());
+  CPPUNIT_ASSERT(false==reopt->checkChanges());
+  CPPUNIT_ASSERT(!reopt->canReuseTree());
+
+  // two cuts: x1 - x2 <= 3 and x1 <= 2. The second cuts off the incumbent.
+  reopt->setRoot(rel);
+  lf->addTerm(rel->getVariable(1), 1.0);
+  lf->addTerm(rel->getVariable(2), -1.0);
+  rel->newConstraint((FunctionPtr) new Function(lf), -INFINITY, 3.0);
+  lf = (LinearFunctionPtr) new LinearFunction();
+  lf->addTerm(rel->getVariable(1), 1.0);
+  rel->newConstraint((FunctionPtr) new Function(lf), -INFINITY, 2.0);
+
+  // n1: x0 <= 0, infeasible. n2: x0 >= 1 and x1 <= 3 in the problem.
+  // n3: child of n2 with x1 >= 2, open. n4: child of n2 with x1 <= 1,
+  // pruned by bound. Changes made in nodes are not kept.
+  br->addRMod((ModificationPtr) new VarBoundMod(rel->getVariable(0), Upper,
+                                                0.0));
+  n1 = (NodePtr) new Node(root, br);
+  n1->setStatus(NodeInfeasible);
+  reopt->addLeaf(n1);
+  br = (BranchPtr) new Branch();
+  br->addRMod((ModificationPtr) new VarBoundMod(rel->getVariable(0), Lower,
+                                                1.0));
+  br->addPMod((ModificationPtr) new VarBoundMod(p_->getVariable(1), Upper,
+                                                3.0));
+  n2 = (NodePtr) new Node(root, br);
+  n2->setDepth(1);
+  br = (BranchPtr) new Branch();
+  br->addRMod((ModificationPtr) new VarBoundMod(rel->getVariable(1), Upper,
+                                                1.0));
+  n4 = (NodePtr) new Node(n2, br);
+  n4->setLb(-1.0);
+  n4->setDepth(2);
+  n4->setStatus(NodeHitUb);
+  reopt->addLeaf(n4);
+  br = (BranchPtr) new Branch();
+  br->addRMod((ModificationPtr) new VarBoundMod(rel->getVariable(1), Lower,
+                                                2.0));
+  n3 = (NodePtr) new Node(n2, br);
+  n3->setLb(-2.5);
+  n3->setDepth(2);
+  n3->addRMod((ModificationPtr) new VarBoundMod(rel->getVariable(2), Upper,
+                                                0.0));
+  nodes.push_back(n3);
+  reopt->finish(nodes, rel, sol);
+
+  // the problem is only restricted.
+  p_->changeBound(p_->getVariable(1), Upper, 3.0);
+  CPPUNIT_ASSERT(true==reopt->checkChanges());
+  CPPUNIT_ASSERT(reopt->canReuseTree());
+  CPPUNIT_ASSERT(reopt->getIncumbent());
+  CPPUNIT_ASSERT(fabs(reopt->getIncumbentValue()+3.0)<1e-12);
+
+  rel2 = (RelaxationPtr) new Relaxation(p_);
+  reopt->setRoot(rel2);
+  reopt->addCuts(rel2);
+  CPPUNIT_ASSERT(2==rel2->getNumCons());
+
+  // the infeasible leaf is dropped because the incumbent is still valid.
+  nodes.clear();
+  root2 = (NodePtr) new Node();
+  reopt->getNodes(root2, rel2, &nodes);
+  CPPUNIT_ASSERT(2==nodes.size());
+  CPPUNIT_ASSERT(!reopt->canReuseTree());
+  CPPUNIT_ASSERT(fabs(nodes[0]->getLb()+1.0)<1e-12);
+  CPPUNIT_ASSERT(fabs(nodes[1]->getLb()+2.5)<1e-12);
+  CPPUNIT_ASSERT(2==nodes[1]->getDepth());
+  CPPUNIT_ASSERT(nodes[1]->getParent()==root2);
+
+  nodes[1]->applyRMods(rel2);
+  CPPUNIT_ASSERT(fabs(rel2->getVariable(0)->getLb()-1.0)<1e-12);
+  CPPUNIT_ASSERT(fabs(rel2->getVariable(1)->getLb()-2.0)<1e-12);
+  CPPUNIT_ASSERT(fabs(rel2->getVariable(2)->getUb()-1.0)<1e-12);
+  nodes[1]->undoRMods(rel2);
+  CPPUNIT_ASSERT(fabs(rel2->getVariable(0)->getLb())<1e-12);
+
+  root2->removeChildren();
+}
+
+
+void BabReoptUT::testChanges()
+{
+  RelaxationPtr rel = (RelaxationPtr) new Relaxation(p_);
+  BabReoptPtr reopt = (BabReoptPtr) new BabReopt(env_, p_);
+  LinearFunctionPtr lf = (LinearFunctionPtr) new LinearFunction();
+  NodePtr root = (NodePtr) new Node();
+  NodePtr n1 = (NodePtr) new Node(root, BranchPtr());
+  NodePtrVector nodes;
+  double x[3] = {1.0, 3.0, 0.0};
+  SolutionPtr sol = (SolutionPtr) new Solution(-3.0, x, p_);
+
+  reopt->setRoot(rel);
+  n1->setLb(5.0);
+  n1->setStatus(NodeInfeasible);
+  reopt->addLeaf(n1);
+  reopt->finish(nodes, rel, sol);
+
+  // min x1 + 1. The incumbent is evaluated again and bounds are not kept.
+  lf->addTerm(p_->getVariable(1), 1.0);
+  p_->changeObj((FunctionPtr) new Function(lf), 1.0);
+  CPPUNIT_ASSERT(true==reopt->checkChanges());
+  CPPUNIT_ASSERT(reopt->canReuseTree());
+  CPPUNIT_ASSERT(reopt->getIncumbent());
+  CPPUNIT_ASSERT(fabs(reopt->getIncumbentValue()-4.0)<1e-12);
+  reopt->getNodes(root, rel, &nodes);
+  CPPUNIT_ASSERT(1==nodes.size());
+  CPPUNIT_ASSERT(-INFINITY==nodes[0]->getLb());
+  root->removeChildren();
+
+  // the incumbent becomes infeasible.
+  nodes.clear();
+  reopt->finish(nodes, rel, sol);
+  p_->changeBound(p_->getConstraint(0), Upper, 3.5);
+  CPPUNIT_ASSERT(true==reopt->checkChanges());
+  CPPUNIT_ASSERT(!reopt->getIncumbent());
+
+  // relaxing a bound discards everything.
+  reopt->addLeaf(n1);
+  reopt->finish(nodes, rel, sol);
+  p_->changeBound(p_->getVariable(2), Lower, -2.0);
+  CPPUNIT_ASSERT(true==reopt->checkChanges());
+  CPPUNIT_ASSERT(!reopt->canReuseTree());
+}
+
+
+void BabReoptUT::testConflicts()
+{
+  RelaxationPtr rel = (RelaxationPtr) new Relaxation(p_);
+  BabReoptPtr reopt = (BabReoptPtr) new BabReopt(env_, p_);
+  ConflictAnalyzer analyzer(env_);
+  std::vector<ConflictLit> lits(2);
+  NodePtrVector nodes;
+  double x[3] = {1.0, 3.0, 0.0};
+  SolutionPtr sol = (SolutionPtr) new Solution(-3.0, x, p_);
+
+  // x1 >= 4 and x2 >= 1 violate x0 + x1 + x2 <= 4.
+  lits[0].j = 1;
+  lits[0].lu = Lower;
+  lits[0].val = 4.0;
+  lits[1].j = 2;
+  lits[1].lu = Lower;
+  lits[1].val = 1.0;
+  CPPUNIT_ASSERT(analyzer.getPool()->addConflict(lits));
+
+  // the second solve is restricted, conflicts are kept.
+  reopt->setRoot(rel);
+  reopt->finish(nodes, rel, sol);
+  p_->changeBound(p_->getVariable(1), Upper, 3.0);
+  CPPUNIT_ASSERT(true==reopt->checkChanges());
+  CPPUNIT_ASSERT(true==reopt->keepsConflicts());
+
+  // the third solve has x0 + x1 + x2 <= 5, and the conflict is not valid.
+  reopt->finish(nodes, rel, sol);
+  p_->changeBound(p_->getConstraint(0), Upper, 5.0);
+  CPPUNIT_ASSERT(true==reopt->checkChanges());
+  CPPUNIT_ASSERT(false==reopt->keepsConflicts());
+  analyzer.clear();
+  CPPUNIT_ASSERT(0==analyzer.getPool()->getNumActive());
+  CPPUNIT_ASSERT(0==analyzer.getPool()->getNumConflicts());
+}
+
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
@@ -0,0 +1,58 @@
+// 
+//     MINOTAUR -- It's only 1/2 bull
+// 
+//     (C)opyright 2009 - 2014 The MINOTAUR Team.
+// 
+
+#ifndef BABREOPTUT_H
+#define BABREOPTUT_H
+
+#include <string>
+
+#include <cppunit/TestCase.h>
+#include <cppunit/TestCaller.h>
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <Environment.h>
+#include <Problem.h>
+
+using namespace Minotaur;
+
+class BabReoptUT : public CppUnit::TestCase {
+
+public:
+  BabReoptUT(std::string name) : TestCase(name) {}
+  BabReoptUT() {}
+
+  void setUp();
+  void tearDown();
+
+  CPPUNIT_TEST_SUITE(BabReoptUT);
+  CPPUNIT_TEST(testReuseTree);
+  CPPUNIT_TEST(testChanges);
+  CPPUNIT_TEST(testConflicts);
+  CPPUNIT_TEST_SUITE_END();
+
+  void testReuseTree();
+  void testChanges();
+  void testConflicts();
+
+private:
+  EnvPtr env_;
+  ProblemPtr p_;
+};
+
+#endif
+
+// Local Variables: 
+// mode: c++ 
+// eval: (c-set-style "k&r") 
+// eval: (c-set-offset 'innamespace 0) 
+// eval: (setq c-basic-offset 2) 
+// eval: (setq fill-column 78) 
+// eval: (auto-fill-mode 1) 
+// eval: (setq column-number-mode 1) 
+// eval: (setq indent-tabs-mode nil) 
+// End:
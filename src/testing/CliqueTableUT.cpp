@@ -0,0 +1,251 @@
+// 
+//    MINOTAUR -- It's only 1/2 bull
+// 
+//    (C)opyright 2009 - 2014 The MINOTAUR Team.
+// 
+
+#include <cmath>
+
+#include "MinotaurConfig.h"
+#include "CliquePropagator.h"
+#include "CliqueTable.h"
+#include "CliqueTableUT.h"
+#include "Constraint.h"
+#include "Function.h"
+#include "LinearFunction.h"
+#include "PropEngine.h"
+#include "Relaxation.h"
+#include "Variable.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(CliqueTableUT);
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(CliqueTableUT, "CliqueTableUT");
+
+using namespace Minotaur;
+
+
+void CliqueTableUT::setUp()
+{
+  p_ = (ProblemPtr) new Problem();
+  for (UInt i=0; i<4; ++i) {
+    vars_.push_back(p_->newVariable(0.0, 1.0, Binary));
+  }
+}
+
+
+void CliqueTableUT::tearDown()
+{
+  vars_.clear();
+  p_.reset();
+}
+
+
+void CliqueTableUT::addCons_(const double *a, double lb, double ub)
+{
+  LinearFunctionPtr lf = (LinearFunctionPtr) new LinearFunction();
+
+  for (UInt i=0; i<vars_.size(); ++i) {
+    if (a[i] != 0.0) {
+      lf->addTerm(vars_[i], a[i]);
+    }
+  }
+  p_->newConstraint((FunctionPtr) new Function(lf), lb, ub);
+}
+
+
+void CliqueTableUT::testKnapsack()
+{
+  // 3x0 + 2x1 + 2x2 + x3 <= 4 has cliques {x0, x1} and {x0, x2}.
+  double a[4] = {3.0, 2.0, 2.0, 1.0};
+  CliqueTable table(4);
+
+  addCons_(a, -INFINITY, 4.0);
+  CPPUNIT_ASSERT(2==table.build(p_, 1e-6));
+  CPPUNIT_ASSERT(table.isAdjacent(CliqueTable::getLit(0, false),
+                                  CliqueTable::getLit(1, false)));
+  CPPUNIT_ASSERT(table.isAdjacent(CliqueTable::getLit(2, false),
+                                  CliqueTable::getLit(0, false)));
+  CPPUNIT_ASSERT(false==table.isAdjacent(CliqueTable::getLit(1, false),
+                                         CliqueTable::getLit(2, false)));
+  CPPUNIT_ASSERT(false==table.isAdjacent(CliqueTable::getLit(0, false),
+                                         CliqueTable::getLit(3, false)));
+}
+
+
+void CliqueTableUT::testImplication()
+{
+  // x0 <= x1, i.e. x0 = 1 implies x1 = 1. Also x2 + x3 >= 1.
+  double a[4] = {1.0, -1.0, 0.0, 0.0};
+  double b[4] = {0.0, 0.0, 1.0, 1.0};
+  CliqueTable table(4);
+  UIntVector lits;
+
+  addCons_(a, -INFINITY, 0.0);
+  addCons_(b, 1.0, INFINITY);
+  CPPUNIT_ASSERT(2==table.build(p_, 1e-6));
+  CPPUNIT_ASSERT(table.isAdjacent(CliqueTable::getLit(0, false),
+                                  CliqueTable::getLit(1, true)));
+  CPPUNIT_ASSERT(table.isAdjacent(CliqueTable::getLit(2, true),
+                                  CliqueTable::getLit(3, true)));
+
+  // an implication already in the table is not added again.
+  CPPUNIT_ASSERT(false==table.addImplication(CliqueTable::getLit(0, false),
+                                             CliqueTable::getLit(1, false)));
+  CPPUNIT_ASSERT(table.addImplication(CliqueTable::getLit(1, false),
+                                      CliqueTable::getLit(2, false)));
+  table.getImplied(CliqueTable::getLit(1, true), lits);
+  CPPUNIT_ASSERT(1==lits.size());
+  CPPUNIT_ASSERT(CliqueTable::getLit(0, false)==lits[0]);
+}
+
+
+void CliqueTableUT::testPacking()
+{
+  // x0 + x1 + x2 = 1 gives one clique of three variables.
+  double a[4] = {1.0, 1.0, 1.0, 0.0};
+  CliqueTable table(4);
+  UIntVector lits;
+
+  addCons_(a, 1.0, 1.0);
+  table.build(p_, 1e-6);
+  CPPUNIT_ASSERT(1==table.getNumCliques());
+  CPPUNIT_ASSERT(3==table.getSize(0));
+
+  // subsets of a clique are not added.
+  lits.push_back(CliqueTable::getLit(2, false));
+  lits.push_back(CliqueTable::getLit(0, false));
+  CPPUNIT_ASSERT(false==table.addClique(lits));
+
+  lits.clear();
+  table.getImplied(CliqueTable::getLit(1, false), lits);
+  CPPUNIT_ASSERT(2==lits.size());
+}
+
+
+void CliqueTableUT::testPropagate()
+{
+  double a[4] = {1.0, 1.0, 1.0, 0.0};
+  double b[4] = {0.0, 0.0, 1.0, -1.0};
+  CliqueTablePtr table = (CliqueTablePtr) new CliqueTable(4);
+  PropEngine engine(p_);
+  ModVector mods;
+
+  // x0 + x1 + x2 <= 1, x2 <= x3.
+  addCons_(a, -INFINITY, 1.0);
+  addCons_(b, -INFINITY, 0.0);
+  table->build(p_, 1e-6);
+  engine.addPropagator((CliquePropagatorPtr)
+                       new CliquePropagator(table, p_));
+  engine.init();
+  CPPUNIT_ASSERT(false==engine.propagate(&mods, 0));
+  CPPUNIT_ASSERT(mods.empty());
+
+  // x3 = 0 fixes x2 = 0.
+  p_->changeBound(vars_[3], Upper, 0.0);
+  engine.sync();
+  CPPUNIT_ASSERT(false==engine.propagate(&mods, 0));
+  CPPUNIT_ASSERT(1==mods.size());
+  CPPUNIT_ASSERT(vars_[2]->getUb() < 0.5);
+
+  // x0 = 1 fixes x1 = 0.
+  p_->changeBound(vars_[0], Lower, 1.0);
+  engine.sync();
+  CPPUNIT_ASSERT(false==engine.propagate(&mods, 0));
+  CPPUNIT_ASSERT(vars_[1]->getUb() < 0.5);
+
+  // x1 = 1 is now infeasible.
+  p_->changeBound(vars_[1], 1.0, 1.0);
+  engine.sync();
+  CPPUNIT_ASSERT(true==engine.propagate(&mods, 0));
+}
+
+
+void CliqueTableUT::testRelVars()
+{
+  double a[4] = {1.0, 1.0, 0.0, 0.0};
+  CliqueTablePtr table = (CliqueTablePtr) new CliqueTable(4);
+  LinearFunctionPtr lf;
+  RelaxationPtr rel;
+  ProblemPtr q = (ProblemPtr) new Problem();
+  VarVector vars;
+  UIntVector ind;
+  ModVector mods;
+
+  // x0 + x1 <= 1.
+  addCons_(a, -INFINITY, 1.0);
+  table->build(p_, 1e-6);
+
+  // a relaxation with an extra variable that is not in the table.
+  lf = (LinearFunctionPtr) new LinearFunction();
+  lf->addTerm(vars_[0], 1.0);
+  p_->newObjective((FunctionPtr) new Function(lf), 0.0, Minimize);
+  rel = (RelaxationPtr) new Relaxation(p_);
+  rel->setProblem(p_);
+  rel->newVariable(0.0, 1.0, Binary);
+  table->getRelVars(p_, rel, vars, &ind);
+  CPPUNIT_ASSERT(4==vars.size());
+  CPPUNIT_ASSERT(5==ind.size());
+  for (UInt j=0; j<4; ++j) {
+    CPPUNIT_ASSERT(vars[j]==rel->getRelaxationVar(vars_[j]));
+    CPPUNIT_ASSERT(j==ind[vars[j]->getIndex()]);
+  }
+  CPPUNIT_ASSERT(4==ind[4]);
+
+  // a problem with the variables in the opposite order: index j of the
+  // table is variable 3-j of q.
+  for (UInt j=0; j<4; ++j) {
+    q->newVariable(0.0, 1.0, Binary);
+  }
+  vars.clear();
+  for (UInt j=0; j<4; ++j) {
+    vars.push_back(q->getVariable(3-j));
+  }
+  PropEngine engine(q);
+  engine.addPropagator((CliquePropagatorPtr)
+                       new CliquePropagator(table, q, vars));
+  engine.init();
+
+  // x0 = 1 fixes x1 = 0, which are q's variables 3 and 2.
+  q->changeBound(vars[0], Lower, 1.0);
+  engine.sync();
+  CPPUNIT_ASSERT(false==engine.propagate(&mods, 0));
+  CPPUNIT_ASSERT(1==mods.size());
+  CPPUNIT_ASSERT(q->getVariable(2)->getUb() < 0.5);
+  CPPUNIT_ASSERT(q->getVariable(1)->getUb() > 0.5);
+  CPPUNIT_ASSERT(q->getVariable(0)->getUb() > 0.5);
+}
+
+
+void CliqueTableUT::testVars()
+{
+  double a[4] = {1.0, 1.0, 0.0, 0.0};
+  CliqueTable table(4);
+
+  // x0 + x1 <= 1.
+  addCons_(a, -INFINITY, 1.0);
+  CPPUNIT_ASSERT(1==table.build(p_, 1e-6));
+  CPPUNIT_ASSERT(table.hasVars(p_));
+  table.setVars(p_);
+  CPPUNIT_ASSERT(1==table.getNumCliques());
+
+  // the same number of variables, but x0 is gone and x1 has index 0.
+  p_->markDelete(vars_[0]);
+  p_->delMarkedVars();
+  p_->newVariable(0.0, 1.0, Binary);
+  CPPUNIT_ASSERT(4==p_->getNumVars());
+  CPPUNIT_ASSERT(false==table.hasVars(p_));
+  table.setVars(p_);
+  CPPUNIT_ASSERT(0==table.getNumCliques());
+  CPPUNIT_ASSERT(table.hasVars(p_));
+}
+
+
+// Local Variables: 
+// mode: c++ 
+// eval: (c-set-style "k&r") 
+// eval: (c-set-offset 'innamespace 0) 
+// eval: (setq c-basic-offset 2) 
+// eval: (setq fill-column 78) 
+// eval: (auto-fill-mode 1) 
+// eval: (setq column-number-mode 1) 
+// eval: (setq indent-tabs-mode nil) 
+// End:
@@ -0,0 +1,66 @@
+// 
+//     MINOTAUR -- It's only 1/2 bull
+// 
+//     (C)opyright 2009 - 2014 The MINOTAUR Team.
+// 
+
+#ifndef CLIQUETABLEUT_H
+#define CLIQUETABLEUT_H
+
+#include <string>
+
+#include <cppunit/TestCase.h>
+#include <cppunit/TestCaller.h>
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <Problem.h>
+
+using namespace Minotaur;
+
+class CliqueTableUT : public CppUnit::TestCase {
+
+public:
+  CliqueTableUT(std::string name) : TestCase(name) {}
+  CliqueTableUT() {}
+
+  void setUp();
+  void tearDown();
+
+  CPPUNIT_TEST_SUITE(CliqueTableUT);
+  CPPUNIT_TEST(testKnapsack);
+  CPPUNIT_TEST(testImplication);
+  CPPUNIT_TEST(testPacking);
+  CPPUNIT_TEST(testPropagate);
+  CPPUNIT_TEST(testVars);
+  CPPUNIT_TEST(testRelVars);
+  CPPUNIT_TEST_SUITE_END();
+
+  void testKnapsack();
+  void testImplication();
+  void testPacking();
+  void testPropagate();
+  void testVars();
+  void testRelVars();
+
+private:
+  /// Add the constraint lb <= sum_i a[i]*x_i <= ub to p_.
+  void addCons_(const double *a, double lb, double ub);
+
+  ProblemPtr p_;
+  VarVector vars_;
+};
+
+#endif
+
+// Local Variables: 
+// mode: c++ 
+// eval: (c-set-style "k&r") 
+// eval: (c-set-offset 'innamespace 0) 
+// eval: (setq c-basic-offset 2) 
+// eval: (setq fill-column 78) 
+// eval: (auto-fill-mode 1) 
+// eval: (setq column-number-mode 1) 
+// eval: (setq indent-tabs-mode nil) 
+// End:
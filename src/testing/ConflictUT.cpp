@@ -0,0 +1,154 @@
+// 
+//    MINOTAUR -- It's only 1/2 bull
+// 
+//    (C)opyright 2009 - 2014 The MINOTAUR Team.
+// 
+
+#include <cmath>
+
+#include "MinotaurConfig.h"
+#include "Branch.h"
+#include "ConflictAnalyzer.h"
+#include "ConflictPool.h"
+#include "ConflictUT.h"
+#include "Constraint.h"
+#include "Function.h"
+#include "LinearFunction.h"
+#include "Node.h"
+#include "Relaxation.h"
+#include "VarBoundMod.h"
+#include "Variable.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(ConflictUT);
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(ConflictUT, "ConflictUT");
+
+using namespace Minotaur;
+
+
+void ConflictUT::setUp()
+{
+  LinearFunctionPtr lf = (LinearFunctionPtr) new LinearFunction();
+
+  env_ = (EnvPtr) new Environment();
+  p_ = (ProblemPtr) new Problem();
+  for (UInt i=0; i<4; ++i) {
+    vars_.push_back(p_->newVariable(0.0, 1.0, Binary));
+  }
+
+  // x0 + x1 + x2 <= 1.
+  for (UInt i=0; i<3; ++i) {
+    lf->addTerm(vars_[i], 1.0);
+  }
+  p_->newConstraint((FunctionPtr) new Function(lf), -INFINITY, 1.0);
+
+  lf = (LinearFunctionPtr) new LinearFunction();
+  lf->addTerm(vars_[3], -1.0);
+  p_->newObjective((FunctionPtr) new Function(lf), 0.0, Minimize);
+}
+
+
+void ConflictUT::tearDown()
+{
+  vars_.clear();
+  p_.reset();
+  env_.reset();
+}
+
+
+void ConflictUT::testPool()
+{
+  ConflictPool pool(2, 3);
+  std::vector<ConflictLit> lits(2);
+
+  lits[0].j = 1;
+  lits[0].lu = Lower;
+  lits[0].val = 1.0;
+  lits[1].j = 0;
+  lits[1].lu = Upper;
+  lits[1].val = 0.0;
+  CPPUNIT_ASSERT(true==pool.addConflict(lits));
+  CPPUNIT_ASSERT(0==pool.begin(0)->j);
+
+  // the same conflict is not added again.
+  CPPUNIT_ASSERT(false==pool.addConflict(lits));
+  CPPUNIT_ASSERT(1==pool.getNumActive());
+
+  // too large.
+  lits.resize(4, lits[0]);
+  lits[2].j = 2;
+  lits[3].j = 3;
+  CPPUNIT_ASSERT(false==pool.addConflict(lits));
+
+  // removed after two calls to age(), unless used.
+  pool.age();
+  pool.age();
+  pool.used(0);
+  pool.age();
+  CPPUNIT_ASSERT(true==pool.isActive(0));
+  pool.age();
+  pool.age();
+  CPPUNIT_ASSERT(false==pool.isActive(0));
+  CPPUNIT_ASSERT(0==pool.getNumActive());
+  CPPUNIT_ASSERT(1==pool.getNumRemoved());
+}
+
+
+void ConflictUT::testAnalyze()
+{
+  RelaxationPtr rel = (RelaxationPtr) new Relaxation(p_);
+  ConflictAnalyzer analyzer(env_);
+  ConflictPoolPtr pool = analyzer.getPool();
+  NodePtr root = (NodePtr) new Node();
+  NodePtr node, parent;
+  BranchPtr br;
+  ModVector mods;
+  // branch on x3 <= 0, x0 >= 1 and then x1 >= 1.
+  UInt j[3] = {3, 0, 1};
+  BoundType lu[3] = {Upper, Lower, Lower};
+  double val[3] = {0.0, 1.0, 1.0};
+
+  parent = root;
+  for (UInt k=0; k<3; ++k) {
+    br = (BranchPtr) new Branch();
+    br->addRMod((VarBoundModPtr) new VarBoundMod(rel->getVariable(j[k]),
+                                                 lu[k], val[k]));
+    node = (NodePtr) new Node(parent, br);
+    node->applyRMods(rel);
+    parent = node;
+  }
+
+  // x0 + x1 + x2 <= 1 is violated. The decision on x3 is not needed.
+  node->setStatus(NodeInfeasible);
+  analyzer.analyze(node, rel);
+  CPPUNIT_ASSERT(1==pool->getNumActive());
+  CPPUNIT_ASSERT(2==pool->getSize(0));
+  CPPUNIT_ASSERT(0==pool->begin(0)->j);
+  CPPUNIT_ASSERT(1==(pool->begin(0)+1)->j);
+  CPPUNIT_ASSERT(rel->getVariable(3)->getUb() < 0.5);
+  CPPUNIT_ASSERT(rel->getVariable(0)->getLb() > 0.5);
+  CPPUNIT_ASSERT(rel->getVariable(1)->getLb() > 0.5);
+
+  // in a sibling with x1 >= 1 and x0 free, the conflict fixes x0 = 0.
+  node->undoRMods(rel);
+  node->getParent()->undoRMods(rel);
+  br = (BranchPtr) new Branch();
+  br->addRMod((VarBoundModPtr) new VarBoundMod(rel->getVariable(1), Lower,
+                                               1.0));
+  node = (NodePtr) new Node(node->getParent()->getParent(), br);
+  node->applyRMods(rel);
+  CPPUNIT_ASSERT(false==analyzer.propagate(rel, mods));
+  CPPUNIT_ASSERT(1==mods.size());
+  CPPUNIT_ASSERT(rel->getVariable(0)->getUb() < 0.5);
+}
+
+
+// Local Variables: 
+// mode: c++ 
+// eval: (c-set-style "k&r") 
+// eval: (c-set-offset 'innamespace 0) 
+// eval: (setq c-basic-offset 2) 
+// eval: (setq fill-column 78) 
+// eval: (auto-fill-mode 1) 
+// eval: (setq column-number-mode 1) 
+// eval: (setq indent-tabs-mode nil) 
+// End:
@@ -0,0 +1,213 @@
+// 
+//    MINOTAUR -- It's only 1/2 bull
+// 
+//    (C)opyright 2009 - 2014 The MINOTAUR Team.
+// 
+
+#include <cmath>
+
+#include "MinotaurConfig.h"
+#include "Cut.h"
+#include "CutPool.h"
+#include "CutPoolUT.h"
+#include "Function.h"
+#include "LinearFunction.h"
+#include "Variable.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(CutPoolUT);
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(CutPoolUT, "CutPoolUT");
+
+using namespace Minotaur;
+
+
+void CutPoolUT::setUp()
+{
+  p_ = (ProblemPtr) new Problem();
+  vars_.push_back(p_->newVariable(0.0, 1.0, Continuous));
+  vars_.push_back(p_->newVariable(0.0, 1.0, Continuous));
+  vars_.push_back(p_->newVariable(0.0, 1.0, Continuous));
+}
+
+
+void CutPoolUT::tearDown()
+{
+  vars_.clear();
+  p_.reset();
+}
+
+
+CutPtr CutPoolUT::getCut_(double a0, double a1, double a2, double lb,
+                          double ub)
+{
+  LinearFunctionPtr lf = (LinearFunctionPtr) new LinearFunction();
+  FunctionPtr f;
+
+  if (a0 != 0.0) {
+    lf->addTerm(vars_[0], a0);
+  }
+  if (a1 != 0.0) {
+    lf->addTerm(vars_[1], a1);
+  }
+  if (a2 != 0.0) {
+    lf->addTerm(vars_[2], a2);
+  }
+  f = (FunctionPtr) new Function(lf);
+  return (CutPtr) new Cut(p_->getNumVars(), f, lb, ub, false, false);
+}
+
+
+void CutPoolUT::testDup()
+{
+  CutPool pool;
+  CutPtr c1 = getCut_(1.0, 2.0, 0.0, -INFINITY, 3.0);
+
+  CPPUNIT_ASSERT(pool.addCut(c1));
+  CPPUNIT_ASSERT(pool.getNumCuts() == 1);
+
+  // same cut scaled by 2.
+  CPPUNIT_ASSERT(pool.findDup(getCut_(2.0, 4.0, 0.0, -INFINITY, 6.0)) == c1);
+
+  // weaker cut.
+  CPPUNIT_ASSERT(pool.findDup(getCut_(1.0, 2.0, 0.0, -INFINITY, 4.0)) == c1);
+
+  // tighter cut is not redundant.
+  CPPUNIT_ASSERT(!pool.findDup(getCut_(1.0, 2.0, 0.0, -INFINITY, 2.0)));
+
+  // opposite direction.
+  CPPUNIT_ASSERT(!pool.findDup(getCut_(1.0, 2.0, 0.0, 3.0, INFINITY)));
+
+  // rows without cuts.
+  UIntVector ind;
+  DoubleVector val;
+  ind.push_back(2);
+  ind.push_back(0);
+  val.push_back(1.0);
+  val.push_back(1.0);
+  pool.addRow(ind, val, 0.0, 1.0);
+  val[0] = 3.0;
+  val[1] = 3.0;
+  CPPUNIT_ASSERT(pool.findDup(ind, val, 0.0, 3.0) == 1);
+  CPPUNIT_ASSERT(pool.findDup(ind, val, 0.0, 2.0) == -1);
+}
+
+
+void CutPoolUT::testParallel()
+{
+  CutPool pool;
+  CutPtr c1 = getCut_(1.0, 1.0, 0.0, -INFINITY, 1.0);
+  CutPtr c2 = getCut_(1.0, 1.01, 0.0, -INFINITY, 1.1);
+  DoubleVector obj, act, eff, objpar, viol;
+  UIntVector rows;
+  double y[3] = {-10.0, 11.0, 0.0};
+  double x[3] = {0.0, 1.5, 0.0};
+
+  // c2 is nearly parallel to c1 and has a looser bound, but y satisfies c1
+  // and violates c2, so c2 is not redundant.
+  pool.addCut(c1);
+  CPPUNIT_ASSERT(!pool.findDup(c2));
+  pool.addCut(c2);
+  pool.evalViolation(y, viol);
+  CPPUNIT_ASSERT(viol[0] <= 0.0 && viol[1] > 0.0);
+
+  pool.evalScores(x, obj, act, eff, objpar);
+  CPPUNIT_ASSERT(eff[0] > 0.0 && eff[1] > 0.0);
+
+  // only one of them is selected when nearly parallel cuts are not wanted.
+  pool.selectCuts(eff, objpar, 0.0, 0.0, 0.999, 0, rows);
+  CPPUNIT_ASSERT(rows.size() == 1);
+  pool.selectCuts(eff, objpar, 0.0, 0.0, 1.0, 0, rows);
+  CPPUNIT_ASSERT(rows.size() == 2);
+}
+
+
+void CutPoolUT::testRemove()
+{
+  CutPool pool;
+  CutVector cuts;
+
+  for (UInt i=0; i<200; ++i) {
+    cuts.push_back(getCut_(1.0, (double) i, 1.0, -INFINITY, 1.0));
+    pool.addCut(cuts.back());
+  }
+  CPPUNIT_ASSERT(pool.getNumCuts() == 200);
+
+  // removing more than half of the rows compacts the pool.
+  for (UInt i=0; i<150; ++i) {
+    CPPUNIT_ASSERT(pool.removeCut(cuts[i]));
+  }
+  CPPUNIT_ASSERT(pool.getNumCuts() == 50);
+  CPPUNIT_ASSERT(false == pool.removeCut(cuts[0]));
+  CPPUNIT_ASSERT(!pool.findDup(cuts[10]));
+  CPPUNIT_ASSERT(pool.findDup(cuts[160]) == cuts[160]);
+}
+
+
+void CutPoolUT::testSelect()
+{
+  CutPool pool;
+  DoubleVector obj, act, eff, objpar;
+  UIntVector rows;
+  double x[3] = {1.0, 1.0, 1.0};
+
+  pool.addCut(getCut_(1.0, 1.0, 0.0, -INFINITY, 1.0));
+  pool.addCut(getCut_(2.0, 2.0, 0.0, -INFINITY, 1.5));
+  pool.addCut(getCut_(0.0, 0.0, 1.0, -INFINITY, 0.5));
+  pool.addCut(getCut_(1.0, 0.0, 0.0, -INFINITY, 2.0));
+  pool.evalScores(x, obj, act, eff, objpar);
+  CPPUNIT_ASSERT(fabs(act[1] - 4.0) < 1e-12);
+  CPPUNIT_ASSERT(fabs(eff[0] - 1.0/sqrt(2.0)) < 1e-12);
+  CPPUNIT_ASSERT(fabs(eff[1] - 2.5/sqrt(8.0)) < 1e-12);
+  CPPUNIT_ASSERT(fabs(eff[3]) < 1e-12);
+  CPPUNIT_ASSERT(fabs(objpar[2]) < 1e-12);
+
+  // all violated cuts, best first.
+  pool.selectCuts(eff, objpar, 0.0, 0.0, 1.0, 0, rows);
+  CPPUNIT_ASSERT(rows.size() == 3);
+  CPPUNIT_ASSERT(rows[0] == 1 && rows[1] == 0 && rows[2] == 2);
+
+  // the first cut is parallel to the second.
+  pool.selectCuts(eff, objpar, 0.0, 0.0, 0.9, 0, rows);
+  CPPUNIT_ASSERT(rows.size() == 2);
+  CPPUNIT_ASSERT(rows[0] == 1 && rows[1] == 2);
+
+  pool.selectCuts(eff, objpar, 0.0, 0.0, 0.9, 1, rows);
+  CPPUNIT_ASSERT(rows.size() == 1);
+
+  // the third cut is parallel to the objective.
+  obj.assign(3, 0.0);
+  obj[2] = 1.0;
+  pool.evalScores(x, obj, act, eff, objpar);
+  CPPUNIT_ASSERT(fabs(objpar[2] - 1.0) < 1e-12);
+  pool.selectCuts(eff, objpar, 0.0, 1.0, 0.9, 0, rows);
+  CPPUNIT_ASSERT(rows.size() == 2);
+  CPPUNIT_ASSERT(rows[0] == 2 && rows[1] == 1);
+}
+
+
+void CutPoolUT::testViolation()
+{
+  CutPool pool;
+  DoubleVector viol;
+  double x[3] = {1.0, 1.0, 1.0};
+
+  pool.addCut(getCut_(1.0, 1.0, 0.0, -INFINITY, 1.0));
+  pool.addCut(getCut_(0.0, 1.0, 1.0, -INFINITY, 3.0));
+  pool.addCut(getCut_(1.0, 0.0, 1.0, 4.0, INFINITY));
+  pool.evalViolation(x, viol);
+  CPPUNIT_ASSERT(viol.size() == 3);
+  CPPUNIT_ASSERT(fabs(viol[0] - 1.0) < 1e-12);
+  CPPUNIT_ASSERT(fabs(viol[1]) < 1e-12);
+  CPPUNIT_ASSERT(fabs(viol[2] - 2.0) < 1e-12);
+}
+
+
+// Local Variables: 
+// mode: c++ 
+// eval: (c-set-style "k&r") 
+// eval: (c-set-offset 'innamespace 0) 
+// eval: (setq c-basic-offset 2) 
+// eval: (setq fill-column 78) 
+// eval: (auto-fill-mode 1) 
+// eval: (setq column-number-mode 1) 
+// eval: (setq indent-tabs-mode nil) 
+// End:
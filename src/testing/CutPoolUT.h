@@ -0,0 +1,64 @@
+// 
+//     MINOTAUR -- It's only 1/2 bull
+// 
+//     (C)opyright 2009 - 2014 The MINOTAUR Team.
+// 
+
+#ifndef CUTPOOLUT_H
+#define CUTPOOLUT_H
+
+#include <string>
+
+#include <cppunit/TestCase.h>
+#include <cppunit/TestCaller.h>
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <Problem.h>
+
+using namespace Minotaur;
+
+class CutPoolUT : public CppUnit::TestCase {
+
+public:
+  CutPoolUT(std::string name) : TestCase(name) {}
+  CutPoolUT() {}
+
+  void setUp();
+  void tearDown();
+
+  CPPUNIT_TEST_SUITE(CutPoolUT);
+  CPPUNIT_TEST(testDup);
+  CPPUNIT_TEST(testParallel);
+  CPPUNIT_TEST(testRemove);
+  CPPUNIT_TEST(testSelect);
+  CPPUNIT_TEST(testViolation);
+  CPPUNIT_TEST_SUITE_END();
+
+  void testDup();
+  void testParallel();
+  void testRemove();
+  void testSelect();
+  void testViolation();
+
+private:
+  /// Create the cut lb <= a0*x0 + a1*x1 + a2*x2 <= ub.
+  CutPtr getCut_(double a0, double a1, double a2, double lb, double ub);
+
+  ProblemPtr p_;
+  VarVector vars_;
+};
+
+#endif
+
+// Local Variables: 
+// mode: c++ 
+// eval: (c-set-style "k&r") 
+// eval: (c-set-offset 'innamespace 0) 
+// eval: (setq c-basic-offset 2) 
+// eval: (setq fill-column 78) 
+// eval: (auto-fill-mode 1) 
+// eval: (setq column-number-mode 1) 
+// eval: (setq indent-tabs-mode nil) 
+// End:
@@ -0,0 +1,187 @@
+//
+//    MINOTAUR -- It's only 1/2 bull
+//
+//    (C)opyright 2009 - 2014 The MINOTAUR Team.
+//
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+
+#include "MinotaurConfig.h"
+#include "Constraint.h"
+#include "Engine.h"
+#include "Function.h"
+#include "LinearFunction.h"
+#include "MipStart.h"
+#include "MipStartUT.h"
+#include "Option.h"
+#include "Relaxation.h"
+#include "Solution.h"
+#include "SolutionPool.h"
+#include "Variable.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(MipStartUT);
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(MipStartUT, "MipStartUT");
+
+using namespace Minotaur;
+
+// An engine that returns the same point with status FailedFeas.
+class FixedEngine : public Engine {
+public:
+  FixedEngine(const DoubleVector &x) : x_(x) {}
+  void addConstraint(ConstraintPtr) {}
+  void changeBound(ConstraintPtr, BoundType, double) {}
+  void changeBound(VariablePtr, BoundType, double) {}
+  void changeBound(VariablePtr, double, double) {}
+  void changeConstraint(ConstraintPtr, LinearFunctionPtr, double, double) {}
+  void changeConstraint(ConstraintPtr, NonlinearFunctionPtr) {}
+  void changeObj(FunctionPtr, double) {}
+  void clear() {}
+  void disableStrBrSetup() {}
+  EnginePtr emptyCopy() {return (EnginePtr) new FixedEngine(x_);}
+  void enableStrBrSetup() {}
+  ConstSolutionPtr getSolution()
+  {return (SolutionPtr) new Solution(0.0, &(x_[0]), p_);}
+  double getSolutionValue() {return 0.0;}
+  EngineStatus solve() {return FailedFeas;}
+  std::string getName() const {return "FixedEngine";}
+  EngineStatus getStatus() {return FailedFeas;}
+  ConstWarmStartPtr getWarmStart() {return ConstWarmStartPtr();}
+  WarmStartPtr getWarmStartCopy() {return WarmStartPtr();}
+  void load(ProblemPtr p) {p_ = p;}
+  void loadFromWarmStart(const WarmStartPtr) {}
+  void negateObj() {}
+  void removeCons(std::vector<ConstraintPtr> &) {}
+  void resetIterationLimit() {}
+  void setIterationLimit(int) {}
+
+private:
+  DoubleVector x_;
+  ProblemPtr p_;
+};
+
+
+void MipStartUT::setUp()
+{
+  env_ = (EnvPtr) new Environment();
+  p_ = (ProblemPtr) new Problem();
+  p_->newVariable(0.0, 1.0, Binary, "x0");
+  p_->newVariable(0.0, 4.0, Integer, "x1");
+  p_->newVariable(-1.0, 1.0, Continuous, "x2");
+}
+
+
+void MipStartUT::tearDown()
+{
+  p_.reset();
+  env_.reset();
+}
+
+
+void MipStartUT::testReadFile()
+{
+  MipStartPtr ms;
+  std::ofstream out;
+
+  out.open("mipstartUT1.mst");
+  out << "# a partial start" << std::endl
+      << "x1 3" << std::endl
+      << "y7 2.5" << std::endl
+      << std::endl
+      << "x2   -0.5" << std::endl;
+  out.close();
+  out.open("mipstartUT2.mst");
+  out << "# nothing useful" << std::endl << "z 1" << std::endl;
+  out.close();
+
+  env_->getOptions()->findString("mipstart_file")
+    ->setValue("mipstartUT1.mst,mipstartUT2.mst mipstartUT.missing");
+  ms = (MipStartPtr) new MipStart(env_, p_, EnginePtr());
+  CPPUNIT_ASSERT(1==ms->getNumStarts());
+  CPPUNIT_ASSERT(std::isnan(ms->getStart(0)[0]));
+  CPPUNIT_ASSERT(fabs(ms->getStart(0)[1]-3.0)<1e-12);
+  CPPUNIT_ASSERT(fabs(ms->getStart(0)[2]+0.5)<1e-12);
+
+  CPPUNIT_ASSERT(true==ms->readFile("mipstartUT1.mst"));
+  CPPUNIT_ASSERT(false==ms->readFile("mipstartUT2.mst"));
+  CPPUNIT_ASSERT(2==ms->getNumStarts());
+  remove("mipstartUT1.mst");
+  remove("mipstartUT2.mst");
+}
+
+
+void MipStartUT::testAddStart()
+{
+  MipStartPtr ms;
+  double x[3] = {1.0, 2.0, 0.5};
+
+  env_->getOptions()->findBool("mipstart_use_x0")->setValue(true);
+  ms = (MipStartPtr) new MipStart(env_, p_, EnginePtr());
+  CPPUNIT_ASSERT(0==ms->getNumStarts());
+
+  p_->setInitialPoint(x);
+  ms = (MipStartPtr) new MipStart(env_, p_, EnginePtr());
+  CPPUNIT_ASSERT(1==ms->getNumStarts());
+  CPPUNIT_ASSERT(fabs(ms->getStart(0)[2]-0.5)<1e-12);
+
+  ms->addStart(DoubleVector(2, 0.0));
+  CPPUNIT_ASSERT(1==ms->getNumStarts());
+  ms->addStart(DoubleVector(3, NAN));
+  CPPUNIT_ASSERT(2==ms->getNumStarts());
+}
+
+
+void MipStartUT::testFeasCheck()
+{
+  LinearFunctionPtr lf = (LinearFunctionPtr) new LinearFunction();
+  SolutionPoolPtr pool;
+  RelaxationPtr rel;
+  MipStartPtr ms;
+  DoubleVector x(3, 1.0);
+  int err = 0;
+
+  env_->startTimer(err);
+  CPPUNIT_ASSERT(0==err);
+
+  // x0 + x2 <= 0.5.
+  lf->addTerm(p_->getVariable(0), 1.0);
+  lf->addTerm(p_->getVariable(2), 1.0);
+  p_->newConstraint((FunctionPtr) new Function(lf), -INFINITY, 0.5, "c0");
+  lf = (LinearFunctionPtr) new LinearFunction();
+  lf->addTerm(p_->getVariable(1), 1.0);
+  p_->newObjective((FunctionPtr) new Function(lf), 0.0, Minimize);
+  rel = (RelaxationPtr) new Relaxation(p_);
+
+  x[1] = 2.0;
+  x[2] = 0.5;
+  CPPUNIT_ASSERT(!MipStart::create(env_, p_, rel,
+                                   (EnginePtr) new FixedEngine(x)));
+  env_->getOptions()->findBool("mipstart_use_x0")->setValue(true);
+  p_->setInitialPoint(&(x[0]));
+
+  // the engine could not prove that its point is feasible, and it is not.
+  ms = MipStart::create(env_, p_, rel, (EnginePtr) new FixedEngine(x));
+  CPPUNIT_ASSERT(ms);
+  pool = (SolutionPoolPtr) new SolutionPool(env_, p_);
+  ms->solve(NodePtr(), rel, pool);
+  CPPUNIT_ASSERT(0==pool->getNumSols());
+
+  x[2] = -0.5;
+  ms = MipStart::create(env_, p_, rel, (EnginePtr) new FixedEngine(x));
+  pool = (SolutionPoolPtr) new SolutionPool(env_, p_);
+  ms->solve(NodePtr(), rel, pool);
+  CPPUNIT_ASSERT(1==pool->getNumSols());
+}
+
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
@@ -0,0 +1,139 @@
+// 
+//    MINOTAUR -- It's only 1/2 bull
+// 
+//    (C)opyright 2009 - 2014 The MINOTAUR Team.
+// 
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+
+#include "MinotaurConfig.h"
+#include "Constraint.h"
+#include "Function.h"
+#include "MpsReader.h"
+#include "MpsReaderUT.h"
+#include "Objective.h"
+#include "Option.h"
+#include "QuadraticFunction.h"
+#include "Variable.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(MpsReaderUT);
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(MpsReaderUT, "MpsReaderUT");
+
+using namespace Minotaur;
+
+
+void MpsReaderUT::setUp()
+{
+  env_ = (EnvPtr) new Environment();
+  env_->setLogLevel(LogNone);
+}
+
+
+void MpsReaderUT::tearDown()
+{
+  env_.reset();
+}
+
+
+void MpsReaderUT::testFree()
+{
+  MpsReader reader(env_);
+  ProblemPtr p = reader.readInstance("instances/mpsut.mps");
+  double x[4] = {1.0, 1.0, 2.0, 3.0};
+  double lb[5] = {-2.0, 1.0, -2.0, 2.0, -INFINITY};
+  double ub[5] = {4.0, INFINITY, 0.0, 5.0, 10.0};
+  double act[5] = {2.0, 4.0, -2.0, 5.0, 16.0};
+  int err = 0;
+
+  CPPUNIT_ASSERT(p);
+  CPPUNIT_ASSERT(4==p->getNumVars());
+  CPPUNIT_ASSERT(5==p->getNumCons());
+
+  // x1, y1, y2, x2 in the order of COLUMNS.
+  CPPUNIT_ASSERT("y2"==p->getVariable(2)->getName());
+  CPPUNIT_ASSERT(Continuous==p->getVariable(0)->getType());
+  CPPUNIT_ASSERT(8.0==p->getVariable(0)->getUb());
+  CPPUNIT_ASSERT(Binary==p->getVariable(1)->getType());
+  CPPUNIT_ASSERT(1.0==p->getVariable(1)->getUb());
+  CPPUNIT_ASSERT(Integer==p->getVariable(2)->getType());
+  CPPUNIT_ASSERT(-1.0==p->getVariable(2)->getLb());
+  CPPUNIT_ASSERT(3.0==p->getVariable(2)->getUb());
+  CPPUNIT_ASSERT(-INFINITY==p->getVariable(3)->getLb());
+  CPPUNIT_ASSERT(5.0==p->getVariable(3)->getUb());
+
+  // the second N row is dropped; only the first RHS set is used.
+  for (UInt i=0; i<5; ++i) {
+    ConstraintPtr c = p->getConstraint(i);
+    CPPUNIT_ASSERT(lb[i]==c->getLb());
+    CPPUNIT_ASSERT(ub[i]==c->getUb());
+    CPPUNIT_ASSERT(fabs(act[i]-c->getActivity(x, &err))<1e-12);
+    CPPUNIT_ASSERT(0==err);
+  }
+  CPPUNIT_ASSERT("q1"==p->getConstraint(4)->getName());
+  CPPUNIT_ASSERT(p->getConstraint(4)->getFunction()->getQuadraticFunction());
+
+  // x1 - 2y1 + 3.5 - x1^2 + x1x2 - 2x2^2.
+  CPPUNIT_ASSERT(Maximize==p->getObjective()->getObjectiveType());
+  CPPUNIT_ASSERT(fabs(p->getObjective()->eval(x, &err)+13.5)<1e-12);
+}
+
+
+void MpsReaderUT::testFixed()
+{
+  MpsReader reader(env_);
+  ProblemPtr p;
+  double x[2] = {2.0, 1.0};
+  int err = 0;
+
+  reader.setFixedFormat(true);
+  p = reader.readInstance("instances/mpsut_fixed.mps");
+  CPPUNIT_ASSERT(p);
+  CPPUNIT_ASSERT(2==p->getNumVars());
+  CPPUNIT_ASSERT(2==p->getNumCons());
+  CPPUNIT_ASSERT("MY X"==p->getVariable(0)->getName());
+  CPPUNIT_ASSERT(3.0==p->getVariable(0)->getUb());
+  CPPUNIT_ASSERT("LIM 2"==p->getConstraint(1)->getName());
+  CPPUNIT_ASSERT(4.0==p->getConstraint(0)->getUb());
+  CPPUNIT_ASSERT(1.0==p->getConstraint(1)->getLb());
+  CPPUNIT_ASSERT(fabs(p->getConstraint(0)->getActivity(x, &err)-3.0)<1e-12);
+  CPPUNIT_ASSERT(Minimize==p->getObjective()->getObjectiveType());
+  CPPUNIT_ASSERT(fabs(p->getObjective()->eval(x, &err)-4.0)<1e-12);
+}
+
+
+void MpsReaderUT::testBadFile()
+{
+  MpsReader reader(env_);
+  const char *name = "mpsreaderut_bad.mps";
+  std::ofstream out;
+
+  CPPUNIT_ASSERT(!reader.readInstance("mpsreaderut_missing.mps"));
+
+  // a column refers to a row that does not exist.
+  out.open(name);
+  out << "NAME bad\nROWS\n N obj\n L c1\nCOLUMNS\n x obj 1 c2 1\nENDATA\n";
+  out.close();
+  CPPUNIT_ASSERT(!reader.readInstance(name));
+
+  // semi-continuous bounds are not supported.
+  out.open(name);
+  out << "NAME bad\nROWS\n N obj\nCOLUMNS\n x obj 1\nBOUNDS\n"
+      << " SC bnd x 4\nENDATA\n";
+  out.close();
+  CPPUNIT_ASSERT(!reader.readInstance(name));
+  remove(name);
+}
+
+
+// Local Variables: 
+// mode: c++ 
+// eval: (c-set-style "k&r") 
+// eval: (c-set-offset 'innamespace 0) 
+// eval: (setq c-basic-offset 2) 
+// eval: (setq fill-column 78) 
+// eval: (auto-fill-mode 1) 
+// eval: (setq column-number-mode 1) 
+// eval: (setq indent-tabs-mode nil) 
+// End:
@@ -0,0 +1,156 @@
+// 
+//    MINOTAUR -- It's only 1/2 bull
+// 
+//    (C)opyright 2009 - 2014 The MINOTAUR Team.
+// 
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#include "MinotaurConfig.h"
+#include "Constraint.h"
+#include "Function.h"
+#include "HessianOfLag.h"
+#include "NlReader.h"
+#include "NlReaderUT.h"
+#include "Objective.h"
+#include "Option.h"
+#include "Variable.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(NlReaderUT);
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(NlReaderUT, "NlReaderUT");
+
+using namespace Minotaur;
+
+
+void NlReaderUT::setUp()
+{
+  env_ = (EnvPtr) new Environment();
+  env_->setLogLevel(LogNone);
+}
+
+
+void NlReaderUT::tearDown()
+{
+  env_.reset();
+}
+
+
+void NlReaderUT::testAllFuns()
+{
+  NlReader reader(env_);
+  ProblemPtr p = reader.readInstance("instances/allfuns");
+
+  // same as with AMPLInterface and the native cgraph.
+  CPPUNIT_ASSERT(p);
+  CPPUNIT_ASSERT(74==p->getNumVars());
+  CPPUNIT_ASSERT(23==p->getNumCons());
+  p->setNativeDer();
+  CPPUNIT_ASSERT(115==p->getHessian()->getNumNz());
+}
+
+
+// write a small file in the binary format and read it:
+// min x0*x1 + 2x0 s.t. 1 <= x0 + x1 <= 4, 0 <= x <= 5.
+void NlReaderUT::testBinary()
+{
+  const char *name = "nlreaderut_bin.nl";
+  const char *hdr = "b3 0 1 0\n 2 1 1 1 0\n 0 1\n 0 0\n 0 2 0\n 0 0 0 1\n"
+                    " 0 0 0 0 0\n 2 1\n 0 0\n 0 0 0 0 0\n";
+  std::ofstream out(name, std::ios::binary);
+  int ints[4];
+  double d[2];
+  double x[2] = {1.0, 2.0};
+  int err = 0;
+  ProblemPtr p;
+  NlReader reader(env_);
+
+  out << hdr;
+  out << 'C'; ints[0] = 0; out.write((char *) ints, 4);
+  out << 'n'; d[0] = 0.0; out.write((char *) d, 8);
+  out << 'O'; ints[1] = 0; out.write((char *) ints, 8);
+  out << 'o'; ints[0] = 2; out.write((char *) ints, 4);
+  for (int j=0; j<2; ++j) {
+    out << 'v'; out.write((char *) &j, 4);
+  }
+  out << 'r' << '0'; d[0] = 1.0; d[1] = 4.0; out.write((char *) d, 16);
+  out << 'b';
+  for (int j=0; j<2; ++j) {
+    out << '0'; d[0] = 0.0; d[1] = 5.0; out.write((char *) d, 16);
+  }
+  out << 'k'; ints[0] = 1; ints[1] = 1; out.write((char *) ints, 8);
+  out << 'J'; ints[0] = 0; ints[1] = 2; out.write((char *) ints, 8);
+  for (int j=0; j<2; ++j) {
+    d[0] = 1.0; out.write((char *) &j, 4); out.write((char *) d, 8);
+  }
+  out << 'G'; ints[0] = 0; ints[1] = 1; out.write((char *) ints, 8);
+  ints[0] = 0; d[0] = 2.0; out.write((char *) ints, 4);
+  out.write((char *) d, 8);
+  out.close();
+
+  p = reader.readInstance(name);
+  remove(name);
+  CPPUNIT_ASSERT(p);
+  CPPUNIT_ASSERT(2==p->getNumVars());
+  CPPUNIT_ASSERT(1==p->getNumCons());
+  CPPUNIT_ASSERT(fabs(p->getVariable(1)->getUb()-5.0) < 1e-12);
+  CPPUNIT_ASSERT(fabs(p->getConstraint(0)->getLb()-1.0) < 1e-12);
+  CPPUNIT_ASSERT(fabs(p->getConstraint(0)->getUb()-4.0) < 1e-12);
+  CPPUNIT_ASSERT(fabs(p->getConstraint(0)->getFunction()->eval(x, &err)
+                      -3.0) < 1e-12);
+  CPPUNIT_ASSERT(fabs(p->getObjective()->eval(x, &err)-4.0) < 1e-12);
+  CPPUNIT_ASSERT(0==err);
+}
+
+
+void NlReaderUT::testMinlp()
+{
+  NlReader reader(env_);
+  ProblemPtr p = reader.readInstance("instances/minlp_eg0.nl");
+  // x2, x0, x1, x3, x4 in the order of the file.
+  double x[5] = {3.0, 1.0, 2.0, 5.0, 1.0};
+  int err = 0;
+  ConstraintPtr c;
+
+  CPPUNIT_ASSERT(p);
+  CPPUNIT_ASSERT(5==p->getNumVars());
+  CPPUNIT_ASSERT(5==p->getNumCons());
+  CPPUNIT_ASSERT("x0"==p->getVariable(1)->getName());
+  CPPUNIT_ASSERT(Integer==p->getVariable(1)->getType());
+  CPPUNIT_ASSERT(Integer==p->getVariable(2)->getType());
+  CPPUNIT_ASSERT(Continuous==p->getVariable(3)->getType());
+  CPPUNIT_ASSERT(fabs(p->getVariable(3)->getLb()-4.0) < 1e-12);
+  CPPUNIT_ASSERT(fabs(p->getVariable(3)->getUb()-10.0) < 1e-12);
+  CPPUNIT_ASSERT(p->getVariable(4)->getUb() >= INFINITY);
+
+  // cons0: x0^2 + x1^2 + x2^2 = 1.
+  c = p->getConstraint(0);
+  CPPUNIT_ASSERT("cons0"==c->getName());
+  CPPUNIT_ASSERT(fabs(c->getLb()-1.0) < 1e-12);
+  CPPUNIT_ASSERT(fabs(c->getFunction()->eval(x, &err)-14.0) < 1e-12);
+
+  // cons2: x0 + x1 - x2 >= 0.
+  c = p->getConstraint(2);
+  CPPUNIT_ASSERT(Linear==c->getFunctionType());
+  CPPUNIT_ASSERT(fabs(c->getFunction()->eval(x, &err)-0.0) < 1e-12);
+
+  // obj: x0*x3 + x1*x2 + x4.
+  CPPUNIT_ASSERT(Minimize==p->getObjective()->getObjectiveType());
+  CPPUNIT_ASSERT(fabs(p->getObjective()->eval(x, &err)-12.0) < 1e-12);
+  CPPUNIT_ASSERT(0==err);
+  CPPUNIT_ASSERT(fabs(reader.getInitialPoint()[0]) < 1e-12);
+}
+
+
+// Local Variables: 
+// mode: c++ 
+// eval: (c-set-style "k&r") 
+// eval: (c-set-offset 'innamespace 0) 
+// eval: (setq c-basic-offset 2) 
+// eval: (setq fill-column 78) 
+// eval: (auto-fill-mode 1) 
+// eval: (setq column-number-mode 1) 
+// eval: (setq indent-tabs-mode nil) 
+// End:
@@ -0,0 +1,172 @@
+// 
+//    MINOTAUR -- It's only 1/2 bull
+// 
+//    (C)opyright 2009 - 2014 The MINOTAUR Team.
+// 
+
+#include <cmath>
+
+#include "MinotaurConfig.h"
+#include "Constraint.h"
+#include "Function.h"
+#include "LinearFunction.h"
+#include "LinearHandler.h"
+#include "Option.h"
+#include "PostsolveStack.h"
+#include "PostsolveStackUT.h"
+#include "Presolver.h"
+#include "Variable.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(PostsolveStackUT);
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(PostsolveStackUT, "PostsolveStackUT");
+
+using namespace Minotaur;
+
+
+void PostsolveStackUT::setUp()
+{
+  LinearFunctionPtr lf = (LinearFunctionPtr) new LinearFunction();
+  double a0[4] = {1.0, 1.0, 0.0, 0.0};
+  double a1[4] = {0.0, 1.0, 1.0, 1.0};
+
+  env_ = (EnvPtr) new Environment();
+  p_ = (ProblemPtr) new Problem();
+  for (UInt i=0; i<4; ++i) {
+    vars_.push_back(p_->newVariable(0.0, 10.0, Continuous));
+  }
+
+  // x0 + x1 = 4, x1 + x2 + x3 >= 1.
+  addCons_(a0, 4.0, 4.0);
+  addCons_(a1, 1.0, INFINITY);
+
+  // min x1 + 2x3.
+  lf->addTerm(vars_[1], 1.0);
+  lf->addTerm(vars_[3], 2.0);
+  p_->newObjective((FunctionPtr) new Function(lf), 0.0, Minimize);
+}
+
+
+void PostsolveStackUT::tearDown()
+{
+  vars_.clear();
+  p_.reset();
+  env_.reset();
+}
+
+
+ConstraintPtr PostsolveStackUT::addCons_(const double *a, double lb,
+                                         double ub)
+{
+  LinearFunctionPtr lf = (LinearFunctionPtr) new LinearFunction();
+
+  for (UInt i=0; i<vars_.size(); ++i) {
+    if (a[i] != 0.0) {
+      lf->addTerm(vars_[i], a[i]);
+    }
+  }
+  return p_->newConstraint((FunctionPtr) new Function(lf), lb, ub);
+}
+
+
+void PostsolveStackUT::testPrimal()
+{
+  PostsolveStack stack(p_);
+  DoubleVector x(4, 0.0);
+  DoubleVector newx;
+
+  x[0] = 1.0;
+  x[2] = 5.0;
+  CPPUNIT_ASSERT(true==stack.fixCol(vars_[3], 2.0, p_));
+  CPPUNIT_ASSERT(true==stack.substCol(vars_[1], p_->getConstraint(0), 4.0,
+                                      p_));
+  // x1 is already removed.
+  CPPUNIT_ASSERT(false==stack.substCol(vars_[1], p_->getConstraint(1), 1.0,
+                                       p_));
+  CPPUNIT_ASSERT(2==stack.getSize());
+
+  stack.postsolveGetX(x, &newx);
+  CPPUNIT_ASSERT(4==newx.size());
+  CPPUNIT_ASSERT(fabs(newx[0]-1.0) < 1e-9);
+  CPPUNIT_ASSERT(fabs(newx[1]-3.0) < 1e-9);
+  CPPUNIT_ASSERT(fabs(newx[2]-5.0) < 1e-9);
+  CPPUNIT_ASSERT(fabs(newx[3]-2.0) < 1e-9);
+
+  // the value is moved into the bounds of x1.
+  x[0] = -8.0;
+  stack.postsolveGetX(x, &newx);
+  CPPUNIT_ASSERT(fabs(newx[1]-10.0) < 1e-9);
+}
+
+
+void PostsolveStackUT::testDual()
+{
+  PostsolveStack stack(p_);
+  double y[2] = {7.0, 0.5};
+  double rc[4] = {0.0, 0.0, 0.0, 0.0};
+  DoubleVector newy, newrc;
+
+  stack.fixCol(vars_[3], 2.0, p_);
+  stack.substCol(vars_[1], p_->getConstraint(0), 4.0, p_);
+  stack.postsolveGetDual(p_, y, rc, &newy, &newrc);
+
+  // y0 = (c1 - a11*y1)/a01 and rc3 = c3 - a13*y1.
+  CPPUNIT_ASSERT(2==newy.size());
+  CPPUNIT_ASSERT(4==newrc.size());
+  CPPUNIT_ASSERT(fabs(newy[0]-0.5) < 1e-9);
+  CPPUNIT_ASSERT(fabs(newy[1]-0.5) < 1e-9);
+  CPPUNIT_ASSERT(fabs(newrc[1]) < 1e-9);
+  CPPUNIT_ASSERT(fabs(newrc[3]-1.5) < 1e-9);
+}
+
+
+void PostsolveStackUT::testPresolve()
+{
+  ProblemPtr p = (ProblemPtr) new Problem();
+  LinearFunctionPtr lf = (LinearFunctionPtr) new LinearFunction();
+  HandlerVector handlers;
+  PresolverPtr pres;
+  VarVector x;
+  DoubleVector newx;
+  double a0[4] = {1.0, 1.0, 0.0, 0.0};
+  double a1[4] = {1.0, 0.0, 1.0, 1.0};
+
+  // x1 has no upper bound and x2 is implied free in the equality.
+  p_ = p;
+  vars_.clear();
+  vars_.push_back(p->newVariable(0.0, 10.0, Continuous));
+  vars_.push_back(p->newVariable(0.0, INFINITY, Continuous));
+  vars_.push_back(p->newVariable(-10.0, 10.0, Continuous));
+  vars_.push_back(p->newVariable(0.0, 1.0, Continuous));
+  addCons_(a0, 3.0, INFINITY);
+  addCons_(a1, 4.0, 4.0);
+  lf->addTerm(vars_[0], 1.0);
+  lf->addTerm(vars_[3], 1.0);
+  p->newObjective((FunctionPtr) new Function(lf), 0.0, Minimize);
+
+  env_->getOptions()->findBool("lin_probe")->setValue(false);
+  handlers.push_back((LinearHandlerPtr) new LinearHandler(env_, p));
+  pres = (PresolverPtr) new Presolver(p, env_, handlers);
+  pres->solve();
+  CPPUNIT_ASSERT(0==p->getNumVars());
+
+  // all variables are restored to a feasible point.
+  pres->getX(0, &newx);
+  CPPUNIT_ASSERT(4==newx.size());
+  CPPUNIT_ASSERT(newx[0]+newx[1] > 3.0-1e-6);
+  CPPUNIT_ASSERT(fabs(newx[0]+newx[2]+newx[3]-4.0) < 1e-6);
+  for (UInt i=0; i<4; ++i) {
+    CPPUNIT_ASSERT(newx[i] > vars_[i]->getLb()-1e-6);
+  }
+}
+
+
+// Local Variables: 
+// mode: c++ 
+// eval: (c-set-style "k&r") 
+// eval: (c-set-offset 'innamespace 0) 
+// eval: (setq c-basic-offset 2) 
+// eval: (setq fill-column 78) 
+// eval: (auto-fill-mode 1) 
+// eval: (setq column-number-mode 1) 
+// eval: (setq indent-tabs-mode nil) 
+// End:
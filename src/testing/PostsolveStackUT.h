@@ -0,0 +1,62 @@
+// 
+//     MINOTAUR -- It's only 1/2 bull
+// 
+//     (C)opyright 2009 - 2014 The MINOTAUR Team.
+// 
+
+#ifndef POSTSOLVESTACKUT_H
+#define POSTSOLVESTACKUT_H
+
+#include <string>
+
+#include <cppunit/TestCase.h>
+#include <cppunit/TestCaller.h>
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <Environment.h>
+#include <Problem.h>
+
+using namespace Minotaur;
+
+class PostsolveStackUT : public CppUnit::TestCase {
+
+public:
+  PostsolveStackUT(std::string name) : TestCase(name) {}
+  PostsolveStackUT() {}
+
+  void setUp();
+  void tearDown();
+
+  CPPUNIT_TEST_SUITE(PostsolveStackUT);
+  CPPUNIT_TEST(testPrimal);
+  CPPUNIT_TEST(testDual);
+  CPPUNIT_TEST(testPresolve);
+  CPPUNIT_TEST_SUITE_END();
+
+  void testPrimal();
+  void testDual();
+  void testPresolve();
+
+private:
+  /// Add the constraint lb <= sum_i a[i]*x_i <= ub to p_.
+  ConstraintPtr addCons_(const double *a, double lb, double ub);
+
+  EnvPtr env_;
+  ProblemPtr p_;
+  VarVector vars_;
+};
+
+#endif
+
+// Local Variables: 
+// mode: c++ 
+// eval: (c-set-style "k&r") 
+// eval: (c-set-offset 'innamespace 0) 
+// eval: (setq c-basic-offset 2) 
+// eval: (setq fill-column 78) 
+// eval: (auto-fill-mode 1) 
+// eval: (setq column-number-mode 1) 
+// eval: (setq indent-tabs-mode nil) 
+// End:
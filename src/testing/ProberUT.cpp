@@ -0,0 +1,174 @@
+// 
+//    MINOTAUR -- It's only 1/2 bull
+// 
+//    (C)opyright 2009 - 2014 The MINOTAUR Team.
+// 
+
+#include <cmath>
+
+#include "MinotaurConfig.h"
+#include "CliqueTable.h"
+#include "Constraint.h"
+#include "Function.h"
+#include "LinearFunction.h"
+#include "LinPropagator.h"
+#include "Prober.h"
+#include "ProberUT.h"
+#include "VarBoundMod.h"
+#include "Variable.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(ProberUT);
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(ProberUT, "ProberUT");
+
+using namespace Minotaur;
+
+
+void ProberUT::setUp()
+{
+  env_ = (EnvPtr) new Environment();
+  p_ = (ProblemPtr) new Problem();
+  for (UInt i=0; i<4; ++i) {
+    vars_.push_back(p_->newVariable(0.0, 1.0, Binary));
+  }
+}
+
+
+void ProberUT::tearDown()
+{
+  vars_.clear();
+  p_.reset();
+  env_.reset();
+}
+
+
+void ProberUT::addCons_(const double *a, double lb, double ub)
+{
+  LinearFunctionPtr lf = (LinearFunctionPtr) new LinearFunction();
+
+  for (UInt i=0; i<vars_.size(); ++i) {
+    if (a[i] != 0.0) {
+      lf->addTerm(vars_[i], a[i]);
+    }
+  }
+  p_->newConstraint((FunctionPtr) new Function(lf), lb, ub);
+}
+
+
+PropEnginePtr ProberUT::getEngine_()
+{
+  PropEnginePtr engine = (PropEnginePtr) new PropEngine(p_);
+  LinPropagatorPtr lprop = (LinPropagatorPtr) 
+    new LinPropagator(p_, 1e-8, 1e20);
+
+  for (ConstraintConstIterator it=p_->consBegin(); it!=p_->consEnd(); ++it) {
+    lprop->addCons(*it);
+  }
+  engine->addPropagator(lprop);
+  return engine;
+}
+
+
+void ProberUT::testFix()
+{
+  // x0 + x1 <= 1 and x0 <= x1. x0 = 1 is infeasible, which propagation
+  // alone does not find.
+  double a[4] = {1.0, 1.0, 0.0, 0.0};
+  double b[4] = {1.0, -1.0, 0.0, 0.0};
+  bool changed = false;
+
+  addCons_(a, -INFINITY, 1.0);
+  addCons_(b, -INFINITY, 0.0);
+  Prober prober(env_, p_, getEngine_());
+  CPPUNIT_ASSERT(Finished==prober.probe(&changed));
+  CPPUNIT_ASSERT(true==changed);
+  CPPUNIT_ASSERT(vars_[0]->getUb() < 0.5);
+  CPPUNIT_ASSERT(1==prober.getStats().fixed);
+
+  // x0 + x1 >= 2 now can not be satisfied in any branch.
+  addCons_(a, 2.0, INFINITY);
+  Prober prober2(env_, p_, getEngine_());
+  CPPUNIT_ASSERT(SolvedInfeasible==prober2.probe(&changed));
+}
+
+
+void ProberUT::testAggregate()
+{
+  // x2 <= x3 and x3 <= x2 give x3 - x2 = 0. x0 + x1 >= 1 and
+  // x0 + x1 <= 1 give x1 + x0 = 1. Both branches of x2 imply x3 and the
+  // implications are saved in the table.
+  double a[4] = {0.0, 0.0, 1.0, -1.0};
+  double b[4] = {0.0, 0.0, -1.0, 1.0};
+  double c[4] = {1.0, 1.0, 0.0, 0.0};
+  CliqueTablePtr table = (CliqueTablePtr) new CliqueTable(4);
+  UInt ncons;
+  bool changed = false;
+
+  addCons_(a, -INFINITY, 0.0);
+  addCons_(b, -INFINITY, 0.0);
+  addCons_(c, 1.0, INFINITY);
+  addCons_(c, -INFINITY, 1.0);
+  ncons = p_->getNumCons();
+  Prober prober(env_, p_, getEngine_());
+  prober.setCliqueTable(table);
+  CPPUNIT_ASSERT(Finished==prober.probe(&changed));
+  CPPUNIT_ASSERT(true==changed);
+  CPPUNIT_ASSERT(2==prober.getStats().aggrs);
+  CPPUNIT_ASSERT(ncons+2==p_->getNumCons());
+  CPPUNIT_ASSERT(table->isAdjacent(CliqueTable::getLit(2, false),
+                                   CliqueTable::getLit(3, true)));
+  CPPUNIT_ASSERT(table->isAdjacent(CliqueTable::getLit(0, false),
+                                   CliqueTable::getLit(1, false)));
+  for (UInt i=0; i<4; ++i) {
+    CPPUNIT_ASSERT(vars_[i]->getLb() < 0.5 && vars_[i]->getUb() > 0.5);
+  }
+}
+
+
+void ProberUT::testUndo()
+{
+  // x0 + x1 + x2 + x3 <= 1. Fixing x0 and undoing restores all bounds, and
+  // propagation is correct afterwards.
+  double a[4] = {1.0, 1.0, 1.0, 1.0};
+  PropEnginePtr engine;
+  ModificationPtr mod;
+  ModVector mods;
+
+  addCons_(a, -INFINITY, 1.0);
+  engine = getEngine_();
+  engine->init();
+  CPPUNIT_ASSERT(false==engine->propagate(&mods, 0));
+  CPPUNIT_ASSERT(true==mods.empty());
+
+  mod = (VarBoundMod2Ptr) new VarBoundMod2(vars_[0], 1.0, 1.0);
+  mod->applyToProblem(p_);
+  mods.push_back(mod);
+  engine->varChanged(vars_[0]);
+  CPPUNIT_ASSERT(false==engine->propagate(&mods, 0));
+  CPPUNIT_ASSERT(4==mods.size());
+  CPPUNIT_ASSERT(vars_[3]->getUb() < 0.5);
+
+  engine->undo(mods, 0);
+  CPPUNIT_ASSERT(true==mods.empty());
+  for (UInt i=0; i<4; ++i) {
+    CPPUNIT_ASSERT(vars_[i]->getLb() < 0.5 && vars_[i]->getUb() > 0.5);
+  }
+
+  mod = (VarBoundMod2Ptr) new VarBoundMod2(vars_[3], 1.0, 1.0);
+  mod->applyToProblem(p_);
+  mods.push_back(mod);
+  engine->varChanged(vars_[3]);
+  CPPUNIT_ASSERT(false==engine->propagate(&mods, 0));
+  CPPUNIT_ASSERT(vars_[0]->getUb() < 0.5);
+}
+
+
+// Local Variables: 
+// mode: c++ 
+// eval: (c-set-style "k&r") 
+// eval: (c-set-offset 'innamespace 0) 
+// eval: (setq c-basic-offset 2) 
+// eval: (setq fill-column 78) 
+// eval: (auto-fill-mode 1) 
+// eval: (setq column-number-mode 1) 
+// eval: (setq indent-tabs-mode nil) 
+// End:
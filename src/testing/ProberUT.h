@@ -0,0 +1,66 @@
+// 
+//     MINOTAUR -- It's only 1/2 bull
+// 
+//     (C)opyright 2009 - 2014 The MINOTAUR Team.
+// 
+
+#ifndef PROBERUT_H
+#define PROBERUT_H
+
+#include <string>
+
+#include <cppunit/TestCase.h>
+#include <cppunit/TestCaller.h>
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <Environment.h>
+#include <Problem.h>
+#include <PropEngine.h>
+
+using namespace Minotaur;
+
+class ProberUT : public CppUnit::TestCase {
+
+public:
+  ProberUT(std::string name) : TestCase(name) {}
+  ProberUT() {}
+
+  void setUp();
+  void tearDown();
+
+  CPPUNIT_TEST_SUITE(ProberUT);
+  CPPUNIT_TEST(testFix);
+  CPPUNIT_TEST(testAggregate);
+  CPPUNIT_TEST(testUndo);
+  CPPUNIT_TEST_SUITE_END();
+
+  void testFix();
+  void testAggregate();
+  void testUndo();
+
+private:
+  /// Add the constraint lb <= sum_i a[i]*x_i <= ub to p_.
+  void addCons_(const double *a, double lb, double ub);
+
+  /// Return an engine with a LinPropagator for all constraints of p_.
+  PropEnginePtr getEngine_();
+
+  EnvPtr env_;
+  ProblemPtr p_;
+  VarVector vars_;
+};
+
+#endif
+
+// Local Variables: 
+// mode: c++ 
+// eval: (c-set-style "k&r") 
+// eval: (c-set-offset 'innamespace 0) 
+// eval: (setq c-basic-offset 2) 
+// eval: (setq fill-column 78) 
+// eval: (auto-fill-mode 1) 
+// eval: (setq column-number-mode 1) 
+// eval: (setq indent-tabs-mode nil) 
+// End:
@@ -0,0 +1,220 @@
+// 
+//    MINOTAUR -- It's only 1/2 bull
+// 
+//    (C)opyright 2009 - 2014 The MINOTAUR Team.
+// 
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#include "MinotaurConfig.h"
+#include "CGraph.h"
+#include "CNode.h"
+#include "Constraint.h"
+#include "Function.h"
+#include "LinearFunction.h"
+#include "Objective.h"
+#include "PostsolveStack.h"
+#include "ProblemSnapshot.h"
+#include "ProblemSnapshotUT.h"
+#include "QuadraticFunction.h"
+#include "SOS.h"
+#include "Variable.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(ProblemSnapshotUT);
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(ProblemSnapshotUT, "ProblemSnapshotUT");
+
+using namespace Minotaur;
+
+
+void ProblemSnapshotUT::setUp()
+{
+  LinearFunctionPtr lf = (LinearFunctionPtr) new LinearFunction();
+  QuadraticFunctionPtr qf = (QuadraticFunctionPtr) new QuadraticFunction();
+  CGraphPtr cg = (CGraphPtr) new CGraph();
+  VariablePtr x0, x1, x2, x3;
+  CNode *n0, *n1, *n2;
+  VarVector vars;
+  double wts[2] = {1.0, 2.0};
+
+  env_ = (EnvPtr) new Environment();
+  p_ = (ProblemPtr) new Problem();
+  x0 = p_->newVariable(-1.0, 2.0, Continuous, "x0");
+  x1 = p_->newVariable(0.0, 3.0, Continuous, "x1");
+  x2 = p_->newVariable(0.0, 1.0, Binary, "x2");
+  x3 = p_->newVariable(0.0, 5.0, Integer, "x3");
+
+  // x0 + 2x1 + x0*x1 + x1^2 + exp(x0)*exp(x0) + 3 <= 10.
+  lf->addTerm(x0, 1.0);
+  lf->addTerm(x1, 2.0);
+  qf->addTerm(x0, x1, 1.0);
+  qf->addTerm(x1, x1, 1.0);
+  n0 = cg->newNode(x0);
+  n1 = cg->newNode(OpExp, n0, 0);
+  n2 = cg->newNode(OpMult, n1, n1);
+  n0 = cg->newNode(3.0);
+  n2 = cg->newNode(OpPlus, n2, n0);
+  cg->setOut(n2);
+  cg->finalize();
+  p_->newConstraint((FunctionPtr) new Function(lf, qf, cg), -INFINITY, 10.0,
+                    "c0");
+
+  // x1 + x2 - x3 = 0.
+  lf = (LinearFunctionPtr) new LinearFunction();
+  lf->addTerm(x1, 1.0);
+  lf->addTerm(x2, 1.0);
+  lf->addTerm(x3, -1.0);
+  p_->newConstraint((FunctionPtr) new Function(lf), 0.0, 0.0, "c1");
+
+  // max x0 - x3 + 1.
+  lf = (LinearFunctionPtr) new LinearFunction();
+  lf->addTerm(x0, 1.0);
+  lf->addTerm(x3, -1.0);
+  p_->newObjective((FunctionPtr) new Function(lf), 1.0, Maximize, "obj");
+
+  vars.push_back(x2);
+  vars.push_back(x3);
+  p_->newSOS(2, SOS1, wts, vars, 4, "s0");
+}
+
+
+void ProblemSnapshotUT::tearDown()
+{
+  p_.reset();
+  env_.reset();
+}
+
+
+void ProblemSnapshotUT::testRoundTrip()
+{
+  ProblemSnapshot snap(env_);
+  ProblemPtr q;
+  IntVector map(4, -1);
+  double x[4] = {0.5, 1.5, 1.0, 2.0};
+  int err = 0;
+  SOSPtr sos;
+
+  map[1] = 3;
+  map[3] = 0;
+  snap.setVarMap(map);
+  CPPUNIT_ASSERT(true==snap.write(p_, "snapshotUT.snap"));
+
+  ProblemSnapshot snap2(env_);
+  q = snap2.read("snapshotUT.snap");
+  CPPUNIT_ASSERT(q);
+  CPPUNIT_ASSERT(4==q->getNumVars());
+  CPPUNIT_ASSERT(2==q->getNumCons());
+  for (UInt i=0; i<4; ++i) {
+    CPPUNIT_ASSERT(q->getVariable(i)->getName()==p_->getVariable(i)->getName());
+    CPPUNIT_ASSERT(q->getVariable(i)->getType()==p_->getVariable(i)->getType());
+    CPPUNIT_ASSERT(q->getVariable(i)->getLb()==p_->getVariable(i)->getLb());
+    CPPUNIT_ASSERT(q->getVariable(i)->getUb()==p_->getVariable(i)->getUb());
+  }
+  for (UInt i=0; i<2; ++i) {
+    ConstraintPtr c = p_->getConstraint(i);
+    ConstraintPtr d = q->getConstraint(i);
+    CPPUNIT_ASSERT(c->getName()==d->getName());
+    CPPUNIT_ASSERT(c->getLb()==d->getLb());
+    CPPUNIT_ASSERT(c->getUb()==d->getUb());
+    CPPUNIT_ASSERT(fabs(c->getActivity(x, &err) -
+                        d->getActivity(x, &err))<1e-12);
+    CPPUNIT_ASSERT(0==err);
+  }
+  CPPUNIT_ASSERT(q->getConstraint(0)->getFunction()->getNonlinearFunction());
+  CPPUNIT_ASSERT(Maximize==q->getObjective()->getObjectiveType());
+  CPPUNIT_ASSERT(fabs(q->getObjective()->eval(x, &err) -
+                      p_->getObjective()->eval(x, &err))<1e-12);
+  CPPUNIT_ASSERT(1==q->sos1End()-q->sos1Begin());
+  sos = *(q->sos1Begin());
+  CPPUNIT_ASSERT(2==sos->getNz());
+  CPPUNIT_ASSERT(4==sos->getPriority());
+  CPPUNIT_ASSERT(2.0==sos->getWeights()[1]);
+  CPPUNIT_ASSERT("x3"==(*(sos->varsBegin()+1))->getName());
+  CPPUNIT_ASSERT(!snap2.getPostsolveStack());
+  CPPUNIT_ASSERT(map==snap2.getVarMap());
+  remove("snapshotUT.snap");
+}
+
+
+void ProblemSnapshotUT::testStack()
+{
+  ProblemSnapshot snap(env_);
+  PostsolveStackPtr stack = (PostsolveStackPtr) new PostsolveStack(p_);
+  DoubleVector x(4, 1.0), newx1, newx2;
+  ProblemPtr q;
+
+  CPPUNIT_ASSERT(true==stack->fixCol(p_->getVariable(3), 2.0, p_));
+  snap.setPostsolveStack(stack);
+  CPPUNIT_ASSERT(true==snap.write(p_, "snapshotUT.snap"));
+
+  ProblemSnapshot snap2(env_);
+  q = snap2.read("snapshotUT.snap");
+  CPPUNIT_ASSERT(q);
+  CPPUNIT_ASSERT(snap2.getPostsolveStack());
+  CPPUNIT_ASSERT(1==snap2.getPostsolveStack()->getSize());
+  CPPUNIT_ASSERT(snap2.getVarMap().empty());
+  stack->postsolveGetX(x, &newx1);
+  snap2.getPostsolveStack()->postsolveGetX(x, &newx2);
+  CPPUNIT_ASSERT(newx1==newx2);
+  CPPUNIT_ASSERT(2.0==newx2[3]);
+  remove("snapshotUT.snap");
+}
+
+
+void ProblemSnapshotUT::testBadFile()
+{
+  ProblemSnapshot snap(env_);
+  std::ofstream out;
+  std::vector<char> buf;
+  std::ifstream in;
+
+  CPPUNIT_ASSERT(!snap.read("snapshotUT.missing"));
+
+  // a truncated file is rejected.
+  CPPUNIT_ASSERT(true==snap.write(p_, "snapshotUT.snap"));
+  in.open("snapshotUT.snap", std::ios::binary);
+  buf.assign(std::istreambuf_iterator<char>(in),
+             std::istreambuf_iterator<char>());
+  in.close();
+  out.open("snapshotUT.snap", std::ios::binary | std::ios::trunc);
+  out.write(&(buf[0]), buf.size()/2);
+  out.close();
+  CPPUNIT_ASSERT(!snap.read("snapshotUT.snap"));
+
+  // damaged counts and opcodes must not crash the reader.
+  for (UInt i=sizeof(UInt); i+sizeof(UInt)<=buf.size(); i+=sizeof(UInt)) {
+    std::vector<char> bad(buf);
+    memset(&(bad[i]), 0xff, sizeof(UInt));
+    out.open("snapshotUT.snap", std::ios::binary | std::ios::trunc);
+    out.write(&(bad[0]), bad.size());
+    out.close();
+    snap.read("snapshotUT.snap");
+  }
+
+  // an unknown type of the first variable is rejected. It follows the
+  // magic string, eight counts and the bounds of the variable.
+  {
+    std::vector<char> bad(buf);
+    UInt t = 7;
+    memcpy(&(bad[8+8*sizeof(UInt)+2*sizeof(double)]), &t, sizeof(UInt));
+    out.open("snapshotUT.snap", std::ios::binary | std::ios::trunc);
+    out.write(&(bad[0]), bad.size());
+    out.close();
+    CPPUNIT_ASSERT(!snap.read("snapshotUT.snap"));
+  }
+  remove("snapshotUT.snap");
+}
+
+
+// Local Variables: 
+// mode: c++ 
+// eval: (c-set-style "k&r") 
+// eval: (c-set-offset 'innamespace 0) 
+// eval: (setq c-basic-offset 2) 
+// eval: (setq fill-column 78) 
+// eval: (auto-fill-mode 1) 
+// eval: (setq column-number-mode 1) 
+// eval: (setq indent-tabs-mode nil) 
+// End:
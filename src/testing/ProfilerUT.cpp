@@ -0,0 +1,131 @@
+//
+//    MINOTAUR -- It's only 1/2 bull
+//
+//    (C)opyright 2009 - 2014 The MINOTAUR Team.
+//
+
+#include <sstream>
+
+#include "MinotaurConfig.h"
+#include "Option.h"
+#include "Profiler.h"
+#include "ProfilerUT.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(ProfilerUT);
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(ProfilerUT, "ProfilerUT");
+
+using namespace Minotaur;
+
+
+void ProfilerUT::setUp()
+{
+  env_ = (EnvPtr) new Environment();
+  env_->getOptions()->findBool("profile")->setValue(true);
+}
+
+
+void ProfilerUT::tearDown()
+{
+  Profiler::reset();
+  env_.reset();
+}
+
+
+void ProfilerUT::testNested()
+{
+  Profiler::start(env_);
+  CPPUNIT_ASSERT(Profiler::isOn());
+  for (UInt i=0; i<3; ++i) {
+    ProfZone z1(ProfBranch);
+    ProfZone z2(ProfEngine);
+  }
+  {
+    ProfZone z1(ProfEngine);
+    ProfZone z2(ProfEngine);
+  }
+
+  // a nested start does not reset, and its finish does not stop.
+  Profiler::start(env_);
+  Profiler::finish(env_);
+  CPPUNIT_ASSERT(Profiler::isOn());
+  Profiler::finish(env_);
+  CPPUNIT_ASSERT(!Profiler::isOn());
+
+  CPPUNIT_ASSERT(1==Profiler::getNumThreads());
+  CPPUNIT_ASSERT(3==Profiler::getCalls(ProfBranch));
+  CPPUNIT_ASSERT(5==Profiler::getCalls(ProfEngine));
+  CPPUNIT_ASSERT(0==Profiler::getCalls(ProfNodeSel));
+  CPPUNIT_ASSERT(Profiler::getTime(ProfEngine)>=0.0);
+  CPPUNIT_ASSERT(0.0==Profiler::getTime(ProfNodeSel));
+}
+
+
+void ProfilerUT::testOff()
+{
+  std::ostringstream out;
+
+  env_->getOptions()->findBool("profile")->setValue(false);
+  Profiler::start(env_);
+  CPPUNIT_ASSERT(!Profiler::isOn());
+  {
+    ProfZone z(ProfHeur);
+  }
+  Profiler::finish(env_);
+  CPPUNIT_ASSERT(0==Profiler::getCalls(ProfHeur));
+  CPPUNIT_ASSERT(0==Profiler::getNumThreads());
+  Profiler::writeStats(out);
+  CPPUNIT_ASSERT(out.str().empty());
+}
+
+
+void ProfilerUT::testReports()
+{
+  std::ostringstream csv, json, trace;
+
+  // save events for the trace, but do not write the trace file.
+  env_->getOptions()->findString("profile_trace_file")->setValue("x.json");
+  Profiler::start(env_);
+  {
+    ProfZone z1(ProfBranch);
+    ProfZone z2(ProfEngine);
+  }
+  {
+    ProfZone z1(ProfEngine);
+  }
+
+  // a zone open when the profiler stops is not counted.
+  ProfZone *z = new ProfZone(ProfSeparate);
+  env_->getOptions()->findString("profile_trace_file")->setValue("");
+  Profiler::finish(env_);
+  delete z;
+
+  Profiler::writeCSV(csv);
+  CPPUNIT_ASSERT(csv.str().find("0,branching/engine_solve,engine_solve,1,1,")
+                 !=std::string::npos);
+  CPPUNIT_ASSERT(csv.str().find("all,engine_solve,engine_solve,0,1,")
+                 !=std::string::npos);
+  CPPUNIT_ASSERT(csv.str().find("0,separation,separation,0,0,")
+                 !=std::string::npos);
+
+  Profiler::writeJSON(json);
+  CPPUNIT_ASSERT(json.str().find("\"zone\": \"branching\", \"calls\": 1")
+                 !=std::string::npos);
+
+  Profiler::writeTrace(trace);
+  CPPUNIT_ASSERT(trace.str().find("\"name\": \"engine_solve\", \"cat\": "
+                                  "\"bnb\", \"ph\": \"X\"")
+                 !=std::string::npos);
+  CPPUNIT_ASSERT(0==Profiler::getCalls(ProfSeparate));
+}
+
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
@@ -0,0 +1,52 @@
+//
+//    MINOTAUR -- It's only 1/2 bull
+//
+//    (C)opyright 2009 - 2014 The MINOTAUR Team.
+//
+
+#ifndef PROFILERUT_H
+#define PROFILERUT_H
+
+#include <cppunit/TestCase.h>
+#include <cppunit/TestCaller.h>
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "Environment.h"
+
+using namespace Minotaur;
+
+class ProfilerUT : public CppUnit::TestCase {
+  public:
+    ProfilerUT(std::string name) : TestCase(name) {}
+    ProfilerUT() {}
+
+    void setUp();
+    void tearDown();
+    void testNested();
+    void testOff();
+    void testReports();
+
+    CPPUNIT_TEST_SUITE(ProfilerUT);
+    CPPUNIT_TEST(testNested);
+    CPPUNIT_TEST(testOff);
+    CPPUNIT_TEST(testReports);
+    CPPUNIT_TEST_SUITE_END();
+
+  private:
+    EnvPtr env_;
+};
+
+#endif     // #define PROFILERUT_H
+
+// Local Variables:
+// mode: c++
+// eval: (c-set-style "k&r")
+// eval: (c-set-offset 'innamespace 0)
+// eval: (setq c-basic-offset 2)
+// eval: (setq fill-column 78)
+// eval: (auto-fill-mode 1)
+// eval: (setq column-number-mode 1)
+// eval: (setq indent-tabs-mode nil)
+// End:
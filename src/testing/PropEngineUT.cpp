@@ -0,0 +1,176 @@
+// 
+//    MINOTAUR -- It's only 1/2 bull
+// 
+//    (C)opyright 2009 - 2014 The MINOTAUR Team.
+// 
+
+#include <cmath>
+
+#include "MinotaurConfig.h"
+#include "Constraint.h"
+#include "Function.h"
+#include "LinearFunction.h"
+#include "LinPropagator.h"
+#include "Modification.h"
+#include "PropEngine.h"
+#include "PropEngineUT.h"
+#include "Variable.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(PropEngineUT);
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(PropEngineUT, "PropEngineUT");
+
+using namespace Minotaur;
+
+
+void PropEngineUT::setUp()
+{
+  p_ = (ProblemPtr) new Problem();
+  vars_.push_back(p_->newVariable(0.0, 10.0, Continuous));
+  vars_.push_back(p_->newVariable(0.0, 10.0, Continuous));
+  vars_.push_back(p_->newVariable(0.0, 10.0, Integer));
+}
+
+
+void PropEngineUT::tearDown()
+{
+  vars_.clear();
+  p_.reset();
+}
+
+
+void PropEngineUT::addCons_(double a0, double a1, double a2, double lb,
+                            double ub)
+{
+  LinearFunctionPtr lf = (LinearFunctionPtr) new LinearFunction();
+
+  if (a0 != 0.0) {
+    lf->addTerm(vars_[0], a0);
+  }
+  if (a1 != 0.0) {
+    lf->addTerm(vars_[1], a1);
+  }
+  if (a2 != 0.0) {
+    lf->addTerm(vars_[2], a2);
+  }
+  p_->newConstraint((FunctionPtr) new Function(lf), lb, ub);
+}
+
+
+void PropEngineUT::testChain()
+{
+  LinPropagatorPtr lp = (LinPropagatorPtr) new LinPropagator(p_, 1e-8, 1e20);
+  PropEngine engine(p_);
+  ModVector mods;
+
+  // x0 <= x1 <= x2
+  addCons_(1.0, -1.0, 0.0, -INFINITY, 0.0);
+  addCons_(0.0, 1.0, -1.0, -INFINITY, 0.0);
+  for (ConstraintConstIterator it=p_->consBegin(); it!=p_->consEnd(); ++it) {
+    lp->addCons(*it);
+  }
+  engine.addPropagator(lp);
+  engine.init();
+  CPPUNIT_ASSERT(false==engine.propagate(&mods, 0));
+  CPPUNIT_ASSERT(mods.empty());
+
+  p_->changeBound(vars_[2], Upper, 3.0);
+  engine.sync();
+  CPPUNIT_ASSERT(false==engine.propagate(&mods, 0));
+  CPPUNIT_ASSERT(2==mods.size());
+  CPPUNIT_ASSERT(fabs(vars_[1]->getUb()-3.0) < 1e-10);
+  CPPUNIT_ASSERT(fabs(vars_[0]->getUb()-3.0) < 1e-10);
+
+  p_->changeBound(vars_[0], Lower, 2.0);
+  engine.sync();
+  CPPUNIT_ASSERT(false==engine.propagate(&mods, 0));
+  CPPUNIT_ASSERT(4==mods.size());
+  CPPUNIT_ASSERT(fabs(vars_[1]->getLb()-2.0) < 1e-10);
+  CPPUNIT_ASSERT(fabs(vars_[2]->getLb()-2.0) < 1e-10);
+}
+
+
+void PropEngineUT::testInfeasible()
+{
+  LinPropagatorPtr lp = (LinPropagatorPtr) new LinPropagator(p_, 1e-8, 1e20);
+  PropEngine engine(p_);
+
+  // x0 + x1 >= 5
+  addCons_(1.0, 1.0, 0.0, 5.0, INFINITY);
+  lp->addCons(p_->getConstraint(0));
+  engine.addPropagator(lp);
+  engine.init();
+  CPPUNIT_ASSERT(false==engine.propagate(0, 0));
+
+  p_->changeBound(vars_[0], Upper, 2.0);
+  p_->changeBound(vars_[1], Upper, 2.0);
+  engine.sync();
+  CPPUNIT_ASSERT(true==engine.propagate(0, 0));
+
+  // the same bounds must be found infeasible again.
+  engine.sync();
+  CPPUNIT_ASSERT(true==engine.propagate(0, 0));
+
+  p_->changeBound(vars_[1], Upper, 10.0);
+  engine.sync();
+  CPPUNIT_ASSERT(false==engine.propagate(0, 0));
+  CPPUNIT_ASSERT(fabs(vars_[1]->getLb()-3.0) < 1e-10);
+}
+
+
+void PropEngineUT::testInteger()
+{
+  LinPropagatorPtr lp = (LinPropagatorPtr) new LinPropagator(p_, 1e-8, 1e20);
+  PropEngine engine(p_);
+  ModVector mods;
+  UInt nint = 0;
+
+  // 0.5 <= 2*x2 <= 7 with x2 integer gives 1 <= x2 <= 3.
+  addCons_(0.0, 0.0, 2.0, 0.5, 7.0);
+  lp->addCons(p_->getConstraint(0));
+  engine.addPropagator(lp);
+  engine.init();
+  CPPUNIT_ASSERT(false==engine.propagate(&mods, &nint));
+  CPPUNIT_ASSERT(fabs(vars_[2]->getLb()-1.0) < 1e-10);
+  CPPUNIT_ASSERT(fabs(vars_[2]->getUb()-3.0) < 1e-10);
+  CPPUNIT_ASSERT(2==nint);
+}
+
+
+void PropEngineUT::testSync()
+{
+  LinPropagatorPtr lp = (LinPropagatorPtr) new LinPropagator(p_, 1e-8, 1e20);
+  PropEngine engine(p_);
+  ModVector mods;
+
+  // x0 + x1 + x2 <= 6
+  addCons_(1.0, 1.0, 1.0, -INFINITY, 6.0);
+  lp->addCons(p_->getConstraint(0));
+  engine.addPropagator(lp);
+  engine.init();
+  CPPUNIT_ASSERT(false==engine.propagate(&mods, 0));
+  CPPUNIT_ASSERT(3==mods.size());
+
+  // undo, as when moving to another node, and branch differently.
+  for (ModVector::reverse_iterator it=mods.rbegin(); it!=mods.rend(); ++it) {
+    (*it)->undoToProblem(p_);
+  }
+  mods.clear();
+  p_->changeBound(vars_[0], Lower, 4.0);
+  engine.sync();
+  CPPUNIT_ASSERT(false==engine.propagate(&mods, 0));
+  CPPUNIT_ASSERT(fabs(vars_[0]->getUb()-6.0) < 1e-10);
+  CPPUNIT_ASSERT(fabs(vars_[1]->getUb()-2.0) < 1e-10);
+  CPPUNIT_ASSERT(fabs(vars_[2]->getUb()-2.0) < 1e-10);
+}
+
+
+// Local Variables: 
+// mode: c++ 
+// eval: (c-set-style "k&r") 
+// eval: (c-set-offset 'innamespace 0) 
+// eval: (setq c-basic-offset 2) 
+// eval: (setq fill-column 78) 
+// eval: (auto-fill-mode 1) 
+// eval: (setq column-number-mode 1) 
+// eval: (setq indent-tabs-mode nil) 
+// End:
@@ -0,0 +1,62 @@
+// 
+//     MINOTAUR -- It's only 1/2 bull
+// 
+//     (C)opyright 2009 - 2014 The MINOTAUR Team.
+// 
+
+#ifndef PROPENGINEUT_H
+#define PROPENGINEUT_H
+
+#include <string>
+
+#include <cppunit/TestCase.h>
+#include <cppunit/TestCaller.h>
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <Problem.h>
+
+using namespace Minotaur;
+
+class PropEngineUT : public CppUnit::TestCase {
+
+public:
+  PropEngineUT(std::string name) : TestCase(name) {}
+  PropEngineUT() {}
+
+  void setUp();
+  void tearDown();
+
+  CPPUNIT_TEST_SUITE(PropEngineUT);
+  CPPUNIT_TEST(testChain);
+  CPPUNIT_TEST(testInfeasible);
+  CPPUNIT_TEST(testInteger);
+  CPPUNIT_TEST(testSync);
+  CPPUNIT_TEST_SUITE_END();
+
+  void testChain();
+  void testInfeasible();
+  void testInteger();
+  void testSync();
+
+private:
+  /// Add the constraint lb <= a0*x0 + a1*x1 + a2*x2 <= ub to p_.
+  void addCons_(double a0, double a1, double a2, double lb, double ub);
+
+  ProblemPtr p_;
+  VarVector vars_;
+};
+
+#endif
+
+// Local Variables: 
+// mode: c++ 
+// eval: (c-set-style "k&r") 
+// eval: (c-set-offset 'innamespace 0) 
+// eval: (setq c-basic-offset 2) 
+// eval: (setq fill-column 78) 
+// eval: (auto-fill-mode 1) 
+// eval: (setq column-number-mode 1) 
+// eval: (setq indent-tabs-mode nil) 
+// End:
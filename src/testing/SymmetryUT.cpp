@@ -0,0 +1,137 @@
+// 
+//    MINOTAUR -- It's only 1/2 bull
+// 
+//    (C)opyright 2009 - 2014 The MINOTAUR Team.
+// 
+
+#include <cmath>
+
+#include "MinotaurConfig.h"
+#include "Branch.h"
+#include "Constraint.h"
+#include "Function.h"
+#include "LinearFunction.h"
+#include "Node.h"
+#include "Option.h"
+#include "Relaxation.h"
+#include "SymmetryGroup.h"
+#include "SymmetryHandler.h"
+#include "SymmetryUT.h"
+#include "VarBoundMod.h"
+#include "Variable.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(SymmetryUT);
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(SymmetryUT, "SymmetryUT");
+
+using namespace Minotaur;
+
+
+void SymmetryUT::setUp()
+{
+  LinearFunctionPtr lf = (LinearFunctionPtr) new LinearFunction();
+
+  env_ = (EnvPtr) new Environment();
+  p_ = (ProblemPtr) new Problem();
+  for (UInt i=0; i<4; ++i) {
+    vars_.push_back(p_->newVariable(0.0, 1.0, Binary));
+  }
+
+  // x0 + x1 + x2 + 2x3 <= 2. x0, x1 and x2 can be exchanged.
+  for (UInt i=0; i<3; ++i) {
+    lf->addTerm(vars_[i], 1.0);
+  }
+  lf->addTerm(vars_[3], 2.0);
+  p_->newConstraint((FunctionPtr) new Function(lf), -INFINITY, 2.0);
+
+  lf = (LinearFunctionPtr) new LinearFunction();
+  for (UInt i=0; i<4; ++i) {
+    lf->addTerm(vars_[i], -1.0);
+  }
+  p_->newObjective((FunctionPtr) new Function(lf), 0.0, Minimize);
+}
+
+
+void SymmetryUT::tearDown()
+{
+  vars_.clear();
+  p_.reset();
+  env_.reset();
+}
+
+
+void SymmetryUT::testGroup()
+{
+  SymmetryGroupPtr group = (SymmetryGroupPtr) new SymmetryGroup(p_);
+  LinearFunctionPtr lf = (LinearFunctionPtr) new LinearFunction();
+  UIntVector orbit;
+
+  CPPUNIT_ASSERT(group->findGenerators(1e7) >= 2);
+  CPPUNIT_ASSERT(false==group->hitLimit());
+  group->getOrbits(BoolVector(), orbit);
+  CPPUNIT_ASSERT(0==orbit[0] && 0==orbit[1] && 0==orbit[2]);
+  CPPUNIT_ASSERT(3==orbit[3]);
+
+  // with x0 <= x1, no two variables can be exchanged.
+  lf->addTerm(vars_[0], 1.0);
+  lf->addTerm(vars_[1], -1.0);
+  p_->newConstraint((FunctionPtr) new Function(lf), -INFINITY, 0.0);
+  group = (SymmetryGroupPtr) new SymmetryGroup(p_);
+  CPPUNIT_ASSERT(0==group->findGenerators(1e7));
+}
+
+
+void SymmetryUT::testOrbitalFixing()
+{
+  RelaxationPtr rel = (RelaxationPtr) new Relaxation(p_);
+  SymmetryHandlerPtr handler;
+  NodePtr root = (NodePtr) new Node();
+  NodePtr node;
+  BranchPtr br;
+  ModVector p_mods, r_mods;
+  bool is_inf = false;
+
+  env_->getOptions()->findInt("symmetry")->setValue(2);
+  handler = (SymmetryHandlerPtr) new SymmetryHandler(env_, p_);
+  handler->relaxInitFull(rel, &is_inf);
+  CPPUNIT_ASSERT(1==rel->getNumCons());
+
+  // x0 = 0 in a child of the root fixes x1 and x2 to zero.
+  br = (BranchPtr) new Branch();
+  br->addRMod((VarBoundModPtr) new VarBoundMod(rel->getVariable(0), Upper,
+                                               0.0));
+  node = (NodePtr) new Node(root, br);
+  node->applyRMods(rel);
+  CPPUNIT_ASSERT(false==handler->presolveNode(rel, node, SolutionPoolPtr(),
+                                              p_mods, r_mods));
+  CPPUNIT_ASSERT(2==r_mods.size());
+  CPPUNIT_ASSERT(rel->getVariable(1)->getUb() < 0.5);
+  CPPUNIT_ASSERT(rel->getVariable(2)->getUb() < 0.5);
+  CPPUNIT_ASSERT(rel->getVariable(3)->getUb() > 0.5);
+}
+
+
+void SymmetryUT::testSymmetryCons()
+{
+  RelaxationPtr rel = (RelaxationPtr) new Relaxation(p_);
+  SymmetryHandlerPtr handler;
+  bool is_inf = false;
+
+  env_->getOptions()->findInt("symmetry")->setValue(1);
+  handler = (SymmetryHandlerPtr) new SymmetryHandler(env_, p_);
+  handler->relaxInitFull(rel, &is_inf);
+  CPPUNIT_ASSERT(false==is_inf);
+  CPPUNIT_ASSERT(handler->getGroup()->getNumGenerators() >= 2);
+  CPPUNIT_ASSERT(rel->getNumCons() >= 3);
+}
+
+
+// Local Variables: 
+// mode: c++ 
+// eval: (c-set-style "k&r") 
+// eval: (c-set-offset 'innamespace 0) 
+// eval: (setq c-basic-offset 2) 
+// eval: (setq fill-column 78) 
+// eval: (auto-fill-mode 1) 
+// eval: (setq column-number-mode 1) 
+// eval: (setq indent-tabs-mode nil) 
+// End:
@@ -0,0 +1,59 @@
+// 
+//     MINOTAUR -- It's only 1/2 bull
+// 
+//     (C)opyright 2009 - 2014 The MINOTAUR Team.
+// 
+
+#ifndef SYMMETRYUT_H
+#define SYMMETRYUT_H
+
+#include <string>
+
+#include <cppunit/TestCase.h>
+#include <cppunit/TestCaller.h>
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <Environment.h>
+#include <Problem.h>
+
+using namespace Minotaur;
+
+class SymmetryUT : public CppUnit::TestCase {
+
+public:
+  SymmetryUT(std::string name) : TestCase(name) {}
+  SymmetryUT() {}
+
+  void setUp();
+  void tearDown();
+
+  CPPUNIT_TEST_SUITE(SymmetryUT);
+  CPPUNIT_TEST(testGroup);
+  CPPUNIT_TEST(testOrbitalFixing);
+  CPPUNIT_TEST(testSymmetryCons);
+  CPPUNIT_TEST_SUITE_END();
+
+  void testGroup();
+  void testOrbitalFixing();
+  void testSymmetryCons();
+
+private:
+  EnvPtr env_;
+  ProblemPtr p_;
+  VarVector vars_;
+};
+
+#endif
+
+// Local Variables: 
+// mode: c++ 
+// eval: (c-set-style "k&r") 
+// eval: (c-set-offset 'innamespace 0) 
+// eval: (setq c-basic-offset 2) 
+// eval: (setq fill-column 78) 
+// eval: (auto-fill-mode 1) 
+// eval: (setq column-number-mode 1) 
+// eval: (setq indent-tabs-mode nil) 
+// End:
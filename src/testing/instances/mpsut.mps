@@ -0,0 +1,46 @@
+* A small quadratic problem in the free MPS format for MpsReaderUT.
+NAME          mpsut
+OBJSENSE
+    MAX
+ROWS
+ N  obj
+ L  c1
+ G  c2
+ E  c3
+ E  c4
+ N  extra
+ L  q1
+COLUMNS
+    x1   obj  1.0   c1  1.0
+    x1   c2   2.0   extra 5
+    MARKER   'MARKER'   'INTORG'
+    y1   obj  -2.0  c1  1.0
+    y1   c3   1.0
+    y2   c4   1.0   c2  1
+    MARKER   'MARKER'   'INTEND'
+    x2   c3   -1    c4  1
+    x2   q1   1
+RHS
+    rhs  obj  -3.5  c1  4
+    rhs  c2   1     c3  0
+    rhs  c4   2     q1  10
+    other c1  100
+RANGES
+    rng  c1   6     c3  -2
+    rng  c4   3
+BOUNDS
+ UP bnd  x1  8
+ MI bnd  x2
+ UP bnd  x2  5
+ LI bnd  y2  -1
+ UP bnd  y2  3
+QUADOBJ
+    x1  x1  -2
+    x1  x2  1
+    x2  x2  -4
+QCMATRIX   q1
+    x1  x1  1
+    x2  x2  1
+    x1  x2  0.5
+    x2  x1  0.5
+ENDATA
@@ -0,0 +1,15 @@
+* A small problem in the fixed MPS format, with spaces in names.
+NAME          FIXED
+ROWS
+ N  COST
+ L  LIM 1
+ G  LIM 2
+COLUMNS
+    MY X      COST               1.0   LIM 1              1.0
+    MY X      LIM 2              1.0
+    Y         COST               2.0   LIM 1              1.0
+RHS
+              LIM 1              4.0   LIM 2              1.0
+BOUNDS
+ UP BND       MY X               3.0
+ENDATA